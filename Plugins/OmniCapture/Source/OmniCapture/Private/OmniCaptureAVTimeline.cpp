@@ -0,0 +1,214 @@
+#include "OmniCaptureAVTimeline.h"
+
+namespace
+{
+    constexpr double GDefaultFrameDuration = 1.0 / 30.0;
+
+    /** Linear interpolation of interleaved PCM to OutFrames frames, keeping the first and last frame in place. */
+    void ResamplePCM(TArray<int16>& PCM16, int32 NumChannels, int64 OutFrames)
+    {
+        const int64 InFrames = PCM16.Num() / NumChannels;
+        TArray<int16> Resampled;
+        Resampled.SetNumUninitialized(static_cast<int32>(OutFrames * NumChannels));
+        const double Step = OutFrames > 1 ? static_cast<double>(InFrames - 1) / static_cast<double>(OutFrames - 1) : 0.0;
+        for (int64 Frame = 0; Frame < OutFrames; ++Frame)
+        {
+            const double Position = static_cast<double>(Frame) * Step;
+            const int64 Index = FMath::Min<int64>(static_cast<int64>(Position), InFrames - 1);
+            const int64 Next = FMath::Min<int64>(Index + 1, InFrames - 1);
+            const double Alpha = Position - static_cast<double>(Index);
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                const double Sample = FMath::Lerp(static_cast<double>(PCM16[Index * NumChannels + Channel]), static_cast<double>(PCM16[Next * NumChannels + Channel]), Alpha);
+                Resampled[Frame * NumChannels + Channel] = static_cast<int16>(FMath::RoundToInt(Sample));
+            }
+        }
+        PCM16 = MoveTemp(Resampled);
+    }
+}
+
+void FOmniCaptureAVTimeline::Reset(double InToleranceSeconds)
+{
+    VideoTimestamps.Reset();
+    Stats = FOmniCaptureAVTimelineStats();
+    ToleranceSeconds = FMath::Max(0.0, InToleranceSeconds);
+    WriteCursor = 0;
+    SkippedFrames = 0;
+    SampleRate = 0;
+    NumChannels = 0;
+}
+
+void FOmniCaptureAVTimeline::AddVideoFrame(double PresentationTime)
+{
+    // Presentation order must be monotonic; a stalled clock repeats the previous timestamp.
+    const double Clamped = VideoTimestamps.Num() > 0 ? FMath::Max(PresentationTime, VideoTimestamps.Last()) : PresentationTime;
+    VideoTimestamps.Add(Clamped);
+}
+
+double FOmniCaptureAVTimeline::GetNominalFrameDuration() const
+{
+    if (VideoTimestamps.Num() < 2)
+    {
+        return GDefaultFrameDuration;
+    }
+
+    const double Span = VideoTimestamps.Last() - VideoTimestamps[0];
+    return Span > 0.0 ? Span / static_cast<double>(VideoTimestamps.Num() - 1) : GDefaultFrameDuration;
+}
+
+double FOmniCaptureAVTimeline::GetVideoEndTime() const
+{
+    return HasVideo() ? VideoTimestamps.Last() + GetNominalFrameDuration() : 0.0;
+}
+
+int64 FOmniCaptureAVTimeline::TimeToSampleFrame(double Seconds) const
+{
+    return static_cast<int64>(FMath::RoundToDouble((Seconds - GetVideoOrigin()) * static_cast<double>(SampleRate)));
+}
+
+void FOmniCaptureAVTimeline::RecordCorrection(int64 Frames)
+{
+    const double Milliseconds = static_cast<double>(FMath::Abs(Frames)) * 1000.0 / static_cast<double>(FMath::Max(SampleRate, 1));
+    Stats.MaxCorrectionMilliseconds = FMath::Max(Stats.MaxCorrectionMilliseconds, Milliseconds);
+}
+
+int64 FOmniCaptureAVTimeline::ClampGap(int64 Frames)
+{
+    const int64 MaxGapFrames = static_cast<int64>(MaxGapSeconds * static_cast<double>(SampleRate));
+    if (Frames <= MaxGapFrames)
+    {
+        return Frames;
+    }
+
+    ++Stats.ClampedGaps;
+    SkippedFrames += Frames - MaxGapFrames;
+    return MaxGapFrames;
+}
+
+void FOmniCaptureAVTimeline::EmitSilence(int64 Frames, TArray<FOmniAudioPacket>& Output)
+{
+    while (Frames > 0)
+    {
+        const int64 PacketFrames = FMath::Min<int64>(Frames, SilencePacketFrames);
+        FOmniAudioPacket& Silence = Output.AddDefaulted_GetRef();
+        Silence.SampleRate = SampleRate;
+        Silence.NumChannels = NumChannels;
+        Silence.Timestamp = GetVideoOrigin() + static_cast<double>(WriteCursor) / static_cast<double>(SampleRate);
+        Silence.PCM16.SetNumZeroed(static_cast<int32>(PacketFrames * NumChannels));
+
+        const int64 Samples = PacketFrames * NumChannels;
+        Stats.PaddedSamples += Samples;
+        Stats.EmittedSamples += Samples;
+        WriteCursor += PacketFrames;
+        Frames -= PacketFrames;
+    }
+}
+
+void FOmniCaptureAVTimeline::ProcessAudio(TArray<FOmniAudioPacket>& InOutPackets)
+{
+    if (!HasVideo())
+    {
+        // Audio that precedes the first frame has no place on the output timeline.
+        for (const FOmniAudioPacket& Packet : InOutPackets)
+        {
+            Stats.TrimmedSamples += Packet.PCM16.Num();
+        }
+        InOutPackets.Reset();
+        return;
+    }
+
+    TArray<FOmniAudioPacket> Output;
+    Output.Reserve(InOutPackets.Num());
+
+    for (FOmniAudioPacket& Packet : InOutPackets)
+    {
+        if (Packet.SampleRate <= 0 || Packet.NumChannels <= 0 || Packet.PCM16.Num() < Packet.NumChannels)
+        {
+            ++Stats.RejectedPackets;
+            continue;
+        }
+
+        if (SampleRate == 0)
+        {
+            SampleRate = Packet.SampleRate;
+            NumChannels = Packet.NumChannels;
+        }
+        else if (Packet.SampleRate != SampleRate || Packet.NumChannels != NumChannels)
+        {
+            ++Stats.RejectedPackets;
+            continue;
+        }
+
+        const int64 ToleranceFrames = static_cast<int64>(FMath::CeilToDouble(ToleranceSeconds * SampleRate));
+        const int64 ResampleFrames = static_cast<int64>(MaxResampleSeconds * SampleRate);
+        const int64 ExpectedStart = TimeToSampleFrame(Packet.Timestamp) - SkippedFrames;
+        const int64 Delta = ExpectedStart - WriteCursor;
+        const int64 PacketFrames = Packet.PCM16.Num() / NumChannels;
+        const int64 MaxAdjustFrames = static_cast<int64>(static_cast<double>(PacketFrames) * MaxResampleRatio);
+
+        if (FMath::Abs(Delta) > ToleranceFrames && FMath::Abs(Delta) <= ResampleFrames && MaxAdjustFrames > 0)
+        {
+            // Late packets are stretched and early ones squeezed; the rest of the drift waits for the next packets.
+            const int64 AdjustFrames = FMath::Clamp(Delta, -MaxAdjustFrames, MaxAdjustFrames);
+            ResamplePCM(Packet.PCM16, NumChannels, PacketFrames + AdjustFrames);
+            ++Stats.ResampleEvents;
+            Stats.ResampledFrames += AdjustFrames;
+            RecordCorrection(AdjustFrames);
+        }
+        else if (Delta > ToleranceFrames)
+        {
+            const int64 PadFrames = ClampGap(Delta);
+            EmitSilence(PadFrames, Output);
+            ++Stats.PadEvents;
+            RecordCorrection(PadFrames);
+        }
+        else if (Delta < -ToleranceFrames)
+        {
+            const int64 TrimFrames = FMath::Min<int64>(-Delta, PacketFrames);
+            const int32 TrimSamples = static_cast<int32>(TrimFrames * NumChannels);
+            Stats.TrimmedSamples += TrimSamples;
+            ++Stats.TrimEvents;
+            RecordCorrection(TrimFrames);
+
+            if (TrimFrames >= PacketFrames)
+            {
+                continue;
+            }
+            Packet.PCM16.RemoveAt(0, TrimSamples, EAllowShrinking::No);
+        }
+
+        // Drop a trailing partial frame so the grid stays channel aligned.
+        Packet.PCM16.SetNum((Packet.PCM16.Num() / NumChannels) * NumChannels, EAllowShrinking::No);
+
+        Packet.Timestamp = GetVideoOrigin() + static_cast<double>(WriteCursor) / static_cast<double>(SampleRate);
+        WriteCursor += Packet.PCM16.Num() / NumChannels;
+        Stats.EmittedSamples += Packet.PCM16.Num();
+        Output.Add(MoveTemp(Packet));
+    }
+
+    InOutPackets = MoveTemp(Output);
+}
+
+int64 FOmniCaptureAVTimeline::Finish(TArray<FOmniAudioPacket>& OutTailPadding)
+{
+    OutTailPadding.Reset();
+    if (!HasVideo() || SampleRate == 0)
+    {
+        return 0;
+    }
+
+    const int64 TargetFrames = TimeToSampleFrame(GetVideoEndTime());
+    const int64 Delta = TargetFrames - WriteCursor;
+    if (Delta > 0)
+    {
+        // A tail longer than MaxGapSeconds is left short rather than buffered as silence.
+        EmitSilence(ClampGap(Delta), OutTailPadding);
+        return 0;
+    }
+
+    const int64 TrimSamples = -Delta * NumChannels;
+    Stats.TrimmedSamples += TrimSamples;
+    Stats.EmittedSamples -= TrimSamples;
+    WriteCursor = TargetFrames;
+    return TrimSamples;
+}
@@ -0,0 +1,295 @@
+#include "OmniCaptureAudioFileWriter.h"
+
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogOmniCaptureAudioFile, Log, All);
+
+namespace
+{
+    // RIFF sizes are 32-bit; past this the header switches to RF64 and the real sizes move into the ds64 chunk.
+    constexpr int64 GMaxWaveDataBytes = static_cast<int64>(MAX_uint32) - FOmniCaptureAudioFileWriter::WaveHeaderSize;
+    // Reserved after "WAVE" as a JUNK chunk so the header can become RF64 in place without moving the PCM.
+    constexpr uint32 GDs64ChunkSize = 28;
+
+    void WriteUInt64LE(uint8* Destination, uint64 Value)
+    {
+        for (int32 Byte = 0; Byte < 8; ++Byte)
+        {
+            Destination[Byte] = static_cast<uint8>((Value >> (Byte * 8)) & 0xFF);
+        }
+    }
+
+    void WriteUInt32LE(uint8* Destination, uint32 Value)
+    {
+        Destination[0] = static_cast<uint8>(Value & 0xFF);
+        Destination[1] = static_cast<uint8>((Value >> 8) & 0xFF);
+        Destination[2] = static_cast<uint8>((Value >> 16) & 0xFF);
+        Destination[3] = static_cast<uint8>((Value >> 24) & 0xFF);
+    }
+
+    void WriteUInt16LE(uint8* Destination, uint16 Value)
+    {
+        Destination[0] = static_cast<uint8>(Value & 0xFF);
+        Destination[1] = static_cast<uint8>((Value >> 8) & 0xFF);
+    }
+}
+
+class FOmniCaptureAudioFileWriterWorker final : public FRunnable
+{
+public:
+    explicit FOmniCaptureAudioFileWriterWorker(FOmniCaptureAudioFileWriter& InOwner)
+        : Owner(InOwner)
+    {
+    }
+
+    virtual uint32 Run() override
+    {
+        const uint32 WaitMilliseconds = static_cast<uint32>(FMath::Clamp(Owner.HeaderRefreshSeconds * 1000.0, 10.0, 10000.0));
+        while (Owner.bRunning.Load())
+        {
+            Owner.DataEvent->Wait(WaitMilliseconds);
+            Owner.DrainQueue();
+
+            const double Now = FPlatformTime::Seconds();
+            if (Now - Owner.LastHeaderWriteTime >= Owner.HeaderRefreshSeconds)
+            {
+                Owner.RewriteHeader();
+            }
+        }
+
+        Owner.DrainQueue();
+        return 0;
+    }
+
+private:
+    FOmniCaptureAudioFileWriter& Owner;
+};
+
+FOmniCaptureAudioFileWriter::FOmniCaptureAudioFileWriter()
+{
+    bRunning = false;
+    PendingCount = 0;
+    RejectedCount = 0;
+    DataBytesWritten = 0;
+}
+
+FOmniCaptureAudioFileWriter::~FOmniCaptureAudioFileWriter()
+{
+    Close();
+}
+
+bool FOmniCaptureAudioFileWriter::Open(const FString& InFilePath, double InHeaderRefreshSeconds)
+{
+    Close();
+
+    FilePath = InFilePath;
+    HeaderRefreshSeconds = FMath::Max(0.05, InHeaderRefreshSeconds);
+    SampleRate = 0;
+    NumChannels = 0;
+    bLoggedFormatMismatch = false;
+    bLoggedRF64 = false;
+    PendingCount = 0;
+    RejectedCount = 0;
+    DataBytesWritten = 0;
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+    FileHandle.Reset(PlatformFile.OpenWrite(*FilePath, false, false));
+    if (!FileHandle.IsValid())
+    {
+        UE_LOG(LogOmniCaptureAudioFile, Error, TEXT("Failed to open audio file %s for writing."), *FilePath);
+        return false;
+    }
+
+    // Placeholder header; the real format is known once the first packet arrives.
+    RewriteHeader();
+
+    DataEvent = FPlatformProcess::GetSynchEventFromPool();
+    bRunning = true;
+    Worker = new FOmniCaptureAudioFileWriterWorker(*this);
+    WorkerThread.Reset(FRunnableThread::Create(Worker, TEXT("OmniCaptureAudioFileWriter")));
+    return true;
+}
+
+void FOmniCaptureAudioFileWriter::Enqueue(const FOmniAudioPacket& Packet)
+{
+    if (!FileHandle.IsValid() || Packet.PCM16.Num() == 0)
+    {
+        return;
+    }
+
+    Queue.Enqueue(Packet);
+    PendingCount.IncrementExchange();
+
+    if (DataEvent)
+    {
+        DataEvent->Trigger();
+    }
+}
+
+void FOmniCaptureAudioFileWriter::Close(int64 MaxDataBytes)
+{
+    if (WorkerThread.IsValid())
+    {
+        bRunning = false;
+        if (DataEvent)
+        {
+            DataEvent->Trigger();
+        }
+
+        WorkerThread->WaitForCompletion();
+        WorkerThread.Reset();
+
+        delete Worker;
+        Worker = nullptr;
+    }
+
+    if (DataEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(DataEvent);
+        DataEvent = nullptr;
+    }
+
+    if (FileHandle.IsValid())
+    {
+        DrainQueue();
+
+        const int64 Written = DataBytesWritten.Load();
+        if (MaxDataBytes >= 0 && MaxDataBytes < Written)
+        {
+            // The header size alone hides the excess from readers; truncation just reclaims the bytes.
+            DataBytesWritten = MaxDataBytes - (MaxDataBytes % sizeof(int16));
+            FileHandle->Truncate(WaveHeaderSize + DataBytesWritten.Load());
+        }
+
+        RewriteHeader();
+        FileHandle.Reset();
+
+        UE_LOG(LogOmniCaptureAudioFile, Log, TEXT("Closed audio file %s (%lld bytes of PCM)."), *FilePath, DataBytesWritten.Load());
+        if (RejectedCount.Load() > 0)
+        {
+            UE_LOG(LogOmniCaptureAudioFile, Warning, TEXT("%d audio packets were skipped because their format did not match %d Hz / %d ch."), RejectedCount.Load(), SampleRate, NumChannels);
+        }
+    }
+}
+
+void FOmniCaptureAudioFileWriter::BuildWaveHeader(int32 InSampleRate, int32 InNumChannels, int64 DataBytes, TArray<uint8>& OutHeader)
+{
+    const uint64 PayloadBytes = static_cast<uint64>(FMath::Max<int64>(DataBytes, 0));
+    const bool bRF64 = IsRF64(DataBytes);
+    const uint16 Channels = static_cast<uint16>(FMath::Max(1, InNumChannels));
+    const uint32 Rate = static_cast<uint32>(FMath::Max(1, InSampleRate));
+    const uint16 BlockAlign = static_cast<uint16>(Channels * sizeof(int16));
+
+    OutHeader.SetNumZeroed(WaveHeaderSize);
+    uint8* Data = OutHeader.GetData();
+
+    const uint64 RiffBytes = PayloadBytes + WaveHeaderSize - 8;
+    FMemory::Memcpy(Data + 0, bRF64 ? "RF64" : "RIFF", 4);
+    WriteUInt32LE(Data + 4, bRF64 ? MAX_uint32 : static_cast<uint32>(RiffBytes));
+    FMemory::Memcpy(Data + 8, "WAVE", 4);
+
+    // EBU Tech 3306: ds64 carries the 64-bit RIFF and data sizes; a plain WAV keeps the same bytes as JUNK.
+    FMemory::Memcpy(Data + 12, bRF64 ? "ds64" : "JUNK", 4);
+    WriteUInt32LE(Data + 16, GDs64ChunkSize);
+    if (bRF64)
+    {
+        WriteUInt64LE(Data + 20, RiffBytes);
+        WriteUInt64LE(Data + 28, PayloadBytes);
+        WriteUInt64LE(Data + 36, PayloadBytes / BlockAlign);
+        WriteUInt32LE(Data + 44, 0);
+    }
+
+    FMemory::Memcpy(Data + 48, "fmt ", 4);
+    WriteUInt32LE(Data + 52, 16);
+    WriteUInt16LE(Data + 56, 1);
+    WriteUInt16LE(Data + 58, Channels);
+    WriteUInt32LE(Data + 60, Rate);
+    WriteUInt32LE(Data + 64, Rate * BlockAlign);
+    WriteUInt16LE(Data + 68, BlockAlign);
+    WriteUInt16LE(Data + 70, 16);
+    FMemory::Memcpy(Data + 72, "data", 4);
+    WriteUInt32LE(Data + 76, bRF64 ? MAX_uint32 : static_cast<uint32>(PayloadBytes));
+}
+
+bool FOmniCaptureAudioFileWriter::IsRF64(int64 DataBytes)
+{
+    return DataBytes > GMaxWaveDataBytes;
+}
+
+void FOmniCaptureAudioFileWriter::DrainQueue()
+{
+    FOmniAudioPacket Packet;
+    while (Queue.Dequeue(Packet))
+    {
+        PendingCount.DecrementExchange();
+        WritePacket(Packet);
+    }
+}
+
+void FOmniCaptureAudioFileWriter::WritePacket(const FOmniAudioPacket& Packet)
+{
+    if (!FileHandle.IsValid())
+    {
+        return;
+    }
+
+    if (SampleRate == 0)
+    {
+        SampleRate = Packet.SampleRate;
+        NumChannels = Packet.NumChannels;
+        RewriteHeader();
+    }
+    else if (Packet.SampleRate != SampleRate || Packet.NumChannels != NumChannels)
+    {
+        RejectedCount.IncrementExchange();
+        if (!bLoggedFormatMismatch)
+        {
+            bLoggedFormatMismatch = true;
+            UE_LOG(LogOmniCaptureAudioFile, Warning, TEXT("Audio format changed mid-capture (%d Hz / %d ch -> %d Hz / %d ch). Mismatched packets are skipped."), SampleRate, NumChannels, Packet.SampleRate, Packet.NumChannels);
+        }
+        return;
+    }
+
+    const int64 NumBytes = static_cast<int64>(Packet.PCM16.Num()) * sizeof(int16);
+    if (FileHandle->Write(reinterpret_cast<const uint8*>(Packet.PCM16.GetData()), NumBytes))
+    {
+        DataBytesWritten.AddExchange(NumBytes);
+    }
+    else
+    {
+        UE_LOG(LogOmniCaptureAudioFile, Error, TEXT("Failed to append %lld bytes to %s."), NumBytes, *FilePath);
+    }
+}
+
+void FOmniCaptureAudioFileWriter::RewriteHeader()
+{
+    if (!FileHandle.IsValid())
+    {
+        return;
+    }
+
+    const int64 DataBytes = DataBytesWritten.Load();
+    if (IsRF64(DataBytes) && !bLoggedRF64)
+    {
+        bLoggedRF64 = true;
+        UE_LOG(LogOmniCaptureAudioFile, Log, TEXT("%s passed 4 GB of PCM; the header is now RF64."), *FilePath);
+    }
+
+    TArray<uint8> Header;
+    BuildWaveHeader(SampleRate > 0 ? SampleRate : 48000, NumChannels > 0 ? NumChannels : 2, DataBytes, Header);
+
+    const int64 EndPosition = WaveHeaderSize + DataBytes;
+    FileHandle->Seek(0);
+    FileHandle->Write(Header.GetData(), Header.Num());
+    FileHandle->Seek(EndPosition);
+    FileHandle->Flush();
+
+    LastHeaderWriteTime = FPlatformTime::Seconds();
+}
@@ -0,0 +1,173 @@
+#include "OmniCaptureAudioPacketRing.h"
+
+#include "Math/VectorRegister.h"
+
+FOmniCaptureAudioPacketRing::FOmniCaptureAudioPacketRing()
+    : WriteIndex(0)
+    , ReadIndex(0)
+    , DroppedBlocks(0)
+    , DroppedSamples(0)
+    , PushedSamples(0)
+{
+}
+
+void FOmniCaptureAudioPacketRing::Initialize(int32 InBlockCount, int32 InSamplesPerBlock)
+{
+    BlockCount = static_cast<int32>(FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(2, InBlockCount))));
+    SamplesPerBlock = FMath::Max(64, InSamplesPerBlock);
+    IndexMask = static_cast<uint32>(BlockCount - 1);
+
+    Blocks.SetNum(BlockCount);
+    SampleStorage.SetNumZeroed(BlockCount * SamplesPerBlock);
+
+    Reset();
+}
+
+void FOmniCaptureAudioPacketRing::Reset()
+{
+    WriteIndex.Store(0);
+    ReadIndex.Store(0);
+    DroppedBlocks.Store(0);
+    DroppedSamples.Store(0);
+    PushedSamples.Store(0);
+}
+
+int32 FOmniCaptureAudioPacketRing::Push(const float* AudioData, int32 NumSamples, int32 NumChannels, int32 SampleRate, double Timestamp, float Gain)
+{
+    if (!AudioData || NumSamples <= 0 || NumChannels <= 0 || SampleRate <= 0)
+    {
+        return 0;
+    }
+
+    if (BlockCount == 0)
+    {
+        DroppedBlocks.IncrementExchange();
+        DroppedSamples.AddExchange(NumSamples);
+        return NumSamples;
+    }
+
+    // Keep every block frame aligned so a split never separates the channels of one sample frame.
+    const int32 MaxSamplesPerBlock = FMath::Max(NumChannels, (SamplesPerBlock / NumChannels) * NumChannels);
+
+    int32 DroppedThisCall = 0;
+    int32 Offset = 0;
+    while (Offset < NumSamples)
+    {
+        const int32 ChunkSamples = FMath::Min(MaxSamplesPerBlock, NumSamples - Offset);
+        const uint32 Write = WriteIndex.Load(EMemoryOrder::Relaxed);
+        const uint32 Read = ReadIndex.Load();
+
+        if (Write - Read >= static_cast<uint32>(BlockCount))
+        {
+            DroppedBlocks.IncrementExchange();
+            DroppedSamples.AddExchange(ChunkSamples);
+            DroppedThisCall += ChunkSamples;
+        }
+        else
+        {
+            const int32 Slot = static_cast<int32>(Write & IndexMask);
+            FBlock& Block = Blocks[Slot];
+            Block.Timestamp = Timestamp + static_cast<double>(Offset / NumChannels) / static_cast<double>(SampleRate);
+            Block.SampleRate = SampleRate;
+            Block.NumChannels = NumChannels;
+            Block.NumSamples = ChunkSamples;
+
+            ConvertFloatToPCM16(AudioData + Offset, SampleStorage.GetData() + Slot * SamplesPerBlock, ChunkSamples, Gain);
+
+            WriteIndex.Store(Write + 1);
+            PushedSamples.AddExchange(ChunkSamples);
+        }
+
+        Offset += ChunkSamples;
+    }
+
+    return DroppedThisCall;
+}
+
+int32 FOmniCaptureAudioPacketRing::PopUpTo(double Threshold, TArray<FOmniAudioPacket>& OutPackets)
+{
+    int32 NumPopped = 0;
+    FOmniAudioPacket Packet;
+    while (PopFront(Threshold, false, Packet))
+    {
+        OutPackets.Add(MoveTemp(Packet));
+        ++NumPopped;
+    }
+    return NumPopped;
+}
+
+int32 FOmniCaptureAudioPacketRing::PopAll(TArray<FOmniAudioPacket>& OutPackets)
+{
+    int32 NumPopped = 0;
+    FOmniAudioPacket Packet;
+    while (PopFront(0.0, true, Packet))
+    {
+        OutPackets.Add(MoveTemp(Packet));
+        ++NumPopped;
+    }
+    return NumPopped;
+}
+
+int32 FOmniCaptureAudioPacketRing::GetPendingBlockCount() const
+{
+    const uint32 Read = ReadIndex.Load();
+    const uint32 Write = WriteIndex.Load();
+    return static_cast<int32>(Write - Read);
+}
+
+bool FOmniCaptureAudioPacketRing::PopFront(double Threshold, bool bIgnoreThreshold, FOmniAudioPacket& OutPacket)
+{
+    const uint32 Read = ReadIndex.Load(EMemoryOrder::Relaxed);
+    const uint32 Write = WriteIndex.Load();
+    if (Read == Write)
+    {
+        return false;
+    }
+
+    const int32 Slot = static_cast<int32>(Read & IndexMask);
+    const FBlock& Block = Blocks[Slot];
+    if (!bIgnoreThreshold && Block.Timestamp > Threshold)
+    {
+        return false;
+    }
+
+    OutPacket.Timestamp = Block.Timestamp;
+    OutPacket.SampleRate = Block.SampleRate;
+    OutPacket.NumChannels = Block.NumChannels;
+    OutPacket.PCM16.SetNumUninitialized(Block.NumSamples, EAllowShrinking::No);
+    FMemory::Memcpy(OutPacket.PCM16.GetData(), SampleStorage.GetData() + Slot * SamplesPerBlock, Block.NumSamples * sizeof(int16));
+
+    ReadIndex.Store(Read + 1);
+    return true;
+}
+
+void FOmniCaptureAudioPacketRing::ConvertFloatToPCM16(const float* Source, int16* Destination, int32 NumSamples, float Gain)
+{
+    // Matches FMath::RoundToInt (floor(x + 0.5)) followed by a clamp to the int16 range.
+    const VectorRegister4Float GainVec = VectorSetFloat1(Gain);
+    const VectorRegister4Float FullScaleVec = VectorSetFloat1(32767.0f);
+    const VectorRegister4Float HalfVec = VectorSetFloat1(0.5f);
+    const VectorRegister4Float MinVec = VectorSetFloat1(-32768.0f);
+    const VectorRegister4Float MaxVec = VectorSetFloat1(32767.0f);
+
+    int32 Index = 0;
+    alignas(16) int32 Rounded[4];
+    for (; Index + 4 <= NumSamples; Index += 4)
+    {
+        VectorRegister4Float Value = VectorMultiply(VectorMultiply(VectorLoad(Source + Index), GainVec), FullScaleVec);
+        Value = VectorMin(VectorMax(Value, MinVec), MaxVec);
+        Value = VectorFloor(VectorAdd(Value, HalfVec));
+        VectorIntStoreAligned(VectorFloatToInt(Value), Rounded);
+
+        Destination[Index + 0] = static_cast<int16>(Rounded[0]);
+        Destination[Index + 1] = static_cast<int16>(Rounded[1]);
+        Destination[Index + 2] = static_cast<int16>(Rounded[2]);
+        Destination[Index + 3] = static_cast<int16>(Rounded[3]);
+    }
+
+    for (; Index < NumSamples; ++Index)
+    {
+        const int32 IntValue = FMath::RoundToInt((Source[Index] * Gain) * 32767.0f);
+        Destination[Index] = static_cast<int16>(FMath::Clamp(IntValue, -32768, 32767));
+    }
+}
@@ -1,13 +1,11 @@
 #include "OmniCaptureAudioRecorder.h"
 
-#include "AudioMixerBlueprintLibrary.h"
 #include "AudioDevice.h"
 #include "Engine/World.h"
 #include "Misc/Paths.h"
 #include "HAL/FileManager.h"
 #include "Sound/SoundWave.h"
 #include "Sound/SoundSubmix.h"
-#include "Misc/ScopeLock.h"
 
 #if WITH_AUDIOMIXER
 #include "AudioMixerDevice.h"
@@ -17,7 +15,8 @@ DEFINE_LOG_CATEGORY_STATIC(LogOmniCaptureAudio, Log, All);
 
 namespace
 {
-    constexpr int32 GMaxPendingAudioPackets = 256;
+    constexpr double GAudioHeaderRefreshSeconds = 1.0;
+    constexpr double GAudioTimelineToleranceSeconds = 0.002;
 
 #if WITH_AUDIOMIXER
     class FOmniCaptureSubmixListener final : public Audio::ISubmixBufferListener
@@ -55,8 +54,9 @@ bool FOmniCaptureAudioRecorder::Initialize(UWorld* InWorld, const FOmniCaptureSe
             TargetSubmix = LoadedSubmix;
         }
     }
-    PendingPacketCount = 0;
-    DroppedPacketCount = 0;
+    PendingOutputDirectory = Settings.OutputDirectory;
+    PendingBaseFileName = Settings.OutputFileName;
+    PacketRing.Initialize(FOmniCaptureAudioPacketRing::DefaultBlockCount, FOmniCaptureAudioPacketRing::DefaultSamplesPerBlock);
     bLoggedOverflowWarning = false;
     AudioClockOrigin = -1.0;
     AudioStartTime = 0.0;
@@ -86,14 +86,21 @@ void FOmniCaptureAudioRecorder::Start()
         return;
     }
 
-    DroppedPacketCount = 0;
+    PacketRing.Reset();
+    Timeline.Reset(GAudioTimelineToleranceSeconds);
+    PaddedSampleCount = 0;
+    TrimmedSampleCount = 0;
+    AudioPlatformOrigin.Store(-1.0);
     bLoggedOverflowWarning = false;
 
+    const FString FilePath = BuildOutputFilePath(PendingOutputDirectory, PendingBaseFileName);
+    if (!FileWriter.Open(FilePath, GAudioHeaderRefreshSeconds))
+    {
+        UE_LOG(LogOmniCaptureAudio, Warning, TEXT("Audio will be attached to frames only; streaming file %s could not be created."), *FilePath);
+    }
+
     RegisterListener();
     AudioStartTime = FPlatformTime::Seconds();
-
-    USoundSubmix* Submix = TargetSubmix.IsValid() ? TargetSubmix.Get() : nullptr;
-    UAudioMixerBlueprintLibrary::StartRecordingOutput(WorldPtr.Get(), 0.0f, Submix);
     bIsRecording = true;
     bPaused.Store(false);
 }
@@ -105,70 +112,116 @@ void FOmniCaptureAudioRecorder::Stop(const FString& OutputDirectory, const FStri
         return;
     }
 
-    const FString SanitizedName = BaseFileName.IsEmpty() ? TEXT("OmniCapture") : BaseFileName;
-    FString Directory = OutputDirectory.IsEmpty() ? (FPaths::ProjectSavedDir() / TEXT("OmniCaptures")) : OutputDirectory;
-    Directory = FPaths::ConvertRelativePathToFull(Directory);
-    IFileManager::Get().MakeDirectory(*Directory, true);
-
-    USoundSubmix* Submix = TargetSubmix.IsValid() ? TargetSubmix.Get() : nullptr;
-    UAudioMixerBlueprintLibrary::StopRecordingOutput(WorldPtr.Get(), EAudioRecordingExportType::WavFile, SanitizedName, Directory, Submix);
-    OutputFilePath = Directory / (SanitizedName + TEXT(".wav"));
-
     UnregisterListener();
 
     bIsRecording = false;
 
+    // The listener is gone, so whatever is still in the ring belongs at the tail of the file.
+    TArray<FOmniAudioPacket> RemainingPackets;
+    PacketRing.PopAll(RemainingPackets);
+    const double ClockOffset = GetAudioToCaptureClockOffset();
+    for (FOmniAudioPacket& Packet : RemainingPackets)
     {
-        FScopeLock Lock(&PacketCS);
-        FOmniAudioPacket Packet;
-        while (PendingPackets.Dequeue(Packet))
+        Packet.Timestamp += ClockOffset;
+    }
+    Timeline.ProcessAudio(RemainingPackets);
+    for (const FOmniAudioPacket& Packet : RemainingPackets)
+    {
+        FileWriter.Enqueue(Packet);
+    }
+
+    // Pad or cut the tail so the audio ends exactly with the last emitted frame.
+    TArray<FOmniAudioPacket> TailPadding;
+    const int64 TrimSamples = Timeline.Finish(TailPadding);
+    for (const FOmniAudioPacket& Packet : TailPadding)
+    {
+        FileWriter.Enqueue(Packet);
+    }
+    PaddedSampleCount = Timeline.GetStats().PaddedSamples;
+    TrimmedSampleCount = Timeline.GetStats().TrimmedSamples;
+    if (Timeline.GetStats().ClampedGaps > 0)
+    {
+        UE_LOG(LogOmniCaptureAudio, Warning, TEXT("OmniCapture audio had %d gaps longer than %.0f s; each was filled with %.0f s of silence."), Timeline.GetStats().ClampedGaps, FOmniCaptureAVTimeline::MaxGapSeconds, FOmniCaptureAVTimeline::MaxGapSeconds);
+    }
+
+    OutputFilePath.Reset();
+    if (FileWriter.IsOpen())
+    {
+        const FString StreamedPath = FileWriter.GetFilePath();
+        const int64 TargetBytes = Timeline.GetStats().EmittedSamples * static_cast<int64>(sizeof(int16));
+        FileWriter.Close(TrimSamples > 0 ? TargetBytes : -1);
+
+        OutputFilePath = BuildOutputFilePath(OutputDirectory, BaseFileName);
+        if (OutputFilePath != StreamedPath && !IFileManager::Get().Move(*OutputFilePath, *StreamedPath, true, true))
         {
+            UE_LOG(LogOmniCaptureAudio, Warning, TEXT("Failed to move streamed audio %s to %s."), *StreamedPath, *OutputFilePath);
+            OutputFilePath = StreamedPath;
         }
-        PendingPacketCount = 0;
     }
 
+    if (PacketRing.GetDroppedBlockCount() > 0)
+    {
+        UE_LOG(LogOmniCaptureAudio, Warning, TEXT("OmniCapture audio ring dropped %d packets (%lld samples) during capture."), PacketRing.GetDroppedBlockCount(), PacketRing.GetDroppedSampleCount());
+    }
+    PacketRing.Reset();
+
     AudioClockOrigin = -1.0;
     AudioStartTime = 0.0;
-    DroppedPacketCount = 0;
     bLoggedOverflowWarning = false;
     bPaused.Store(false);
 }
 
 void FOmniCaptureAudioRecorder::GatherAudio(double FrameTimestamp, TArray<FOmniAudioPacket>& OutPackets)
 {
-    FScopeLock Lock(&PacketCS);
+    Timeline.AddVideoFrame(FrameTimestamp);
+
+    // Ring timestamps are relative to the first audio callback; move them onto the capture clock.
+    const double ClockOffset = GetAudioToCaptureClockOffset();
+    const double Threshold = FrameTimestamp + (1.0 / 120.0) - ClockOffset;
 
-    const double Threshold = FrameTimestamp + (1.0 / 120.0);
-    for (;;)
+    TArray<FOmniAudioPacket> Gathered;
+    PacketRing.PopUpTo(Threshold, Gathered);
+    for (FOmniAudioPacket& Packet : Gathered)
     {
-        FOmniAudioPacket Packet;
-        if (!PendingPackets.Peek(Packet))
-        {
-            break;
-        }
+        Packet.Timestamp += ClockOffset;
+    }
 
-        if (Packet.Timestamp > Threshold)
+    Timeline.ProcessAudio(Gathered);
+    PaddedSampleCount = Timeline.GetStats().PaddedSamples;
+    TrimmedSampleCount = Timeline.GetStats().TrimmedSamples;
+
+    for (FOmniAudioPacket& Packet : Gathered)
+    {
+        if (FileWriter.IsOpen())
         {
-            break;
+            FileWriter.Enqueue(Packet);
         }
-
-        PendingPackets.Dequeue(Packet);
-        PendingPacketCount.DecrementExchange();
         OutPackets.Add(MoveTemp(Packet));
     }
 }
 
+double FOmniCaptureAudioRecorder::GetAudioToCaptureClockOffset() const
+{
+    const double PlatformOrigin = AudioPlatformOrigin.Load();
+    return PlatformOrigin >= 0.0 ? PlatformOrigin - CaptureClockOrigin : 0.0;
+}
+
 FString FOmniCaptureAudioRecorder::GetDebugStatus() const
 {
-    const int32 Pending = PendingPacketCount.Load();
-    const int32 Dropped = DroppedPacketCount.Load();
+    const int32 Pending = PacketRing.GetPendingBlockCount();
+    const int32 Dropped = PacketRing.GetDroppedBlockCount();
     const FString SubmixName = TargetSubmix.IsValid() ? TargetSubmix->GetName() : TEXT("Master");
-    return FString::Printf(TEXT("AudioPackets:%d Dropped:%d SR:%d Submix:%s"), Pending, Dropped, CachedSampleRate, *SubmixName);
+    return FString::Printf(TEXT("AudioPackets:%d Dropped:%d Padded:%lld Trimmed:%lld SR:%d Submix:%s"), Pending, Dropped, PaddedSampleCount.Load(), TrimmedSampleCount.Load(), CachedSampleRate, *SubmixName);
 }
 
 int32 FOmniCaptureAudioRecorder::GetPendingPacketCount() const
 {
-    return PendingPacketCount.Load();
+    return PacketRing.GetPendingBlockCount();
+}
+
+int32 FOmniCaptureAudioRecorder::GetDroppedPacketCount() const
+{
+    return PacketRing.GetDroppedBlockCount();
 }
 
 void FOmniCaptureAudioRecorder::SetPaused(bool bInPaused)
@@ -176,6 +229,14 @@ void FOmniCaptureAudioRecorder::SetPaused(bool bInPaused)
     bPaused.Store(bInPaused);
 }
 
+FString FOmniCaptureAudioRecorder::BuildOutputFilePath(const FString& OutputDirectory, const FString& BaseFileName) const
+{
+    const FString SanitizedName = BaseFileName.IsEmpty() ? TEXT("OmniCapture") : BaseFileName;
+    FString Directory = OutputDirectory.IsEmpty() ? (FPaths::ProjectSavedDir() / TEXT("OmniCaptures")) : OutputDirectory;
+    Directory = FPaths::ConvertRelativePathToFull(Directory);
+    return Directory / (SanitizedName + TEXT(".wav"));
+}
+
 void FOmniCaptureAudioRecorder::RegisterListener()
 {
 #if WITH_AUDIOMIXER
@@ -228,46 +289,14 @@ void FOmniCaptureAudioRecorder::HandleSubmixBuffer(const float* AudioData, int32
     if (AudioClockOrigin < 0.0)
     {
         AudioClockOrigin = AudioClock;
+        AudioPlatformOrigin.Store(FPlatformTime::Seconds());
     }
 
     const double RelativeTimestamp = FMath::Max(0.0, AudioClock - AudioClockOrigin);
-    FOmniAudioPacket Packet;
-    Packet.Timestamp = RelativeTimestamp;
-    Packet.SampleRate = SampleRate;
-    Packet.NumChannels = NumChannels;
-    Packet.PCM16.SetNumUninitialized(NumSamples);
-
-    for (int32 Index = 0; Index < NumSamples; ++Index)
+    const int32 DroppedSamples = PacketRing.Push(AudioData, NumSamples, NumChannels, SampleRate, RelativeTimestamp, Gain);
+    if (DroppedSamples > 0 && !bLoggedOverflowWarning.Exchange(true))
     {
-        const float SampleValue = AudioData[Index] * Gain;
-        const int32 IntValue = FMath::RoundToInt(SampleValue * 32767.0f);
-        Packet.PCM16[Index] = static_cast<int16>(FMath::Clamp(IntValue, -32768, 32767));
-    }
-
-    {
-        FScopeLock Lock(&PacketCS);
-        bool bDropped = false;
-        while (PendingPacketCount.Load() >= GMaxPendingAudioPackets)
-        {
-            FOmniAudioPacket DiscardedPacket;
-            if (!PendingPackets.Dequeue(DiscardedPacket))
-            {
-                PendingPacketCount = 0;
-                break;
-            }
-
-            PendingPacketCount.DecrementExchange();
-            DroppedPacketCount.IncrementExchange();
-            bDropped = true;
-        }
-
-        PendingPackets.Enqueue(MoveTemp(Packet));
-        PendingPacketCount.IncrementExchange();
-
-        if (bDropped && !bLoggedOverflowWarning.Exchange(true))
-        {
-            UE_LOG(LogOmniCaptureAudio, Warning, TEXT("OmniCapture audio queue overflowed. Dropping oldest packets to keep audio in sync."));
-        }
+        UE_LOG(LogOmniCaptureAudio, Warning, TEXT("OmniCapture audio ring overflowed. Dropping incoming packets until the game thread catches up."));
     }
 #else
     (void)AudioData;
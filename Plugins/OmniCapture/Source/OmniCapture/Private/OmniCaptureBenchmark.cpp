@@ -0,0 +1,426 @@
+#include "OmniCaptureBenchmark.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "OmniCaptureEquirectConverter.h"
+#include "OmniCaptureFrameIndex.h"
+#include "OmniCaptureImageWriter.h"
+#include "OmniCaptureMuxer.h"
+#include "OmniCaptureProjectionRemap.h"
+#include "OmniCaptureRingBuffer.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogOmniCaptureBenchmark, Log, All);
+
+namespace
+{
+    struct FBenchmarkWriterVariant
+    {
+        const TCHAR* Label;
+        EOmniCaptureImageFormat Format;
+        EOmniCapturePNGBitDepth PNGBitDepth;
+        EOmniCaptureGamma Gamma;
+        EOmniCaptureHDRPrecision Precision;
+    };
+
+    // Each writer path the converter output can take: 8-bit formats from sRGB frames, 16-bit and float from linear ones.
+    const FBenchmarkWriterVariant GWriterVariants[] =
+    {
+        { TEXT("PNG8"), EOmniCaptureImageFormat::PNG, EOmniCapturePNGBitDepth::BitDepth8, EOmniCaptureGamma::SRGB, EOmniCaptureHDRPrecision::HalfFloat },
+        { TEXT("PNG16"), EOmniCaptureImageFormat::PNG, EOmniCapturePNGBitDepth::BitDepth16, EOmniCaptureGamma::Linear, EOmniCaptureHDRPrecision::HalfFloat },
+        { TEXT("PNG32"), EOmniCaptureImageFormat::PNG, EOmniCapturePNGBitDepth::BitDepth32, EOmniCaptureGamma::SRGB, EOmniCaptureHDRPrecision::HalfFloat },
+        { TEXT("JPG"), EOmniCaptureImageFormat::JPG, EOmniCapturePNGBitDepth::BitDepth32, EOmniCaptureGamma::SRGB, EOmniCaptureHDRPrecision::HalfFloat },
+        { TEXT("BMP"), EOmniCaptureImageFormat::BMP, EOmniCapturePNGBitDepth::BitDepth32, EOmniCaptureGamma::SRGB, EOmniCaptureHDRPrecision::HalfFloat },
+        { TEXT("EXR16"), EOmniCaptureImageFormat::EXR, EOmniCapturePNGBitDepth::BitDepth32, EOmniCaptureGamma::Linear, EOmniCaptureHDRPrecision::HalfFloat },
+        { TEXT("EXR32"), EOmniCaptureImageFormat::EXR, EOmniCapturePNGBitDepth::BitDepth32, EOmniCaptureGamma::Linear, EOmniCaptureHDRPrecision::FullFloat },
+        { TEXT("Y4M10"), EOmniCaptureImageFormat::Y4M, EOmniCapturePNGBitDepth::BitDepth32, EOmniCaptureGamma::Linear, EOmniCaptureHDRPrecision::HalfFloat },
+    };
+
+    const TCHAR* GetStageKey(EOmniCaptureStage Stage)
+    {
+        switch (Stage)
+        {
+        case EOmniCaptureStage::RigCapture: return TEXT("rigCapture");
+        case EOmniCaptureStage::RenderFlush: return TEXT("renderFlush");
+        case EOmniCaptureStage::Conversion: return TEXT("conversion");
+        case EOmniCaptureStage::AuxiliaryPasses: return TEXT("auxiliaryPasses");
+        case EOmniCaptureStage::Enqueue: return TEXT("enqueue");
+        case EOmniCaptureStage::Preview: return TEXT("preview");
+        case EOmniCaptureStage::WriterEncode: return TEXT("writerEncode");
+        case EOmniCaptureStage::FileWrite: return TEXT("fileWrite");
+        case EOmniCaptureStage::EncoderSubmit: return TEXT("encoderSubmit");
+        case EOmniCaptureStage::Mux: return TEXT("mux");
+        default: return TEXT("unknown");
+        }
+    }
+
+    uint64 SampleUsedPhysical(uint64 PeakSoFar)
+    {
+        return FMath::Max<uint64>(PeakSoFar, FPlatformMemory::GetStats().UsedPhysical);
+    }
+
+    double ToMegabytes(uint64 Bytes)
+    {
+        return static_cast<double>(Bytes) / (1024.0 * 1024.0);
+    }
+}
+
+TArray<FOmniCaptureBenchmarkCase> FOmniCaptureBenchmark::MakeCases(const FOmniCaptureBenchmarkOptions& Options)
+{
+    TArray<FOmniCaptureBenchmarkCase> Cases;
+    for (const int32 Width : Options.OutputWidths)
+    {
+        for (int32 EyeIndex = 0; EyeIndex < 2; ++EyeIndex)
+        {
+            const bool bStereo = EyeIndex == 1;
+            if ((bStereo && !Options.bStereo) || (!bStereo && !Options.bMono))
+            {
+                continue;
+            }
+
+            for (const FBenchmarkWriterVariant& Variant : GWriterVariants)
+            {
+                if (!Options.ImageFormats.Contains(Variant.Format))
+                {
+                    continue;
+                }
+
+                FOmniCaptureBenchmarkCase Case;
+                Case.Name = FString::Printf(TEXT("%dK_%s_%s"), FMath::Max(Width / 1024, 1), bStereo ? TEXT("Stereo") : TEXT("Mono"), Variant.Label);
+                if (!Options.Filter.IsEmpty() && !Case.Name.Contains(Options.Filter))
+                {
+                    continue;
+                }
+
+                FOmniCaptureSettings& Settings = Case.Settings;
+                Settings.Mode = bStereo ? EOmniCaptureMode::Stereo : EOmniCaptureMode::Mono;
+                Settings.StereoLayout = EOmniCaptureStereoLayout::TopBottom;
+                Settings.Projection = EOmniCaptureProjection::Equirectangular;
+                Settings.Resolution = FMath::Max(Width / 2, 16);
+                Settings.bAdaptiveFaceResolution = true;
+                Settings.OutputFormat = EOmniOutputFormat::ImageSequence;
+                Settings.ImageFormat = Variant.Format;
+                Settings.PNGBitDepth = Variant.PNGBitDepth;
+                Settings.Gamma = Variant.Gamma;
+                Settings.HDRPrecision = Variant.Precision;
+                Settings.TargetFrameRate = 30.0f;
+                Settings.RingBufferPolicy = EOmniCaptureRingBufferPolicy::BlockProducer;
+                Settings.bRecordAudio = false;
+                Settings.OutputDirectory = Options.OutputDirectory / Case.Name;
+                Settings.OutputFileName = Case.Name;
+                Cases.Add(MoveTemp(Case));
+            }
+        }
+    }
+    return Cases;
+}
+
+TArray<FOmniCaptureBenchmarkResult> FOmniCaptureBenchmark::Run(const FOmniCaptureBenchmarkOptions& Options)
+{
+    TArray<FOmniCaptureBenchmarkResult> Results;
+    for (const FOmniCaptureBenchmarkCase& Case : MakeCases(Options))
+    {
+        UE_LOG(LogOmniCaptureBenchmark, Display, TEXT("Running %s"), *Case.Name);
+        Results.Add(RunCase(Case, Options));
+
+        const FOmniCaptureBenchmarkResult& Result = Results.Last();
+        if (Result.bSucceeded)
+        {
+            UE_LOG(LogOmniCaptureBenchmark, Display, TEXT("%s: %.2f frames/s, %.1f Mpix/s, peak %.0f MB"), *Result.Name, Result.FramesPerSecond, Result.MegapixelsPerSecond, ToMegabytes(Result.PeakUsedPhysicalBytes));
+        }
+        else
+        {
+            UE_LOG(LogOmniCaptureBenchmark, Error, TEXT("%s failed: %s"), *Result.Name, *Result.Error);
+        }
+    }
+    return Results;
+}
+
+FOmniCaptureBenchmarkResult FOmniCaptureBenchmark::RunCase(const FOmniCaptureBenchmarkCase& Case, const FOmniCaptureBenchmarkOptions& Options)
+{
+    const FOmniCaptureSettings& Settings = Case.Settings;
+
+    FOmniCaptureBenchmarkResult Result;
+    Result.Name = Case.Name;
+    Result.OutputSize = Settings.GetOutputResolution();
+    Result.bStereo = Settings.IsStereo();
+    Result.ImageFormat = Settings.ImageFormat;
+    Result.PeakUsedPhysicalBytes = SampleUsedPhysical(0);
+
+    const FString& Directory = Settings.OutputDirectory;
+    IFileManager::Get().DeleteDirectory(*Directory, false, true);
+    if (!IFileManager::Get().MakeDirectory(*Directory, true))
+    {
+        Result.Error = FString::Printf(TEXT("Could not create %s"), *Directory);
+        return Result;
+    }
+
+    // Inputs are built before the clock starts; only the pipeline is timed.
+    FOmniCaptureCubemapPixels LeftCubemap;
+    FOmniCaptureCubemapPixels RightCubemap;
+    MakeSyntheticCubemap(Settings, 0, LeftCubemap);
+    if (Result.bStereo)
+    {
+        MakeSyntheticCubemap(Settings, 1, RightCubemap);
+    }
+    const EOmniCapturePixelPrecision Precision = Settings.HDRPrecision == EOmniCaptureHDRPrecision::FullFloat ? EOmniCapturePixelPrecision::FullFloat : EOmniCapturePixelPrecision::HalfFloat;
+
+    // The first conversion builds the remap table, which a live capture does once per settings change.
+    if (!FOmniCaptureEquirectConverter::ConvertCubemapsOnCPU(Settings, LeftCubemap, RightCubemap, Precision).PixelData.IsValid())
+    {
+        Result.Error = TEXT("CPU conversion produced no pixels");
+        return Result;
+    }
+    Result.PeakUsedPhysicalBytes = SampleUsedPhysical(Result.PeakUsedPhysicalBytes);
+
+    FOmniCaptureStageTimingHistory History;
+    TAtomic<int64> BytesWritten(0);
+
+    FOmniCaptureFrameIndexWriter IndexWriter;
+    IndexWriter.Open(Directory, Settings.OutputFileName, Settings);
+
+    FOmniCaptureImageWriter ImageWriter;
+    ImageWriter.Initialize(Settings, Directory);
+    ImageWriter.SetFrameWrittenCallback([&IndexWriter, &BytesWritten](int32 FrameIndex, int64 FileSizeBytes)
+    {
+        IndexWriter.AppendEncodedSize(FrameIndex, FileSizeBytes);
+        BytesWritten += FileSizeBytes;
+    });
+    ImageWriter.SetStageTimingCallback([&History](const FOmniCaptureFrameStageTimings& Timings)
+    {
+        History.Record(Timings);
+    });
+
+    const FString Extension = Settings.GetImageFileExtension();
+    TUniquePtr<FOmniCaptureRingBuffer> RingBuffer = MakeUnique<FOmniCaptureRingBuffer>();
+    RingBuffer->Initialize(Settings, [&ImageWriter, &Settings, &Extension](TUniquePtr<FOmniCaptureFrame>&& Frame)
+    {
+        const FString FileName = FString::Printf(TEXT("%s_%06d%s"), *Settings.OutputFileName, Frame->Metadata.FrameIndex, *Extension);
+        ImageWriter.EnqueueFrame(MoveTemp(Frame), FileName);
+    });
+
+    const int32 FrameCount = FMath::Clamp(Options.FramesPerCase, 1, FOmniCaptureStageTimingHistory::Capacity);
+    TArray<FOmniCaptureFrameMetadata> Frames;
+    const double StartSeconds = FPlatformTime::Seconds();
+    for (int32 FrameIndex = 0; FrameIndex < FrameCount; ++FrameIndex)
+    {
+        FOmniCaptureStageScope::ResetThreadTimings();
+        FOmniCaptureEquirectResult Conversion;
+        {
+            OMNICAPTURE_STAGE_SCOPE(Conversion);
+            Conversion = FOmniCaptureEquirectConverter::ConvertCubemapsOnCPU(Settings, LeftCubemap, RightCubemap, Precision);
+            FOmniCaptureEquirectConverter::PackOutputPixels(Settings, Conversion);
+        }
+        Result.PeakUsedPhysicalBytes = SampleUsedPhysical(Result.PeakUsedPhysicalBytes);
+
+        TUniquePtr<FOmniCaptureFrame> Frame = MakeUnique<FOmniCaptureFrame>();
+        Frame->Metadata.FrameIndex = FrameIndex;
+        Frame->Metadata.Timecode = FrameIndex / static_cast<double>(Settings.TargetFrameRate);
+        Frame->Metadata.bKeyFrame = FrameIndex == 0;
+        Frame->PixelData = MoveTemp(Conversion.PixelData);
+        Frame->bLinearColor = Conversion.bIsLinear;
+        Frame->bUsedCPUFallback = true;
+        Frame->PixelPrecision = Conversion.PixelPrecision;
+        Frame->PixelDataType = Conversion.PixelDataType;
+        Frames.Add(Frame->Metadata);
+        IndexWriter.AppendFrame(Frame->Metadata);
+        {
+            OMNICAPTURE_STAGE_SCOPE(Enqueue);
+            RingBuffer->Enqueue(MoveTemp(Frame));
+        }
+        History.Record(FOmniCaptureStageScope::TakeThreadTimings(FrameIndex));
+    }
+
+    RingBuffer->Flush();
+    RingBuffer.Reset();
+    ImageWriter.Flush();
+    Result.WallSeconds = FPlatformTime::Seconds() - StartSeconds;
+    Result.PeakUsedPhysicalBytes = SampleUsedPhysical(Result.PeakUsedPhysicalBytes);
+    IndexWriter.Close();
+
+    if (Options.bMux)
+    {
+        FOmniCaptureMuxer Muxer;
+        Muxer.Initialize(Settings, Directory);
+        FOmniCaptureStageScope::ResetThreadTimings();
+        {
+            OMNICAPTURE_STAGE_SCOPE(Mux);
+            Result.bMuxed = Muxer.FinalizeCapture(Settings, Frames, FString(), FString(), 0);
+        }
+        History.Record(FOmniCaptureStageScope::TakeThreadTimings(INDEX_NONE));
+    }
+
+    Result.Frames = FrameCount;
+    Result.BytesWritten = BytesWritten.Load();
+    const double SafeSeconds = FMath::Max(Result.WallSeconds, static_cast<double>(KINDA_SMALL_NUMBER));
+    Result.FramesPerSecond = FrameCount / SafeSeconds;
+    Result.MegapixelsPerSecond = static_cast<double>(Result.OutputSize.X) * Result.OutputSize.Y * FrameCount / 1.0e6 / SafeSeconds;
+
+    const TArray<FOmniCaptureFrameStageTimings> Recent = History.GetRecent(FrameCount);
+    const FOmniCaptureFrameStageTimings Session = History.GetSessionTimings();
+    for (int32 StageIndex = 0; StageIndex < static_cast<int32>(EOmniCaptureStage::Count); ++StageIndex)
+    {
+        TArray<double> Samples;
+        for (const FOmniCaptureFrameStageTimings& Timings : Recent)
+        {
+            if (Timings.Milliseconds[StageIndex] > 0.0)
+            {
+                Samples.Add(Timings.Milliseconds[StageIndex]);
+            }
+        }
+        if (Session.Milliseconds[StageIndex] > 0.0)
+        {
+            Samples.Add(Session.Milliseconds[StageIndex]);
+        }
+        Result.Stages[StageIndex] = ComputeStageStats(Samples);
+    }
+
+    const int32 WrittenFrames = ImageWriter.GetCapturedFrames().Num();
+    Result.bSucceeded = WrittenFrames == FrameCount && Result.BytesWritten > 0;
+    if (!Result.bSucceeded)
+    {
+        Result.Error = FString::Printf(TEXT("Wrote %d of %d frames"), WrittenFrames, FrameCount);
+    }
+
+    if (!Options.bKeepOutputs)
+    {
+        IFileManager::Get().DeleteDirectory(*Directory, false, true);
+    }
+    return Result;
+}
+
+void FOmniCaptureBenchmark::MakeSyntheticCubemap(const FOmniCaptureSettings& Settings, int32 Seed, FOmniCaptureCubemapPixels& OutCubemap)
+{
+    const FOmniCaptureFaceCoverage Coverage = FOmniCaptureProjectionRemap::ComputeFaceCoverage(Settings);
+    OutCubemap.Resolution = 0;
+    for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+    {
+        const int32 Resolution = FMath::Max(Coverage.FaceSizes[FaceIndex] > 0 ? Coverage.FaceSizes[FaceIndex] : Settings.Resolution, 1);
+        OutCubemap.FaceResolutions[FaceIndex] = Resolution;
+        OutCubemap.Resolution = FMath::Max(OutCubemap.Resolution, Resolution);
+
+        // Smooth gradients compress like real frames; the checker keeps the encoders from collapsing flat areas.
+        TArray<FLinearColor>& Face = OutCubemap.Faces[FaceIndex];
+        Face.SetNumUninitialized(Resolution * Resolution);
+        const float InvResolution = 1.0f / Resolution;
+        const float FaceTint = (FaceIndex + 1) / 7.0f;
+        for (int32 Y = 0; Y < Resolution; ++Y)
+        {
+            for (int32 X = 0; X < Resolution; ++X)
+            {
+                const bool bChecker = (((X + Seed * 7) >> 5) ^ (Y >> 5)) & 1;
+                const float Detail = bChecker ? 0.15f : 0.0f;
+                Face[Y * Resolution + X] = FLinearColor(X * InvResolution * 0.85f + Detail, Y * InvResolution * 0.85f + Detail, FaceTint, 1.0f);
+            }
+        }
+    }
+}
+
+FOmniCaptureBenchmarkStageStats FOmniCaptureBenchmark::ComputeStageStats(TArray<double>& Samples)
+{
+    FOmniCaptureBenchmarkStageStats Stats;
+    Stats.Samples = Samples.Num();
+    if (Samples.Num() == 0)
+    {
+        return Stats;
+    }
+
+    Samples.Sort();
+    double Sum = 0.0;
+    for (const double Sample : Samples)
+    {
+        Sum += Sample;
+    }
+
+    const auto Percentile = [&Samples](double Fraction)
+    {
+        const int32 Rank = FMath::CeilToInt(Fraction * Samples.Num());
+        return Samples[FMath::Clamp(Rank - 1, 0, Samples.Num() - 1)];
+    };
+
+    Stats.MeanMilliseconds = Sum / Samples.Num();
+    Stats.P50Milliseconds = Percentile(0.50);
+    Stats.P90Milliseconds = Percentile(0.90);
+    Stats.P99Milliseconds = Percentile(0.99);
+    Stats.MaxMilliseconds = Samples.Last();
+    return Stats;
+}
+
+TSharedRef<FJsonObject> FOmniCaptureBenchmark::MakeReport(const FOmniCaptureBenchmarkOptions& Options, const TArray<FOmniCaptureBenchmarkResult>& Results)
+{
+    TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetNumberField(TEXT("version"), 1);
+    Report->SetStringField(TEXT("engineVersion"), FEngineVersion::Current().ToString());
+    Report->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+    Report->SetStringField(TEXT("cpu"), FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+    Report->SetNumberField(TEXT("logicalCores"), FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+    Report->SetNumberField(TEXT("framesPerCase"), FMath::Clamp(Options.FramesPerCase, 1, FOmniCaptureStageTimingHistory::Capacity));
+
+    TArray<TSharedPtr<FJsonValue>> CaseValues;
+    for (const FOmniCaptureBenchmarkResult& Result : Results)
+    {
+        TSharedRef<FJsonObject> CaseJson = MakeShared<FJsonObject>();
+        CaseJson->SetStringField(TEXT("name"), Result.Name);
+        CaseJson->SetNumberField(TEXT("width"), Result.OutputSize.X);
+        CaseJson->SetNumberField(TEXT("height"), Result.OutputSize.Y);
+        CaseJson->SetBoolField(TEXT("stereo"), Result.bStereo);
+        CaseJson->SetBoolField(TEXT("succeeded"), Result.bSucceeded);
+        if (!Result.Error.IsEmpty())
+        {
+            CaseJson->SetStringField(TEXT("error"), Result.Error);
+        }
+        CaseJson->SetNumberField(TEXT("frames"), Result.Frames);
+        CaseJson->SetNumberField(TEXT("wallSeconds"), Result.WallSeconds);
+        CaseJson->SetNumberField(TEXT("framesPerSecond"), Result.FramesPerSecond);
+        CaseJson->SetNumberField(TEXT("megapixelsPerSecond"), Result.MegapixelsPerSecond);
+        CaseJson->SetNumberField(TEXT("peakMemoryMB"), ToMegabytes(Result.PeakUsedPhysicalBytes));
+        CaseJson->SetNumberField(TEXT("bytesWritten"), static_cast<double>(Result.BytesWritten));
+        if (Options.bMux)
+        {
+            CaseJson->SetBoolField(TEXT("muxed"), Result.bMuxed);
+        }
+
+        TSharedRef<FJsonObject> StagesJson = MakeShared<FJsonObject>();
+        for (int32 StageIndex = 0; StageIndex < static_cast<int32>(EOmniCaptureStage::Count); ++StageIndex)
+        {
+            const FOmniCaptureBenchmarkStageStats& Stats = Result.Stages[StageIndex];
+            if (Stats.Samples == 0)
+            {
+                continue;
+            }
+
+            TSharedRef<FJsonObject> StageJson = MakeShared<FJsonObject>();
+            StageJson->SetNumberField(TEXT("samples"), Stats.Samples);
+            StageJson->SetNumberField(TEXT("meanMs"), Stats.MeanMilliseconds);
+            StageJson->SetNumberField(TEXT("p50Ms"), Stats.P50Milliseconds);
+            StageJson->SetNumberField(TEXT("p90Ms"), Stats.P90Milliseconds);
+            StageJson->SetNumberField(TEXT("p99Ms"), Stats.P99Milliseconds);
+            StageJson->SetNumberField(TEXT("maxMs"), Stats.MaxMilliseconds);
+            StagesJson->SetObjectField(GetStageKey(static_cast<EOmniCaptureStage>(StageIndex)), StageJson);
+        }
+        CaseJson->SetObjectField(TEXT("stages"), StagesJson);
+        CaseValues.Add(MakeShared<FJsonValueObject>(CaseJson));
+    }
+    Report->SetArrayField(TEXT("cases"), CaseValues);
+    return Report;
+}
+
+bool FOmniCaptureBenchmark::SaveReport(const TSharedRef<FJsonObject>& Report, const FString& FilePath)
+{
+    FString ReportString;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ReportString);
+    if (!FJsonSerializer::Serialize(Report, Writer))
+    {
+        return false;
+    }
+
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+    return FFileHelper::SaveStringToFile(ReportString, *FilePath);
+}
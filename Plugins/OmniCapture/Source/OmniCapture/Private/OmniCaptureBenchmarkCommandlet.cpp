@@ -0,0 +1,116 @@
+#include "OmniCaptureBenchmarkCommandlet.h"
+
+#include "Dom/JsonObject.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "OmniCaptureBenchmark.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogOmniCaptureBenchmarkCommandlet, Log, All);
+
+namespace
+{
+    TArray<FString> ParseList(const FString& Params, const TCHAR* Key)
+    {
+        FString Value;
+        TArray<FString> Items;
+        if (FParse::Value(*Params, Key, Value, false))
+        {
+            Value.ParseIntoArray(Items, TEXT(","), true);
+            for (FString& Item : Items)
+            {
+                Item.TrimStartAndEndInline();
+            }
+        }
+        return Items;
+    }
+
+    bool ParseImageFormat(const FString& Name, EOmniCaptureImageFormat& OutFormat)
+    {
+        const UEnum* Enum = StaticEnum<EOmniCaptureImageFormat>();
+        const int64 Value = Enum ? Enum->GetValueByNameString(Name) : INDEX_NONE;
+        if (Value == INDEX_NONE)
+        {
+            return false;
+        }
+
+        OutFormat = static_cast<EOmniCaptureImageFormat>(Value);
+        return true;
+    }
+}
+
+UOmniCaptureBenchmarkCommandlet::UOmniCaptureBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UOmniCaptureBenchmarkCommandlet::Main(const FString& Params)
+{
+    FOmniCaptureBenchmarkOptions Options;
+    Options.OutputDirectory = FPaths::ProjectSavedDir() / TEXT("OmniCapture") / TEXT("Benchmark");
+
+    const TArray<FString> Widths = ParseList(Params, TEXT("Widths="));
+    if (Widths.Num() > 0)
+    {
+        Options.OutputWidths.Reset();
+        for (const FString& Width : Widths)
+        {
+            Options.OutputWidths.Add(FMath::Max(FCString::Atoi(*Width), 32));
+        }
+    }
+
+    const TArray<FString> Eyes = ParseList(Params, TEXT("Eyes="));
+    if (Eyes.Num() > 0)
+    {
+        Options.bMono = Eyes.Contains(TEXT("Mono"));
+        Options.bStereo = Eyes.Contains(TEXT("Stereo"));
+    }
+
+    const TArray<FString> Formats = ParseList(Params, TEXT("Formats="));
+    if (Formats.Num() > 0)
+    {
+        Options.ImageFormats.Reset();
+        for (const FString& FormatName : Formats)
+        {
+            EOmniCaptureImageFormat Format;
+            if (!ParseImageFormat(FormatName, Format))
+            {
+                UE_LOG(LogOmniCaptureBenchmarkCommandlet, Error, TEXT("Unknown image format '%s'"), *FormatName);
+                return 1;
+            }
+            Options.ImageFormats.AddUnique(Format);
+        }
+    }
+
+    FParse::Value(*Params, TEXT("Frames="), Options.FramesPerCase);
+    FParse::Value(*Params, TEXT("Filter="), Options.Filter);
+    FParse::Value(*Params, TEXT("OutputDir="), Options.OutputDirectory);
+    Options.bMux = !FParse::Param(*Params, TEXT("NoMux"));
+    Options.bKeepOutputs = FParse::Param(*Params, TEXT("KeepOutputs"));
+
+    FString ReportPath = Options.OutputDirectory / TEXT("OmniCaptureBenchmark.json");
+    FParse::Value(*Params, TEXT("Report="), ReportPath);
+
+    const TArray<FOmniCaptureBenchmarkResult> Results = FOmniCaptureBenchmark::Run(Options);
+    if (Results.Num() == 0)
+    {
+        UE_LOG(LogOmniCaptureBenchmarkCommandlet, Error, TEXT("No benchmark cases matched the arguments"));
+        return 1;
+    }
+
+    if (!FOmniCaptureBenchmark::SaveReport(FOmniCaptureBenchmark::MakeReport(Options, Results), ReportPath))
+    {
+        UE_LOG(LogOmniCaptureBenchmarkCommandlet, Error, TEXT("Failed to write %s"), *ReportPath);
+        return 1;
+    }
+    UE_LOG(LogOmniCaptureBenchmarkCommandlet, Display, TEXT("Wrote %d cases to %s"), Results.Num(), *ReportPath);
+
+    int32 FailedCases = 0;
+    for (const FOmniCaptureBenchmarkResult& Result : Results)
+    {
+        FailedCases += Result.bSucceeded ? 0 : 1;
+    }
+    return FailedCases > 0 ? 1 : 0;
+}
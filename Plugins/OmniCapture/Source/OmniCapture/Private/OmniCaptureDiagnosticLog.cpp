@@ -0,0 +1,232 @@
+#include "OmniCaptureDiagnosticLog.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/Archive.h"
+
+namespace
+{
+    const TCHAR* GetDiagnosticLevelName(EOmniCaptureDiagnosticLevel Level)
+    {
+        switch (Level)
+        {
+        case EOmniCaptureDiagnosticLevel::Warning: return TEXT("Warning");
+        case EOmniCaptureDiagnosticLevel::Error: return TEXT("Error");
+        case EOmniCaptureDiagnosticLevel::Info:
+        default: return TEXT("Info");
+        }
+    }
+
+    FString GetRotatedSpillPath(const FString& FilePath)
+    {
+        return FPaths::GetBaseFilename(FilePath, false) + TEXT(".1") + FPaths::GetExtension(FilePath, true);
+    }
+}
+
+FOmniCaptureDiagnosticLog::FOmniCaptureDiagnosticLog(int32 InCapacity)
+    : Capacity(FMath::Max(1, InCapacity))
+{
+    Entries.Reserve(Capacity);
+}
+
+FOmniCaptureDiagnosticLog::~FOmniCaptureDiagnosticLog()
+{
+    FlushSpill();
+    CloseSpillFile();
+}
+
+void FOmniCaptureDiagnosticLog::SetSpillFile(const FString& FilePath, int64 InMaxSpillBytes)
+{
+    FScopeLock SpillLock(&SpillCriticalSection);
+    if (FilePath != SpillFilePath)
+    {
+        // Entries queued for the old file still belong to it.
+        WritePendingSpill(true);
+        CloseSpillFile();
+        SpillFilePath = FilePath;
+    }
+    MaxSpillBytes = FMath::Max<int64>(1024, InMaxSpillBytes);
+
+    FScopeLock Lock(&CriticalSection);
+    bSpillEnabled = !SpillFilePath.IsEmpty();
+}
+
+FString FOmniCaptureDiagnosticLog::GetSpillFilePath() const
+{
+    FScopeLock SpillLock(&SpillCriticalSection);
+    return SpillFilePath;
+}
+
+int64 FOmniCaptureDiagnosticLog::Append(FOmniCaptureDiagnosticEntry Entry)
+{
+    int64 Sequence = 0;
+    bool bWriteBatch = false;
+    {
+        FScopeLock Lock(&CriticalSection);
+        Entry.Sequence = NextSequence++;
+        Sequence = Entry.Sequence;
+
+        if (Entries.Num() < Capacity)
+        {
+            Entries.Add(MoveTemp(Entry));
+            return Sequence;
+        }
+
+        if (bSpillEnabled)
+        {
+            PendingSpill.Add(MoveTemp(Entries[OldestIndex]));
+            bWriteBatch = PendingSpill.Num() >= SpillBatchSize;
+        }
+        Entries[OldestIndex] = MoveTemp(Entry);
+        OldestIndex = (OldestIndex + 1) % Capacity;
+    }
+
+    // The file write happens after the ring lock is released so readers and other appenders never wait on disk.
+    if (bWriteBatch)
+    {
+        FScopeLock SpillLock(&SpillCriticalSection);
+        WritePendingSpill(false);
+    }
+    return Sequence;
+}
+
+int64 FOmniCaptureDiagnosticLog::GetSince(int64 Sequence, TArray<FOmniCaptureDiagnosticEntry>& OutEntries) const
+{
+    FScopeLock Lock(&CriticalSection);
+    OutEntries.Reset();
+
+    const int32 Count = Entries.Num();
+    if (Count > 0)
+    {
+        // Retained sequences are contiguous, so the first new entry's position follows from the oldest one.
+        const int64 OldestSequence = Entries[OldestIndex].Sequence;
+        const int32 FirstOffset = static_cast<int32>(FMath::Clamp<int64>(Sequence + 1 - OldestSequence, 0, Count));
+        OutEntries.Reserve(Count - FirstOffset);
+        for (int32 Offset = FirstOffset; Offset < Count; ++Offset)
+        {
+            OutEntries.Add(Entries[(OldestIndex + Offset) % Count]);
+        }
+    }
+    return NextSequence - 1;
+}
+
+int64 FOmniCaptureDiagnosticLog::GetLatestSequence() const
+{
+    FScopeLock Lock(&CriticalSection);
+    return NextSequence - 1;
+}
+
+int32 FOmniCaptureDiagnosticLog::Num() const
+{
+    FScopeLock Lock(&CriticalSection);
+    return Entries.Num();
+}
+
+void FOmniCaptureDiagnosticLog::Reset()
+{
+    {
+        FScopeLock Lock(&CriticalSection);
+        // Entries leave in the order eviction would have spilled them, so the spill file stays complete across resets.
+        const int32 Count = Entries.Num();
+        if (bSpillEnabled)
+        {
+            PendingSpill.Reserve(PendingSpill.Num() + Count);
+            for (int32 Offset = 0; Offset < Count; ++Offset)
+            {
+                PendingSpill.Add(MoveTemp(Entries[(OldestIndex + Offset) % Count]));
+            }
+        }
+        Entries.Reset();
+        OldestIndex = 0;
+        ++ResetGeneration;
+    }
+
+    FlushSpill();
+}
+
+void FOmniCaptureDiagnosticLog::FlushSpill()
+{
+    FScopeLock SpillLock(&SpillCriticalSection);
+    WritePendingSpill(true);
+}
+
+int32 FOmniCaptureDiagnosticLog::GetResetGeneration() const
+{
+    FScopeLock Lock(&CriticalSection);
+    return ResetGeneration;
+}
+
+FString FOmniCaptureDiagnosticLog::FormatEntry(const FOmniCaptureDiagnosticEntry& Entry)
+{
+    return FString::Printf(TEXT("#%lld %s +%.2fs [%s] Attempt %d | %s: %s"),
+        Entry.Sequence,
+        *Entry.Timestamp.ToString(TEXT("%Y-%m-%d %H:%M:%S")),
+        Entry.SecondsSinceCaptureStart,
+        GetDiagnosticLevelName(Entry.Level),
+        Entry.AttemptIndex,
+        *Entry.Step,
+        *Entry.Message.Replace(TEXT("\n"), TEXT(" ")));
+}
+
+void FOmniCaptureDiagnosticLog::WritePendingSpill(bool bFlush)
+{
+    // The batch is taken while the spill lock is held, so concurrent batches reach the file in eviction order.
+    TArray<FOmniCaptureDiagnosticEntry> Batch;
+    {
+        FScopeLock Lock(&CriticalSection);
+        Swap(Batch, PendingSpill);
+    }
+
+    for (const FOmniCaptureDiagnosticEntry& Entry : Batch)
+    {
+        WriteSpillLine(Entry);
+    }
+    if (bFlush && SpillArchive.IsValid())
+    {
+        SpillArchive->Flush();
+    }
+}
+
+void FOmniCaptureDiagnosticLog::WriteSpillLine(const FOmniCaptureDiagnosticEntry& Entry)
+{
+    if (SpillFilePath.IsEmpty())
+    {
+        return;
+    }
+
+    const FTCHARToUTF8 Line(*(FormatEntry(Entry) + LINE_TERMINATOR));
+
+    if (SpillArchive.IsValid() && SpillArchive->TotalSize() + Line.Length() > MaxSpillBytes)
+    {
+        CloseSpillFile();
+        const FString RotatedPath = GetRotatedSpillPath(SpillFilePath);
+        IFileManager::Get().Delete(*RotatedPath, false, true, true);
+        IFileManager::Get().Move(*RotatedPath, *SpillFilePath, true, true);
+    }
+
+    if (!SpillArchive.IsValid())
+    {
+        IFileManager::Get().MakeDirectory(*FPaths::GetPath(SpillFilePath), true);
+        SpillArchive.Reset(IFileManager::Get().CreateFileWriter(*SpillFilePath, FILEWRITE_Append | FILEWRITE_AllowRead));
+        if (!SpillArchive.IsValid())
+        {
+            // Spilling is best effort; keep the ring working without it.
+            SpillFilePath.Reset();
+            FScopeLock Lock(&CriticalSection);
+            bSpillEnabled = false;
+            return;
+        }
+    }
+
+    SpillArchive->Serialize(const_cast<ANSICHAR*>(Line.Get()), Line.Length());
+}
+
+void FOmniCaptureDiagnosticLog::CloseSpillFile()
+{
+    if (SpillArchive.IsValid())
+    {
+        SpillArchive->Close();
+        SpillArchive.Reset();
+    }
+}
@@ -2,6 +2,9 @@
 
 #include "OmniCaptureIncludeFixes.h" // 统一兼容：TRT2D + TRTResource
 #include "OmniCaptureTypes.h"
+#include "OmniCaptureProjectionRemap.h"
+#include "OmniCaptureODS.h"
+#include "OmniCapturePixelPacking.h"
 
 #include "GlobalShader.h"
 #include "PixelShaderUtils.h"
@@ -117,6 +120,7 @@ namespace
             SHADER_PARAMETER(float, Padding)
             SHADER_PARAMETER(float, LongitudeSpan)
             SHADER_PARAMETER(float, LatitudeSpan)
+            SHADER_PARAMETER_ARRAY(FVector4f, FaceUVScale, [6])
             SHADER_PARAMETER_SAMPLER(SamplerState, FaceSampler)
             SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture2DArray<float4>, LeftFaces)
             SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture2DArray<float4>, RightFaces)
@@ -147,6 +151,7 @@ namespace
             SHADER_PARAMETER(int32, bHalfSphere)
             SHADER_PARAMETER(float, SeamStrength)
             SHADER_PARAMETER(float, Padding)
+            SHADER_PARAMETER_ARRAY(FVector4f, FaceUVScale, [6])
             SHADER_PARAMETER_SAMPLER(SamplerState, FaceSampler)
             SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture2DArray<float4>, LeftFaces)
             SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture2DArray<float4>, RightFaces)
@@ -161,6 +166,89 @@ namespace
 
     IMPLEMENT_GLOBAL_SHADER(FOmniFisheyeCS, "/Plugin/OmniCapture/Private/OmniFisheyeCS.usf", "MainCS", SF_Compute);
 
+    class FOmniProjectionRemapCS final : public FGlobalShader
+    {
+    public:
+        DECLARE_GLOBAL_SHADER(FOmniProjectionRemapCS);
+        SHADER_USE_PARAMETER_STRUCT(FOmniProjectionRemapCS, FGlobalShader);
+
+        BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+            SHADER_PARAMETER(FVector2f, OutputResolution)
+            SHADER_PARAMETER(FIntPoint, EyeResolution)
+            SHADER_PARAMETER(int32, bStereo)
+            SHADER_PARAMETER(int32, StereoLayout)
+            SHADER_PARAMETER(int32, TapsPerPixel)
+            SHADER_PARAMETER_ARRAY(FVector4f, FaceUVScale, [6])
+            SHADER_PARAMETER_SAMPLER(SamplerState, FaceSampler)
+            SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture2DArray<float4>, LeftFaces)
+            SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture2DArray<float4>, RightFaces)
+            SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, RemapTable)
+            SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, OutputTexture)
+        END_SHADER_PARAMETER_STRUCT()
+
+        static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+        {
+            return true;
+        }
+    };
+
+    IMPLEMENT_GLOBAL_SHADER(FOmniProjectionRemapCS, "/Plugin/OmniCapture/Private/OmniProjectionRemapCS.usf", "MainCS", SF_Compute);
+
+    class FOmniProjectionRemapLayersCS final : public FGlobalShader
+    {
+    public:
+        DECLARE_GLOBAL_SHADER(FOmniProjectionRemapLayersCS);
+        SHADER_USE_PARAMETER_STRUCT(FOmniProjectionRemapLayersCS, FGlobalShader);
+
+        BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+            SHADER_PARAMETER(FVector2f, OutputResolution)
+            SHADER_PARAMETER(FIntPoint, EyeResolution)
+            SHADER_PARAMETER(int32, bStereo)
+            SHADER_PARAMETER(int32, StereoLayout)
+            SHADER_PARAMETER(int32, TapsPerPixel)
+            SHADER_PARAMETER(int32, LayerCount)
+            SHADER_PARAMETER_ARRAY(FVector4f, FaceUVScale, [6])
+            SHADER_PARAMETER_SAMPLER(SamplerState, FaceSampler)
+            SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture2DArray<float4>, LeftFaces)
+            SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture2DArray<float4>, RightFaces)
+            SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, RemapTable)
+            SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, OutputTexture)
+        END_SHADER_PARAMETER_STRUCT()
+
+        static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+        {
+            return true;
+        }
+    };
+
+    IMPLEMENT_GLOBAL_SHADER(FOmniProjectionRemapLayersCS, "/Plugin/OmniCapture/Private/OmniProjectionRemapLayersCS.usf", "MainCS", SF_Compute);
+
+    class FOmniODSStitchCS final : public FGlobalShader
+    {
+    public:
+        DECLARE_GLOBAL_SHADER(FOmniODSStitchCS);
+        SHADER_USE_PARAMETER_STRUCT(FOmniODSStitchCS, FGlobalShader);
+
+        BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+            SHADER_PARAMETER(FVector2f, OutputResolution)
+            SHADER_PARAMETER(FIntPoint, EyeResolution)
+            SHADER_PARAMETER(int32, bStereo)
+            SHADER_PARAMETER(int32, StereoLayout)
+            SHADER_PARAMETER_SAMPLER(SamplerState, ViewSampler)
+            SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture2DArray<float4>, LeftViews)
+            SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture2DArray<float4>, RightViews)
+            SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, StitchTable)
+            SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, OutputTexture)
+        END_SHADER_PARAMETER_STRUCT()
+
+        static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+        {
+            return true;
+        }
+    };
+
+    IMPLEMENT_GLOBAL_SHADER(FOmniODSStitchCS, "/Plugin/OmniCapture/Private/OmniODSStitchCS.usf", "MainCS", SF_Compute);
+
     class FOmniConvertToYUVLumaCS final : public FGlobalShader
     {
     public:
@@ -236,13 +324,87 @@ namespace
 
     IMPLEMENT_GLOBAL_SHADER(FOmniConvertToBGRACS, "/Plugin/OmniCapture/Private/OmniColorConvertCS.usf", "ConvertBGRA", SF_Compute);
 
-    bool ReadFaceData(UTextureRenderTarget2D* RenderTarget, FCPUFaceData& OutFace)
+    /** Where a face render target lands inside its full face, and that face's edge length in texels. */
+    struct FFaceCopyRegion
+    {
+        FIntRect Rect;
+        int32 FaceSize = 0;
+    };
+
+    int32 GetFaceSize(const FOmniCaptureFaceResources& Face, int32 FaceResolution)
+    {
+        return Face.FaceSize > 0 ? Face.FaceSize : FaceResolution;
+    }
+
+    /** Rect is empty when the rig skipped the face. */
+    FFaceCopyRegion GetFaceCopyRegion(const FOmniCaptureFaceResources& Face, int32 FaceResolution)
+    {
+        FFaceCopyRegion Region;
+        Region.FaceSize = GetFaceSize(Face, FaceResolution);
+        if (Face.bRendered)
+        {
+            Region.Rect = Face.ValidRect.Area() > 0 ? Face.ValidRect : FIntRect(0, 0, Region.FaceSize, Region.FaceSize);
+        }
+        return Region;
+    }
+
+    /** Reads a whole render target as linear colour. Anything but full float comes back at half precision. */
+    bool ReadRenderTargetPixels(FTextureRenderTargetResource* Resource, EOmniCapturePixelPrecision& InOutPrecision, TArray<FLinearColor>& OutPixels)
+    {
+        // Use the standard UNorm readback mode instead of the Min/Max resolve
+        // path.  RCM_MinMax performs additional math on the HDR buffer which
+        // skews the colour channels when we subsequently treat the data as
+        // regular colour pixels.  That manifested as a visible green tint in
+        // 2D captures.  RCM_UNorm leaves the pixel values untouched so that
+        // our later linear → sRGB conversions behave correctly.
+        FReadSurfaceDataFlags Flags(RCM_UNorm);
+        Flags.SetLinearToGamma(false);
+
+        if (InOutPrecision == EOmniCapturePixelPrecision::FullFloat)
+        {
+            return Resource->ReadLinearColorPixels(OutPixels, Flags, FIntRect());
+        }
+
+        TArray<FFloat16Color> HalfPixels;
+        if (!Resource->ReadFloat16Pixels(HalfPixels, Flags, FIntRect()))
+        {
+            return false;
+        }
+
+        InOutPrecision = EOmniCapturePixelPrecision::HalfFloat;
+        OutPixels.SetNum(HalfPixels.Num());
+        for (int32 Index = 0; Index < HalfPixels.Num(); ++Index)
+        {
+            OutPixels[Index] = FLinearColor(HalfPixels[Index]);
+        }
+        return true;
+    }
+
+    bool ReadFaceData(const FOmniCaptureFaceResources& Face, int32 FaceResolution, FCPUFaceData& OutFace)
     {
+        UTextureRenderTarget2D* RenderTarget = Face.RenderTarget;
         if (!RenderTarget)
         {
             return false;
         }
 
+        const FFaceCopyRegion Region = GetFaceCopyRegion(Face, FaceResolution);
+        const FIntRect& Rect = Region.Rect;
+        const int32 FaceSize = Region.FaceSize;
+        const bool bCropped = Rect != FIntRect(0, 0, FaceSize, FaceSize);
+
+        OutFace.Pixels.Reset();
+        OutFace.Precision = PixelPrecisionFromFormat(RenderTarget->GetFormat());
+
+        if (Rect.Area() <= 0)
+        {
+            // Skipped face: nothing samples it, so keep it black like the GPU face array.
+            OutFace.Precision = OutFace.Precision == EOmniCapturePixelPrecision::FullFloat ? EOmniCapturePixelPrecision::FullFloat : EOmniCapturePixelPrecision::HalfFloat;
+            OutFace.Pixels.SetNumZeroed(FaceSize * FaceSize);
+            OutFace.Resolution = FaceSize;
+            return OutFace.IsValid();
+        }
+
         FTextureRenderTargetResource* Resource = RenderTarget->GameThread_GetRenderTargetResource();
         if (!Resource)
         {
@@ -251,57 +413,46 @@ namespace
 
         const int32 SizeX = RenderTarget->SizeX;
         const int32 SizeY = RenderTarget->SizeY;
-        if (SizeX <= 0 || SizeY <= 0 || SizeX != SizeY)
+        if (SizeX <= 0 || SizeY <= 0 || (bCropped ? Rect.Size() != FIntPoint(SizeX, SizeY) : SizeX != SizeY))
         {
             return false;
         }
 
-        OutFace.Pixels.Reset();
-        OutFace.Precision = PixelPrecisionFromFormat(RenderTarget->GetFormat());
-
-        // Use the standard UNorm readback mode instead of the Min/Max resolve
-        // path.  RCM_MinMax performs additional math on the HDR buffer which
-        // skews the colour channels when we subsequently treat the data as
-        // regular colour pixels.  That manifested as a visible green tint in
-        // 2D captures.  RCM_UNorm leaves the pixel values untouched so that
-        // our later linear → sRGB conversions behave correctly.
-        FReadSurfaceDataFlags Flags(RCM_UNorm);
-        Flags.SetLinearToGamma(false);
-
-        if (OutFace.Precision == EOmniCapturePixelPrecision::FullFloat)
+        if (!ReadRenderTargetPixels(Resource, OutFace.Precision, OutFace.Pixels))
         {
-            if (!Resource->ReadLinearColorPixels(OutFace.Pixels, Flags, FIntRect()))
-            {
-                return false;
-            }
+            return false;
         }
-        else
+
+        if (bCropped)
         {
-            TArray<FFloat16Color> HalfPixels;
-            if (!Resource->ReadFloat16Pixels(HalfPixels, Flags, FIntRect()))
+            if (OutFace.Pixels.Num() != SizeX * SizeY)
             {
                 return false;
             }
 
-            OutFace.Precision = EOmniCapturePixelPrecision::HalfFloat;
-            OutFace.Pixels.SetNum(HalfPixels.Num());
-            for (int32 Index = 0; Index < HalfPixels.Num(); ++Index)
+            // Embed the cropped render into an otherwise black face so sampling sees full-face coordinates.
+            TArray<FLinearColor> FacePixels;
+            FacePixels.SetNumZeroed(FaceSize * FaceSize);
+            for (int32 Row = 0; Row < SizeY; ++Row)
             {
-                OutFace.Pixels[Index] = FLinearColor(HalfPixels[Index]);
+                FMemory::Memcpy(&FacePixels[(Rect.Min.Y + Row) * FaceSize + Rect.Min.X], &OutFace.Pixels[Row * SizeX], SizeX * sizeof(FLinearColor));
             }
+            OutFace.Pixels = MoveTemp(FacePixels);
+            OutFace.Resolution = FaceSize;
+            return OutFace.IsValid();
         }
 
         OutFace.Resolution = SizeX;
         return OutFace.IsValid();
     }
 
-    bool BuildCPUCubemap(const FOmniEyeCapture& Eye, FCPUCubemap& OutCubemap)
+    bool BuildCPUCubemap(const FOmniEyeCapture& Eye, int32 FaceResolution, FCPUCubemap& OutCubemap)
     {
         OutCubemap.Precision = EOmniCapturePixelPrecision::Unknown;
 
         for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
         {
-            if (!ReadFaceData(Eye.Faces[FaceIndex].RenderTarget, OutCubemap.Faces[FaceIndex]))
+            if (!ReadFaceData(Eye.Faces[FaceIndex], FaceResolution, OutCubemap.Faces[FaceIndex]))
             {
                 return false;
             }
@@ -425,19 +576,31 @@ namespace
         OutUV.Y = FMath::Clamp(OutUV.Y, 0.0f, 1.0f);
     }
 
-    FLinearColor SampleCubemapCPU(const FCPUCubemap& Cubemap, const FVector& Direction, int32 FaceResolution, float SeamStrength)
+    /** Face texel a direction reads. Stereo cubemaps come from one rig and share face sizes, so one lookup serves both eyes. */
+    struct FCPUCubemapTexel
     {
         uint32 FaceIndex = 0;
+        int32 SampleIndex = INDEX_NONE;
+    };
+
+    FCPUCubemapTexel LocateCubemapTexelCPU(const FCPUCubemap& Cubemap, const FVector& Direction, int32 FaceResolution, float SeamStrength)
+    {
+        FCPUCubemapTexel Texel;
         FVector2D FaceUV = FVector2D::ZeroVector;
-        DirectionToFaceUVCPU(Direction, FaceIndex, FaceUV, FaceResolution, SeamStrength);
+        DirectionToFaceUVCPU(Direction, Texel.FaceIndex, FaceUV, FaceResolution, SeamStrength);
 
-        const FCPUFaceData& Face = Cubemap.Faces[FaceIndex];
+        const FCPUFaceData& Face = Cubemap.Faces[Texel.FaceIndex];
         const int32 SampleX = FMath::Clamp(static_cast<int32>(FaceUV.X * (Face.Resolution - 1)), 0, Face.Resolution - 1);
         const int32 SampleY = FMath::Clamp(static_cast<int32>(FaceUV.Y * (Face.Resolution - 1)), 0, Face.Resolution - 1);
-        const int32 SampleIndex = SampleY * Face.Resolution + SampleX;
+        Texel.SampleIndex = SampleY * Face.Resolution + SampleX;
+        return Texel;
+    }
 
-        return Face.Pixels.IsValidIndex(SampleIndex)
-            ? FLinearColor(Face.Pixels[SampleIndex])
+    FLinearColor FetchCubemapTexelCPU(const FCPUCubemap& Cubemap, const FCPUCubemapTexel& Texel)
+    {
+        const FCPUFaceData& Face = Cubemap.Faces[Texel.FaceIndex];
+        return Face.Pixels.IsValidIndex(Texel.SampleIndex)
+            ? FLinearColor(Face.Pixels[Texel.SampleIndex])
             : FLinearColor::Black;
     }
 
@@ -568,19 +731,56 @@ namespace
         return OutputTexture;
     }
 
-    FRDGTextureRef BuildFaceArray(FRDGBuilder& GraphBuilder, const TArray<FTextureRHIRef, TInlineAllocator<6>>& Faces, int32 FaceResolution, EPixelFormat PixelFormat, const TCHAR* DebugName)
+    /**
+     * Copies each face into one slice of a texture array sized for the largest face. Smaller faces sit in the
+     * slice's top-left corner; OutFaceUVScale tells the shaders how to address them (see FaceUVToArrayUV).
+     */
+    FRDGTextureRef BuildFaceArray(FRDGBuilder& GraphBuilder, const TArray<FTextureRHIRef, TInlineAllocator<6>>& Faces, const TArray<FFaceCopyRegion, TInlineAllocator<6>>& FaceRegions, int32 FaceResolution, EPixelFormat PixelFormat, const TCHAR* DebugName, FVector4f (&OutFaceUVScale)[6])
     {
+        for (FVector4f& Scale : OutFaceUVScale)
+        {
+            Scale = FVector4f(1.0f, 1.0f, 0.0f, 0.0f);
+        }
+
         if (Faces.Num() == 0)
         {
             return nullptr;
         }
 
-        FRDGTextureDesc ArrayDesc = FRDGTextureDesc::Create2DArray(FIntPoint(FaceResolution, FaceResolution), PixelFormat, FClearValueBinding::Transparent, TexCreate_ShaderResource | TexCreate_UAV, Faces.Num());
+        int32 ArraySize = 0;
+        for (int32 Index = 0; Index < Faces.Num(); ++Index)
+        {
+            ArraySize = FMath::Max(ArraySize, FaceRegions.IsValidIndex(Index) ? FaceRegions[Index].FaceSize : FaceResolution);
+        }
+        ArraySize = FMath::Max(1, ArraySize);
+
+        FRDGTextureDesc ArrayDesc = FRDGTextureDesc::Create2DArray(FIntPoint(ArraySize, ArraySize), PixelFormat, FClearValueBinding::Transparent, TexCreate_ShaderResource | TexCreate_UAV, Faces.Num());
         FRDGTextureRef ArrayTexture = GraphBuilder.CreateTexture(ArrayDesc, DebugName);
 
+        bool bHasPartialFaces = false;
+        for (int32 Index = 0; Index < Faces.Num(); ++Index)
+        {
+            const int32 FaceSize = FaceRegions.IsValidIndex(Index) ? FaceRegions[Index].FaceSize : ArraySize;
+            const FIntRect Rect = FaceRegions.IsValidIndex(Index) ? FaceRegions[Index].Rect : FIntRect(0, 0, ArraySize, ArraySize);
+            bHasPartialFaces |= FaceSize != ArraySize || Rect != FIntRect(0, 0, ArraySize, ArraySize);
+
+            // x scales face UV into the slice, y clamps taps to the face's last texel centre so they never read past it.
+            if (Index < UE_ARRAY_COUNT(OutFaceUVScale) && FaceSize > 0)
+            {
+                OutFaceUVScale[Index] = FVector4f(static_cast<float>(FaceSize) / ArraySize, (FaceSize - 0.5f) / FaceSize, 0.0f, 0.0f);
+            }
+        }
+
+        // Texels outside the rendered rects are never sampled; clear them so the array holds no stale data.
+        if (bHasPartialFaces)
+        {
+            AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(ArrayTexture), FLinearColor::Transparent);
+        }
+
         for (int32 Index = 0; Index < Faces.Num(); ++Index)
         {
-            if (!Faces[Index].IsValid())
+            const FIntRect Rect = FaceRegions.IsValidIndex(Index) ? FaceRegions[Index].Rect : FIntRect(0, 0, ArraySize, ArraySize);
+            if (!Faces[Index].IsValid() || Rect.Area() <= 0)
             {
                 continue;
             }
@@ -590,6 +790,11 @@ namespace
             CopyInfo.SourceSliceIndex = 0;
             CopyInfo.DestSliceIndex = Index;
             CopyInfo.NumSlices = 1;
+            if (Rect != FIntRect(0, 0, ArraySize, ArraySize))
+            {
+                CopyInfo.Size = FIntVector(Rect.Width(), Rect.Height(), 1);
+                CopyInfo.DestPosition = FIntVector(Rect.Min.X, Rect.Min.Y, 0);
+            }
 
             AddCopyTexturePass(GraphBuilder, SourceTexture, ArrayTexture, CopyInfo);
         }
@@ -597,7 +802,7 @@ namespace
         return ArrayTexture;
     }
 
-    void ConvertOnRenderThread(const FOmniCaptureSettings Settings, const TArray<FTextureRHIRef, TInlineAllocator<6>> LeftFaces, const TArray<FTextureRHIRef, TInlineAllocator<6>> RightFaces, FOmniCaptureEquirectResult& OutResult)
+    void ConvertOnRenderThread(const FOmniCaptureSettings Settings, const TArray<FTextureRHIRef, TInlineAllocator<6>> LeftFaces, const TArray<FTextureRHIRef, TInlineAllocator<6>> RightFaces, const TArray<FFaceCopyRegion, TInlineAllocator<6>> LeftRegions, const TArray<FFaceCopyRegion, TInlineAllocator<6>> RightRegions, FOmniCaptureEquirectResult& OutResult)
     {
         const int32 FaceResolution = Settings.Resolution;
         const bool bStereo = Settings.Mode == EOmniCaptureMode::Stereo;
@@ -623,8 +828,14 @@ namespace
 
         const EPixelFormat FacePixelFormat = GetPixelFormatForPrecision(Precision);
 
-        FRDGTextureRef LeftArray = BuildFaceArray(GraphBuilder, LeftFaces, FaceResolution, FacePixelFormat, TEXT("OmniLeftFaces"));
-        FRDGTextureRef RightArray = bStereo ? BuildFaceArray(GraphBuilder, RightFaces, FaceResolution, FacePixelFormat, TEXT("OmniRightFaces")) : LeftArray;
+        // Both eyes come from the same rig, so their faces share sizes and the left scales serve both arrays.
+
+        FVector4f FaceUVScale[6];
+
+        FVector4f RightFaceUVScale[6];
+
+        FRDGTextureRef LeftArray = BuildFaceArray(GraphBuilder, LeftFaces, LeftRegions, FaceResolution, FacePixelFormat, TEXT("OmniLeftFaces"), FaceUVScale);
+        FRDGTextureRef RightArray = bStereo ? BuildFaceArray(GraphBuilder, RightFaces, RightRegions, FaceResolution, FacePixelFormat, TEXT("OmniRightFaces"), RightFaceUVScale) : LeftArray;
 
         if (!LeftArray)
         {
@@ -646,15 +857,22 @@ namespace
         Parameters->LongitudeSpan = LongitudeSpan;
         Parameters->LatitudeSpan = LatitudeSpan;
         Parameters->bHalfSphere = bHalfSphere ? 1 : 0;
+        for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+        {
+            Parameters->FaceUVScale[FaceIndex] = FaceUVScale[FaceIndex];
+        }
         Parameters->LeftFaces = GraphBuilder.CreateSRV(FRDGTextureSRVDesc::Create(LeftArray));
         Parameters->RightFaces = GraphBuilder.CreateSRV(FRDGTextureSRVDesc::Create(RightArray));
         Parameters->FaceSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
         Parameters->OutputTexture = GraphBuilder.CreateUAV(OutputTexture);
 
+        // One thread per eye pixel; stereo threads write both halves.
+        const bool bSideBySide = bStereo && Settings.StereoLayout == EOmniCaptureStereoLayout::SideBySide;
+        const bool bTopBottom = bStereo && !bSideBySide;
         TShaderMapRef<FOmniEquirectCS> ComputeShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
         const FIntVector GroupCount(
-            FMath::DivideAndRoundUp(OutputWidth, 8),
-            FMath::DivideAndRoundUp(OutputHeight, 8),
+            FMath::DivideAndRoundUp(bSideBySide ? OutputWidth / 2 : OutputWidth, 8),
+            FMath::DivideAndRoundUp(bTopBottom ? OutputHeight / 2 : OutputHeight, 8),
             1);
 
         FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("OmniCapture::Equirect"), ComputeShader, Parameters, GroupCount);
@@ -775,16 +993,6 @@ namespace
 
                     OutResult.PixelData = MoveTemp(PixelData);
                     OutResult.PixelDataType = EOmniCapturePixelDataType::LinearColorFloat32;
-
-                    OutResult.PreviewPixels.SetNum(PixelCount);
-                    const TImagePixelData<FLinearColor>* FloatData = static_cast<const TImagePixelData<FLinearColor>*>(OutResult.PixelData.Get());
-                    if (FloatData)
-                    {
-                        for (uint32 Index = 0; Index < PixelCount; ++Index)
-                        {
-                            OutResult.PreviewPixels[Index] = FloatData->Pixels[Index].ToFColor(true);
-                        }
-                    }
                 }
                 else
                 {
@@ -801,25 +1009,12 @@ namespace
 
                     OutResult.PixelData = MoveTemp(PixelData);
                     OutResult.PixelDataType = EOmniCapturePixelDataType::LinearColorFloat16;
-
-                    OutResult.PreviewPixels.SetNum(PixelCount);
-                    const TImagePixelData<FFloat16Color>* FloatData = static_cast<const TImagePixelData<FFloat16Color>*>(OutResult.PixelData.Get());
-                    if (FloatData)
-                    {
-                        for (uint32 Index = 0; Index < PixelCount; ++Index)
-                        {
-                            const FFloat16Color& Source = FloatData->Pixels[Index];
-                            const FLinearColor Linear(Source.R.GetFloat(), Source.G.GetFloat(), Source.B.GetFloat(), Source.A.GetFloat());
-                            OutResult.PreviewPixels[Index] = Linear.ToFColor(true);
-                        }
-                    }
                 }
             }
             else
             {
                 TUniquePtr<TImagePixelData<FColor>> PixelData = MakeUnique<TImagePixelData<FColor>>(FIntPoint(OutputWidth, OutputHeight));
                 PixelData->Pixels.SetNum(PixelCount);
-                OutResult.PreviewPixels.SetNum(PixelCount);
 
                 const uint8* SourcePixels = RawData;
                 for (int32 Row = 0; Row < OutputHeight; ++Row)
@@ -839,9 +1034,7 @@ namespace
                             const FFloat16Color* Pixel = reinterpret_cast<const FFloat16Color*>(SourceRow) + Column;
                             Linear = FLinearColor(Pixel->R.GetFloat(), Pixel->G.GetFloat(), Pixel->B.GetFloat(), Pixel->A.GetFloat());
                         }
-                        const FColor SRGB = Linear.ToFColor(true);
-                        DestRow[Column] = SRGB;
-                        OutResult.PreviewPixels[Row * OutputWidth + Column] = SRGB;
+                        DestRow[Column] = Linear.ToFColor(true);
                     }
                 }
 
@@ -854,7 +1047,7 @@ namespace
         OutResult.PixelPrecision = Precision;
     }
 
-    void ConvertFisheyeOnRenderThread(const FOmniCaptureSettings Settings, const TArray<FTextureRHIRef, TInlineAllocator<6>> LeftFaces, const TArray<FTextureRHIRef, TInlineAllocator<6>> RightFaces, FOmniCaptureEquirectResult& OutResult)
+    void ConvertFisheyeOnRenderThread(const FOmniCaptureSettings Settings, const TArray<FTextureRHIRef, TInlineAllocator<6>> LeftFaces, const TArray<FTextureRHIRef, TInlineAllocator<6>> RightFaces, const TArray<FFaceCopyRegion, TInlineAllocator<6>> LeftRegions, const TArray<FFaceCopyRegion, TInlineAllocator<6>> RightRegions, FOmniCaptureEquirectResult& OutResult)
     {
         const int32 FaceResolution = Settings.Resolution;
         const bool bStereo = Settings.Mode == EOmniCaptureMode::Stereo;
@@ -877,8 +1070,14 @@ namespace
 
         const EPixelFormat FacePixelFormat = GetPixelFormatForPrecision(Precision);
 
-        FRDGTextureRef LeftArray = BuildFaceArray(GraphBuilder, LeftFaces, FaceResolution, FacePixelFormat, TEXT("OmniFisheyeLeftFaces"));
-        FRDGTextureRef RightArray = bStereo ? BuildFaceArray(GraphBuilder, RightFaces, FaceResolution, FacePixelFormat, TEXT("OmniFisheyeRightFaces")) : LeftArray;
+        // Both eyes come from the same rig, so their faces share sizes and the left scales serve both arrays.
+
+        FVector4f FaceUVScale[6];
+
+        FVector4f RightFaceUVScale[6];
+
+        FRDGTextureRef LeftArray = BuildFaceArray(GraphBuilder, LeftFaces, LeftRegions, FaceResolution, FacePixelFormat, TEXT("OmniFisheyeLeftFaces"), FaceUVScale);
+        FRDGTextureRef RightArray = bStereo ? BuildFaceArray(GraphBuilder, RightFaces, RightRegions, FaceResolution, FacePixelFormat, TEXT("OmniFisheyeRightFaces"), RightFaceUVScale) : LeftArray;
 
         if (!LeftArray)
         {
@@ -899,15 +1098,20 @@ namespace
         Parameters->bHalfSphere = bHalfSphere ? 1 : 0;
         Parameters->SeamStrength = Settings.SeamBlend;
         Parameters->Padding = 0.0f;
+        for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+        {
+            Parameters->FaceUVScale[FaceIndex] = FaceUVScale[FaceIndex];
+        }
         Parameters->LeftFaces = GraphBuilder.CreateSRV(FRDGTextureSRVDesc::Create(LeftArray));
         Parameters->RightFaces = GraphBuilder.CreateSRV(FRDGTextureSRVDesc::Create(RightArray));
         Parameters->FaceSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
         Parameters->OutputTexture = GraphBuilder.CreateUAV(OutputTexture);
 
+        // One thread per eye pixel; stereo threads write both halves.
         TShaderMapRef<FOmniFisheyeCS> ComputeShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
         const FIntVector GroupCount(
-            FMath::DivideAndRoundUp(OutputSize.X, 8),
-            FMath::DivideAndRoundUp(OutputSize.Y, 8),
+            FMath::DivideAndRoundUp(FMath::Min(EyeSize.X, OutputSize.X), 8),
+            FMath::DivideAndRoundUp(FMath::Min(EyeSize.Y, OutputSize.Y), 8),
             1);
 
         FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("OmniCapture::Fisheye"), ComputeShader, Parameters, GroupCount);
@@ -1045,16 +1249,6 @@ namespace
 
                     OutResult.PixelData = MoveTemp(PixelData);
                     OutResult.PixelDataType = EOmniCapturePixelDataType::LinearColorFloat32;
-
-                    OutResult.PreviewPixels.SetNum(PixelCount);
-                    const TImagePixelData<FLinearColor>* FloatData = static_cast<const TImagePixelData<FLinearColor>*>(OutResult.PixelData.Get());
-                    if (FloatData)
-                    {
-                        for (uint32 Index = 0; Index < PixelCount; ++Index)
-                        {
-                            OutResult.PreviewPixels[Index] = FloatData->Pixels[Index].ToFColor(true);
-                        }
-                    }
                 }
                 else
                 {
@@ -1071,25 +1265,12 @@ namespace
 
                     OutResult.PixelData = MoveTemp(PixelData);
                     OutResult.PixelDataType = EOmniCapturePixelDataType::LinearColorFloat16;
-
-                    OutResult.PreviewPixels.SetNum(PixelCount);
-                    const TImagePixelData<FFloat16Color>* FloatData = static_cast<const TImagePixelData<FFloat16Color>*>(OutResult.PixelData.Get());
-                    if (FloatData)
-                    {
-                        for (uint32 Index = 0; Index < PixelCount; ++Index)
-                        {
-                            const FFloat16Color& Source = FloatData->Pixels[Index];
-                            const FLinearColor Linear(Source.R.GetFloat(), Source.G.GetFloat(), Source.B.GetFloat(), Source.A.GetFloat());
-                            OutResult.PreviewPixels[Index] = Linear.ToFColor(true);
-                        }
-                    }
                 }
             }
             else
             {
                 TUniquePtr<TImagePixelData<FColor>> PixelData = MakeUnique<TImagePixelData<FColor>>(OutputSize);
                 PixelData->Pixels.SetNum(PixelCount);
-                OutResult.PreviewPixels.SetNum(PixelCount);
 
                 const uint8* SourcePixels = RawData;
                 for (int32 Row = 0; Row < OutputSize.Y; ++Row)
@@ -1109,9 +1290,7 @@ namespace
                             const FFloat16Color* Pixel = reinterpret_cast<const FFloat16Color*>(SourceRow) + Column;
                             Linear = FLinearColor(Pixel->R.GetFloat(), Pixel->G.GetFloat(), Pixel->B.GetFloat(), Pixel->A.GetFloat());
                         }
-                        const FColor SRGB = Linear.ToFColor(true);
-                        DestRow[Column] = SRGB;
-                        OutResult.PreviewPixels[Row * OutputSize.X + Column] = SRGB;
+                        DestRow[Column] = Linear.ToFColor(true);
                     }
                 }
 
@@ -1237,7 +1416,7 @@ namespace
     void ConvertOnCPU(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye, FOmniCaptureEquirectResult& OutResult)
     {
         FCPUCubemap LeftCubemap;
-        if (!BuildCPUCubemap(LeftEye, LeftCubemap))
+        if (!BuildCPUCubemap(LeftEye, Settings.Resolution, LeftCubemap))
         {
             return;
         }
@@ -1245,7 +1424,7 @@ namespace
         FCPUCubemap RightCubemap;
         if (Settings.Mode == EOmniCaptureMode::Stereo)
         {
-            if (!BuildCPUCubemap(RightEye, RightCubemap))
+            if (!BuildCPUCubemap(RightEye, Settings.Resolution, RightCubemap))
             {
                 return;
             }
@@ -1253,7 +1432,7 @@ namespace
 
         const bool bStereo = Settings.Mode == EOmniCaptureMode::Stereo;
         const bool bSideBySide = bStereo && Settings.StereoLayout == EOmniCaptureStereoLayout::SideBySide;
-        const int32 FaceResolution = LeftCubemap.Faces[0].Resolution;
+        const int32 FaceResolution = Settings.Resolution;
         const FIntPoint OutputSize = Settings.GetEquirectResolution();
         const int32 OutputWidth = OutputSize.X;
         const int32 OutputHeight = OutputSize.Y;
@@ -1270,58 +1449,51 @@ namespace
         OutResult.EncoderPlanes.Reset();
 
         const int32 PixelCount = OutputWidth * OutputHeight;
-        OutResult.PreviewPixels.SetNum(PixelCount);
         OutResult.PixelPrecision = LeftCubemap.Precision;
 
+        // Each eye pixel's direction and face texel are resolved once and written to both stereo halves.
+        FIntPoint EyeResolution(OutputWidth, OutputHeight);
+        FIntPoint RightEyeOffset = FIntPoint::ZeroValue;
+        if (bStereo)
+        {
+            EyeResolution = bSideBySide ? FIntPoint(OutputWidth / 2, OutputHeight) : FIntPoint(OutputWidth, OutputHeight / 2);
+            RightEyeOffset = bSideBySide ? FIntPoint(EyeResolution.X, 0) : FIntPoint(0, EyeResolution.Y);
+        }
+
         auto ProcessPixel = [&](auto& PixelArray, auto ConvertColor)
         {
-            for (int32 Y = 0; Y < OutputHeight; ++Y)
+            auto WritePixel = [&](int32 Index, const FLinearColor& LinearColor)
             {
-                for (int32 X = 0; X < OutputWidth; ++X)
-                {
-                    const int32 Index = Y * OutputWidth + X;
+                PixelArray[Index] = ConvertColor(LinearColor);
+            };
 
-                    FIntPoint EyePixel(X, Y);
-                    FIntPoint EyeResolution(OutputWidth, OutputHeight);
-                    bool bRightEye = false;
-
-                    if (bStereo)
-                    {
-                        if (bSideBySide)
-                        {
-                            const int32 EyeWidth = OutputWidth / 2;
-                            bRightEye = X >= EyeWidth;
-                            EyePixel.X = X % EyeWidth;
-                            EyeResolution = FIntPoint(EyeWidth, OutputHeight);
-                        }
-                        else
-                        {
-                            const int32 EyeHeight = OutputHeight / 2;
-                            bRightEye = Y >= EyeHeight;
-                            EyePixel.Y = Y % EyeHeight;
-                            EyeResolution = FIntPoint(OutputWidth, EyeHeight);
-                        }
-                    }
+            for (int32 Y = 0; Y < EyeResolution.Y; ++Y)
+            {
+                for (int32 X = 0; X < EyeResolution.X; ++X)
+                {
+                    const int32 LeftIndex = Y * OutputWidth + X;
+                    const int32 RightIndex = (Y + RightEyeOffset.Y) * OutputWidth + X + RightEyeOffset.X;
 
                     float Latitude = 0.0f;
-                    FVector Direction = DirectionFromEquirectPixelCPU(EyePixel, EyeResolution, LongitudeSpan, LatitudeSpan, Latitude);
+                    FVector Direction = DirectionFromEquirectPixelCPU(FIntPoint(X, Y), EyeResolution, LongitudeSpan, LatitudeSpan, Latitude);
                     ApplyPolarMitigation(Settings.PolarDampening, Latitude, Direction);
 
                     if (bHalfSphere && Direction.X < 0.0f)
                     {
-                        PixelArray[Index] = ConvertColor(FLinearColor::Transparent);
-                        OutResult.PreviewPixels[Index] = FColor::Transparent;
+                        WritePixel(LeftIndex, FLinearColor::Transparent);
+                        if (bStereo)
+                        {
+                            WritePixel(RightIndex, FLinearColor::Transparent);
+                        }
                         continue;
                     }
 
-                    const FLinearColor LinearColor = SampleCubemapCPU(
-                        (bStereo && bRightEye) ? RightCubemap : LeftCubemap,
-                        Direction,
-                        FaceResolution,
-                        Settings.SeamBlend);
-
-                    PixelArray[Index] = ConvertColor(LinearColor);
-                    OutResult.PreviewPixels[Index] = LinearColor.ToFColor(true);
+                    const FCPUCubemapTexel Texel = LocateCubemapTexelCPU(LeftCubemap, Direction, FaceResolution, Settings.SeamBlend);
+                    WritePixel(LeftIndex, FetchCubemapTexelCPU(LeftCubemap, Texel));
+                    if (bStereo)
+                    {
+                        WritePixel(RightIndex, FetchCubemapTexelCPU(RightCubemap, Texel));
+                    }
                 }
             }
         };
@@ -1359,7 +1531,7 @@ namespace
     void ConvertFisheyeOnCPU(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye, FOmniCaptureEquirectResult& OutResult)
     {
         FCPUCubemap LeftCubemap;
-        if (!BuildCPUCubemap(LeftEye, LeftCubemap))
+        if (!BuildCPUCubemap(LeftEye, Settings.Resolution, LeftCubemap))
         {
             return;
         }
@@ -1367,7 +1539,7 @@ namespace
         FCPUCubemap RightCubemap;
         if (Settings.Mode == EOmniCaptureMode::Stereo)
         {
-            if (!BuildCPUCubemap(RightEye, RightCubemap))
+            if (!BuildCPUCubemap(RightEye, Settings.Resolution, RightCubemap))
             {
                 return;
             }
@@ -1375,7 +1547,7 @@ namespace
 
         const bool bStereo = Settings.Mode == EOmniCaptureMode::Stereo;
         const bool bSideBySide = bStereo && Settings.StereoLayout == EOmniCaptureStereoLayout::SideBySide;
-        const int32 FaceResolution = LeftCubemap.Faces[0].Resolution;
+        const int32 FaceResolution = Settings.Resolution;
         const FIntPoint OutputSize = Settings.GetOutputResolution();
         const FIntPoint EyeSize = Settings.GetFisheyeResolution();
         const bool bHalfSphere = Settings.IsVR180();
@@ -1390,63 +1562,46 @@ namespace
         OutResult.EncoderPlanes.Reset();
 
         const int32 PixelCount = OutputSize.X * OutputSize.Y;
-        OutResult.PreviewPixels.SetNum(PixelCount);
         OutResult.PixelPrecision = LeftCubemap.Precision;
 
+        // Each eye pixel's direction and face texel are resolved once and written to both stereo halves.
+        const FIntPoint EyeResolution(FMath::Max(1, EyeSize.X), FMath::Max(1, EyeSize.Y));
+        const FIntPoint RightEyeOffset = bSideBySide ? FIntPoint(EyeResolution.X, 0) : FIntPoint(0, EyeResolution.Y);
+
         auto ProcessPixel = [&](auto& PixelArray, auto ConvertColor)
         {
-            for (int32 Y = 0; Y < OutputSize.Y; ++Y)
+            auto WritePixel = [&](int32 Index, const FLinearColor& LinearColor)
             {
-                for (int32 X = 0; X < OutputSize.X; ++X)
-                {
-                    const int32 Index = Y * OutputSize.X + X;
+                PixelArray[Index] = ConvertColor(LinearColor);
+            };
 
-                    FIntPoint EyePixel(X, Y);
-                    FIntPoint EyeResolution = EyeSize;
-                    bool bRightEye = false;
+            const int32 RowsPerEye = FMath::Min(EyeResolution.Y, OutputSize.Y);
+            const int32 ColumnsPerEye = FMath::Min(EyeResolution.X, OutputSize.X);
+            for (int32 Y = 0; Y < RowsPerEye; ++Y)
+            {
+                for (int32 X = 0; X < ColumnsPerEye; ++X)
+                {
+                    const int32 LeftIndex = Y * OutputSize.X + X;
+                    const int32 RightIndex = (Y + RightEyeOffset.Y) * OutputSize.X + X + RightEyeOffset.X;
 
-                    if (bStereo)
+                    bool bValid = false;
+                    FVector Direction = DirectionFromFisheyePixelCPU(FIntPoint(X, Y), EyeResolution, FovRadians, bValid);
+                    if (!bValid || (bHalfSphere && Direction.X < 0.0f))
                     {
-                        if (bSideBySide)
-                        {
-                            const int32 EyeWidth = FMath::Max(1, EyeSize.X);
-                            bRightEye = X >= EyeWidth;
-                            EyePixel.X = X % EyeWidth;
-                            EyeResolution = FIntPoint(EyeWidth, EyeSize.Y);
-                        }
-                        else
+                        WritePixel(LeftIndex, FLinearColor::Transparent);
+                        if (bStereo)
                         {
-                            const int32 EyeHeight = FMath::Max(1, EyeSize.Y);
-                            bRightEye = Y >= EyeHeight;
-                            EyePixel.Y = Y % EyeHeight;
-                            EyeResolution = FIntPoint(EyeSize.X, EyeHeight);
+                            WritePixel(RightIndex, FLinearColor::Transparent);
                         }
-                    }
-
-                    bool bValid = false;
-                    FVector Direction = DirectionFromFisheyePixelCPU(EyePixel, EyeResolution, FovRadians, bValid);
-                    if (!bValid)
-                    {
-                        PixelArray[Index] = ConvertColor(FLinearColor::Transparent);
-                        OutResult.PreviewPixels[Index] = FColor::Transparent;
                         continue;
                     }
 
-                    if (bHalfSphere && Direction.X < 0.0f)
+                    const FCPUCubemapTexel Texel = LocateCubemapTexelCPU(LeftCubemap, Direction, FaceResolution, Settings.SeamBlend);
+                    WritePixel(LeftIndex, FetchCubemapTexelCPU(LeftCubemap, Texel));
+                    if (bStereo)
                     {
-                        PixelArray[Index] = ConvertColor(FLinearColor::Transparent);
-                        OutResult.PreviewPixels[Index] = FColor::Transparent;
-                        continue;
+                        WritePixel(RightIndex, FetchCubemapTexelCPU(RightCubemap, Texel));
                     }
-
-                    const FLinearColor LinearColor = SampleCubemapCPU(
-                        (bStereo && bRightEye) ? RightCubemap : LeftCubemap,
-                        Direction,
-                        FaceResolution,
-                        Settings.SeamBlend);
-
-                    PixelArray[Index] = ConvertColor(LinearColor);
-                    OutResult.PreviewPixels[Index] = LinearColor.ToFColor(true);
                 }
             }
         };
@@ -1480,47 +1635,695 @@ namespace
             OutResult.PixelDataType = EOmniCapturePixelDataType::Color8;
         }
     }
-}
-
-FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToEquirectangular(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye)
-{
-    FOmniCaptureEquirectResult Result;
-
-    if (Settings.Resolution <= 0)
+    /** Packs remapped linear pixels into the result the same way the equirect readback does. */
+    void StoreLinearPixels(TConstArrayView<FLinearColor> Pixels, const FIntPoint& Size, bool bUseLinear, EOmniCapturePixelPrecision Precision, FOmniCaptureEquirectResult& OutResult)
     {
-        return Result;
-    }
-
-    TArray<FTextureRHIRef, TInlineAllocator<6>> LeftFaces;
-    TArray<FTextureRHIRef, TInlineAllocator<6>> RightFaces;
+        const int32 PixelCount = Size.X * Size.Y;
+        OutResult.Size = Size;
+        OutResult.bIsLinear = bUseLinear;
 
-    for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
-    {
-        if (UTextureRenderTarget2D* LeftTarget = LeftEye.Faces[FaceIndex].RenderTarget)
+        if (!bUseLinear)
         {
-            if (FTextureRenderTargetResource* Resource = LeftTarget->GameThread_GetRenderTargetResource())
+            TUniquePtr<TImagePixelData<FColor>> PixelData = MakeUnique<TImagePixelData<FColor>>(Size);
+            PixelData->Pixels.SetNumUninitialized(PixelCount);
+            for (int32 Index = 0; Index < PixelCount; ++Index)
             {
-                if (FTextureRHIRef Texture = Resource->GetTextureRHI())
-                {
-                    LeftFaces.Add(Texture);
-                }
+                PixelData->Pixels[Index] = Pixels[Index].ToFColor(true);
             }
+            OutResult.PixelData = MoveTemp(PixelData);
+            OutResult.PixelDataType = EOmniCapturePixelDataType::Color8;
         }
-
-        if (Settings.Mode == EOmniCaptureMode::Stereo)
+        else if (Precision == EOmniCapturePixelPrecision::FullFloat)
         {
-            if (UTextureRenderTarget2D* RightTarget = RightEye.Faces[FaceIndex].RenderTarget)
+            TUniquePtr<TImagePixelData<FLinearColor>> PixelData = MakeUnique<TImagePixelData<FLinearColor>>(Size);
+            PixelData->Pixels.Append(Pixels.GetData(), PixelCount);
+            OutResult.PixelData = MoveTemp(PixelData);
+            OutResult.PixelDataType = EOmniCapturePixelDataType::LinearColorFloat32;
+        }
+        else
+        {
+            Precision = EOmniCapturePixelPrecision::HalfFloat;
+            TUniquePtr<TImagePixelData<FFloat16Color>> PixelData = MakeUnique<TImagePixelData<FFloat16Color>>(Size);
+            PixelData->Pixels.SetNum(PixelCount);
+            for (int32 Index = 0; Index < PixelCount; ++Index)
             {
-                if (FTextureRenderTargetResource* Resource = RightTarget->GameThread_GetRenderTargetResource())
-                {
-                    if (FTextureRHIRef Texture = Resource->GetTextureRHI())
-                    {
-                        RightFaces.Add(Texture);
-                    }
-                }
+                PixelData->Pixels[Index] = FFloat16Color(Pixels[Index]);
             }
+            OutResult.PixelData = MoveTemp(PixelData);
+            OutResult.PixelDataType = EOmniCapturePixelDataType::LinearColorFloat16;
         }
-    }
+
+        OutResult.PixelPrecision = Precision;
+    }
+
+    /** Waits for an enqueued readback of a float texture and converts it to linear colour. */
+    bool CopyReadbackPixels(FRHIGPUTextureReadback& Readback, const FIntPoint& Size, EOmniCapturePixelPrecision Precision, TArray<FLinearColor>& OutPixels)
+    {
+        while (!Readback.IsReady())
+        {
+            FPlatformProcess::SleepNoStats(0.001f);
+        }
+
+        int32 RowPitchInPixels = 0;
+        const uint8* RawData = static_cast<const uint8*>(Readback.Lock(RowPitchInPixels));
+        if (RawData)
+        {
+            const int32 RowPitch = RowPitchInPixels > 0 ? RowPitchInPixels : Size.X;
+            OutPixels.SetNumUninitialized(Size.X * Size.Y);
+            for (int32 Row = 0; Row < Size.Y; ++Row)
+            {
+                FLinearColor* DestRow = OutPixels.GetData() + Row * Size.X;
+                if (Precision == EOmniCapturePixelPrecision::FullFloat)
+                {
+                    FMemory::Memcpy(DestRow, reinterpret_cast<const FLinearColor*>(RawData) + RowPitch * Row, Size.X * sizeof(FLinearColor));
+                }
+                else
+                {
+                    const FFloat16Color* SourceRow = reinterpret_cast<const FFloat16Color*>(RawData) + RowPitch * Row;
+                    for (int32 Column = 0; Column < Size.X; ++Column)
+                    {
+                        DestRow[Column] = SourceRow[Column].GetFloats();
+                    }
+                }
+            }
+        }
+        Readback.Unlock();
+        return RawData != nullptr;
+    }
+
+    /** Adds the encoder plane passes for OutputTexture, executes the graph and reads the output back into OutResult. */
+    void ExecuteAndReadBackOutput(FRHICommandListImmediate& RHICmdList, FRDGBuilder& GraphBuilder, const FOmniCaptureSettings& Settings, FRDGTextureRef OutputTexture, const FIntPoint& OutputSize, EOmniCapturePixelPrecision Precision, const TCHAR* FenceName, const TCHAR* ReadbackName, FOmniCaptureEquirectResult& OutResult)
+    {
+        const bool bUseLinear = Settings.Gamma == EOmniCaptureGamma::Linear;
+
+        FRDGTextureRef LumaTexture = nullptr;
+        FRDGTextureRef ChromaTexture = nullptr;
+        FRDGTextureRef BGRATexture = nullptr;
+        if (Settings.OutputFormat == EOmniOutputFormat::NVENCHardware)
+        {
+            if (Settings.NVENCColorFormat == EOmniCaptureColorFormat::BGRA)
+            {
+                BGRATexture = AddBGRAPackingPass(GraphBuilder, Settings, bUseLinear, OutputSize.X, OutputSize.Y, OutputTexture);
+            }
+            else
+            {
+                AddYUVConversionPasses(GraphBuilder, Settings, bUseLinear, OutputSize.X, OutputSize.Y, OutputTexture, LumaTexture, ChromaTexture);
+            }
+        }
+
+        TRefCountPtr<IPooledRenderTarget> ExtractedOutput;
+        TRefCountPtr<IPooledRenderTarget> ExtractedLuma;
+        TRefCountPtr<IPooledRenderTarget> ExtractedChroma;
+        TRefCountPtr<IPooledRenderTarget> ExtractedBGRA;
+        GraphBuilder.QueueTextureExtraction(OutputTexture, &ExtractedOutput);
+        if (LumaTexture)
+        {
+            GraphBuilder.QueueTextureExtraction(LumaTexture, &ExtractedLuma);
+        }
+        if (ChromaTexture)
+        {
+            GraphBuilder.QueueTextureExtraction(ChromaTexture, &ExtractedChroma);
+        }
+        if (BGRATexture)
+        {
+            GraphBuilder.QueueTextureExtraction(BGRATexture, &ExtractedBGRA);
+        }
+        GraphBuilder.Execute();
+
+        FRHITexture* OutputTextureRHI = ExtractedOutput.IsValid() ? ExtractedOutput->GetRHI() : nullptr;
+        if (!OutputTextureRHI)
+        {
+            return;
+        }
+
+        OutResult.bUsedCPUFallback = false;
+        OutResult.OutputTarget = ExtractedOutput;
+        OutResult.Texture = OutputTextureRHI;
+        if (ExtractedLuma.IsValid())
+        {
+            OutResult.EncoderPlanes.Add(ExtractedLuma);
+        }
+        if (ExtractedChroma.IsValid())
+        {
+            OutResult.EncoderPlanes.Add(ExtractedChroma);
+        }
+        if (ExtractedBGRA.IsValid())
+        {
+            OutResult.EncoderPlanes.Add(ExtractedBGRA);
+
+            if (FRHITexture* BGRATextureRHI = ExtractedBGRA->GetRHI())
+            {
+                OutResult.Texture = BGRATextureRHI;
+            }
+        }
+
+        FGPUFenceRHIRef Fence = RHICreateGPUFence(FenceName);
+        if (Fence.IsValid())
+        {
+            RHICmdList.WriteGPUFence(Fence);
+            OutResult.ReadyFence = Fence;
+        }
+
+        FRHIGPUTextureReadback Readback(ReadbackName);
+        Readback.EnqueueCopy(RHICmdList, OutputTextureRHI, FResolveRect(0, 0, OutputSize.X, OutputSize.Y));
+        RHICmdList.SubmitCommandsAndFlushGPU();
+
+        TArray<FLinearColor> Pixels;
+        if (CopyReadbackPixels(Readback, OutputSize, Precision, Pixels))
+        {
+            StoreLinearPixels(Pixels, OutputSize, bUseLinear, Precision, OutResult);
+        }
+    }
+
+    void ConvertProjectionOnRenderThread(const FOmniCaptureSettings Settings, TSharedRef<const FOmniCaptureRemapTable> Table, const TArray<FTextureRHIRef, TInlineAllocator<6>> LeftFaces, const TArray<FTextureRHIRef, TInlineAllocator<6>> RightFaces, const TArray<FFaceCopyRegion, TInlineAllocator<6>> LeftRegions, const TArray<FFaceCopyRegion, TInlineAllocator<6>> RightRegions, FOmniCaptureEquirectResult& OutResult)
+    {
+        const int32 FaceResolution = Settings.Resolution;
+        const bool bStereo = Settings.Mode == EOmniCaptureMode::Stereo;
+        const FIntPoint OutputSize = Settings.GetOutputResolution();
+
+        FRHICommandListImmediate& RHICmdList = FRHICommandListExecutor::GetImmediateCommandList();
+        FRDGBuilder GraphBuilder(RHICmdList);
+
+        EOmniCapturePixelPrecision Precision = ResolvePrecisionFromTextures(LeftFaces);
+        if (Precision == EOmniCapturePixelPrecision::Unknown)
+        {
+            Precision = Settings.HDRPrecision == EOmniCaptureHDRPrecision::FullFloat
+                ? EOmniCapturePixelPrecision::FullFloat
+                : EOmniCapturePixelPrecision::HalfFloat;
+        }
+
+        const EPixelFormat FacePixelFormat = GetPixelFormatForPrecision(Precision);
+
+        // Both eyes come from the same rig, so their faces share sizes and the left scales serve both arrays.
+
+        FVector4f FaceUVScale[6];
+
+        FVector4f RightFaceUVScale[6];
+
+        FRDGTextureRef LeftArray = BuildFaceArray(GraphBuilder, LeftFaces, LeftRegions, FaceResolution, FacePixelFormat, TEXT("OmniRemapLeftFaces"), FaceUVScale);
+        FRDGTextureRef RightArray = bStereo ? BuildFaceArray(GraphBuilder, RightFaces, RightRegions, FaceResolution, FacePixelFormat, TEXT("OmniRemapRightFaces"), RightFaceUVScale) : LeftArray;
+
+        if (!LeftArray || !RightArray)
+        {
+            GraphBuilder.Execute();
+            return;
+        }
+
+        FRDGTextureDesc OutputDesc = FRDGTextureDesc::Create2D(OutputSize, FacePixelFormat, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_UAV | TexCreate_RenderTargetable);
+        FRDGTextureRef OutputTexture = GraphBuilder.CreateTexture(OutputDesc, TEXT("OmniProjectionRemapOutput"));
+
+        FOmniProjectionRemapCS::FParameters* Parameters = GraphBuilder.AllocParameters<FOmniProjectionRemapCS::FParameters>();
+        Parameters->OutputResolution = FVector2f(OutputSize.X, OutputSize.Y);
+        Parameters->EyeResolution = Table->Size;
+        Parameters->TapsPerPixel = FMath::Max(1, Table->TapsPerPixel);
+        Parameters->bStereo = bStereo ? 1 : 0;
+        Parameters->StereoLayout = Settings.StereoLayout == EOmniCaptureStereoLayout::TopBottom ? 0 : 1;
+        Parameters->FaceSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+        for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+        {
+            Parameters->FaceUVScale[FaceIndex] = FaceUVScale[FaceIndex];
+        }
+        Parameters->LeftFaces = GraphBuilder.CreateSRV(FRDGTextureSRVDesc::Create(LeftArray));
+        Parameters->RightFaces = GraphBuilder.CreateSRV(FRDGTextureSRVDesc::Create(RightArray));
+        Parameters->RemapTable = GraphBuilder.CreateSRV(Table->RegisterBuffer(GraphBuilder));
+        Parameters->OutputTexture = GraphBuilder.CreateUAV(OutputTexture);
+
+        // One thread per eye pixel; stereo threads write both halves.
+        TShaderMapRef<FOmniProjectionRemapCS> ComputeShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+        const FIntVector GroupCount(
+            FMath::DivideAndRoundUp(Table->Size.X, 8),
+            FMath::DivideAndRoundUp(Table->Size.Y, 8),
+            1);
+
+        FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("OmniCapture::ProjectionRemap"), ComputeShader, Parameters, GroupCount);
+        ExecuteAndReadBackOutput(RHICmdList, GraphBuilder, Settings, OutputTexture, OutputSize, Precision, TEXT("OmniProjectionRemapFence"), TEXT("OmniProjectionRemapReadback"), OutResult);
+    }
+
+    /** Layers that go through one FOmniProjectionRemapLayersCS dispatch: same face format, six faces per layer in layer order. */
+    struct FRemapLayerBatch
+    {
+        TArray<int32> LayerIndices;
+        EPixelFormat SourceFormat = PF_Unknown;
+        TArray<FTextureRHIRef, TInlineAllocator<6>> LeftFaces;
+        TArray<FTextureRHIRef, TInlineAllocator<6>> RightFaces;
+        TArray<FFaceCopyRegion, TInlineAllocator<6>> LeftRegions;
+        TArray<FFaceCopyRegion, TInlineAllocator<6>> RightRegions;
+    };
+
+    void ConvertLayersOnRenderThread(const FOmniCaptureSettings Settings, TSharedRef<const FOmniCaptureRemapTable> Table, const TArray<FRemapLayerBatch> Batches, TArray<FOmniCaptureEquirectResult>& OutResults)
+    {
+        const int32 FaceResolution = Settings.Resolution;
+        const bool bStereo = Settings.Mode == EOmniCaptureMode::Stereo;
+        const FIntPoint OutputSize = Settings.GetOutputResolution();
+        const bool bUseLinear = Settings.Gamma == EOmniCaptureGamma::Linear;
+
+        FRHICommandListImmediate& RHICmdList = FRHICommandListExecutor::GetImmediateCommandList();
+        FRDGBuilder GraphBuilder(RHICmdList);
+
+        TArray<EOmniCapturePixelPrecision> Precisions;
+        TArray<TRefCountPtr<IPooledRenderTarget>> ExtractedOutputs;
+        Precisions.SetNum(Batches.Num());
+        ExtractedOutputs.SetNum(Batches.Num());
+
+        TShaderMapRef<FOmniProjectionRemapLayersCS> ComputeShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+        for (int32 BatchIndex = 0; BatchIndex < Batches.Num(); ++BatchIndex)
+        {
+            const FRemapLayerBatch& Batch = Batches[BatchIndex];
+            const int32 LayerCount = Batch.LayerIndices.Num();
+
+            EOmniCapturePixelPrecision Precision = ResolvePrecisionFromTextures(Batch.LeftFaces);
+            if (Precision == EOmniCapturePixelPrecision::Unknown)
+            {
+                Precision = Settings.HDRPrecision == EOmniCaptureHDRPrecision::FullFloat
+                    ? EOmniCapturePixelPrecision::FullFloat
+                    : EOmniCapturePixelPrecision::HalfFloat;
+            }
+            Precisions[BatchIndex] = Precision;
+
+            const EPixelFormat FacePixelFormat = GetPixelFormatForPrecision(Precision);
+
+            // Every layer comes from the same rig, so the first layer's scales address all slices.
+            FVector4f FaceUVScale[6];
+            FVector4f RightFaceUVScale[6];
+            FRDGTextureRef LeftArray = BuildFaceArray(GraphBuilder, Batch.LeftFaces, Batch.LeftRegions, FaceResolution, FacePixelFormat, TEXT("OmniRemapLeftLayers"), FaceUVScale);
+            FRDGTextureRef RightArray = bStereo ? BuildFaceArray(GraphBuilder, Batch.RightFaces, Batch.RightRegions, FaceResolution, FacePixelFormat, TEXT("OmniRemapRightLayers"), RightFaceUVScale) : LeftArray;
+            if (!LeftArray || !RightArray || LayerCount == 0)
+            {
+                continue;
+            }
+
+            FRDGTextureDesc OutputDesc = FRDGTextureDesc::Create2D(FIntPoint(OutputSize.X, OutputSize.Y * LayerCount), FacePixelFormat, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_UAV);
+            FRDGTextureRef OutputTexture = GraphBuilder.CreateTexture(OutputDesc, TEXT("OmniProjectionRemapLayersOutput"));
+
+            FOmniProjectionRemapLayersCS::FParameters* Parameters = GraphBuilder.AllocParameters<FOmniProjectionRemapLayersCS::FParameters>();
+            Parameters->OutputResolution = FVector2f(OutputSize.X, OutputSize.Y);
+            Parameters->EyeResolution = Table->Size;
+            Parameters->TapsPerPixel = FMath::Max(1, Table->TapsPerPixel);
+            Parameters->LayerCount = LayerCount;
+            Parameters->bStereo = bStereo ? 1 : 0;
+            Parameters->StereoLayout = Settings.StereoLayout == EOmniCaptureStereoLayout::TopBottom ? 0 : 1;
+            Parameters->FaceSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+            for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+            {
+                Parameters->FaceUVScale[FaceIndex] = FaceUVScale[FaceIndex];
+            }
+            Parameters->LeftFaces = GraphBuilder.CreateSRV(FRDGTextureSRVDesc::Create(LeftArray));
+            Parameters->RightFaces = GraphBuilder.CreateSRV(FRDGTextureSRVDesc::Create(RightArray));
+            Parameters->RemapTable = GraphBuilder.CreateSRV(Table->RegisterBuffer(GraphBuilder));
+            Parameters->OutputTexture = GraphBuilder.CreateUAV(OutputTexture);
+
+            const FIntVector GroupCount(
+                FMath::DivideAndRoundUp(Table->Size.X, 8),
+                FMath::DivideAndRoundUp(Table->Size.Y, 8),
+                1);
+
+            FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("OmniCapture::ProjectionRemapLayers (%d)", LayerCount), ComputeShader, Parameters, GroupCount);
+            GraphBuilder.QueueTextureExtraction(OutputTexture, &ExtractedOutputs[BatchIndex]);
+        }
+        GraphBuilder.Execute();
+
+        // All readbacks are queued before the single flush.
+        TArray<TUniquePtr<FRHIGPUTextureReadback>> Readbacks;
+        Readbacks.SetNum(Batches.Num());
+        for (int32 BatchIndex = 0; BatchIndex < Batches.Num(); ++BatchIndex)
+        {
+            if (FRHITexture* OutputTextureRHI = ExtractedOutputs[BatchIndex].IsValid() ? ExtractedOutputs[BatchIndex]->GetRHI() : nullptr)
+            {
+                Readbacks[BatchIndex] = MakeUnique<FRHIGPUTextureReadback>(TEXT("OmniProjectionRemapLayersReadback"));
+                Readbacks[BatchIndex]->EnqueueCopy(RHICmdList, OutputTextureRHI, FResolveRect(0, 0, OutputSize.X, OutputSize.Y * Batches[BatchIndex].LayerIndices.Num()));
+            }
+        }
+        RHICmdList.SubmitCommandsAndFlushGPU();
+
+        const int32 PixelsPerLayer = OutputSize.X * OutputSize.Y;
+        for (int32 BatchIndex = 0; BatchIndex < Batches.Num(); ++BatchIndex)
+        {
+            const TArray<int32>& LayerIndices = Batches[BatchIndex].LayerIndices;
+            TArray<FLinearColor> Pixels;
+            if (!Readbacks[BatchIndex].IsValid() || !CopyReadbackPixels(*Readbacks[BatchIndex], FIntPoint(OutputSize.X, OutputSize.Y * LayerIndices.Num()), Precisions[BatchIndex], Pixels))
+            {
+                continue;
+            }
+
+            for (int32 Slot = 0; Slot < LayerIndices.Num(); ++Slot)
+            {
+                FOmniCaptureEquirectResult& Result = OutResults[LayerIndices[Slot]];
+                Result.bUsedCPUFallback = false;
+                StoreLinearPixels(TConstArrayView<FLinearColor>(Pixels.GetData() + Slot * PixelsPerLayer, PixelsPerLayer), OutputSize, bUseLinear, Precisions[BatchIndex], Result);
+            }
+        }
+    }
+
+    /** The analytic equirect/fisheye shaders take one tap per pixel; supersampled quality runs them through a remap table instead. */
+    /** Copies each ODS view into one slice of a texture array; views all share the layout's ViewSize. */
+    FRDGTextureRef BuildViewArray(FRDGBuilder& GraphBuilder, const TArray<FTextureRHIRef>& Views, const FIntPoint& ViewSize, EPixelFormat PixelFormat, const TCHAR* DebugName)
+    {
+        if (Views.Num() == 0)
+        {
+            return nullptr;
+        }
+
+        FRDGTextureDesc ArrayDesc = FRDGTextureDesc::Create2DArray(ViewSize, PixelFormat, FClearValueBinding::Transparent, TexCreate_ShaderResource | TexCreate_UAV, Views.Num());
+        FRDGTextureRef ArrayTexture = GraphBuilder.CreateTexture(ArrayDesc, DebugName);
+
+        for (int32 Index = 0; Index < Views.Num(); ++Index)
+        {
+            FRDGTextureRef SourceTexture = GraphBuilder.RegisterExternalTexture(CreateRenderTarget(Views[Index], *FString::Printf(TEXT("%sView%d"), DebugName, Index)));
+            FRHICopyTextureInfo CopyInfo;
+            CopyInfo.SourceSliceIndex = 0;
+            CopyInfo.DestSliceIndex = Index;
+            CopyInfo.NumSlices = 1;
+            CopyInfo.Size = FIntVector(ViewSize.X, ViewSize.Y, 1);
+            AddCopyTexturePass(GraphBuilder, SourceTexture, ArrayTexture, CopyInfo);
+        }
+
+        return ArrayTexture;
+    }
+
+    void ConvertODSOnRenderThread(const FOmniCaptureSettings Settings, TSharedRef<const FOmniCaptureRemapTable> Table, const FIntPoint ViewSize, const TArray<FTextureRHIRef> LeftViews, const TArray<FTextureRHIRef> RightViews, FOmniCaptureEquirectResult& OutResult)
+    {
+        const FIntPoint OutputSize = Settings.GetOutputResolution();
+
+        FRHICommandListImmediate& RHICmdList = FRHICommandListExecutor::GetImmediateCommandList();
+        FRDGBuilder GraphBuilder(RHICmdList);
+
+        EOmniCapturePixelPrecision Precision = PixelPrecisionFromFormat(LeftViews[0]->GetFormat());
+        if (Precision == EOmniCapturePixelPrecision::Unknown)
+        {
+            Precision = Settings.HDRPrecision == EOmniCaptureHDRPrecision::FullFloat
+                ? EOmniCapturePixelPrecision::FullFloat
+                : EOmniCapturePixelPrecision::HalfFloat;
+        }
+
+        const EPixelFormat ViewPixelFormat = GetPixelFormatForPrecision(Precision);
+        FRDGTextureRef LeftArray = BuildViewArray(GraphBuilder, LeftViews, ViewSize, ViewPixelFormat, TEXT("OmniODSLeftViews"));
+        FRDGTextureRef RightArray = BuildViewArray(GraphBuilder, RightViews, ViewSize, ViewPixelFormat, TEXT("OmniODSRightViews"));
+        if (!LeftArray || !RightArray)
+        {
+            GraphBuilder.Execute();
+            return;
+        }
+
+        FRDGTextureDesc OutputDesc = FRDGTextureDesc::Create2D(OutputSize, ViewPixelFormat, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_UAV | TexCreate_RenderTargetable);
+        FRDGTextureRef OutputTexture = GraphBuilder.CreateTexture(OutputDesc, TEXT("OmniODSStitchOutput"));
+
+        FOmniODSStitchCS::FParameters* Parameters = GraphBuilder.AllocParameters<FOmniODSStitchCS::FParameters>();
+        Parameters->OutputResolution = FVector2f(OutputSize.X, OutputSize.Y);
+        Parameters->EyeResolution = Table->Size;
+        Parameters->bStereo = 1;
+        Parameters->StereoLayout = Settings.StereoLayout == EOmniCaptureStereoLayout::TopBottom ? 0 : 1;
+        Parameters->ViewSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+        Parameters->LeftViews = GraphBuilder.CreateSRV(FRDGTextureSRVDesc::Create(LeftArray));
+        Parameters->RightViews = GraphBuilder.CreateSRV(FRDGTextureSRVDesc::Create(RightArray));
+        Parameters->StitchTable = GraphBuilder.CreateSRV(Table->RegisterBuffer(GraphBuilder));
+        Parameters->OutputTexture = GraphBuilder.CreateUAV(OutputTexture);
+
+        TShaderMapRef<FOmniODSStitchCS> ComputeShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+        const FIntVector GroupCount(
+            FMath::DivideAndRoundUp(Table->Size.X, 8),
+            FMath::DivideAndRoundUp(Table->Size.Y, 8),
+            1);
+
+        FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("OmniCapture::ODSStitch"), ComputeShader, Parameters, GroupCount);
+        ExecuteAndReadBackOutput(RHICmdList, GraphBuilder, Settings, OutputTexture, OutputSize, Precision, TEXT("OmniODSStitchFence"), TEXT("OmniODSStitchReadback"), OutResult);
+    }
+
+    /** True when equirect and fisheye need the remap path; tables over the memory budget fall back to the analytic shaders. */
+    bool UsesSupersampledRemap(const FOmniCaptureSettings& Settings)
+    {
+        if (Settings.IsPlanar() || Settings.GetRemapSamplesPerAxis() <= 1)
+        {
+            return false;
+        }
+
+        FOmniCaptureProjectionParams Params;
+        FIntPoint EyeSize;
+        FOmniCaptureProjectionRemap::GetConverterParams(Settings, Params, EyeSize);
+        return FOmniCaptureProjectionRemap::GetTableSamplesPerAxis(Params, EyeSize) > 1;
+    }
+
+    bool BuildCubemapPixels(const FOmniEyeCapture& Eye, int32 FaceResolution, FOmniCaptureCubemapPixels& OutCubemap, EOmniCapturePixelPrecision& OutPrecision)
+    {
+        FCPUCubemap Cubemap;
+        if (!BuildCPUCubemap(Eye, FaceResolution, Cubemap))
+        {
+            return false;
+        }
+
+        OutCubemap.Resolution = 0;
+        for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+        {
+            OutCubemap.FaceResolutions[FaceIndex] = Cubemap.Faces[FaceIndex].Resolution;
+            OutCubemap.Resolution = FMath::Max(OutCubemap.Resolution, Cubemap.Faces[FaceIndex].Resolution);
+            OutCubemap.Faces[FaceIndex] = MoveTemp(Cubemap.Faces[FaceIndex].Pixels);
+        }
+        OutPrecision = Cubemap.Precision;
+        return OutCubemap.IsValid();
+    }
+
+    void RemapCubemapsOnCPU(const FOmniCaptureSettings& Settings, const FOmniCaptureCubemapPixels& LeftCubemap, const FOmniCaptureCubemapPixels& RightCubemap, EOmniCapturePixelPrecision Precision, FOmniCaptureEquirectResult& OutResult)
+    {
+        const bool bStereo = Settings.Mode == EOmniCaptureMode::Stereo;
+        const FIntPoint OutputSize = Settings.GetOutputResolution();
+        FOmniCaptureProjectionParams Params;
+        FIntPoint EyeSize;
+        FOmniCaptureProjectionRemap::GetConverterParams(Settings, Params, EyeSize);
+        const TSharedRef<const FOmniCaptureRemapTable> Table = FOmniCaptureProjectionRemap::FindOrBuildTable(Params, EyeSize, Settings.Resolution, Settings.SeamBlend);
+
+        // Both eyes share one table walk; only the cubemap each tap reads from differs.
+        TArray<FLinearColor> Pixels;
+        Pixels.SetNumZeroed(OutputSize.X * OutputSize.Y);
+        TArray<FOmniCaptureRemapTarget, TInlineAllocator<2>> Targets;
+        Targets.Add({ &LeftCubemap, Pixels, FIntPoint::ZeroValue });
+        if (bStereo)
+        {
+            const FIntPoint RightOffset = Settings.StereoLayout == EOmniCaptureStereoLayout::SideBySide ? FIntPoint(EyeSize.X, 0) : FIntPoint(0, EyeSize.Y);
+            Targets.Add({ &RightCubemap, Pixels, RightOffset });
+        }
+        FOmniCaptureProjectionRemap::RemapTargetsCPU(*Table, Targets, OutputSize.X);
+
+        OutResult.bUsedCPUFallback = true;
+        OutResult.OutputTarget.SafeRelease();
+        OutResult.Texture.SafeRelease();
+        OutResult.ReadyFence.SafeRelease();
+        OutResult.EncoderPlanes.Reset();
+        StoreLinearPixels(Pixels, OutputSize, Settings.Gamma == EOmniCaptureGamma::Linear, Precision, OutResult);
+    }
+
+    void ConvertProjectionOnCPU(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye, FOmniCaptureEquirectResult& OutResult)
+    {
+        const bool bStereo = Settings.Mode == EOmniCaptureMode::Stereo;
+        EOmniCapturePixelPrecision Precision = EOmniCapturePixelPrecision::Unknown;
+
+        FOmniCaptureCubemapPixels LeftCubemap;
+        FOmniCaptureCubemapPixels RightCubemap;
+        if (!BuildCubemapPixels(LeftEye, Settings.Resolution, LeftCubemap, Precision) || (bStereo && !BuildCubemapPixels(RightEye, Settings.Resolution, RightCubemap, Precision)))
+        {
+            return;
+        }
+
+        RemapCubemapsOnCPU(Settings, LeftCubemap, RightCubemap, Precision, OutResult);
+    }
+
+    void ConvertLayersOnCPU(const FOmniCaptureSettings& Settings, const TArray<FOmniCaptureLayerEyes>& Layers, TArray<FOmniCaptureEquirectResult>& OutResults)
+    {
+        const bool bStereo = Settings.Mode == EOmniCaptureMode::Stereo;
+
+        TArray<FOmniCaptureCubemapPixels> LeftCubemaps;
+        TArray<FOmniCaptureCubemapPixels> RightCubemaps;
+        TArray<EOmniCapturePixelPrecision> Precisions;
+        LeftCubemaps.SetNum(Layers.Num());
+        RightCubemaps.SetNum(Layers.Num());
+        Precisions.SetNum(Layers.Num());
+
+        TArray<int32> ValidLayers;
+        for (int32 LayerIndex = 0; LayerIndex < Layers.Num(); ++LayerIndex)
+        {
+            if (BuildCubemapPixels(Layers[LayerIndex].LeftEye, Settings.Resolution, LeftCubemaps[LayerIndex], Precisions[LayerIndex])
+                && (!bStereo || BuildCubemapPixels(Layers[LayerIndex].RightEye, Settings.Resolution, RightCubemaps[LayerIndex], Precisions[LayerIndex])))
+            {
+                ValidLayers.Add(LayerIndex);
+            }
+        }
+
+        if (ValidLayers.Num() == 0)
+        {
+            return;
+        }
+
+        const FIntPoint OutputSize = Settings.GetOutputResolution();
+        FOmniCaptureProjectionParams Params;
+        FIntPoint EyeSize;
+        FOmniCaptureProjectionRemap::GetConverterParams(Settings, Params, EyeSize);
+        const TSharedRef<const FOmniCaptureRemapTable> Table = FOmniCaptureProjectionRemap::FindOrBuildTable(Params, EyeSize, Settings.Resolution, Settings.SeamBlend);
+
+        const FIntPoint RightOffset = Settings.StereoLayout == EOmniCaptureStereoLayout::SideBySide ? FIntPoint(EyeSize.X, 0) : FIntPoint(0, EyeSize.Y);
+        TArray<TArray<FLinearColor>> Pixels;
+        TArray<FOmniCaptureRemapTarget> Targets;
+        Pixels.SetNum(ValidLayers.Num());
+        for (int32 Slot = 0; Slot < ValidLayers.Num(); ++Slot)
+        {
+            Pixels[Slot].SetNumZeroed(OutputSize.X * OutputSize.Y);
+            Targets.Add({ &LeftCubemaps[ValidLayers[Slot]], Pixels[Slot], FIntPoint::ZeroValue });
+            if (bStereo)
+            {
+                Targets.Add({ &RightCubemaps[ValidLayers[Slot]], Pixels[Slot], RightOffset });
+            }
+        }
+        FOmniCaptureProjectionRemap::RemapTargetsCPU(*Table, Targets, OutputSize.X);
+
+        for (int32 Slot = 0; Slot < ValidLayers.Num(); ++Slot)
+        {
+            FOmniCaptureEquirectResult& Result = OutResults[ValidLayers[Slot]];
+            Result.bUsedCPUFallback = true;
+            StoreLinearPixels(Pixels[Slot], OutputSize, Settings.Gamma == EOmniCaptureGamma::Linear, Precisions[ValidLayers[Slot]], Result);
+        }
+    }
+
+    /** Reads every ODS view of an eye back to the CPU; false if a view is missing or not ViewSize. */
+    bool ReadODSViews(const FOmniEyeCapture& Eye, const FOmniCaptureODSLayout& Layout, TArray<TArray<FLinearColor>>& OutViews, EOmniCapturePixelPrecision& OutPrecision)
+    {
+        if (Eye.ODSViews.Num() != Layout.GetViewCount())
+        {
+            return false;
+        }
+
+        OutViews.SetNum(Eye.ODSViews.Num());
+        for (int32 Index = 0; Index < Eye.ODSViews.Num(); ++Index)
+        {
+            UTextureRenderTarget2D* View = Eye.ODSViews[Index];
+            FTextureRenderTargetResource* Resource = View ? View->GameThread_GetRenderTargetResource() : nullptr;
+            if (!Resource || View->SizeX != Layout.ViewSize.X || View->SizeY != Layout.ViewSize.Y)
+            {
+                return false;
+            }
+
+            EOmniCapturePixelPrecision Precision = PixelPrecisionFromFormat(View->GetFormat());
+            if (!ReadRenderTargetPixels(Resource, Precision, OutViews[Index]) || OutViews[Index].Num() != Layout.ViewSize.X * Layout.ViewSize.Y)
+            {
+                return false;
+            }
+            OutPrecision = Precision;
+        }
+        return true;
+    }
+
+    void ConvertODSOnCPU(const FOmniCaptureSettings& Settings, const FOmniCaptureODSLayout& Layout, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye, FOmniCaptureEquirectResult& OutResult)
+    {
+        EOmniCapturePixelPrecision Precision = EOmniCapturePixelPrecision::Unknown;
+        TArray<TArray<FLinearColor>> LeftViews;
+        TArray<TArray<FLinearColor>> RightViews;
+        if (!ReadODSViews(LeftEye, Layout, LeftViews, Precision) || !ReadODSViews(RightEye, Layout, RightViews, Precision))
+        {
+            return;
+        }
+
+        const FIntPoint OutputSize = Settings.GetOutputResolution();
+        const TSharedRef<const FOmniCaptureRemapTable> Table = Layout.FindOrBuildStitchTable();
+        const FIntPoint RightOffset = Settings.StereoLayout == EOmniCaptureStereoLayout::SideBySide ? FIntPoint(Layout.EyeSize.X, 0) : FIntPoint(0, Layout.EyeSize.Y);
+
+        TArray<FLinearColor> Pixels;
+        Pixels.SetNumZeroed(OutputSize.X * OutputSize.Y);
+        const FOmniCaptureODSStitchTarget Targets[2] =
+        {
+            { LeftViews, Pixels, FIntPoint::ZeroValue },
+            { RightViews, Pixels, RightOffset },
+        };
+        FOmniCaptureODSLayout::StitchCPU(*Table, Layout.ViewSize, Targets, OutputSize.X);
+
+        OutResult.bUsedCPUFallback = true;
+        OutResult.OutputTarget.SafeRelease();
+        OutResult.Texture.SafeRelease();
+        OutResult.ReadyFence.SafeRelease();
+        OutResult.EncoderPlanes.Reset();
+        StoreLinearPixels(Pixels, OutputSize, Settings.Gamma == EOmniCaptureGamma::Linear, Precision, OutResult);
+    }
+
+    /** Render target textures of every ODS view of an eye; false if any is missing. */
+    bool GatherODSViews(const FOmniEyeCapture& Eye, TArray<FTextureRHIRef>& OutViews)
+    {
+        for (UTextureRenderTarget2D* View : Eye.ODSViews)
+        {
+            FTextureRenderTargetResource* Resource = View ? View->GameThread_GetRenderTargetResource() : nullptr;
+            FTextureRHIRef Texture = Resource ? Resource->GetTextureRHI() : FTextureRHIRef();
+            if (!Texture.IsValid())
+            {
+                return false;
+            }
+            OutViews.Add(Texture);
+        }
+        return true;
+    }
+
+    /** Render target textures and copy regions of all six faces of an eye; false if any face is missing. */
+    bool GatherEyeFaces(const FOmniEyeCapture& Eye, int32 FaceResolution, TArray<FTextureRHIRef, TInlineAllocator<6>>& OutFaces, TArray<FFaceCopyRegion, TInlineAllocator<6>>& OutRegions)
+    {
+        for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+        {
+            UTextureRenderTarget2D* RenderTarget = Eye.Faces[FaceIndex].RenderTarget;
+            FTextureRenderTargetResource* Resource = RenderTarget ? RenderTarget->GameThread_GetRenderTargetResource() : nullptr;
+            FTextureRHIRef Texture = Resource ? Resource->GetTextureRHI() : FTextureRHIRef();
+            if (!Texture.IsValid())
+            {
+                return false;
+            }
+
+            OutFaces.Add(Texture);
+            OutRegions.Add(GetFaceCopyRegion(Eye.Faces[FaceIndex], FaceResolution));
+        }
+        return true;
+    }
+}
+
+
+FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToEquirectangular(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye)
+{
+    if (UsesSupersampledRemap(Settings))
+    {
+        return ConvertToProjection(Settings, LeftEye, RightEye);
+    }
+
+    FOmniCaptureEquirectResult Result;
+
+    if (Settings.Resolution <= 0)
+    {
+        return Result;
+    }
+
+    TArray<FTextureRHIRef, TInlineAllocator<6>> LeftFaces;
+    TArray<FTextureRHIRef, TInlineAllocator<6>> RightFaces;
+    TArray<FFaceCopyRegion, TInlineAllocator<6>> LeftRegions;
+    TArray<FFaceCopyRegion, TInlineAllocator<6>> RightRegions;
+
+    for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+    {
+        if (UTextureRenderTarget2D* LeftTarget = LeftEye.Faces[FaceIndex].RenderTarget)
+        {
+            if (FTextureRenderTargetResource* Resource = LeftTarget->GameThread_GetRenderTargetResource())
+            {
+                if (FTextureRHIRef Texture = Resource->GetTextureRHI())
+                {
+                    LeftFaces.Add(Texture);
+                    LeftRegions.Add(GetFaceCopyRegion(LeftEye.Faces[FaceIndex], Settings.Resolution));
+                }
+            }
+        }
+
+        if (Settings.Mode == EOmniCaptureMode::Stereo)
+        {
+            if (UTextureRenderTarget2D* RightTarget = RightEye.Faces[FaceIndex].RenderTarget)
+            {
+                if (FTextureRenderTargetResource* Resource = RightTarget->GameThread_GetRenderTargetResource())
+                {
+                    if (FTextureRHIRef Texture = Resource->GetTextureRHI())
+                    {
+                        RightFaces.Add(Texture);
+                        RightRegions.Add(GetFaceCopyRegion(RightEye.Faces[FaceIndex], Settings.Resolution));
+                    }
+                }
+            }
+        }
+    }
 
     if (LeftFaces.Num() != 6)
     {
@@ -1548,9 +2351,9 @@ FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToEquirectangul
 
     FEvent* CompletionEvent = FPlatformProcess::GetSynchEventFromPool();
 
-    ENQUEUE_RENDER_COMMAND(OmniCaptureEquirect)([Settings, LeftFaces, RightFaces, &Result, CompletionEvent](FRHICommandListImmediate&)
+    ENQUEUE_RENDER_COMMAND(OmniCaptureEquirect)([Settings, LeftFaces, RightFaces, LeftRegions, RightRegions, &Result, CompletionEvent](FRHICommandListImmediate&)
     {
-        ConvertOnRenderThread(Settings, LeftFaces, RightFaces, Result);
+        ConvertOnRenderThread(Settings, LeftFaces, RightFaces, LeftRegions, RightRegions, Result);
         CompletionEvent->Trigger();
     });
 
@@ -1567,6 +2370,11 @@ FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToEquirectangul
 
 FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToFisheye(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye)
 {
+    if (UsesSupersampledRemap(Settings))
+    {
+        return ConvertToProjection(Settings, LeftEye, RightEye);
+    }
+
     FOmniCaptureEquirectResult Result;
 
     if (!Settings.IsFisheye() || Settings.Resolution <= 0)
@@ -1576,6 +2384,8 @@ FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToFisheye(const
 
     TArray<FTextureRHIRef, TInlineAllocator<6>> LeftFaces;
     TArray<FTextureRHIRef, TInlineAllocator<6>> RightFaces;
+    TArray<FFaceCopyRegion, TInlineAllocator<6>> LeftRegions;
+    TArray<FFaceCopyRegion, TInlineAllocator<6>> RightRegions;
 
     for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
     {
@@ -1586,6 +2396,7 @@ FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToFisheye(const
                 if (FTextureRHIRef Texture = Resource->GetTextureRHI())
                 {
                     LeftFaces.Add(Texture);
+                    LeftRegions.Add(GetFaceCopyRegion(LeftEye.Faces[FaceIndex], Settings.Resolution));
                 }
             }
         }
@@ -1599,6 +2410,7 @@ FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToFisheye(const
                     if (FTextureRHIRef Texture = Resource->GetTextureRHI())
                     {
                         RightFaces.Add(Texture);
+                        RightRegions.Add(GetFaceCopyRegion(RightEye.Faces[FaceIndex], Settings.Resolution));
                     }
                 }
             }
@@ -1627,9 +2439,9 @@ FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToFisheye(const
     if (bSupportsCompute)
     {
         FEvent* CompletionEvent = FPlatformProcess::GetSynchEventFromPool();
-        ENQUEUE_RENDER_COMMAND(OmniCaptureFisheyeConvert)([Settings, LeftFaces, RightFaces, &Result, CompletionEvent](FRHICommandListImmediate&)
+        ENQUEUE_RENDER_COMMAND(OmniCaptureFisheyeConvert)([Settings, LeftFaces, RightFaces, LeftRegions, RightRegions, &Result, CompletionEvent](FRHICommandListImmediate&)
         {
-            ConvertFisheyeOnRenderThread(Settings, LeftFaces, RightFaces.Num() > 0 ? RightFaces : LeftFaces, Result);
+            ConvertFisheyeOnRenderThread(Settings, LeftFaces, RightFaces.Num() > 0 ? RightFaces : LeftFaces, LeftRegions, RightRegions.Num() > 0 ? RightRegions : LeftRegions, Result);
             CompletionEvent->Trigger();
         });
 
@@ -1644,6 +2456,150 @@ FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToFisheye(const
     return Result;
 }
 
+FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToProjection(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye)
+{
+    FOmniCaptureEquirectResult Result;
+
+    if ((!FOmniCaptureProjectionRemap::SupportsProjection(Settings.Projection) && !UsesSupersampledRemap(Settings)) || Settings.Resolution <= 0)
+    {
+        return Result;
+    }
+
+    TArray<FTextureRHIRef, TInlineAllocator<6>> LeftFaces;
+    TArray<FTextureRHIRef, TInlineAllocator<6>> RightFaces;
+    TArray<FFaceCopyRegion, TInlineAllocator<6>> LeftRegions;
+    TArray<FFaceCopyRegion, TInlineAllocator<6>> RightRegions;
+
+    for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+    {
+        if (UTextureRenderTarget2D* LeftTarget = LeftEye.Faces[FaceIndex].RenderTarget)
+        {
+            if (FTextureRenderTargetResource* Resource = LeftTarget->GameThread_GetRenderTargetResource())
+            {
+                if (FTextureRHIRef Texture = Resource->GetTextureRHI())
+                {
+                    LeftFaces.Add(Texture);
+                    LeftRegions.Add(GetFaceCopyRegion(LeftEye.Faces[FaceIndex], Settings.Resolution));
+                }
+            }
+        }
+
+        if (Settings.Mode == EOmniCaptureMode::Stereo)
+        {
+            if (UTextureRenderTarget2D* RightTarget = RightEye.Faces[FaceIndex].RenderTarget)
+            {
+                if (FTextureRenderTargetResource* Resource = RightTarget->GameThread_GetRenderTargetResource())
+                {
+                    if (FTextureRHIRef Texture = Resource->GetTextureRHI())
+                    {
+                        RightFaces.Add(Texture);
+                        RightRegions.Add(GetFaceCopyRegion(RightEye.Faces[FaceIndex], Settings.Resolution));
+                    }
+                }
+            }
+        }
+    }
+
+    if (LeftFaces.Num() != 6)
+    {
+        return Result;
+    }
+
+    if (Settings.Mode == EOmniCaptureMode::Stereo && RightFaces.Num() != 6)
+    {
+        return Result;
+    }
+
+    bool bSupportsCompute = GDynamicRHI != nullptr;
+#if defined(GRHISupportsComputeShaders)
+    bSupportsCompute = bSupportsCompute && GRHISupportsComputeShaders;
+#elif defined(GSupportsComputeShaders)
+    bSupportsCompute = bSupportsCompute && GSupportsComputeShaders;
+#else
+    bSupportsCompute = false;
+#endif
+
+    if (bSupportsCompute)
+    {
+        // Built on the game thread so a settings change never stalls the render thread on table generation.
+        FOmniCaptureProjectionParams Params;
+        FIntPoint EyeSize;
+        FOmniCaptureProjectionRemap::GetConverterParams(Settings, Params, EyeSize);
+        const TSharedRef<const FOmniCaptureRemapTable> Table = FOmniCaptureProjectionRemap::FindOrBuildTable(Params, EyeSize, Settings.Resolution, Settings.SeamBlend);
+
+        FEvent* CompletionEvent = FPlatformProcess::GetSynchEventFromPool();
+        ENQUEUE_RENDER_COMMAND(OmniCaptureProjectionRemap)([Settings, Table, LeftFaces, RightFaces, LeftRegions, RightRegions, &Result, CompletionEvent](FRHICommandListImmediate&)
+        {
+            ConvertProjectionOnRenderThread(Settings, Table, LeftFaces, RightFaces.Num() > 0 ? RightFaces : LeftFaces, LeftRegions, RightRegions.Num() > 0 ? RightRegions : LeftRegions, Result);
+            CompletionEvent->Trigger();
+        });
+
+        CompletionEvent->Wait();
+        FPlatformProcess::ReturnSynchEventToPool(CompletionEvent);
+    }
+    else
+    {
+        ConvertProjectionOnCPU(Settings, LeftEye, RightEye, Result);
+    }
+
+    return Result;
+}
+
+FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToODS(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye)
+{
+    FOmniCaptureEquirectResult Result;
+
+    if (!Settings.UsesOmniDirectionalStereo())
+    {
+        return Result;
+    }
+
+    const FOmniCaptureODSLayout Layout = FOmniCaptureODSLayout::Build(Settings);
+    const int32 ViewCount = Layout.GetViewCount();
+    if (!Layout.IsValid() || LeftEye.ODSViews.Num() != ViewCount || RightEye.ODSViews.Num() != ViewCount)
+    {
+        return Result;
+    }
+
+    TArray<FTextureRHIRef> LeftViews;
+    TArray<FTextureRHIRef> RightViews;
+    if (!GatherODSViews(LeftEye, LeftViews) || !GatherODSViews(RightEye, RightViews))
+    {
+        return Result;
+    }
+
+    bool bSupportsCompute = GDynamicRHI != nullptr;
+#if defined(GRHISupportsComputeShaders)
+    bSupportsCompute = bSupportsCompute && GRHISupportsComputeShaders;
+#elif defined(GSupportsComputeShaders)
+    bSupportsCompute = bSupportsCompute && GSupportsComputeShaders;
+#else
+    bSupportsCompute = false;
+#endif
+
+    if (bSupportsCompute)
+    {
+        const TSharedRef<const FOmniCaptureRemapTable> Table = Layout.FindOrBuildStitchTable();
+        const FIntPoint ViewSize = Layout.ViewSize;
+
+        FEvent* CompletionEvent = FPlatformProcess::GetSynchEventFromPool();
+        ENQUEUE_RENDER_COMMAND(OmniCaptureODSStitch)([Settings, Table, ViewSize, LeftViews, RightViews, &Result, CompletionEvent](FRHICommandListImmediate&)
+        {
+            ConvertODSOnRenderThread(Settings, Table, ViewSize, LeftViews, RightViews, Result);
+            CompletionEvent->Trigger();
+        });
+
+        CompletionEvent->Wait();
+        FPlatformProcess::ReturnSynchEventToPool(CompletionEvent);
+    }
+    else
+    {
+        ConvertODSOnCPU(Settings, Layout, LeftEye, RightEye, Result);
+    }
+
+    return Result;
+}
+
 FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToPlanar(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& SourceEye)
 {
     FOmniCaptureEquirectResult Result;
@@ -1679,8 +2635,6 @@ FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToPlanar(const
     Result.OutputTarget.SafeRelease();
     Result.GPUSource.SafeRelease();
 
-    const int32 PixelCount = OutputSize.X * OutputSize.Y;
-
     if (Result.bIsLinear)
     {
         TUniquePtr<TImagePixelData<FFloat16Color>> PixelData = MakeUnique<TImagePixelData<FFloat16Color>>(OutputSize);
@@ -1716,50 +2670,146 @@ FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToPlanar(const
 
     if (!Result.PixelData.IsValid())
     {
-        Result.PreviewPixels.Reset();
         return Result;
     }
 
-    Result.PreviewPixels.SetNum(PixelCount);
-    if (Result.bIsLinear)
+    Result.Texture = Resource->GetRenderTargetTexture();
+
+    if (Result.Texture.IsValid() && Settings.OutputFormat == EOmniOutputFormat::NVENCHardware)
     {
-        const TImagePixelData<FFloat16Color>* FloatData = static_cast<const TImagePixelData<FFloat16Color>*>(Result.PixelData.Get());
-        if (FloatData)
+        FEvent* CompletionEvent = FPlatformProcess::GetSynchEventFromPool();
+        ENQUEUE_RENDER_COMMAND(OmniCapturePlanarConvert)([Settings, SourceTexture = Result.Texture, OutputSize, bLinear = Result.bIsLinear, &Result, CompletionEvent](FRHICommandListImmediate& RHICmdList)
         {
-            for (int32 Index = 0; Index < PixelCount; ++Index)
-            {
-                Result.PreviewPixels[Index] = FLinearColor(FloatData->Pixels[Index]).ToFColor(true);
-            }
-        }
+            ConvertPlanarOnRenderThread(Settings, SourceTexture, OutputSize, bLinear, Result);
+            CompletionEvent->Trigger();
+        });
+
+        CompletionEvent->Wait();
+        FPlatformProcess::ReturnSynchEventToPool(CompletionEvent);
     }
-    else
+
+    return Result;
+}
+
+TArray<FOmniCaptureEquirectResult> FOmniCaptureEquirectConverter::ConvertLayers(const FOmniCaptureSettings& Settings, const TArray<FOmniCaptureLayerEyes>& Layers)
+{
+    TArray<FOmniCaptureEquirectResult> Results;
+    Results.SetNum(Layers.Num());
+
+    if (Layers.Num() == 0 || Settings.IsPlanar() || Settings.Resolution <= 0)
     {
-        const TImagePixelData<FColor>* ColorData = static_cast<const TImagePixelData<FColor>*>(Result.PixelData.Get());
-        if (ColorData)
-        {
-            Result.PreviewPixels = ColorData->Pixels;
-        }
+        return Results;
     }
 
-    if (Result.PreviewPixels.Num() != PixelCount)
+    bool bSupportsCompute = GDynamicRHI != nullptr;
+#if defined(GRHISupportsComputeShaders)
+    bSupportsCompute = bSupportsCompute && GRHISupportsComputeShaders;
+#elif defined(GSupportsComputeShaders)
+    bSupportsCompute = bSupportsCompute && GSupportsComputeShaders;
+#else
+    bSupportsCompute = false;
+#endif
+
+    if (!bSupportsCompute)
     {
-        Result.PreviewPixels.Init(FColor::Black, PixelCount);
+        ConvertLayersOnCPU(Settings, Layers, Results);
+        return Results;
     }
 
-    Result.Texture = Resource->GetRenderTargetTexture();
+    const bool bStereo = Settings.Mode == EOmniCaptureMode::Stereo;
 
-    if (Result.Texture.IsValid() && Settings.OutputFormat == EOmniOutputFormat::NVENCHardware)
+    // Layers are stacked in one output texture, so a batch is capped by the tallest texture the RHI allows.
+    const int32 OutputHeight = FMath::Max(1, Settings.GetOutputResolution().Y);
+    const int32 MaxLayersPerBatch = FMath::Max(1, static_cast<int32>(GMaxTextureDimensions) / OutputHeight);
+
+    TArray<FRemapLayerBatch> Batches;
+    for (int32 LayerIndex = 0; LayerIndex < Layers.Num(); ++LayerIndex)
     {
-        FEvent* CompletionEvent = FPlatformProcess::GetSynchEventFromPool();
-        ENQUEUE_RENDER_COMMAND(OmniCapturePlanarConvert)([Settings, SourceTexture = Result.Texture, OutputSize, bLinear = Result.bIsLinear, &Result, CompletionEvent](FRHICommandListImmediate& RHICmdList)
+        TArray<FTextureRHIRef, TInlineAllocator<6>> LeftFaces;
+        TArray<FTextureRHIRef, TInlineAllocator<6>> RightFaces;
+        TArray<FFaceCopyRegion, TInlineAllocator<6>> LeftRegions;
+        TArray<FFaceCopyRegion, TInlineAllocator<6>> RightRegions;
+        if (!GatherEyeFaces(Layers[LayerIndex].LeftEye, Settings.Resolution, LeftFaces, LeftRegions)
+            || (bStereo && !GatherEyeFaces(Layers[LayerIndex].RightEye, Settings.Resolution, RightFaces, RightRegions)))
         {
-            ConvertPlanarOnRenderThread(Settings, SourceTexture, OutputSize, bLinear, Result);
-            CompletionEvent->Trigger();
+            continue;
+        }
+
+        // Faces are copied into one array per batch, which needs a single source format.
+        const EPixelFormat SourceFormat = LeftFaces[0]->GetFormat();
+        FRemapLayerBatch* Batch = Batches.FindByPredicate([SourceFormat, MaxLayersPerBatch](const FRemapLayerBatch& Candidate)
+        {
+            return Candidate.SourceFormat == SourceFormat && Candidate.LayerIndices.Num() < MaxLayersPerBatch;
         });
+        if (!Batch)
+        {
+            Batch = &Batches.AddDefaulted_GetRef();
+            Batch->SourceFormat = SourceFormat;
+        }
 
-        CompletionEvent->Wait();
-        FPlatformProcess::ReturnSynchEventToPool(CompletionEvent);
+        Batch->LayerIndices.Add(LayerIndex);
+        Batch->LeftFaces.Append(LeftFaces);
+        Batch->LeftRegions.Append(LeftRegions);
+        Batch->RightFaces.Append(RightFaces);
+        Batch->RightRegions.Append(RightRegions);
     }
 
+    if (Batches.Num() == 0)
+    {
+        return Results;
+    }
+
+    // Built on the game thread so a settings change never stalls the render thread on table generation.
+    FOmniCaptureProjectionParams Params;
+    FIntPoint EyeSize;
+    FOmniCaptureProjectionRemap::GetConverterParams(Settings, Params, EyeSize);
+    const TSharedRef<const FOmniCaptureRemapTable> Table = FOmniCaptureProjectionRemap::FindOrBuildTable(Params, EyeSize, Settings.Resolution, Settings.SeamBlend);
+
+    FEvent* CompletionEvent = FPlatformProcess::GetSynchEventFromPool();
+    ENQUEUE_RENDER_COMMAND(OmniCaptureProjectionRemapLayers)([Settings, Table, Batches = MoveTemp(Batches), &Results, CompletionEvent](FRHICommandListImmediate&)
+    {
+        ConvertLayersOnRenderThread(Settings, Table, Batches, Results);
+        CompletionEvent->Trigger();
+    });
+
+    CompletionEvent->Wait();
+    FPlatformProcess::ReturnSynchEventToPool(CompletionEvent);
+
+    return Results;
+}
+
+FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertCubemapsOnCPU(const FOmniCaptureSettings& Settings, const FOmniCaptureCubemapPixels& LeftCubemap, const FOmniCaptureCubemapPixels& RightCubemap, EOmniCapturePixelPrecision Precision)
+{
+    FOmniCaptureEquirectResult Result;
+    if (Settings.IsPlanar() || Settings.UsesOmniDirectionalStereo() || !LeftCubemap.IsValid() || (Settings.Mode == EOmniCaptureMode::Stereo && !RightCubemap.IsValid()))
+    {
+        return Result;
+    }
+
+    RemapCubemapsOnCPU(Settings, LeftCubemap, RightCubemap, Precision, Result);
     return Result;
 }
+
+void FOmniCaptureEquirectConverter::PackOutputPixels(const FOmniCaptureSettings& Settings, FOmniCaptureEquirectResult& InOutResult, TUniquePtr<FImagePixelData>* OutUnpackedPixels)
+{
+    if (!Settings.UsesPackedFrames() || !InOutResult.PixelData.IsValid() || InOutResult.PixelDataType == EOmniCapturePixelDataType::PackedRGB10A2)
+    {
+        return;
+    }
+
+    TUniquePtr<TImagePixelData<FOmniCapturePackedRGB10A2>> Packed = FOmniCapturePixelPacking::PackFrame(*InOutResult.PixelData, InOutResult.PixelDataType, InOutResult.bIsLinear, Settings.ColorSpace);
+    if (!Packed.IsValid())
+    {
+        return;
+    }
+
+    if (OutUnpackedPixels)
+    {
+        *OutUnpackedPixels = MoveTemp(InOutResult.PixelData);
+    }
+
+    // Packed values are display encoded, so the frame is no longer linear.
+    InOutResult.PixelData = MoveTemp(Packed);
+    InOutResult.PixelDataType = EOmniCapturePixelDataType::PackedRGB10A2;
+    InOutResult.bIsLinear = false;
+}
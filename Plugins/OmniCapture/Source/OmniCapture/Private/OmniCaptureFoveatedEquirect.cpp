@@ -0,0 +1,111 @@
+#include "OmniCaptureFoveatedEquirect.h"
+
+FOmniCaptureFoveatedLayout FOmniCaptureFoveatedLayout::Build(const FIntPoint& InSourceSize, float InStartLatitudeDegrees, int32 InLevels)
+{
+    FOmniCaptureFoveatedLayout Layout;
+    Layout.SourceSize = FIntPoint(FMath::Max(1, InSourceSize.X), FMath::Max(1, InSourceSize.Y));
+    Layout.StartLatitudeDegrees = FMath::Clamp(InStartLatitudeDegrees, 0.0f, 90.0f);
+    Layout.Levels = FMath::Clamp(InLevels, 0, 8);
+
+    const int32 Width = Layout.SourceSize.X;
+    const int32 Height = Layout.SourceSize.Y;
+    const double BandSpan = Layout.Levels > 0 ? (90.0 - Layout.StartLatitudeDegrees) / Layout.Levels : 90.0;
+
+    auto GetDivisor = [&Layout, Width, Height, BandSpan](int32 Row)
+    {
+        const double Latitude = FMath::Abs(90.0 - (Row + 0.5) * 180.0 / Height);
+        if (Layout.Levels == 0 || Latitude < Layout.StartLatitudeDegrees || BandSpan <= 0.0)
+        {
+            return 1;
+        }
+
+        int32 Level = FMath::Min(Layout.Levels, 1 + FMath::FloorToInt((Latitude - Layout.StartLatitudeDegrees) / BandSpan));
+        // Only divide evenly so every packed pixel covers a whole number of source pixels.
+        while (Level > 0 && (Width % (1 << Level)) != 0)
+        {
+            --Level;
+        }
+        return 1 << Level;
+    };
+
+    Layout.SourceRows.SetNum(Height);
+    int32 Row = 0;
+    while (Row < Height)
+    {
+        FOmniCaptureFoveatedBand Band;
+        Band.FirstSourceRow = Row;
+        Band.Divisor = GetDivisor(Row);
+        Band.FirstOutputRow = Layout.OutputRowDivisor.Num();
+        while (Row < Height && GetDivisor(Row) == Band.Divisor)
+        {
+            ++Row;
+        }
+        Band.SourceRowCount = Row - Band.FirstSourceRow;
+
+        const int32 SegmentWidth = Width / Band.Divisor;
+        for (int32 Index = 0; Index < Band.SourceRowCount; ++Index)
+        {
+            FSourceRow& Source = Layout.SourceRows[Band.FirstSourceRow + Index];
+            Source.OutputRow = Band.FirstOutputRow + Index / Band.Divisor;
+            Source.OutputX = (Index % Band.Divisor) * SegmentWidth;
+            Source.Width = SegmentWidth;
+
+            if (Index % Band.Divisor == 0)
+            {
+                Layout.OutputRowFirstSource.Add(Band.FirstSourceRow + Index);
+                Layout.OutputRowSourceCount.Add(FMath::Min(Band.Divisor, Band.SourceRowCount - Index));
+                Layout.OutputRowDivisor.Add(Band.Divisor);
+            }
+        }
+
+        Layout.Bands.Add(Band);
+    }
+
+    return Layout;
+}
+
+bool FOmniCaptureFoveatedLayout::ResolveOutputPixel(int32 X, int32 OutputRow, int32& OutSourceRow, double& OutU) const
+{
+    if (!OutputRowDivisor.IsValidIndex(OutputRow) || X < 0 || X >= SourceSize.X)
+    {
+        return false;
+    }
+
+    const int32 SegmentWidth = SourceSize.X / OutputRowDivisor[OutputRow];
+    const int32 Segment = X / SegmentWidth;
+    if (Segment >= OutputRowSourceCount[OutputRow])
+    {
+        return false;
+    }
+
+    OutSourceRow = OutputRowFirstSource[OutputRow] + Segment;
+    OutU = ((X - Segment * SegmentWidth) + 0.5) / SegmentWidth;
+    return true;
+}
+
+void FOmniCaptureFoveatedLayout::Pack(TArrayView<const FLinearColor> Equirect, TArray<FLinearColor>& OutPacked) const
+{
+    OutPacked.SetNumZeroed(SourceSize.X * GetPackedHeight());
+    if (Equirect.Num() < SourceSize.X * SourceSize.Y)
+    {
+        return;
+    }
+
+    for (int32 Row = 0; Row < SourceSize.Y; ++Row)
+    {
+        const FSourceRow& Source = SourceRows[Row];
+        const int32 Divisor = SourceSize.X / Source.Width;
+        const float Weight = 1.0f / Divisor;
+        const FLinearColor* SourcePixels = Equirect.GetData() + Row * SourceSize.X;
+        FLinearColor* Dest = OutPacked.GetData() + Source.OutputRow * SourceSize.X + Source.OutputX;
+        for (int32 X = 0; X < Source.Width; ++X)
+        {
+            FLinearColor Sum = FLinearColor::Transparent;
+            for (int32 Tap = 0; Tap < Divisor; ++Tap)
+            {
+                Sum += SourcePixels[X * Divisor + Tap];
+            }
+            Dest[X] = Sum * Weight;
+        }
+    }
+}
@@ -0,0 +1,379 @@
+#include "OmniCaptureFrameIndex.h"
+
+#include "Dom/JsonObject.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogOmniCaptureFrameIndex, Log, All);
+
+namespace
+{
+    constexpr int32 GFrameIndexFlushRecords = 256;
+    constexpr double GFrameIndexFlushSeconds = 1.0;
+    constexpr int32 GManifestFramesPerChunk = 4096;
+    constexpr int32 GSidecarRecordsPerRead = 4096;
+
+    void AppendUTF8(FArchive& Archive, const FString& Text)
+    {
+        FTCHARToUTF8 Converted(*Text);
+        Archive.Serialize(const_cast<ANSICHAR*>(Converted.Get()), Converted.Length());
+    }
+
+    /** Calls Visit for every whole record of a sidecar, reading it in fixed-size chunks rather than all at once. */
+    template<typename VisitorType>
+    bool ForEachRecord(const FString& InBinaryPath, VisitorType Visit)
+    {
+        TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*InBinaryPath, FILEREAD_Silent));
+        if (!Reader.IsValid() || Reader->TotalSize() < FOmniCaptureFrameIndexWriter::FileHeaderSize)
+        {
+            return false;
+        }
+
+        uint32 Header[4];
+        Reader->Serialize(Header, sizeof(Header));
+        if (Header[0] != FOmniCaptureFrameIndexWriter::FileMagic || Header[1] != FOmniCaptureFrameIndexWriter::FileVersion || Header[2] != sizeof(FOmniCaptureFrameIndexRecord))
+        {
+            UE_LOG(LogOmniCaptureFrameIndex, Warning, TEXT("%s is not a compatible frame index."), *InBinaryPath);
+            return false;
+        }
+
+        // A crash can leave a partial record at the end; only whole records are read.
+        const int64 NumRecords = (Reader->TotalSize() - FOmniCaptureFrameIndexWriter::FileHeaderSize) / static_cast<int64>(sizeof(FOmniCaptureFrameIndexRecord));
+        TArray<FOmniCaptureFrameIndexRecord> Records;
+        for (int64 First = 0; First < NumRecords; First += GSidecarRecordsPerRead)
+        {
+            const int32 Count = static_cast<int32>(FMath::Min<int64>(GSidecarRecordsPerRead, NumRecords - First));
+            Records.SetNumUninitialized(Count, EAllowShrinking::No);
+            Reader->Serialize(Records.GetData(), Count * sizeof(FOmniCaptureFrameIndexRecord));
+            for (const FOmniCaptureFrameIndexRecord& Record : Records)
+            {
+                Visit(Record);
+            }
+        }
+        return !Reader->IsError();
+    }
+
+    FOmniCaptureFrameMetadata MakeFrameMetadata(const FOmniCaptureFrameIndexRecord& Record)
+    {
+        FOmniCaptureFrameMetadata Metadata;
+        Metadata.FrameIndex = Record.FrameIndex;
+        Metadata.Timecode = Record.Timecode;
+        Metadata.bKeyFrame = (Record.Flags & FOmniCaptureFrameIndexRecord::FlagKeyFrame) != 0;
+        Metadata.bDuplicate = (Record.Flags & FOmniCaptureFrameIndexRecord::FlagDuplicate) != 0;
+        Metadata.SkippedSlots = static_cast<int32>(Record.Value);
+        return Metadata;
+    }
+
+    /** Writes the serialized Root up to an open "frames" array; rows and the footer are streamed after it. */
+    TUniquePtr<FArchive> BeginManifest(const TSharedRef<FJsonObject>& Root, const FString& OutJsonPath)
+    {
+        FString RootString;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RootString);
+        if (!FJsonSerializer::Serialize(Root, Writer))
+        {
+            return nullptr;
+        }
+
+        // Splice the streamed arrays into the serialized root so no per-frame FJsonObject is ever built.
+        RootString.TrimEndInline();
+        if (!RootString.EndsWith(TEXT("}")))
+        {
+            return nullptr;
+        }
+        RootString.LeftChopInline(1);
+        RootString.TrimEndInline();
+        const bool bRootHasFields = !RootString.EndsWith(TEXT("{"));
+
+        TUniquePtr<FArchive> Archive(IFileManager::Get().CreateFileWriter(*OutJsonPath));
+        if (Archive.IsValid())
+        {
+            AppendUTF8(*Archive, RootString);
+            AppendUTF8(*Archive, bRootHasFields ? TEXT(",\n\t\"frames\": [") : TEXT("\n\t\"frames\": ["));
+        }
+        return Archive;
+    }
+
+    /** Adds one "frames" row to Chunk and hands Chunk to the archive every GManifestFramesPerChunk rows. */
+    void AppendFrameRow(FArchive& Archive, FString& Chunk, int64 Row, const FOmniCaptureFrameMetadata& Metadata, int64 EncodedBytes)
+    {
+        Chunk += FString::Printf(TEXT("%s\n\t\t{ \"index\": %d, \"timecode\": %.17g, \"keyFrame\": %s"),
+            Row > 0 ? TEXT(",") : TEXT(""),
+            Metadata.FrameIndex,
+            Metadata.Timecode,
+            Metadata.bKeyFrame ? TEXT("true") : TEXT("false"));
+        if (EncodedBytes >= 0)
+        {
+            Chunk += FString::Printf(TEXT(", \"encodedBytes\": %lld"), EncodedBytes);
+        }
+        if (Metadata.bDuplicate)
+        {
+            Chunk += TEXT(", \"duplicate\": true");
+        }
+        if (Metadata.SkippedSlots > 0)
+        {
+            Chunk += FString::Printf(TEXT(", \"skippedSlots\": %d"), Metadata.SkippedSlots);
+        }
+        Chunk += TEXT(" }");
+
+        if ((Row + 1) % GManifestFramesPerChunk == 0)
+        {
+            AppendUTF8(Archive, Chunk);
+            Chunk.Reset();
+        }
+    }
+
+    /** Closes the "frames" array, writes "dropEvents" and the closing brace. */
+    bool EndManifest(FArchive& Archive, FString& Chunk, const TArray<FOmniCaptureFrameIndexRecord>& Drops)
+    {
+        Chunk += TEXT("\n\t],\n\t\"dropEvents\": [");
+        for (int32 Index = 0; Index < Drops.Num(); ++Index)
+        {
+            const FOmniCaptureFrameIndexRecord& Drop = Drops[Index];
+            Chunk += FString::Printf(TEXT("%s\n\t\t{ \"index\": %d, \"timecode\": %.17g }"), Index > 0 ? TEXT(",") : TEXT(""), Drop.FrameIndex, Drop.Timecode);
+        }
+        Chunk += TEXT("\n\t]\n}");
+        AppendUTF8(Archive, Chunk);
+
+        return Archive.Close();
+    }
+}
+
+FOmniCaptureFrameIndexWriter::FOmniCaptureFrameIndexWriter()
+{
+}
+
+FOmniCaptureFrameIndexWriter::~FOmniCaptureFrameIndexWriter()
+{
+    Close();
+}
+
+FString FOmniCaptureFrameIndexWriter::MakeBinaryPath(const FString& Directory, const FString& BaseFileName)
+{
+    return Directory / (BaseFileName + TEXT("_FrameIndex.bin"));
+}
+
+FString FOmniCaptureFrameIndexWriter::MakeHeaderPath(const FString& Directory, const FString& BaseFileName)
+{
+    return Directory / (BaseFileName + TEXT("_FrameIndex.json"));
+}
+
+bool FOmniCaptureFrameIndexWriter::Open(const FString& Directory, const FString& BaseFileName, const FOmniCaptureSettings& Settings)
+{
+    Close();
+
+    FScopeLock Lock(&WriterCS);
+
+    BinaryPath = MakeBinaryPath(Directory, BaseFileName);
+    RecordCount = 0;
+    PendingRecords.Reset();
+    PendingRecords.Reserve(GFrameIndexFlushRecords);
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*Directory);
+    FileHandle.Reset(PlatformFile.OpenWrite(*BinaryPath, false, false));
+    if (!FileHandle.IsValid())
+    {
+        UE_LOG(LogOmniCaptureFrameIndex, Warning, TEXT("Failed to open frame index %s"), *BinaryPath);
+        return false;
+    }
+
+    uint32 Header[4] = { FileMagic, FileVersion, static_cast<uint32>(sizeof(FOmniCaptureFrameIndexRecord)), 0 };
+    FileHandle->Write(reinterpret_cast<const uint8*>(Header), sizeof(Header));
+
+    TSharedRef<FJsonObject> HeaderJson = MakeShared<FJsonObject>();
+    HeaderJson->SetStringField(TEXT("format"), TEXT("OmniCaptureFrameIndex"));
+    HeaderJson->SetNumberField(TEXT("version"), FileVersion);
+    HeaderJson->SetStringField(TEXT("binary"), FPaths::GetCleanFilename(BinaryPath));
+    HeaderJson->SetNumberField(TEXT("headerBytes"), FileHeaderSize);
+    HeaderJson->SetNumberField(TEXT("recordBytes"), sizeof(FOmniCaptureFrameIndexRecord));
+    HeaderJson->SetStringField(TEXT("layout"), TEXT("f64 timecode, i64 value, i32 frameIndex, u8 type, u8 flags, u16 reserved"));
+    HeaderJson->SetStringField(TEXT("types"), TEXT("0=frame, 1=dropped, 2=encodedBytes"));
+    HeaderJson->SetStringField(TEXT("frameRecords"), TEXT("value=skipped output slots, flags: 1=keyFrame, 2=duplicate"));
+    HeaderJson->SetStringField(TEXT("fileBase"), BaseFileName);
+    HeaderJson->SetNumberField(TEXT("targetFrameRate"), Settings.TargetFrameRate);
+
+    FString HeaderString;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&HeaderString);
+    if (FJsonSerializer::Serialize(HeaderJson, Writer))
+    {
+        FFileHelper::SaveStringToFile(HeaderString, *MakeHeaderPath(Directory, BaseFileName));
+    }
+
+    LastFlushTime = FPlatformTime::Seconds();
+    return true;
+}
+
+void FOmniCaptureFrameIndexWriter::Close()
+{
+    FScopeLock Lock(&WriterCS);
+    if (!FileHandle.IsValid())
+    {
+        return;
+    }
+
+    FlushLocked();
+    FileHandle.Reset();
+}
+
+void FOmniCaptureFrameIndexWriter::AppendFrame(const FOmniCaptureFrameMetadata& Metadata)
+{
+    FOmniCaptureFrameIndexRecord Record;
+    Record.Type = static_cast<uint8>(EOmniCaptureFrameIndexRecordType::Frame);
+    Record.FrameIndex = Metadata.FrameIndex;
+    Record.Timecode = Metadata.Timecode;
+    Record.Value = Metadata.SkippedSlots;
+    Record.Flags = (Metadata.bKeyFrame ? FOmniCaptureFrameIndexRecord::FlagKeyFrame : 0)
+        | (Metadata.bDuplicate ? FOmniCaptureFrameIndexRecord::FlagDuplicate : 0);
+    AppendRecord(Record);
+}
+
+void FOmniCaptureFrameIndexWriter::AppendDrop(int32 FrameIndex, double Timecode)
+{
+    FOmniCaptureFrameIndexRecord Record;
+    Record.Type = static_cast<uint8>(EOmniCaptureFrameIndexRecordType::Dropped);
+    Record.FrameIndex = FrameIndex;
+    Record.Timecode = Timecode;
+    AppendRecord(Record);
+}
+
+void FOmniCaptureFrameIndexWriter::AppendEncodedSize(int32 FrameIndex, int64 EncodedBytes)
+{
+    FOmniCaptureFrameIndexRecord Record;
+    Record.Type = static_cast<uint8>(EOmniCaptureFrameIndexRecordType::Encoded);
+    Record.FrameIndex = FrameIndex;
+    Record.Value = EncodedBytes;
+    AppendRecord(Record);
+}
+
+void FOmniCaptureFrameIndexWriter::Flush()
+{
+    FScopeLock Lock(&WriterCS);
+    FlushLocked();
+}
+
+void FOmniCaptureFrameIndexWriter::AppendRecord(const FOmniCaptureFrameIndexRecord& Record)
+{
+    FScopeLock Lock(&WriterCS);
+    if (!FileHandle.IsValid())
+    {
+        return;
+    }
+
+    PendingRecords.Add(Record);
+    ++RecordCount;
+
+    if (PendingRecords.Num() >= GFrameIndexFlushRecords || (FPlatformTime::Seconds() - LastFlushTime) >= GFrameIndexFlushSeconds)
+    {
+        FlushLocked();
+    }
+}
+
+void FOmniCaptureFrameIndexWriter::FlushLocked()
+{
+    if (!FileHandle.IsValid())
+    {
+        return;
+    }
+
+    if (PendingRecords.Num() > 0)
+    {
+        FileHandle->Write(reinterpret_cast<const uint8*>(PendingRecords.GetData()), PendingRecords.Num() * sizeof(FOmniCaptureFrameIndexRecord));
+        PendingRecords.Reset();
+    }
+
+    FileHandle->Flush();
+    LastFlushTime = FPlatformTime::Seconds();
+}
+
+bool FOmniCaptureFrameIndexWriter::Load(const FString& InBinaryPath, FOmniCaptureFrameIndexContents& OutContents)
+{
+    OutContents = FOmniCaptureFrameIndexContents();
+
+    TMap<int32, int32> FrameLookup;
+    return ForEachRecord(InBinaryPath, [&OutContents, &FrameLookup](const FOmniCaptureFrameIndexRecord& Record)
+    {
+        switch (static_cast<EOmniCaptureFrameIndexRecordType>(Record.Type))
+        {
+        case EOmniCaptureFrameIndexRecordType::Frame:
+            OutContents.Frames.AddDefaulted_GetRef().Metadata = MakeFrameMetadata(Record);
+            FrameLookup.Add(Record.FrameIndex, OutContents.Frames.Num() - 1);
+            break;
+        case EOmniCaptureFrameIndexRecordType::Dropped:
+            OutContents.Drops.Add(Record);
+            break;
+        case EOmniCaptureFrameIndexRecordType::Encoded:
+            if (const int32* EntryIndex = FrameLookup.Find(Record.FrameIndex))
+            {
+                OutContents.Frames[*EntryIndex].EncodedBytes = Record.Value;
+            }
+            break;
+        default:
+            break;
+        }
+    });
+}
+
+bool FOmniCaptureFrameIndexWriter::ExportManifestJson(const FOmniCaptureFrameIndexContents& Contents, const TSharedRef<FJsonObject>& Root, const FString& OutJsonPath)
+{
+    TUniquePtr<FArchive> Archive = BeginManifest(Root, OutJsonPath);
+    if (!Archive.IsValid())
+    {
+        return false;
+    }
+
+    FString Chunk;
+    for (int32 Index = 0; Index < Contents.Frames.Num(); ++Index)
+    {
+        AppendFrameRow(*Archive, Chunk, Index, Contents.Frames[Index].Metadata, Contents.Frames[Index].EncodedBytes);
+    }
+    return EndManifest(*Archive, Chunk, Contents.Drops);
+}
+
+bool FOmniCaptureFrameIndexWriter::ExportManifestJson(const FString& InBinaryPath, const TSharedRef<FJsonObject>& Root, const FString& OutJsonPath)
+{
+    // First pass keeps only what a frame row cannot know when it is written: its later encode size, and the drops.
+    TMap<int32, int64> EncodedBytesByFrame;
+    TArray<FOmniCaptureFrameIndexRecord> Drops;
+    const bool bScanned = ForEachRecord(InBinaryPath, [&EncodedBytesByFrame, &Drops](const FOmniCaptureFrameIndexRecord& Record)
+    {
+        if (Record.Type == static_cast<uint8>(EOmniCaptureFrameIndexRecordType::Encoded))
+        {
+            EncodedBytesByFrame.Add(Record.FrameIndex, Record.Value);
+        }
+        else if (Record.Type == static_cast<uint8>(EOmniCaptureFrameIndexRecordType::Dropped))
+        {
+            Drops.Add(Record);
+        }
+    });
+    if (!bScanned)
+    {
+        return false;
+    }
+
+    TUniquePtr<FArchive> Archive = BeginManifest(Root, OutJsonPath);
+    if (!Archive.IsValid())
+    {
+        return false;
+    }
+
+    // Second pass streams the frame rows straight from the sidecar into the manifest, a chunk at a time.
+    FString Chunk;
+    int64 Row = 0;
+    FArchive& ManifestArchive = *Archive;
+    const bool bStreamed = ForEachRecord(InBinaryPath, [&ManifestArchive, &Chunk, &Row, &EncodedBytesByFrame](const FOmniCaptureFrameIndexRecord& Record)
+    {
+        if (Record.Type == static_cast<uint8>(EOmniCaptureFrameIndexRecordType::Frame))
+        {
+            const int64* EncodedBytes = EncodedBytesByFrame.Find(Record.FrameIndex);
+            AppendFrameRow(ManifestArchive, Chunk, Row++, MakeFrameMetadata(Record), EncodedBytes ? *EncodedBytes : -1);
+        }
+    });
+    return EndManifest(ManifestArchive, Chunk, Drops) && bStreamed;
+}
@@ -0,0 +1,115 @@
+#include "OmniCaptureFramePacer.h"
+
+namespace
+{
+    // Absorbs rounding when the tick rate is an exact multiple of the target (4 x 1/120 s should be one 30 fps slot).
+    constexpr double GSlotTolerance = 1.0e-6;
+}
+
+void FOmniCaptureFramePacer::Reset(EOmniCaptureFramePacing InMode, double InTargetFrameRate, int32 InTemporalSamples, int32 InWarmUpFrames)
+{
+    Mode = InMode;
+    FrameRate = MakeFrameRate(InTargetFrameRate);
+    TargetFrameRate = InTargetFrameRate > 0.0 ? FrameRate.AsDecimal() : 0.0;
+    // The first tick always captures slot zero.
+    Accumulator = 1.0;
+    TemporalSamples = FMath::Max(InTemporalSamples, 1);
+    SubSampleIndex = 0;
+    WarmUpTicksRemaining = IsFixedTimestep() ? static_cast<int64>(FMath::Max(InWarmUpFrames, 0)) * TemporalSamples : 0;
+    NextSlot = 0;
+    CapturedTicks = 0;
+    DecimatedTicks = 0;
+    WarmUpTicks = 0;
+    DuplicatedSlots = 0;
+    SkippedSlots = 0;
+}
+
+FOmniCaptureFramePacingStep FOmniCaptureFramePacer::Advance(double DeltaSeconds)
+{
+    FOmniCaptureFramePacingStep Step;
+    if (!IsPacing())
+    {
+        Step.Slot = NextSlot++;
+        Step.bCapture = true;
+        ++CapturedTicks;
+        return Step;
+    }
+
+    if (IsFixedTimestep())
+    {
+        if (WarmUpTicksRemaining > 0)
+        {
+            --WarmUpTicksRemaining;
+            ++WarmUpTicks;
+            return Step;
+        }
+
+        // Earlier sub-steps let temporal accumulation converge; the last one of each frame is captured.
+        if (++SubSampleIndex < TemporalSamples)
+        {
+            ++DecimatedTicks;
+            return Step;
+        }
+
+        SubSampleIndex = 0;
+        Step.Slot = NextSlot++;
+        Step.bCapture = true;
+        ++CapturedTicks;
+        return Step;
+    }
+
+    // The first tick's delta predates the capture, so it only takes slot zero.
+    Accumulator += NextSlot > 0 ? FMath::Max(DeltaSeconds, 0.0) * TargetFrameRate : 0.0;
+    const int64 DueSlots = static_cast<int64>(FMath::FloorToDouble(Accumulator + GSlotTolerance));
+    if (DueSlots <= 0)
+    {
+        ++DecimatedTicks;
+        return Step;
+    }
+
+    Accumulator = FMath::Max(Accumulator - static_cast<double>(DueSlots), 0.0);
+    NextSlot += DueSlots;
+    Step.Slot = NextSlot - 1;
+    Step.bCapture = true;
+    ++CapturedTicks;
+
+    const int64 MissedSlots = DueSlots - 1;
+    if (MissedSlots > 0)
+    {
+        const int64 MaxDuplicates = Mode == EOmniCaptureFramePacing::DecimateAndDuplicate ? static_cast<int64>(FMath::CeilToDouble(TargetFrameRate)) : 0;
+        const int64 Duplicates = FMath::Min(MissedSlots, MaxDuplicates);
+        Step.DuplicateSlots = static_cast<int32>(Duplicates);
+        Step.SkippedSlots = static_cast<int32>(FMath::Min<int64>(MissedSlots - Duplicates, MAX_int32));
+        DuplicatedSlots += Duplicates;
+        SkippedSlots += MissedSlots - Duplicates;
+    }
+    return Step;
+}
+
+double FOmniCaptureFramePacer::GetSlotTimecode(int64 Slot) const
+{
+    return TargetFrameRate > 0.0 ? static_cast<double>(Slot * FrameRate.Denominator) / static_cast<double>(FrameRate.Numerator) : 0.0;
+}
+
+double FOmniCaptureFramePacer::GetFixedDeltaSeconds() const
+{
+    return TargetFrameRate > 0.0 ? static_cast<double>(FrameRate.Denominator) / (static_cast<double>(FrameRate.Numerator) * TemporalSamples) : 0.0;
+}
+
+FFrameRate FOmniCaptureFramePacer::MakeFrameRate(double FramesPerSecond)
+{
+    const double Rate = FramesPerSecond > 0.0 ? FramesPerSecond : 30.0;
+    const double Whole = FMath::RoundToDouble(Rate);
+    if (FMath::IsNearlyEqual(Rate, Whole, 1.0e-3))
+    {
+        return FFrameRate(static_cast<int32>(Whole), 1);
+    }
+
+    const double NTSC = FMath::RoundToDouble(Rate * 1.001);
+    if (FMath::IsNearlyEqual(Rate, NTSC / 1.001, 1.0e-3))
+    {
+        return FFrameRate(static_cast<int32>(NTSC) * 1000, 1001);
+    }
+
+    return FFrameRate(FMath::RoundToInt(Rate * 1000.0), 1000);
+}
@@ -15,6 +15,7 @@
 #include "Internationalization/Internationalization.h"
 #include "Math/Vector2D.h"
 #include "OmniCaptureVersion.h"
+#include "OmniCapturePixelPacking.h"
 
 #include <exception>
 
@@ -138,6 +139,7 @@ namespace
         }
 
         IFileManager::Get().Delete(*FilePath, false, true, false);
+        OMNICAPTURE_STAGE_SCOPE(FileWrite);
         return FFileHelper::SaveArrayToFile(CompressedData, *FilePath);
     }
 
@@ -189,7 +191,10 @@ namespace
             return;
         }
 
-        Archive->Serialize(Data, Length);
+        {
+            OMNICAPTURE_STAGE_SCOPE(FileWrite);
+            Archive->Serialize(Data, Length);
+        }
         if (Archive->IsError())
         {
             png_error(PngPtr, "Failed to write PNG data");
@@ -209,6 +214,8 @@ namespace
 FOmniCaptureImageWriter::FOmniCaptureImageWriter()
 {
     bStopRequested.Store(false);
+    PendingFrameCount.Store(0);
+    PNGCompressionLevel.Store(-1);
 }
 FOmniCaptureImageWriter::~FOmniCaptureImageWriter() { Flush(); }
 
@@ -224,17 +231,25 @@ void FOmniCaptureImageWriter::Initialize(const FOmniCaptureSettings& Settings, c
     bPackEXRAuxiliaryLayers = Settings.bPackEXRAuxiliaryLayers;
     bUseEXRMultiPart = Settings.bUseEXRMultiPart;
     TargetEXRCompression = Settings.EXRCompression;
+    TargetColorSpace = Settings.ColorSpace;
+    TargetFrameRate = Settings.TargetFrameRate;
     bStopRequested.Store(false);
     bInitialized = true;
 }
 
-void FOmniCaptureImageWriter::EnqueueFrame(TUniquePtr<FOmniCaptureFrame>&& Frame, const FString& FrameFileName)
+void FOmniCaptureImageWriter::EnqueueFrame(TUniquePtr<FOmniCaptureFrame>&& Frame, const FString& FrameFileName, const TArray<FString>& DuplicateFileNames)
 {
     if (!bInitialized || !Frame.IsValid() || IsStopRequested())
     {
         return;
     }
 
+    if (TargetFormat == EOmniCaptureImageFormat::Y4M)
+    {
+        WriteY4MFrame(*Frame);
+        return;
+    }
+
     PruneCompletedTasks();
     WaitForAvailableTaskSlot();
 
@@ -247,6 +262,14 @@ void FOmniCaptureImageWriter::EnqueueFrame(TUniquePtr<FOmniCaptureFrame>&& Frame
     FOmniCaptureFrameMetadata Metadata = Frame->Metadata;
     bool bIsLinear = Frame->bLinearColor;
 
+    // Duplicates repeat the beauty pass byte for byte, so the written file is copied rather than encoded again.
+    TArray<TPair<int32, FString>> DuplicateTargets;
+    for (int32 Index = 0; Index < Frame->Duplicates.Num() && Index < DuplicateFileNames.Num(); ++Index)
+    {
+        DuplicateTargets.Emplace(Frame->Duplicates[Index].FrameIndex, NormalizeFilePath(OutputDirectory / DuplicateFileNames[Index]));
+    }
+    TArray<FOmniCaptureFrameMetadata> Duplicates = MoveTemp(Frame->Duplicates);
+
     TUniquePtr<FImagePixelData> PixelData = MoveTemp(Frame->PixelData);
     TMap<FName, FOmniCaptureLayerPayload> AuxiliaryLayers = MoveTemp(Frame->AuxiliaryLayers);
     if (!PixelData.IsValid())
@@ -260,44 +283,87 @@ void FOmniCaptureImageWriter::EnqueueFrame(TUniquePtr<FOmniCaptureFrame>&& Frame
     const FString LayerBaseName = FPaths::GetBaseFilename(TargetPath);
     const FString LayerExtension = FPaths::GetExtension(TargetPath, true);
 
-    TFuture<bool> Future = Async(EAsyncExecution::ThreadPool, [this, FilePath = MoveTemp(TargetPath), Format = TargetFormat, bIsLinear, PixelPrecision, PixelDataType, PixelData = MoveTemp(PixelData), AuxiliaryLayers = MoveTemp(AuxiliaryLayers), LayerDirectory, LayerBaseName, LayerExtension]() mutable
+    PendingFrameCount.IncrementExchange();
+    TFuture<bool> Future = Async(EAsyncExecution::ThreadPool, [this, FilePath = MoveTemp(TargetPath), Format = TargetFormat, bIsLinear, PixelPrecision, PixelDataType, PixelData = MoveTemp(PixelData), AuxiliaryLayers = MoveTemp(AuxiliaryLayers), LayerDirectory, LayerBaseName, LayerExtension, FrameIndex = Metadata.FrameIndex, DuplicateTargets = MoveTemp(DuplicateTargets), OnWritten = FrameWrittenCallback, OnStageTimings = StageTimingCallback]() mutable
     {
-        if (Format == EOmniCaptureImageFormat::EXR)
+        auto ReportWritten = [&OnWritten, &FilePath, &DuplicateTargets, FrameIndex](bool bWritten)
         {
-            return WriteEXRFrame(FilePath, bIsLinear, MoveTemp(PixelData), PixelPrecision, PixelDataType, MoveTemp(AuxiliaryLayers), LayerDirectory, LayerBaseName, LayerExtension);
-        }
-
-        bool bResult = WritePixelDataToDisk(MoveTemp(PixelData), FilePath, Format, bIsLinear, PixelPrecision, PixelDataType);
+            if (bWritten && OnWritten)
+            {
+                const int64 FileSize = IFileManager::Get().FileSize(*FilePath);
+                for (const TPair<int32, FString>& Duplicate : DuplicateTargets)
+                {
+                    OnWritten(Duplicate.Key, FileSize);
+                }
+                OnWritten(FrameIndex, FileSize);
+            }
+            return bWritten;
+        };
 
-        for (TPair<FName, FOmniCaptureLayerPayload>& Pair : AuxiliaryLayers)
+        FOmniCaptureStageScope::ResetThreadTimings();
+        bool bResult = false;
         {
-            if (!Pair.Value.PixelData.IsValid())
+            OMNICAPTURE_STAGE_SCOPE(WriterEncode);
+            if (Format == EOmniCaptureImageFormat::EXR)
             {
-                continue;
+                bResult = WriteEXRFrame(FilePath, bIsLinear, MoveTemp(PixelData), PixelPrecision, PixelDataType, MoveTemp(AuxiliaryLayers), LayerDirectory, LayerBaseName, LayerExtension);
             }
-
-            const FString LayerFileName = FString::Printf(TEXT("%s_%s%s"), *LayerBaseName, *Pair.Key.ToString(), *LayerExtension);
-            const FString LayerPath = FPaths::Combine(LayerDirectory, LayerFileName);
-            const bool bLayerLinear = Pair.Value.bLinear;
-            const EOmniCapturePixelPrecision LayerPrecision = (Pair.Value.Precision == EOmniCapturePixelPrecision::Unknown) ? PixelPrecision : Pair.Value.Precision;
-            EOmniCapturePixelDataType LayerType = Pair.Value.PixelDataType;
-            if (LayerType == EOmniCapturePixelDataType::Unknown)
+            else
             {
-                if (bLayerLinear)
+                bResult = WritePixelDataToDisk(MoveTemp(PixelData), FilePath, Format, bIsLinear, PixelPrecision, PixelDataType);
+
+                for (TPair<FName, FOmniCaptureLayerPayload>& Pair : AuxiliaryLayers)
                 {
-                    LayerType = (LayerPrecision == EOmniCapturePixelPrecision::FullFloat)
-                        ? EOmniCapturePixelDataType::LinearColorFloat32
-                        : EOmniCapturePixelDataType::LinearColorFloat16;
+                    if (!Pair.Value.PixelData.IsValid())
+                    {
+                        continue;
+                    }
+
+                    const FString LayerFileName = FString::Printf(TEXT("%s_%s%s"), *LayerBaseName, *Pair.Key.ToString(), *LayerExtension);
+                    const FString LayerPath = FPaths::Combine(LayerDirectory, LayerFileName);
+                    const bool bLayerLinear = Pair.Value.bLinear;
+                    const EOmniCapturePixelPrecision LayerPrecision = (Pair.Value.Precision == EOmniCapturePixelPrecision::Unknown) ? PixelPrecision : Pair.Value.Precision;
+                    EOmniCapturePixelDataType LayerType = Pair.Value.PixelDataType;
+                    if (LayerType == EOmniCapturePixelDataType::Unknown)
+                    {
+                        if (bLayerLinear)
+                        {
+                            LayerType = (LayerPrecision == EOmniCapturePixelPrecision::FullFloat)
+                                ? EOmniCapturePixelDataType::LinearColorFloat32
+                                : EOmniCapturePixelDataType::LinearColorFloat16;
+                        }
+                        else
+                        {
+                            LayerType = EOmniCapturePixelDataType::Color8;
+                        }
+                    }
+                    bResult &= WritePixelDataToDisk(MoveTemp(Pair.Value.PixelData), LayerPath, Format, bLayerLinear, LayerPrecision, LayerType);
                 }
-                else
+            }
+        }
+
+        if (bResult && DuplicateTargets.Num() > 0)
+        {
+            OMNICAPTURE_STAGE_SCOPE(FileWrite);
+            // Duplicates that fail to copy are not reported as written; the frame itself still is.
+            DuplicateTargets.RemoveAll([&FilePath](const TPair<int32, FString>& Duplicate)
+            {
+                if (IFileManager::Get().Copy(*Duplicate.Value, *FilePath, true) == COPY_OK)
                 {
-                    LayerType = EOmniCapturePixelDataType::Color8;
+                    return false;
                 }
-            }
-            bResult &= WritePixelDataToDisk(MoveTemp(Pair.Value.PixelData), LayerPath, Format, bLayerLinear, LayerPrecision, LayerType);
+                UE_LOG(LogTemp, Warning, TEXT("Failed to repeat %s as duplicate frame %s"), *FilePath, *Duplicate.Value);
+                return true;
+            });
         }
 
-        return bResult;
+        if (OnStageTimings)
+        {
+            OnStageTimings(FOmniCaptureStageScope::TakeThreadTimings(FrameIndex));
+        }
+        const bool bWritten = ReportWritten(bResult);
+        PendingFrameCount.DecrementExchange();
+        return bWritten;
     });
 
     TrackPendingTask(MoveTemp(Future));
@@ -306,6 +372,7 @@ void FOmniCaptureImageWriter::EnqueueFrame(TUniquePtr<FOmniCaptureFrame>&& Frame
 
     {
         FScopeLock Lock(&MetadataCS);
+        CapturedMetadata.Append(Duplicates);
         CapturedMetadata.Add(Metadata);
     }
 }
@@ -315,6 +382,10 @@ void FOmniCaptureImageWriter::Flush()
     RequestStop();
     PruneCompletedTasks();
     WaitForAllTasks();
+    {
+        FScopeLock Lock(&Y4MCS);
+        Y4MWriter.Close();
+    }
     bInitialized = false;
 }
 
@@ -326,6 +397,78 @@ TArray<FOmniCaptureFrameMetadata> FOmniCaptureImageWriter::ConsumeCapturedFrames
     return Result;
 }
 
+bool FOmniCaptureImageWriter::WriteY4MFrame(FOmniCaptureFrame& Frame)
+{
+    // Duplicates come first in the stream: they hold the slots ahead of the frame and repeat its packed image.
+    TArray<FOmniCaptureFrameMetadata> Entries = MoveTemp(Frame.Duplicates);
+    Entries.Add(Frame.Metadata);
+
+    FOmniCaptureStageScope::ResetThreadTimings();
+    TArray<int64> BytesWritten;
+    {
+        OMNICAPTURE_STAGE_SCOPE(WriterEncode);
+        TUniquePtr<FImagePixelData> PixelData = MoveTemp(Frame.PixelData);
+        if (!PixelData.IsValid())
+        {
+            return false;
+        }
+
+        if (Frame.PixelDataType != EOmniCapturePixelDataType::PackedRGB10A2)
+        {
+            PixelData = FOmniCapturePixelPacking::PackFrame(*PixelData, Frame.PixelDataType, Frame.bLinearColor, TargetColorSpace);
+            if (!PixelData.IsValid())
+            {
+                UE_LOG(LogTemp, Warning, TEXT("Unsupported pixel data type %d for the Y4M stream"), static_cast<int32>(Frame.PixelDataType));
+                return false;
+            }
+        }
+
+        const TImagePixelData<FOmniCapturePackedRGB10A2>& Packed = static_cast<const TImagePixelData<FOmniCapturePackedRGB10A2>&>(*PixelData);
+        {
+            FScopeLock Lock(&Y4MCS);
+            if (!Y4MWriter.IsOpen())
+            {
+                const FString StreamPath = NormalizeFilePath(OutputDirectory / ((SequenceBaseName.IsEmpty() ? FString(TEXT("OmniCapture")) : SequenceBaseName) + TEXT(".y4m")));
+                if (!Y4MWriter.Open(StreamPath, Packed.GetSize(), TargetFrameRate, TargetColorSpace))
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("Failed to open Y4M stream %s"), *StreamPath);
+                    return false;
+                }
+            }
+            for (const FOmniCaptureFrameMetadata& Entry : Entries)
+            {
+                const int64 Bytes = Y4MWriter.WriteFrame(Packed);
+                if (Bytes <= 0)
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("Failed to append frame %d to the Y4M stream"), Entry.FrameIndex);
+                    break;
+                }
+                BytesWritten.Add(Bytes);
+            }
+        }
+    }
+
+    if (StageTimingCallback)
+    {
+        StageTimingCallback(FOmniCaptureStageScope::TakeThreadTimings(Frame.Metadata.FrameIndex));
+    }
+
+    // Only the entries that reached the stream are reported, in stream order.
+    const bool bWroteAll = BytesWritten.Num() == Entries.Num();
+    Entries.SetNum(BytesWritten.Num());
+    if (FrameWrittenCallback)
+    {
+        for (int32 Index = 0; Index < Entries.Num(); ++Index)
+        {
+            FrameWrittenCallback(Entries[Index].FrameIndex, BytesWritten[Index]);
+        }
+    }
+
+    FScopeLock Lock(&MetadataCS);
+    CapturedMetadata.Append(Entries);
+    return bWroteAll;
+}
+
 bool FOmniCaptureImageWriter::WritePixelDataToDisk(TUniquePtr<FImagePixelData> PixelData, const FString& FilePath, EOmniCaptureImageFormat Format, bool bIsLinear, EOmniCapturePixelPrecision PixelPrecision, EOmniCapturePixelDataType PixelDataType) const
 {
     if (!PixelData.IsValid())
@@ -623,6 +766,11 @@ bool FOmniCaptureImageWriter::WritePNGWithRowSource(const FString& FilePath, con
 
     png_set_write_fn(PngPtr, Archive.Get(), PngWriteDataCallback, PngFlushCallback);
     png_set_IHDR(PngPtr, InfoPtr, Size.X, Size.Y, BitDepth, ColorType, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+    const int32 CompressionLevel = PNGCompressionLevel.Load(EMemoryOrder::Relaxed);
+    if (CompressionLevel >= 0)
+    {
+        png_set_compression_level(PngPtr, CompressionLevel);
+    }
 
     if (BitDepth == 16)
     {
@@ -768,6 +916,7 @@ bool FOmniCaptureImageWriter::WriteBMP(const TImagePixelData<FColor>& PixelData,
     }
 
     IFileManager::Get().Delete(*FilePath, false, true, false);
+    OMNICAPTURE_STAGE_SCOPE(FileWrite);
     return FFileHelper::SaveArrayToFile(CompressedData, *FilePath);
 }
 
@@ -1019,6 +1168,7 @@ bool FOmniCaptureImageWriter::WriteJPEG(const TImagePixelData<FColor>& PixelData
     }
 
     IFileManager::Get().Delete(*FilePath, false, true, false);
+    OMNICAPTURE_STAGE_SCOPE(FileWrite);
     return FFileHelper::SaveArrayToFile(CompressedData, *FilePath);
 }
 
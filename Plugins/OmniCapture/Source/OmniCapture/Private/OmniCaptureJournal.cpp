@@ -0,0 +1,611 @@
+#include "OmniCaptureJournal.h"
+
+#include "OmniCaptureFrameIndex.h"
+#include "OmniCaptureMuxer.h"
+
+#include "Dom/JsonObject.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+#include "JsonObjectConverter.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogOmniCaptureJournal, Log, All);
+
+namespace
+{
+    constexpr int32 GJournalVersion = 1;
+    constexpr double GFrameRangeFlushSeconds = 1.0;
+    constexpr int32 GFrameRangeFlushFrames = 120;
+    const TCHAR* GJournalExtension = TEXT(".omnijournal");
+
+    /** Journals being finalized in this process; the console, subsystem and editor resume paths can overlap. */
+    FCriticalSection GResumeClaimCS;
+    TSet<FString> GResumeClaims;
+
+    bool TryClaimResume(const FString& JournalPath)
+    {
+        FScopeLock Lock(&GResumeClaimCS);
+        bool bAlreadyClaimed = false;
+        GResumeClaims.Add(FPaths::ConvertRelativePathToFull(JournalPath), &bAlreadyClaimed);
+        return !bAlreadyClaimed;
+    }
+
+    void ReleaseResume(const FString& JournalPath)
+    {
+        FScopeLock Lock(&GResumeClaimCS);
+        GResumeClaims.Remove(FPaths::ConvertRelativePathToFull(JournalPath));
+    }
+
+    bool IsResumeClaimed(const FString& JournalPath)
+    {
+        FScopeLock Lock(&GResumeClaimCS);
+        return GResumeClaims.Contains(FPaths::ConvertRelativePathToFull(JournalPath));
+    }
+
+    FString SerializeLine(const TSharedRef<FJsonObject>& Event)
+    {
+        FString Line;
+        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+        FJsonSerializer::Serialize(Event, Writer);
+        Line.AppendChar(TEXT('\n'));
+        return Line;
+    }
+
+    TSharedRef<FJsonObject> MakeEvent(const TCHAR* Type)
+    {
+        TSharedRef<FJsonObject> Event = MakeShared<FJsonObject>();
+        Event->SetStringField(TEXT("event"), Type);
+        Event->SetNumberField(TEXT("time"), FPlatformTime::Seconds());
+        return Event;
+    }
+
+    void WriteSegmentFields(const FOmniCaptureJournalSegment& Segment, const TSharedRef<FJsonObject>& Event)
+    {
+        Event->SetNumberField(TEXT("segment"), Segment.SegmentIndex);
+        Event->SetStringField(TEXT("directory"), Segment.Directory);
+        Event->SetStringField(TEXT("baseFileName"), Segment.BaseFileName);
+        Event->SetStringField(TEXT("audioPath"), Segment.AudioPath);
+        Event->SetStringField(TEXT("videoPath"), Segment.VideoPath);
+    }
+
+    FOmniCaptureJournalSegment& FindOrAddSegment(FOmniCaptureJournalRecovery& Recovery, int32 SegmentIndex)
+    {
+        for (FOmniCaptureJournalSegment& Segment : Recovery.Segments)
+        {
+            if (Segment.SegmentIndex == SegmentIndex)
+            {
+                return Segment;
+            }
+        }
+
+        FOmniCaptureJournalSegment& Segment = Recovery.Segments.AddDefaulted_GetRef();
+        Segment.SegmentIndex = SegmentIndex;
+        return Segment;
+    }
+
+    /** Drops frames whose image never reached the disk, so the concat list only names files FFmpeg can open. */
+    void RemoveMissingImageFrames(const FOmniCaptureJournalRecovery& Recovery, const FOmniCaptureJournalSegment& Segment, TArray<FOmniCaptureFrameMetadata>& InOutFrames, int32& InOutDroppedFrames)
+    {
+        if (!Segment.bHasImageSequence || Recovery.Settings.UsesPackedFrames())
+        {
+            return;
+        }
+
+        const FString Extension = Recovery.Settings.GetImageFileExtension();
+        const int32 Skipped = InOutFrames.RemoveAll([&Segment, &Extension](const FOmniCaptureFrameMetadata& Metadata)
+        {
+            return !FPaths::FileExists(Segment.Directory / FString::Printf(TEXT("%s_%06d%s"), *Segment.BaseFileName, Metadata.FrameIndex, *Extension));
+        });
+
+        if (Skipped > 0)
+        {
+            InOutDroppedFrames += Skipped;
+            UE_LOG(LogOmniCaptureJournal, Warning, TEXT("Segment %d: skipped %d of %d frame(s) whose image files are missing from %s."), Segment.SegmentIndex, Skipped, InOutFrames.Num() + Skipped, *Segment.Directory);
+        }
+    }
+
+    void BuildSegmentFrames(const FOmniCaptureJournalRecovery& Recovery, const FOmniCaptureJournalSegment& Segment, TArray<FOmniCaptureFrameMetadata>& OutFrames, int32& OutDroppedFrames)
+    {
+        OutFrames.Reset();
+        OutDroppedFrames = Segment.DroppedFrames;
+
+        FOmniCaptureFrameIndexContents Contents;
+        if (FOmniCaptureFrameIndexWriter::Load(FOmniCaptureFrameIndexWriter::MakeBinaryPath(Segment.Directory, Segment.BaseFileName), Contents) && Contents.Frames.Num() > 0)
+        {
+            OutFrames.Reserve(Contents.Frames.Num());
+            for (const FOmniCaptureFrameIndexEntry& Entry : Contents.Frames)
+            {
+                OutFrames.Add(Entry.Metadata);
+            }
+            OutDroppedFrames = FMath::Max(OutDroppedFrames, Contents.Drops.Num());
+        }
+        else if (Segment.FrameCount > 0 && Segment.FirstFrame != INDEX_NONE)
+        {
+            // Without a sidecar the journal range is all we have; assume a constant frame rate across it.
+            const double FrameDuration = 1.0 / FMath::Max(1.0, static_cast<double>(Recovery.Settings.TargetFrameRate));
+            OutFrames.Reserve(Segment.FrameCount);
+            for (int32 Offset = 0; Offset < Segment.FrameCount; ++Offset)
+            {
+                FOmniCaptureFrameMetadata& Metadata = OutFrames.AddDefaulted_GetRef();
+                Metadata.FrameIndex = Segment.FirstFrame + Offset;
+                Metadata.Timecode = Offset * FrameDuration;
+                Metadata.bKeyFrame = Offset == 0;
+            }
+        }
+
+        RemoveMissingImageFrames(Recovery, Segment, OutFrames, OutDroppedFrames);
+    }
+}
+
+class FOmniCaptureJournalWorker final : public FRunnable
+{
+public:
+    explicit FOmniCaptureJournalWorker(FOmniCaptureJournal& InOwner)
+        : Owner(InOwner)
+    {
+    }
+
+    virtual uint32 Run() override
+    {
+        while (Owner.bRunning.Load())
+        {
+            Owner.DataEvent->Wait(static_cast<uint32>(GFrameRangeFlushSeconds * 1000.0));
+            Owner.DrainQueue();
+        }
+
+        Owner.DrainQueue();
+        return 0;
+    }
+
+private:
+    FOmniCaptureJournal& Owner;
+};
+
+FOmniCaptureJournal::FOmniCaptureJournal()
+{
+    bRunning = false;
+}
+
+FOmniCaptureJournal::~FOmniCaptureJournal()
+{
+    // Destroying an open journal without End() leaves it on disk for recovery.
+    if (WorkerThread.IsValid())
+    {
+        bRunning = false;
+        DataEvent->Trigger();
+        WorkerThread->WaitForCompletion();
+        WorkerThread.Reset();
+        delete Worker;
+        Worker = nullptr;
+    }
+
+    if (DataEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(DataEvent);
+        DataEvent = nullptr;
+    }
+
+    DrainQueue();
+    FileHandle.Reset();
+}
+
+FString FOmniCaptureJournal::GetJournalDirectory()
+{
+    return FPaths::ProjectSavedDir() / TEXT("OmniCapture") / TEXT("Journals");
+}
+
+bool FOmniCaptureJournal::Begin(const FOmniCaptureSettings& Settings, const FString& BaseDirectory, const FString& BaseFileName)
+{
+    End(false);
+
+    const FDateTime Now = FDateTime::UtcNow();
+    JournalPath = GetJournalDirectory() / FString::Printf(TEXT("%s_%s%s"), *Now.ToString(TEXT("%Y%m%d_%H%M%S")), *FPaths::MakeValidFileName(BaseFileName), GJournalExtension);
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*GetJournalDirectory());
+    FileHandle.Reset(PlatformFile.OpenWrite(*JournalPath, false, false));
+    if (!FileHandle.IsValid())
+    {
+        UE_LOG(LogOmniCaptureJournal, Warning, TEXT("Failed to create capture journal %s; a crash during this capture will not be recoverable."), *JournalPath);
+        return false;
+    }
+
+    RangeSegmentIndex = INDEX_NONE;
+    RangeFirstFrame = INDEX_NONE;
+    RangeLastFrame = INDEX_NONE;
+    RangeFrameCount = 0;
+    LastJournaledFrameCount = 0;
+    LastRangeFlushTime = FPlatformTime::Seconds();
+
+    TSharedRef<FJsonObject> Event = MakeEvent(TEXT("captureBegin"));
+    Event->SetNumberField(TEXT("version"), GJournalVersion);
+    Event->SetNumberField(TEXT("pid"), FPlatformProcess::GetCurrentProcessId());
+    Event->SetStringField(TEXT("startTime"), Now.ToIso8601());
+    Event->SetStringField(TEXT("baseDirectory"), BaseDirectory);
+    Event->SetStringField(TEXT("baseFileName"), BaseFileName);
+
+    TSharedRef<FJsonObject> SettingsObject = MakeShared<FJsonObject>();
+    if (FJsonObjectConverter::UStructToJsonObject(FOmniCaptureSettings::StaticStruct(), &Settings, SettingsObject, 0, 0))
+    {
+        Event->SetObjectField(TEXT("settings"), SettingsObject);
+    }
+
+    // The header is written synchronously so a journal on disk always names its capture.
+    const FTCHARToUTF8 Utf8(*SerializeLine(Event));
+    FileHandle->Write(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+    FileHandle->Flush();
+
+    DataEvent = FPlatformProcess::GetSynchEventFromPool();
+    bRunning = true;
+    Worker = new FOmniCaptureJournalWorker(*this);
+    WorkerThread.Reset(FRunnableThread::Create(Worker, TEXT("OmniCaptureJournal")));
+    return true;
+}
+
+void FOmniCaptureJournal::RecordSegmentOpen(const FOmniCaptureJournalSegment& Segment)
+{
+    TSharedRef<FJsonObject> Event = MakeEvent(TEXT("segmentOpen"));
+    WriteSegmentFields(Segment, Event);
+    EnqueueEvent(Event);
+}
+
+void FOmniCaptureJournal::RecordFrame(int32 SegmentIndex, int32 FrameIndex)
+{
+    if (!FileHandle.IsValid())
+    {
+        return;
+    }
+
+    if (RangeSegmentIndex != SegmentIndex)
+    {
+        FlushFrameRange(true);
+        RangeSegmentIndex = SegmentIndex;
+        RangeFirstFrame = FrameIndex;
+        RangeFrameCount = 0;
+        LastJournaledFrameCount = 0;
+    }
+
+    RangeLastFrame = FrameIndex;
+    ++RangeFrameCount;
+    FlushFrameRange(false);
+}
+
+void FOmniCaptureJournal::RecordSegmentClose(const FOmniCaptureJournalSegment& Segment)
+{
+    FlushFrameRange(true);
+
+    TSharedRef<FJsonObject> Event = MakeEvent(TEXT("segmentClose"));
+    WriteSegmentFields(Segment, Event);
+    Event->SetNumberField(TEXT("frames"), Segment.FrameCount);
+    Event->SetNumberField(TEXT("droppedFrames"), Segment.DroppedFrames);
+    Event->SetBoolField(TEXT("hasImageSequence"), Segment.bHasImageSequence);
+    EnqueueEvent(Event);
+
+    RangeSegmentIndex = INDEX_NONE;
+}
+
+void FOmniCaptureJournal::End(bool bFinalized)
+{
+    if (!FileHandle.IsValid())
+    {
+        return;
+    }
+
+    TSharedRef<FJsonObject> Event = MakeEvent(TEXT("captureEnd"));
+    Event->SetBoolField(TEXT("finalized"), bFinalized);
+    EnqueueEvent(Event);
+
+    if (WorkerThread.IsValid())
+    {
+        bRunning = false;
+        DataEvent->Trigger();
+        WorkerThread->WaitForCompletion();
+        WorkerThread.Reset();
+        delete Worker;
+        Worker = nullptr;
+    }
+
+    if (DataEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(DataEvent);
+        DataEvent = nullptr;
+    }
+
+    DrainQueue();
+    FileHandle.Reset();
+
+    IFileManager::Get().Delete(*JournalPath, false, true, true);
+    JournalPath.Reset();
+}
+
+void FOmniCaptureJournal::EnqueueEvent(const TSharedRef<FJsonObject>& Event)
+{
+    if (!FileHandle.IsValid())
+    {
+        return;
+    }
+
+    Queue.Enqueue(SerializeLine(Event));
+    if (DataEvent)
+    {
+        DataEvent->Trigger();
+    }
+}
+
+void FOmniCaptureJournal::FlushFrameRange(bool bForce)
+{
+    if (RangeSegmentIndex == INDEX_NONE || RangeFrameCount == LastJournaledFrameCount)
+    {
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    if (!bForce && Now - LastRangeFlushTime < GFrameRangeFlushSeconds && RangeFrameCount - LastJournaledFrameCount < GFrameRangeFlushFrames)
+    {
+        return;
+    }
+
+    // Ranges are cumulative per segment, so only the latest line for a segment matters on recovery.
+    TSharedRef<FJsonObject> Event = MakeEvent(TEXT("frames"));
+    Event->SetNumberField(TEXT("segment"), RangeSegmentIndex);
+    Event->SetNumberField(TEXT("first"), RangeFirstFrame);
+    Event->SetNumberField(TEXT("last"), RangeLastFrame);
+    Event->SetNumberField(TEXT("count"), RangeFrameCount);
+    EnqueueEvent(Event);
+
+    LastJournaledFrameCount = RangeFrameCount;
+    LastRangeFlushTime = Now;
+}
+
+void FOmniCaptureJournal::DrainQueue()
+{
+    if (!FileHandle.IsValid())
+    {
+        return;
+    }
+
+    bool bWrote = false;
+    FString Line;
+    while (Queue.Dequeue(Line))
+    {
+        const FTCHARToUTF8 Utf8(*Line);
+        FileHandle->Write(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+        bWrote = true;
+    }
+
+    if (bWrote)
+    {
+        FileHandle->Flush();
+    }
+}
+
+void FOmniCaptureJournal::FindUnfinished(TArray<FOmniCaptureJournalRecovery>& OutRecoveries)
+{
+    OutRecoveries.Reset();
+
+    TArray<FString> JournalFiles;
+    IFileManager::Get().FindFiles(JournalFiles, *(GetJournalDirectory() / (FString(TEXT("*")) + GJournalExtension)), true, false);
+    JournalFiles.Sort();
+
+    const uint32 CurrentProcessId = FPlatformProcess::GetCurrentProcessId();
+    for (const FString& FileName : JournalFiles)
+    {
+        FOmniCaptureJournalRecovery Recovery;
+        if (!Load(GetJournalDirectory() / FileName, Recovery))
+        {
+            continue;
+        }
+
+        // A journal still held by a live editor belongs to a capture in progress, not a crash.
+        if (Recovery.ProcessId == CurrentProcessId || (Recovery.ProcessId != 0 && FPlatformProcess::IsApplicationRunning(Recovery.ProcessId)))
+        {
+            continue;
+        }
+
+        OutRecoveries.Add(MoveTemp(Recovery));
+    }
+}
+
+bool FOmniCaptureJournal::Load(const FString& InJournalPath, FOmniCaptureJournalRecovery& OutRecovery)
+{
+    OutRecovery = FOmniCaptureJournalRecovery();
+    OutRecovery.JournalPath = InJournalPath;
+
+    TArray<FString> Lines;
+    if (!FFileHelper::LoadFileToStringArray(Lines, *InJournalPath))
+    {
+        return false;
+    }
+
+    bool bHasHeader = false;
+    for (const FString& Line : Lines)
+    {
+        TSharedPtr<FJsonObject> Event;
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Line);
+        if (Line.IsEmpty() || !FJsonSerializer::Deserialize(Reader, Event) || !Event.IsValid())
+        {
+            // Only the final line can be torn; anything after it was never written.
+            continue;
+        }
+
+        const FString Type = Event->GetStringField(TEXT("event"));
+        if (Type == TEXT("captureBegin"))
+        {
+            bHasHeader = true;
+            OutRecovery.ProcessId = static_cast<uint32>(Event->GetNumberField(TEXT("pid")));
+            OutRecovery.BaseDirectory = Event->GetStringField(TEXT("baseDirectory"));
+            OutRecovery.BaseFileName = Event->GetStringField(TEXT("baseFileName"));
+            FDateTime::ParseIso8601(*Event->GetStringField(TEXT("startTime")), OutRecovery.StartTime);
+
+            const TSharedPtr<FJsonObject>* SettingsObject = nullptr;
+            if (Event->TryGetObjectField(TEXT("settings"), SettingsObject) && SettingsObject)
+            {
+                FJsonObjectConverter::JsonObjectToUStruct((*SettingsObject).ToSharedRef(), FOmniCaptureSettings::StaticStruct(), &OutRecovery.Settings, 0, 0);
+            }
+        }
+        else if (Type == TEXT("segmentOpen") || Type == TEXT("segmentClose"))
+        {
+            FOmniCaptureJournalSegment& Segment = FindOrAddSegment(OutRecovery, static_cast<int32>(Event->GetNumberField(TEXT("segment"))));
+            Segment.Directory = Event->GetStringField(TEXT("directory"));
+            Segment.BaseFileName = Event->GetStringField(TEXT("baseFileName"));
+            Segment.AudioPath = Event->GetStringField(TEXT("audioPath"));
+            Segment.VideoPath = Event->GetStringField(TEXT("videoPath"));
+            if (Type == TEXT("segmentClose"))
+            {
+                Segment.bClosed = true;
+                Segment.FrameCount = FMath::Max(Segment.FrameCount, static_cast<int32>(Event->GetNumberField(TEXT("frames"))));
+                Segment.DroppedFrames = static_cast<int32>(Event->GetNumberField(TEXT("droppedFrames")));
+                Segment.bHasImageSequence = Event->GetBoolField(TEXT("hasImageSequence"));
+            }
+        }
+        else if (Type == TEXT("frames"))
+        {
+            FOmniCaptureJournalSegment& Segment = FindOrAddSegment(OutRecovery, static_cast<int32>(Event->GetNumberField(TEXT("segment"))));
+            Segment.FirstFrame = static_cast<int32>(Event->GetNumberField(TEXT("first")));
+            Segment.LastFrame = static_cast<int32>(Event->GetNumberField(TEXT("last")));
+            Segment.FrameCount = static_cast<int32>(Event->GetNumberField(TEXT("count")));
+        }
+    }
+
+    for (FOmniCaptureJournalSegment& Segment : OutRecovery.Segments)
+    {
+        if (Segment.AudioPath.IsEmpty() || !FPaths::FileExists(Segment.AudioPath))
+        {
+            Segment.AudioPath.Reset();
+        }
+        if (!Segment.bClosed)
+        {
+            Segment.bHasImageSequence = OutRecovery.Settings.OutputFormat == EOmniOutputFormat::ImageSequence;
+        }
+    }
+
+    return bHasHeader;
+}
+
+bool FOmniCaptureJournal::ResumeFinalize(const FOmniCaptureJournalRecovery& Recovery, TArray<FString>* OutFinalizedFiles)
+{
+    if (!TryClaimResume(Recovery.JournalPath))
+    {
+        UE_LOG(LogOmniCaptureJournal, Display, TEXT("%s is already being finalized; skipping."), *Recovery.JournalPath);
+        return false;
+    }
+    // A resume that finished between FindUnfinished and the claim has already removed the journal.
+    if (!FPaths::FileExists(Recovery.JournalPath))
+    {
+        ReleaseResume(Recovery.JournalPath);
+        return false;
+    }
+
+    UE_LOG(LogOmniCaptureJournal, Display, TEXT("Resuming finalization of %s (%d segment(s))."), *Recovery.JournalPath, Recovery.Segments.Num());
+
+    bool bAllSucceeded = true;
+    int32 MuxedSegments = 0;
+    for (const FOmniCaptureJournalSegment& Segment : Recovery.Segments)
+    {
+        TArray<FOmniCaptureFrameMetadata> Frames;
+        int32 DroppedFrames = 0;
+        BuildSegmentFrames(Recovery, Segment, Frames, DroppedFrames);
+        if (Frames.Num() == 0)
+        {
+            UE_LOG(LogOmniCaptureJournal, Warning, TEXT("Segment %d has no recoverable frames; skipping."), Segment.SegmentIndex);
+            continue;
+        }
+
+        FOmniCaptureSettings SegmentSettings = Recovery.Settings;
+        SegmentSettings.OutputDirectory = Segment.Directory;
+        SegmentSettings.OutputFileName = Segment.BaseFileName;
+        SegmentSettings.bOpenPreviewOnFinalize = false;
+
+        FOmniCaptureMuxer Muxer;
+        Muxer.Initialize(SegmentSettings, Segment.Directory);
+        Muxer.BeginRealtimeSession(SegmentSettings);
+        const bool bSuccess = Muxer.FinalizeCapture(SegmentSettings, Frames, Segment.AudioPath, Segment.VideoPath, DroppedFrames);
+        Muxer.EndRealtimeSession();
+
+        const FString FinalVideoPath = Segment.Directory / (Segment.BaseFileName + TEXT(".mp4"));
+        if (bSuccess && FPaths::FileExists(FinalVideoPath))
+        {
+            ++MuxedSegments;
+            if (OutFinalizedFiles)
+            {
+                OutFinalizedFiles->Add(FinalVideoPath);
+            }
+            UE_LOG(LogOmniCaptureJournal, Display, TEXT("Recovered segment %d (%d frames) -> %s"), Segment.SegmentIndex, Frames.Num(), *FinalVideoPath);
+        }
+        else
+        {
+            bAllSucceeded = false;
+            UE_LOG(LogOmniCaptureJournal, Warning, TEXT("Failed to mux recovered segment %d in %s."), Segment.SegmentIndex, *Segment.Directory);
+        }
+    }
+
+    // Failed journals stay on disk so the user can fix the environment (e.g. FFmpeg) and retry.
+    if (bAllSucceeded)
+    {
+        IFileManager::Get().Delete(*Recovery.JournalPath, false, true, true);
+    }
+    ReleaseResume(Recovery.JournalPath);
+
+    return bAllSucceeded && MuxedSegments > 0;
+}
+
+int32 FOmniCaptureJournal::ResumeFinalizeAll(TArray<FString>* OutFinalizedFiles)
+{
+    TArray<FOmniCaptureJournalRecovery> Recoveries;
+    FindUnfinished(Recoveries);
+
+    int32 Recovered = 0;
+    for (const FOmniCaptureJournalRecovery& Recovery : Recoveries)
+    {
+        Recovered += ResumeFinalize(Recovery, OutFinalizedFiles) ? 1 : 0;
+    }
+    return Recovered;
+}
+
+void FOmniCaptureJournal::Discard(const FOmniCaptureJournalRecovery& Recovery)
+{
+    // A journal being finalized must not be deleted underneath the mux.
+    if (IsResumeClaimed(Recovery.JournalPath))
+    {
+        UE_LOG(LogOmniCaptureJournal, Display, TEXT("%s is being finalized; not discarding it."), *Recovery.JournalPath);
+        return;
+    }
+    IFileManager::Get().Delete(*Recovery.JournalPath, false, true, true);
+}
+
+static FAutoConsoleCommand GOmniCaptureResumeFinalizeCommand(
+    TEXT("OmniCapture.ResumeFinalize"),
+    TEXT("Muxes captures left unfinished by a crash from their journals, frame index sidecars and streamed audio. Usable headless via -ExecCmds."),
+    FConsoleCommandDelegate::CreateLambda([]()
+    {
+        TArray<FString> FinalizedFiles;
+        const int32 Recovered = FOmniCaptureJournal::ResumeFinalizeAll(&FinalizedFiles);
+        UE_LOG(LogOmniCaptureJournal, Display, TEXT("Resume finalize recovered %d capture(s), %d file(s)."), Recovered, FinalizedFiles.Num());
+    }));
+
+static FAutoConsoleCommand GOmniCaptureListUnfinishedCommand(
+    TEXT("OmniCapture.ListUnfinished"),
+    TEXT("Lists capture journals left behind by sessions that did not end cleanly."),
+    FConsoleCommandDelegate::CreateLambda([]()
+    {
+        TArray<FOmniCaptureJournalRecovery> Recoveries;
+        FOmniCaptureJournal::FindUnfinished(Recoveries);
+        for (const FOmniCaptureJournalRecovery& Recovery : Recoveries)
+        {
+            UE_LOG(LogOmniCaptureJournal, Display, TEXT("%s: %s (%d segment(s), started %s)"), *Recovery.JournalPath, *Recovery.BaseFileName, Recovery.Segments.Num(), *Recovery.StartTime.ToString());
+        }
+        UE_LOG(LogOmniCaptureJournal, Display, TEXT("%d unfinished capture(s)."), Recoveries.Num());
+    }));
@@ -1,5 +1,8 @@
 #include "OmniCaptureMuxer.h"
 #include "OmniCaptureTypes.h"
+#include "OmniCaptureFrameIndex.h"
+#include "OmniCaptureFoveatedEquirect.h"
+#include "OmniCaptureFramePacer.h"
 #include "Misc/EngineVersionComparison.h"
 
 #include "HAL/FileManager.h"
@@ -95,6 +98,118 @@ namespace
 
         return TEXT("Mono");
     }
+
+    /** Face placement of the 3x2 atlas, matching FOmniCaptureProjectionRemap::AtlasToCubeFace. */
+    TSharedRef<FJsonObject> MakeCubemapLayoutJson(const FOmniCaptureSettings& Settings)
+    {
+        const bool bEquiAngular = Settings.Projection == EOmniCaptureProjection::EquiAngularCubemap;
+        const TCHAR* FaceOrder[6] = { TEXT("right"), TEXT("left"), TEXT("up"), TEXT("down"), TEXT("front"), TEXT("back") };
+        const TCHAR* EquiAngularFaceOrder[6] = { TEXT("left"), TEXT("front"), TEXT("right"), TEXT("down"), TEXT("back"), TEXT("up") };
+        const int32 Rotations[6] = { 0, 0, 0, 0, 0, 0 };
+        const int32 EquiAngularRotations[6] = { 0, 0, 0, 270, 90, 270 };
+
+        TArray<TSharedPtr<FJsonValue>> Faces;
+        TArray<TSharedPtr<FJsonValue>> FaceRotations;
+        for (int32 Slot = 0; Slot < 6; ++Slot)
+        {
+            Faces.Add(MakeShared<FJsonValueString>(bEquiAngular ? EquiAngularFaceOrder[Slot] : FaceOrder[Slot]));
+            FaceRotations.Add(MakeShared<FJsonValueNumber>(bEquiAngular ? EquiAngularRotations[Slot] : Rotations[Slot]));
+        }
+
+        const FIntPoint EyeSize = Settings.GetPerEyeOutputResolution();
+        TSharedRef<FJsonObject> Layout = MakeShared<FJsonObject>();
+        Layout->SetStringField(TEXT("layout"), TEXT("3x2"));
+        Layout->SetBoolField(TEXT("equiAngular"), bEquiAngular);
+        Layout->SetNumberField(TEXT("faceWidth"), EyeSize.X / 3);
+        Layout->SetNumberField(TEXT("faceHeight"), EyeSize.Y / 2);
+        Layout->SetNumberField(TEXT("padding"), 0);
+        Layout->SetArrayField(TEXT("faceOrder"), Faces);
+        Layout->SetArrayField(TEXT("faceRotationDegreesClockwise"), FaceRotations);
+        return Layout;
+    }
+
+    /** Band table of a foveated equirect, enough to expand each eye back to a standard equirect. */
+    TSharedRef<FJsonObject> MakeFoveationJson(const FOmniCaptureSettings& Settings)
+    {
+        const FIntPoint SourceSize = Settings.GetFoveatedSourceResolution();
+        const FOmniCaptureFoveatedLayout Layout = FOmniCaptureFoveatedLayout::Build(SourceSize, Settings.FoveationStartLatitude, FMath::Clamp(Settings.FoveationLevels, 1, 4));
+
+        TArray<TSharedPtr<FJsonValue>> Bands;
+        for (const FOmniCaptureFoveatedBand& Band : Layout.Bands)
+        {
+            TSharedRef<FJsonObject> BandObject = MakeShared<FJsonObject>();
+            BandObject->SetNumberField(TEXT("firstSourceRow"), Band.FirstSourceRow);
+            BandObject->SetNumberField(TEXT("sourceRowCount"), Band.SourceRowCount);
+            BandObject->SetNumberField(TEXT("firstOutputRow"), Band.FirstOutputRow);
+            BandObject->SetNumberField(TEXT("divisor"), Band.Divisor);
+            Bands.Add(MakeShared<FJsonValueObject>(BandObject));
+        }
+
+        TSharedRef<FJsonObject> Foveation = MakeShared<FJsonObject>();
+        Foveation->SetNumberField(TEXT("sourceWidth"), SourceSize.X);
+        Foveation->SetNumberField(TEXT("sourceHeight"), SourceSize.Y);
+        Foveation->SetNumberField(TEXT("packedRows"), Layout.GetPackedHeight());
+        Foveation->SetNumberField(TEXT("startLatitudeDegrees"), Layout.StartLatitudeDegrees);
+        Foveation->SetNumberField(TEXT("levels"), Layout.Levels);
+        Foveation->SetArrayField(TEXT("bands"), Bands);
+        return Foveation;
+    }
+
+    TArray<TSharedPtr<FJsonValue>> MakeQualityChangesJson(const TArray<FOmniCaptureQualityChange>& Changes)
+    {
+        TArray<TSharedPtr<FJsonValue>> Values;
+        Values.Reserve(Changes.Num());
+        for (const FOmniCaptureQualityChange& Change : Changes)
+        {
+            TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+            Entry->SetNumberField(TEXT("time"), Change.CaptureSeconds);
+            Entry->SetNumberField(TEXT("frame"), Change.FrameIndex);
+            Entry->SetStringField(TEXT("knob"), LexToString(Change.Knob));
+            Entry->SetStringField(TEXT("action"), Change.bDegraded ? TEXT("lowered") : TEXT("restored"));
+            Entry->SetNumberField(TEXT("level"), Change.Level);
+            Entry->SetStringField(TEXT("reason"), Change.Reason);
+            Values.Add(MakeShared<FJsonValueObject>(Entry));
+        }
+        return Values;
+    }
+
+    TSharedRef<FJsonObject> MakeFramePacingJson(const FOmniCaptureSettings& Settings, const TArray<FOmniCaptureFrameMetadata>& Frames)
+    {
+        int32 DuplicatedFrames = 0;
+        int64 SkippedSlots = 0;
+        for (const FOmniCaptureFrameMetadata& Metadata : Frames)
+        {
+            DuplicatedFrames += Metadata.bDuplicate ? 1 : 0;
+            SkippedSlots += Metadata.SkippedSlots;
+        }
+
+        const TCHAR* ModeString = TEXT("EveryTick");
+        switch (Settings.FramePacing)
+        {
+        case EOmniCaptureFramePacing::Decimate:
+            ModeString = TEXT("Decimate");
+            break;
+        case EOmniCaptureFramePacing::DecimateAndDuplicate:
+            ModeString = TEXT("DecimateAndDuplicate");
+            break;
+        case EOmniCaptureFramePacing::FixedTimestep:
+            ModeString = TEXT("FixedTimestep");
+            break;
+        default:
+            break;
+        }
+
+        TSharedRef<FJsonObject> Pacing = MakeShared<FJsonObject>();
+        Pacing->SetStringField(TEXT("mode"), ModeString);
+        Pacing->SetNumberField(TEXT("targetFrameRate"), Settings.TargetFrameRate);
+        const FFrameRate Rational = FOmniCaptureFramePacer::MakeFrameRate(Settings.TargetFrameRate);
+        Pacing->SetNumberField(TEXT("frameRateNumerator"), Rational.Numerator);
+        Pacing->SetNumberField(TEXT("frameRateDenominator"), Rational.Denominator);
+        Pacing->SetBoolField(TEXT("constantFrameRateTimecodes"), Settings.UsesFramePacing());
+        Pacing->SetNumberField(TEXT("duplicatedFrames"), DuplicatedFrames);
+        Pacing->SetNumberField(TEXT("skippedSlots"), static_cast<double>(SkippedSlots));
+        return Pacing;
+    }
 }
 
 FString FOmniCaptureMuxer::ResolveFFmpegBinary(const FOmniCaptureSettings& Settings)
@@ -215,6 +330,15 @@ bool FOmniCaptureMuxer::FinalizeCapture(const FOmniCaptureSettings& Settings, co
         bSuccess = false;
     }
 
+    if (Frames.Num() > 0)
+    {
+        FString TimecodePath;
+        if (!WriteTimecodeFile(Frames, TimecodePath))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Failed to write per-frame timecodes for %s"), *BaseFileName);
+        }
+    }
+
     const bool bMuxed = TryInvokeFFmpeg(Settings, Frames, AudioPath, VideoPath);
     return bSuccess && bMuxed;
 }
@@ -238,6 +362,11 @@ bool FOmniCaptureMuxer::WriteManifest(const FOmniCaptureSettings& Settings, cons
     Root->SetNumberField(TEXT("frameCount"), Frames.Num());
     Root->SetNumberField(TEXT("frameRate"), CalculateFrameRate(Frames));
     Root->SetNumberField(TEXT("droppedFrames"), DroppedFrames);
+    Root->SetObjectField(TEXT("framePacing"), MakeFramePacingJson(Settings, Frames));
+    if (QualityChanges.Num() > 0)
+    {
+        Root->SetArrayField(TEXT("qualityChanges"), MakeQualityChangesJson(QualityChanges));
+    }
     Root->SetStringField(TEXT("stereoLayout"), Settings.StereoLayout == EOmniCaptureStereoLayout::TopBottom ? TEXT("TopBottom") : TEXT("SideBySide"));
     const FIntPoint OutputSize = Settings.GetOutputResolution();
     Root->SetNumberField(TEXT("outputWidth"), OutputSize.X);
@@ -254,6 +383,15 @@ bool FOmniCaptureMuxer::WriteManifest(const FOmniCaptureSettings& Settings, cons
     const FIntPoint EyeSize = Settings.GetPerEyeOutputResolution();
     Root->SetNumberField(TEXT("perEyeWidth"), EyeSize.X);
     Root->SetNumberField(TEXT("perEyeHeight"), EyeSize.Y);
+    Root->SetStringField(TEXT("projectionType"), Settings.GetProjectionMetadataTag());
+    if (Settings.IsCubemapLayout())
+    {
+        Root->SetObjectField(TEXT("cubemap"), MakeCubemapLayoutJson(Settings));
+    }
+    if (Settings.IsFoveatedEquirect())
+    {
+        Root->SetObjectField(TEXT("foveation"), MakeFoveationJson(Settings));
+    }
 
     if (Settings.AuxiliaryPasses.Num() > 0)
     {
@@ -281,7 +419,7 @@ bool FOmniCaptureMuxer::WriteManifest(const FOmniCaptureSettings& Settings, cons
     const int32 CroppedTop = 0;
 
     TSharedRef<FJsonObject> GPano = MakeShared<FJsonObject>();
-    GPano->SetStringField(TEXT("projectionType"), TEXT("equirectangular"));
+    GPano->SetStringField(TEXT("projectionType"), Settings.GetProjectionMetadataTag());
     GPano->SetStringField(TEXT("stereoMode"), Settings.GetStereoModeMetadataTag());
     GPano->SetNumberField(TEXT("fullPanoWidthPixels"), FullPanoWidth);
     GPano->SetNumberField(TEXT("fullPanoHeightPixels"), FullPanoHeight);
@@ -332,27 +470,30 @@ bool FOmniCaptureMuxer::WriteManifest(const FOmniCaptureSettings& Settings, cons
         break;
     }
 
-    TArray<TSharedPtr<FJsonValue>> FrameArray;
-    FrameArray.Reserve(Frames.Num());
-    for (const FOmniCaptureFrameMetadata& Metadata : Frames)
+    OutManifestPath = OutputDirectory / (BaseFileName + TEXT("_Manifest.json"));
+
+    // The sidecar was streamed while the frames were captured, so its rows are copied into the manifest chunk by
+    // chunk and finalizing only adds the summary above and the drop events after them.
+    const FString SidecarPath = FOmniCaptureFrameIndexWriter::MakeBinaryPath(OutputDirectory, BaseFileName);
+    if (FPaths::FileExists(SidecarPath))
     {
-        TSharedRef<FJsonObject> FrameObject = MakeShared<FJsonObject>();
-        FrameObject->SetNumberField(TEXT("index"), Metadata.FrameIndex);
-        FrameObject->SetNumberField(TEXT("timecode"), Metadata.Timecode);
-        FrameObject->SetBoolField(TEXT("keyFrame"), Metadata.bKeyFrame);
-        FrameArray.Add(MakeShared<FJsonValueObject>(FrameObject));
+        Root->SetStringField(TEXT("frameIndex"), FPaths::GetCleanFilename(SidecarPath));
+        if (FOmniCaptureFrameIndexWriter::ExportManifestJson(SidecarPath, Root, OutManifestPath))
+        {
+            return true;
+        }
+        Root->RemoveField(TEXT("frameIndex"));
+        UE_LOG(LogTemp, Warning, TEXT("Frame index %s could not be streamed; writing the manifest from the captured frame list."), *SidecarPath);
     }
-    Root->SetArrayField(TEXT("frames"), FrameArray);
 
-    FString OutputString;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
-    if (!FJsonSerializer::Serialize(Root, Writer))
+    // Without a sidecar the rows come from the capture's own frame list.
+    FOmniCaptureFrameIndexContents Contents;
+    Contents.Frames.Reserve(Frames.Num());
+    for (const FOmniCaptureFrameMetadata& Metadata : Frames)
     {
-        return false;
+        Contents.Frames.AddDefaulted_GetRef().Metadata = Metadata;
     }
-
-    OutManifestPath = OutputDirectory / (BaseFileName + TEXT("_Manifest.json"));
-    return FFileHelper::SaveStringToFile(OutputString, *OutManifestPath);
+    return FOmniCaptureFrameIndexWriter::ExportManifestJson(Contents, Root, OutManifestPath);
 }
 
 bool FOmniCaptureMuxer::WriteSpatialMetadata(const FOmniCaptureSettings& Settings) const
@@ -383,6 +524,7 @@ bool FOmniCaptureMuxer::WriteSpatialMetadata(const FOmniCaptureSettings& Setting
 
     TSharedRef<FJsonObject> SpatialRoot = MakeShared<FJsonObject>();
     SpatialRoot->SetStringField(TEXT("projection"), bHalfSphere ? TEXT("VR180") : TEXT("VR360"));
+    SpatialRoot->SetStringField(TEXT("projectionType"), Settings.GetProjectionMetadataTag());
     SpatialRoot->SetStringField(TEXT("stereoMode"), StereoMode);
     SpatialRoot->SetBoolField(TEXT("isStereo"), Settings.IsStereo());
     SpatialRoot->SetNumberField(TEXT("frameWidth"), OutputSize.X);
@@ -395,6 +537,10 @@ bool FOmniCaptureMuxer::WriteSpatialMetadata(const FOmniCaptureSettings& Setting
     SpatialRoot->SetNumberField(TEXT("croppedTop"), CroppedTop);
     SpatialRoot->SetNumberField(TEXT("horizontalFOVDegrees"), Settings.GetHorizontalFOVDegrees());
     SpatialRoot->SetNumberField(TEXT("verticalFOVDegrees"), Settings.GetVerticalFOVDegrees());
+    if (Settings.IsCubemapLayout())
+    {
+        SpatialRoot->SetObjectField(TEXT("cubemap"), MakeCubemapLayoutJson(Settings));
+    }
 
     bool bSuccess = true;
 
@@ -427,7 +573,7 @@ bool FOmniCaptureMuxer::WriteSpatialMetadata(const FOmniCaptureSettings& Setting
         TEXT(" <rdf:RDF xmlns:rdf=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\">\n")
         TEXT("  <rdf:Description rdf:about=\"\"\n")
         TEXT("    xmlns:GPano=\"http://ns.google.com/photos/1.0/panorama/\"\n")
-        TEXT("    GPano:ProjectionType=\"equirectangular\"\n")
+        TEXT("    GPano:ProjectionType=\"%s\"\n")
         TEXT("    GPano:StereoMode=\"%s\"\n")
         TEXT("    GPano:StitchingSoftware=\"OmniCapture\"\n")
         TEXT("    GPano:CroppedAreaImageWidthPixels=\"%d\"\n")
@@ -443,6 +589,7 @@ bool FOmniCaptureMuxer::WriteSpatialMetadata(const FOmniCaptureSettings& Setting
         TEXT("    GPano:InitialVerticalFOVDegrees=\"%.2f\"/>\n")
         TEXT(" </rdf:RDF>\n")
         TEXT("</x:xmpmeta>\n"),
+        *Settings.GetProjectionMetadataTag(),
         *StereoMode,
         OutputSize.X,
         OutputSize.Y,
@@ -511,7 +658,30 @@ bool FOmniCaptureMuxer::TryInvokeFFmpeg(const FOmniCaptureSettings& Settings, co
     FString OutputFile = OutputDirectory / (BaseFileName + TEXT(".mp4"));
     FString CommandLine;
 
-    if (IsImageSequenceFormat(Settings.OutputFormat))
+    // A Y4M stream carries its own frame rate and is already one file, so it never needs the concat list.
+    const bool bY4MStream = Settings.UsesPackedFrames();
+    FString ConcatListPath;
+    const bool bUseFrameTimestamps = IsImageSequenceFormat(Settings.OutputFormat)
+        && !bY4MStream
+        && !Settings.bForceConstantFrameRate
+        && WriteConcatList(Settings, Frames, ConcatListPath);
+
+    if (bY4MStream)
+    {
+        const FString StreamPath = OutputDirectory / (BaseFileName + TEXT(".y4m"));
+        if (!FPaths::FileExists(StreamPath))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Y4M stream %s not found; skipping FFmpeg mux."), *StreamPath);
+            return false;
+        }
+        CommandLine = FString::Printf(TEXT("-y -i \"%s\""), *StreamPath);
+    }
+    else if (bUseFrameTimestamps)
+    {
+        // Each frame keeps its captured presentation time, matching the timeline-aligned audio.
+        CommandLine = FString::Printf(TEXT("-y -f concat -safe 0 -i \"%s\""), *ConcatListPath);
+    }
+    else if (IsImageSequenceFormat(Settings.OutputFormat))
     {
         const FString Extension = Settings.GetImageFileExtension();
         FString Pattern = OutputDirectory / FString::Printf(TEXT("%s_%%06d%s"), *BaseFileName, *Extension);
@@ -567,10 +737,15 @@ bool FOmniCaptureMuxer::TryInvokeFFmpeg(const FOmniCaptureSettings& Settings, co
 
     if (Settings.bInjectFFmpegMetadata && Settings.SupportsSphericalMetadata())
     {
-        FString MetadataArgs = FString::Printf(TEXT(" -metadata:s:v:0 spherical_video=1 -metadata:s:v:0 projection=equirectangular -metadata:s:v:0 stereo_mode=%s"), StereoMode);
+        const FString ProjectionTag = Settings.GetProjectionMetadataTag();
+        FString MetadataArgs = FString::Printf(TEXT(" -metadata:s:v:0 spherical_video=1 -metadata:s:v:0 projection=%s -metadata:s:v:0 stereo_mode=%s"), *ProjectionTag, StereoMode);
         MetadataArgs += TEXT(" -metadata:s:v:0 spatial_audio=0 -metadata:s:v:0 stitching_software=OmniCapture");
         MetadataArgs += TEXT(" -metadata:s:v:0 projection_pose_yaw_degrees=0 -metadata:s:v:0 projection_pose_pitch_degrees=0 -metadata:s:v:0 projection_pose_roll_degrees=0");
-        if (bHalfSphere)
+        if (Settings.IsCubemapLayout())
+        {
+            MetadataArgs += TEXT(" -metadata:s:v:0 cubemap_layout=3x2 -metadata:s:v:0 cubemap_padding=0");
+        }
+        else if (bHalfSphere)
         {
             MetadataArgs += TEXT(" -metadata:s:v:0 bound_left=-90 -metadata:s:v:0 bound_right=90 -metadata:s:v:0 bound_top=90 -metadata:s:v:0 bound_bottom=-90");
         }
@@ -580,7 +755,7 @@ bool FOmniCaptureMuxer::TryInvokeFFmpeg(const FOmniCaptureSettings& Settings, co
         }
         MetadataArgs += FString::Printf(TEXT(" -metadata:s:v:0 view=%s"), ViewTag);
         MetadataArgs += TEXT(" -metadata:s:v:0 spherical=1");
-        MetadataArgs += TEXT(" -metadata:s:v:0 gpano:ProjectionType=equirectangular");
+        MetadataArgs += FString::Printf(TEXT(" -metadata:s:v:0 gpano:ProjectionType=%s"), *ProjectionTag);
         MetadataArgs += FString::Printf(TEXT(" -metadata:s:v:0 gpano:StereoMode=%s"), StereoMode);
         MetadataArgs += FString::Printf(TEXT(" -metadata:s:v:0 gpano:FullPanoWidthPixels=%d"), FullPanoWidth);
         MetadataArgs += FString::Printf(TEXT(" -metadata:s:v:0 gpano:FullPanoHeightPixels=%d"), FullPanoHeight);
@@ -598,6 +773,10 @@ bool FOmniCaptureMuxer::TryInvokeFFmpeg(const FOmniCaptureSettings& Settings, co
     {
         CommandLine += TEXT(" -vsync cfr");
     }
+    else if (bUseFrameTimestamps)
+    {
+        CommandLine += TEXT(" -vsync vfr");
+    }
     if (Settings.bEnableFastStart)
     {
         CommandLine += TEXT(" -movflags +faststart");
@@ -627,6 +806,81 @@ bool FOmniCaptureMuxer::TryInvokeFFmpeg(const FOmniCaptureSettings& Settings, co
     return true;
 }
 
+bool FOmniCaptureMuxer::WriteTimecodeFile(const TArray<FOmniCaptureFrameMetadata>& Frames, FString& OutTimecodePath) const
+{
+    if (Frames.Num() == 0)
+    {
+        return false;
+    }
+
+    // Matroska "timecode format v2": one presentation time in milliseconds per frame, relative to the first frame.
+    const double Origin = Frames[0].Timecode;
+    FString Contents = TEXT("# timecode format v2\n");
+    Contents.Reserve(Frames.Num() * 12);
+    for (const FOmniCaptureFrameMetadata& Metadata : Frames)
+    {
+        Contents += FString::Printf(TEXT("%.6f\n"), (Metadata.Timecode - Origin) * 1000.0);
+    }
+
+    OutTimecodePath = OutputDirectory / (BaseFileName + TEXT("_timecodes.txt"));
+    return FFileHelper::SaveStringToFile(Contents, *OutTimecodePath);
+}
+
+bool FOmniCaptureMuxer::WriteConcatList(const FOmniCaptureSettings& Settings, const TArray<FOmniCaptureFrameMetadata>& Frames, FString& OutListPath) const
+{
+    if (Frames.Num() == 0)
+    {
+        return false;
+    }
+
+    const FString Extension = Settings.GetImageFileExtension();
+    const double FrameRate = CalculateFrameRate(Frames);
+    const double NominalDuration = 1.0 / (FrameRate > 0.0 ? FrameRate : 30.0);
+
+    // Frames the ring buffer dropped or the writer failed to save are still in the metadata but have no image.
+    // They are left out and the frame before each one is held until the next written frame.
+    TArray<int32> WrittenFrames;
+    TArray<FString> WrittenFileNames;
+    WrittenFrames.Reserve(Frames.Num());
+    WrittenFileNames.Reserve(Frames.Num());
+    for (int32 Index = 0; Index < Frames.Num(); ++Index)
+    {
+        FString FileName = FString::Printf(TEXT("%s_%06d%s"), *BaseFileName, Frames[Index].FrameIndex, *Extension);
+        if (FPaths::FileExists(OutputDirectory / FileName))
+        {
+            WrittenFrames.Add(Index);
+            WrittenFileNames.Add(MoveTemp(FileName));
+        }
+    }
+
+    if (WrittenFrames.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("No image sequence frames were found on disk; skipping the concat list."));
+        return false;
+    }
+    if (WrittenFrames.Num() < Frames.Num())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("%d of %d frames were not written; holding the previous frame in their place."), Frames.Num() - WrittenFrames.Num(), Frames.Num());
+    }
+
+    FString Contents = TEXT("ffconcat version 1.0\n");
+    for (int32 Written = 0; Written < WrittenFrames.Num(); ++Written)
+    {
+        const double Duration = WrittenFrames.IsValidIndex(Written + 1)
+            ? FMath::Max(0.0, Frames[WrittenFrames[Written + 1]].Timecode - Frames[WrittenFrames[Written]].Timecode)
+            : NominalDuration;
+
+        Contents += FString::Printf(TEXT("file '%s'\nduration %.6f\n"), *WrittenFileNames[Written], Duration);
+    }
+    const FString& LastFile = WrittenFileNames.Last();
+
+    // The concat demuxer ignores the duration of the final entry unless the file is listed again.
+    Contents += FString::Printf(TEXT("file '%s'\n"), *LastFile);
+
+    OutListPath = OutputDirectory / (BaseFileName + TEXT("_frames.ffconcat"));
+    return FFileHelper::SaveStringToFile(Contents, *OutListPath);
+}
+
 FString FOmniCaptureMuxer::BuildFFmpegBinaryPath() const
 {
     return ResolveFFmpegBinary(FOmniCaptureSettings());
@@ -1019,6 +1019,8 @@ FOmniCaptureNVENCEncoder::~FOmniCaptureNVENCEncoder()
 void FOmniCaptureNVENCEncoder::Initialize(const FOmniCaptureSettings& Settings, const FString& OutputDirectory)
 {
     LastErrorMessage.Reset();
+    EncodedBytes.Store(0);
+    EncodedPackets.Store(0);
     FString Directory = OutputDirectory.IsEmpty() ? (FPaths::ProjectSavedDir() / TEXT("OmniCaptures")) : OutputDirectory;
     Directory = FPaths::ConvertRelativePathToFull(Directory);
     IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
@@ -1100,6 +1102,8 @@ void FOmniCaptureNVENCEncoder::Initialize(const FOmniCaptureSettings& Settings,
         if (AnnexBBuffer.Num() > 0)
         {
             BitstreamFile->Write(AnnexBBuffer.GetData(), AnnexBBuffer.Num());
+            EncodedBytes.AddExchange(AnnexBBuffer.Num());
+            EncodedPackets.IncrementExchange();
         }
     });
 
@@ -1152,37 +1156,47 @@ void FOmniCaptureNVENCEncoder::EnqueueFrame(const FOmniCaptureFrame& Frame)
         return;
     }
 
-    TSharedPtr<OmniAVEncoder::FVideoEncoderInputFrame> InputFrame;
-    if (Frame.EncoderTextures.Num() > 0)
+    // Duplicates are submitted ahead of the frame with the same textures, one encoder input per slot.
+    auto Submit = [this, &Frame](const FOmniCaptureFrameMetadata& Metadata)
     {
-        InputFrame = EncoderInput->CreateEncoderInputFrame();
-        if (InputFrame.IsValid())
+        TSharedPtr<OmniAVEncoder::FVideoEncoderInputFrame> InputFrame;
+        if (Frame.EncoderTextures.Num() > 0)
         {
-            for (int32 PlaneIndex = 0; PlaneIndex < Frame.EncoderTextures.Num(); ++PlaneIndex)
+            InputFrame = EncoderInput->CreateEncoderInputFrame();
+            if (InputFrame.IsValid())
             {
-                if (Frame.EncoderTextures[PlaneIndex].IsValid())
+                for (int32 PlaneIndex = 0; PlaneIndex < Frame.EncoderTextures.Num(); ++PlaneIndex)
                 {
-                    InputFrame->SetTexture(PlaneIndex, Frame.EncoderTextures[PlaneIndex]);
+                    if (Frame.EncoderTextures[PlaneIndex].IsValid())
+                    {
+                        InputFrame->SetTexture(PlaneIndex, Frame.EncoderTextures[PlaneIndex]);
+                    }
                 }
             }
         }
-    }
 
-    if (!InputFrame.IsValid())
-    {
-        InputFrame = EncoderInput->CreateEncoderInputFrameFromRHITexture(Frame.Texture);
-    }
+        if (!InputFrame.IsValid())
+        {
+            InputFrame = EncoderInput->CreateEncoderInputFrameFromRHITexture(Frame.Texture);
+        }
 
-    if (!InputFrame.IsValid())
-    {
-        return;
-    }
+        if (!InputFrame.IsValid())
+        {
+            return;
+        }
 
-    InputFrame->SetTimestampUs(static_cast<uint64>(Frame.Metadata.Timecode * 1'000'000.0));
-    InputFrame->SetFrameIndex(Frame.Metadata.FrameIndex);
-    InputFrame->SetKeyFrame(Frame.Metadata.bKeyFrame);
+        InputFrame->SetTimestampUs(static_cast<uint64>(Metadata.Timecode * 1'000'000.0));
+        InputFrame->SetFrameIndex(Metadata.FrameIndex);
+        InputFrame->SetKeyFrame(Metadata.bKeyFrame);
 
-    VideoEncoder->Encode(InputFrame);
+        VideoEncoder->Encode(InputFrame);
+    };
+
+    for (const FOmniCaptureFrameMetadata& Duplicate : Frame.Duplicates)
+    {
+        Submit(Duplicate);
+    }
+    Submit(Frame.Metadata);
 #else
     (void)Frame;
 #endif
@@ -0,0 +1,275 @@
+#include "OmniCaptureODS.h"
+
+#include "OmniCaptureProjectionRemap.h"
+#include "Async/ParallelFor.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    // Rows never span more than this, so each view stays well inside a 90 degree half angle and clear of the pole.
+    constexpr double GODSMaxRowSpanRadians = UE_DOUBLE_PI / 3.0;
+    // View texels kept beyond the slice and row edges so bilinear taps at a column boundary never clamp.
+    constexpr int32 GODSMarginPixels = 2;
+    constexpr int32 GODSMinSlices = 8;
+    // Three rows per slice must still fit the 2048 slices of a texture array.
+    constexpr int32 GODSMaxSlices = 640;
+
+    FCriticalSection GStitchTableCS;
+    TSharedPtr<const FOmniCaptureRemapTable> GLastStitchTable;
+
+    /** Camera axes of a view looking along (Yaw, Pitch): forward, right and up in rig space. */
+    void GetViewAxes(double Yaw, double Pitch, FVector& OutForward, FVector& OutRight, FVector& OutUp)
+    {
+        const double CosYaw = FMath::Cos(Yaw);
+        const double SinYaw = FMath::Sin(Yaw);
+        const double CosPitch = FMath::Cos(Pitch);
+        const double SinPitch = FMath::Sin(Pitch);
+        OutForward = FVector(CosPitch * CosYaw, CosPitch * SinYaw, SinPitch);
+        OutRight = FVector(-SinYaw, CosYaw, 0.0);
+        OutUp = FVector(-SinPitch * CosYaw, -SinPitch * SinYaw, CosPitch);
+    }
+
+    FVector DirectionFromAngles(double Longitude, double Latitude)
+    {
+        const double CosLat = FMath::Cos(Latitude);
+        return FVector(CosLat * FMath::Cos(Longitude), CosLat * FMath::Sin(Longitude), FMath::Sin(Latitude));
+    }
+
+    bool WrapsLongitude(double LongitudeSpan)
+    {
+        return LongitudeSpan >= UE_DOUBLE_TWO_PI - UE_DOUBLE_KINDA_SMALL_NUMBER;
+    }
+}
+
+FOmniCaptureODSLayout FOmniCaptureODSLayout::Build(const FOmniCaptureSettings& Settings)
+{
+    FOmniCaptureProjectionParams Params;
+    FIntPoint EyeSize;
+    FOmniCaptureProjectionRemap::GetConverterParams(Settings, Params, EyeSize);
+    return Build(EyeSize, Settings.GetLongitudeSpanRadians() * 2.0f, Settings.GetLatitudeSpanRadians() * 2.0f, Settings.ODSSliceCount, Settings.InterPupillaryDistanceCm);
+}
+
+FOmniCaptureODSLayout FOmniCaptureODSLayout::Build(const FIntPoint& InEyeSize, float LongitudeSpanRadians, float LatitudeSpanRadians, int32 InSliceCount, float InterPupillaryDistanceCm)
+{
+    FOmniCaptureODSLayout Layout;
+    Layout.EyeSize = FIntPoint(FMath::Max(1, InEyeSize.X), FMath::Max(1, InEyeSize.Y));
+    Layout.LongitudeSpan = FMath::Clamp(static_cast<double>(LongitudeSpanRadians), UE_DOUBLE_PI / 180.0, UE_DOUBLE_TWO_PI);
+    Layout.LatitudeSpan = FMath::Clamp(static_cast<double>(LatitudeSpanRadians), UE_DOUBLE_PI / 180.0, UE_DOUBLE_PI);
+    Layout.SliceCount = FMath::Clamp(InSliceCount, GODSMinSlices, GODSMaxSlices);
+    Layout.RowCount = FMath::Max(1, FMath::CeilToInt(Layout.LatitudeSpan / GODSMaxRowSpanRadians - UE_DOUBLE_KINDA_SMALL_NUMBER));
+    Layout.EyeRadiusCm = FMath::Max(0.0f, InterPupillaryDistanceCm) * 0.5f;
+
+    // Widest extent of any row's band, in the camera of a slice at yaw 0. Slices only differ by yaw, so that covers every view.
+    const double HalfSlice = Layout.LongitudeSpan / Layout.SliceCount * 0.5;
+    const double HalfRow = Layout.LatitudeSpan / Layout.RowCount * 0.5;
+    constexpr int32 YawSamples = 8;
+    constexpr int32 PitchSamples = 64;
+    double MaxX = 0.0;
+    double MaxY = 0.0;
+    for (int32 Row = 0; Row < Layout.RowCount; ++Row)
+    {
+        FVector Forward;
+        FVector Right;
+        FVector Up;
+        const double Pitch = Layout.GetRowPitch(Row);
+        GetViewAxes(0.0, Pitch, Forward, Right, Up);
+        for (int32 PitchSample = 0; PitchSample <= PitchSamples; ++PitchSample)
+        {
+            const double Latitude = FMath::Clamp(Pitch - HalfRow + 2.0 * HalfRow * PitchSample / PitchSamples, -UE_DOUBLE_HALF_PI, UE_DOUBLE_HALF_PI);
+            for (int32 YawSample = 0; YawSample <= YawSamples; ++YawSample)
+            {
+                const FVector Direction = DirectionFromAngles(-HalfSlice + 2.0 * HalfSlice * YawSample / YawSamples, Latitude);
+                const double Depth = FVector::DotProduct(Direction, Forward);
+                if (Depth > UE_DOUBLE_KINDA_SMALL_NUMBER)
+                {
+                    MaxX = FMath::Max(MaxX, FMath::Abs(FVector::DotProduct(Direction, Right) / Depth));
+                    MaxY = FMath::Max(MaxY, FMath::Abs(FVector::DotProduct(Direction, Up) / Depth));
+                }
+            }
+        }
+    }
+
+    // Views keep the output's angular density at their centre; the frustum is then widened to whole pixels.
+    const double FocalPixels = FMath::Max(Layout.EyeSize.X / Layout.LongitudeSpan, Layout.EyeSize.Y / Layout.LatitudeSpan);
+    Layout.ViewSize.X = FMath::Max(2, FMath::CeilToInt(2.0 * (MaxX * FocalPixels + GODSMarginPixels)));
+    Layout.ViewSize.Y = FMath::Max(2, FMath::CeilToInt(2.0 * (MaxY * FocalPixels + GODSMarginPixels)));
+    Layout.TanHalfFovX = Layout.ViewSize.X / (2.0 * FocalPixels);
+    Layout.TanHalfFovY = Layout.ViewSize.Y / (2.0 * FocalPixels);
+    return Layout;
+}
+
+double FOmniCaptureODSLayout::GetSliceYaw(int32 Slice) const
+{
+    return -LongitudeSpan * 0.5 + (Slice + 0.5) * LongitudeSpan / FMath::Max(1, SliceCount);
+}
+
+double FOmniCaptureODSLayout::GetRowPitch(int32 Row) const
+{
+    return -LatitudeSpan * 0.5 + (Row + 0.5) * LatitudeSpan / FMath::Max(1, RowCount);
+}
+
+float FOmniCaptureODSLayout::GetViewFOVDegrees() const
+{
+    return static_cast<float>(FMath::RadiansToDegrees(2.0 * FMath::Atan(TanHalfFovX)));
+}
+
+FVector FOmniCaptureODSLayout::GetViewLocation(int32 Slice, float EyeSign) const
+{
+    const double Yaw = GetSliceYaw(Slice);
+    return FVector(-FMath::Sin(Yaw), FMath::Cos(Yaw), 0.0) * (EyeRadiusCm * EyeSign);
+}
+
+FRotator FOmniCaptureODSLayout::GetViewRotation(int32 Slice, int32 Row) const
+{
+    return FRotator(FMath::RadiansToDegrees(GetRowPitch(Row)), FMath::RadiansToDegrees(GetSliceYaw(Slice)), 0.0);
+}
+
+void FOmniCaptureODSLayout::ResolveView(double Longitude, double Latitude, int32& OutSlice, int32& OutRow) const
+{
+    const int32 Slice = FMath::FloorToInt((Longitude + LongitudeSpan * 0.5) * SliceCount / LongitudeSpan);
+    OutSlice = WrapsLongitude(LongitudeSpan) ? ((Slice % SliceCount) + SliceCount) % SliceCount : FMath::Clamp(Slice, 0, SliceCount - 1);
+    OutRow = FMath::Clamp(FMath::FloorToInt((Latitude + LatitudeSpan * 0.5) * RowCount / LatitudeSpan), 0, RowCount - 1);
+}
+
+FVector2f FOmniCaptureODSLayout::ProjectToView(int32 Slice, int32 Row, const FVector& Direction) const
+{
+    FVector Forward;
+    FVector Right;
+    FVector Up;
+    GetViewAxes(GetSliceYaw(Slice), GetRowPitch(Row), Forward, Right, Up);
+
+    const double Depth = FMath::Max(FVector::DotProduct(Direction, Forward), UE_DOUBLE_KINDA_SMALL_NUMBER);
+    const double X = FVector::DotProduct(Direction, Right) / Depth;
+    const double Y = FVector::DotProduct(Direction, Up) / Depth;
+    return FVector2f(
+        static_cast<float>(0.5 + 0.5 * X / TanHalfFovX),
+        static_cast<float>(0.5 - 0.5 * Y / TanHalfFovY));
+}
+
+FVector FOmniCaptureODSLayout::ViewUVToDirection(int32 Slice, int32 Row, const FVector2f& UV) const
+{
+    FVector Forward;
+    FVector Right;
+    FVector Up;
+    GetViewAxes(GetSliceYaw(Slice), GetRowPitch(Row), Forward, Right, Up);
+    return (Forward + Right * ((UV.X * 2.0 - 1.0) * TanHalfFovX) + Up * ((1.0 - UV.Y * 2.0) * TanHalfFovY)).GetSafeNormal();
+}
+
+FVector FOmniCaptureODSLayout::GetOutputDirection(int32 X, int32 Y, double& OutLongitude, double& OutLatitude) const
+{
+    OutLongitude = ((X + 0.5) / EyeSize.X * 2.0 - 1.0) * LongitudeSpan * 0.5;
+    OutLatitude = (0.5 - (Y + 0.5) / EyeSize.Y) * LatitudeSpan;
+    return DirectionFromAngles(OutLongitude, OutLatitude);
+}
+
+uint32 FOmniCaptureODSLayout::GetTypeHash() const
+{
+    // The eye radius only moves the cameras; the stitch itself does not depend on it.
+    uint32 Hash = ::GetTypeHash(EyeSize);
+    Hash = HashCombine(Hash, ::GetTypeHash(SliceCount));
+    Hash = HashCombine(Hash, ::GetTypeHash(RowCount));
+    Hash = HashCombine(Hash, ::GetTypeHash(LongitudeSpan));
+    Hash = HashCombine(Hash, ::GetTypeHash(LatitudeSpan));
+    Hash = HashCombine(Hash, ::GetTypeHash(ViewSize));
+    return Hash;
+}
+
+TSharedRef<const FOmniCaptureRemapTable> FOmniCaptureODSLayout::BuildStitchTable() const
+{
+    TSharedRef<FOmniCaptureRemapTable> Table = MakeShared<FOmniCaptureRemapTable>();
+    Table->Size = EyeSize;
+    Table->TapsPerPixel = 1;
+    Table->Key = GetTypeHash();
+    Table->Entries.SetNumZeroed(EyeSize.X * EyeSize.Y);
+    if (!IsValid())
+    {
+        return Table;
+    }
+
+    FVector4f* Entries = Table->Entries.GetData();
+    ParallelFor(EyeSize.Y, [this, Entries](int32 Y)
+    {
+        for (int32 X = 0; X < EyeSize.X; ++X)
+        {
+            double Longitude = 0.0;
+            double Latitude = 0.0;
+            const FVector Direction = GetOutputDirection(X, Y, Longitude, Latitude);
+
+            int32 Slice = 0;
+            int32 Row = 0;
+            ResolveView(Longitude, Latitude, Slice, Row);
+            const FVector2f UV = ProjectToView(Slice, Row, Direction);
+            Entries[Y * EyeSize.X + X] = FVector4f(UV.X, UV.Y, static_cast<float>(GetViewIndex(Slice, Row)), 1.0f);
+        }
+    });
+    return Table;
+}
+
+TSharedRef<const FOmniCaptureRemapTable> FOmniCaptureODSLayout::FindOrBuildStitchTable() const
+{
+    const uint32 Key = GetTypeHash();
+    {
+        FScopeLock Lock(&GStitchTableCS);
+        if (GLastStitchTable.IsValid() && GLastStitchTable->Key == Key && GLastStitchTable->Size == EyeSize)
+        {
+            return GLastStitchTable.ToSharedRef();
+        }
+    }
+
+    TSharedRef<const FOmniCaptureRemapTable> Table = BuildStitchTable();
+
+    FScopeLock Lock(&GStitchTableCS);
+    GLastStitchTable = Table;
+    return Table;
+}
+
+void FOmniCaptureODSLayout::StitchCPU(const FOmniCaptureRemapTable& Table, const FIntPoint& ViewSize, TConstArrayView<FOmniCaptureODSStitchTarget> Targets, int32 RowStride)
+{
+    const int32 ViewPixels = ViewSize.X * ViewSize.Y;
+    if (Targets.Num() == 0 || ViewPixels <= 0 || Table.Entries.Num() != Table.Size.X * Table.Size.Y)
+    {
+        return;
+    }
+
+    for (const FOmniCaptureODSStitchTarget& Target : Targets)
+    {
+        check(RowStride >= Target.Offset.X + Table.Size.X);
+        check(Target.Pixels.Num() >= (Target.Offset.Y + Table.Size.Y) * RowStride);
+    }
+
+    const int32 Width = Table.Size.X;
+    ParallelFor(Table.Size.Y, [&Table, &ViewSize, Targets, RowStride, Width, ViewPixels](int32 Y)
+    {
+        for (int32 X = 0; X < Width; ++X)
+        {
+            const FVector4f& Entry = Table.Entries[Y * Width + X];
+            const int32 ViewIndex = static_cast<int32>(Entry.Z);
+
+            // Same texel centres and clamp addressing as the GPU sampler.
+            const float SampleX = Entry.X * ViewSize.X - 0.5f;
+            const float SampleY = Entry.Y * ViewSize.Y - 0.5f;
+            const int32 X0 = FMath::FloorToInt(SampleX);
+            const int32 Y0 = FMath::FloorToInt(SampleY);
+            const float FracX = SampleX - X0;
+            const float FracY = SampleY - Y0;
+            const int32 Xa = FMath::Clamp(X0, 0, ViewSize.X - 1);
+            const int32 Xb = FMath::Clamp(X0 + 1, 0, ViewSize.X - 1);
+            const int32 Ya = FMath::Clamp(Y0, 0, ViewSize.Y - 1) * ViewSize.X;
+            const int32 Yb = FMath::Clamp(Y0 + 1, 0, ViewSize.Y - 1) * ViewSize.X;
+
+            for (const FOmniCaptureODSStitchTarget& Target : Targets)
+            {
+                FLinearColor Color = FLinearColor::Transparent;
+                if (Entry.W > 0.0f && Target.Views.IsValidIndex(ViewIndex) && Target.Views[ViewIndex].Num() == ViewPixels)
+                {
+                    const FLinearColor* View = Target.Views[ViewIndex].GetData();
+                    const FLinearColor Top = FMath::Lerp(View[Ya + Xa], View[Ya + Xb], FracX);
+                    const FLinearColor Bottom = FMath::Lerp(View[Yb + Xa], View[Yb + Xb], FracX);
+                    Color = FMath::Lerp(Top, Bottom, FracY);
+                }
+                Target.Pixels[(Target.Offset.Y + Y) * RowStride + Target.Offset.X + X] = Color;
+            }
+        }
+    });
+}
@@ -0,0 +1,224 @@
+#include "OmniCapturePixelPacking.h"
+
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    /** Same piecewise curve as LinearToSRGB in the engine shaders. */
+    float EncodeSRGB(float Value)
+    {
+        const float Clamped = Value > 0.0f ? FMath::Min(Value, 1.0f) : 0.0f;
+        return Clamped <= 0.0031308f ? Clamped * 12.92f : 1.055f * FMath::Pow(Clamped, 1.0f / 2.4f) - 0.055f;
+    }
+
+    float DecodeSRGB(float Value)
+    {
+        const float Clamped = Value > 0.0f ? FMath::Min(Value, 1.0f) : 0.0f;
+        return Clamped <= 0.04045f ? Clamped / 12.92f : FMath::Pow((Clamped + 0.055f) / 1.055f, 2.4f);
+    }
+
+    /** BT.709 to BT.2020 primaries (ITU-R BT.2087), as Rec709ToRec2020 in OmniColorConvertCS. */
+    FVector3f Rec709ToRec2020(const FVector3f& RGB)
+    {
+        return FVector3f(
+            FVector3f(0.627404f, 0.329283f, 0.043313f) | RGB,
+            FVector3f(0.069097f, 0.919540f, 0.011362f) | RGB,
+            FVector3f(0.016391f, 0.088013f, 0.895595f) | RGB);
+    }
+
+    FOmniCapturePackedRGB10A2 PackEncoded(const FLinearColor& Color, bool bLinear, EOmniCaptureColorSpace ColorSpace)
+    {
+        if (ColorSpace == EOmniCaptureColorSpace::HDR10)
+        {
+            const FVector3f Linear = bLinear
+                ? FVector3f(FMath::Max(Color.R, 0.0f), FMath::Max(Color.G, 0.0f), FMath::Max(Color.B, 0.0f))
+                : FVector3f(DecodeSRGB(Color.R), DecodeSRGB(Color.G), DecodeSRGB(Color.B));
+            const FVector3f Nits = Rec709ToRec2020(Linear) * FOmniCapturePixelPacking::HDR10ReferenceWhiteNits;
+            return FOmniCapturePixelPacking::PackRGB10A2(FLinearColor(
+                FOmniCapturePixelPacking::EncodePQ(Nits.X), FOmniCapturePixelPacking::EncodePQ(Nits.Y), FOmniCapturePixelPacking::EncodePQ(Nits.Z), Color.A));
+        }
+        if (!bLinear)
+        {
+            return FOmniCapturePixelPacking::PackRGB10A2(Color);
+        }
+        return FOmniCapturePixelPacking::PackRGB10A2(FLinearColor(EncodeSRGB(Color.R), EncodeSRGB(Color.G), EncodeSRGB(Color.B), Color.A));
+    }
+
+    /** Luma and chroma rows of the matrices OmniColorConvertCS uses. */
+    struct FYUVMatrix
+    {
+        FVector3f Y;
+        FVector3f Cb;
+        FVector3f Cr;
+    };
+
+    FYUVMatrix GetYUVMatrix(EOmniCaptureColorSpace ColorSpace)
+    {
+        if (ColorSpace == EOmniCaptureColorSpace::BT2020 || ColorSpace == EOmniCaptureColorSpace::HDR10)
+        {
+            return { FVector3f(0.2627f, 0.6780f, 0.0593f), FVector3f(-0.139630f, -0.360370f, 0.5f), FVector3f(0.5f, -0.459786f, -0.040214f) };
+        }
+        return { FVector3f(0.2126f, 0.7152f, 0.0722f), FVector3f(-0.114572f, -0.385428f, 0.5f), FVector3f(0.5f, -0.454153f, -0.045847f) };
+    }
+
+    /** Limited-range code: the 8-bit Offset + Range * Value scaled up to BitDepth. */
+    uint16 EncodeLimitedRange(float Value, float Range, float Offset, int32 BitDepth)
+    {
+        const float Scale = static_cast<float>(1 << (BitDepth - 8));
+        const float MaxCode = static_cast<float>((1 << BitDepth) - 1);
+        return static_cast<uint16>(FMath::RoundToInt(FMath::Clamp((Value * Range + Offset) * Scale, 0.0f, MaxCode)));
+    }
+}
+
+uint32 FOmniCapturePixelPacking::QuantizeUnorm(float Value, int32 BitDepth)
+{
+    const uint32 MaxCode = (1u << FMath::Clamp(BitDepth, 1, 16)) - 1u;
+    // Written so NaN lands on zero.
+    const float Clamped = Value > 0.0f ? FMath::Min(Value, 1.0f) : 0.0f;
+    return static_cast<uint32>(FMath::RoundToInt(Clamped * static_cast<float>(MaxCode)));
+}
+
+float FOmniCapturePixelPacking::DequantizeUnorm(uint32 Code, int32 BitDepth)
+{
+    const uint32 MaxCode = (1u << FMath::Clamp(BitDepth, 1, 16)) - 1u;
+    return static_cast<float>(FMath::Min(Code, MaxCode)) / static_cast<float>(MaxCode);
+}
+
+float FOmniCapturePixelPacking::EncodePQ(float Nits)
+{
+    // ST 2084 constants m1, m2, c1, c2 and c3; written so NaN lands on zero.
+    const float Y = FMath::Pow(Nits > 0.0f ? FMath::Min(Nits / 10000.0f, 1.0f) : 0.0f, 0.1593017578125f);
+    return FMath::Pow((0.8359375f + 18.8515625f * Y) / (1.0f + 18.6875f * Y), 78.84375f);
+}
+
+FOmniCapturePackedRGB10A2 FOmniCapturePixelPacking::PackRGB10A2(const FLinearColor& Color)
+{
+    FOmniCapturePackedRGB10A2 Pixel;
+    Pixel.Bits = QuantizeUnorm(Color.R, 10)
+        | (QuantizeUnorm(Color.G, 10) << 10)
+        | (QuantizeUnorm(Color.B, 10) << 20)
+        | (QuantizeUnorm(Color.A, 2) << 30);
+    return Pixel;
+}
+
+FLinearColor FOmniCapturePixelPacking::UnpackRGB10A2(FOmniCapturePackedRGB10A2 Pixel)
+{
+    return FLinearColor(
+        DequantizeUnorm(Pixel.Bits & 0x3FFu, 10),
+        DequantizeUnorm((Pixel.Bits >> 10) & 0x3FFu, 10),
+        DequantizeUnorm((Pixel.Bits >> 20) & 0x3FFu, 10),
+        DequantizeUnorm(Pixel.Bits >> 30, 2));
+}
+
+TUniquePtr<TImagePixelData<FOmniCapturePackedRGB10A2>> FOmniCapturePixelPacking::PackFrame(const FImagePixelData& PixelData, EOmniCapturePixelDataType PixelDataType, bool bLinear, EOmniCaptureColorSpace ColorSpace)
+{
+    const FIntPoint Size = PixelData.GetSize();
+    const int32 PixelCount = Size.X * Size.Y;
+    TUniquePtr<TImagePixelData<FOmniCapturePackedRGB10A2>> Packed = MakeUnique<TImagePixelData<FOmniCapturePackedRGB10A2>>(Size);
+    Packed->Pixels.SetNumUninitialized(PixelCount);
+    FOmniCapturePackedRGB10A2* Dest = Packed->Pixels.GetData();
+
+    switch (PixelDataType)
+    {
+    case EOmniCapturePixelDataType::Color8:
+    {
+        // 8-bit frames are already sRGB encoded.
+        const TArray<FColor>& Source = static_cast<const TImagePixelData<FColor>&>(PixelData).Pixels;
+        if (Source.Num() != PixelCount)
+        {
+            return nullptr;
+        }
+        ParallelFor(Size.Y, [&Source, Dest, Width = Size.X, ColorSpace](int32 Row)
+        {
+            for (int32 Index = Row * Width; Index < (Row + 1) * Width; ++Index)
+            {
+                const FColor& Color = Source[Index];
+                Dest[Index] = PackEncoded(FLinearColor(Color.R / 255.0f, Color.G / 255.0f, Color.B / 255.0f, Color.A / 255.0f), false, ColorSpace);
+            }
+        });
+        break;
+    }
+    case EOmniCapturePixelDataType::LinearColorFloat16:
+    {
+        const TArray<FFloat16Color>& Source = static_cast<const TImagePixelData<FFloat16Color>&>(PixelData).Pixels;
+        if (Source.Num() != PixelCount)
+        {
+            return nullptr;
+        }
+        ParallelFor(Size.Y, [&Source, Dest, Width = Size.X, bLinear, ColorSpace](int32 Row)
+        {
+            for (int32 Index = Row * Width; Index < (Row + 1) * Width; ++Index)
+            {
+                Dest[Index] = PackEncoded(FLinearColor(Source[Index]), bLinear, ColorSpace);
+            }
+        });
+        break;
+    }
+    case EOmniCapturePixelDataType::LinearColorFloat32:
+    {
+        const TArray<FLinearColor>& Source = static_cast<const TImagePixelData<FLinearColor>&>(PixelData).Pixels;
+        if (Source.Num() != PixelCount)
+        {
+            return nullptr;
+        }
+        ParallelFor(Size.Y, [&Source, Dest, Width = Size.X, bLinear, ColorSpace](int32 Row)
+        {
+            for (int32 Index = Row * Width; Index < (Row + 1) * Width; ++Index)
+            {
+                Dest[Index] = PackEncoded(Source[Index], bLinear, ColorSpace);
+            }
+        });
+        break;
+    }
+    default:
+        return nullptr;
+    }
+
+    return Packed;
+}
+
+void FOmniCapturePixelPacking::ConvertToYUV420(TConstArrayView<FOmniCapturePackedRGB10A2> Pixels, const FIntPoint& Size, EOmniCaptureColorSpace ColorSpace, int32 BitDepth, TArray<uint16>& OutY, TArray<uint16>& OutCb, TArray<uint16>& OutCr)
+{
+    const int32 Width = Size.X;
+    const int32 Height = Size.Y;
+    const int32 ChromaWidth = (Width + 1) / 2;
+    const int32 ChromaHeight = (Height + 1) / 2;
+    OutY.SetNumUninitialized(Width * Height);
+    OutCb.SetNumUninitialized(ChromaWidth * ChromaHeight);
+    OutCr.SetNumUninitialized(ChromaWidth * ChromaHeight);
+    if (Pixels.Num() != Width * Height || Width <= 0 || Height <= 0)
+    {
+        return;
+    }
+
+    BitDepth = FMath::Clamp(BitDepth, 8, 16);
+    const FYUVMatrix Matrix = GetYUVMatrix(ColorSpace);
+    uint16* YPlane = OutY.GetData();
+    uint16* CbPlane = OutCb.GetData();
+    uint16* CrPlane = OutCr.GetData();
+
+    ParallelFor(ChromaHeight, [&](int32 ChromaRow)
+    {
+        for (int32 ChromaColumn = 0; ChromaColumn < ChromaWidth; ++ChromaColumn)
+        {
+            FVector3f Sum = FVector3f::ZeroVector;
+            int32 Count = 0;
+            for (int32 Y = ChromaRow * 2; Y < FMath::Min(ChromaRow * 2 + 2, Height); ++Y)
+            {
+                for (int32 X = ChromaColumn * 2; X < FMath::Min(ChromaColumn * 2 + 2, Width); ++X)
+                {
+                    const FLinearColor Color = UnpackRGB10A2(Pixels[Y * Width + X]);
+                    const FVector3f RGB(Color.R, Color.G, Color.B);
+                    YPlane[Y * Width + X] = EncodeLimitedRange(Matrix.Y | RGB, 219.0f, 16.0f, BitDepth);
+                    Sum += RGB;
+                    ++Count;
+                }
+            }
+
+            const FVector3f Average = Sum / static_cast<float>(Count);
+            const int32 ChromaIndex = ChromaRow * ChromaWidth + ChromaColumn;
+            CbPlane[ChromaIndex] = EncodeLimitedRange(Matrix.Cb | Average, 224.0f, 128.0f, BitDepth);
+            CrPlane[ChromaIndex] = EncodeLimitedRange(Matrix.Cr | Average, 224.0f, 128.0f, BitDepth);
+        }
+    });
+}
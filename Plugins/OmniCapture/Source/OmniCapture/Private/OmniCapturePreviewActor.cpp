@@ -2,8 +2,10 @@
 
 #include "Components/StaticMeshComponent.h"
 #include "OmniCaptureEquirectConverter.h"
+#include "OmniCapturePreviewDownsample.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/Texture2D.h"
+#include "Engine/TextureRenderTarget2D.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Materials/MaterialInterface.h"
 #include "OmniCaptureIncludeFixes.h"
@@ -96,18 +98,40 @@ void AOmniCapturePreviewActor::ResizePreviewTexture(const FIntPoint& Size)
 
     UpdatePreviewAspectRatio(Size);
 
-    if (PreviewTexture && PreviewTexture->GetSizeX() == Size.X && PreviewTexture->GetSizeY() == Size.Y)
+    if (!PreviewTexture || PreviewTexture->GetSizeX() != Size.X || PreviewTexture->GetSizeY() != Size.Y)
+    {
+        PreviewTexture = UTexture2D::CreateTransient(Size.X, Size.Y, PF_B8G8R8A8);
+        PreviewTexture->MipGenSettings = TMGS_NoMipmaps;
+        PreviewTexture->CompressionSettings = TC_HDR;
+        PreviewTexture->SRGB = true;
+        PreviewTexture->UpdateResource();
+    }
+
+    ApplyTexture(PreviewTexture);
+}
+
+void AOmniCapturePreviewActor::ResizePreviewRenderTarget(const FIntPoint& Size)
+{
+    if (Size.X <= 0 || Size.Y <= 0)
     {
         return;
     }
 
-    PreviewTexture = UTexture2D::CreateTransient(Size.X, Size.Y, PF_B8G8R8A8);
-    PreviewTexture->MipGenSettings = TMGS_NoMipmaps;
-    PreviewTexture->CompressionSettings = TC_HDR;
-    PreviewTexture->SRGB = true;
-    PreviewTexture->UpdateResource();
+    UpdatePreviewAspectRatio(Size);
 
-    ApplyTexture(PreviewTexture);
+    if (!PreviewRenderTarget)
+    {
+        PreviewRenderTarget = NewObject<UTextureRenderTarget2D>(this, TEXT("OmniCapturePreviewTarget"), RF_Transient);
+        PreviewRenderTarget->bCanCreateUAV = true;
+        PreviewRenderTarget->ClearColor = FLinearColor::Black;
+        PreviewRenderTarget->InitCustomFormat(Size.X, Size.Y, PF_FloatRGBA, true);
+    }
+    else if (PreviewRenderTarget->SizeX != Size.X || PreviewRenderTarget->SizeY != Size.Y)
+    {
+        PreviewRenderTarget->ResizeTarget(Size.X, Size.Y);
+    }
+
+    ApplyTexture(PreviewRenderTarget);
 }
 
 void AOmniCapturePreviewActor::UpdatePreviewAspectRatio(const FIntPoint& Size)
@@ -127,12 +151,18 @@ void AOmniCapturePreviewActor::UpdatePreviewAspectRatio(const FIntPoint& Size)
     ScreenComponent->SetRelativeScale3D(Scale);
 }
 
-void AOmniCapturePreviewActor::ApplyTexture(UTexture2D* Texture)
+void AOmniCapturePreviewActor::ApplyTexture(UTexture* Texture)
 {
+    if (Texture == BoundTexture)
+    {
+        return;
+    }
+
     EnsureMaterial();
     if (DynamicMaterial && Texture)
     {
         DynamicMaterial->SetTextureParameterValue(TextureParameterName, Texture);
+        BoundTexture = Texture;
     }
 }
 
@@ -141,83 +171,57 @@ void AOmniCapturePreviewActor::SetPreviewView(EOmniCapturePreviewView InView)
     PreviewViewMode = InView;
 }
 
-void AOmniCapturePreviewActor::UpdatePreviewTexture(const FOmniCaptureEquirectResult& Result, const FOmniCaptureSettings& Settings)
+FOmniCapturePreviewRequest AOmniCapturePreviewActor::UpdatePreviewTexture(const FOmniCaptureEquirectResult& Result, const FOmniCaptureSettings& Settings)
 {
-    const FIntPoint Size = Result.Size;
-    if (Size.X <= 0 || Size.Y <= 0)
-    {
-        return;
-    }
-
-    const bool bStereo = Settings.IsStereo();
-    const bool bShowSingleEye = bStereo && PreviewViewMode != EOmniCapturePreviewView::StereoComposite;
+    FOmniCapturePreviewRequest Request;
 
-    FIntPoint TargetSize = Size;
-    if (bShowSingleEye)
+    // GPU-converted frames are filtered from their pooled output target straight into the preview render target.
+    if (Result.OutputTarget.IsValid() && !Result.bUsedCPUFallback)
     {
-        if (Settings.StereoLayout == EOmniCaptureStereoLayout::SideBySide)
+        const FIntRect ViewRect = FOmniCapturePreviewDownsample::GetViewRect(Result.Size, Settings, PreviewViewMode);
+        ResizePreviewRenderTarget(FOmniCapturePreviewDownsample::GetPreviewSize(ViewRect.Size(), Settings.PreviewMaxWidth));
+        if (PreviewRenderTarget)
         {
-            TargetSize.X = FMath::Max(1, Size.X / 2);
-        }
-        else
-        {
-            TargetSize.Y = FMath::Max(1, Size.Y / 2);
+            FOmniCapturePreviewDownsample::EnqueueGPUDownsample(Result.OutputTarget, ViewRect, PreviewRenderTarget);
         }
+        return Request;
     }
 
-    ResizePreviewTexture(TargetSize);
-    if (!PreviewTexture)
+    if (!Result.PixelData.IsValid())
     {
-        return;
+        return Request;
     }
 
-    FTexture2DMipMap& Mip = PreviewTexture->GetPlatformData()->Mips[0];
-    void* TextureMemory = Mip.BulkData.Lock(LOCK_READ_WRITE);
+    // The box filter reads the whole view, so it runs where the frame goes next instead of stalling the game thread.
+    Request.Target = this;
+    Request.ViewRect = FOmniCapturePreviewDownsample::GetViewRect(Result.PixelData->GetSize(), Settings, PreviewViewMode);
+    Request.PreviewSize = FOmniCapturePreviewDownsample::GetPreviewSize(Request.ViewRect.Size(), Settings.PreviewMaxWidth);
+    return Request;
+}
 
-    if (Result.PreviewPixels.Num() != Size.X * Size.Y)
+void AOmniCapturePreviewActor::UploadPreviewPixels(const FIntPoint& TargetSize, TArray<FColor>&& Pixels)
+{
+    if (Pixels.Num() != TargetSize.X * TargetSize.Y)
     {
-        Mip.BulkData.Unlock();
         return;
     }
 
-    if (bShowSingleEye)
-    {
-        const int32 OutputPixels = TargetSize.X * TargetSize.Y;
-        PreviewScratchBuffer.SetNum(OutputPixels, EAllowShrinking::No);
+    // The render thread owns the upload buffer until the copy is done, so each update gets its own.
+    TUniquePtr<TArray<FColor>> UploadPixels = MakeUnique<TArray<FColor>>(MoveTemp(Pixels));
 
-        if (Settings.StereoLayout == EOmniCaptureStereoLayout::SideBySide)
-        {
-            const int32 EyeWidth = TargetSize.X;
-            const int32 SourceWidth = Size.X;
-            const int32 StartX = PreviewViewMode == EOmniCapturePreviewView::LeftEye ? 0 : EyeWidth;
-            for (int32 Row = 0; Row < Size.Y; ++Row)
-            {
-                const int32 DestIndex = Row * EyeWidth;
-                const int32 SourceIndex = Row * SourceWidth + StartX;
-                FMemory::Memcpy(PreviewScratchBuffer.GetData() + DestIndex, Result.PreviewPixels.GetData() + SourceIndex, EyeWidth * sizeof(FColor));
-            }
-        }
-        else
-        {
-            const int32 EyeHeight = TargetSize.Y;
-            const int32 SourceWidth = Size.X;
-            const int32 StartRow = PreviewViewMode == EOmniCapturePreviewView::LeftEye ? 0 : EyeHeight;
-            for (int32 Row = 0; Row < EyeHeight; ++Row)
-            {
-                const int32 DestIndex = Row * TargetSize.X;
-                const int32 SourceIndex = (StartRow + Row) * SourceWidth;
-                FMemory::Memcpy(PreviewScratchBuffer.GetData() + DestIndex, Result.PreviewPixels.GetData() + SourceIndex, TargetSize.X * sizeof(FColor));
-            }
-        }
-
-        FMemory::Memcpy(TextureMemory, PreviewScratchBuffer.GetData(), PreviewScratchBuffer.Num() * sizeof(FColor));
-    }
-    else
+    ResizePreviewTexture(TargetSize);
+    if (!PreviewTexture)
     {
-        const int32 CopyCount = FMath::Min(Result.PreviewPixels.Num(), TargetSize.X * TargetSize.Y);
-        FMemory::Memcpy(TextureMemory, Result.PreviewPixels.GetData(), CopyCount * sizeof(FColor));
+        return;
     }
 
-    Mip.BulkData.Unlock();
-    PreviewTexture->UpdateResource();
+    // Only the region is rewritten; the texture resource is reused instead of rebuilt by UpdateResource.
+    FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(0, 0, 0, 0, TargetSize.X, TargetSize.Y);
+    uint8* SourceData = reinterpret_cast<uint8*>(UploadPixels->GetData());
+    PreviewTexture->UpdateTextureRegions(0, 1, Region, TargetSize.X * sizeof(FColor), sizeof(FColor), SourceData,
+        [UploadedPixels = UploadPixels.Release()](uint8*, const FUpdateTextureRegion2D* UploadedRegion)
+        {
+            delete UploadedPixels;
+            delete UploadedRegion;
+        });
 }
@@ -0,0 +1,241 @@
+#include "OmniCapturePreviewDownsample.h"
+
+#include "Async/ParallelFor.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "GlobalShader.h"
+#include "RenderGraphBuilder.h"
+#include "RenderGraphUtils.h"
+#if __has_include("RenderGraphUtils/Public/ComputeShaderUtils.h")
+#include "RenderGraphUtils/Public/ComputeShaderUtils.h"
+#elif __has_include("RenderGraphUtils/ComputeShaderUtils.h")
+#include "RenderGraphUtils/ComputeShaderUtils.h"
+#elif __has_include("ComputeShaderUtils.h")
+#include "ComputeShaderUtils.h"
+#endif
+#include "RenderingThread.h"
+#include "ShaderParameterStruct.h"
+#include "TextureResource.h"
+
+namespace
+{
+    constexpr int32 MaxTaps = FOmniCapturePreviewDownsample::MaxTapsPerAxis;
+
+    class FOmniPreviewDownsampleCS final : public FGlobalShader
+    {
+    public:
+        DECLARE_GLOBAL_SHADER(FOmniPreviewDownsampleCS);
+        SHADER_USE_PARAMETER_STRUCT(FOmniPreviewDownsampleCS, FGlobalShader);
+
+        BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+            SHADER_PARAMETER(FIntPoint, SourceOrigin)
+            SHADER_PARAMETER(FIntPoint, SourceSize)
+            SHADER_PARAMETER(FIntPoint, OutputSize)
+            SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float4>, SourceTexture)
+            SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, OutputTexture)
+        END_SHADER_PARAMETER_STRUCT()
+
+        static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+        {
+            return true;
+        }
+    };
+
+    IMPLEMENT_GLOBAL_SHADER(FOmniPreviewDownsampleCS, "/Plugin/OmniCapture/Private/OmniPreviewDownsampleCS.usf", "MainCS", SF_Compute);
+
+    /** Source coordinates each output texel averages along one axis, MaxTaps slots per texel. */
+    struct FBoxTaps
+    {
+        TArray<int32> Coordinates;
+        TArray<int32> Counts;
+    };
+
+    FBoxTaps MakeBoxTaps(int32 SourceStart, int32 SourceCount, int32 OutputCount)
+    {
+        FBoxTaps Taps;
+        Taps.Coordinates.SetNumUninitialized(OutputCount * MaxTaps);
+        Taps.Counts.SetNumUninitialized(OutputCount);
+        for (int32 Output = 0; Output < OutputCount; ++Output)
+        {
+            const int32 BoxBegin = static_cast<int32>(static_cast<int64>(Output) * SourceCount / OutputCount);
+            const int32 BoxEnd = FMath::Max(BoxBegin + 1, static_cast<int32>(static_cast<int64>(Output + 1) * SourceCount / OutputCount));
+            const int32 BoxWidth = BoxEnd - BoxBegin;
+            const int32 Count = FMath::Min(BoxWidth, MaxTaps);
+            for (int32 Tap = 0; Tap < Count; ++Tap)
+            {
+                // Tap centres spread evenly across the box; with a tap per texel this is every texel.
+                Taps.Coordinates[Output * MaxTaps + Tap] = SourceStart + BoxBegin + (Tap * 2 + 1) * BoxWidth / (Count * 2);
+            }
+            Taps.Counts[Output] = Count;
+        }
+        return Taps;
+    }
+
+    template<typename PixelType, typename ToAccumulatorType, typename ResolveType>
+    void BoxFilter(const PixelType* Pixels, int32 Stride, const FBoxTaps& Columns, const FBoxTaps& Rows, const FIntPoint& PreviewSize, FColor* OutPixels, ToAccumulatorType ToAccumulator, ResolveType Resolve)
+    {
+        ParallelFor(PreviewSize.Y, [&](int32 Y)
+        {
+            const int32 RowCount = Rows.Counts[Y];
+            FColor* OutRow = OutPixels + static_cast<int64>(Y) * PreviewSize.X;
+            for (int32 X = 0; X < PreviewSize.X; ++X)
+            {
+                const int32 ColumnCount = Columns.Counts[X];
+                FLinearColor Sum(0.0f, 0.0f, 0.0f, 0.0f);
+                for (int32 RowTap = 0; RowTap < RowCount; ++RowTap)
+                {
+                    const PixelType* SourceRow = Pixels + static_cast<int64>(Rows.Coordinates[Y * MaxTaps + RowTap]) * Stride;
+                    for (int32 ColumnTap = 0; ColumnTap < ColumnCount; ++ColumnTap)
+                    {
+                        Sum += ToAccumulator(SourceRow[Columns.Coordinates[X * MaxTaps + ColumnTap]]);
+                    }
+                }
+                OutRow[X] = Resolve(Sum / static_cast<float>(RowCount * ColumnCount));
+            }
+        });
+    }
+
+    FColor ResolveLinear(const FLinearColor& Average)
+    {
+        return Average.ToFColor(true);
+    }
+}
+
+FIntRect FOmniCapturePreviewDownsample::GetViewRect(const FIntPoint& Size, const FOmniCaptureSettings& Settings, EOmniCapturePreviewView View)
+{
+    if (!Settings.IsStereo() || View == EOmniCapturePreviewView::StereoComposite)
+    {
+        return FIntRect(FIntPoint::ZeroValue, Size);
+    }
+
+    const bool bRightEye = View == EOmniCapturePreviewView::RightEye;
+    if (Settings.StereoLayout == EOmniCaptureStereoLayout::SideBySide)
+    {
+        const int32 EyeWidth = FMath::Max(1, Size.X / 2);
+        return FIntRect(bRightEye ? EyeWidth : 0, 0, bRightEye ? EyeWidth * 2 : EyeWidth, Size.Y);
+    }
+
+    const int32 EyeHeight = FMath::Max(1, Size.Y / 2);
+    return FIntRect(0, bRightEye ? EyeHeight : 0, Size.X, bRightEye ? EyeHeight * 2 : EyeHeight);
+}
+
+FIntPoint FOmniCapturePreviewDownsample::GetPreviewSize(const FIntPoint& SourceSize, int32 MaxWidth)
+{
+    if (SourceSize.X <= 0 || SourceSize.Y <= 0)
+    {
+        return FIntPoint::ZeroValue;
+    }
+
+    const int32 Width = FMath::Clamp(MaxWidth, 1, SourceSize.X);
+    const int32 Height = FMath::Max(1, static_cast<int32>(static_cast<int64>(SourceSize.Y) * Width / SourceSize.X));
+    return FIntPoint(Width, Height);
+}
+
+bool FOmniCapturePreviewDownsample::Downsample(const FImagePixelData& PixelData, EOmniCapturePixelDataType PixelDataType, const FIntRect& SourceRect, const FIntPoint& PreviewSize, TArray<FColor>& OutPixels)
+{
+    const FIntPoint FrameSize = PixelData.GetSize();
+    const int64 PixelCount = static_cast<int64>(FrameSize.X) * FrameSize.Y;
+    const FIntRect Rect(SourceRect.Min.ComponentMax(FIntPoint::ZeroValue), SourceRect.Max.ComponentMin(FrameSize));
+    if (Rect.Width() <= 0 || Rect.Height() <= 0 || PreviewSize.X <= 0 || PreviewSize.Y <= 0)
+    {
+        OutPixels.Reset();
+        return false;
+    }
+
+    const FBoxTaps Columns = MakeBoxTaps(Rect.Min.X, Rect.Width(), PreviewSize.X);
+    const FBoxTaps Rows = MakeBoxTaps(Rect.Min.Y, Rect.Height(), PreviewSize.Y);
+    OutPixels.SetNumUninitialized(PreviewSize.X * PreviewSize.Y, EAllowShrinking::No);
+
+    switch (PixelDataType)
+    {
+    case EOmniCapturePixelDataType::Color8:
+    {
+        // 8-bit frames are already sRGB encoded, so their codes are averaged directly.
+        const TArray<FColor>& Source = static_cast<const TImagePixelData<FColor>&>(PixelData).Pixels;
+        if (Source.Num() != PixelCount)
+        {
+            break;
+        }
+        BoxFilter(Source.GetData(), FrameSize.X, Columns, Rows, PreviewSize, OutPixels.GetData(),
+            [](const FColor& Pixel) { return FLinearColor(Pixel.R, Pixel.G, Pixel.B, Pixel.A); },
+            [](const FLinearColor& Average)
+            {
+                return FColor(
+                    static_cast<uint8>(FMath::RoundToInt(Average.R)),
+                    static_cast<uint8>(FMath::RoundToInt(Average.G)),
+                    static_cast<uint8>(FMath::RoundToInt(Average.B)),
+                    static_cast<uint8>(FMath::RoundToInt(Average.A)));
+            });
+        return true;
+    }
+    case EOmniCapturePixelDataType::LinearColorFloat16:
+    {
+        const TArray<FFloat16Color>& Source = static_cast<const TImagePixelData<FFloat16Color>&>(PixelData).Pixels;
+        if (Source.Num() != PixelCount)
+        {
+            break;
+        }
+        BoxFilter(Source.GetData(), FrameSize.X, Columns, Rows, PreviewSize, OutPixels.GetData(),
+            [](const FFloat16Color& Pixel) { return FLinearColor(Pixel); }, ResolveLinear);
+        return true;
+    }
+    case EOmniCapturePixelDataType::LinearColorFloat32:
+    {
+        const TArray<FLinearColor>& Source = static_cast<const TImagePixelData<FLinearColor>&>(PixelData).Pixels;
+        if (Source.Num() != PixelCount)
+        {
+            break;
+        }
+        BoxFilter(Source.GetData(), FrameSize.X, Columns, Rows, PreviewSize, OutPixels.GetData(),
+            [](const FLinearColor& Pixel) { return Pixel; }, ResolveLinear);
+        return true;
+    }
+    default:
+        break;
+    }
+
+    OutPixels.Reset();
+    return false;
+}
+
+void FOmniCapturePreviewDownsample::EnqueueGPUDownsample(const TRefCountPtr<IPooledRenderTarget>& Source, const FIntRect& SourceRect, UTextureRenderTarget2D* Target)
+{
+    FTextureRenderTargetResource* TargetResource = Target ? Target->GameThread_GetRenderTargetResource() : nullptr;
+    if (!Source.IsValid() || !TargetResource || SourceRect.Width() <= 0 || SourceRect.Height() <= 0)
+    {
+        return;
+    }
+
+    // The captured reference keeps the pooled output alive until the pass has read it.
+    ENQUEUE_RENDER_COMMAND(OmniCapturePreviewDownsample)([Source, SourceRect, TargetResource](FRHICommandListImmediate& RHICmdList)
+    {
+        FTextureRHIRef TargetTexture = TargetResource->GetRenderTargetTexture();
+        if (!TargetTexture.IsValid() || !Source->GetRHI())
+        {
+            return;
+        }
+
+        FRDGBuilder GraphBuilder(RHICmdList);
+        FRDGTextureRef SourceTexture = GraphBuilder.RegisterExternalTexture(Source, TEXT("OmniPreviewSource"));
+        FRDGTextureRef OutputTexture = GraphBuilder.RegisterExternalTexture(CreateRenderTarget(TargetTexture, TEXT("OmniPreview")));
+
+        const FIntPoint SourceExtent = SourceTexture->Desc.Extent;
+        const FIntRect ClampedRect(SourceRect.Min.ComponentMax(FIntPoint::ZeroValue), SourceRect.Max.ComponentMin(SourceExtent));
+        const FIntPoint OutputSize = OutputTexture->Desc.Extent;
+        if (ClampedRect.Width() <= 0 || ClampedRect.Height() <= 0)
+        {
+            return;
+        }
+
+        FOmniPreviewDownsampleCS::FParameters* Parameters = GraphBuilder.AllocParameters<FOmniPreviewDownsampleCS::FParameters>();
+        Parameters->SourceOrigin = ClampedRect.Min;
+        Parameters->SourceSize = ClampedRect.Size();
+        Parameters->OutputSize = OutputSize;
+        Parameters->SourceTexture = SourceTexture;
+        Parameters->OutputTexture = GraphBuilder.CreateUAV(OutputTexture);
+
+        TShaderMapRef<FOmniPreviewDownsampleCS> ComputeShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+        const FIntVector GroupCount(FMath::DivideAndRoundUp(OutputSize.X, 8), FMath::DivideAndRoundUp(OutputSize.Y, 8), 1);
+        FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("OmniCapture::PreviewDownsample"), ComputeShader, Parameters, GroupCount);
+        GraphBuilder.Execute();
+    });
+}
@@ -0,0 +1,1069 @@
+#include "OmniCaptureProjectionRemap.h"
+
+#include "OmniCaptureFoveatedEquirect.h"
+#include "Async/ParallelFor.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/Optional.h"
+#include "Misc/ScopeLock.h"
+#include "RenderGraphBuilder.h"
+#include "RenderGraphUtils.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogOmniCaptureRemap, Log, All);
+
+namespace
+{
+    constexpr int32 GMaxCachedRemapTables = 8;
+    // Cached tables are evicted oldest first once together they would hold more than this.
+    constexpr int64 GMaxCachedRemapTableBytes = FOmniCaptureProjectionRemap::MaxTableBytes * 2;
+    // Extra face texels kept around the bilinear footprint so float differences between the CPU estimate and the GPU sampler never reach a cropped edge.
+    constexpr int32 GCoverageMarginTexels = 2;
+    // Adaptive faces never drop below this size (or FaceResolution, if smaller) and are rounded up to a multiple of GAdaptiveFaceAlignment.
+    constexpr int32 GMinAdaptiveFaceSize = 64;
+    constexpr int32 GAdaptiveFaceAlignment = 8;
+    // Tables grow with the square of this, so the grid stays small.
+    constexpr int32 GMaxRemapSamplesPerAxis = 3;
+
+    FCriticalSection GRemapTableCacheCS;
+    TArray<TSharedRef<const FOmniCaptureRemapTable>> GRemapTableCache;
+
+    // Rigs are reconfigured for every still, so the last coverage is kept to skip the full-resolution scan.
+    TOptional<TPair<uint32, FOmniCaptureFaceCoverage>> GLastFaceCoverage;
+
+    uint32 MakeTableKey(const FOmniCaptureProjectionParams& Params, const FIntPoint& EyeSize, int32 FaceResolution, float SeamStrength)
+    {
+        uint32 Key = Params.GetTypeHash();
+        Key = HashCombine(Key, ::GetTypeHash(EyeSize));
+        Key = HashCombine(Key, ::GetTypeHash(FaceResolution));
+        Key = HashCombine(Key, ::GetTypeHash(SeamStrength));
+        return Key;
+    }
+
+    struct FAtlasSlot
+    {
+        int32 FaceIndex;
+        int32 ClockwiseQuarterTurns;
+    };
+
+    // Faces are +X front, -X back, +Y up, -Y down, +Z right, -Z left; slots are row-major.
+    constexpr FAtlasSlot GCubemapSlots[6] = { { 4, 0 }, { 5, 0 }, { 2, 0 }, { 3, 0 }, { 0, 0 }, { 1, 0 } };
+    constexpr FAtlasSlot GEquiAngularSlots[6] = { { 5, 0 }, { 0, 0 }, { 4, 0 }, { 3, 3 }, { 1, 1 }, { 2, 3 } };
+
+    // Same pole blend and half-sphere cull as OmniEquirectCS/OmniFisheyeCS; a no-op for the remap projections.
+    bool ApplyLegacyShaping(const FOmniCaptureProjectionParams& Params, const FVector2D& UV, FVector& Direction)
+    {
+        if (Params.PolarStrength > 0.0f && Params.Projection == EOmniCaptureProjection::Equirectangular)
+        {
+            const double Latitude = (0.5 - UV.Y) * Params.VerticalFovRadians;
+            const double PoleFactor = FMath::Pow(FMath::Clamp(FMath::Abs(Latitude) / HALF_PI, 0.0, 1.0), 4.0);
+            const double Blend = PoleFactor * Params.PolarStrength;
+            if (Blend > 0.0)
+            {
+                Direction = FMath::Lerp(Direction, FVector(0.0, Latitude >= 0.0 ? 1.0 : -1.0, 0.0), Blend).GetSafeNormal();
+            }
+        }
+
+        return !(Params.bCullRearHemisphere && Direction.X < 0.0);
+    }
+
+    /** Texels and weights of one bilinear tap. Layers captured by the same rig share face sizes, so one footprint serves all of them. */
+    struct FBilinearFootprint
+    {
+        int32 FaceIndex = 0;
+        int32 Texels[4] = { 0, 0, 0, 0 };
+        float FracX = 0.0f;
+        float FracY = 0.0f;
+
+        FBilinearFootprint(const FOmniCaptureCubemapPixels& Cubemap, int32 InFaceIndex, const FVector2f& UV)
+        {
+            FaceIndex = FMath::Clamp(InFaceIndex, 0, 5);
+            const int32 Resolution = Cubemap.GetFaceResolution(FaceIndex);
+
+            // Texel centres at (i + 0.5) / Resolution, clamped at the edges like AM_Clamp.
+            const float X = UV.X * Resolution - 0.5f;
+            const float Y = UV.Y * Resolution - 0.5f;
+            const int32 X0 = FMath::FloorToInt(X);
+            const int32 Y0 = FMath::FloorToInt(Y);
+            FracX = X - X0;
+            FracY = Y - Y0;
+
+            const int32 Xa = FMath::Clamp(X0, 0, Resolution - 1);
+            const int32 Xb = FMath::Clamp(X0 + 1, 0, Resolution - 1);
+            const int32 Ya = FMath::Clamp(Y0, 0, Resolution - 1);
+            const int32 Yb = FMath::Clamp(Y0 + 1, 0, Resolution - 1);
+            Texels[0] = Ya * Resolution + Xa;
+            Texels[1] = Ya * Resolution + Xb;
+            Texels[2] = Yb * Resolution + Xa;
+            Texels[3] = Yb * Resolution + Xb;
+        }
+
+        FLinearColor Sample(const FOmniCaptureCubemapPixels& Cubemap) const
+        {
+            const TArray<FLinearColor>& Face = Cubemap.Faces[FaceIndex];
+            const FLinearColor Top = FMath::Lerp(Face[Texels[0]], Face[Texels[1]], FracX);
+            const FLinearColor Bottom = FMath::Lerp(Face[Texels[2]], Face[Texels[3]], FracX);
+            return FMath::Lerp(Top, Bottom, FracY);
+        }
+    };
+
+    bool HaveSameFaceSizes(const FOmniCaptureCubemapPixels& A, const FOmniCaptureCubemapPixels& B)
+    {
+        for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+        {
+            if (A.GetFaceResolution(FaceIndex) != B.GetFaceResolution(FaceIndex))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool ResolveDirection(FOmniCaptureInverseMapping InverseMapping, const FOmniCaptureProjectionParams& Params, const FVector2D& UV, FVector& OutDirection)
+    {
+        return InverseMapping(UV, Params, OutDirection) && ApplyLegacyShaping(Params, UV, OutDirection);
+    }
+
+    int64 GetTableBytes(const FIntPoint& EyeSize, int32 SamplesPerAxis)
+    {
+        return static_cast<int64>(FMath::Max(1, EyeSize.X)) * FMath::Max(1, EyeSize.Y) * SamplesPerAxis * SamplesPerAxis * static_cast<int64>(sizeof(FVector4f));
+    }
+
+    /** Solid angle of the sub-sample cell at UV, from the parallelogram spanned by neighbouring directions. Negative if unknown. */
+    double EstimateSolidAngle(FOmniCaptureInverseMapping InverseMapping, const FOmniCaptureProjectionParams& Params, const FVector2D& UV, const FVector& Direction, double StepU, double StepV)
+    {
+        FVector DirectionU;
+        FVector DirectionV;
+        const bool bHasU = ResolveDirection(InverseMapping, Params, FVector2D(UV.X + StepU, UV.Y), DirectionU)
+            || ResolveDirection(InverseMapping, Params, FVector2D(UV.X - StepU, UV.Y), DirectionU);
+        const bool bHasV = ResolveDirection(InverseMapping, Params, FVector2D(UV.X, UV.Y + StepV), DirectionV)
+            || ResolveDirection(InverseMapping, Params, FVector2D(UV.X, UV.Y - StepV), DirectionV);
+        if (!bHasU || !bHasV)
+        {
+            return -1.0;
+        }
+
+        const FVector Normal = Direction.GetSafeNormal();
+        const double Area = FVector::CrossProduct(DirectionU.GetSafeNormal() - Normal, DirectionV.GetSafeNormal() - Normal).Size();
+        return Area > 0.0 ? Area : -1.0;
+    }
+}
+
+FOmniCaptureProjectionParams FOmniCaptureProjectionParams::FromSettings(const FOmniCaptureSettings& Settings)
+{
+    FOmniCaptureProjectionParams Params;
+    Params.Projection = Settings.Projection;
+    Params.HorizontalFovRadians = FMath::DegreesToRadians(Settings.GetHorizontalFOVDegrees());
+    Params.VerticalFovRadians = FMath::DegreesToRadians(Settings.GetVerticalFOVDegrees());
+    Params.TiltRadians = FMath::DegreesToRadians(FMath::Clamp(Settings.FullDomeTilt, -90.0f, 90.0f));
+
+    const FIntPoint EyeSize = Settings.GetPerEyeOutputResolution();
+    Params.AspectRatio = EyeSize.Y > 0 ? static_cast<float>(EyeSize.X) / EyeSize.Y : 1.0f;
+
+    // Keep the mirror inside the dome and the projector outside the mirror.
+    Params.MirrorOffset = FMath::Clamp(Settings.MirrorOffset, 0.1f, 0.95f);
+    Params.MirrorRadius = FMath::Clamp(Settings.MirrorRadius, 0.05f, FMath::Max(0.05f, 0.98f - Params.MirrorOffset));
+    Params.ProjectorDistance = FMath::Max(Settings.MirrorProjectorDistance, Params.MirrorRadius * 1.05f);
+
+    if (Settings.IsFoveatedEquirect())
+    {
+        Params.FoveatedSourceSize = Settings.GetFoveatedSourceResolution();
+        Params.FoveationStartLatitude = Settings.FoveationStartLatitude;
+        Params.FoveationLevels = FMath::Clamp(Settings.FoveationLevels, 1, 4);
+    }
+    Params.SamplesPerAxis = Settings.GetRemapSamplesPerAxis();
+    return Params;
+}
+
+uint32 FOmniCaptureProjectionParams::GetTypeHash() const
+{
+    uint32 Hash = ::GetTypeHash(static_cast<uint8>(Projection));
+    Hash = HashCombine(Hash, ::GetTypeHash(HorizontalFovRadians));
+    Hash = HashCombine(Hash, ::GetTypeHash(VerticalFovRadians));
+    Hash = HashCombine(Hash, ::GetTypeHash(TiltRadians));
+    Hash = HashCombine(Hash, ::GetTypeHash(AspectRatio));
+    Hash = HashCombine(Hash, ::GetTypeHash(MirrorRadius));
+    Hash = HashCombine(Hash, ::GetTypeHash(MirrorOffset));
+    Hash = HashCombine(Hash, ::GetTypeHash(ProjectorDistance));
+    Hash = HashCombine(Hash, ::GetTypeHash(FoveatedSourceSize));
+    Hash = HashCombine(Hash, ::GetTypeHash(FoveationStartLatitude));
+    Hash = HashCombine(Hash, ::GetTypeHash(FoveationLevels));
+    Hash = HashCombine(Hash, ::GetTypeHash(PolarStrength));
+    Hash = HashCombine(Hash, ::GetTypeHash(bCullRearHemisphere));
+    Hash = HashCombine(Hash, ::GetTypeHash(SamplesPerAxis));
+    return Hash;
+}
+
+int64 FOmniCaptureRemapTable::GetAllocatedBytes() const
+{
+    return static_cast<int64>(Entries.GetAllocatedSize());
+}
+
+int32 FOmniCaptureRemapTable::GetValidCount() const
+{
+    const int32 Taps = FMath::Max(1, TapsPerPixel);
+    int32 Count = 0;
+    for (int32 Pixel = 0; Pixel + Taps <= Entries.Num(); Pixel += Taps)
+    {
+        for (int32 Tap = 0; Tap < Taps; ++Tap)
+        {
+            if (Entries[Pixel + Tap].W > 0.0f)
+            {
+                ++Count;
+                break;
+            }
+        }
+    }
+    return Count;
+}
+
+FRDGBufferRef FOmniCaptureRemapTable::RegisterBuffer(FRDGBuilder& GraphBuilder) const
+{
+    check(IsInRenderingThread());
+
+    if (PooledBuffer.IsValid())
+    {
+        return GraphBuilder.RegisterExternalBuffer(PooledBuffer);
+    }
+
+    // The table outlives the graph (callers hold a reference), so the upload can skip the copy.
+    FRDGBufferRef Buffer = CreateStructuredBuffer(
+        GraphBuilder,
+        TEXT("OmniCapture.RemapTable"),
+        sizeof(FVector4f),
+        Entries.Num(),
+        Entries.GetData(),
+        Entries.Num() * sizeof(FVector4f),
+        ERDGInitialDataFlags::NoCopy);
+    PooledBuffer = GraphBuilder.ConvertToExternalBuffer(Buffer);
+    return Buffer;
+}
+
+FOmniCaptureFaceCoverage FOmniCaptureFaceCoverage::Full(int32 InFaceResolution)
+{
+    FOmniCaptureFaceCoverage Coverage;
+    Coverage.FaceResolution = InFaceResolution;
+    for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+    {
+        Coverage.FaceSizes[FaceIndex] = InFaceResolution;
+        Coverage.Rects[FaceIndex] = FIntRect(0, 0, InFaceResolution, InFaceResolution);
+    }
+    return Coverage;
+}
+
+float FOmniCaptureFaceCoverage::GetRenderedFraction() const
+{
+    if (FaceResolution <= 0)
+    {
+        return 0.0f;
+    }
+
+    int64 Rendered = 0;
+    for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+    {
+        Rendered += IsFaceUsed(FaceIndex) ? static_cast<int64>(Rects[FaceIndex].Area()) : 0;
+    }
+    return static_cast<float>(static_cast<double>(Rendered) / (6.0 * FaceResolution * FaceResolution));
+}
+
+bool FOmniCaptureCubemapPixels::IsValid() const
+{
+    if (Resolution <= 0)
+    {
+        return false;
+    }
+
+    for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+    {
+        const int32 FaceResolution = GetFaceResolution(FaceIndex);
+        if (FaceResolution <= 0 || Faces[FaceIndex].Num() != FaceResolution * FaceResolution)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FOmniCaptureProjectionRemap::SupportsProjection(EOmniCaptureProjection Projection)
+{
+    return Projection == EOmniCaptureProjection::Cylindrical
+        || Projection == EOmniCaptureProjection::FullDome
+        || Projection == EOmniCaptureProjection::SphericalMirror
+        || IsCubemapLayout(Projection)
+        || Projection == EOmniCaptureProjection::FoveatedEquirectangular;
+}
+
+bool FOmniCaptureProjectionRemap::IsCubemapLayout(EOmniCaptureProjection Projection)
+{
+    return Projection == EOmniCaptureProjection::Cubemap || Projection == EOmniCaptureProjection::EquiAngularCubemap;
+}
+
+int32 FOmniCaptureProjectionRemap::GetTableSamplesPerAxis(const FOmniCaptureProjectionParams& Params, const FIntPoint& EyeSize)
+{
+    if (IsCubemapLayout(Params.Projection) || Params.Projection == EOmniCaptureProjection::FoveatedEquirectangular)
+    {
+        return 1;
+    }
+
+    int32 SamplesPerAxis = FMath::Clamp(Params.SamplesPerAxis, 1, GMaxRemapSamplesPerAxis);
+    while (SamplesPerAxis > 1 && GetTableBytes(EyeSize, SamplesPerAxis) > MaxTableBytes)
+    {
+        --SamplesPerAxis;
+    }
+    return SamplesPerAxis;
+}
+
+FOmniCaptureInverseMapping FOmniCaptureProjectionRemap::GetInverseMapping(EOmniCaptureProjection Projection)
+{
+    switch (Projection)
+    {
+    case EOmniCaptureProjection::Cylindrical:
+        return &DirectionFromCylindrical;
+    case EOmniCaptureProjection::FullDome:
+        return &DirectionFromFullDome;
+    case EOmniCaptureProjection::SphericalMirror:
+        return &DirectionFromSphericalMirror;
+    case EOmniCaptureProjection::Cubemap:
+    case EOmniCaptureProjection::EquiAngularCubemap:
+        return &DirectionFromCubemap;
+    case EOmniCaptureProjection::Equirectangular:
+    case EOmniCaptureProjection::FoveatedEquirectangular:
+        return &DirectionFromEquirect;
+    case EOmniCaptureProjection::Fisheye:
+        return &DirectionFromFisheye;
+    default:
+        return nullptr;
+    }
+}
+
+bool FOmniCaptureProjectionRemap::DirectionFromEquirect(const FVector2D& UV, const FOmniCaptureProjectionParams& Params, FVector& OutDirection)
+{
+    const double Longitude = (UV.X * 2.0 - 1.0) * Params.HorizontalFovRadians * 0.5;
+    const double Latitude = (0.5 - UV.Y) * Params.VerticalFovRadians;
+    const double CosLat = FMath::Cos(Latitude);
+    OutDirection = FVector(CosLat * FMath::Cos(Longitude), FMath::Sin(Latitude), CosLat * FMath::Sin(Longitude));
+    return true;
+}
+
+bool FOmniCaptureProjectionRemap::DirectionFromCylindrical(const FVector2D& UV, const FOmniCaptureProjectionParams& Params, FVector& OutDirection)
+{
+    // Longitude is linear across the width; height is linear on the cylinder wall (tan of latitude).
+    const double Longitude = (UV.X * 2.0 - 1.0) * Params.HorizontalFovRadians * 0.5;
+    const double HalfVertical = FMath::Clamp(static_cast<double>(Params.VerticalFovRadians) * 0.5, 0.01, HALF_PI - 0.01);
+    const double Height = (1.0 - UV.Y * 2.0) * FMath::Tan(HalfVertical);
+    OutDirection = FVector(FMath::Cos(Longitude), Height, FMath::Sin(Longitude)).GetSafeNormal();
+    return true;
+}
+
+bool FOmniCaptureProjectionRemap::DirectionFromFullDome(const FVector2D& UV, const FOmniCaptureProjectionParams& Params, FVector& OutDirection)
+{
+    // Azimuthal equidistant dome master: zenith at the centre, forward at the top edge.
+    const FVector2D Point(UV.X * 2.0 - 1.0, 1.0 - UV.Y * 2.0);
+    const double Radius = Point.Size();
+    if (Radius > 1.0)
+    {
+        return false;
+    }
+
+    const double Theta = Radius * Params.HorizontalFovRadians * 0.5;
+    const double SinTheta = FMath::Sin(Theta);
+    const FVector2D Azimuth = Radius > UE_DOUBLE_SMALL_NUMBER ? Point / Radius : FVector2D::ZeroVector;
+    const FVector Local(SinTheta * Azimuth.Y, FMath::Cos(Theta), SinTheta * Azimuth.X);
+
+    // Positive tilt leans the zenith towards the front of the dome.
+    const double CosTilt = FMath::Cos(Params.TiltRadians);
+    const double SinTilt = FMath::Sin(Params.TiltRadians);
+    OutDirection = FVector(Local.X * CosTilt + Local.Y * SinTilt, Local.Y * CosTilt - Local.X * SinTilt, Local.Z).GetSafeNormal();
+    return true;
+}
+
+bool FOmniCaptureProjectionRemap::DirectionFromSphericalMirror(const FVector2D& UV, const FOmniCaptureProjectionParams& Params, FVector& OutDirection)
+{
+    // Unit dome around the viewer, mirror behind the viewer, projector between them facing the mirror.
+    // Each projector ray is reflected off the mirror and the dome hit point gives the view direction.
+    const FVector MirrorCenter(-Params.MirrorOffset, 0.0, 0.0);
+    const FVector ProjectorOrigin = MirrorCenter + FVector(Params.ProjectorDistance, 0.0, 0.0);
+
+    const double TanHalfVertical = FMath::Tan(FMath::Asin(FMath::Clamp(static_cast<double>(Params.MirrorRadius) / Params.ProjectorDistance, 0.0, 0.999)));
+    const double TanHalfHorizontal = TanHalfVertical * Params.AspectRatio;
+    const FVector Ray = FVector(-1.0, (1.0 - UV.Y * 2.0) * TanHalfVertical, (UV.X * 2.0 - 1.0) * TanHalfHorizontal).GetSafeNormal();
+
+    const FVector ToProjector = ProjectorOrigin - MirrorCenter;
+    const double B = FVector::DotProduct(ToProjector, Ray);
+    const double C = ToProjector.SizeSquared() - FMath::Square(Params.MirrorRadius);
+    const double Discriminant = B * B - C;
+    if (Discriminant < 0.0)
+    {
+        return false;
+    }
+
+    const double HitDistance = -B - FMath::Sqrt(Discriminant);
+    if (HitDistance <= 0.0)
+    {
+        return false;
+    }
+
+    const FVector Hit = ProjectorOrigin + Ray * HitDistance;
+    const FVector Normal = (Hit - MirrorCenter) / Params.MirrorRadius;
+    const FVector Reflected = Ray - 2.0 * FVector::DotProduct(Ray, Normal) * Normal;
+
+    const double DomeB = FVector::DotProduct(Hit, Reflected);
+    const double DomeC = Hit.SizeSquared() - 1.0;
+    if (DomeC >= 0.0)
+    {
+        return false;
+    }
+
+    const FVector DomePoint = Hit + Reflected * (-DomeB + FMath::Sqrt(DomeB * DomeB - DomeC));
+    OutDirection = DomePoint.GetSafeNormal();
+    return true;
+}
+
+bool FOmniCaptureProjectionRemap::DirectionFromFisheye(const FVector2D& UV, const FOmniCaptureProjectionParams& Params, FVector& OutDirection)
+{
+    // Equidistant fisheye looking down +X, matching OmniFisheyeCS.
+    const FVector2D Point(UV.X * 2.0 - 1.0, 1.0 - UV.Y * 2.0);
+    const double Radius = Point.Size();
+    if (Radius > 1.0)
+    {
+        return false;
+    }
+
+    const double Theta = Radius * FMath::Clamp(static_cast<double>(Params.HorizontalFovRadians) * 0.5, 0.0, static_cast<double>(PI));
+    const double Phi = FMath::Atan2(Point.Y, Point.X);
+    const double SinTheta = FMath::Sin(Theta);
+    OutDirection = FVector(FMath::Cos(Theta), SinTheta * FMath::Sin(Phi), SinTheta * FMath::Cos(Phi)).GetSafeNormal();
+    return true;
+}
+
+bool FOmniCaptureProjectionRemap::DirectionFromCubemap(const FVector2D& UV, const FOmniCaptureProjectionParams& Params, FVector& OutDirection)
+{
+    int32 FaceIndex = 0;
+    FVector2f FaceUV;
+    AtlasToCubeFace(UV, Params.Projection == EOmniCaptureProjection::EquiAngularCubemap, FaceIndex, FaceUV);
+    OutDirection = CubeFaceToDirection(FaceIndex, FaceUV);
+    return true;
+}
+
+void FOmniCaptureProjectionRemap::AtlasToCubeFace(const FVector2D& UV, bool bEquiAngular, int32& OutFaceIndex, FVector2f& OutFaceUV)
+{
+    const int32 Column = FMath::Clamp(FMath::FloorToInt(UV.X * 3.0), 0, 2);
+    const int32 Row = FMath::Clamp(FMath::FloorToInt(UV.Y * 2.0), 0, 1);
+    const FAtlasSlot& Slot = (bEquiAngular ? GEquiAngularSlots : GCubemapSlots)[Row * 3 + Column];
+
+    FVector2D SlotUV(UV.X * 3.0 - Column, UV.Y * 2.0 - Row);
+    if (bEquiAngular)
+    {
+        // EAC stores equal angles per texel: face coordinate = tan(angle), angle linear in the slot.
+        SlotUV.X = (FMath::Tan((SlotUV.X * 2.0 - 1.0) * (PI * 0.25)) + 1.0) * 0.5;
+        SlotUV.Y = (FMath::Tan((SlotUV.Y * 2.0 - 1.0) * (PI * 0.25)) + 1.0) * 0.5;
+    }
+
+    FVector2D FaceUV = SlotUV;
+    switch (Slot.ClockwiseQuarterTurns)
+    {
+    case 1: FaceUV = FVector2D(SlotUV.Y, 1.0 - SlotUV.X); break;
+    case 2: FaceUV = FVector2D(1.0 - SlotUV.X, 1.0 - SlotUV.Y); break;
+    case 3: FaceUV = FVector2D(1.0 - SlotUV.Y, SlotUV.X); break;
+    default: break;
+    }
+
+    OutFaceIndex = Slot.FaceIndex;
+    OutFaceUV = FVector2f(
+        static_cast<float>(FMath::Clamp(FaceUV.X, 0.0, 1.0)),
+        static_cast<float>(FMath::Clamp(FaceUV.Y, 0.0, 1.0)));
+}
+
+void FOmniCaptureProjectionRemap::DirectionToCubeFace(const FVector& Direction, int32 FaceResolution, float SeamStrength, int32& OutFaceIndex, FVector2f& OutUV)
+{
+    const FVector AbsDir = Direction.GetAbs();
+    FVector2D FaceUV;
+
+    if (AbsDir.X >= AbsDir.Y && AbsDir.X >= AbsDir.Z)
+    {
+        OutFaceIndex = Direction.X > 0.0 ? 0 : 1;
+        FaceUV = Direction.X > 0.0 ? FVector2D(-Direction.Z, Direction.Y) : FVector2D(Direction.Z, Direction.Y);
+        FaceUV /= AbsDir.X;
+    }
+    else if (AbsDir.Y >= AbsDir.X && AbsDir.Y >= AbsDir.Z)
+    {
+        OutFaceIndex = Direction.Y > 0.0 ? 2 : 3;
+        FaceUV = Direction.Y > 0.0 ? FVector2D(Direction.X, -Direction.Z) : FVector2D(Direction.X, Direction.Z);
+        FaceUV /= AbsDir.Y;
+    }
+    else
+    {
+        OutFaceIndex = Direction.Z > 0.0 ? 4 : 5;
+        FaceUV = Direction.Z > 0.0 ? FVector2D(Direction.X, Direction.Y) : FVector2D(-Direction.X, Direction.Y);
+        FaceUV /= AbsDir.Z;
+    }
+
+    FaceUV = (FaceUV + FVector2D(1.0, 1.0)) * 0.5;
+
+    const double Resolution = static_cast<double>(FMath::Max(1, FaceResolution));
+    const double Scale = FMath::Lerp(1.0, (Resolution - 1.0) / Resolution, static_cast<double>(SeamStrength));
+    const double Bias = (0.5 / Resolution) * SeamStrength;
+    OutUV = FVector2f(
+        static_cast<float>(FMath::Clamp(FaceUV.X * Scale + Bias, 0.0, 1.0)),
+        static_cast<float>(FMath::Clamp(FaceUV.Y * Scale + Bias, 0.0, 1.0)));
+}
+
+FVector FOmniCaptureProjectionRemap::CubeFaceToDirection(int32 FaceIndex, const FVector2f& UV)
+{
+    const double U = UV.X * 2.0 - 1.0;
+    const double V = UV.Y * 2.0 - 1.0;
+
+    FVector Direction;
+    switch (FaceIndex)
+    {
+    case 0: Direction = FVector(1.0, V, -U); break;
+    case 1: Direction = FVector(-1.0, V, U); break;
+    case 2: Direction = FVector(U, 1.0, -V); break;
+    case 3: Direction = FVector(U, -1.0, V); break;
+    case 4: Direction = FVector(U, V, 1.0); break;
+    default: Direction = FVector(-U, V, -1.0); break;
+    }
+    return Direction.GetSafeNormal();
+}
+
+TSharedRef<const FOmniCaptureRemapTable> FOmniCaptureProjectionRemap::BuildTable(const FOmniCaptureProjectionParams& Params, const FIntPoint& EyeSize, int32 FaceResolution, float SeamStrength)
+{
+    TSharedRef<FOmniCaptureRemapTable> Table = MakeShared<FOmniCaptureRemapTable>();
+    Table->Size = FIntPoint(FMath::Max(1, EyeSize.X), FMath::Max(1, EyeSize.Y));
+    Table->FaceResolution = FaceResolution;
+    Table->Key = MakeTableKey(Params, EyeSize, FaceResolution, SeamStrength);
+    const int32 SamplesPerAxis = GetTableSamplesPerAxis(Params, Table->Size);
+    Table->TapsPerPixel = SamplesPerAxis * SamplesPerAxis;
+
+    const int32 RequestedSamplesPerAxis = FMath::Clamp(Params.SamplesPerAxis, 1, GMaxRemapSamplesPerAxis);
+    if (SamplesPerAxis < RequestedSamplesPerAxis && !IsCubemapLayout(Params.Projection) && Params.Projection != EOmniCaptureProjection::FoveatedEquirectangular)
+    {
+        UE_LOG(LogOmniCaptureRemap, Warning, TEXT("A %dx%d remap table with %dx%d sub-samples needs %.1f MB; using %dx%d to stay within %.0f MB."),
+            Table->Size.X, Table->Size.Y, RequestedSamplesPerAxis, RequestedSamplesPerAxis, GetTableBytes(Table->Size, RequestedSamplesPerAxis) / (1024.0 * 1024.0),
+            SamplesPerAxis, SamplesPerAxis, MaxTableBytes / (1024.0 * 1024.0));
+    }
+
+    const int64 EntryCount = static_cast<int64>(Table->Size.X) * Table->Size.Y * Table->TapsPerPixel;
+    if (EntryCount > MAX_int32)
+    {
+        UE_LOG(LogOmniCaptureRemap, Error, TEXT("A %dx%d remap table has too many entries to allocate; the output stays empty."), Table->Size.X, Table->Size.Y);
+        Table->Size = FIntPoint::ZeroValue;
+        return Table;
+    }
+    Table->Entries.SetNumZeroed(static_cast<int32>(EntryCount));
+
+    const FOmniCaptureInverseMapping InverseMapping = GetInverseMapping(Params.Projection);
+    if (!InverseMapping)
+    {
+        return Table;
+    }
+
+    const int32 Width = Table->Size.X;
+    const int32 Height = Table->Size.Y;
+    FVector4f* Entries = Table->Entries.GetData();
+
+    if (IsCubemapLayout(Params.Projection))
+    {
+        // Atlas texels land on face texel centres, so the raw layout is an exact copy and no seam inset is wanted.
+        const bool bEquiAngular = Params.Projection == EOmniCaptureProjection::EquiAngularCubemap;
+        ParallelFor(Height, [=](int32 Y)
+        {
+            for (int32 X = 0; X < Width; ++X)
+            {
+                int32 FaceIndex = 0;
+                FVector2f FaceUV;
+                AtlasToCubeFace(FVector2D((X + 0.5) / Width, (Y + 0.5) / Height), bEquiAngular, FaceIndex, FaceUV);
+                Entries[Y * Width + X] = FVector4f(FaceUV.X, FaceUV.Y, static_cast<float>(FaceIndex), 1.0f);
+            }
+        });
+        return Table;
+    }
+
+    if (Params.Projection == EOmniCaptureProjection::FoveatedEquirectangular)
+    {
+        // Each packed pixel samples the centre of the source span it stands for.
+        const FOmniCaptureFoveatedLayout Layout = FOmniCaptureFoveatedLayout::Build(Params.FoveatedSourceSize, Params.FoveationStartLatitude, Params.FoveationLevels);
+        const int32 SourceHeight = Layout.SourceSize.Y;
+        ParallelFor(Height, [=, &Layout, &Params](int32 Y)
+        {
+            for (int32 X = 0; X < Width; ++X)
+            {
+                int32 SourceRow = 0;
+                double U = 0.0;
+                if (!Layout.ResolveOutputPixel(X, Y, SourceRow, U))
+                {
+                    continue;
+                }
+
+                FVector Direction;
+                DirectionFromEquirect(FVector2D(U, (SourceRow + 0.5) / SourceHeight), Params, Direction);
+
+                int32 FaceIndex = 0;
+                FVector2f FaceUV;
+                DirectionToCubeFace(Direction, FaceResolution, SeamStrength, FaceIndex, FaceUV);
+                Entries[Y * Width + X] = FVector4f(FaceUV.X, FaceUV.Y, static_cast<float>(FaceIndex), 1.0f);
+            }
+        });
+        return Table;
+    }
+
+    // Sub-samples sit on a regular grid inside the pixel. Weights follow each cell's solid angle, scaled by the
+    // fraction of cells that hit the image, so pixels cut by an image-circle edge fade out instead of stair-stepping.
+    const int32 TapsPerPixel = Table->TapsPerPixel;
+    const double SubStep = 1.0 / SamplesPerAxis;
+    ParallelFor(Height, [=, &Params](int32 Y)
+    {
+        double SolidAngles[GMaxRemapSamplesPerAxis * GMaxRemapSamplesPerAxis];
+        for (int32 X = 0; X < Width; ++X)
+        {
+            FVector4f* PixelTaps = Entries + (Y * Width + X) * TapsPerPixel;
+            int32 ValidTaps = 0;
+            int32 KnownTaps = 0;
+            double KnownSolidAngle = 0.0;
+
+            for (int32 Tap = 0; Tap < TapsPerPixel; ++Tap)
+            {
+                SolidAngles[Tap] = 0.0;
+                const FVector2D UV((X + ((Tap % SamplesPerAxis) + 0.5) * SubStep) / Width, (Y + ((Tap / SamplesPerAxis) + 0.5) * SubStep) / Height);
+                FVector Direction;
+                if (!ResolveDirection(InverseMapping, Params, UV, Direction))
+                {
+                    continue;
+                }
+
+                int32 FaceIndex = 0;
+                FVector2f FaceUV;
+                DirectionToCubeFace(Direction, FaceResolution, SeamStrength, FaceIndex, FaceUV);
+                PixelTaps[Tap] = FVector4f(FaceUV.X, FaceUV.Y, static_cast<float>(FaceIndex), 0.0f);
+                ++ValidTaps;
+
+                SolidAngles[Tap] = TapsPerPixel > 1 ? EstimateSolidAngle(InverseMapping, Params, UV, Direction, SubStep / Width, SubStep / Height) : 1.0;
+                if (SolidAngles[Tap] > 0.0)
+                {
+                    KnownSolidAngle += SolidAngles[Tap];
+                    ++KnownTaps;
+                }
+            }
+
+            if (ValidTaps == 0)
+            {
+                continue;
+            }
+
+            // Cells whose neighbours left the image borrow the mean of the others.
+            const double FallbackSolidAngle = KnownTaps > 0 ? KnownSolidAngle / KnownTaps : 1.0;
+            double TotalSolidAngle = 0.0;
+            for (int32 Tap = 0; Tap < TapsPerPixel; ++Tap)
+            {
+                if (SolidAngles[Tap] != 0.0)
+                {
+                    SolidAngles[Tap] = SolidAngles[Tap] > 0.0 ? SolidAngles[Tap] : FallbackSolidAngle;
+                    TotalSolidAngle += SolidAngles[Tap];
+                }
+            }
+
+            const double Scale = static_cast<double>(ValidTaps) / (TapsPerPixel * TotalSolidAngle);
+            for (int32 Tap = 0; Tap < TapsPerPixel; ++Tap)
+            {
+                if (SolidAngles[Tap] != 0.0)
+                {
+                    PixelTaps[Tap].W = static_cast<float>(SolidAngles[Tap] * Scale);
+                }
+            }
+        }
+    });
+
+    return Table;
+}
+
+TSharedRef<const FOmniCaptureRemapTable> FOmniCaptureProjectionRemap::FindOrBuildTable(const FOmniCaptureProjectionParams& Params, const FIntPoint& EyeSize, int32 FaceResolution, float SeamStrength)
+{
+    const uint32 Key = MakeTableKey(Params, EyeSize, FaceResolution, SeamStrength);
+    {
+        FScopeLock Lock(&GRemapTableCacheCS);
+        for (int32 Index = 0; Index < GRemapTableCache.Num(); ++Index)
+        {
+            if (GRemapTableCache[Index]->Key == Key && GRemapTableCache[Index]->Size == EyeSize)
+            {
+                TSharedRef<const FOmniCaptureRemapTable> Found = GRemapTableCache[Index];
+                GRemapTableCache.RemoveAt(Index, 1, EAllowShrinking::No);
+                GRemapTableCache.Add(Found);
+                return Found;
+            }
+        }
+    }
+
+    TSharedRef<const FOmniCaptureRemapTable> Table = BuildTable(Params, EyeSize, FaceResolution, SeamStrength);
+
+    FScopeLock Lock(&GRemapTableCacheCS);
+    int64 CachedBytes = Table->GetAllocatedBytes();
+    for (const TSharedRef<const FOmniCaptureRemapTable>& Cached : GRemapTableCache)
+    {
+        CachedBytes += Cached->GetAllocatedBytes();
+    }
+    while (GRemapTableCache.Num() > 0 && (GRemapTableCache.Num() >= GMaxCachedRemapTables || CachedBytes > GMaxCachedRemapTableBytes))
+    {
+        CachedBytes -= GRemapTableCache[0]->GetAllocatedBytes();
+        GRemapTableCache.RemoveAt(0);
+    }
+    GRemapTableCache.Add(Table);
+    return Table;
+}
+
+void FOmniCaptureProjectionRemap::ComputeFaceResolutions(const FOmniCaptureProjectionParams& Params, const FIntPoint& EyeSize, int32 FaceResolution, float DensityScale, int32 (&OutFaceSizes)[6])
+{
+    for (int32& FaceSize : OutFaceSizes)
+    {
+        FaceSize = FaceResolution;
+    }
+
+    const FOmniCaptureInverseMapping InverseMapping = GetInverseMapping(Params.Projection);
+    if (!InverseMapping || FaceResolution <= 0 || DensityScale <= 0.0f || IsCubemapLayout(Params.Projection))
+    {
+        return;
+    }
+
+    const bool bFoveated = Params.Projection == EOmniCaptureProjection::FoveatedEquirectangular;
+    const FIntPoint SampleSize = bFoveated ? Params.FoveatedSourceSize : EyeSize;
+    const int32 Width = FMath::Max(1, SampleSize.X);
+    const int32 Height = FMath::Max(1, SampleSize.Y);
+
+    auto ResolvePixel = [&Params, InverseMapping, Width, Height, FaceResolution](int32 X, int32 Y, int32& OutFaceIndex, FVector2f& OutUV)
+    {
+        const FVector2D UV((X + 0.5) / Width, (Y + 0.5) / Height);
+        FVector Direction;
+        if (!ResolveDirection(InverseMapping, Params, UV, Direction))
+        {
+            return false;
+        }
+
+        DirectionToCubeFace(Direction, FaceResolution, 0.0f, OutFaceIndex, OutUV);
+        return true;
+    };
+
+    // Texels per face UV unit needed at the densest point of each face.
+    double Density[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    FCriticalSection DensityCS;
+
+    ParallelFor(Height, [&](int32 Y)
+    {
+        double RowDensity[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+        for (int32 X = 0; X < Width; ++X)
+        {
+            int32 FaceIndex = 0;
+            FVector2f UV;
+            if (!ResolvePixel(X, Y, FaceIndex, UV))
+            {
+                continue;
+            }
+
+            // Largest step to a neighbouring output pixel on the same face; seams between faces are skipped.
+            float Footprint = 0.0f;
+            int32 NeighbourFace = 0;
+            FVector2f NeighbourUV;
+            if (X + 1 < Width && ResolvePixel(X + 1, Y, NeighbourFace, NeighbourUV) && NeighbourFace == FaceIndex)
+            {
+                Footprint = FMath::Max(Footprint, (NeighbourUV - UV).Size());
+            }
+            if (Y + 1 < Height && ResolvePixel(X, Y + 1, NeighbourFace, NeighbourUV) && NeighbourFace == FaceIndex)
+            {
+                Footprint = FMath::Max(Footprint, (NeighbourUV - UV).Size());
+            }
+
+            if (Footprint > UE_SMALL_NUMBER)
+            {
+                RowDensity[FaceIndex] = FMath::Max(RowDensity[FaceIndex], 1.0 / Footprint);
+            }
+        }
+
+        FScopeLock Lock(&DensityCS);
+        for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+        {
+            Density[FaceIndex] = FMath::Max(Density[FaceIndex], RowDensity[FaceIndex]);
+        }
+    });
+
+    const int32 MinFaceSize = FMath::Min(FaceResolution, GMinAdaptiveFaceSize);
+    for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+    {
+        if (Density[FaceIndex] <= 0.0)
+        {
+            continue;
+        }
+
+        const int32 Needed = FMath::CeilToInt(Density[FaceIndex] * DensityScale);
+        const int32 Aligned = FMath::DivideAndRoundUp(Needed, GAdaptiveFaceAlignment) * GAdaptiveFaceAlignment;
+        OutFaceSizes[FaceIndex] = FMath::Clamp(Aligned, MinFaceSize, FaceResolution);
+    }
+}
+
+FOmniCaptureFaceCoverage FOmniCaptureProjectionRemap::ComputeFaceCoverage(const FOmniCaptureProjectionParams& Params, const FIntPoint& EyeSize, int32 FaceResolution, float SeamStrength, float DensityScale)
+{
+    const FOmniCaptureInverseMapping InverseMapping = GetInverseMapping(Params.Projection);
+    if (!InverseMapping || FaceResolution <= 0 || IsCubemapLayout(Params.Projection))
+    {
+        return FOmniCaptureFaceCoverage::Full(FaceResolution);
+    }
+
+    // Foveated rows sample a subset of the source equirect, so the source coverage is a safe superset.
+    const bool bFoveated = Params.Projection == EOmniCaptureProjection::FoveatedEquirectangular;
+    const FIntPoint SampleSize = bFoveated ? Params.FoveatedSourceSize : EyeSize;
+    const int32 Width = FMath::Max(1, SampleSize.X);
+    const int32 Height = FMath::Max(1, SampleSize.Y);
+
+    const uint32 Key = HashCombine(MakeTableKey(Params, EyeSize, FaceResolution, SeamStrength), ::GetTypeHash(DensityScale));
+    {
+        FScopeLock Lock(&GRemapTableCacheCS);
+        if (GLastFaceCoverage.IsSet() && GLastFaceCoverage->Key == Key)
+        {
+            return GLastFaceCoverage->Value;
+        }
+    }
+
+    FOmniCaptureFaceCoverage Coverage;
+    Coverage.FaceResolution = FaceResolution;
+    ComputeFaceResolutions(Params, EyeSize, FaceResolution, DensityScale, Coverage.FaceSizes);
+    const int32* FaceSizes = Coverage.FaceSizes;
+
+    // Inclusive texel bounds while accumulating; Min > Max marks an untouched face.
+    FIntRect Bounds[6];
+    for (FIntRect& Rect : Bounds)
+    {
+        Rect = FIntRect(MAX_int32, MAX_int32, MIN_int32, MIN_int32);
+    }
+    FCriticalSection BoundsCS;
+
+    // Every tap of a supersampled table counts, so walk the same sub-sample grid as BuildTable.
+    const int32 SamplesPerAxis = GetTableSamplesPerAxis(Params, EyeSize);
+    const int32 SampleCount = Width * SamplesPerAxis;
+
+    ParallelFor(Height * SamplesPerAxis, [&, Width, Height, FaceResolution, SeamStrength, FaceSizes, SamplesPerAxis, SampleCount](int32 SampleRow)
+    {
+        FIntRect RowBounds[6];
+        for (FIntRect& Rect : RowBounds)
+        {
+            Rect = FIntRect(MAX_int32, MAX_int32, MIN_int32, MIN_int32);
+        }
+
+        for (int32 Sample = 0; Sample < SampleCount; ++Sample)
+        {
+            const FVector2D UV((Sample + 0.5) / (Width * SamplesPerAxis), (SampleRow + 0.5) / (Height * SamplesPerAxis));
+            FVector Direction;
+            if (!ResolveDirection(InverseMapping, Params, UV, Direction))
+            {
+                continue;
+            }
+
+            int32 FaceIndex = 0;
+            FVector2f FaceUV;
+            DirectionToCubeFace(Direction, FaceResolution, SeamStrength, FaceIndex, FaceUV);
+
+            // Both bilinear taps in the face's own texels, clamped like AM_Clamp.
+            const int32 FaceSize = FaceSizes[FaceIndex];
+            const int32 TexelX = FMath::FloorToInt(FaceUV.X * FaceSize - 0.5f);
+            const int32 TexelY = FMath::FloorToInt(FaceUV.Y * FaceSize - 0.5f);
+            FIntRect& Rect = RowBounds[FaceIndex];
+            Rect.Min.X = FMath::Min(Rect.Min.X, FMath::Clamp(TexelX, 0, FaceSize - 1));
+            Rect.Min.Y = FMath::Min(Rect.Min.Y, FMath::Clamp(TexelY, 0, FaceSize - 1));
+            Rect.Max.X = FMath::Max(Rect.Max.X, FMath::Clamp(TexelX + 1, 0, FaceSize - 1));
+            Rect.Max.Y = FMath::Max(Rect.Max.Y, FMath::Clamp(TexelY + 1, 0, FaceSize - 1));
+        }
+
+        FScopeLock Lock(&BoundsCS);
+        for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+        {
+            Bounds[FaceIndex].Min = Bounds[FaceIndex].Min.ComponentMin(RowBounds[FaceIndex].Min);
+            Bounds[FaceIndex].Max = Bounds[FaceIndex].Max.ComponentMax(RowBounds[FaceIndex].Max);
+        }
+    });
+
+    for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+    {
+        const FIntRect& Rect = Bounds[FaceIndex];
+        if (Rect.Min.X > Rect.Max.X || Rect.Min.Y > Rect.Max.Y)
+        {
+            continue;
+        }
+
+        const int32 FaceSize = Coverage.FaceSizes[FaceIndex];
+        Coverage.Rects[FaceIndex] = FIntRect(
+            FMath::Max(0, Rect.Min.X - GCoverageMarginTexels),
+            FMath::Max(0, Rect.Min.Y - GCoverageMarginTexels),
+            FMath::Min(FaceSize, Rect.Max.X + 1 + GCoverageMarginTexels),
+            FMath::Min(FaceSize, Rect.Max.Y + 1 + GCoverageMarginTexels));
+    }
+
+    FScopeLock Lock(&GRemapTableCacheCS);
+    GLastFaceCoverage.Emplace(Key, Coverage);
+    return Coverage;
+}
+
+void FOmniCaptureProjectionRemap::GetConverterParams(const FOmniCaptureSettings& Settings, FOmniCaptureProjectionParams& OutParams, FIntPoint& OutEyeSize)
+{
+    if (SupportsProjection(Settings.Projection))
+    {
+        OutParams = FOmniCaptureProjectionParams::FromSettings(Settings);
+        OutEyeSize = Settings.GetPerEyeOutputResolution();
+        return;
+    }
+
+    // The legacy converters take their geometry straight from the settings; mirror their parameters.
+    OutParams = FOmniCaptureProjectionParams();
+    OutParams.bCullRearHemisphere = Settings.IsVR180();
+
+    if (Settings.IsFisheye() && !Settings.ShouldConvertFisheyeToEquirect())
+    {
+        OutParams.Projection = EOmniCaptureProjection::Fisheye;
+        OutParams.HorizontalFovRadians = FMath::DegreesToRadians(FMath::Clamp(Settings.FisheyeFOV, 0.0f, 360.0f));
+        OutParams.SamplesPerAxis = Settings.GetRemapSamplesPerAxis();
+        OutEyeSize = Settings.GetFisheyeResolution();
+        return;
+    }
+
+    OutParams.Projection = EOmniCaptureProjection::Equirectangular;
+    OutParams.SamplesPerAxis = Settings.GetRemapSamplesPerAxis();
+    OutParams.HorizontalFovRadians = Settings.GetLongitudeSpanRadians() * 2.0f;
+    OutParams.VerticalFovRadians = Settings.GetLatitudeSpanRadians() * 2.0f;
+    OutParams.PolarStrength = Settings.PolarDampening;
+
+    OutEyeSize = Settings.GetEquirectResolution();
+    if (Settings.IsStereo())
+    {
+        if (Settings.StereoLayout == EOmniCaptureStereoLayout::SideBySide)
+        {
+            OutEyeSize.X /= 2;
+        }
+        else
+        {
+            OutEyeSize.Y /= 2;
+        }
+    }
+}
+
+FOmniCaptureFaceCoverage FOmniCaptureProjectionRemap::ComputeFaceCoverage(const FOmniCaptureSettings& Settings)
+{
+    if (Settings.IsPlanar() || Settings.Resolution <= 0)
+    {
+        return FOmniCaptureFaceCoverage::Full(Settings.Resolution);
+    }
+
+    FOmniCaptureProjectionParams Params;
+    FIntPoint EyeSize;
+    GetConverterParams(Settings, Params, EyeSize);
+    const float DensityScale = Settings.bAdaptiveFaceResolution ? FMath::Clamp(Settings.AdaptiveFaceDensityScale, 0.5f, 4.0f) : 0.0f;
+    return ComputeFaceCoverage(Params, EyeSize, Settings.Resolution, Settings.SeamBlend, DensityScale);
+}
+
+FLinearColor FOmniCaptureProjectionRemap::SampleBilinear(const FOmniCaptureCubemapPixels& Cubemap, int32 FaceIndex, const FVector2f& UV)
+{
+    return FBilinearFootprint(Cubemap, FaceIndex, UV).Sample(Cubemap);
+}
+
+void FOmniCaptureProjectionRemap::RemapCPU(const FOmniCaptureRemapTable& Table, const FOmniCaptureCubemapPixels& Cubemap, TArrayView<FLinearColor> OutPixels, const FIntPoint& Offset, int32 RowStride)
+{
+    const int32 TapsPerPixel = FMath::Max(1, Table.TapsPerPixel);
+    if (!Cubemap.IsValid() || Table.Entries.Num() != Table.Size.X * Table.Size.Y * TapsPerPixel)
+    {
+        return;
+    }
+
+    check(RowStride >= Offset.X + Table.Size.X);
+    check(OutPixels.Num() >= (Offset.Y + Table.Size.Y) * RowStride);
+
+    const int32 Width = Table.Size.X;
+    FLinearColor* Output = OutPixels.GetData();
+    ParallelFor(Table.Size.Y, [&Table, &Cubemap, Output, Offset, RowStride, Width, TapsPerPixel](int32 Y)
+    {
+        const FVector4f* Row = Table.Entries.GetData() + Y * Width * TapsPerPixel;
+        FLinearColor* Destination = Output + (Offset.Y + Y) * RowStride + Offset.X;
+        for (int32 X = 0; X < Width; ++X)
+        {
+            const FVector4f* Taps = Row + X * TapsPerPixel;
+            FLinearColor Sum = FLinearColor::Transparent;
+            for (int32 Tap = 0; Tap < TapsPerPixel; ++Tap)
+            {
+                if (Taps[Tap].W > 0.0f)
+                {
+                    Sum += SampleBilinear(Cubemap, static_cast<int32>(Taps[Tap].Z), FVector2f(Taps[Tap].X, Taps[Tap].Y)) * Taps[Tap].W;
+                }
+            }
+            Destination[X] = Sum;
+        }
+    });
+}
+
+void FOmniCaptureProjectionRemap::RemapTargetsCPU(const FOmniCaptureRemapTable& Table, TConstArrayView<FOmniCaptureRemapTarget> Targets, int32 RowStride)
+{
+    const int32 TargetCount = Targets.Num();
+    const int32 TapsPerPixel = FMath::Max(1, Table.TapsPerPixel);
+    if (TargetCount == 0 || Table.Entries.Num() != Table.Size.X * Table.Size.Y * TapsPerPixel)
+    {
+        return;
+    }
+
+    bool bSharedFootprints = true;
+    for (const FOmniCaptureRemapTarget& Target : Targets)
+    {
+        bSharedFootprints &= Target.Cubemap && Target.Cubemap->IsValid() && HaveSameFaceSizes(*Targets[0].Cubemap, *Target.Cubemap);
+        check(RowStride >= Target.Offset.X + Table.Size.X);
+        check(Target.Pixels.Num() >= (Target.Offset.Y + Table.Size.Y) * RowStride);
+    }
+
+    // Targets that do not line up texel for texel cannot share footprints; remap them one by one.
+    if (!bSharedFootprints)
+    {
+        for (const FOmniCaptureRemapTarget& Target : Targets)
+        {
+            if (Target.Cubemap)
+            {
+                RemapCPU(Table, *Target.Cubemap, Target.Pixels, Target.Offset, RowStride);
+            }
+        }
+        return;
+    }
+
+    const int32 Width = Table.Size.X;
+    ParallelFor(Table.Size.Y, [&Table, &Targets, RowStride, Width, TapsPerPixel, TargetCount](int32 Y)
+    {
+        TArray<FLinearColor, TInlineAllocator<8>> Sums;
+        Sums.SetNumUninitialized(TargetCount);
+
+        const FVector4f* Row = Table.Entries.GetData() + Y * Width * TapsPerPixel;
+        for (int32 X = 0; X < Width; ++X)
+        {
+            for (FLinearColor& Sum : Sums)
+            {
+                Sum = FLinearColor::Transparent;
+            }
+
+            const FVector4f* Taps = Row + X * TapsPerPixel;
+            for (int32 Tap = 0; Tap < TapsPerPixel; ++Tap)
+            {
+                if (Taps[Tap].W <= 0.0f)
+                {
+                    continue;
+                }
+
+                const FBilinearFootprint Footprint(*Targets[0].Cubemap, static_cast<int32>(Taps[Tap].Z), FVector2f(Taps[Tap].X, Taps[Tap].Y));
+                for (int32 TargetIndex = 0; TargetIndex < TargetCount; ++TargetIndex)
+                {
+                    Sums[TargetIndex] += Footprint.Sample(*Targets[TargetIndex].Cubemap) * Taps[Tap].W;
+                }
+            }
+
+            for (int32 TargetIndex = 0; TargetIndex < TargetCount; ++TargetIndex)
+            {
+                const FOmniCaptureRemapTarget& Target = Targets[TargetIndex];
+                Target.Pixels[(Target.Offset.Y + Y) * RowStride + Target.Offset.X + X] = Sums[TargetIndex];
+            }
+        }
+    });
+}
+
+void FOmniCaptureProjectionRemap::RemapLayersCPU(const FOmniCaptureRemapTable& Table, TConstArrayView<const FOmniCaptureCubemapPixels*> Cubemaps, TConstArrayView<TArrayView<FLinearColor>> OutPixels, const FIntPoint& Offset, int32 RowStride)
+{
+    TArray<FOmniCaptureRemapTarget, TInlineAllocator<8>> Targets;
+    for (int32 Layer = 0; Layer < FMath::Min(Cubemaps.Num(), OutPixels.Num()); ++Layer)
+    {
+        Targets.Add({ Cubemaps[Layer], OutPixels[Layer], Offset });
+    }
+    RemapTargetsCPU(Table, Targets, RowStride);
+}
@@ -0,0 +1,186 @@
+#include "OmniCaptureQualityGovernor.h"
+
+namespace
+{
+    constexpr double RingOverloadedFill = 0.75;
+    constexpr double RingHeadroomFill = 0.25;
+    /** Share of the frame budget the game-thread stages may use before the governor counts it as headroom. */
+    constexpr double HeadroomBudgetFraction = 0.75;
+
+    constexpr int32 DegradedPNGCompressionLevel = 1;
+    constexpr int32 DegradedAuxiliaryPassInterval = 2;
+    constexpr float DegradedPreviewRateScale = 0.25f;
+
+    /** Stages that run on the game thread for every captured frame and therefore bound the capture rate. */
+    constexpr EOmniCaptureStage CaptureThreadStages[] =
+    {
+        EOmniCaptureStage::RigCapture,
+        EOmniCaptureStage::RenderFlush,
+        EOmniCaptureStage::Conversion,
+        EOmniCaptureStage::AuxiliaryPasses,
+        EOmniCaptureStage::Enqueue,
+        EOmniCaptureStage::Preview
+    };
+}
+
+const TCHAR* LexToString(EOmniCaptureQualityKnob Knob)
+{
+    switch (Knob)
+    {
+    case EOmniCaptureQualityKnob::PNGCompression: return TEXT("PNGCompression");
+    case EOmniCaptureQualityKnob::AuxiliaryPassRate: return TEXT("AuxiliaryPassRate");
+    case EOmniCaptureQualityKnob::PreviewRate: return TEXT("PreviewRate");
+    case EOmniCaptureQualityKnob::RemapSampling: return TEXT("RemapSampling");
+    case EOmniCaptureQualityKnob::FaceResolution: return TEXT("FaceResolution");
+    default: return TEXT("Unknown");
+    }
+}
+
+void FOmniCaptureQualityGovernor::Initialize(const FOmniCaptureSettings& Settings)
+{
+    Knobs.Reset();
+    if (Settings.OutputFormat == EOmniOutputFormat::ImageSequence && Settings.ImageFormat == EOmniCaptureImageFormat::PNG)
+    {
+        Knobs.Add(EOmniCaptureQualityKnob::PNGCompression);
+    }
+    if (Settings.AuxiliaryPasses.Num() > 0 && !Settings.IsPlanar() && Settings.OutputFormat != EOmniOutputFormat::NVENCHardware)
+    {
+        Knobs.Add(EOmniCaptureQualityKnob::AuxiliaryPassRate);
+    }
+    if (Settings.bEnablePreviewWindow && Settings.PreviewFrameRate > 0.0f)
+    {
+        Knobs.Add(EOmniCaptureQualityKnob::PreviewRate);
+    }
+    if (!Settings.IsPlanar() && Settings.GetRemapSamplesPerAxis() > 1)
+    {
+        Knobs.Add(EOmniCaptureQualityKnob::RemapSampling);
+    }
+    MinFaceResolutionScale = FMath::Clamp(Settings.GovernorMinFaceResolutionScale, 0.25f, 1.0f);
+    if (!Settings.IsPlanar() && !Settings.UsesOmniDirectionalStereo() && MinFaceResolutionScale < 1.0f)
+    {
+        Knobs.Add(EOmniCaptureQualityKnob::FaceResolution);
+    }
+
+    bEnabled = Settings.bEnableQualityGovernor && !Settings.UsesFixedTimestep() && Knobs.Num() > 0;
+    FrameBudgetMilliseconds = Settings.TargetFrameRate > 0.0f ? 1000.0 / Settings.TargetFrameRate : 0.0;
+    WriterTaskLimit = Settings.OutputFormat == EOmniOutputFormat::ImageSequence ? FMath::Max(1, Settings.MaxPendingImageTasks) : 0;
+
+    BaselineState = FOmniCaptureQualityState();
+    BaselineState.RemapQuality = Settings.RemapQuality;
+    Reset();
+}
+
+void FOmniCaptureQualityGovernor::Reset()
+{
+    State = BaselineState;
+    Changes.Reset();
+    LastDroppedFrames = 0;
+    OverloadedSnapshots = 0;
+    HeadroomSnapshots = 0;
+}
+
+FOmniCaptureQualityGovernor::EPressure FOmniCaptureQualityGovernor::Classify(const FOmniCaptureTelemetrySnapshot& Snapshot, FString* OutReason) const
+{
+    const double RingFill = Snapshot.RingBufferCapacity > 0
+        ? static_cast<double>(Snapshot.RingBufferPending) / Snapshot.RingBufferCapacity
+        : 0.0;
+
+    double CaptureMilliseconds = 0.0;
+    for (EOmniCaptureStage Stage : CaptureThreadStages)
+    {
+        CaptureMilliseconds += Snapshot[Stage];
+    }
+
+    const int32 NewDrops = FMath::Max(0, Snapshot.DroppedFrames - LastDroppedFrames);
+    const bool bWriterSaturated = WriterTaskLimit > 0 && Snapshot.WriterPendingFrames >= WriterTaskLimit;
+    const bool bOverBudget = FrameBudgetMilliseconds > 0.0 && CaptureMilliseconds > FrameBudgetMilliseconds;
+
+    if (OutReason)
+    {
+        *OutReason = FString::Printf(TEXT("ring %d/%d, writer %d/%d, capture %.1f/%.1f ms, %d new drops"),
+            Snapshot.RingBufferPending, Snapshot.RingBufferCapacity, Snapshot.WriterPendingFrames, WriterTaskLimit,
+            CaptureMilliseconds, FrameBudgetMilliseconds, NewDrops);
+    }
+
+    if (RingFill >= RingOverloadedFill || bWriterSaturated || bOverBudget || NewDrops > 0)
+    {
+        return EPressure::Overloaded;
+    }
+
+    const bool bWriterIdle = WriterTaskLimit <= 0 || Snapshot.WriterPendingFrames * 2 <= WriterTaskLimit;
+    const bool bUnderBudget = FrameBudgetMilliseconds <= 0.0 || CaptureMilliseconds <= FrameBudgetMilliseconds * HeadroomBudgetFraction;
+    return RingFill <= RingHeadroomFill && bWriterIdle && bUnderBudget ? EPressure::Headroom : EPressure::Steady;
+}
+
+bool FOmniCaptureQualityGovernor::Update(const FOmniCaptureTelemetrySnapshot& Snapshot, int32 FrameIndex)
+{
+    if (!bEnabled)
+    {
+        return false;
+    }
+
+    FString Reason;
+    const EPressure Pressure = Classify(Snapshot, &Reason);
+    LastDroppedFrames = Snapshot.DroppedFrames;
+    OverloadedSnapshots = Pressure == EPressure::Overloaded ? OverloadedSnapshots + 1 : 0;
+    HeadroomSnapshots = Pressure == EPressure::Headroom ? HeadroomSnapshots + 1 : 0;
+
+    int32 NewLevel = State.Level;
+    if (OverloadedSnapshots >= OverloadedSnapshotsToDegrade && State.Level < Knobs.Num())
+    {
+        ++NewLevel;
+    }
+    else if (HeadroomSnapshots >= HeadroomSnapshotsToRestore && State.Level > 0)
+    {
+        --NewLevel;
+    }
+    else
+    {
+        return false;
+    }
+
+    // Each change gets a fresh observation window so its effect shows up before the next decision.
+    OverloadedSnapshots = 0;
+    HeadroomSnapshots = 0;
+
+    FOmniCaptureQualityChange& Change = Changes.AddDefaulted_GetRef();
+    Change.CaptureSeconds = Snapshot.CaptureSeconds;
+    Change.FrameIndex = FrameIndex;
+    Change.bDegraded = NewLevel > State.Level;
+    Change.Knob = Knobs[Change.bDegraded ? State.Level : NewLevel];
+    Change.Level = NewLevel;
+    Change.Reason = MoveTemp(Reason);
+
+    State = MakeState(NewLevel);
+    return true;
+}
+
+FOmniCaptureQualityState FOmniCaptureQualityGovernor::MakeState(int32 Level) const
+{
+    FOmniCaptureQualityState Result = BaselineState;
+    Result.Level = FMath::Clamp(Level, 0, Knobs.Num());
+    for (int32 KnobIndex = 0; KnobIndex < Result.Level; ++KnobIndex)
+    {
+        switch (Knobs[KnobIndex])
+        {
+        case EOmniCaptureQualityKnob::PNGCompression:
+            Result.PNGCompressionLevel = DegradedPNGCompressionLevel;
+            break;
+        case EOmniCaptureQualityKnob::AuxiliaryPassRate:
+            Result.AuxiliaryPassInterval = DegradedAuxiliaryPassInterval;
+            break;
+        case EOmniCaptureQualityKnob::PreviewRate:
+            Result.PreviewRateScale = DegradedPreviewRateScale;
+            break;
+        case EOmniCaptureQualityKnob::RemapSampling:
+            Result.RemapQuality = EOmniCaptureRemapQuality::Standard;
+            break;
+        case EOmniCaptureQualityKnob::FaceResolution:
+            Result.FaceResolutionScale = MinFaceResolutionScale;
+            break;
+        default:
+            break;
+        }
+    }
+    return Result;
+}
@@ -3,12 +3,15 @@
 #include "Components/SceneComponent.h"
 #include "Components/SceneCaptureComponent2D.h"
 #include "OmniCaptureIncludeFixes.h"
+#include "OmniCaptureProjectionRemap.h"
 #include "UObject/Package.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "OmniCaptureTypes.h"  // 增加头文件
 #include "OmniCaptureVersion.h"
 #include "UObject/UnrealType.h"
 
+DEFINE_LOG_CATEGORY_STATIC(LogOmniCaptureRig, Log, All);
+
 namespace
 {
     constexpr int32 CubemapFaceCount = 6;
@@ -146,35 +149,47 @@ void AOmniCaptureRigActor::Configure(const FOmniCaptureSettings& InSettings)
     RightAuxiliaryCaptures.Empty();
     RenderTargets.Empty();
 
+    if (CachedSettings.UsesOmniDirectionalStereo())
+    {
+        ODSLayout = FOmniCaptureODSLayout::Build(CachedSettings);
+        BuildODSEyeRig(EOmniCaptureEye::Left);
+        BuildODSEyeRig(EOmniCaptureEye::Right);
+        ApplyStereoParameters();
+
+        UE_LOG(LogOmniCaptureRig, Log, TEXT("ODS rig: %d slices x %d rows per eye, %d x %d views (%.1f MP per eye)"),
+            ODSLayout.SliceCount, ODSLayout.RowCount, ODSLayout.ViewSize.X, ODSLayout.ViewSize.Y, ODSLayout.GetRenderedPixelCount() / 1.0e6);
+        return;
+    }
+
     const bool bPlanar = CachedSettings.IsPlanar();
     const int32 FaceCount = bPlanar ? 1 : CubemapFaceCount;
-    const FIntPoint TargetSize = bPlanar
-        ? CachedSettings.GetPlanarResolution()
-        : FIntPoint(CachedSettings.Resolution, CachedSettings.Resolution);
+    FaceResolutionScale = 1.0f;
+    UpdateFaceCaptureRects();
 
     const float IPDHalf = CachedSettings.Mode == EOmniCaptureMode::Stereo
         ? CachedSettings.InterPupillaryDistanceCm * 0.5f
         : 0.0f;
 
     BuildEyeRig(EOmniCaptureEye::Left, -IPDHalf, FaceCount);
-    ConfigureAuxiliaryTargets(EOmniCaptureEye::Left, FaceCount, TargetSize);
+    ConfigureAuxiliaryTargets(EOmniCaptureEye::Left, FaceCount);
 
     if (CachedSettings.Mode == EOmniCaptureMode::Stereo)
     {
         BuildEyeRig(EOmniCaptureEye::Right, IPDHalf, FaceCount);
-        ConfigureAuxiliaryTargets(EOmniCaptureEye::Right, FaceCount, TargetSize);
+        ConfigureAuxiliaryTargets(EOmniCaptureEye::Right, FaceCount);
     }
 
     ApplyStereoParameters();
 }
 
-void AOmniCaptureRigActor::Capture(FOmniEyeCapture& OutLeftEye, FOmniEyeCapture& OutRightEye) const
+void AOmniCaptureRigActor::Capture(FOmniEyeCapture& OutLeftEye, FOmniEyeCapture& OutRightEye, bool bCaptureAuxiliary) const
 {
-    CaptureEye(EOmniCaptureEye::Left, OutLeftEye);
+    LastCapturedPixels = 0;
+    CaptureEye(EOmniCaptureEye::Left, OutLeftEye, bCaptureAuxiliary);
 
     if (CachedSettings.Mode == EOmniCaptureMode::Stereo && RightEyeCaptures.Num() > 0)
     {
-        CaptureEye(EOmniCaptureEye::Right, OutRightEye);
+        CaptureEye(EOmniCaptureEye::Right, OutRightEye, bCaptureAuxiliary);
     }
     else
     {
@@ -193,29 +208,196 @@ void AOmniCaptureRigActor::BuildEyeRig(EOmniCaptureEye Eye, float IPDHalfCm, int
 
     TArray<USceneCaptureComponent2D*>& TargetArray = Eye == EOmniCaptureEye::Left ? LeftEyeCaptures : RightEyeCaptures;
 
-    const FIntPoint TargetSize = CachedSettings.IsPlanar()
-        ? CachedSettings.GetPlanarResolution()
-        : FIntPoint(CachedSettings.Resolution, CachedSettings.Resolution);
-
     for (int32 FaceIndex = 0; FaceIndex < FaceCount; ++FaceIndex)
     {
         FString ComponentName = FString::Printf(TEXT("%s_CaptureFace_%d"), Eye == EOmniCaptureEye::Left ? TEXT("Left") : TEXT("Right"), FaceIndex);
         USceneCaptureComponent2D* CaptureComponent = NewObject<USceneCaptureComponent2D>(this, *ComponentName);
         CaptureComponent->SetupAttachment(EyeRoot);
         CaptureComponent->RegisterComponent();
-        ConfigureCaptureComponent(CaptureComponent, TargetSize);
+        ConfigureCaptureComponent(CaptureComponent, GetFaceTargetSize(FaceIndex));
 
         if (!CachedSettings.IsPlanar())
         {
             FRotator FaceRotation;
             GetOrientationForFace(FaceIndex, FaceRotation);
             CaptureComponent->SetRelativeRotation(FaceRotation);
+            ApplyFaceCrop(CaptureComponent, FaceIndex);
         }
 
         TargetArray.Add(CaptureComponent);
     }
 }
 
+void AOmniCaptureRigActor::BuildODSEyeRig(EOmniCaptureEye Eye)
+{
+    TArray<USceneCaptureComponent2D*>& TargetArray = Eye == EOmniCaptureEye::Left ? LeftEyeCaptures : RightEyeCaptures;
+    const TCHAR* EyeName = Eye == EOmniCaptureEye::Left ? TEXT("Left") : TEXT("Right");
+
+    // Views are added in FOmniCaptureODSLayout::GetViewIndex order; UpdateODSViewTransforms places them on the IPD circle.
+    for (int32 Slice = 0; Slice < ODSLayout.SliceCount; ++Slice)
+    {
+        for (int32 Row = 0; Row < ODSLayout.RowCount; ++Row)
+        {
+            const FString ComponentName = FString::Printf(TEXT("%s_ODSSlice_%d_%d"), EyeName, Slice, Row);
+            USceneCaptureComponent2D* CaptureComponent = NewObject<USceneCaptureComponent2D>(this, *ComponentName);
+            CaptureComponent->SetupAttachment(RigRoot);
+            CaptureComponent->RegisterComponent();
+            ConfigureCaptureComponent(CaptureComponent, ODSLayout.ViewSize);
+            CaptureComponent->FOVAngle = ODSLayout.GetViewFOVDegrees();
+            CaptureComponent->SetRelativeRotation(ODSLayout.GetViewRotation(Slice, Row));
+            TargetArray.Add(CaptureComponent);
+        }
+    }
+}
+
+void AOmniCaptureRigActor::UpdateODSViewTransforms()
+{
+    for (int32 ViewIndex = 0; ViewIndex < ODSLayout.GetViewCount(); ++ViewIndex)
+    {
+        const int32 Slice = ViewIndex / ODSLayout.RowCount;
+        if (LeftEyeCaptures.IsValidIndex(ViewIndex) && LeftEyeCaptures[ViewIndex])
+        {
+            LeftEyeCaptures[ViewIndex]->SetRelativeLocation(ODSLayout.GetViewLocation(Slice, -1.0f));
+        }
+        if (RightEyeCaptures.IsValidIndex(ViewIndex) && RightEyeCaptures[ViewIndex])
+        {
+            RightEyeCaptures[ViewIndex]->SetRelativeLocation(ODSLayout.GetViewLocation(Slice, 1.0f));
+        }
+    }
+}
+
+void AOmniCaptureRigActor::UpdateFaceCaptureRects()
+{
+    const int32 FaceResolution = CachedSettings.Resolution;
+    const bool bUseCoverage = !CachedSettings.IsPlanar()
+        && (CachedSettings.bSkipUnusedCubeFaces || CachedSettings.bCropPartialCubeFaces || CachedSettings.bAdaptiveFaceResolution);
+    FOmniCaptureFaceCoverage Coverage = bUseCoverage
+        ? FOmniCaptureProjectionRemap::ComputeFaceCoverage(CachedSettings)
+        : FOmniCaptureFaceCoverage::Full(FaceResolution);
+
+    for (int32 FaceIndex = 0; FaceIndex < CubemapFaceCount; ++FaceIndex)
+    {
+        const int32 FaceSize = Coverage.FaceSizes[FaceIndex];
+        if ((!Coverage.IsFaceUsed(FaceIndex) && !CachedSettings.bSkipUnusedCubeFaces)
+            || (Coverage.IsFaceCropped(FaceIndex) && !CachedSettings.bCropPartialCubeFaces))
+        {
+            Coverage.Rects[FaceIndex] = FIntRect(0, 0, FaceSize, FaceSize);
+        }
+        FaceCaptureRects[FaceIndex] = Coverage.Rects[FaceIndex];
+        FaceSizes[FaceIndex] = FaceSize;
+
+        // Scaling the face and its rect together keeps the normalized crop, so the off-axis projection is unchanged.
+        if (FaceResolutionScale < 1.0f && FaceSize > 0)
+        {
+            const int32 ScaledSize = FMath::Max(2, FMath::RoundToInt(FaceSize * FaceResolutionScale));
+            const double Ratio = static_cast<double>(ScaledSize) / FaceSize;
+            const FIntRect& Rect = FaceCaptureRects[FaceIndex];
+            if (Rect.Area() > 0)
+            {
+                FaceCaptureRects[FaceIndex] = FIntRect(
+                    FMath::FloorToInt(Rect.Min.X * Ratio), FMath::FloorToInt(Rect.Min.Y * Ratio),
+                    FMath::Min(ScaledSize, FMath::CeilToInt(Rect.Max.X * Ratio)), FMath::Min(ScaledSize, FMath::CeilToInt(Rect.Max.Y * Ratio)));
+            }
+            FaceSizes[FaceIndex] = ScaledSize;
+        }
+    }
+
+    if (bUseCoverage)
+    {
+        UE_LOG(LogOmniCaptureRig, Log, TEXT("Cube faces render %.1f%% of %d x %d face texels (face sizes %d/%d/%d/%d/%d/%d)"),
+            Coverage.GetRenderedFraction() * 100.0f, FaceResolution, FaceResolution,
+            FaceSizes[0], FaceSizes[1], FaceSizes[2], FaceSizes[3], FaceSizes[4], FaceSizes[5]);
+    }
+}
+
+FIntPoint AOmniCaptureRigActor::GetFaceTargetSize(int32 FaceIndex) const
+{
+    if (CachedSettings.IsPlanar())
+    {
+        return CachedSettings.GetPlanarResolution();
+    }
+
+    // Skipped faces keep a minimal target so downstream code can still resolve a texture.
+    const FIntRect& Rect = FaceCaptureRects[FaceIndex];
+    return FIntPoint(Rect.Width(), Rect.Height());
+}
+
+void AOmniCaptureRigActor::ApplyFaceCrop(USceneCaptureComponent2D* CaptureComponent, int32 FaceIndex) const
+{
+    const int32 FaceResolution = FaceSizes[FaceIndex] > 0 ? FaceSizes[FaceIndex] : CachedSettings.Resolution;
+    const FIntRect& Rect = FaceCaptureRects[FaceIndex];
+    if (!CaptureComponent || Rect.Area() <= 0 || Rect == FIntRect(0, 0, FaceResolution, FaceResolution))
+    {
+        return;
+    }
+
+    // Off-axis crop of the 90 degree face frustum: remap the rect's NDC range to [-1, 1] after projection,
+    // so each target pixel lands exactly on the face texel it replaces.
+    const double MinX = 2.0 * Rect.Min.X / FaceResolution - 1.0;
+    const double MaxX = 2.0 * Rect.Max.X / FaceResolution - 1.0;
+    const double MaxY = 1.0 - 2.0 * Rect.Min.Y / FaceResolution;
+    const double MinY = 1.0 - 2.0 * Rect.Max.Y / FaceResolution;
+    const double ScaleX = 0.5 * (MaxX - MinX);
+    const double ScaleY = 0.5 * (MaxY - MinY);
+
+    FMatrix Crop = FMatrix::Identity;
+    Crop.M[0][0] = 1.0 / ScaleX;
+    Crop.M[3][0] = -0.5 * (MaxX + MinX) / ScaleX;
+    Crop.M[1][1] = 1.0 / ScaleY;
+    Crop.M[3][1] = -0.5 * (MaxY + MinY) / ScaleY;
+
+    CaptureComponent->bUseCustomProjectionMatrix = true;
+    CaptureComponent->CustomProjectionMatrix = FReversedZPerspectiveMatrix(UE_DOUBLE_PI * 0.25, 1.0, 1.0, static_cast<double>(GNearClippingPlane)) * Crop;
+}
+
+bool AOmniCaptureRigActor::SetFaceResolutionScale(float Scale)
+{
+    if (CachedSettings.IsPlanar() || CachedSettings.UsesOmniDirectionalStereo())
+    {
+        return false;
+    }
+
+    Scale = FMath::Clamp(Scale, 0.1f, 1.0f);
+    if (FMath::IsNearlyEqual(Scale, FaceResolutionScale))
+    {
+        return true;
+    }
+
+    FaceResolutionScale = Scale;
+    UpdateFaceCaptureRects();
+
+    auto ResizeFaceTarget = [this](USceneCaptureComponent2D* CaptureComponent, int32 FaceIndex)
+    {
+        UTextureRenderTarget2D* RenderTarget = CaptureComponent ? Cast<UTextureRenderTarget2D>(CaptureComponent->TextureTarget) : nullptr;
+        if (RenderTarget)
+        {
+            const FIntPoint TargetSize = GetFaceTargetSize(FaceIndex);
+            RenderTarget->ResizeTarget(FMath::Max(2, TargetSize.X), FMath::Max(2, TargetSize.Y));
+            ApplyFaceCrop(CaptureComponent, FaceIndex);
+        }
+    };
+
+    for (const TArray<USceneCaptureComponent2D*>* EyeCaptures : { &LeftEyeCaptures, &RightEyeCaptures })
+    {
+        for (int32 FaceIndex = 0; FaceIndex < EyeCaptures->Num() && FaceIndex < CubemapFaceCount; ++FaceIndex)
+        {
+            ResizeFaceTarget((*EyeCaptures)[FaceIndex], FaceIndex);
+        }
+    }
+
+    for (const TMap<EOmniCaptureAuxiliaryPassType, FOmniCaptureAuxiliaryCaptureArray>* AuxMap : { &LeftAuxiliaryCaptures, &RightAuxiliaryCaptures })
+    {
+        for (const TPair<EOmniCaptureAuxiliaryPassType, FOmniCaptureAuxiliaryCaptureArray>& Pair : *AuxMap)
+        {
+            for (int32 FaceIndex = 0; FaceIndex < Pair.Value.CaptureComponents.Num() && FaceIndex < CubemapFaceCount; ++FaceIndex)
+            {
+                ResizeFaceTarget(Pair.Value.CaptureComponents[FaceIndex], FaceIndex);
+            }
+        }
+    }
+    return true;
+}
+
 void AOmniCaptureRigActor::UpdateStereoParameters(float NewIPDCm, float NewConvergenceDistanceCm)
 {
     if (CachedSettings.Mode != EOmniCaptureMode::Stereo)
@@ -237,6 +419,14 @@ void AOmniCaptureRigActor::ApplyStereoParameters()
         ? CachedSettings.InterPupillaryDistanceCm * 0.5f
         : 0.0f;
 
+    if (CachedSettings.UsesOmniDirectionalStereo())
+    {
+        // ODS views hang off the rig root, each at its own point on the IPD circle.
+        ODSLayout.EyeRadiusCm = HalfIPD;
+        UpdateODSViewTransforms();
+        return;
+    }
+
     UpdateEyeRootTransform(LeftEyeRoot, -HalfIPD, EOmniCaptureEye::Left);
     UpdateEyeRootTransform(RightEyeRoot, HalfIPD, EOmniCaptureEye::Right);
 }
@@ -365,7 +555,7 @@ USceneCaptureComponent2D* AOmniCaptureRigActor::CreateAuxiliaryCaptureComponent(
     return CaptureComponent;
 }
 
-void AOmniCaptureRigActor::ConfigureAuxiliaryTargets(EOmniCaptureEye Eye, int32 FaceCount, const FIntPoint& TargetSize)
+void AOmniCaptureRigActor::ConfigureAuxiliaryTargets(EOmniCaptureEye Eye, int32 FaceCount)
 {
     if (CachedSettings.AuxiliaryPasses.Num() == 0)
     {
@@ -396,7 +586,7 @@ void AOmniCaptureRigActor::ConfigureAuxiliaryTargets(EOmniCaptureEye Eye, int32
         {
             const FString PassName = GetAuxiliaryLayerName(Pass).ToString();
             const FString ComponentName = FString::Printf(TEXT("%s_%s_%d"), Eye == EOmniCaptureEye::Left ? TEXT("Left") : TEXT("Right"), *PassName, FaceIndex);
-            if (USceneCaptureComponent2D* AuxCapture = CreateAuxiliaryCaptureComponent(ComponentName, Pass, TargetSize))
+            if (USceneCaptureComponent2D* AuxCapture = CreateAuxiliaryCaptureComponent(ComponentName, Pass, GetFaceTargetSize(FaceIndex)))
             {
                 AuxCapture->SetupAttachment(EyeRoot);
                 AuxCapture->RegisterComponent();
@@ -406,6 +596,7 @@ void AOmniCaptureRigActor::ConfigureAuxiliaryTargets(EOmniCaptureEye Eye, int32
                     FRotator FaceRotation;
                     GetOrientationForFace(FaceIndex, FaceRotation);
                     AuxCapture->SetRelativeRotation(FaceRotation);
+                    ApplyFaceCrop(AuxCapture, FaceIndex);
                 }
 
                 CaptureArray[FaceIndex] = AuxCapture;
@@ -414,31 +605,62 @@ void AOmniCaptureRigActor::ConfigureAuxiliaryTargets(EOmniCaptureEye Eye, int32
     }
 }
 
-void AOmniCaptureRigActor::CaptureEye(EOmniCaptureEye Eye, FOmniEyeCapture& OutCapture) const
+void AOmniCaptureRigActor::CaptureEye(EOmniCaptureEye Eye, FOmniEyeCapture& OutCapture, bool bCaptureAuxiliary) const
 {
     const TArray<USceneCaptureComponent2D*>& CaptureComponents = Eye == EOmniCaptureEye::Left ? LeftEyeCaptures : RightEyeCaptures;
 
     OutCapture.ActiveFaceCount = CaptureComponents.Num();
+    OutCapture.ODSViews.Reset();
 
     for (int32 FaceIndex = 0; FaceIndex < UE_ARRAY_COUNT(OutCapture.Faces); ++FaceIndex)
     {
         OutCapture.Faces[FaceIndex].RenderTarget = nullptr;
         OutCapture.Faces[FaceIndex].AuxiliaryTargets.Reset();
+        OutCapture.Faces[FaceIndex].ValidRect = FIntRect();
+        OutCapture.Faces[FaceIndex].bRendered = true;
+        OutCapture.Faces[FaceIndex].FaceSize = 0;
     }
 
+    if (CachedSettings.UsesOmniDirectionalStereo())
+    {
+        OutCapture.ActiveFaceCount = 0;
+        for (USceneCaptureComponent2D* CaptureComponent : CaptureComponents)
+        {
+            UTextureRenderTarget2D* ViewTarget = CaptureComponent ? Cast<UTextureRenderTarget2D>(CaptureComponent->TextureTarget) : nullptr;
+            if (ViewTarget)
+            {
+                CaptureComponent->CaptureScene();
+                LastCapturedPixels += static_cast<int64>(ViewTarget->SizeX) * ViewTarget->SizeY;
+            }
+            OutCapture.ODSViews.Add(ViewTarget);
+        }
+        return;
+    }
+
+    const bool bCubemap = !CachedSettings.IsPlanar();
     for (int32 FaceIndex = 0; FaceIndex < CaptureComponents.Num(); ++FaceIndex)
     {
         if (USceneCaptureComponent2D* CaptureComponent = CaptureComponents[FaceIndex])
         {
-            CaptureComponent->CaptureScene();
+            FOmniCaptureFaceResources& Face = OutCapture.Faces[FaceIndex];
+            if (bCubemap)
+            {
+                Face.ValidRect = FaceCaptureRects[FaceIndex];
+                Face.FaceSize = FaceSizes[FaceIndex];
+                Face.bRendered = Face.ValidRect.Area() > 0;
+            }
 
-            UTextureRenderTarget2D* RenderTarget = Cast<UTextureRenderTarget2D>(CaptureComponent->TextureTarget);
-            OutCapture.Faces[FaceIndex].RenderTarget = RenderTarget;
+            Face.RenderTarget = Cast<UTextureRenderTarget2D>(CaptureComponent->TextureTarget);
+            if (Face.bRendered)
+            {
+                CaptureComponent->CaptureScene();
+                LastCapturedPixels += Face.RenderTarget ? static_cast<int64>(Face.RenderTarget->SizeX) * Face.RenderTarget->SizeY : 0;
+            }
         }
     }
 
     const TMap<EOmniCaptureAuxiliaryPassType, FOmniCaptureAuxiliaryCaptureArray>* AuxMap = Eye == EOmniCaptureEye::Left ? &LeftAuxiliaryCaptures : &RightAuxiliaryCaptures;
-    if (AuxMap)
+    if (AuxMap && bCaptureAuxiliary)
     {
         for (const TPair<EOmniCaptureAuxiliaryPassType, FOmniCaptureAuxiliaryCaptureArray>& Pair : *AuxMap)
         {
@@ -449,8 +671,13 @@ void AOmniCaptureRigActor::CaptureEye(EOmniCaptureEye Eye, FOmniEyeCapture& OutC
             {
                 if (USceneCaptureComponent2D* AuxCapture = AuxCaptures[FaceIndex])
                 {
-                    AuxCapture->CaptureScene();
-                    if (UTextureRenderTarget2D* AuxTarget = Cast<UTextureRenderTarget2D>(AuxCapture->TextureTarget))
+                    UTextureRenderTarget2D* AuxTarget = Cast<UTextureRenderTarget2D>(AuxCapture->TextureTarget);
+                    if (OutCapture.Faces[FaceIndex].bRendered)
+                    {
+                        AuxCapture->CaptureScene();
+                        LastCapturedPixels += AuxTarget ? static_cast<int64>(AuxTarget->SizeX) * AuxTarget->SizeY : 0;
+                    }
+                    if (AuxTarget)
                     {
                         OutCapture.Faces[FaceIndex].AuxiliaryTargets.Add(PassType, AuxTarget);
                     }
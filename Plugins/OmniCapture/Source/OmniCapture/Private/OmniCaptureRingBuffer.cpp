@@ -93,9 +93,10 @@ FOmniCaptureRingBuffer::~FOmniCaptureRingBuffer()
     }
 }
 
-void FOmniCaptureRingBuffer::Initialize(const FOmniCaptureSettings& Settings, const TFunction<void(TUniquePtr<FOmniCaptureFrame>&&)>& InConsumer)
+void FOmniCaptureRingBuffer::Initialize(const FOmniCaptureSettings& Settings, const TFunction<void(TUniquePtr<FOmniCaptureFrame>&&)>& InConsumer, const TFunction<void(const FOmniCaptureFrameMetadata&)>& InOnDropped)
 {
     Consumer = InConsumer;
+    OnDropped = InOnDropped;
     Capacity = FMath::Max(0, Settings.RingBufferCapacity);
     Policy = Settings.RingBufferPolicy;
     StartWorker();
@@ -128,7 +129,20 @@ void FOmniCaptureRingBuffer::Enqueue(TUniquePtr<FOmniCaptureFrame>&& Frame)
                         PendingCount.DecrementExchange();
                     }
                 }
-                DroppedCount.IncrementExchange();
+
+                // The worker may have taken the oldest frame first, in which case nothing was dropped.
+                if (Discarded.IsValid())
+                {
+                    DroppedCount.IncrementExchange();
+                    if (OnDropped)
+                    {
+                        for (const FOmniCaptureFrameMetadata& Duplicate : Discarded->Duplicates)
+                        {
+                            OnDropped(Duplicate);
+                        }
+                        OnDropped(Discarded->Metadata);
+                    }
+                }
                 break;
             }
             else
@@ -1,6 +1,7 @@
 #include "OmniCaptureSettingsValidator.h"
 
 #include "Internationalization/Text.h"
+#include "OmniCaptureProjectionRemap.h"
 
 namespace
 {
@@ -22,6 +23,7 @@ namespace
             Info.SupportedCoverage = { EOmniCaptureCoverage::FullSphere, EOmniCaptureCoverage::HalfSphere };
             Info.bSupportsStereo = true;
             break;
+        case EOmniCaptureProjection::FoveatedEquirectangular:
         case EOmniCaptureProjection::Fisheye:
             Info.SupportedCoverage = { EOmniCaptureCoverage::FullSphere, EOmniCaptureCoverage::HalfSphere };
             Info.bSupportsStereo = true;
@@ -42,6 +44,11 @@ namespace
             Info.SupportedCoverage = { EOmniCaptureCoverage::FullSphere };
             Info.bSupportsStereo = false;
             break;
+        case EOmniCaptureProjection::Cubemap:
+        case EOmniCaptureProjection::EquiAngularCubemap:
+            Info.SupportedCoverage = { EOmniCaptureCoverage::FullSphere };
+            Info.bSupportsStereo = true;
+            break;
         default:
             Info.bKnown = false;
             break;
@@ -69,6 +76,16 @@ namespace
 
         return TEXT("Unknown Coverage");
     }
+
+    FString RemapQualityToString(EOmniCaptureRemapQuality Quality)
+    {
+        if (const UEnum* Enum = StaticEnum<EOmniCaptureRemapQuality>())
+        {
+            return Enum->GetDisplayNameTextByValue(static_cast<int64>(Quality)).ToString();
+        }
+
+        return TEXT("Unknown Remap Quality");
+    }
 }
 
 bool FOmniCaptureSettingsValidator::ApplyCompatibilityFixups(FOmniCaptureSettings& InOutSettings, TArray<FString>& OutWarnings, FString* OutFailureReason)
@@ -129,6 +146,46 @@ bool FOmniCaptureSettingsValidator::ApplyCompatibilityFixups(FOmniCaptureSetting
         InOutSettings.FisheyeType = EOmniCaptureFisheyeType::Hemispherical;
     }
 
+    if (InOutSettings.bOmniDirectionalStereo && !InOutSettings.UsesOmniDirectionalStereo())
+    {
+        EmitWarning(TEXT("Omni-directional stereo requires stereo equirectangular output - rendering offset cubemaps instead."));
+        InOutSettings.bOmniDirectionalStereo = false;
+    }
+
+    if (InOutSettings.UsesOmniDirectionalStereo() && InOutSettings.AuxiliaryPasses.Num() > 0)
+    {
+        EmitWarning(TEXT("Auxiliary passes are not rendered by the omni-directional stereo rig - dropping them."));
+        InOutSettings.AuxiliaryPasses.Reset();
+    }
+
+    if (InOutSettings.UsesPackedFrames() && InOutSettings.AuxiliaryPasses.Num() > 0)
+    {
+        EmitWarning(TEXT("A Y4M stream only carries the beauty pass - dropping auxiliary passes."));
+        InOutSettings.AuxiliaryPasses.Reset();
+    }
+
+    if (InOutSettings.UsesFixedTimestep() && InOutSettings.bRecordAudio)
+    {
+        EmitWarning(TEXT("Offline fixed-timestep capture does not run in realtime - disabling audio recording."));
+        InOutSettings.bRecordAudio = false;
+    }
+
+    // Supersampled tables grow with the output and the grid; lower the grid rather than allocate gigabytes.
+    if (!InOutSettings.IsPlanar() && !InOutSettings.IsCubemapLayout() && !InOutSettings.IsFoveatedEquirect() && InOutSettings.GetRemapSamplesPerAxis() > 1)
+    {
+        FOmniCaptureProjectionParams Params;
+        FIntPoint EyeSize;
+        FOmniCaptureProjectionRemap::GetConverterParams(InOutSettings, Params, EyeSize);
+        const int32 SamplesPerAxis = FOmniCaptureProjectionRemap::GetTableSamplesPerAxis(Params, EyeSize);
+        if (SamplesPerAxis < InOutSettings.GetRemapSamplesPerAxis())
+        {
+            const EOmniCaptureRemapQuality Fallback = SamplesPerAxis >= 2 ? EOmniCaptureRemapQuality::High : EOmniCaptureRemapQuality::Standard;
+            EmitWarning(FString::Printf(TEXT("%s remap of a %dx%d eye needs more than %lld MB of remap table - switching to %s."),
+                *RemapQualityToString(InOutSettings.RemapQuality), EyeSize.X, EyeSize.Y, FOmniCaptureProjectionRemap::MaxTableBytes / (1024 * 1024), *RemapQualityToString(Fallback)));
+            InOutSettings.RemapQuality = Fallback;
+        }
+    }
+
     return true;
 }
 
@@ -0,0 +1,198 @@
+#include "OmniCaptureStageTimings.h"
+
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+UE_TRACE_CHANNEL_DEFINE(OmniCaptureChannel);
+
+DEFINE_STAT(STAT_OmniCapture_RigCapture);
+DEFINE_STAT(STAT_OmniCapture_RenderFlush);
+DEFINE_STAT(STAT_OmniCapture_Conversion);
+DEFINE_STAT(STAT_OmniCapture_AuxiliaryPasses);
+DEFINE_STAT(STAT_OmniCapture_Enqueue);
+DEFINE_STAT(STAT_OmniCapture_Preview);
+DEFINE_STAT(STAT_OmniCapture_WriterEncode);
+DEFINE_STAT(STAT_OmniCapture_FileWrite);
+DEFINE_STAT(STAT_OmniCapture_EncoderSubmit);
+DEFINE_STAT(STAT_OmniCapture_Mux);
+
+namespace
+{
+    thread_local FOmniCaptureFrameStageTimings GThreadStageTimings;
+    thread_local FOmniCaptureStageScope* GCurrentStageScope = nullptr;
+}
+
+const TCHAR* LexToString(EOmniCaptureStage Stage)
+{
+    switch (Stage)
+    {
+    case EOmniCaptureStage::RigCapture: return TEXT("Rig Capture");
+    case EOmniCaptureStage::RenderFlush: return TEXT("Render Flush");
+    case EOmniCaptureStage::Conversion: return TEXT("Conversion");
+    case EOmniCaptureStage::AuxiliaryPasses: return TEXT("Aux Passes");
+    case EOmniCaptureStage::Enqueue: return TEXT("Enqueue");
+    case EOmniCaptureStage::Preview: return TEXT("Preview");
+    case EOmniCaptureStage::WriterEncode: return TEXT("Writer Encode");
+    case EOmniCaptureStage::FileWrite: return TEXT("File Write");
+    case EOmniCaptureStage::EncoderSubmit: return TEXT("Encoder Submit");
+    case EOmniCaptureStage::Mux: return TEXT("Mux");
+    default: return TEXT("Unknown");
+    }
+}
+
+void FOmniCaptureFrameStageTimings::Accumulate(const FOmniCaptureFrameStageTimings& Other)
+{
+    for (int32 StageIndex = 0; StageIndex < static_cast<int32>(EOmniCaptureStage::Count); ++StageIndex)
+    {
+        Milliseconds[StageIndex] += Other.Milliseconds[StageIndex];
+    }
+}
+
+double FOmniCaptureFrameStageTimings::GetTotalMilliseconds() const
+{
+    double Total = 0.0;
+    for (double StageMilliseconds : Milliseconds)
+    {
+        Total += StageMilliseconds;
+    }
+    return Total;
+}
+
+bool FOmniCaptureFrameStageTimings::IsEmpty() const
+{
+    for (double StageMilliseconds : Milliseconds)
+    {
+        if (StageMilliseconds > 0.0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+FOmniCaptureStageScope::FOmniCaptureStageScope(EOmniCaptureStage InStage)
+    : Stage(InStage)
+    , StartCycles(FPlatformTime::Cycles64())
+    , Parent(GCurrentStageScope)
+{
+    GCurrentStageScope = this;
+}
+
+FOmniCaptureStageScope::~FOmniCaptureStageScope()
+{
+    const double ElapsedMilliseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+    GThreadStageTimings[Stage] += ElapsedMilliseconds;
+    if (Parent)
+    {
+        GThreadStageTimings[Parent->Stage] -= ElapsedMilliseconds;
+    }
+    GCurrentStageScope = Parent;
+}
+
+void FOmniCaptureStageScope::ResetThreadTimings()
+{
+    GThreadStageTimings = FOmniCaptureFrameStageTimings();
+}
+
+FOmniCaptureFrameStageTimings FOmniCaptureStageScope::TakeThreadTimings(int32 FrameIndex)
+{
+    FOmniCaptureFrameStageTimings Timings = GThreadStageTimings;
+    Timings.FrameIndex = FrameIndex;
+    ResetThreadTimings();
+    return Timings;
+}
+
+void FOmniCaptureStageTimingHistory::Reset()
+{
+    FScopeLock Lock(&CriticalSection);
+    Frames.Reset();
+    SessionTimings = FOmniCaptureFrameStageTimings();
+    NewestFrameIndex = INDEX_NONE;
+}
+
+void FOmniCaptureStageTimingHistory::Record(const FOmniCaptureFrameStageTimings& Timings)
+{
+    FScopeLock Lock(&CriticalSection);
+    if (Timings.FrameIndex == INDEX_NONE)
+    {
+        SessionTimings.Accumulate(Timings);
+        return;
+    }
+
+    if (Frames.Num() == 0)
+    {
+        Frames.SetNum(Capacity);
+    }
+
+    FOmniCaptureFrameStageTimings& Slot = Frames[Timings.FrameIndex % Capacity];
+    if (Slot.FrameIndex == Timings.FrameIndex)
+    {
+        Slot.Accumulate(Timings);
+    }
+    else if (Slot.FrameIndex < Timings.FrameIndex)
+    {
+        // A newer frame reuses the slot; a writer finishing a frame that has already been overwritten is dropped.
+        Slot = Timings;
+    }
+    NewestFrameIndex = FMath::Max(NewestFrameIndex, Timings.FrameIndex);
+}
+
+TArray<FOmniCaptureFrameStageTimings> FOmniCaptureStageTimingHistory::GetRecent(int32 MaxFrames) const
+{
+    FScopeLock Lock(&CriticalSection);
+    TArray<FOmniCaptureFrameStageTimings> Recent;
+    if (NewestFrameIndex == INDEX_NONE || MaxFrames <= 0)
+    {
+        return Recent;
+    }
+
+    const int32 OldestFrameIndex = FMath::Max(NewestFrameIndex - FMath::Min(MaxFrames, Capacity) + 1, 0);
+    Recent.Reserve(NewestFrameIndex - OldestFrameIndex + 1);
+    for (int32 FrameIndex = OldestFrameIndex; FrameIndex <= NewestFrameIndex; ++FrameIndex)
+    {
+        const FOmniCaptureFrameStageTimings& Slot = Frames[FrameIndex % Capacity];
+        if (Slot.FrameIndex == FrameIndex)
+        {
+            Recent.Add(Slot);
+        }
+    }
+    return Recent;
+}
+
+FOmniCaptureFrameStageTimings FOmniCaptureStageTimingHistory::GetAverage(int32 MaxFrames) const
+{
+    const TArray<FOmniCaptureFrameStageTimings> Recent = GetRecent(MaxFrames);
+
+    FOmniCaptureFrameStageTimings Average;
+    int32 Samples[static_cast<int32>(EOmniCaptureStage::Count)] = {};
+    for (const FOmniCaptureFrameStageTimings& Timings : Recent)
+    {
+        for (int32 StageIndex = 0; StageIndex < static_cast<int32>(EOmniCaptureStage::Count); ++StageIndex)
+        {
+            if (Timings.Milliseconds[StageIndex] > 0.0)
+            {
+                Average.Milliseconds[StageIndex] += Timings.Milliseconds[StageIndex];
+                ++Samples[StageIndex];
+            }
+        }
+    }
+
+    for (int32 StageIndex = 0; StageIndex < static_cast<int32>(EOmniCaptureStage::Count); ++StageIndex)
+    {
+        if (Samples[StageIndex] > 0)
+        {
+            Average.Milliseconds[StageIndex] /= Samples[StageIndex];
+        }
+    }
+    if (Recent.Num() > 0)
+    {
+        Average.FrameIndex = Recent.Last().FrameIndex;
+    }
+    return Average;
+}
+
+FOmniCaptureFrameStageTimings FOmniCaptureStageTimingHistory::GetSessionTimings() const
+{
+    FScopeLock Lock(&CriticalSection);
+    return SessionTimings;
+}
@@ -3,17 +3,21 @@
 #include "OmniCaptureAudioRecorder.h"
 #include "OmniCaptureDirectorActor.h"
 #include "OmniCaptureEquirectConverter.h"
+#include "OmniCaptureProjectionRemap.h"
 #include "OmniCaptureNVENCEncoder.h"
 #include "OmniCaptureImageWriter.h"
 #include "OmniCaptureRigActor.h"
 #include "OmniCaptureRingBuffer.h"
 #include "OmniCapturePreviewActor.h"
+#include "OmniCapturePreviewDownsample.h"
 #include "OmniCaptureMuxer.h"
 #include "OmniCaptureSettingsValidator.h"
 
+#include "Async/Async.h"
 #include "Curves/CurveFloat.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
+#include "Misc/App.h"
 #include "Misc/Paths.h"
 #include "Misc/DateTime.h"
 #include "HAL/FileManager.h"
@@ -47,8 +51,6 @@ namespace OmniCapture
 
 namespace
 {
-    constexpr int32 GMaxOmniDiagnostics = 256;
-
     EOmniCaptureDiagnosticLevel ConvertVerbosityToDiagnostic(ELogVerbosity::Type Verbosity)
     {
         switch (Verbosity)
@@ -62,6 +64,87 @@ namespace
             return EOmniCaptureDiagnosticLevel::Info;
         }
     }
+
+    FOmniEyeCapture BuildAuxiliaryEye(const FOmniEyeCapture& SourceEye, EOmniCaptureAuxiliaryPassType PassType)
+    {
+        FOmniEyeCapture AuxEye;
+        AuxEye.ActiveFaceCount = SourceEye.ActiveFaceCount;
+        for (int32 FaceIndex = 0; FaceIndex < AuxEye.ActiveFaceCount && FaceIndex < UE_ARRAY_COUNT(AuxEye.Faces); ++FaceIndex)
+        {
+            AuxEye.Faces[FaceIndex].RenderTarget = SourceEye.Faces[FaceIndex].GetAuxiliaryRenderTarget(PassType);
+            AuxEye.Faces[FaceIndex].ValidRect = SourceEye.Faces[FaceIndex].ValidRect;
+            AuxEye.Faces[FaceIndex].bRendered = SourceEye.Faces[FaceIndex].bRendered;
+            AuxEye.Faces[FaceIndex].FaceSize = SourceEye.Faces[FaceIndex].FaceSize;
+        }
+        return AuxEye;
+    }
+
+    /**
+     * Beauty joins the auxiliary batch when there is one. The encoder reads beauty from GPU planes the batched
+     * remap does not produce, so NVENC output keeps beauty on its own pass.
+     */
+    bool CanBatchBeautyLayer(const FOmniCaptureSettings& Settings)
+    {
+        return Settings.AuxiliaryPasses.Num() > 0 && !Settings.IsPlanar() && Settings.OutputFormat != EOmniOutputFormat::NVENCHardware;
+    }
+
+    /**
+     * Converts every auxiliary pass, plus the beauty layer when bIncludeBeauty, in one batched remap that shares
+     * the table walk between layers. Returns the beauty result, which is empty unless it was included.
+     */
+    FOmniCaptureEquirectResult ConvertFrameLayers(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye, bool bIncludeBeauty, TMap<FName, FOmniCaptureLayerPayload>& OutAuxiliaryLayers)
+    {
+        TArray<EOmniCaptureAuxiliaryPassType> LayerPasses;
+        TArray<FOmniCaptureLayerEyes> Layers;
+        if (bIncludeBeauty)
+        {
+            LayerPasses.Add(EOmniCaptureAuxiliaryPassType::None);
+            Layers.Add({ LeftEye, RightEye });
+        }
+
+        for (EOmniCaptureAuxiliaryPassType PassType : Settings.AuxiliaryPasses)
+        {
+            if (PassType != EOmniCaptureAuxiliaryPassType::None)
+            {
+                LayerPasses.Add(PassType);
+                Layers.Add({ BuildAuxiliaryEye(LeftEye, PassType), BuildAuxiliaryEye(RightEye, PassType) });
+            }
+        }
+
+        TArray<FOmniCaptureEquirectResult> Results;
+        if (Settings.IsPlanar())
+        {
+            // Planar output is a resample of one view, not a remap, so there is nothing to share.
+            for (const FOmniCaptureLayerEyes& Layer : Layers)
+            {
+                Results.Add(FOmniCaptureEquirectConverter::ConvertToPlanar(Settings, Layer.LeftEye));
+            }
+        }
+        else
+        {
+            Results = FOmniCaptureEquirectConverter::ConvertLayers(Settings, Layers);
+        }
+
+        FOmniCaptureEquirectResult BeautyResult;
+        for (int32 LayerIndex = 0; LayerIndex < Results.Num(); ++LayerIndex)
+        {
+            FOmniCaptureEquirectResult& Result = Results[LayerIndex];
+            if (LayerPasses[LayerIndex] == EOmniCaptureAuxiliaryPassType::None)
+            {
+                BeautyResult = MoveTemp(Result);
+            }
+            else if (Result.PixelData.IsValid())
+            {
+                FOmniCaptureLayerPayload Payload;
+                Payload.PixelData = MoveTemp(Result.PixelData);
+                Payload.bLinear = Result.bIsLinear;
+                Payload.Precision = Result.PixelPrecision;
+                Payload.PixelDataType = Result.PixelDataType;
+                OutAuxiliaryLayers.Add(GetAuxiliaryLayerName(LayerPasses[LayerIndex]), MoveTemp(Payload));
+            }
+        }
+        return BeautyResult;
+    }
 }
 
 void UOmniCaptureSubsystem::SetDiagnosticContext(const FString& StepName)
@@ -71,7 +154,7 @@ void UOmniCaptureSubsystem::SetDiagnosticContext(const FString& StepName)
 
 void UOmniCaptureSubsystem::AppendDiagnostic(EOmniCaptureDiagnosticLevel Level, const FString& Message, const FString& StepOverride)
 {
-    FOmniCaptureDiagnosticEntry& Entry = DiagnosticLog.AddDefaulted_GetRef();
+    FOmniCaptureDiagnosticEntry Entry;
     Entry.Timestamp = FDateTime::UtcNow();
     Entry.SecondsSinceCaptureStart = CaptureStartTime > 0.0 ? static_cast<float>(FPlatformTime::Seconds() - CaptureStartTime) : 0.0f;
     const int32 AttemptId = CurrentDiagnosticAttemptId > 0 ? CurrentDiagnosticAttemptId : (ActiveCaptureAttemptId > 0 ? ActiveCaptureAttemptId : 0);
@@ -79,12 +162,7 @@ void UOmniCaptureSubsystem::AppendDiagnostic(EOmniCaptureDiagnosticLevel Level,
     Entry.Step = StepOverride.IsEmpty() ? (CurrentDiagnosticStep.IsEmpty() ? TEXT("General") : CurrentDiagnosticStep) : StepOverride;
     Entry.Message = Message;
     Entry.Level = Level;
-
-    if (DiagnosticLog.Num() > GMaxOmniDiagnostics)
-    {
-        const int32 Excess = DiagnosticLog.Num() - GMaxOmniDiagnostics;
-        DiagnosticLog.RemoveAt(0, Excess, EAllowShrinking::No);
-    }
+    DiagnosticLog.Append(MoveTemp(Entry));
 
     if (Level == EOmniCaptureDiagnosticLevel::Error)
     {
@@ -218,7 +296,17 @@ void UOmniCaptureSubsystem::RecordCaptureCompletion(bool bFinalizeOutputs)
 
 void UOmniCaptureSubsystem::GetCaptureDiagnosticLog(TArray<FOmniCaptureDiagnosticEntry>& OutEntries) const
 {
-    OutEntries = DiagnosticLog;
+    DiagnosticLog.GetAll(OutEntries);
+}
+
+int64 UOmniCaptureSubsystem::GetDiagnosticsSince(int64 Sequence, TArray<FOmniCaptureDiagnosticEntry>& OutEntries) const
+{
+    return DiagnosticLog.GetSince(Sequence, OutEntries);
+}
+
+int32 UOmniCaptureSubsystem::GetDiagnosticResetGeneration() const
+{
+    return DiagnosticLog.GetResetGeneration();
 }
 
 void UOmniCaptureSubsystem::ClearCaptureDiagnosticLog()
@@ -239,10 +327,37 @@ void UOmniCaptureSubsystem::ClearCaptureDiagnosticLog()
 void UOmniCaptureSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
     Super::Initialize(Collection);
+    DiagnosticLog.SetSpillFile(FPaths::ProjectLogDir() / TEXT("OmniCapture") / TEXT("Diagnostics.log"));
     SetDiagnosticContext(TEXT("Subsystem"));
     LogDiagnosticMessage(ELogVerbosity::Log, TEXT("Subsystem"), TEXT("OmniCapture subsystem initialized"));
 }
 
+void UOmniCaptureSubsystem::GetUnfinishedCaptures(TArray<FString>& OutJournalPaths) const
+{
+    TArray<FOmniCaptureJournalRecovery> Recoveries;
+    FOmniCaptureJournal::FindUnfinished(Recoveries);
+
+    OutJournalPaths.Reset(Recoveries.Num());
+    for (const FOmniCaptureJournalRecovery& Recovery : Recoveries)
+    {
+        OutJournalPaths.Add(Recovery.JournalPath);
+    }
+}
+
+int32 UOmniCaptureSubsystem::ResumeUnfinishedCaptures(TArray<FString>& OutFinalizedFiles)
+{
+    OutFinalizedFiles.Reset();
+    if (bIsCapturing)
+    {
+        LogDiagnosticMessage(ELogVerbosity::Warning, TEXT("ResumeFinalize"), TEXT("Cannot resume unfinished captures while a capture is running."));
+        return 0;
+    }
+
+    const int32 Recovered = FOmniCaptureJournal::ResumeFinalizeAll(&OutFinalizedFiles);
+    LogDiagnosticMessage(ELogVerbosity::Log, TEXT("ResumeFinalize"), FString::Printf(TEXT("Recovered %d unfinished capture(s) into %d file(s)."), Recovered, OutFinalizedFiles.Num()));
+    return Recovered;
+}
+
 void UOmniCaptureSubsystem::Deinitialize()
 {
     EndCapture(false);
@@ -304,6 +419,7 @@ void UOmniCaptureSubsystem::BeginCapture(const FOmniCaptureSettings& InSettings)
     DroppedFrameCount = 0;
     RecordedSegmentDroppedFrames = 0;
     CurrentCaptureFPS = 0.0;
+    RenderedMegapixelsPerFrame = 0.0;
     LastFpsSampleTime = 0.0;
     FramesSinceLastFpsSample = 0;
     LastRuntimeWarningCheckTime = FPlatformTime::Seconds();
@@ -395,6 +511,12 @@ void UOmniCaptureSubsystem::BeginCapture(const FOmniCaptureSettings& InSettings)
 
     SetDiagnosticContext(TEXT("InitializeOutputs"));
     AppendDiagnostic(EOmniCaptureDiagnosticLevel::Info, TEXT("Initializing output writers."), TEXT("InitializeOutputs"));
+    CaptureJournal = MakeUnique<FOmniCaptureJournal>();
+    if (!CaptureJournal->Begin(ActiveSettings, BaseOutputDirectory, BaseOutputFileName))
+    {
+        AddWarningUnique(TEXT("Capture journal unavailable - this capture cannot be recovered after a crash."));
+        CaptureJournal.Reset();
+    }
     InitializeOutputWriters();
 
     OutputMuxer = MakeUnique<FOmniCaptureMuxer>();
@@ -412,6 +534,11 @@ void UOmniCaptureSubsystem::BeginCapture(const FOmniCaptureSettings& InSettings)
             return;
         }
 
+        if (Frame->Preview.IsRequested())
+        {
+            FulfilPreviewRequest(*Frame);
+        }
+
         if (OutputMuxer)
         {
             OutputMuxer->PushFrame(*Frame);
@@ -420,6 +547,7 @@ void UOmniCaptureSubsystem::BeginCapture(const FOmniCaptureSettings& InSettings)
             {
                 AudioStats.PendingPackets += AudioRecorder->GetPendingPacketCount();
             }
+            Telemetry.RecordAudioSync(AudioStats.DriftMilliseconds, AudioStats.MaxObservedDriftMilliseconds, AudioStats.PendingPackets);
         }
 
         switch (ActiveSettings.OutputFormat)
@@ -428,18 +556,25 @@ void UOmniCaptureSubsystem::BeginCapture(const FOmniCaptureSettings& InSettings)
             if (ImageWriter)
             {
                 const FString FileName = BuildFrameFileName(Frame->Metadata.FrameIndex, ActiveSettings.GetImageFileExtension());
-                ImageWriter->EnqueueFrame(MoveTemp(Frame), FileName);
+                const TArray<FString> DuplicateFileNames = BuildDuplicateFileNames(*Frame);
+                ImageWriter->EnqueueFrame(MoveTemp(Frame), FileName, DuplicateFileNames);
             }
             break;
         case EOmniOutputFormat::NVENCHardware:
             if (NVENCEncoder)
             {
-                NVENCEncoder->EnqueueFrame(*Frame);
+                FOmniCaptureStageScope::ResetThreadTimings();
+                {
+                    OMNICAPTURE_STAGE_SCOPE(EncoderSubmit);
+                    NVENCEncoder->EnqueueFrame(*Frame);
+                }
+                RecordStageTimings(FOmniCaptureStageScope::TakeThreadTimings(Frame->Metadata.FrameIndex));
             }
             if (bUsingNVENCImageFallback.Load() && ImageWriter && Frame.IsValid())
             {
                 const FString FileName = BuildFrameFileName(Frame->Metadata.FrameIndex, ActiveSettings.GetImageFileExtension());
-                ImageWriter->EnqueueFrame(MoveTemp(Frame), FileName);
+                const TArray<FString> DuplicateFileNames = BuildDuplicateFileNames(*Frame);
+                ImageWriter->EnqueueFrame(MoveTemp(Frame), FileName, DuplicateFileNames);
             }
             break;
         default:
@@ -449,21 +584,42 @@ void UOmniCaptureSubsystem::BeginCapture(const FOmniCaptureSettings& InSettings)
         if (RingBuffer.IsValid())
         {
             LatestRingBufferStats = RingBuffer->GetStats();
-            if (LatestRingBufferStats.DroppedFrames > DroppedFrameCount)
-            {
-                DroppedFrameCount = LatestRingBufferStats.DroppedFrames;
-                HandleDroppedFrame();
-            }
         }
+    },
+    [this](const FOmniCaptureFrameMetadata& Dropped)
+    {
+        // Runs inside Enqueue on the game thread, with the metadata of the frame the ring discarded.
+        HandleDroppedFrame(Dropped.FrameIndex, Dropped.Timecode);
     });
 
     InitializeAudioRecording();
+    JournalActiveSegmentOpened();
 
     bIsCapturing = true;
     bDroppedFrames = false;
     DroppedFrameCount = 0;
     FrameCounter = 0;
+    StageTimingHistory.Reset();
+    Telemetry.Reset();
+    LastTelemetryPublishTime = 0.0;
+    QualityGovernor.Initialize(ActiveSettings);
+    if (ActiveSettings.bWriteTelemetryCsv)
+    {
+        const FString TelemetryPath = BaseOutputDirectory / (BaseOutputFileName + TEXT("_Telemetry.csv"));
+        if (!Telemetry.OpenCsv(TelemetryPath))
+        {
+            LogDiagnosticMessage(ELogVerbosity::Warning, TEXT("InitializeOutputs"), FString::Printf(TEXT("Telemetry CSV could not be created at %s"), *TelemetryPath));
+        }
+    }
+    FramePacer.Reset(ActiveSettings.FramePacing, ActiveSettings.TargetFrameRate,
+        ActiveSettings.bEnableOfflineSampling ? ActiveSettings.TemporalSampleCount : 1,
+        ActiveSettings.bEnableOfflineSampling ? ActiveSettings.WarmUpFrameCount : 0);
+    ApplyFixedTimestep();
     CaptureStartTime = FPlatformTime::Seconds();
+    if (AudioRecorder)
+    {
+        AudioRecorder->SetCaptureClockOrigin(CaptureStartTime);
+    }
     CurrentSegmentStartTime = CaptureStartTime;
     LastSegmentSizeCheckTime = CurrentSegmentStartTime;
     LastRuntimeWarningCheckTime = CurrentSegmentStartTime;
@@ -478,9 +634,19 @@ void UOmniCaptureSubsystem::BeginCapture(const FOmniCaptureSettings& InSettings)
     const TCHAR* LayoutLabel = ActiveSettings.Mode == EOmniCaptureMode::Stereo
         ? (ActiveSettings.StereoLayout == EOmniCaptureStereoLayout::TopBottom ? TEXT("Top-Bottom") : TEXT("Side-by-Side"))
         : TEXT("Mono");
-    const TCHAR* ProjectionLabel = ActiveSettings.IsPlanar()
-        ? TEXT("Planar")
-        : (ActiveSettings.IsFisheye() ? TEXT("Fisheye") : TEXT("Equirect"));
+    const TCHAR* ProjectionLabel = TEXT("Equirect");
+    switch (ActiveSettings.Projection)
+    {
+    case EOmniCaptureProjection::Planar2D: ProjectionLabel = TEXT("Planar"); break;
+    case EOmniCaptureProjection::Fisheye: ProjectionLabel = TEXT("Fisheye"); break;
+    case EOmniCaptureProjection::Cylindrical: ProjectionLabel = TEXT("Cylindrical"); break;
+    case EOmniCaptureProjection::FullDome: ProjectionLabel = TEXT("FullDome"); break;
+    case EOmniCaptureProjection::SphericalMirror: ProjectionLabel = TEXT("SphericalMirror"); break;
+    case EOmniCaptureProjection::Cubemap: ProjectionLabel = TEXT("Cubemap3x2"); break;
+    case EOmniCaptureProjection::EquiAngularCubemap: ProjectionLabel = TEXT("EAC"); break;
+    case EOmniCaptureProjection::FoveatedEquirectangular: ProjectionLabel = TEXT("FoveatedEquirect"); break;
+    default: break;
+    }
     const FString BeginSummary = FString::Printf(TEXT("Attempt #%d -> Begin capture %s %s (%dx%d -> %dx%d, %s %s) (%s, %s, %s) -> %s"),
         ActiveCaptureAttemptId,
         ActiveSettings.Mode == EOmniCaptureMode::Stereo ? TEXT("Stereo") : TEXT("Mono"),
@@ -515,10 +681,18 @@ void UOmniCaptureSubsystem::EndCapture(bool bFinalize)
     State = EOmniCaptureState::Finalizing;
 
     RestoreRenderFeatureOverrides();
+    RestoreFixedTimestep();
     DynamicParameterStartTime = 0.0;
     LastDynamicInterPupillaryDistance = -1.0f;
     LastDynamicConvergence = -1.0f;
 
+    if (FramePacer.IsFixedTimestep())
+    {
+        const double Throughput = GetCaptureThroughput();
+        LogDiagnosticMessage(ELogVerbosity::Log, TEXT("EndCapture"), FString::Printf(TEXT("Offline capture rendered %lld frames at %.2f frames/s (%.2fx realtime, %lld warm-up ticks)"),
+            FramePacer.GetCapturedTicks(), Throughput, Throughput / FramePacer.GetFrameRate().AsDecimal(), FramePacer.GetWarmUpTicks()));
+    }
+
     DestroyTickActor();
     DestroyPreviewActor();
     DestroyRig();
@@ -532,12 +706,21 @@ void UOmniCaptureSubsystem::EndCapture(bool bFinalize)
     }
 
     ShutdownOutputWriters(bFinalize);
+    PublishTelemetry(true);
+    Telemetry.CloseCsv();
+    ActiveSettings.RemapQuality = QualityGovernor.GetBaselineState().RemapQuality;
     if (OutputMuxer)
     {
         OutputMuxer->EndRealtimeSession();
     }
     FinalizeOutputs(bFinalize);
 
+    if (CaptureJournal)
+    {
+        CaptureJournal->End(bFinalize);
+        CaptureJournal.Reset();
+    }
+
     RecordCaptureCompletion(bFinalize);
 
     SetDiagnosticContext(TEXT("Idle"));
@@ -682,45 +865,29 @@ bool UOmniCaptureSubsystem::CapturePanoramaStill(const FOmniCaptureSettings& InS
             return FOmniCaptureEquirectConverter::ConvertToFisheye(CaptureSettings, Left, Right);
         }
 
+        if (CaptureSettings.UsesOmniDirectionalStereo())
+        {
+            return FOmniCaptureEquirectConverter::ConvertToODS(CaptureSettings, Left, Right);
+        }
+
+        if (FOmniCaptureProjectionRemap::SupportsProjection(CaptureSettings.Projection))
+        {
+            return FOmniCaptureEquirectConverter::ConvertToProjection(CaptureSettings, Left, Right);
+        }
+
         return FOmniCaptureEquirectConverter::ConvertToEquirectangular(CaptureSettings, Left, Right);
     };
 
-    FOmniCaptureEquirectResult Result = ConvertFrame(StillSettings, LeftEye, RightEye);
-
     TMap<FName, FOmniCaptureLayerPayload> AuxiliaryLayers;
+    const bool bBatchBeauty = CanBatchBeautyLayer(StillSettings);
+    FOmniCaptureEquirectResult Result;
     if (StillSettings.AuxiliaryPasses.Num() > 0)
     {
-        auto BuildAuxEye = [](const FOmniEyeCapture& SourceEye, EOmniCaptureAuxiliaryPassType PassType)
-        {
-            FOmniEyeCapture AuxEye;
-            AuxEye.ActiveFaceCount = SourceEye.ActiveFaceCount;
-            for (int32 FaceIndex = 0; FaceIndex < AuxEye.ActiveFaceCount && FaceIndex < UE_ARRAY_COUNT(AuxEye.Faces); ++FaceIndex)
-            {
-                AuxEye.Faces[FaceIndex].RenderTarget = SourceEye.Faces[FaceIndex].GetAuxiliaryRenderTarget(PassType);
-            }
-            return AuxEye;
-        };
-
-        for (EOmniCaptureAuxiliaryPassType PassType : StillSettings.AuxiliaryPasses)
-        {
-            if (PassType == EOmniCaptureAuxiliaryPassType::None)
-            {
-                continue;
-            }
-
-            const FOmniEyeCapture AuxLeft = BuildAuxEye(LeftEye, PassType);
-            const FOmniEyeCapture AuxRight = BuildAuxEye(RightEye, PassType);
-            FOmniCaptureEquirectResult AuxResult = ConvertFrame(StillSettings, AuxLeft, AuxRight);
-            if (AuxResult.PixelData.IsValid())
-            {
-                FOmniCaptureLayerPayload Payload;
-                Payload.PixelData = MoveTemp(AuxResult.PixelData);
-                Payload.bLinear = AuxResult.bIsLinear;
-                Payload.Precision = AuxResult.PixelPrecision;
-                Payload.PixelDataType = AuxResult.PixelDataType;
-                AuxiliaryLayers.Add(GetAuxiliaryLayerName(PassType), MoveTemp(Payload));
-            }
-        }
+        Result = ConvertFrameLayers(StillSettings, LeftEye, RightEye, bBatchBeauty, AuxiliaryLayers);
+    }
+    if (!bBatchBeauty)
+    {
+        Result = ConvertFrame(StillSettings, LeftEye, RightEye);
     }
 
     World->DestroyActor(TempRig);
@@ -748,9 +915,12 @@ bool UOmniCaptureSubsystem::CapturePanoramaStill(const FOmniCaptureSettings& InS
     FOmniCaptureImageWriter Writer;
     FOmniCaptureSettings WriterSettings = StillSettings;
     WriterSettings.OutputDirectory = OutputDirectory;
-    WriterSettings.OutputFileName = BaseName;
+    // Stream formats such as Y4M name their file after the sequence, so give the writer the still's own stem.
+    WriterSettings.OutputFileName = FPaths::GetBaseFilename(FileName);
     Writer.Initialize(WriterSettings, OutputDirectory);
 
+    FOmniCaptureEquirectConverter::PackOutputPixels(StillSettings, Result);
+
     TUniquePtr<FOmniCaptureFrame> Frame = MakeUnique<FOmniCaptureFrame>();
     Frame->Metadata.FrameIndex = 0;
     Frame->Metadata.Timecode = 0.0;
@@ -830,11 +1000,18 @@ FString UOmniCaptureSubsystem::GetStatusString() const
         break;
     }
 
-    Status += FString::Printf(TEXT(" | Frames:%d Pending:%d Dropped:%d Blocked:%d"), FrameCounter, LatestRingBufferStats.PendingFrames, LatestRingBufferStats.DroppedFrames, LatestRingBufferStats.BlockedPushes);
+    const FOmniCaptureTelemetrySnapshot Snapshot = Telemetry.GetSnapshot();
+    Status += FString::Printf(TEXT(" | Frames:%d Pending:%d Dropped:%d Blocked:%d"), FrameCounter, Snapshot.RingBufferPending, Snapshot.DroppedFrames, Snapshot.RingBufferBlockedPushes);
+    Status += FString::Printf(TEXT(" | Writer:%d Write:%.1f MB/s In Flight:%.0f MB"), Snapshot.WriterPendingFrames, Snapshot.BytesWrittenPerSecond / (1024.0 * 1024.0), Snapshot.MemoryInFlightBytes / (1024.0 * 1024.0));
     Status += FString::Printf(TEXT(" | FPS:%.2f"), CurrentCaptureFPS);
+    Status += FString::Printf(TEXT(" | Rendered:%.1f MP"), RenderedMegapixelsPerFrame);
+    if (FramePacer.IsFixedTimestep())
+    {
+        Status += FString::Printf(TEXT(" | Throughput:%.2f fps (%.2fx realtime)"), GetCaptureThroughput(), GetCaptureThroughput() / FramePacer.GetFrameRate().AsDecimal());
+    }
     Status += FString::Printf(TEXT(" | Segment:%d"), CurrentSegmentIndex);
 
-    Status += FString::Printf(TEXT(" | Audio Drift:%.2fms (Max %.2fms) Pending:%d"), AudioStats.DriftMilliseconds, AudioStats.MaxObservedDriftMilliseconds, AudioStats.PendingPackets);
+    Status += FString::Printf(TEXT(" | Audio Drift:%.2fms (Max %.2fms) Pending:%d"), Snapshot.AudioDriftMilliseconds, Snapshot.MaxAudioDriftMilliseconds, Snapshot.AudioPendingPackets);
     if (AudioStats.bInError)
     {
         Status += TEXT(" | AudioSyncError");
@@ -858,7 +1035,7 @@ FOmniAudioSyncStats UOmniCaptureSubsystem::GetAudioSyncStats() const
     return AudioStats;
 }
 
-UTexture2D* UOmniCaptureSubsystem::GetPreviewTexture() const
+UTexture* UOmniCaptureSubsystem::GetPreviewTexture() const
 {
     if (const AOmniCapturePreviewActor* Preview = PreviewActor.Get())
     {
@@ -1013,11 +1190,30 @@ void UOmniCaptureSubsystem::InitializeOutputWriters()
     RecordedVideoPath.Reset();
     bUsingNVENCImageFallback.Store(false);
 
+    FrameIndexWriter = MakeUnique<FOmniCaptureFrameIndexWriter>();
+    if (!FrameIndexWriter->Open(ActiveSettings.OutputDirectory, ActiveSettings.OutputFileName, ActiveSettings))
+    {
+        LogDiagnosticMessage(ELogVerbosity::Warning, TEXT("InitializeOutputs"), TEXT("Frame index sidecar could not be created; the manifest will be rebuilt from memory only."));
+        FrameIndexWriter.Reset();
+    }
+
     switch (ActiveSettings.OutputFormat)
     {
     case EOmniOutputFormat::ImageSequence:
         ImageWriter = MakeUnique<FOmniCaptureImageWriter>();
         ImageWriter->Initialize(ActiveSettings, ActiveSettings.OutputDirectory);
+        ImageWriter->SetFrameWrittenCallback([this, IndexWriter = FrameIndexWriter.Get()](int32 FrameIndex, int64 FileSizeBytes)
+        {
+            if (IndexWriter)
+            {
+                IndexWriter->AppendEncodedSize(FrameIndex, FileSizeBytes);
+            }
+            Telemetry.RecordBytesWritten(FileSizeBytes);
+        });
+        ImageWriter->SetStageTimingCallback([this](const FOmniCaptureFrameStageTimings& Timings)
+        {
+            RecordStageTimings(Timings);
+        });
         AppendDiagnostic(EOmniCaptureDiagnosticLevel::Info, TEXT("Image sequence writer initialized."), TEXT("InitializeOutputs"));
         break;
     case EOmniOutputFormat::NVENCHardware:
@@ -1038,6 +1234,14 @@ void UOmniCaptureSubsystem::InitializeOutputWriters()
         {
             ImageWriter = MakeUnique<FOmniCaptureImageWriter>();
             ImageWriter->Initialize(ActiveSettings, ActiveSettings.OutputDirectory);
+            ImageWriter->SetFrameWrittenCallback([this](int32 FrameIndex, int64 FileSizeBytes)
+            {
+                Telemetry.RecordBytesWritten(FileSizeBytes);
+            });
+            ImageWriter->SetStageTimingCallback([this](const FOmniCaptureFrameStageTimings& Timings)
+            {
+                RecordStageTimings(Timings);
+            });
             bUsingNVENCImageFallback.Store(true);
             AppendDiagnostic(EOmniCaptureDiagnosticLevel::Info, TEXT("Image sequence writer initialized for NVENC fallback."), TEXT("InitializeOutputs"));
         }
@@ -1065,6 +1269,12 @@ void UOmniCaptureSubsystem::ShutdownOutputWriters(bool bFinalizeOutputs)
         }
         NVENCEncoder.Reset();
     }
+
+    if (FrameIndexWriter)
+    {
+        FrameIndexWriter->Close();
+        FrameIndexWriter.Reset();
+    }
 }
 
 void UOmniCaptureSubsystem::FinalizeOutputs(bool bFinalizeOutputs)
@@ -1109,6 +1319,10 @@ void UOmniCaptureSubsystem::FinalizeOutputs(bool bFinalizeOutputs)
     }
 
     LastFinalizedOutput.Empty();
+    if (OutputMuxer)
+    {
+        OutputMuxer->SetQualityChanges(QualityGovernor.GetChanges());
+    }
 
     for (const FOmniCaptureSegmentRecord& Segment : CompletedSegments)
     {
@@ -1124,7 +1338,13 @@ void UOmniCaptureSubsystem::FinalizeOutputs(bool bFinalizeOutputs)
         OutputMuxer->Initialize(SegmentSettings, Segment.Directory);
         OutputMuxer->BeginRealtimeSession(SegmentSettings);
 
-        const bool bSuccess = OutputMuxer->FinalizeCapture(SegmentSettings, Segment.Frames, Segment.AudioPath, Segment.VideoPath, Segment.DroppedFrames);
+        FOmniCaptureStageScope::ResetThreadTimings();
+        bool bSuccess = false;
+        {
+            OMNICAPTURE_STAGE_SCOPE(Mux);
+            bSuccess = OutputMuxer->FinalizeCapture(SegmentSettings, Segment.Frames, Segment.AudioPath, Segment.VideoPath, Segment.DroppedFrames);
+        }
+        RecordStageTimings(FOmniCaptureStageScope::TakeThreadTimings(INDEX_NONE));
         OutputMuxer->EndRealtimeSession();
 
         const FString FinalVideoPath = Segment.Directory / (Segment.BaseFileName + TEXT(".mp4"));
@@ -1451,6 +1671,7 @@ void UOmniCaptureSubsystem::InitializeAudioRecording()
     AudioRecorder = MakeUnique<FOmniCaptureAudioRecorder>();
     if (AudioRecorder->Initialize(World, ActiveSettings))
     {
+        AudioRecorder->SetCaptureClockOrigin(CaptureStartTime);
         AudioRecorder->Start();
         AppendDiagnostic(EOmniCaptureDiagnosticLevel::Info, TEXT("Audio recorder started."), TEXT("Audio"));
     }
@@ -1488,25 +1709,43 @@ void UOmniCaptureSubsystem::TickCapture(float DeltaTime)
     {
         UpdateDynamicStereoParameters();
         RotateSegmentIfNeeded();
-        CaptureFrame();
+
+        // Ticks between output slots render nothing.
+        const FOmniCaptureFramePacingStep PacingStep = FramePacer.Advance(DeltaTime);
+        if (PacingStep.bCapture)
+        {
+            CaptureFrame(PacingStep);
+        }
     }
 
     UpdateRuntimeWarnings();
+    PublishTelemetry(false);
 }
 
-void UOmniCaptureSubsystem::CaptureFrame()
+void UOmniCaptureSubsystem::CaptureFrame(const FOmniCaptureFramePacingStep& PacingStep)
 {
     if (!RigActor.IsValid() || !RingBuffer)
     {
-        HandleDroppedFrame();
+        HandleDroppedFrame(FrameCounter + PacingStep.DuplicateSlots, GetFrameTimecode(PacingStep));
         return;
     }
 
+    FOmniCaptureStageScope::ResetThreadTimings();
+    // The quality governor may thin the auxiliary passes out to every Nth frame.
+    const bool bCaptureAuxiliary = ActiveSettings.AuxiliaryPasses.Num() > 0
+        && (FrameCounter % FMath::Max(1, QualityGovernor.GetState().AuxiliaryPassInterval)) == 0;
     FOmniEyeCapture LeftEye;
     FOmniEyeCapture RightEye;
-    RigActor->Capture(LeftEye, RightEye);
+    {
+        OMNICAPTURE_STAGE_SCOPE(RigCapture);
+        RigActor->Capture(LeftEye, RightEye, bCaptureAuxiliary);
+    }
+    RenderedMegapixelsPerFrame = static_cast<double>(RigActor->GetLastCapturedPixelCount()) / 1.0e6;
 
-    FlushRenderingCommands();
+    {
+        OMNICAPTURE_STAGE_SCOPE(RenderFlush);
+        FlushRenderingCommands();
+    }
 
     auto ConvertActiveFrame = [](const FOmniCaptureSettings& CaptureSettings, const FOmniEyeCapture& Left, const FOmniEyeCapture& Right)
     {
@@ -1520,63 +1759,51 @@ void UOmniCaptureSubsystem::CaptureFrame()
             return FOmniCaptureEquirectConverter::ConvertToFisheye(CaptureSettings, Left, Right);
         }
 
+        if (CaptureSettings.UsesOmniDirectionalStereo())
+        {
+            return FOmniCaptureEquirectConverter::ConvertToODS(CaptureSettings, Left, Right);
+        }
+
+        if (FOmniCaptureProjectionRemap::SupportsProjection(CaptureSettings.Projection))
+        {
+            return FOmniCaptureEquirectConverter::ConvertToProjection(CaptureSettings, Left, Right);
+        }
+
         return FOmniCaptureEquirectConverter::ConvertToEquirectangular(CaptureSettings, Left, Right);
     };
 
-    FOmniCaptureEquirectResult ConversionResult = ConvertActiveFrame(ActiveSettings, LeftEye, RightEye);
-
     TMap<FName, FOmniCaptureLayerPayload> AuxiliaryLayers;
-    if (ActiveSettings.AuxiliaryPasses.Num() > 0)
+    const bool bBatchBeauty = bCaptureAuxiliary && CanBatchBeautyLayer(ActiveSettings);
+    FOmniCaptureEquirectResult ConversionResult;
+    if (bCaptureAuxiliary)
     {
-        auto BuildAuxiliaryEye = [](const FOmniEyeCapture& SourceEye, EOmniCaptureAuxiliaryPassType PassType)
-        {
-            FOmniEyeCapture AuxEye;
-            AuxEye.ActiveFaceCount = SourceEye.ActiveFaceCount;
-            for (int32 FaceIndex = 0; FaceIndex < AuxEye.ActiveFaceCount && FaceIndex < UE_ARRAY_COUNT(AuxEye.Faces); ++FaceIndex)
-            {
-                AuxEye.Faces[FaceIndex].RenderTarget = SourceEye.Faces[FaceIndex].GetAuxiliaryRenderTarget(PassType);
-            }
-            return AuxEye;
-        };
-
-        for (EOmniCaptureAuxiliaryPassType PassType : ActiveSettings.AuxiliaryPasses)
-        {
-            if (PassType == EOmniCaptureAuxiliaryPassType::None)
-            {
-                continue;
-            }
-
-            const FOmniEyeCapture AuxLeft = BuildAuxiliaryEye(LeftEye, PassType);
-            const FOmniEyeCapture AuxRight = BuildAuxiliaryEye(RightEye, PassType);
-            FOmniCaptureEquirectResult AuxResult = ConvertActiveFrame(ActiveSettings, AuxLeft, AuxRight);
-            if (AuxResult.PixelData.IsValid())
-            {
-                FOmniCaptureLayerPayload Payload;
-                Payload.PixelData = MoveTemp(AuxResult.PixelData);
-                Payload.bLinear = AuxResult.bIsLinear;
-                Payload.Precision = AuxResult.PixelPrecision;
-                Payload.PixelDataType = AuxResult.PixelDataType;
-                AuxiliaryLayers.Add(GetAuxiliaryLayerName(PassType), MoveTemp(Payload));
-            }
-        }
+        OMNICAPTURE_STAGE_SCOPE(AuxiliaryPasses);
+        ConversionResult = ConvertFrameLayers(ActiveSettings, LeftEye, RightEye, bBatchBeauty, AuxiliaryLayers);
     }
-    const bool bRequiresGPU = ActiveSettings.OutputFormat == EOmniOutputFormat::NVENCHardware;
-    if (!ConversionResult.PixelData.IsValid())
+    if (!bBatchBeauty)
     {
-        HandleDroppedFrame();
-        return;
+        OMNICAPTURE_STAGE_SCOPE(Conversion);
+        ConversionResult = ConvertActiveFrame(ActiveSettings, LeftEye, RightEye);
     }
 
-    if (bRequiresGPU && !ConversionResult.Texture.IsValid())
+    const bool bRequiresGPU = ActiveSettings.OutputFormat == EOmniOutputFormat::NVENCHardware;
+    if (!ConversionResult.PixelData.IsValid() || (bRequiresGPU && !ConversionResult.Texture.IsValid()))
     {
-        HandleDroppedFrame();
+        HandleDroppedFrame(FrameCounter + PacingStep.DuplicateSlots, GetFrameTimecode(PacingStep));
         return;
     }
 
+    // Duplicates of this frame take the indices of the slots the tick ran past, ahead of the frame itself.
+    const int32 FirstFrameIndex = FrameCounter;
+    FrameCounter += PacingStep.DuplicateSlots;
+
     TUniquePtr<FOmniCaptureFrame> Frame = MakeUnique<FOmniCaptureFrame>();
     Frame->Metadata.FrameIndex = FrameCounter++;
-    Frame->Metadata.Timecode = FPlatformTime::Seconds() - CaptureStartTime;
-    Frame->Metadata.bKeyFrame = (Frame->Metadata.FrameIndex % ActiveSettings.Quality.GOPLength) == 0;
+    Frame->Metadata.Timecode = GetFrameTimecode(PacingStep);
+    // Duplicates are never keyframes, so a GOP boundary that falls on one of their slots moves to this frame.
+    const int32 GOPLength = FMath::Max(1, ActiveSettings.Quality.GOPLength);
+    Frame->Metadata.bKeyFrame = FirstFrameIndex == 0 || (Frame->Metadata.FrameIndex / GOPLength) != ((FirstFrameIndex - 1) / GOPLength);
+    Frame->Metadata.SkippedSlots = PacingStep.DuplicateSlots > 0 ? 0 : PacingStep.SkippedSlots;
 
     ++FramesSinceLastFpsSample;
     const double NowSeconds = FPlatformTime::Seconds();
@@ -1593,6 +1820,28 @@ void UOmniCaptureSubsystem::CaptureFrame()
         LastFpsSampleTime = NowSeconds;
     }
 
+    // The preview reads the converted pixels before they are packed, and only on frames it will actually show. GPU
+    // frames are filtered on the GPU; CPU frames carry a request the ring buffer worker fulfils before writing them.
+    FOmniCapturePreviewRequest PreviewRequest;
+    if (PreviewActor.IsValid())
+    {
+        const double Now = FPlatformTime::Seconds();
+        if (PreviewFrameInterval <= 0.0 || (Now - LastPreviewUpdateTime) >= PreviewFrameInterval)
+        {
+            OMNICAPTURE_STAGE_SCOPE(Preview);
+            PreviewRequest = PreviewActor->UpdatePreviewTexture(ConversionResult, ActiveSettings);
+            LastPreviewUpdateTime = Now;
+        }
+    }
+
+    {
+        OMNICAPTURE_STAGE_SCOPE(Conversion);
+        // Packing replaces the pixels; a pending preview keeps the unpacked ones instead of letting them be freed.
+        const EOmniCapturePixelDataType UnpackedPixelDataType = ConversionResult.PixelDataType;
+        FOmniCaptureEquirectConverter::PackOutputPixels(ActiveSettings, ConversionResult, PreviewRequest.IsRequested() ? &PreviewRequest.UnpackedPixels : nullptr);
+        PreviewRequest.UnpackedPixelDataType = UnpackedPixelDataType;
+    }
+    Frame->Preview = MoveTemp(PreviewRequest);
     Frame->PixelData = MoveTemp(ConversionResult.PixelData);
     Frame->GPUSource = ConversionResult.OutputTarget;
     Frame->Texture = ConversionResult.Texture;
@@ -1620,33 +1869,187 @@ void UOmniCaptureSubsystem::CaptureFrame()
         Frame->EncoderTextures.Add(Frame->Texture);
     }
 
+    if (PacingStep.DuplicateSlots > 0)
+    {
+        OMNICAPTURE_STAGE_SCOPE(Enqueue);
+        AddDuplicateFrames(*Frame, FirstFrameIndex, PacingStep);
+    }
+
     if (AudioRecorder)
     {
         AudioRecorder->GatherAudio(Frame->Metadata.Timecode, Frame->AudioPackets);
     }
 
     CapturedFrameMetadata.Add(Frame->Metadata);
+    if (FrameIndexWriter)
+    {
+        FrameIndexWriter->AppendFrame(Frame->Metadata);
+    }
+    if (CaptureJournal)
+    {
+        CaptureJournal->RecordFrame(CurrentSegmentIndex, Frame->Metadata.FrameIndex);
+    }
 
     if (ImageWriter && (ActiveSettings.OutputFormat == EOmniOutputFormat::ImageSequence || bUsingNVENCImageFallback.Load()))
     {
         bCapturedImageSequenceThisSegment = true;
     }
 
-    RingBuffer->Enqueue(MoveTemp(Frame));
+    const int32 CapturedFrameIndex = Frame->Metadata.FrameIndex;
+    {
+        const void* RawData = nullptr;
+        int64 FrameBytes = 0;
+        if (!Frame->PixelData.IsValid() || !Frame->PixelData->GetRawData(RawData, FrameBytes))
+        {
+            FrameBytes = 0;
+        }
+        Telemetry.RecordFrameCaptured(FrameBytes);
+    }
+    {
+        OMNICAPTURE_STAGE_SCOPE(Enqueue);
+        RingBuffer->Enqueue(MoveTemp(Frame));
+    }
+    RecordStageTimings(FOmniCaptureStageScope::TakeThreadTimings(CapturedFrameIndex));
 
     if (RingBuffer)
     {
         LatestRingBufferStats = RingBuffer->GetStats();
     }
+}
 
-    if (PreviewActor.IsValid())
+void UOmniCaptureSubsystem::FulfilPreviewRequest(FOmniCaptureFrame& Frame)
+{
+    // Runs on the ring buffer worker; only the filtered pixels go back to the game thread.
+    FOmniCapturePreviewRequest Request = MoveTemp(Frame.Preview);
+    Frame.Preview = FOmniCapturePreviewRequest();
+
+    const bool bUseUnpacked = Request.UnpackedPixels.IsValid();
+    const FImagePixelData* Source = bUseUnpacked ? Request.UnpackedPixels.Get() : Frame.PixelData.Get();
+    const EOmniCapturePixelDataType SourceType = bUseUnpacked ? Request.UnpackedPixelDataType : Frame.PixelDataType;
+    TArray<FColor> Pixels;
+    if (!Source || !FOmniCapturePreviewDownsample::Downsample(*Source, SourceType, Request.ViewRect, Request.PreviewSize, Pixels))
     {
-        const double Now = FPlatformTime::Seconds();
-        if (PreviewFrameInterval <= 0.0 || (Now - LastPreviewUpdateTime) >= PreviewFrameInterval)
+        return;
+    }
+
+    AsyncTask(ENamedThreads::GameThread, [Target = Request.Target, PreviewSize = Request.PreviewSize, Pixels = MoveTemp(Pixels)]() mutable
+    {
+        if (AOmniCapturePreviewActor* Actor = Target.Get())
         {
-            PreviewActor->UpdatePreviewTexture(ConversionResult, ActiveSettings);
-            LastPreviewUpdateTime = Now;
+            Actor->UploadPreviewPixels(PreviewSize, MoveTemp(Pixels));
         }
+    });
+}
+
+void UOmniCaptureSubsystem::AddDuplicateFrames(FOmniCaptureFrame& Source, int32 FirstFrameIndex, const FOmniCaptureFramePacingStep& PacingStep)
+{
+    // Duplicates are metadata only and ride on the source frame; the writers repeat its beauty pass for each one.
+    Source.Duplicates.Reserve(PacingStep.DuplicateSlots);
+    for (int32 Offset = 0; Offset < PacingStep.DuplicateSlots; ++Offset)
+    {
+        FOmniCaptureFrameMetadata& Duplicate = Source.Duplicates.AddDefaulted_GetRef();
+        Duplicate.FrameIndex = FirstFrameIndex + Offset;
+        Duplicate.Timecode = FramePacer.GetSlotTimecode(PacingStep.GetFirstSlot() + Offset);
+        // A repeated image never starts a GOP; the encoder places keyframes on captured frames only.
+        Duplicate.bKeyFrame = false;
+        Duplicate.bDuplicate = true;
+        Duplicate.SkippedSlots = Offset == 0 ? PacingStep.SkippedSlots : 0;
+
+        // Audio for the duplicate slots travels with the source frame, ahead of its own packets.
+        if (AudioRecorder)
+        {
+            AudioRecorder->GatherAudio(Duplicate.Timecode, Source.AudioPackets);
+        }
+
+        CapturedFrameMetadata.Add(Duplicate);
+        if (FrameIndexWriter)
+        {
+            FrameIndexWriter->AppendFrame(Duplicate);
+        }
+        if (CaptureJournal)
+        {
+            CaptureJournal->RecordFrame(CurrentSegmentIndex, Duplicate.FrameIndex);
+        }
+    }
+}
+
+TArray<FString> UOmniCaptureSubsystem::BuildDuplicateFileNames(const FOmniCaptureFrame& Frame) const
+{
+    TArray<FString> FileNames;
+    FileNames.Reserve(Frame.Duplicates.Num());
+    for (const FOmniCaptureFrameMetadata& Duplicate : Frame.Duplicates)
+    {
+        FileNames.Add(BuildFrameFileName(Duplicate.FrameIndex, ActiveSettings.GetImageFileExtension()));
+    }
+    return FileNames;
+}
+
+void UOmniCaptureSubsystem::RecordStageTimings(const FOmniCaptureFrameStageTimings& Timings)
+{
+    StageTimingHistory.Record(Timings);
+    Telemetry.RecordStageTimings(Timings);
+}
+
+void UOmniCaptureSubsystem::PublishTelemetry(bool bForce)
+{
+    const double Now = FPlatformTime::Seconds();
+    if (!bForce && (Now - LastTelemetryPublishTime) < FMath::Max(0.05, static_cast<double>(ActiveSettings.TelemetryIntervalSeconds)))
+    {
+        return;
+    }
+    LastTelemetryPublishTime = Now;
+
+    // Gauges come straight from the atomics their owners keep, so sampling them never blocks the pipeline.
+    FOmniCaptureTelemetrySnapshot Gauges;
+    Gauges.DroppedFrames = DroppedFrameCount;
+    Gauges.RingBufferCapacity = ActiveSettings.RingBufferCapacity;
+    if (RingBuffer)
+    {
+        const FOmniCaptureRingBufferStats RingStats = RingBuffer->GetStats();
+        Gauges.RingBufferPending = RingStats.PendingFrames;
+        Gauges.RingBufferBlockedPushes = RingStats.BlockedPushes;
+        Gauges.DroppedFrames = FMath::Max(Gauges.DroppedFrames, RingStats.DroppedFrames);
+    }
+    if (ImageWriter)
+    {
+        Gauges.WriterPendingFrames = ImageWriter->GetPendingFrameCount();
+    }
+    if (NVENCEncoder)
+    {
+        Gauges.EncodedBytes = NVENCEncoder->GetEncodedBytes();
+        Gauges.EncodedPackets = NVENCEncoder->GetEncodedPacketCount();
+    }
+    Telemetry.Publish(CaptureStartTime > 0.0 ? Now - CaptureStartTime : 0.0, Gauges);
+
+    if (bIsCapturing && QualityGovernor.Update(Telemetry.GetSnapshot(), FrameCounter))
+    {
+        const FOmniCaptureQualityChange& Change = QualityGovernor.GetChanges().Last();
+        LogDiagnosticMessage(Change.bDegraded ? ELogVerbosity::Warning : ELogVerbosity::Log, TEXT("QualityGovernor"),
+            FString::Printf(TEXT("%s %s at frame %d (level %d of %d): %s"),
+                Change.bDegraded ? TEXT("Lowered") : TEXT("Restored"),
+                LexToString(Change.Knob),
+                Change.FrameIndex,
+                Change.Level,
+                QualityGovernor.GetKnobCount(),
+                *Change.Reason));
+        ApplyQualityState(QualityGovernor.GetState());
+    }
+}
+
+void UOmniCaptureSubsystem::ApplyQualityState(const FOmniCaptureQualityState& QualityState)
+{
+    // The auxiliary pass interval is read by CaptureFrame; everything else is pushed to its owner here.
+    if (ImageWriter)
+    {
+        ImageWriter->SetPNGCompressionLevel(QualityState.PNGCompressionLevel);
+    }
+    PreviewFrameInterval = (ActiveSettings.bEnablePreviewWindow && ActiveSettings.PreviewFrameRate > 0.f)
+        ? (1.0 / (FMath::Max(1.0f, ActiveSettings.PreviewFrameRate) * QualityState.PreviewRateScale))
+        : 0.0;
+    ActiveSettings.RemapQuality = QualityState.RemapQuality;
+    if (RigActor.IsValid())
+    {
+        RigActor->SetFaceResolutionScale(QualityState.FaceResolutionScale);
     }
 }
 
@@ -1925,11 +2328,56 @@ void UOmniCaptureSubsystem::RestoreRenderFeatureOverrides()
     LastDynamicConvergence = -1.0f;
 }
 
-void UOmniCaptureSubsystem::HandleDroppedFrame()
+void UOmniCaptureSubsystem::ApplyFixedTimestep()
+{
+    if (!FramePacer.IsFixedTimestep() || bFixedTimestepApplied)
+    {
+        return;
+    }
+
+    // Without a frame rate lock the engine does not wait between fixed steps, so capture runs as fast as it renders.
+    bPreviousUseFixedTimeStep = FApp::UseFixedTimeStep();
+    PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+    FApp::SetUseFixedTimeStep(true);
+    FApp::SetFixedDeltaTime(FramePacer.GetFixedDeltaSeconds());
+    bFixedTimestepApplied = true;
+
+    LogDiagnosticMessage(ELogVerbosity::Log, TEXT("BeginCapture"), FString::Printf(TEXT("Offline capture locked to %.6f s per tick (%d/%d fps)"),
+        FramePacer.GetFixedDeltaSeconds(), FramePacer.GetFrameRate().Numerator, FramePacer.GetFrameRate().Denominator));
+}
+
+void UOmniCaptureSubsystem::RestoreFixedTimestep()
+{
+    if (!bFixedTimestepApplied)
+    {
+        return;
+    }
+
+    FApp::SetUseFixedTimeStep(bPreviousUseFixedTimeStep);
+    FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+    bFixedTimestepApplied = false;
+}
+
+double UOmniCaptureSubsystem::GetCaptureThroughput() const
+{
+    const double Elapsed = CaptureStartTime > 0.0 ? FPlatformTime::Seconds() - CaptureStartTime : 0.0;
+    return Elapsed > 0.0 ? static_cast<double>(FramePacer.GetCapturedTicks()) / Elapsed : 0.0;
+}
+
+double UOmniCaptureSubsystem::GetFrameTimecode(const FOmniCaptureFramePacingStep& PacingStep) const
+{
+    return FramePacer.IsPacing() ? FramePacer.GetSlotTimecode(PacingStep.Slot) : FPlatformTime::Seconds() - CaptureStartTime;
+}
+
+void UOmniCaptureSubsystem::HandleDroppedFrame(int32 FrameIndex, double Timecode)
 {
     bDroppedFrames = true;
     State = EOmniCaptureState::DroppedFrames;
     ++DroppedFrameCount;
+    if (FrameIndexWriter)
+    {
+        FrameIndexWriter->AppendDrop(FrameIndex, Timecode);
+    }
     AddWarningUnique(OmniCapture::WarningFrameDrop);
     LogDiagnosticMessage(ELogVerbosity::Warning, TEXT("CaptureLoop"), TEXT("OmniCapture frame dropped"));
 }
@@ -2026,6 +2474,7 @@ void UOmniCaptureSubsystem::RotateSegmentIfNeeded()
     ConfigureActiveSegment();
 
     InitializeOutputWriters();
+    ApplyQualityState(QualityGovernor.GetState());
 
     if (!OutputMuxer)
     {
@@ -2040,6 +2489,7 @@ void UOmniCaptureSubsystem::RotateSegmentIfNeeded()
     }
 
     InitializeAudioRecording();
+    JournalActiveSegmentOpened();
 
     CurrentSegmentStartTime = FPlatformTime::Seconds();
     LastSegmentSizeCheckTime = CurrentSegmentStartTime;
@@ -2080,6 +2530,20 @@ void UOmniCaptureSubsystem::CompleteActiveSegment(bool bStoreResults)
     SegmentRecord.Frames = MoveTemp(CapturedFrameMetadata);
     SegmentRecord.bHasImageSequence = bCapturedImageSequenceThisSegment || ActiveSettings.OutputFormat == EOmniOutputFormat::ImageSequence;
 
+    if (CaptureJournal)
+    {
+        FOmniCaptureJournalSegment JournalSegment;
+        JournalSegment.SegmentIndex = SegmentRecord.SegmentIndex;
+        JournalSegment.Directory = SegmentRecord.Directory;
+        JournalSegment.BaseFileName = SegmentRecord.BaseFileName;
+        JournalSegment.AudioPath = SegmentRecord.AudioPath;
+        JournalSegment.VideoPath = SegmentRecord.VideoPath;
+        JournalSegment.FrameCount = SegmentRecord.Frames.Num();
+        JournalSegment.DroppedFrames = SegmentRecord.DroppedFrames;
+        JournalSegment.bHasImageSequence = SegmentRecord.bHasImageSequence;
+        CaptureJournal->RecordSegmentClose(JournalSegment);
+    }
+
     CompletedSegments.Add(MoveTemp(SegmentRecord));
 
     CapturedFrameMetadata.Reset();
@@ -2088,6 +2552,22 @@ void UOmniCaptureSubsystem::CompleteActiveSegment(bool bStoreResults)
     bCapturedImageSequenceThisSegment = false;
 }
 
+void UOmniCaptureSubsystem::JournalActiveSegmentOpened()
+{
+    if (!CaptureJournal)
+    {
+        return;
+    }
+
+    FOmniCaptureJournalSegment JournalSegment;
+    JournalSegment.SegmentIndex = CurrentSegmentIndex;
+    JournalSegment.Directory = ActiveSettings.OutputDirectory;
+    JournalSegment.BaseFileName = ActiveSettings.OutputFileName;
+    JournalSegment.AudioPath = AudioRecorder ? AudioRecorder->GetStreamingFilePath() : FString();
+    JournalSegment.VideoPath = RecordedVideoPath;
+    CaptureJournal->RecordSegmentOpen(JournalSegment);
+}
+
 int64 UOmniCaptureSubsystem::CalculateActiveSegmentSizeBytes() const
 {
     int64 TotalBytes = 0;
@@ -2179,7 +2659,8 @@ void UOmniCaptureSubsystem::UpdateRuntimeWarnings()
         }
     }
 
-    if (ActiveSettings.TargetFrameRate > 0.0f)
+    // Offline capture runs as fast as it can by design, so a low rate is not a warning there.
+    if (ActiveSettings.TargetFrameRate > 0.0f && !FramePacer.IsFixedTimestep())
     {
         const double ThresholdFps = ActiveSettings.TargetFrameRate * FMath::Clamp(static_cast<double>(ActiveSettings.LowFrameRateWarningRatio), 0.1, 1.0);
         if (!bIsPaused && CurrentCaptureFPS > 0.0 && CurrentCaptureFPS < ThresholdFps)
@@ -0,0 +1,210 @@
+#include "OmniCaptureTelemetry.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/Paths.h"
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<FOmniCaptureTelemetrySnapshot>::value, "Telemetry snapshots are copied under a sequence lock and must stay plain data");
+
+FOmniCaptureTelemetry::FOmniCaptureTelemetry()
+{
+    Sequence.Store(0);
+    Reset();
+}
+
+FOmniCaptureTelemetry::~FOmniCaptureTelemetry()
+{
+    CloseCsv();
+}
+
+void FOmniCaptureTelemetry::Reset()
+{
+    FramesCaptured.Store(0);
+    LastFrameBytes.Store(0);
+    BytesWritten.Store(0);
+    for (int32 StageIndex = 0; StageIndex < StageCount; ++StageIndex)
+    {
+        StageMicroseconds[StageIndex].Store(0);
+        StageSamples[StageIndex].Store(0);
+        PreviousStageMicroseconds[StageIndex] = 0;
+        PreviousStageSamples[StageIndex] = 0;
+    }
+    AudioDriftMilliseconds.Store(0.0);
+    MaxAudioDriftMilliseconds.Store(0.0);
+    AudioPendingPackets.Store(0);
+
+    Previous = FOmniCaptureTelemetrySnapshot();
+    const uint32 Current = Sequence.Load();
+    Sequence.Store(Current + 1);
+    FPlatformMisc::MemoryBarrier();
+    Published = FOmniCaptureTelemetrySnapshot();
+    FPlatformMisc::MemoryBarrier();
+    Sequence.Store(Current + 2);
+}
+
+void FOmniCaptureTelemetry::RecordFrameCaptured(int64 FrameBytes)
+{
+    FramesCaptured.IncrementExchange();
+    LastFrameBytes.Store(FrameBytes, EMemoryOrder::Relaxed);
+}
+
+void FOmniCaptureTelemetry::RecordStageTimings(const FOmniCaptureFrameStageTimings& Timings)
+{
+    for (int32 StageIndex = 0; StageIndex < StageCount; ++StageIndex)
+    {
+        if (Timings.Milliseconds[StageIndex] > 0.0)
+        {
+            StageMicroseconds[StageIndex].AddExchange(static_cast<int64>(Timings.Milliseconds[StageIndex] * 1000.0));
+            StageSamples[StageIndex].IncrementExchange();
+        }
+    }
+}
+
+void FOmniCaptureTelemetry::RecordBytesWritten(int64 Bytes)
+{
+    BytesWritten.AddExchange(Bytes);
+}
+
+void FOmniCaptureTelemetry::RecordAudioSync(double DriftMilliseconds, double MaxDriftMilliseconds, int32 PendingPackets)
+{
+    AudioDriftMilliseconds.Store(DriftMilliseconds, EMemoryOrder::Relaxed);
+    MaxAudioDriftMilliseconds.Store(MaxDriftMilliseconds, EMemoryOrder::Relaxed);
+    AudioPendingPackets.Store(PendingPackets, EMemoryOrder::Relaxed);
+}
+
+void FOmniCaptureTelemetry::Publish(double CaptureSeconds, const FOmniCaptureTelemetrySnapshot& Gauges)
+{
+    FOmniCaptureTelemetrySnapshot Snapshot = Gauges;
+    Snapshot.PublishIndex = Previous.PublishIndex + 1;
+    Snapshot.CaptureSeconds = CaptureSeconds;
+    Snapshot.FramesCaptured = FramesCaptured.Load(EMemoryOrder::Relaxed);
+    Snapshot.BytesWritten = BytesWritten.Load(EMemoryOrder::Relaxed);
+    Snapshot.AudioDriftMilliseconds = AudioDriftMilliseconds.Load(EMemoryOrder::Relaxed);
+    Snapshot.MaxAudioDriftMilliseconds = MaxAudioDriftMilliseconds.Load(EMemoryOrder::Relaxed);
+    Snapshot.AudioPendingPackets = AudioPendingPackets.Load(EMemoryOrder::Relaxed);
+    Snapshot.MemoryInFlightBytes = LastFrameBytes.Load(EMemoryOrder::Relaxed) * FMath::Max(Gauges.RingBufferPending + Gauges.WriterPendingFrames, 0);
+
+    for (int32 StageIndex = 0; StageIndex < StageCount; ++StageIndex)
+    {
+        const int64 Microseconds = StageMicroseconds[StageIndex].Load(EMemoryOrder::Relaxed);
+        const int32 Samples = StageSamples[StageIndex].Load(EMemoryOrder::Relaxed);
+        const int32 NewSamples = Samples - PreviousStageSamples[StageIndex];
+        Snapshot.StageMilliseconds[StageIndex] = NewSamples > 0 ? (Microseconds - PreviousStageMicroseconds[StageIndex]) / (1000.0 * NewSamples) : 0.0;
+        PreviousStageMicroseconds[StageIndex] = Microseconds;
+        PreviousStageSamples[StageIndex] = Samples;
+    }
+
+    // The first publish has no earlier sample, so its rates cover the whole capture so far.
+    const double Elapsed = CaptureSeconds - Previous.CaptureSeconds;
+    if (Elapsed > 0.0)
+    {
+        Snapshot.CaptureFramesPerSecond = (Snapshot.FramesCaptured - Previous.FramesCaptured) / Elapsed;
+        Snapshot.BytesWrittenPerSecond = (Snapshot.BytesWritten - Previous.BytesWritten) / Elapsed;
+        Snapshot.EncodedBytesPerSecond = (Snapshot.EncodedBytes - Previous.EncodedBytes) / Elapsed;
+        Snapshot.EncodedPacketsPerSecond = (Snapshot.EncodedPackets - Previous.EncodedPackets) / Elapsed;
+    }
+    else
+    {
+        Snapshot.CaptureFramesPerSecond = Previous.CaptureFramesPerSecond;
+        Snapshot.BytesWrittenPerSecond = Previous.BytesWrittenPerSecond;
+        Snapshot.EncodedBytesPerSecond = Previous.EncodedBytesPerSecond;
+        Snapshot.EncodedPacketsPerSecond = Previous.EncodedPacketsPerSecond;
+    }
+    Previous = Snapshot;
+
+    const uint32 Current = Sequence.Load(EMemoryOrder::Relaxed);
+    Sequence.Store(Current + 1);
+    FPlatformMisc::MemoryBarrier();
+    Published = Snapshot;
+    FPlatformMisc::MemoryBarrier();
+    Sequence.Store(Current + 2);
+
+    if (CsvArchive.IsValid())
+    {
+        const FTCHARToUTF8 Row(*FormatCsvRow(Snapshot));
+        CsvArchive->Serialize(const_cast<ANSICHAR*>(Row.Get()), Row.Length());
+    }
+}
+
+FOmniCaptureTelemetrySnapshot FOmniCaptureTelemetry::GetSnapshot() const
+{
+    for (;;)
+    {
+        const uint32 Before = Sequence.Load();
+        if ((Before & 1u) == 0)
+        {
+            FOmniCaptureTelemetrySnapshot Snapshot = Published;
+            FPlatformMisc::MemoryBarrier();
+            if (Sequence.Load() == Before)
+            {
+                return Snapshot;
+            }
+        }
+        FPlatformProcess::YieldThread();
+    }
+}
+
+bool FOmniCaptureTelemetry::OpenCsv(const FString& FilePath)
+{
+    CloseCsv();
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+    CsvArchive.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+    if (!CsvArchive.IsValid())
+    {
+        return false;
+    }
+
+    const FTCHARToUTF8 Header(*GetCsvHeader());
+    CsvArchive->Serialize(const_cast<ANSICHAR*>(Header.Get()), Header.Length());
+    return true;
+}
+
+void FOmniCaptureTelemetry::CloseCsv()
+{
+    if (CsvArchive.IsValid())
+    {
+        CsvArchive->Close();
+        CsvArchive.Reset();
+    }
+}
+
+FString FOmniCaptureTelemetry::GetCsvHeader()
+{
+    FString Header = TEXT("time_s,frames,dropped,fps,ring_pending,ring_capacity,ring_blocked,writer_pending");
+    for (int32 StageIndex = 0; StageIndex < StageCount; ++StageIndex)
+    {
+        FString StageName = FString(LexToString(static_cast<EOmniCaptureStage>(StageIndex))).ToLower().Replace(TEXT(" "), TEXT("_"));
+        Header += FString::Printf(TEXT(",%s_ms"), *StageName);
+    }
+    Header += TEXT(",bytes_written,write_bytes_per_s,encoded_bytes,encoded_bytes_per_s,encoded_packets_per_s,audio_drift_ms,audio_max_drift_ms,audio_pending,memory_in_flight_bytes\n");
+    return Header;
+}
+
+FString FOmniCaptureTelemetry::FormatCsvRow(const FOmniCaptureTelemetrySnapshot& Snapshot)
+{
+    FString Row = FString::Printf(TEXT("%.3f,%d,%d,%.3f,%d,%d,%d,%d"),
+        Snapshot.CaptureSeconds,
+        Snapshot.FramesCaptured,
+        Snapshot.DroppedFrames,
+        Snapshot.CaptureFramesPerSecond,
+        Snapshot.RingBufferPending,
+        Snapshot.RingBufferCapacity,
+        Snapshot.RingBufferBlockedPushes,
+        Snapshot.WriterPendingFrames);
+    for (int32 StageIndex = 0; StageIndex < StageCount; ++StageIndex)
+    {
+        Row += FString::Printf(TEXT(",%.3f"), Snapshot.StageMilliseconds[StageIndex]);
+    }
+    Row += FString::Printf(TEXT(",%lld,%.0f,%lld,%.0f,%.3f,%.3f,%.3f,%d,%lld\n"),
+        Snapshot.BytesWritten,
+        Snapshot.BytesWrittenPerSecond,
+        Snapshot.EncodedBytes,
+        Snapshot.EncodedBytesPerSecond,
+        Snapshot.EncodedPacketsPerSecond,
+        Snapshot.AudioDriftMilliseconds,
+        Snapshot.MaxAudioDriftMilliseconds,
+        Snapshot.AudioPendingPackets,
+        Snapshot.MemoryInFlightBytes);
+    return Row;
+}
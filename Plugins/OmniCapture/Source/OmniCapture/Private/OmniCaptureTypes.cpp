@@ -1,5 +1,6 @@
 #include "OmniCaptureTypes.h"
 
+#include "OmniCaptureFoveatedEquirect.h"
 #include "Math/UnrealMathUtility.h"
 #include "UObject/UnrealType.h"
 
@@ -104,6 +105,55 @@ FIntPoint FOmniCaptureSettings::GetFisheyeResolution() const
     return Base;
 }
 
+FIntPoint FOmniCaptureSettings::GetDomeResolution() const
+{
+    // Dome masters are square; spherical mirror output fills a 4:3 projector frame.
+    const int32 Size = FMath::Max(1, Resolution) * 2;
+    FIntPoint Base = IsSphericalMirror() ? FIntPoint(Size, Size * 3 / 4) : FIntPoint(Size, Size);
+
+    const int32 Alignment = GetEncoderAlignmentRequirement();
+    Base = AlignPoint(Base, Alignment);
+
+    Base.X = FMath::Max(2, Base.X);
+    Base.Y = FMath::Max(2, Base.Y);
+
+    return Base;
+}
+
+FIntPoint FOmniCaptureSettings::GetCubemapResolution() const
+{
+    const int32 FaceSize = FMath::Max(1, Resolution);
+    FIntPoint Base(FaceSize * 3, FaceSize * 2);
+
+    const int32 Alignment = GetEncoderAlignmentRequirement();
+    Base = AlignPoint(Base, Alignment);
+
+    Base.X = FMath::Max(2, Base.X);
+    Base.Y = FMath::Max(2, Base.Y);
+
+    return Base;
+}
+
+FIntPoint FOmniCaptureSettings::GetFoveatedSourceResolution() const
+{
+    const int32 Alignment = GetEncoderAlignmentRequirement();
+    const int32 Levels = FMath::Clamp(FoveationLevels, 1, 4);
+
+    FIntPoint Base(FMath::Max(1, Resolution) * (IsVR180() ? 1 : 2), FMath::Max(1, Resolution));
+    Base.X = AlignDimension(AlignDimension(Base.X, Alignment), 1 << Levels);
+    Base.Y = AlignDimension(Base.Y, 2);
+    return Base;
+}
+
+FIntPoint FOmniCaptureSettings::GetFoveatedResolution() const
+{
+    const FIntPoint Source = GetFoveatedSourceResolution();
+    const FOmniCaptureFoveatedLayout Layout = FOmniCaptureFoveatedLayout::Build(Source, FoveationStartLatitude, FMath::Clamp(FoveationLevels, 1, 4));
+
+    const int32 Alignment = GetEncoderAlignmentRequirement();
+    return FIntPoint(Source.X, FMath::Max(2, AlignDimension(Layout.GetPackedHeight(), Alignment)));
+}
+
 FIntPoint FOmniCaptureSettings::GetOutputResolution() const
 {
     if (IsPlanar())
@@ -111,6 +161,31 @@ FIntPoint FOmniCaptureSettings::GetOutputResolution() const
         return GetPlanarResolution();
     }
 
+    if (IsFullDome() || IsSphericalMirror())
+    {
+        return GetDomeResolution();
+    }
+
+    if (IsCubemapLayout() || IsFoveatedEquirect())
+    {
+        const FIntPoint EyeResolution = IsCubemapLayout() ? GetCubemapResolution() : GetFoveatedResolution();
+        FIntPoint Output = EyeResolution;
+
+        if (IsStereo())
+        {
+            if (StereoLayout == EOmniCaptureStereoLayout::SideBySide)
+            {
+                Output.X = AlignDimension(EyeResolution.X * 2, GetEncoderAlignmentRequirement());
+            }
+            else
+            {
+                Output.Y = AlignDimension(EyeResolution.Y * 2, GetEncoderAlignmentRequirement());
+            }
+        }
+
+        return Output;
+    }
+
     if (IsFisheye())
     {
         if (ShouldConvertFisheyeToEquirect())
@@ -148,6 +223,21 @@ FIntPoint FOmniCaptureSettings::GetPerEyeOutputResolution() const
         return GetPlanarResolution();
     }
 
+    if (IsFullDome() || IsSphericalMirror())
+    {
+        return GetDomeResolution();
+    }
+
+    if (IsCubemapLayout())
+    {
+        return GetCubemapResolution();
+    }
+
+    if (IsFoveatedEquirect())
+    {
+        return GetFoveatedResolution();
+    }
+
     if (IsFisheye())
     {
         if (ShouldConvertFisheyeToEquirect())
@@ -232,6 +322,36 @@ bool FOmniCaptureSettings::IsSphericalMirror() const
     return Projection == EOmniCaptureProjection::SphericalMirror;
 }
 
+bool FOmniCaptureSettings::IsCubemapLayout() const
+{
+    return Projection == EOmniCaptureProjection::Cubemap || Projection == EOmniCaptureProjection::EquiAngularCubemap;
+}
+
+bool FOmniCaptureSettings::IsFoveatedEquirect() const
+{
+    return Projection == EOmniCaptureProjection::FoveatedEquirectangular;
+}
+
+bool FOmniCaptureSettings::UsesOmniDirectionalStereo() const
+{
+    return bOmniDirectionalStereo && IsStereo() && Projection == EOmniCaptureProjection::Equirectangular;
+}
+
+bool FOmniCaptureSettings::UsesPackedFrames() const
+{
+    return OutputFormat == EOmniOutputFormat::ImageSequence && ImageFormat == EOmniCaptureImageFormat::Y4M;
+}
+
+bool FOmniCaptureSettings::UsesFramePacing() const
+{
+    return FramePacing != EOmniCaptureFramePacing::EveryTick && TargetFrameRate > 0.0f;
+}
+
+bool FOmniCaptureSettings::UsesFixedTimestep() const
+{
+    return FramePacing == EOmniCaptureFramePacing::FixedTimestep && TargetFrameRate > 0.0f;
+}
+
 bool FOmniCaptureSettings::SupportsSphericalMetadata() const
 {
     if (IsPlanar())
@@ -239,7 +359,8 @@ bool FOmniCaptureSettings::SupportsSphericalMetadata() const
         return false;
     }
 
-    if (IsCylindrical() || IsFullDome() || IsSphericalMirror())
+    // Foveated frames must be expanded before a player can treat them as equirect.
+    if (IsCylindrical() || IsFullDome() || IsSphericalMirror() || IsFoveatedEquirect())
     {
         return false;
     }
@@ -262,6 +383,19 @@ bool FOmniCaptureSettings::ShouldConvertFisheyeToEquirect() const
     return bFisheyeConvertToEquirect && IsFisheye();
 }
 
+int32 FOmniCaptureSettings::GetRemapSamplesPerAxis() const
+{
+    switch (RemapQuality)
+    {
+    case EOmniCaptureRemapQuality::High:
+        return 2;
+    case EOmniCaptureRemapQuality::Ultra:
+        return 3;
+    default:
+        return 1;
+    }
+}
+
 FString FOmniCaptureSettings::GetStereoModeMetadataTag() const
 {
     if (!IsStereo())
@@ -274,6 +408,19 @@ FString FOmniCaptureSettings::GetStereoModeMetadataTag() const
         : TEXT("left-right");
 }
 
+FString FOmniCaptureSettings::GetProjectionMetadataTag() const
+{
+    switch (Projection)
+    {
+    case EOmniCaptureProjection::Cubemap:
+        return TEXT("cubemap");
+    case EOmniCaptureProjection::EquiAngularCubemap:
+        return TEXT("equi-angular-cubemap");
+    default:
+        return TEXT("equirectangular");
+    }
+}
+
 namespace
 {
     static int32 CalculateLcm(int32 A, int32 B)
@@ -331,7 +478,7 @@ float FOmniCaptureSettings::GetHorizontalFOVDegrees() const
 
     if (IsFullDome())
     {
-        return 180.0f;
+        return FMath::Clamp(FullDomeFOV, 90.0f, 360.0f);
     }
 
     if (IsSphericalMirror())
@@ -356,12 +503,12 @@ float FOmniCaptureSettings::GetVerticalFOVDegrees() const
 
     if (IsCylindrical())
     {
-        return 180.0f;
+        return FMath::Clamp(CylindricalVerticalFOV, 10.0f, 170.0f);
     }
 
     if (IsFullDome())
     {
-        return 180.0f;
+        return FMath::Clamp(FullDomeFOV, 90.0f, 360.0f);
     }
 
     if (IsSphericalMirror())
@@ -392,6 +539,8 @@ FString FOmniCaptureSettings::GetImageFileExtension() const
         return TEXT(".exr");
     case EOmniCaptureImageFormat::BMP:
         return TEXT(".bmp");
+    case EOmniCaptureImageFormat::Y4M:
+        return TEXT(".y4m");
     case EOmniCaptureImageFormat::PNG:
     default:
         return TEXT(".png");
@@ -0,0 +1,93 @@
+#include "OmniCaptureY4MWriter.h"
+
+#include "HAL/FileManager.h"
+#include "OmniCaptureFramePacer.h"
+#include "OmniCaptureStageTimings.h"
+
+FOmniCaptureY4MWriter::~FOmniCaptureY4MWriter()
+{
+    Close();
+}
+
+bool FOmniCaptureY4MWriter::Open(const FString& FilePath, const FIntPoint& InSize, double FrameRate, EOmniCaptureColorSpace InColorSpace, int32 InBitDepth)
+{
+    Close();
+    if (InSize.X <= 0 || InSize.Y <= 0 || (InBitDepth != 10 && InBitDepth != 12 && InBitDepth != 16))
+    {
+        return false;
+    }
+
+    IFileManager::Get().Delete(*FilePath, false, true, false);
+    Archive.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+    if (!Archive.IsValid())
+    {
+        return false;
+    }
+
+    Size = InSize;
+    ColorSpace = InColorSpace;
+    BitDepth = InBitDepth;
+    FramesWritten = 0;
+
+    const FTCHARToUTF8 Header(*BuildHeader(Size, FrameRate, BitDepth));
+    Archive->Serialize(const_cast<ANSICHAR*>(Header.Get()), Header.Length());
+    if (Archive->IsError())
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+int64 FOmniCaptureY4MWriter::WriteFrame(const TImagePixelData<FOmniCapturePackedRGB10A2>& Frame)
+{
+    if (!Archive.IsValid() || Frame.GetSize() != Size || Frame.Pixels.Num() != Size.X * Size.Y)
+    {
+        return 0;
+    }
+
+    FOmniCapturePixelPacking::ConvertToYUV420(Frame.Pixels, Size, ColorSpace, BitDepth, YPlane, CbPlane, CrPlane);
+
+    // Y4M wants little-endian 16-bit samples above 8 bits, which is the in-memory layout on every supported platform.
+    static const ANSICHAR FrameMarker[] = "FRAME\n";
+    const int64 MarkerBytes = UE_ARRAY_COUNT(FrameMarker) - 1;
+    const int64 StartOffset = Archive->Tell();
+    {
+        OMNICAPTURE_STAGE_SCOPE(FileWrite);
+        Archive->Serialize(const_cast<ANSICHAR*>(FrameMarker), MarkerBytes);
+        Archive->Serialize(YPlane.GetData(), YPlane.Num() * sizeof(uint16));
+        Archive->Serialize(CbPlane.GetData(), CbPlane.Num() * sizeof(uint16));
+        Archive->Serialize(CrPlane.GetData(), CrPlane.Num() * sizeof(uint16));
+    }
+    if (Archive->IsError())
+    {
+        return 0;
+    }
+
+    ++FramesWritten;
+    return Archive->Tell() - StartOffset;
+}
+
+void FOmniCaptureY4MWriter::Close()
+{
+    if (Archive.IsValid())
+    {
+        Archive->Close();
+        Archive.Reset();
+    }
+}
+
+FString FOmniCaptureY4MWriter::BuildHeader(const FIntPoint& Size, double FrameRate, int32 BitDepth)
+{
+    int32 Numerator = 0;
+    int32 Denominator = 1;
+    GetFrameRateRatio(FrameRate, Numerator, Denominator);
+    return FString::Printf(TEXT("YUV4MPEG2 W%d H%d F%d:%d Ip A1:1 C420p%d XCOLORRANGE=LIMITED\n"), Size.X, Size.Y, Numerator, Denominator, BitDepth);
+}
+
+void FOmniCaptureY4MWriter::GetFrameRateRatio(double FrameRate, int32& OutNumerator, int32& OutDenominator)
+{
+    const FFrameRate Rational = FOmniCaptureFramePacer::MakeFrameRate(FrameRate);
+    OutNumerator = Rational.Numerator;
+    OutDenominator = Rational.Denominator;
+}
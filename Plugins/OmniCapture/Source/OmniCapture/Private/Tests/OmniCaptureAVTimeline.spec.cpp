@@ -0,0 +1,205 @@
+#include "Misc/AutomationTest.h"
+
+#include "Math/RandomStream.h"
+#include "OmniCaptureAVTimeline.h"
+
+namespace OmniCaptureAVTimelineTests
+{
+    constexpr int32 SampleRate = 48000;
+    constexpr int32 NumChannels = 2;
+    constexpr int32 FramesPerPacket = 480;
+
+    struct FSimulationResult
+    {
+        FOmniCaptureAVTimelineStats Stats;
+        int64 OutputFrames = 0;
+        int64 ExpectedFrames = 0;
+        bool bContiguous = true;
+        bool bStartsAtOrigin = false;
+    };
+
+    /**
+     * 60 fps video with +/-4 ms capture jitter against 10 ms audio packets with +/-0.5 ms clock jitter.
+     * Packet 90 is lost (gap) and packet 150 is delivered twice (overlap).
+     */
+    FSimulationResult Simulate(int32 Seed)
+    {
+        FRandomStream Random(Seed);
+        FOmniCaptureAVTimeline Timeline;
+        Timeline.Reset(0.002);
+
+        FSimulationResult Result;
+        int32 NextPacket = 0;
+        int64 Cursor = 0;
+
+        for (int32 FrameIndex = 0; FrameIndex < 240; ++FrameIndex)
+        {
+            const double FrameTime = 0.5 + FrameIndex / 60.0 + Random.FRandRange(-0.004f, 0.004f);
+            Timeline.AddVideoFrame(FrameTime);
+
+            TArray<FOmniAudioPacket> Packets;
+            for (;;)
+            {
+                const double PacketTime = static_cast<double>(NextPacket * FramesPerPacket) / SampleRate + Random.FRandRange(-0.0005f, 0.0005f);
+                if (PacketTime > FrameTime + (1.0 / 120.0))
+                {
+                    break;
+                }
+
+                FOmniAudioPacket Packet;
+                Packet.Timestamp = PacketTime;
+                Packet.SampleRate = SampleRate;
+                Packet.NumChannels = NumChannels;
+                Packet.PCM16.Init(static_cast<int16>(NextPacket & 0x7FFF), FramesPerPacket * NumChannels);
+
+                if (NextPacket != 90)
+                {
+                    Packets.Add(Packet);
+                }
+                if (NextPacket == 150)
+                {
+                    Packets.Add(Packet);
+                }
+                ++NextPacket;
+            }
+
+            Timeline.ProcessAudio(Packets);
+            for (const FOmniAudioPacket& Packet : Packets)
+            {
+                const double ExpectedTimestamp = Timeline.GetVideoOrigin() + static_cast<double>(Cursor) / SampleRate;
+                if (Cursor == 0)
+                {
+                    Result.bStartsAtOrigin = Packet.Timestamp == Timeline.GetVideoOrigin();
+                }
+                Result.bContiguous &= FMath::IsNearlyEqual(Packet.Timestamp, ExpectedTimestamp, 1e-9);
+                Cursor += Packet.PCM16.Num() / NumChannels;
+            }
+        }
+
+        TArray<FOmniAudioPacket> Tail;
+        const int64 TrimSamples = Timeline.Finish(Tail);
+        for (const FOmniAudioPacket& Packet : Tail)
+        {
+            Cursor += Packet.PCM16.Num() / NumChannels;
+        }
+        Cursor -= TrimSamples / NumChannels;
+
+        Result.Stats = Timeline.GetStats();
+        Result.OutputFrames = Cursor;
+        Result.ExpectedFrames = static_cast<int64>(FMath::RoundToDouble((Timeline.GetVideoEndTime() - Timeline.GetVideoOrigin()) * SampleRate));
+        return Result;
+    }
+
+    FOmniAudioPacket MakePacket(double Timestamp)
+    {
+        FOmniAudioPacket Packet;
+        Packet.Timestamp = Timestamp;
+        Packet.SampleRate = SampleRate;
+        Packet.NumChannels = NumChannels;
+        Packet.PCM16.Init(1, FramesPerPacket * NumChannels);
+        return Packet;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureAVTimelineJitterTest, "OmniCapture.Audio.TimelineJitter", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureAVTimelineJitterTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCaptureAVTimelineTests;
+
+    const FSimulationResult Result = Simulate(1337);
+    TestTrue(TEXT("Audio starts exactly at the first frame"), Result.bStartsAtOrigin);
+    TestTrue(TEXT("Emitted packets are gapless on the sample grid"), Result.bContiguous);
+    TestEqual(TEXT("Audio length matches the video timeline"), Result.OutputFrames, Result.ExpectedFrames);
+    TestTrue(TEXT("Lost packet was filled with silence"), Result.Stats.PadEvents >= 1 && Result.Stats.PaddedSamples >= FramesPerPacket * NumChannels);
+    TestTrue(TEXT("Duplicated packet was trimmed"), Result.Stats.TrimEvents >= 1);
+    TestTrue(TEXT("Clock jitter is absorbed without correction"), Result.Stats.PadEvents <= 2);
+
+    const FSimulationResult Repeat = Simulate(1337);
+    TestEqual(TEXT("Simulation is deterministic"), Repeat.Stats.EmittedSamples, Result.Stats.EmittedSamples);
+    TestEqual(TEXT("Corrections are deterministic"), Repeat.Stats.PaddedSamples, Result.Stats.PaddedSamples);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureAVTimelineGapTest, "OmniCapture.Audio.TimelineGap", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureAVTimelineGapTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCaptureAVTimelineTests;
+
+    FOmniCaptureAVTimeline Timeline;
+    Timeline.Reset(0.002);
+    Timeline.AddVideoFrame(0.0);
+
+    // One packet, then an audio clock jump of a minute.
+    TArray<FOmniAudioPacket> Packets = { MakePacket(0.0), MakePacket(60.0), MakePacket(60.0 + static_cast<double>(FramesPerPacket) / SampleRate) };
+    Timeline.ProcessAudio(Packets);
+
+    const int64 MaxGapFrames = static_cast<int64>(FOmniCaptureAVTimeline::MaxGapSeconds * SampleRate);
+    const int32 ExpectedSilencePackets = static_cast<int32>((MaxGapFrames + FOmniCaptureAVTimeline::SilencePacketFrames - 1) / FOmniCaptureAVTimeline::SilencePacketFrames);
+    TestEqual(TEXT("Silence arrives as separate packets between the audio"), Packets.Num(), 3 + ExpectedSilencePackets);
+    TestEqual(TEXT("Only MaxGapSeconds of silence is inserted"), Timeline.GetStats().PaddedSamples, MaxGapFrames * NumChannels);
+    TestEqual(TEXT("The jump is reported"), Timeline.GetStats().ClampedGaps, 1);
+
+    bool bFixedSize = true;
+    int64 Cursor = 0;
+    bool bContiguous = true;
+    for (int32 Index = 0; Index < Packets.Num(); ++Index)
+    {
+        const FOmniAudioPacket& Packet = Packets[Index];
+        const bool bSilence = Index > 0 && Index <= ExpectedSilencePackets;
+        bFixedSize &= !bSilence || Packet.PCM16.Num() <= FOmniCaptureAVTimeline::SilencePacketFrames * NumChannels;
+        bContiguous &= FMath::IsNearlyEqual(Packet.Timestamp, static_cast<double>(Cursor) / SampleRate, 1e-9);
+        Cursor += Packet.PCM16.Num() / NumChannels;
+    }
+    TestTrue(TEXT("Silence packets hold at most SilencePacketFrames"), bFixedSize);
+    TestTrue(TEXT("Audio after the jump follows the silence without a second gap"), bContiguous);
+    TestEqual(TEXT("Later packets need no further padding"), Timeline.GetStats().PadEvents, 1);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureAVTimelineDriftTest, "OmniCapture.Audio.TimelineDrift", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureAVTimelineDriftTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCaptureAVTimelineTests;
+
+    // An audio clock 0.3% slow and one 0.3% fast drift 9 ms over three seconds; both are resampled, never padded or trimmed.
+    for (const double ClockScale : { 1.003, 0.997 })
+    {
+        FOmniCaptureAVTimeline Timeline;
+        Timeline.Reset(0.002);
+        Timeline.AddVideoFrame(0.0);
+
+        TArray<FOmniAudioPacket> Packets;
+        for (int32 Index = 0; Index < 300; ++Index)
+        {
+            Packets.Add(MakePacket(Index * ClockScale * FramesPerPacket / SampleRate));
+        }
+        const double LastTimestamp = Packets.Last().Timestamp;
+        Timeline.ProcessAudio(Packets);
+
+        const FOmniCaptureAVTimelineStats& Stats = Timeline.GetStats();
+        const int64 MaxAdjustFrames = static_cast<int64>(FramesPerPacket * FOmniCaptureAVTimeline::MaxResampleRatio);
+        TestEqual(FString::Printf(TEXT("x%.3f: no silence is inserted"), ClockScale), Stats.PadEvents, 0);
+        TestEqual(FString::Printf(TEXT("x%.3f: no samples are dropped"), ClockScale), Stats.TrimEvents, 0);
+        TestTrue(FString::Printf(TEXT("x%.3f: drift is resampled in the clock's direction"), ClockScale), Stats.ResampleEvents > 0 && (ClockScale > 1.0 ? Stats.ResampledFrames > 0 : Stats.ResampledFrames < 0));
+
+        bool bSmallSteps = true;
+        bool bContiguous = true;
+        int64 Cursor = 0;
+        for (const FOmniAudioPacket& Packet : Packets)
+        {
+            const int64 Frames = Packet.PCM16.Num() / NumChannels;
+            bSmallSteps &= FMath::Abs(Frames - FramesPerPacket) <= MaxAdjustFrames;
+            bContiguous &= FMath::IsNearlyEqual(Packet.Timestamp, static_cast<double>(Cursor) / SampleRate, 1e-9);
+            Cursor += Frames;
+        }
+        TestEqual(FString::Printf(TEXT("x%.3f: every packet is kept"), ClockScale), Packets.Num(), 300);
+        TestTrue(FString::Printf(TEXT("x%.3f: packets change by at most MaxResampleRatio"), ClockScale), bSmallSteps);
+        TestTrue(FString::Printf(TEXT("x%.3f: resampled packets stay gapless"), ClockScale), bContiguous);
+
+        const int64 ExpectedEnd = static_cast<int64>(FMath::RoundToDouble(LastTimestamp * SampleRate)) + FramesPerPacket;
+        const int64 ToleranceFrames = static_cast<int64>(FMath::CeilToDouble(0.002 * SampleRate));
+        TestTrue(FString::Printf(TEXT("x%.3f: the stream ends within the tolerance of the audio clock"), ClockScale), FMath::Abs(Timeline.GetWriteCursorFrames() - ExpectedEnd) <= ToleranceFrames + MaxAdjustFrames);
+    }
+    return true;
+}
@@ -0,0 +1,113 @@
+#include "Misc/AutomationTest.h"
+
+#include "OmniCaptureProjectionRemap.h"
+
+namespace OmniCaptureAdaptiveFaceResolutionTests
+{
+    /** Smooth colour field on the sphere, well below the Nyquist limit of either face size. */
+    FLinearColor EvaluateScene(const FVector& Direction)
+    {
+        const float Azimuth = static_cast<float>(FMath::Atan2(Direction.Y, Direction.X));
+        const float Elevation = static_cast<float>(Direction.Z);
+        return FLinearColor(
+            0.5f + 0.4f * FMath::Sin(Azimuth * 4.0f),
+            0.5f + 0.4f * Elevation,
+            0.5f + 0.4f * FMath::Cos(Elevation * 6.0f + Azimuth),
+            1.0f);
+    }
+
+    /** Renders the scene into each face at that face's own size, the way the rig does with adaptive targets. */
+    FOmniCaptureCubemapPixels RenderCubemap(const int32 (&FaceSizes)[6])
+    {
+        FOmniCaptureCubemapPixels Cubemap;
+        for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+        {
+            const int32 Size = FaceSizes[FaceIndex];
+            Cubemap.FaceResolutions[FaceIndex] = Size;
+            Cubemap.Resolution = FMath::Max(Cubemap.Resolution, Size);
+
+            TArray<FLinearColor>& Face = Cubemap.Faces[FaceIndex];
+            Face.SetNumUninitialized(Size * Size);
+            for (int32 Y = 0; Y < Size; ++Y)
+            {
+                for (int32 X = 0; X < Size; ++X)
+                {
+                    const FVector Direction = FOmniCaptureProjectionRemap::CubeFaceToDirection(FaceIndex, FVector2f((X + 0.5f) / Size, (Y + 0.5f) / Size));
+                    Face[Y * Size + X] = EvaluateScene(Direction.GetSafeNormal());
+                }
+            }
+        }
+        return Cubemap;
+    }
+
+    double ComputePSNR(const TArray<FLinearColor>& Reference, const TArray<FLinearColor>& Test)
+    {
+        double SquaredError = 0.0;
+        for (int32 Index = 0; Index < Reference.Num(); ++Index)
+        {
+            const FLinearColor Delta = Reference[Index] - Test[Index];
+            SquaredError += Delta.R * Delta.R + Delta.G * Delta.G + Delta.B * Delta.B;
+        }
+
+        const double MeanSquaredError = SquaredError / FMath::Max(1, Reference.Num() * 3);
+        return MeanSquaredError > 0.0 ? 10.0 * FMath::LogX(10.0, 1.0 / MeanSquaredError) : 200.0;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureAdaptiveFaceResolutionTest, "OmniCapture.Projection.AdaptiveFaceResolution", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCaptureAdaptiveFaceResolutionTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCaptureAdaptiveFaceResolutionTests;
+
+    constexpr int32 FaceResolution = 512;
+
+    FOmniCaptureSettings Settings;
+    Settings.Resolution = FaceResolution;
+    Settings.Projection = EOmniCaptureProjection::Equirectangular;
+    Settings.Coverage = EOmniCaptureCoverage::FullSphere;
+    Settings.bAdaptiveFaceResolution = true;
+    Settings.AdaptiveFaceDensityScale = 1.0f;
+
+    // A 2R x R equirect needs about 2R/pi texels per face at the face centre, so every face shrinks.
+    const FOmniCaptureFaceCoverage Coverage = FOmniCaptureProjectionRemap::ComputeFaceCoverage(Settings);
+    for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+    {
+        AddInfo(FString::Printf(TEXT("Face %d: %d x %d"), FaceIndex, Coverage.FaceSizes[FaceIndex], Coverage.FaceSizes[FaceIndex]));
+        TestTrue(FString::Printf(TEXT("Face %d is smaller than Resolution"), FaceIndex), Coverage.FaceSizes[FaceIndex] < FaceResolution);
+        TestTrue(FString::Printf(TEXT("Face %d keeps the density the equirect needs"), FaceIndex), Coverage.FaceSizes[FaceIndex] >= FMath::FloorToInt(2.0f * FaceResolution / UE_PI));
+    }
+    AddInfo(FString::Printf(TEXT("Adaptive faces render %.1f%% of the texels of fixed %d faces"), Coverage.GetRenderedFraction() * 100.0f, FaceResolution));
+    TestTrue(TEXT("360 equirect renders less than half the texels"), Coverage.GetRenderedFraction() < 0.5f);
+
+    // Same remap table for both; only the face sizes differ.
+    FOmniCaptureProjectionParams Params;
+    FIntPoint EyeSize;
+    FOmniCaptureProjectionRemap::GetConverterParams(Settings, Params, EyeSize);
+    const TSharedRef<const FOmniCaptureRemapTable> Table = FOmniCaptureProjectionRemap::BuildTable(Params, EyeSize, FaceResolution, Settings.SeamBlend);
+
+    const int32 FullSizes[6] = { FaceResolution, FaceResolution, FaceResolution, FaceResolution, FaceResolution, FaceResolution };
+    const FOmniCaptureCubemapPixels FullCubemap = RenderCubemap(FullSizes);
+    const FOmniCaptureCubemapPixels AdaptiveCubemap = RenderCubemap(Coverage.FaceSizes);
+    TestTrue(TEXT("Mixed-size cubemap is valid"), AdaptiveCubemap.IsValid());
+
+    TArray<FLinearColor> FullPixels;
+    TArray<FLinearColor> AdaptivePixels;
+    FullPixels.SetNumZeroed(Table->Size.X * Table->Size.Y);
+    AdaptivePixels.SetNumZeroed(Table->Size.X * Table->Size.Y);
+    FOmniCaptureProjectionRemap::RemapCPU(*Table, FullCubemap, FullPixels, FIntPoint::ZeroValue, Table->Size.X);
+    FOmniCaptureProjectionRemap::RemapCPU(*Table, AdaptiveCubemap, AdaptivePixels, FIntPoint::ZeroValue, Table->Size.X);
+
+    const double PSNR = ComputePSNR(FullPixels, AdaptivePixels);
+    AddInfo(FString::Printf(TEXT("Adaptive vs fixed output: %.1f dB PSNR"), PSNR));
+    TestTrue(TEXT("Adaptive output is visually identical to fixed-resolution output"), PSNR > 40.0);
+
+    // Turning the feature off leaves every face at Resolution.
+    Settings.bAdaptiveFaceResolution = false;
+    const FOmniCaptureFaceCoverage FixedCoverage = FOmniCaptureProjectionRemap::ComputeFaceCoverage(Settings);
+    for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+    {
+        TestEqual(FString::Printf(TEXT("Face %d stays at Resolution when disabled"), FaceIndex), FixedCoverage.FaceSizes[FaceIndex], FaceResolution);
+    }
+    return true;
+}
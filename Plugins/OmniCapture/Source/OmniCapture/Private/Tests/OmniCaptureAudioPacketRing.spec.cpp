@@ -0,0 +1,106 @@
+#include "Misc/AutomationTest.h"
+
+#include "OmniCaptureAudioPacketRing.h"
+
+namespace OmniCaptureAudioRingTests
+{
+    /** Feeds CallbackCount synthetic stereo submix callbacks into the ring and drains them like GatherAudio would. */
+    bool RunSyntheticSubmix(FAutomationTestBase& Test, int32 SampleRate, int32 FramesPerCallback, int32 CallbackCount)
+    {
+        constexpr int32 NumChannels = 2;
+        constexpr float Gain = 0.8f;
+
+        FOmniCaptureAudioPacketRing Ring;
+        Ring.Initialize(64, 1024);
+
+        TArray<float> Callback;
+        Callback.SetNumUninitialized(FramesPerCallback * NumChannels);
+
+        TArray<int16> Expected;
+        TArray<FOmniAudioPacket> Gathered;
+        int64 FrameCursor = 0;
+
+        for (int32 CallbackIndex = 0; CallbackIndex < CallbackCount; ++CallbackIndex)
+        {
+            for (int32 Frame = 0; Frame < FramesPerCallback; ++Frame)
+            {
+                const double Time = static_cast<double>(FrameCursor + Frame) / SampleRate;
+                const float Value = 1.1f * static_cast<float>(FMath::Sin(2.0 * PI * 440.0 * Time));
+                Callback[Frame * NumChannels + 0] = Value;
+                Callback[Frame * NumChannels + 1] = -Value;
+            }
+
+            for (const float Sample : Callback)
+            {
+                Expected.Add(static_cast<int16>(FMath::Clamp(FMath::RoundToInt((Sample * Gain) * 32767.0f), -32768, 32767)));
+            }
+
+            const double Timestamp = static_cast<double>(FrameCursor) / SampleRate;
+            Ring.Push(Callback.GetData(), Callback.Num(), NumChannels, SampleRate, Timestamp, Gain);
+            FrameCursor += FramesPerCallback;
+
+            Ring.PopUpTo(Timestamp + (1.0 / 120.0), Gathered);
+        }
+        Ring.PopAll(Gathered);
+
+        Test.TestEqual(TEXT("No packets dropped while drained every callback"), Ring.GetDroppedBlockCount(), 0);
+        Test.TestEqual(TEXT("Ring empty after drain"), Ring.GetPendingBlockCount(), 0);
+
+        TArray<int16> Received;
+        double ExpectedTimestamp = 0.0;
+        for (const FOmniAudioPacket& Packet : Gathered)
+        {
+            Test.TestEqual(TEXT("Packet sample rate"), Packet.SampleRate, SampleRate);
+            Test.TestEqual(TEXT("Packet channel count"), Packet.NumChannels, NumChannels);
+            Test.TestTrue(TEXT("Packets are frame aligned"), Packet.PCM16.Num() % NumChannels == 0);
+            Test.TestTrue(TEXT("Packet timestamps are contiguous"), FMath::IsNearlyEqual(Packet.Timestamp, ExpectedTimestamp, 1e-9));
+            ExpectedTimestamp += static_cast<double>(Packet.PCM16.Num() / NumChannels) / SampleRate;
+            Received.Append(Packet.PCM16);
+        }
+
+        Test.TestEqual(TEXT("Every sample delivered"), Received.Num(), Expected.Num());
+        Test.TestTrue(TEXT("Vectorized conversion matches scalar reference"), Received == Expected);
+        return true;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureAudioRing48kTest, "OmniCapture.Audio.PacketRing48k", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureAudioRing48kTest::RunTest(const FString& Parameters)
+{
+    return OmniCaptureAudioRingTests::RunSyntheticSubmix(*this, 48000, 1024, 200);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureAudioRing96kTest, "OmniCapture.Audio.PacketRing96k", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureAudioRing96kTest::RunTest(const FString& Parameters)
+{
+    // 96 kHz callbacks exceed one block and exercise the split path.
+    return OmniCaptureAudioRingTests::RunSyntheticSubmix(*this, 96000, 2047, 200);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureAudioRingOverflowTest, "OmniCapture.Audio.PacketRingOverflow", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureAudioRingOverflowTest::RunTest(const FString& Parameters)
+{
+    FOmniCaptureAudioPacketRing Ring;
+    Ring.Initialize(8, 512);
+
+    TArray<float> Callback;
+    Callback.Init(0.25f, 512);
+
+    int64 DroppedSamples = 0;
+    for (int32 Index = 0; Index < 20; ++Index)
+    {
+        DroppedSamples += Ring.Push(Callback.GetData(), Callback.Num(), 2, 48000, Index * (256.0 / 48000.0), 1.0f);
+    }
+
+    TestEqual(TEXT("Ring holds capacity"), Ring.GetPendingBlockCount(), 8);
+    TestEqual(TEXT("Dropped block count"), Ring.GetDroppedBlockCount(), 12);
+    TestEqual(TEXT("Dropped sample count"), Ring.GetDroppedSampleCount(), DroppedSamples);
+    TestEqual(TEXT("Pushed + dropped equals produced"), Ring.GetPushedSampleCount() + Ring.GetDroppedSampleCount(), static_cast<int64>(20 * 512));
+
+    TArray<FOmniAudioPacket> Gathered;
+    Ring.PopAll(Gathered);
+    TestEqual(TEXT("Oldest blocks retained"), Gathered.Num(), 8);
+    TestTrue(TEXT("First retained block is the first pushed"), Gathered.Num() > 0 && Gathered[0].Timestamp == 0.0);
+
+    return true;
+}
@@ -0,0 +1,104 @@
+#include "Misc/AutomationTest.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "OmniCaptureDiagnosticLog.h"
+
+namespace OmniCaptureDiagnosticLogTests
+{
+    FOmniCaptureDiagnosticEntry MakeEntry(int32 Index)
+    {
+        FOmniCaptureDiagnosticEntry Entry;
+        Entry.Timestamp = FDateTime(2024, 1, 1);
+        Entry.Step = TEXT("Test");
+        Entry.Message = FString::Printf(TEXT("Message %d"), Index);
+        Entry.Level = EOmniCaptureDiagnosticLevel::Warning;
+        return Entry;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureDiagnosticLogTest, "OmniCapture.Diagnostics.DiagnosticLog", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCaptureDiagnosticLogTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCaptureDiagnosticLogTests;
+
+    constexpr int32 Capacity = 4;
+    FOmniCaptureDiagnosticLog Log(Capacity);
+    TArray<FOmniCaptureDiagnosticEntry> Entries;
+    TestEqual(TEXT("An empty log reports no sequence"), static_cast<int32>(Log.GetSince(0, Entries)), 0);
+    TestEqual(TEXT("An empty log returns nothing"), Entries.Num(), 0);
+
+    // Sequences start at 1 and a reader only receives what it has not seen.
+    TestEqual(TEXT("First sequence"), static_cast<int32>(Log.Append(MakeEntry(1))), 1);
+    Log.Append(MakeEntry(2));
+    Log.Append(MakeEntry(3));
+    TestEqual(TEXT("Latest sequence is returned"), static_cast<int32>(Log.GetSince(1, Entries)), 3);
+    TestEqual(TEXT("Only newer entries are returned"), Entries.Num(), 2);
+    TestEqual(TEXT("Newer entries are oldest first"), static_cast<int32>(Entries[0].Sequence), 2);
+    Log.GetSince(3, Entries);
+    TestEqual(TEXT("A caught-up reader gets nothing"), Entries.Num(), 0);
+
+    // Without a spill file the ring silently drops the oldest entries.
+    const FString SpillPath = FPaths::AutomationTransientDir() / TEXT("OmniCaptureDiagnosticLog") / TEXT("Diagnostics.log");
+    const FString RotatedPath = FPaths::GetPath(SpillPath) / TEXT("Diagnostics.1.log");
+    IFileManager::Get().DeleteDirectory(*FPaths::GetPath(SpillPath), false, true);
+    Log.Append(MakeEntry(4));
+    Log.Append(MakeEntry(5));
+    TestFalse(TEXT("No spill file until one is set"), IFileManager::Get().FileExists(*SpillPath));
+
+    // The ring wraps: the newest Capacity entries stay in order and evicted ones are spilled.
+    Log.SetSpillFile(SpillPath, 1024);
+    for (int32 Index = 6; Index <= 10; ++Index)
+    {
+        Log.Append(MakeEntry(Index));
+    }
+    TestEqual(TEXT("Ring is capped at its capacity"), Log.Num(), Capacity);
+    Log.GetAll(Entries);
+    TestEqual(TEXT("All retained entries"), Entries.Num(), Capacity);
+    TestEqual(TEXT("Oldest retained entry"), static_cast<int32>(Entries[0].Sequence), 7);
+    TestEqual(TEXT("Newest retained entry"), Entries.Last().Message, FString(TEXT("Message 10")));
+    Log.GetSince(2, Entries);
+    TestEqual(TEXT("A reader that fell behind gets every retained entry"), Entries.Num(), Capacity);
+    Log.GetSince(8, Entries);
+    TestEqual(TEXT("A reader inside the ring gets the rest"), Entries.Num(), 2);
+
+    // Evictions are batched; nothing reaches the disk until a batch fills or the spill is flushed.
+    TestFalse(TEXT("Evicted entries are queued, not written per entry"), IFileManager::Get().FileExists(*SpillPath));
+    Log.FlushSpill();
+
+    TArray<FString> Lines;
+    TestTrue(TEXT("Spill file is written"), FFileHelper::LoadFileToStringArray(Lines, *SpillPath));
+    TestEqual(TEXT("One line per evicted entry"), Lines.Num(), 5);
+    if (Lines.Num() == 5)
+    {
+        TestTrue(TEXT("Spilled lines carry their sequence"), Lines[0].StartsWith(TEXT("#2 ")));
+        TestTrue(TEXT("Spilled lines carry their message"), Lines[0].EndsWith(TEXT("Message 2")));
+    }
+
+    // Growing past the size limit rolls the spill file over.
+    for (int32 Index = 11; Index <= 40; ++Index)
+    {
+        Log.Append(MakeEntry(Index));
+    }
+    Log.FlushSpill();
+    TestTrue(TEXT("Spill file rolls over"), IFileManager::Get().FileExists(*RotatedPath));
+    TestTrue(TEXT("Rolled spill file stays near its limit"), IFileManager::Get().FileSize(*SpillPath) <= 1024);
+
+    // Reset spills the entries, bumps the generation and never reuses a sequence.
+    const int32 Generation = Log.GetResetGeneration();
+    Log.Reset();
+    TestEqual(TEXT("Reset empties the ring"), Log.Num(), 0);
+    TestEqual(TEXT("Reset bumps the generation"), Log.GetResetGeneration(), Generation + 1);
+    Lines.Reset();
+    FFileHelper::LoadFileToStringArray(Lines, *SpillPath);
+    TestTrue(TEXT("Reset spills the retained entries"), Lines.Num() > 0 && Lines.Last().EndsWith(TEXT("Message 40")));
+    TestEqual(TEXT("Sequences continue after a reset"), static_cast<int32>(Log.Append(MakeEntry(41))), 41);
+    Log.GetSince(40, Entries);
+    TestEqual(TEXT("Readers see entries added after a reset"), Entries.Num(), 1);
+
+    Log.SetSpillFile(FString());
+    IFileManager::Get().DeleteDirectory(*FPaths::GetPath(SpillPath), false, true);
+    return true;
+}
@@ -0,0 +1,128 @@
+#include "Misc/AutomationTest.h"
+
+#include "Math/RandomStream.h"
+#include "OmniCaptureProjectionRemap.h"
+
+namespace OmniCaptureFaceCoverageTests
+{
+    FOmniCaptureCubemapPixels MakeNoiseCubemap(int32 Resolution)
+    {
+        FRandomStream Random(42);
+        FOmniCaptureCubemapPixels Cubemap;
+        Cubemap.Resolution = Resolution;
+        for (TArray<FLinearColor>& Face : Cubemap.Faces)
+        {
+            Face.SetNumUninitialized(Resolution * Resolution);
+            for (FLinearColor& Pixel : Face)
+            {
+                Pixel = FLinearColor(Random.GetFraction(), Random.GetFraction(), Random.GetFraction(), 1.0f);
+            }
+        }
+        return Cubemap;
+    }
+
+    /** What the rig hands the converter: rendered rects as captured, everything else black. */
+    FOmniCaptureCubemapPixels MaskToCoverage(const FOmniCaptureCubemapPixels& Cubemap, const FOmniCaptureFaceCoverage& Coverage)
+    {
+        FOmniCaptureCubemapPixels Masked;
+        Masked.Resolution = Cubemap.Resolution;
+        for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+        {
+            Masked.Faces[FaceIndex].SetNumZeroed(Cubemap.Resolution * Cubemap.Resolution);
+            const FIntRect& Rect = Coverage.Rects[FaceIndex];
+            for (int32 Y = Rect.Min.Y; Y < Rect.Max.Y; ++Y)
+            {
+                for (int32 X = Rect.Min.X; X < Rect.Max.X; ++X)
+                {
+                    Masked.Faces[FaceIndex][Y * Cubemap.Resolution + X] = Cubemap.Faces[FaceIndex][Y * Cubemap.Resolution + X];
+                }
+            }
+        }
+        return Masked;
+    }
+
+    /** Remaps the full and the coverage-masked cubemap and counts differing output pixels. */
+    int32 CountMismatches(const FOmniCaptureSettings& Settings, const FOmniCaptureCubemapPixels& Cubemap, FOmniCaptureFaceCoverage& OutCoverage)
+    {
+        FOmniCaptureProjectionParams Params;
+        FIntPoint EyeSize;
+        FOmniCaptureProjectionRemap::GetConverterParams(Settings, Params, EyeSize);
+        OutCoverage = FOmniCaptureProjectionRemap::ComputeFaceCoverage(Settings);
+
+        const TSharedRef<const FOmniCaptureRemapTable> Table = FOmniCaptureProjectionRemap::BuildTable(Params, EyeSize, Settings.Resolution, Settings.SeamBlend);
+        const FOmniCaptureCubemapPixels Masked = MaskToCoverage(Cubemap, OutCoverage);
+
+        TArray<FLinearColor> Full;
+        TArray<FLinearColor> Cropped;
+        Full.SetNumZeroed(Table->Size.X * Table->Size.Y);
+        Cropped.SetNumZeroed(Table->Size.X * Table->Size.Y);
+        FOmniCaptureProjectionRemap::RemapCPU(*Table, Cubemap, Full, FIntPoint::ZeroValue, Table->Size.X);
+        FOmniCaptureProjectionRemap::RemapCPU(*Table, Masked, Cropped, FIntPoint::ZeroValue, Table->Size.X);
+
+        int32 Mismatches = 0;
+        for (int32 Index = 0; Index < Full.Num(); ++Index)
+        {
+            Mismatches += Full[Index] == Cropped[Index] ? 0 : 1;
+        }
+        return Mismatches;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureFaceCoverageTest, "OmniCapture.Projection.FaceCoverage", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCaptureFaceCoverageTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCaptureFaceCoverageTests;
+
+    constexpr int32 FaceResolution = 256;
+    const FOmniCaptureCubemapPixels Cubemap = MakeNoiseCubemap(FaceResolution);
+
+    FOmniCaptureSettings Base;
+    Base.Resolution = FaceResolution;
+    Base.FisheyeResolution = FIntPoint(512, 512);
+
+    struct FCase
+    {
+        const TCHAR* Name;
+        EOmniCaptureProjection Projection;
+        EOmniCaptureCoverage Coverage;
+        float FisheyeFOV;
+    };
+
+    const FCase Cases[] =
+    {
+        { TEXT("VR180 equirect"), EOmniCaptureProjection::Equirectangular, EOmniCaptureCoverage::HalfSphere, 180.0f },
+        { TEXT("360 equirect"), EOmniCaptureProjection::Equirectangular, EOmniCaptureCoverage::FullSphere, 180.0f },
+        { TEXT("180 fisheye"), EOmniCaptureProjection::Fisheye, EOmniCaptureCoverage::HalfSphere, 180.0f },
+        { TEXT("Cylindrical"), EOmniCaptureProjection::Cylindrical, EOmniCaptureCoverage::FullSphere, 180.0f },
+        { TEXT("Full dome"), EOmniCaptureProjection::FullDome, EOmniCaptureCoverage::FullSphere, 180.0f },
+    };
+
+    for (const FCase& Case : Cases)
+    {
+        FOmniCaptureSettings Settings = Base;
+        Settings.Projection = Case.Projection;
+        Settings.Coverage = Case.Coverage;
+        Settings.FisheyeFOV = Case.FisheyeFOV;
+
+        FOmniCaptureFaceCoverage Coverage;
+        const int32 Mismatches = CountMismatches(Settings, Cubemap, Coverage);
+        AddInfo(FString::Printf(TEXT("%s: renders %.1f%% of cube face texels"), Case.Name, Coverage.GetRenderedFraction() * 100.0f));
+        TestEqual(FString::Printf(TEXT("%s output is identical with only covered texels rendered"), Case.Name), Mismatches, 0);
+
+        if (Case.Coverage == EOmniCaptureCoverage::HalfSphere)
+        {
+            TestFalse(FString::Printf(TEXT("%s never samples the rear face"), Case.Name), Coverage.IsFaceUsed(1));
+            TestTrue(FString::Printf(TEXT("%s skips at least 40%% of face texels"), Case.Name), Coverage.GetRenderedFraction() <= 0.6f);
+        }
+    }
+
+    FOmniCaptureSettings FullSphere = Base;
+    FullSphere.Projection = EOmniCaptureProjection::Equirectangular;
+    const FOmniCaptureFaceCoverage FullCoverage = FOmniCaptureProjectionRemap::ComputeFaceCoverage(FullSphere);
+    TestEqual(TEXT("360 equirect renders every face in full"), FullCoverage.GetRenderedFraction(), 1.0f);
+
+    FullSphere.Projection = EOmniCaptureProjection::Cubemap;
+    TestEqual(TEXT("Cubemap layouts always render every face"), FOmniCaptureProjectionRemap::ComputeFaceCoverage(FullSphere).GetRenderedFraction(), 1.0f);
+    return true;
+}
@@ -0,0 +1,193 @@
+#include "Misc/AutomationTest.h"
+
+#include "HAL/PlatformTime.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Math/RandomStream.h"
+#include "Modules/ModuleManager.h"
+#include "OmniCaptureFoveatedEquirect.h"
+#include "OmniCaptureProjectionRemap.h"
+
+namespace OmniCaptureFoveatedEquirectTests
+{
+    /** Smooth sky/ground gradient with some texture, so PNG sizes resemble real content more than flat colour would. */
+    FOmniCaptureCubemapPixels MakeSceneCubemap(int32 Resolution)
+    {
+        FRandomStream Random(1234);
+        FOmniCaptureCubemapPixels Cubemap;
+        Cubemap.Resolution = Resolution;
+        for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+        {
+            TArray<FLinearColor>& Face = Cubemap.Faces[FaceIndex];
+            Face.SetNumUninitialized(Resolution * Resolution);
+            for (int32 Y = 0; Y < Resolution; ++Y)
+            {
+                for (int32 X = 0; X < Resolution; ++X)
+                {
+                    const FVector Direction = FOmniCaptureProjectionRemap::CubeFaceToDirection(FaceIndex, FVector2f((X + 0.5f) / Resolution, (Y + 0.5f) / Resolution));
+                    const float Stripe = 0.5f + 0.5f * FMath::Sin(static_cast<float>(FMath::Atan2(Direction.Z, Direction.X)) * 24.0f);
+                    const float Noise = Random.FRandRange(-0.02f, 0.02f);
+                    Face[Y * Resolution + X] = FLinearColor(
+                        FMath::Clamp(0.3f + 0.4f * static_cast<float>(Direction.Y) + Noise, 0.0f, 1.0f),
+                        FMath::Clamp(0.2f + 0.6f * Stripe + Noise, 0.0f, 1.0f),
+                        FMath::Clamp(0.6f - 0.3f * static_cast<float>(Direction.Y) + Noise, 0.0f, 1.0f),
+                        1.0f);
+                }
+            }
+        }
+        return Cubemap;
+    }
+
+    double TimeRemap(const FOmniCaptureRemapTable& Table, const FOmniCaptureCubemapPixels& Cubemap, int32 Iterations, TArray<FLinearColor>& OutPixels)
+    {
+        OutPixels.SetNumZeroed(Table.Size.X * Table.Size.Y);
+        const double Start = FPlatformTime::Seconds();
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            FOmniCaptureProjectionRemap::RemapCPU(Table, Cubemap, OutPixels, FIntPoint::ZeroValue, Table.Size.X);
+        }
+        return (FPlatformTime::Seconds() - Start) * 1000.0 / Iterations;
+    }
+
+    int64 CompressedPngSize(const TArray<FLinearColor>& Pixels, const FIntPoint& Size)
+    {
+        TArray<FColor> Colors;
+        Colors.SetNumUninitialized(Pixels.Num());
+        for (int32 Index = 0; Index < Pixels.Num(); ++Index)
+        {
+            Colors[Index] = Pixels[Index].ToFColor(true);
+        }
+
+        IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+        const TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+        if (!ImageWrapper.IsValid() || !ImageWrapper->SetRaw(Colors.GetData(), Colors.Num() * sizeof(FColor), Size.X, Size.Y, ERGBFormat::BGRA, 8))
+        {
+            return 0;
+        }
+        return ImageWrapper->GetCompressed(100).Num();
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureFoveatedLayoutTest, "OmniCapture.Projection.FoveatedLayout", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCaptureFoveatedLayoutTest::RunTest(const FString& Parameters)
+{
+    const FIntPoint SourceSize(4096, 2048);
+    const FOmniCaptureFoveatedLayout Layout = FOmniCaptureFoveatedLayout::Build(SourceSize, 60.0f, 2);
+
+    // 60..75 deg rows at half width and 75..90 deg rows at quarter width, per hemisphere.
+    TestEqual(TEXT("Five bands: quarter, half, full, half, quarter"), Layout.Bands.Num(), 5);
+    if (Layout.Bands.Num() == 5)
+    {
+        TestEqual(TEXT("Polar band divisor"), Layout.Bands[0].Divisor, 4);
+        TestEqual(TEXT("Mid band divisor"), Layout.Bands[1].Divisor, 2);
+        TestEqual(TEXT("Equator band divisor"), Layout.Bands[2].Divisor, 1);
+        TestEqual(TEXT("Bands are symmetric"), Layout.Bands[0].SourceRowCount, Layout.Bands[4].SourceRowCount);
+    }
+
+    const float Ratio = static_cast<float>(Layout.GetPackedHeight()) / SourceSize.Y;
+    AddInfo(FString::Printf(TEXT("Packed %d of %d rows (%.1f%%)"), Layout.GetPackedHeight(), SourceSize.Y, Ratio * 100.0f));
+    TestTrue(TEXT("Packing saves about a fifth of the frame"), Ratio > 0.75f && Ratio < 0.82f);
+
+    // Every packed pixel resolves back to exactly one source row and span.
+    int32 ResolveFailures = 0;
+    int32 ValidPixels = 0;
+    for (int32 Row = 0; Row < Layout.GetPackedHeight(); ++Row)
+    {
+        for (int32 X = 0; X < SourceSize.X; ++X)
+        {
+            int32 SourceRow = INDEX_NONE;
+            double U = 0.0;
+            if (Layout.ResolveOutputPixel(X, Row, SourceRow, U))
+            {
+                ++ValidPixels;
+                ResolveFailures += (SourceRow < 0 || SourceRow >= SourceSize.Y || U <= 0.0 || U >= 1.0) ? 1 : 0;
+            }
+        }
+    }
+    TestEqual(TEXT("Resolved pixels are in range"), ResolveFailures, 0);
+
+    int64 ExpectedValid = 0;
+    for (const FOmniCaptureFoveatedBand& Band : Layout.Bands)
+    {
+        ExpectedValid += static_cast<int64>(Band.SourceRowCount) * (SourceSize.X / Band.Divisor);
+    }
+    TestEqual(TEXT("Packed pixels cover every source span once"), static_cast<int64>(ValidPixels), ExpectedValid);
+
+    // Expand is lossless: packing the expanded frame gives back the packed frame bit for bit.
+    FRandomStream Random(7);
+    TArray<FLinearColor> Packed;
+    Packed.SetNumUninitialized(SourceSize.X * Layout.GetPackedHeight());
+    for (FLinearColor& Pixel : Packed)
+    {
+        Pixel = FLinearColor(Random.GetFraction(), Random.GetFraction(), Random.GetFraction(), 1.0f);
+    }
+    for (int32 Row = 0; Row < Layout.GetPackedHeight(); ++Row)
+    {
+        for (int32 X = 0; X < SourceSize.X; ++X)
+        {
+            int32 SourceRow = 0;
+            double U = 0.0;
+            if (!Layout.ResolveOutputPixel(X, Row, SourceRow, U))
+            {
+                Packed[Row * SourceSize.X + X] = FLinearColor::Transparent;
+            }
+        }
+    }
+
+    TArray<FLinearColor> Expanded;
+    Layout.Expand<FLinearColor>(Packed, SourceSize.X, Expanded);
+    TestEqual(TEXT("Expanded to the source size"), Expanded.Num(), SourceSize.X * SourceSize.Y);
+
+    TArray<FLinearColor> Repacked;
+    Layout.Pack(Expanded, Repacked);
+    int32 RoundTripMismatches = 0;
+    for (int32 Index = 0; Index < Packed.Num(); ++Index)
+    {
+        RoundTripMismatches += Packed[Index].Equals(Repacked[Index], 1.0e-6f) ? 0 : 1;
+    }
+    TestEqual(TEXT("Pack(Expand(P)) == P"), RoundTripMismatches, 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureFoveatedBenchmarkTest, "OmniCapture.Projection.FoveatedBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCaptureFoveatedBenchmarkTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCaptureFoveatedEquirectTests;
+
+    constexpr int32 FaceResolution = 512;
+    constexpr int32 Iterations = 8;
+    const FOmniCaptureCubemapPixels Cubemap = MakeSceneCubemap(FaceResolution);
+
+    FOmniCaptureSettings Settings;
+    Settings.Resolution = FaceResolution;
+    Settings.Projection = EOmniCaptureProjection::Equirectangular;
+    const FIntPoint EquirectSize = Settings.GetPerEyeOutputResolution();
+    const TSharedRef<const FOmniCaptureRemapTable> EquirectTable = FOmniCaptureProjectionRemap::BuildTable(FOmniCaptureProjectionParams::FromSettings(Settings), EquirectSize, FaceResolution, 0.0f);
+
+    Settings.Projection = EOmniCaptureProjection::FoveatedEquirectangular;
+    const FIntPoint FoveatedSize = Settings.GetPerEyeOutputResolution();
+    const TSharedRef<const FOmniCaptureRemapTable> FoveatedTable = FOmniCaptureProjectionRemap::BuildTable(FOmniCaptureProjectionParams::FromSettings(Settings), FoveatedSize, FaceResolution, 0.0f);
+
+    // The equirect table performs the same per-pixel work as the converter's CPU path (one face lookup and fetch per pixel).
+    TArray<FLinearColor> EquirectPixels;
+    TArray<FLinearColor> FoveatedPixels;
+    const double EquirectMs = TimeRemap(*EquirectTable, Cubemap, Iterations, EquirectPixels);
+    const double FoveatedMs = TimeRemap(*FoveatedTable, Cubemap, Iterations, FoveatedPixels);
+
+    const int64 EquirectBytes = CompressedPngSize(EquirectPixels, EquirectSize);
+    const int64 FoveatedBytes = CompressedPngSize(FoveatedPixels, FoveatedSize);
+
+    AddInfo(FString::Printf(TEXT("Equirect  %dx%d: %.2f ms/frame, %lld bytes PNG"), EquirectSize.X, EquirectSize.Y, EquirectMs, EquirectBytes));
+    AddInfo(FString::Printf(TEXT("Foveated  %dx%d: %.2f ms/frame, %lld bytes PNG"), FoveatedSize.X, FoveatedSize.Y, FoveatedMs, FoveatedBytes));
+    if (EquirectMs > 0.0 && EquirectBytes > 0)
+    {
+        AddInfo(FString::Printf(TEXT("Foveated/equirect: time %.2f, size %.2f"), FoveatedMs / EquirectMs, static_cast<double>(FoveatedBytes) / EquirectBytes));
+    }
+
+    TestTrue(TEXT("Foveated frame has fewer pixels"), FoveatedSize.X * FoveatedSize.Y < EquirectSize.X * EquirectSize.Y);
+    TestTrue(TEXT("Foveated frame compresses smaller"), FoveatedBytes > 0 && FoveatedBytes < EquirectBytes);
+    TestTrue(TEXT("Foveated table has fewer valid taps"), FoveatedTable->GetValidCount() < EquirectTable->GetValidCount());
+    return true;
+}
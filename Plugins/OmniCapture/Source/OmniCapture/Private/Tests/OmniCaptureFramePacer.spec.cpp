@@ -0,0 +1,128 @@
+#include "Misc/AutomationTest.h"
+
+#include "Math/RandomStream.h"
+#include "OmniCaptureFramePacer.h"
+
+namespace OmniCaptureFramePacerTests
+{
+    struct FPacingRun
+    {
+        TArray<int64> CapturedSlots;
+        int32 Ticks = 0;
+    };
+
+    /** Ticks the pacer for Seconds of game time at TickRate, optionally jittering each delta by up to Jitter. */
+    FPacingRun Simulate(FOmniCaptureFramePacer& Pacer, double TickRate, double Seconds, double Jitter = 0.0)
+    {
+        FPacingRun Run;
+        FRandomStream Random(0x51);
+        double Elapsed = 0.0;
+        while (Elapsed < Seconds - 0.5 / TickRate)
+        {
+            const double Delta = (1.0 / TickRate) * (1.0 + Jitter * (Random.FRand() * 2.0 - 1.0));
+            const FOmniCaptureFramePacingStep Step = Pacer.Advance(Delta);
+            if (Step.bCapture)
+            {
+                Run.CapturedSlots.Add(Step.Slot);
+            }
+            Elapsed += Delta;
+            ++Run.Ticks;
+        }
+        return Run;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureFramePacerTest, "OmniCapture.Capture.FramePacer", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCaptureFramePacerTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCaptureFramePacerTests;
+
+    FOmniCaptureFramePacer Pacer;
+
+    // Whole multiples decimate to a fixed cadence: 120 Hz ticks into 30 fps capture every fourth tick.
+    Pacer.Reset(EOmniCaptureFramePacing::Decimate, 30.0);
+    FPacingRun Run = Simulate(Pacer, 120.0, 1.0);
+    TestEqual(TEXT("120 Hz into 30 fps captures 30 frames"), Run.CapturedSlots.Num(), 30);
+    TestEqual(TEXT("120 Hz into 30 fps decimates the other ticks"), Pacer.GetDecimatedTicks(), static_cast<int64>(Run.Ticks - 30));
+    bool bContiguous = true;
+    for (int32 Index = 0; Index < Run.CapturedSlots.Num(); ++Index)
+    {
+        bContiguous &= Run.CapturedSlots[Index] == Index;
+    }
+    TestTrue(TEXT("Slots are contiguous when the engine keeps up"), bContiguous);
+    TestEqual(TEXT("Slot timecodes are constant rate"), Pacer.GetSlotTimecode(29), 29.0 / 30.0, 1.0e-12);
+
+    // Non-integer ratios: the accumulator carries the remainder instead of rounding the cadence.
+    Pacer.Reset(EOmniCaptureFramePacing::Decimate, 60.0);
+    Run = Simulate(Pacer, 144.0, 10.0);
+    TestEqual(TEXT("144 Hz into 60 fps captures 600 frames in 10 s"), Run.CapturedSlots.Num(), 600);
+    TestEqual(TEXT("144 Hz into 60 fps skips no slots"), Pacer.GetSkippedSlots(), static_cast<int64>(0));
+
+    // Jittered ticks still land within one frame of the target count.
+    Pacer.Reset(EOmniCaptureFramePacing::Decimate, 30.0);
+    Run = Simulate(Pacer, 90.0, 10.0, 0.3);
+    TestTrue(FString::Printf(TEXT("Jittered 90 Hz into 30 fps captures 300 +/- 1 frames (%d)"), Run.CapturedSlots.Num()), FMath::Abs(Run.CapturedSlots.Num() - 300) <= 1);
+    TestEqual(TEXT("Jittered slots are covered exactly once"), static_cast<int64>(Run.CapturedSlots.Num()) + Pacer.GetSkippedSlots(), Run.CapturedSlots.Last() + 1);
+
+    // A slow engine either skips the slots it ran past or fills them with duplicates.
+    Pacer.Reset(EOmniCaptureFramePacing::Decimate, 60.0);
+    Run = Simulate(Pacer, 20.0, 1.0);
+    TestEqual(TEXT("20 Hz into 60 fps captures every tick"), Run.CapturedSlots.Num(), Run.Ticks);
+    TestEqual(TEXT("20 Hz into 60 fps skips two slots per tick"), Pacer.GetSkippedSlots(), static_cast<int64>(2 * (Run.Ticks - 1)));
+    TestEqual(TEXT("Skipping mode duplicates nothing"), Pacer.GetDuplicatedSlots(), static_cast<int64>(0));
+
+    Pacer.Reset(EOmniCaptureFramePacing::DecimateAndDuplicate, 60.0);
+    Pacer.Advance(0.0);
+    const FOmniCaptureFramePacingStep SlowStep = Pacer.Advance(1.0 / 20.0);
+    TestEqual(TEXT("Slow tick renders the latest slot"), SlowStep.Slot, static_cast<int64>(3));
+    TestEqual(TEXT("Slow tick duplicates the slots it ran past"), SlowStep.DuplicateSlots, 2);
+    TestEqual(TEXT("Duplicates start right after the previous frame"), SlowStep.GetFirstSlot(), static_cast<int64>(1));
+    TestEqual(TEXT("Duplicating mode skips nothing"), SlowStep.SkippedSlots, 0);
+
+    // A long hitch duplicates at most one second and skips the rest.
+    const FOmniCaptureFramePacingStep HitchStep = Pacer.Advance(5.0);
+    TestEqual(TEXT("Hitch duplicates one second"), HitchStep.DuplicateSlots, 60);
+    TestEqual(TEXT("Hitch skips the remainder"), HitchStep.SkippedSlots, 5 * 60 - 1 - 60);
+    TestEqual(TEXT("Hitch lands on the current slot"), HitchStep.Slot, static_cast<int64>(3 + 5 * 60));
+
+    // Every-tick mode and a zero target keep the legacy behaviour.
+    Pacer.Reset(EOmniCaptureFramePacing::EveryTick, 30.0);
+    Run = Simulate(Pacer, 120.0, 1.0);
+    TestFalse(TEXT("Every-tick mode does not pace"), Pacer.IsPacing());
+    TestEqual(TEXT("Every-tick mode captures every tick"), Run.CapturedSlots.Num(), Run.Ticks);
+    Pacer.Reset(EOmniCaptureFramePacing::Decimate, 0.0);
+    TestFalse(TEXT("A zero target rate does not pace"), Pacer.IsPacing());
+
+    // Rational rates give exact timecodes: 30000 slots at 29.97 fps end at exactly 1001 s.
+    Pacer.Reset(EOmniCaptureFramePacing::Decimate, 29.97);
+    TestTrue(TEXT("29.97 fps is 30000/1001"), Pacer.GetFrameRate() == FFrameRate(30000, 1001));
+    TestEqual(TEXT("29.97 fps slot timecodes are exact"), Pacer.GetSlotTimecode(30000), 1001.0);
+    TestTrue(TEXT("23.976 fps is 24000/1001"), FOmniCaptureFramePacer::MakeFrameRate(24000.0 / 1001.0) == FFrameRate(24000, 1001));
+    TestTrue(TEXT("Odd rates fall back to thousandths"), FOmniCaptureFramePacer::MakeFrameRate(47.5) == FFrameRate(47500, 1000));
+
+    // Offline mode ignores the tick delta: warm-up ticks first, then one frame per TemporalSamples fixed steps.
+    constexpr int32 TemporalSamples = 4;
+    constexpr int32 WarmUpFrames = 2;
+    Pacer.Reset(EOmniCaptureFramePacing::FixedTimestep, 30.0, TemporalSamples, WarmUpFrames);
+    TestEqual(TEXT("Fixed step splits a frame over the temporal samples"), Pacer.GetFixedDeltaSeconds(), 1.0 / 120.0, 1.0e-15);
+    TArray<int64> OfflineSlots;
+    for (int32 Tick = 0; Tick < WarmUpFrames * TemporalSamples + 10 * TemporalSamples; ++Tick)
+    {
+        // A slow renderer reports long deltas; they must not change the output.
+        const FOmniCaptureFramePacingStep Step = Pacer.Advance(2.5);
+        if (Step.bCapture)
+        {
+            OfflineSlots.Add(Step.Slot);
+            TestEqual(FString::Printf(TEXT("Offline tick %d neither skips nor duplicates"), Tick), Step.DuplicateSlots + Step.SkippedSlots, 0);
+            TestEqual(FString::Printf(TEXT("Offline tick %d captures after the last sub-step"), Tick), (Tick + 1) % TemporalSamples, 0);
+        }
+    }
+    TestEqual(TEXT("Offline warm-up ticks"), Pacer.GetWarmUpTicks(), static_cast<int64>(WarmUpFrames * TemporalSamples));
+    TestEqual(TEXT("Offline capture renders ten frames"), OfflineSlots.Num(), 10);
+    TestEqual(TEXT("Offline slots are contiguous"), OfflineSlots.Last(), static_cast<int64>(9));
+    TestEqual(TEXT("Offline timecodes follow the frame rate"), Pacer.GetSlotTimecode(OfflineSlots.Last()), 9.0 / 30.0);
+
+    AddInfo(FString::Printf(TEXT("120 Hz editor ticks at a 30 fps target render %d of %d ticks"), 30, 120));
+    return true;
+}
@@ -0,0 +1,128 @@
+#include "Misc/AutomationTest.h"
+
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "OmniCaptureProjectionRemap.h"
+
+namespace OmniCaptureLayeredRemapTests
+{
+    FOmniCaptureCubemapPixels MakeNoiseCubemap(int32 Resolution, int32 Seed)
+    {
+        FRandomStream Random(Seed);
+        FOmniCaptureCubemapPixels Cubemap;
+        Cubemap.Resolution = Resolution;
+        for (TArray<FLinearColor>& Face : Cubemap.Faces)
+        {
+            Face.SetNumUninitialized(Resolution * Resolution);
+            for (FLinearColor& Pixel : Face)
+            {
+                Pixel = FLinearColor(Random.GetFraction(), Random.GetFraction(), Random.GetFraction(), Random.GetFraction());
+            }
+        }
+        return Cubemap;
+    }
+
+    /** Remaps every layer one by one and through RemapLayersCPU, then counts pixels that differ. */
+    int32 CountMismatches(const FOmniCaptureRemapTable& Table, const TArray<FOmniCaptureCubemapPixels>& Cubemaps, double& OutSeparateMs, double& OutBatchedMs)
+    {
+        const int32 PixelCount = Table.Size.X * Table.Size.Y;
+
+        TArray<TArray<FLinearColor>> Separate;
+        Separate.SetNum(Cubemaps.Num());
+        double Start = FPlatformTime::Seconds();
+        for (int32 Layer = 0; Layer < Cubemaps.Num(); ++Layer)
+        {
+            Separate[Layer].SetNumZeroed(PixelCount);
+            FOmniCaptureProjectionRemap::RemapCPU(Table, Cubemaps[Layer], Separate[Layer], FIntPoint::ZeroValue, Table.Size.X);
+        }
+        OutSeparateMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+        TArray<TArray<FLinearColor>> Batched;
+        TArray<TArrayView<FLinearColor>> Outputs;
+        TArray<const FOmniCaptureCubemapPixels*> Sources;
+        Batched.SetNum(Cubemaps.Num());
+        for (int32 Layer = 0; Layer < Cubemaps.Num(); ++Layer)
+        {
+            Batched[Layer].SetNumZeroed(PixelCount);
+            Outputs.Add(Batched[Layer]);
+            Sources.Add(&Cubemaps[Layer]);
+        }
+        Start = FPlatformTime::Seconds();
+        FOmniCaptureProjectionRemap::RemapLayersCPU(Table, Sources, Outputs, FIntPoint::ZeroValue, Table.Size.X);
+        OutBatchedMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+        int32 Mismatches = 0;
+        for (int32 Layer = 0; Layer < Cubemaps.Num(); ++Layer)
+        {
+            for (int32 Index = 0; Index < PixelCount; ++Index)
+            {
+                Mismatches += Separate[Layer][Index] == Batched[Layer][Index] ? 0 : 1;
+            }
+        }
+        return Mismatches;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureLayeredRemapTest, "OmniCapture.Projection.LayeredRemap", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCaptureLayeredRemapTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCaptureLayeredRemapTests;
+
+    constexpr int32 FaceResolution = 256;
+    constexpr int32 LayerCount = 4;
+
+    // Beauty plus three auxiliary passes from the same rig.
+    TArray<FOmniCaptureCubemapPixels> Layers;
+    for (int32 Layer = 0; Layer < LayerCount; ++Layer)
+    {
+        Layers.Add(MakeNoiseCubemap(FaceResolution, 100 + Layer));
+    }
+
+    struct FCase
+    {
+        const TCHAR* Name;
+        EOmniCaptureProjection Projection;
+        int32 SamplesPerAxis;
+    };
+
+    const FCase Cases[] =
+    {
+        { TEXT("Equirect"), EOmniCaptureProjection::Equirectangular, 1 },
+        { TEXT("Supersampled equirect"), EOmniCaptureProjection::Equirectangular, 2 },
+        { TEXT("Fisheye"), EOmniCaptureProjection::Fisheye, 1 },
+        { TEXT("Cubemap"), EOmniCaptureProjection::Cubemap, 1 },
+    };
+
+    for (const FCase& Case : Cases)
+    {
+        FOmniCaptureProjectionParams Params;
+        Params.Projection = Case.Projection;
+        Params.SamplesPerAxis = Case.SamplesPerAxis;
+        if (Case.Projection == EOmniCaptureProjection::Fisheye)
+        {
+            Params.HorizontalFovRadians = UE_PI;
+        }
+
+        const FIntPoint EyeSize = Case.Projection == EOmniCaptureProjection::Cubemap ? FIntPoint(768, 512) : FIntPoint(512, 256);
+        const TSharedRef<const FOmniCaptureRemapTable> Table = FOmniCaptureProjectionRemap::BuildTable(Params, EyeSize, FaceResolution, 0.0f);
+
+        double SeparateMs = 0.0;
+        double BatchedMs = 0.0;
+        const int32 Mismatches = CountMismatches(*Table, Layers, SeparateMs, BatchedMs);
+        AddInfo(FString::Printf(TEXT("%s, %d layers: separate %.2f ms, batched %.2f ms"), Case.Name, LayerCount, SeparateMs, BatchedMs));
+        TestEqual(FString::Printf(TEXT("%s batched layers match per-layer remaps"), Case.Name), Mismatches, 0);
+    }
+
+    // A layer whose faces differ in size cannot share footprints and still comes out right.
+    FOmniCaptureProjectionParams Params;
+    const TSharedRef<const FOmniCaptureRemapTable> Table = FOmniCaptureProjectionRemap::BuildTable(Params, FIntPoint(256, 128), FaceResolution, 0.0f);
+    TArray<FOmniCaptureCubemapPixels> MixedLayers;
+    MixedLayers.Add(MakeNoiseCubemap(FaceResolution, 7));
+    MixedLayers.Add(MakeNoiseCubemap(FaceResolution / 2, 8));
+
+    double SeparateMs = 0.0;
+    double BatchedMs = 0.0;
+    TestEqual(TEXT("Mixed face sizes match per-layer remaps"), CountMismatches(*Table, MixedLayers, SeparateMs, BatchedMs), 0);
+    return true;
+}
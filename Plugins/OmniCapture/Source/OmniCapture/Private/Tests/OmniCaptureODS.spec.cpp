@@ -0,0 +1,193 @@
+#include "Misc/AutomationTest.h"
+
+#include "OmniCaptureODS.h"
+#include "OmniCaptureProjectionRemap.h"
+
+namespace OmniCaptureODSTests
+{
+    /** Smooth stand-in for a rendered scene: colour is a function of view direction only. */
+    FLinearColor ShadeDirection(const FVector& Direction)
+    {
+        return FLinearColor(
+            static_cast<float>(0.5 + 0.5 * Direction.X),
+            static_cast<float>(0.5 + 0.5 * Direction.Y),
+            static_cast<float>(0.5 + 0.5 * Direction.Z),
+            1.0f);
+    }
+
+    /** Renders every view of the layout the way a slice camera would see the analytic scene. */
+    TArray<TArray<FLinearColor>> RenderSceneViews(const FOmniCaptureODSLayout& Layout)
+    {
+        TArray<TArray<FLinearColor>> Views;
+        Views.SetNum(Layout.GetViewCount());
+        for (int32 Slice = 0; Slice < Layout.SliceCount; ++Slice)
+        {
+            for (int32 Row = 0; Row < Layout.RowCount; ++Row)
+            {
+                TArray<FLinearColor>& View = Views[Layout.GetViewIndex(Slice, Row)];
+                View.SetNumUninitialized(Layout.ViewSize.X * Layout.ViewSize.Y);
+                for (int32 Y = 0; Y < Layout.ViewSize.Y; ++Y)
+                {
+                    for (int32 X = 0; X < Layout.ViewSize.X; ++X)
+                    {
+                        const FVector2f UV((X + 0.5f) / Layout.ViewSize.X, (Y + 0.5f) / Layout.ViewSize.Y);
+                        View[Y * Layout.ViewSize.X + X] = ShadeDirection(Layout.ViewUVToDirection(Slice, Row, UV));
+                    }
+                }
+            }
+        }
+        return Views;
+    }
+
+    /** Fills each view with a flat colour that encodes its slice and row, plus an eye tag in blue. */
+    TArray<TArray<FLinearColor>> MakeIdViews(const FOmniCaptureODSLayout& Layout, float EyeTag)
+    {
+        TArray<TArray<FLinearColor>> Views;
+        Views.SetNum(Layout.GetViewCount());
+        for (int32 Slice = 0; Slice < Layout.SliceCount; ++Slice)
+        {
+            for (int32 Row = 0; Row < Layout.RowCount; ++Row)
+            {
+                Views[Layout.GetViewIndex(Slice, Row)].Init(FLinearColor(static_cast<float>(Slice), static_cast<float>(Row), EyeTag, 1.0f), Layout.ViewSize.X * Layout.ViewSize.Y);
+            }
+        }
+        return Views;
+    }
+
+    /** Output pixels whose stitched colour does not name the slice and row its direction resolves to. */
+    int32 CountIdMismatches(const FOmniCaptureODSLayout& Layout, TConstArrayView<FLinearColor> Pixels, const FIntPoint& Offset, int32 RowStride, float EyeTag)
+    {
+        int32 Mismatches = 0;
+        for (int32 Y = 0; Y < Layout.EyeSize.Y; ++Y)
+        {
+            for (int32 X = 0; X < Layout.EyeSize.X; ++X)
+            {
+                double Longitude = 0.0;
+                double Latitude = 0.0;
+                Layout.GetOutputDirection(X, Y, Longitude, Latitude);
+                int32 Slice = 0;
+                int32 Row = 0;
+                Layout.ResolveView(Longitude, Latitude, Slice, Row);
+                const FLinearColor Expected(static_cast<float>(Slice), static_cast<float>(Row), EyeTag, 1.0f);
+                Mismatches += Pixels[(Offset.Y + Y) * RowStride + Offset.X + X] == Expected ? 0 : 1;
+            }
+        }
+        return Mismatches;
+    }
+
+    /** Taps that land within the bilinear margin of a view edge, where the slice frustum would be too small. */
+    int32 CountEdgeTaps(const FOmniCaptureODSLayout& Layout, const FOmniCaptureRemapTable& Table)
+    {
+        const float MinU = 1.0f / Layout.ViewSize.X;
+        const float MinV = 1.0f / Layout.ViewSize.Y;
+        int32 EdgeTaps = 0;
+        for (const FVector4f& Entry : Table.Entries)
+        {
+            EdgeTaps += Entry.X < MinU || Entry.X > 1.0f - MinU || Entry.Y < MinV || Entry.Y > 1.0f - MinV ? 1 : 0;
+        }
+        return EdgeTaps;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureODSStitchTest, "OmniCapture.Projection.ODSStitch", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCaptureODSStitchTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCaptureODSTests;
+
+    constexpr float IPDCm = 6.4f;
+    const FIntPoint EyeSize(512, 256);
+
+    struct FCase
+    {
+        const TCHAR* Name;
+        float LongitudeSpan;
+        float LatitudeSpan;
+        int32 SliceCount;
+    };
+
+    const FCase Cases[] =
+    {
+        { TEXT("360, 16 slices"), UE_TWO_PI, UE_PI, 16 },
+        { TEXT("360, 36 slices"), UE_TWO_PI, UE_PI, 36 },
+        { TEXT("360, 72 slices"), UE_TWO_PI, UE_PI, 72 },
+        { TEXT("180, 36 slices"), UE_PI, UE_PI, 36 },
+    };
+
+    for (const FCase& Case : Cases)
+    {
+        const FOmniCaptureODSLayout Layout = FOmniCaptureODSLayout::Build(EyeSize, Case.LongitudeSpan, Case.LatitudeSpan, Case.SliceCount, IPDCm);
+        if (!TestTrue(FString::Printf(TEXT("%s layout is valid"), Case.Name), Layout.IsValid()))
+        {
+            continue;
+        }
+        TestEqual(FString::Printf(TEXT("%s view count"), Case.Name), Layout.GetViewCount(), Case.SliceCount * Layout.RowCount);
+
+        // Both eyes of a slice sit on the IPD circle, opposite each other and sideways to the slice direction.
+        for (int32 Slice = 0; Slice < Layout.SliceCount; ++Slice)
+        {
+            const FVector LeftLocation = Layout.GetViewLocation(Slice, -1.0f);
+            const FVector RightLocation = Layout.GetViewLocation(Slice, 1.0f);
+            const FVector Forward = Layout.GetViewRotation(Slice, 0).Vector();
+            TestEqual(FString::Printf(TEXT("%s slice %d eye separation"), Case.Name, Slice), (RightLocation - LeftLocation).Size(), static_cast<double>(IPDCm), 1.0e-4);
+            TestEqual(FString::Printf(TEXT("%s slice %d eyes perpendicular to view"), Case.Name, Slice), FVector::DotProduct(RightLocation - LeftLocation, Forward), 0.0, 1.0e-4);
+        }
+
+        const TSharedRef<const FOmniCaptureRemapTable> Table = Layout.BuildStitchTable();
+        TestEqual(FString::Printf(TEXT("%s taps inside the view margin"), Case.Name), CountEdgeTaps(Layout, *Table), 0);
+
+        // Synthetic slice images: every output pixel must come from exactly the view its direction resolves to.
+        const TArray<TArray<FLinearColor>> LeftIds = MakeIdViews(Layout, 0.0f);
+        const TArray<TArray<FLinearColor>> RightIds = MakeIdViews(Layout, 1.0f);
+        const FIntPoint OutputSize(EyeSize.X, EyeSize.Y * 2);
+        const FIntPoint RightOffset(0, EyeSize.Y);
+        TArray<FLinearColor> Stitched;
+        Stitched.SetNumZeroed(OutputSize.X * OutputSize.Y);
+        const FOmniCaptureODSStitchTarget IdTargets[2] =
+        {
+            { LeftIds, Stitched, FIntPoint::ZeroValue },
+            { RightIds, Stitched, RightOffset },
+        };
+        FOmniCaptureODSLayout::StitchCPU(*Table, Layout.ViewSize, IdTargets, OutputSize.X);
+        TestEqual(FString::Printf(TEXT("%s left eye columns pick the nearest slice"), Case.Name), CountIdMismatches(Layout, Stitched, FIntPoint::ZeroValue, OutputSize.X, 0.0f), 0);
+        TestEqual(FString::Printf(TEXT("%s right eye columns pick the nearest slice"), Case.Name), CountIdMismatches(Layout, Stitched, RightOffset, OutputSize.X, 1.0f), 0);
+
+        // Stitching both eyes in one walk is bit-exact with stitching them one at a time.
+        TArray<FLinearColor> Separate;
+        Separate.SetNumZeroed(OutputSize.X * OutputSize.Y);
+        const FOmniCaptureODSStitchTarget LeftOnly[1] = { { LeftIds, Separate, FIntPoint::ZeroValue } };
+        const FOmniCaptureODSStitchTarget RightOnly[1] = { { RightIds, Separate, RightOffset } };
+        FOmniCaptureODSLayout::StitchCPU(*Table, Layout.ViewSize, LeftOnly, OutputSize.X);
+        FOmniCaptureODSLayout::StitchCPU(*Table, Layout.ViewSize, RightOnly, OutputSize.X);
+        TestTrue(FString::Printf(TEXT("%s shared stitch matches per-eye stitches"), Case.Name), Separate == Stitched);
+
+        // Views of a smooth scene stitch back into that scene at each output pixel's direction.
+        const TArray<TArray<FLinearColor>> SceneViews = RenderSceneViews(Layout);
+        TArray<FLinearColor> Scene;
+        Scene.SetNumZeroed(EyeSize.X * EyeSize.Y);
+        const FOmniCaptureODSStitchTarget SceneTarget[1] = { { SceneViews, Scene, FIntPoint::ZeroValue } };
+        FOmniCaptureODSLayout::StitchCPU(*Table, Layout.ViewSize, SceneTarget, EyeSize.X);
+
+        float MaxError = 0.0f;
+        for (int32 Y = 0; Y < EyeSize.Y; ++Y)
+        {
+            for (int32 X = 0; X < EyeSize.X; ++X)
+            {
+                double Longitude = 0.0;
+                double Latitude = 0.0;
+                const FLinearColor Expected = ShadeDirection(Layout.GetOutputDirection(X, Y, Longitude, Latitude));
+                const FLinearColor& Actual = Scene[Y * EyeSize.X + X];
+                MaxError = FMath::Max(MaxError, FMath::Max3(FMath::Abs(Actual.R - Expected.R), FMath::Abs(Actual.G - Expected.G), FMath::Abs(Actual.B - Expected.B)));
+            }
+        }
+        TestTrue(FString::Printf(TEXT("%s stitched scene within 0.01 (max error %.5f)"), Case.Name, MaxError), MaxError < 0.01f);
+
+        // Cubemap faces at the output's equator density, for scale.
+        const int32 FaceResolution = FMath::CeilToInt(EyeSize.X / 4.0f);
+        AddInfo(FString::Printf(TEXT("%s: %d views of %dx%d, %.3f MP per eye rendered (cubemap %.3f MP)"),
+            Case.Name, Layout.GetViewCount(), Layout.ViewSize.X, Layout.ViewSize.Y,
+            Layout.GetRenderedPixelCount() / 1.0e6, 6.0 * FaceResolution * FaceResolution / 1.0e6));
+    }
+
+    return true;
+}
@@ -0,0 +1,452 @@
+#include "Misc/AutomationTest.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "ImagePixelData.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "OmniCaptureBenchmark.h"
+#include "OmniCaptureEquirectConverter.h"
+#include "OmniCaptureMuxer.h"
+#include "OmniCaptureProjectionRemap.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace OmniCapturePerfTests
+{
+    /**
+     * Golden checksums, sampling signatures and timings from Private/Tests/Baselines/OmniCapturePerfBaselines.json.
+     *
+     * Checksums and sampling signatures are shared by every platform; timings are keyed by platform. A case missing
+     * any of them is an error. Every run writes what it measured to Saved/OmniCapture/Perf so CI can promote it into
+     * the baseline file; -OmniCapturePerfTolerance=<fraction> overrides the allowed slowdown.
+     */
+    class FPerfBaselines
+    {
+    public:
+        FPerfBaselines(FAutomationTestBase& InTest, const FString& InSuite)
+            : Test(InTest)
+            , Suite(InSuite)
+            , Platform(FPlatformProperties::IniPlatformName())
+            , Measured(MakeShared<FJsonObject>())
+        {
+            FString BaselineString;
+            TSharedPtr<FJsonObject> Root;
+            if (FFileHelper::LoadFileToString(BaselineString, *GetBaselinePath())
+                && FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BaselineString), Root) && Root.IsValid())
+            {
+                Root->TryGetNumberField(TEXT("tolerance"), Tolerance);
+                Root->TryGetNumberField(TEXT("slackMs"), SlackMilliseconds);
+                Root->TryGetNumberField(TEXT("signatureTolerance"), SignatureTolerance);
+                const TSharedPtr<FJsonObject>* ChecksumObject = nullptr;
+                if (Root->TryGetObjectField(TEXT("checksums"), ChecksumObject))
+                {
+                    Checksums = *ChecksumObject;
+                }
+                const TSharedPtr<FJsonObject>* SignatureObject = nullptr;
+                if (Root->TryGetObjectField(TEXT("signatures"), SignatureObject))
+                {
+                    Signatures = *SignatureObject;
+                }
+                const TSharedPtr<FJsonObject>* Platforms = nullptr;
+                const TSharedPtr<FJsonObject>* PlatformCases = nullptr;
+                if (Root->TryGetObjectField(TEXT("platforms"), Platforms) && (*Platforms)->TryGetObjectField(Platform, PlatformCases))
+                {
+                    Timings = *PlatformCases;
+                }
+            }
+            else
+            {
+                Test.AddError(FString::Printf(TEXT("No perf baselines at %s"), *GetBaselinePath()));
+            }
+            FParse::Value(FCommandLine::Get(), TEXT("OmniCapturePerfTolerance="), Tolerance);
+        }
+
+        ~FPerfBaselines()
+        {
+            FString MeasuredString;
+            FJsonSerializer::Serialize(Measured, TJsonWriterFactory<>::Create(&MeasuredString));
+            const FString MeasuredPath = FPaths::ProjectSavedDir() / TEXT("OmniCapture") / TEXT("Perf") / Platform / (Suite + TEXT(".json"));
+            FFileHelper::SaveStringToFile(MeasuredString, *MeasuredPath);
+        }
+
+        /** Checksums must match the committed one exactly. */
+        void CheckChecksum(const FString& Name, const FString& Checksum)
+        {
+            GetMeasuredEntry(Name)->SetStringField(TEXT("checksum"), Checksum);
+
+            FString BaselineChecksum;
+            if (!Checksums.IsValid() || !Checksums->TryGetStringField(Name, BaselineChecksum))
+            {
+                Test.AddError(FString::Printf(TEXT("%s has no golden checksum (measured %s)"), *Name, *Checksum));
+                return;
+            }
+            Test.TestEqual(FString::Printf(TEXT("%s output matches its golden checksum"), *Name), Checksum, BaselineChecksum);
+        }
+
+        /** Signature values may each differ from the committed ones by SignatureTolerance. */
+        void CheckSignature(const FString& Name, const TArray<double>& Signature)
+        {
+            TArray<TSharedPtr<FJsonValue>> MeasuredValues;
+            for (const double Value : Signature)
+            {
+                MeasuredValues.Add(MakeShared<FJsonValueNumber>(Value));
+            }
+            GetMeasuredEntry(Name)->SetArrayField(TEXT("signature"), MeasuredValues);
+
+            const TArray<TSharedPtr<FJsonValue>>* BaselineValues = nullptr;
+            if (!Signatures.IsValid() || !Signatures->TryGetArrayField(Name, BaselineValues))
+            {
+                Test.AddError(FString::Printf(TEXT("%s has no golden sampling signature"), *Name));
+                return;
+            }
+            if (!Test.TestEqual(FString::Printf(TEXT("%s signature length"), *Name), Signature.Num(), BaselineValues->Num()))
+            {
+                return;
+            }
+
+            int32 WorstIndex = 0;
+            double WorstError = 0.0;
+            for (int32 Index = 0; Index < Signature.Num(); ++Index)
+            {
+                const double Error = FMath::Abs(Signature[Index] - (*BaselineValues)[Index]->AsNumber());
+                if (Error > WorstError)
+                {
+                    WorstIndex = Index;
+                    WorstError = Error;
+                }
+            }
+            if (WorstError > SignatureTolerance)
+            {
+                Test.AddError(FString::Printf(TEXT("%s sampling moved: value %d is %.6f, golden %.6f"), *Name, WorstIndex, Signature[WorstIndex], (*BaselineValues)[WorstIndex]->AsNumber()));
+            }
+        }
+
+        /** Timings may exceed the platform's baseline by Tolerance plus SlackMilliseconds. */
+        void CheckTiming(const FString& Name, double Milliseconds)
+        {
+            GetMeasuredEntry(Name)->SetNumberField(TEXT("ms"), Milliseconds);
+
+            const TSharedPtr<FJsonObject>* Baseline = nullptr;
+            double BaselineMilliseconds = 0.0;
+            if (!Timings.IsValid() || !Timings->TryGetObjectField(Name, Baseline) || !(*Baseline)->TryGetNumberField(TEXT("ms"), BaselineMilliseconds) || BaselineMilliseconds <= 0.0)
+            {
+                Test.AddError(FString::Printf(TEXT("%s has no %s timing baseline (measured %.2f ms); promote Saved/OmniCapture/Perf/%s/%s.json into the baseline file"), *Name, *Platform, Milliseconds, *Platform, *Suite));
+                return;
+            }
+
+            const double Limit = BaselineMilliseconds * (1.0 + Tolerance) + SlackMilliseconds;
+            if (Milliseconds > Limit)
+            {
+                Test.AddError(FString::Printf(TEXT("%s regressed: %.2f ms against a %.2f ms baseline (limit %.2f ms)"), *Name, Milliseconds, BaselineMilliseconds, Limit));
+            }
+            else
+            {
+                Test.AddInfo(FString::Printf(TEXT("%s: %.2f ms (baseline %.2f ms)"), *Name, Milliseconds, BaselineMilliseconds));
+            }
+        }
+
+    private:
+        TSharedPtr<FJsonObject> GetMeasuredEntry(const FString& Name)
+        {
+            const TSharedPtr<FJsonObject>* Entry = nullptr;
+            if (Measured->TryGetObjectField(Name, Entry))
+            {
+                return *Entry;
+            }
+            TSharedRef<FJsonObject> NewEntry = MakeShared<FJsonObject>();
+            Measured->SetObjectField(Name, NewEntry);
+            return NewEntry;
+        }
+
+        static FString GetBaselinePath()
+        {
+            const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("OmniCapture"));
+            return Plugin.IsValid() ? Plugin->GetBaseDir() / TEXT("Source/OmniCapture/Private/Tests/Baselines/OmniCapturePerfBaselines.json") : FString();
+        }
+
+        FAutomationTestBase& Test;
+        FString Suite;
+        FString Platform;
+        double Tolerance = 0.25;
+        double SlackMilliseconds = 2.0;
+        double SignatureTolerance = 1.0e-4;
+        TSharedPtr<FJsonObject> Checksums;
+        TSharedPtr<FJsonObject> Signatures;
+        TSharedPtr<FJsonObject> Timings;
+        TSharedRef<FJsonObject> Measured;
+    };
+
+    FString HashPixels(const FImagePixelData& PixelData)
+    {
+        const void* RawData = nullptr;
+        int64 SizeBytes = 0;
+        if (!PixelData.GetRawData(RawData, SizeBytes) || SizeBytes <= 0)
+        {
+            return FString();
+        }
+        return FString::Printf(TEXT("%08x"), FCrc::MemCrc32(RawData, static_cast<int32>(SizeBytes)));
+    }
+
+    /** True when the muxer's ffmpeg actually starts; a bare "ffmpeg" resolves even when nothing is on the PATH. */
+    bool CanRunFFmpeg()
+    {
+        FString Binary;
+        int32 ReturnCode = -1;
+        return FOmniCaptureMuxer::IsFFmpegAvailable(FOmniCaptureSettings(), &Binary)
+            && FPlatformProcess::ExecProcess(*Binary, TEXT("-version"), &ReturnCode, nullptr, nullptr) && ReturnCode == 0;
+    }
+
+    // Each face has its own flat colour, so every output pixel is exactly the colour of the face it sampled: lerps
+    // between equal texels and single taps of weight 1 are exact. Faces are picked in double precision and no case
+    // has a pixel within 1e-5 of a face edge, so the checksums pin the projection, face choice, eye placement,
+    // coverage mask, pixel format and packing without depending on how a platform rounds the remap maths. The
+    // channels are exact in half floats and none lands near a rounding edge once sRGB encoded to 8 or 10 bits.
+    const FLinearColor LeftFaceColors[6] =
+    {
+        FLinearColor(1.0f, 0.25f, 0.0f, 1.0f), FLinearColor(0.0f, 1.0f, 0.25f, 1.0f), FLinearColor(0.25f, 0.0f, 1.0f, 1.0f),
+        FLinearColor(1.0f, 1.0f, 0.375f, 1.0f), FLinearColor(0.375f, 1.0f, 1.0f, 1.0f), FLinearColor(1.0f, 0.375f, 1.0f, 1.0f)
+    };
+    const FLinearColor RightFaceColors[6] =
+    {
+        FLinearColor(0.5625f, 0.0f, 0.0f, 1.0f), FLinearColor(0.0f, 0.5625f, 0.0f, 1.0f), FLinearColor(0.0f, 0.0f, 0.5625f, 1.0f),
+        FLinearColor(0.5625f, 0.5625f, 0.1875f, 1.0f), FLinearColor(0.1875f, 0.5625f, 0.5625f, 1.0f), FLinearColor(0.5625f, 0.1875f, 0.5625f, 1.0f)
+    };
+
+    /** A cubemap with one colour per face and the face sizes MakeSyntheticCubemap picks for the settings. */
+    void MakeFaceColorCubemap(const FOmniCaptureSettings& Settings, const FLinearColor (&Colors)[6], FOmniCaptureCubemapPixels& OutCubemap)
+    {
+        FOmniCaptureBenchmark::MakeSyntheticCubemap(Settings, 0, OutCubemap);
+        for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+        {
+            for (FLinearColor& Texel : OutCubemap.Faces[FaceIndex])
+            {
+                Texel = Colors[FaceIndex];
+            }
+        }
+    }
+
+    /**
+     * Full-size faces whose texels hold their own centre UV in red and green and the face in blue. Bilinear taps
+     * reproduce the UV they were asked for, so the converted image reads back where every output pixel sampled.
+     */
+    void MakeSampleReadoutCubemap(int32 Resolution, FOmniCaptureCubemapPixels& OutCubemap)
+    {
+        OutCubemap.Resolution = Resolution;
+        for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+        {
+            OutCubemap.FaceResolutions[FaceIndex] = Resolution;
+            TArray<FLinearColor>& Face = OutCubemap.Faces[FaceIndex];
+            Face.SetNumUninitialized(Resolution * Resolution);
+            for (int32 Y = 0; Y < Resolution; ++Y)
+            {
+                for (int32 X = 0; X < Resolution; ++X)
+                {
+                    Face[Y * Resolution + X] = FLinearColor((X + 0.5f) / Resolution, (Y + 0.5f) / Resolution, (FaceIndex + 1) / 8.0f, 1.0f);
+                }
+            }
+        }
+    }
+
+    /**
+     * Mean red, green and blue of an 8x4 grid of blocks over a float image, row by row. Goldens come from a double
+     * precision model of the remap, and float rounding moves a mean by well under 1e-6, while a tenth of a texel
+     * shift in where the blocks sample moves it by about 4e-4.
+     */
+    TArray<double> ComputeSamplingSignature(const FOmniCaptureEquirectResult& Result)
+    {
+        constexpr int32 BlocksX = 8;
+        constexpr int32 BlocksY = 4;
+        TArray<double> Signature;
+        const TImagePixelData<FLinearColor>* PixelData = static_cast<const TImagePixelData<FLinearColor>*>(Result.PixelData.Get());
+        if (Result.PixelDataType != EOmniCapturePixelDataType::LinearColorFloat32 || !PixelData || PixelData->Pixels.Num() != Result.Size.X * Result.Size.Y)
+        {
+            return Signature;
+        }
+
+        for (int32 BlockY = 0; BlockY < BlocksY; ++BlockY)
+        {
+            for (int32 BlockX = 0; BlockX < BlocksX; ++BlockX)
+            {
+                const FIntRect Block(Result.Size.X * BlockX / BlocksX, Result.Size.Y * BlockY / BlocksY, Result.Size.X * (BlockX + 1) / BlocksX, Result.Size.Y * (BlockY + 1) / BlocksY);
+                double Sums[3] = { 0.0, 0.0, 0.0 };
+                for (int32 Y = Block.Min.Y; Y < Block.Max.Y; ++Y)
+                {
+                    for (int32 X = Block.Min.X; X < Block.Max.X; ++X)
+                    {
+                        const FLinearColor& Pixel = PixelData->Pixels[Y * Result.Size.X + X];
+                        Sums[0] += Pixel.R;
+                        Sums[1] += Pixel.G;
+                        Sums[2] += Pixel.B;
+                    }
+                }
+                const double Count = FMath::Max(1, Block.Area());
+                Signature.Append({ Sums[0] / Count, Sums[1] / Count, Sums[2] / Count });
+            }
+        }
+        return Signature;
+    }
+
+    FOmniCaptureSettings MakeConversionSettings(EOmniCaptureProjection Projection, EOmniCaptureMode Mode, EOmniCaptureGamma Gamma, EOmniCaptureHDRPrecision Precision)
+    {
+        FOmniCaptureSettings Settings;
+        Settings.Mode = Mode;
+        Settings.Projection = Projection;
+        Settings.Resolution = 256;
+        Settings.Gamma = Gamma;
+        Settings.HDRPrecision = Precision;
+        Settings.bAdaptiveFaceResolution = true;
+        // Not square, so no fisheye pixel centre sits on a diagonal where two faces tie.
+        Settings.FisheyeResolution = FIntPoint(512, 384);
+        return Settings;
+    }
+
+    double MedianMilliseconds(TArray<double>& Samples)
+    {
+        return FOmniCaptureBenchmark::ComputeStageStats(Samples).P50Milliseconds;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCapturePerfConversionTest, "OmniCapture.Perf.Conversion", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCapturePerfConversionTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCapturePerfTests;
+
+    struct FConversionCase
+    {
+        const TCHAR* Name;
+        FOmniCaptureSettings Settings;
+    };
+
+    TArray<FConversionCase> Cases;
+    Cases.Add({ TEXT("Equirect_Mono_SRGB8"), MakeConversionSettings(EOmniCaptureProjection::Equirectangular, EOmniCaptureMode::Mono, EOmniCaptureGamma::SRGB, EOmniCaptureHDRPrecision::HalfFloat) });
+    Cases.Add({ TEXT("Equirect_Mono_Half"), MakeConversionSettings(EOmniCaptureProjection::Equirectangular, EOmniCaptureMode::Mono, EOmniCaptureGamma::Linear, EOmniCaptureHDRPrecision::HalfFloat) });
+    Cases.Add({ TEXT("Equirect_Mono_Float"), MakeConversionSettings(EOmniCaptureProjection::Equirectangular, EOmniCaptureMode::Mono, EOmniCaptureGamma::Linear, EOmniCaptureHDRPrecision::FullFloat) });
+    Cases.Add({ TEXT("Equirect_Stereo_Half"), MakeConversionSettings(EOmniCaptureProjection::Equirectangular, EOmniCaptureMode::Stereo, EOmniCaptureGamma::Linear, EOmniCaptureHDRPrecision::HalfFloat) });
+    Cases.Add({ TEXT("Fisheye_Mono_Half"), MakeConversionSettings(EOmniCaptureProjection::Fisheye, EOmniCaptureMode::Mono, EOmniCaptureGamma::Linear, EOmniCaptureHDRPrecision::HalfFloat) });
+    Cases.Add({ TEXT("Cylindrical_Mono_Half"), MakeConversionSettings(EOmniCaptureProjection::Cylindrical, EOmniCaptureMode::Mono, EOmniCaptureGamma::Linear, EOmniCaptureHDRPrecision::HalfFloat) });
+    Cases.Add({ TEXT("Cubemap_Mono_Half"), MakeConversionSettings(EOmniCaptureProjection::Cubemap, EOmniCaptureMode::Mono, EOmniCaptureGamma::Linear, EOmniCaptureHDRPrecision::HalfFloat) });
+    Cases.Add({ TEXT("EAC_Mono_Half"), MakeConversionSettings(EOmniCaptureProjection::EquiAngularCubemap, EOmniCaptureMode::Mono, EOmniCaptureGamma::Linear, EOmniCaptureHDRPrecision::HalfFloat) });
+    Cases.Add({ TEXT("Foveated_Mono_Half"), MakeConversionSettings(EOmniCaptureProjection::FoveatedEquirectangular, EOmniCaptureMode::Mono, EOmniCaptureGamma::Linear, EOmniCaptureHDRPrecision::HalfFloat) });
+    FConversionCase& Packed = Cases.Add_GetRef({ TEXT("Equirect_Stereo_Packed10"), MakeConversionSettings(EOmniCaptureProjection::Equirectangular, EOmniCaptureMode::Stereo, EOmniCaptureGamma::Linear, EOmniCaptureHDRPrecision::HalfFloat) });
+    Packed.Settings.ImageFormat = EOmniCaptureImageFormat::Y4M;
+
+    FPerfBaselines Baselines(*this, TEXT("Conversion"));
+    for (const FConversionCase& Case : Cases)
+    {
+        const FOmniCaptureSettings& Settings = Case.Settings;
+        const EOmniCapturePixelPrecision Precision = Settings.HDRPrecision == EOmniCaptureHDRPrecision::FullFloat ? EOmniCapturePixelPrecision::FullFloat : EOmniCapturePixelPrecision::HalfFloat;
+
+        // The checksum run converts one colour per face, which is exact on every platform. It also builds the remap
+        // table the timed runs reuse.
+        FOmniCaptureCubemapPixels LeftFlat;
+        FOmniCaptureCubemapPixels RightFlat;
+        MakeFaceColorCubemap(Settings, LeftFaceColors, LeftFlat);
+        MakeFaceColorCubemap(Settings, RightFaceColors, RightFlat);
+        FOmniCaptureEquirectResult Result = FOmniCaptureEquirectConverter::ConvertCubemapsOnCPU(Settings, LeftFlat, RightFlat, Precision);
+        FOmniCaptureEquirectConverter::PackOutputPixels(Settings, Result);
+        if (!TestTrue(FString::Printf(TEXT("%s converts"), Case.Name), Result.PixelData.IsValid()))
+        {
+            continue;
+        }
+        TestTrue(FString::Printf(TEXT("%s has the output size"), Case.Name), Result.Size == Settings.GetOutputResolution());
+        Baselines.CheckChecksum(Case.Name, HashPixels(*Result.PixelData));
+
+        // Timings use the gradient inputs, which exercise the sampling like a real frame; the median of five runs counts.
+        FOmniCaptureCubemapPixels LeftCubemap;
+        FOmniCaptureCubemapPixels RightCubemap;
+        FOmniCaptureBenchmark::MakeSyntheticCubemap(Settings, 0, LeftCubemap);
+        FOmniCaptureBenchmark::MakeSyntheticCubemap(Settings, 1, RightCubemap);
+        TArray<double> Samples;
+        for (int32 Iteration = 0; Iteration < 5; ++Iteration)
+        {
+            const double StartSeconds = FPlatformTime::Seconds();
+            FOmniCaptureEquirectResult Timed = FOmniCaptureEquirectConverter::ConvertCubemapsOnCPU(Settings, LeftCubemap, RightCubemap, Precision);
+            FOmniCaptureEquirectConverter::PackOutputPixels(Settings, Timed);
+            Samples.Add((FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+        }
+        Baselines.CheckTiming(Case.Name, MedianMilliseconds(Samples));
+    }
+
+    // Face colours cannot see where inside a face a pixel sampled, so each projection also converts the UV readout
+    // faces and compares block means against its golden signature.
+    struct FSamplingCase
+    {
+        const TCHAR* Name;
+        EOmniCaptureProjection Projection;
+    };
+
+    const FSamplingCase SamplingCases[] =
+    {
+        { TEXT("Equirect_Sampling"), EOmniCaptureProjection::Equirectangular },
+        { TEXT("Fisheye_Sampling"), EOmniCaptureProjection::Fisheye },
+        { TEXT("Cylindrical_Sampling"), EOmniCaptureProjection::Cylindrical },
+        { TEXT("Cubemap_Sampling"), EOmniCaptureProjection::Cubemap },
+        { TEXT("EAC_Sampling"), EOmniCaptureProjection::EquiAngularCubemap },
+        { TEXT("Foveated_Sampling"), EOmniCaptureProjection::FoveatedEquirectangular },
+    };
+    for (const FSamplingCase& Case : SamplingCases)
+    {
+        FOmniCaptureSettings Settings = MakeConversionSettings(Case.Projection, EOmniCaptureMode::Mono, EOmniCaptureGamma::Linear, EOmniCaptureHDRPrecision::FullFloat);
+        Settings.bAdaptiveFaceResolution = false;
+
+        FOmniCaptureCubemapPixels Readout;
+        MakeSampleReadoutCubemap(Settings.Resolution, Readout);
+        const FOmniCaptureEquirectResult Result = FOmniCaptureEquirectConverter::ConvertCubemapsOnCPU(Settings, Readout, Readout, EOmniCapturePixelPrecision::FullFloat);
+        const TArray<double> Signature = ComputeSamplingSignature(Result);
+        if (TestFalse(FString::Printf(TEXT("%s converts to float pixels"), Case.Name), Signature.IsEmpty()))
+        {
+            Baselines.CheckSignature(Case.Name, Signature);
+        }
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCapturePerfWritersTest, "OmniCapture.Perf.Writers", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCapturePerfWritersTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCapturePerfTests;
+
+    // Small frames keep the suite quick; every writer path, the ring buffer, frame index and manifest still run.
+    // Writer timings include disk I/O and vary with the machine's storage, so treat their baselines as coarse. The
+    // files carry no golden checksum: PNG, JPG and EXR bytes depend on the engine's image libraries.
+    FOmniCaptureBenchmarkOptions Options;
+    Options.OutputWidths = { 512 };
+    Options.FramesPerCase = 4;
+    Options.bKeepOutputs = true;
+    Options.OutputDirectory = FPaths::AutomationTransientDir() / TEXT("OmniCapturePerf");
+    Options.bMux = CanRunFFmpeg();
+    if (!Options.bMux)
+    {
+        AddInfo(TEXT("ffmpeg is not available; the mux cases are skipped"));
+    }
+
+    FPerfBaselines Baselines(*this, TEXT("Writers"));
+    for (const FOmniCaptureBenchmarkCase& Case : FOmniCaptureBenchmark::MakeCases(Options))
+    {
+        const FOmniCaptureBenchmarkResult Result = FOmniCaptureBenchmark::RunCase(Case, Options);
+        if (!TestTrue(FString::Printf(TEXT("%s writes every frame (%s)"), *Case.Name, *Result.Error), Result.bSucceeded))
+        {
+            continue;
+        }
+        TestTrue(FString::Printf(TEXT("%s writes its manifest"), *Case.Name), IFileManager::Get().FileExists(*(Case.Settings.OutputDirectory / Case.Settings.OutputFileName + TEXT("_Manifest.json"))));
+        Baselines.CheckTiming(Case.Name, Result.WallSeconds * 1000.0 / FMath::Max(Result.Frames, 1));
+
+        if (Options.bMux)
+        {
+            TestTrue(FString::Printf(TEXT("%s muxes"), *Case.Name), Result.bMuxed);
+            Baselines.CheckTiming(Case.Name + TEXT("_Mux"), Result.Stages[static_cast<int32>(EOmniCaptureStage::Mux)].MaxMilliseconds);
+        }
+        IFileManager::Get().DeleteDirectory(*Case.Settings.OutputDirectory, false, true);
+    }
+    return true;
+}
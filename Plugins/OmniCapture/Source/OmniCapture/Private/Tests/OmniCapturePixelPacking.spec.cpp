@@ -0,0 +1,197 @@
+#include "Misc/AutomationTest.h"
+
+#include "HAL/FileManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include <limits>
+#include "OmniCapturePixelPacking.h"
+#include "OmniCaptureY4MWriter.h"
+
+namespace OmniCapturePixelPackingTests
+{
+    float EncodeSRGBReference(float Value)
+    {
+        return Value <= 0.0031308f ? Value * 12.92f : 1.055f * FMath::Pow(Value, 1.0f / 2.4f) - 0.055f;
+    }
+
+    double EncodePQReference(double Nits)
+    {
+        const double Y = FMath::Pow(Nits / 10000.0, 2610.0 / 16384.0);
+        return FMath::Pow((3424.0 / 4096.0 + 2413.0 / 128.0 * Y) / (1.0 + 2392.0 / 128.0 * Y), 2523.0 / 32.0);
+    }
+
+    TImagePixelData<FOmniCapturePackedRGB10A2> MakeFlatFrame(const FIntPoint& Size, const FLinearColor& Color)
+    {
+        TImagePixelData<FOmniCapturePackedRGB10A2> Frame(Size);
+        Frame.Pixels.Init(FOmniCapturePixelPacking::PackRGB10A2(Color), Size.X * Size.Y);
+        return Frame;
+    }
+
+    uint16 ReadSample(const TArray<uint8>& Bytes, int64 Offset)
+    {
+        return static_cast<uint16>(Bytes[Offset] | (Bytes[Offset + 1] << 8));
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCapturePixelPackingTest, "OmniCapture.Output.PixelPacking", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCapturePixelPackingTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCapturePixelPackingTests;
+
+    // Every code survives a dequantize/quantize round trip at each encoder depth.
+    for (const int32 BitDepth : { 10, 12, 16 })
+    {
+        int32 Mismatches = 0;
+        const uint32 MaxCode = (1u << BitDepth) - 1u;
+        for (uint32 Code = 0; Code <= MaxCode; ++Code)
+        {
+            Mismatches += FOmniCapturePixelPacking::QuantizeUnorm(FOmniCapturePixelPacking::DequantizeUnorm(Code, BitDepth), BitDepth) == Code ? 0 : 1;
+        }
+        TestEqual(FString::Printf(TEXT("%d-bit codes round trip"), BitDepth), Mismatches, 0);
+    }
+    TestEqual(TEXT("Values above one clamp"), static_cast<int32>(FOmniCapturePixelPacking::QuantizeUnorm(4.0f, 10)), 1023);
+    TestEqual(TEXT("Negative values clamp"), static_cast<int32>(FOmniCapturePixelPacking::QuantizeUnorm(-1.0f, 10)), 0);
+    TestEqual(TEXT("NaN lands on zero"), static_cast<int32>(FOmniCapturePixelPacking::QuantizeUnorm(std::numeric_limits<float>::quiet_NaN(), 10)), 0);
+
+    // Packed words unpack and repack bit-exactly, and floats come back within half a 10-bit step.
+    FRandomStream Random(0x0C10);
+    int32 WordMismatches = 0;
+    float MaxError = 0.0f;
+    for (int32 Index = 0; Index < 4096; ++Index)
+    {
+        FOmniCapturePackedRGB10A2 Word;
+        Word.Bits = static_cast<uint32>(Random.GetUnsignedInt());
+        WordMismatches += FOmniCapturePixelPacking::PackRGB10A2(FOmniCapturePixelPacking::UnpackRGB10A2(Word)) == Word ? 0 : 1;
+
+        const FLinearColor Color(Random.FRand(), Random.FRand(), Random.FRand(), 1.0f);
+        const FLinearColor RoundTrip = FOmniCapturePixelPacking::UnpackRGB10A2(FOmniCapturePixelPacking::PackRGB10A2(Color));
+        MaxError = FMath::Max(MaxError, FMath::Max3(FMath::Abs(RoundTrip.R - Color.R), FMath::Abs(RoundTrip.G - Color.G), FMath::Abs(RoundTrip.B - Color.B)));
+    }
+    TestEqual(TEXT("Packed words round trip"), WordMismatches, 0);
+    TestTrue(FString::Printf(TEXT("Float round trip within half a step (max error %.6f)"), MaxError), MaxError <= 0.5f / 1023.0f + 1.0e-6f);
+
+    // Linear float frames are display encoded on the way in; already-encoded frames are not.
+    const FIntPoint FrameSize(5, 3);
+    const float Ramp[] = { 0.0f, 0.002f, 0.18f, 0.5f, 1.0f };
+    TImagePixelData<FLinearColor> Float32Frame(FrameSize);
+    TImagePixelData<FFloat16Color> Float16Frame(FrameSize);
+    for (int32 Y = 0; Y < FrameSize.Y; ++Y)
+    {
+        for (const float Value : Ramp)
+        {
+            Float32Frame.Pixels.Add(FLinearColor(Value, Value, Value, 1.0f));
+            Float16Frame.Pixels.Add(FFloat16Color(FLinearColor(Value, Value, Value, 1.0f)));
+        }
+    }
+
+    const TUniquePtr<TImagePixelData<FOmniCapturePackedRGB10A2>> LinearPacked = FOmniCapturePixelPacking::PackFrame(Float32Frame, EOmniCapturePixelDataType::LinearColorFloat32, true, EOmniCaptureColorSpace::BT709);
+    const TUniquePtr<TImagePixelData<FOmniCapturePackedRGB10A2>> EncodedPacked = FOmniCapturePixelPacking::PackFrame(Float32Frame, EOmniCapturePixelDataType::LinearColorFloat32, false, EOmniCaptureColorSpace::BT709);
+    const TUniquePtr<TImagePixelData<FOmniCapturePackedRGB10A2>> HalfPacked = FOmniCapturePixelPacking::PackFrame(Float16Frame, EOmniCapturePixelDataType::LinearColorFloat16, true, EOmniCaptureColorSpace::BT709);
+    if (TestTrue(TEXT("Float frames pack"), LinearPacked.IsValid() && EncodedPacked.IsValid() && HalfPacked.IsValid()))
+    {
+        TestEqual(TEXT("Packed frame keeps its size"), LinearPacked->GetSize(), FrameSize);
+        for (int32 Column = 0; Column < UE_ARRAY_COUNT(Ramp); ++Column)
+        {
+            const int32 Index = FrameSize.X + Column;
+            const uint32 Expected = FOmniCapturePixelPacking::QuantizeUnorm(EncodeSRGBReference(Ramp[Column]), 10);
+            TestEqual(FString::Printf(TEXT("Linear %.3f is sRGB encoded"), Ramp[Column]), static_cast<int32>(LinearPacked->Pixels[Index].Bits & 0x3FFu), static_cast<int32>(Expected));
+            TestEqual(FString::Printf(TEXT("Encoded %.3f is stored as is"), Ramp[Column]), static_cast<int32>(EncodedPacked->Pixels[Index].Bits & 0x3FFu), static_cast<int32>(FOmniCapturePixelPacking::QuantizeUnorm(Ramp[Column], 10)));
+
+            const uint32 HalfCode = HalfPacked->Pixels[Index].Bits & 0x3FFu;
+            TestTrue(FString::Printf(TEXT("Half float %.3f within one code"), Ramp[Column]), FMath::Abs(static_cast<int32>(HalfCode) - static_cast<int32>(Expected)) <= 1);
+        }
+    }
+    TestFalse(TEXT("Unknown pixel types are rejected"), FOmniCapturePixelPacking::PackFrame(Float32Frame, EOmniCapturePixelDataType::Unknown, true, EOmniCaptureColorSpace::BT709).IsValid());
+
+    // HDR10 keeps highlights: scene-linear 1.0 is reference white and brighter values climb the PQ curve instead of clipping.
+    const float ReferenceWhite = FOmniCapturePixelPacking::HDR10ReferenceWhiteNits;
+    TImagePixelData<FLinearColor> HighlightFrame(FIntPoint(3, 1));
+    HighlightFrame.Pixels = { FLinearColor(1.0f, 1.0f, 1.0f, 1.0f), FLinearColor(4.0f, 4.0f, 4.0f, 1.0f), FLinearColor(1.0f, 0.0f, 0.0f, 1.0f) };
+    const TUniquePtr<TImagePixelData<FOmniCapturePackedRGB10A2>> HDRPacked = FOmniCapturePixelPacking::PackFrame(HighlightFrame, EOmniCapturePixelDataType::LinearColorFloat32, true, EOmniCaptureColorSpace::HDR10);
+    const TUniquePtr<TImagePixelData<FOmniCapturePackedRGB10A2>> SDRPacked = FOmniCapturePixelPacking::PackFrame(HighlightFrame, EOmniCapturePixelDataType::LinearColorFloat32, true, EOmniCaptureColorSpace::BT709);
+    if (TestTrue(TEXT("Highlight frames pack"), HDRPacked.IsValid() && SDRPacked.IsValid()))
+    {
+        const int32 WhiteCode = static_cast<int32>(HDRPacked->Pixels[0].Bits & 0x3FFu);
+        const int32 HighlightCode = static_cast<int32>(HDRPacked->Pixels[1].Bits & 0x3FFu);
+        const int32 ExpectedWhite = static_cast<int32>(FOmniCapturePixelPacking::QuantizeUnorm(static_cast<float>(EncodePQReference(ReferenceWhite)), 10));
+        const int32 ExpectedHighlight = static_cast<int32>(FOmniCapturePixelPacking::QuantizeUnorm(static_cast<float>(EncodePQReference(4.0 * ReferenceWhite)), 10));
+        TestTrue(FString::Printf(TEXT("Reference white is PQ encoded (%d, expected %d)"), WhiteCode, ExpectedWhite), FMath::Abs(WhiteCode - ExpectedWhite) <= 1);
+        TestTrue(FString::Printf(TEXT("4.0 is PQ encoded above white (%d, expected %d)"), HighlightCode, ExpectedHighlight), FMath::Abs(HighlightCode - ExpectedHighlight) <= 1 && HighlightCode > WhiteCode);
+        TestEqual(TEXT("SDR clips 4.0"), static_cast<int32>(SDRPacked->Pixels[1].Bits & 0x3FFu), 1023);
+        TestTrue(TEXT("BT.709 red picks up green in BT.2020 primaries"), ((HDRPacked->Pixels[2].Bits >> 10) & 0x3FFu) > 0u);
+    }
+    TestEqual(TEXT("10000 nits is the top PQ code"), static_cast<int32>(FOmniCapturePixelPacking::QuantizeUnorm(FOmniCapturePixelPacking::EncodePQ(10000.0f), 10)), 1023);
+    TestEqual(TEXT("Black is PQ zero"), static_cast<int32>(FOmniCapturePixelPacking::QuantizeUnorm(FOmniCapturePixelPacking::EncodePQ(0.0f), 10)), 0);
+
+    // Limited range anchors: white and black at 10 bits, and the 16-bit scale of the same codes.
+    TArray<uint16> YPlane;
+    TArray<uint16> CbPlane;
+    TArray<uint16> CrPlane;
+    const FIntPoint OddSize(3, 3);
+    const TImagePixelData<FOmniCapturePackedRGB10A2> White = MakeFlatFrame(OddSize, FLinearColor::White);
+    FOmniCapturePixelPacking::ConvertToYUV420(White.Pixels, OddSize, EOmniCaptureColorSpace::BT709, 10, YPlane, CbPlane, CrPlane);
+    TestEqual(TEXT("Odd sizes keep a full luma plane"), YPlane.Num(), 9);
+    TestEqual(TEXT("Odd sizes round chroma up"), CbPlane.Num(), 4);
+    TestEqual(TEXT("White luma"), static_cast<int32>(YPlane.Last()), 940);
+    TestEqual(TEXT("White Cb"), static_cast<int32>(CbPlane.Last()), 512);
+    TestEqual(TEXT("White Cr"), static_cast<int32>(CrPlane.Last()), 512);
+
+    const TImagePixelData<FOmniCapturePackedRGB10A2> Black = MakeFlatFrame(OddSize, FLinearColor::Black);
+    FOmniCapturePixelPacking::ConvertToYUV420(Black.Pixels, OddSize, EOmniCaptureColorSpace::BT2020, 10, YPlane, CbPlane, CrPlane);
+    TestEqual(TEXT("Black luma"), static_cast<int32>(YPlane[0]), 64);
+    TestEqual(TEXT("Black Cb"), static_cast<int32>(CbPlane[0]), 512);
+
+    FOmniCapturePixelPacking::ConvertToYUV420(White.Pixels, OddSize, EOmniCaptureColorSpace::BT709, 16, YPlane, CbPlane, CrPlane);
+    TestEqual(TEXT("16-bit white luma"), static_cast<int32>(YPlane[0]), 235 << 8);
+    TestEqual(TEXT("16-bit neutral chroma"), static_cast<int32>(CbPlane[0]), 128 << 8);
+
+    // Frame rates become the rationals ffmpeg expects.
+    int32 Numerator = 0;
+    int32 Denominator = 0;
+    FOmniCaptureY4MWriter::GetFrameRateRatio(30.0, Numerator, Denominator);
+    TestTrue(TEXT("30 fps is 30:1"), Numerator == 30 && Denominator == 1);
+    FOmniCaptureY4MWriter::GetFrameRateRatio(29.97, Numerator, Denominator);
+    TestTrue(TEXT("29.97 fps is 30000:1001"), Numerator == 30000 && Denominator == 1001);
+    FOmniCaptureY4MWriter::GetFrameRateRatio(24000.0 / 1001.0, Numerator, Denominator);
+    TestTrue(TEXT("23.976 fps is 24000:1001"), Numerator == 24000 && Denominator == 1001);
+
+    // Two frames written to a stream: header, FRAME markers and planes land where a Y4M reader expects them.
+    const FIntPoint StreamSize(4, 2);
+    const FString StreamPath = FPaths::AutomationTransientDir() / TEXT("OmniCapturePixelPacking.y4m");
+    FOmniCaptureY4MWriter Writer;
+    if (TestTrue(TEXT("Y4M stream opens"), Writer.Open(StreamPath, StreamSize, 30.0, EOmniCaptureColorSpace::BT709)))
+    {
+        TestFalse(TEXT("8-bit streams are rejected"), FOmniCaptureY4MWriter().Open(StreamPath + TEXT(".8"), StreamSize, 30.0, EOmniCaptureColorSpace::BT709, 8));
+        const int64 FrameBytes = Writer.WriteFrame(MakeFlatFrame(StreamSize, FLinearColor::Black));
+        TestEqual(TEXT("Frame payload size"), FrameBytes, static_cast<int64>(6 + (8 + 2 + 2) * sizeof(uint16)));
+        TestEqual(TEXT("Second frame appends"), Writer.WriteFrame(MakeFlatFrame(StreamSize, FLinearColor::White)), FrameBytes);
+        TestEqual(TEXT("Mismatched sizes are rejected"), Writer.WriteFrame(MakeFlatFrame(FIntPoint(2, 2), FLinearColor::White)), static_cast<int64>(0));
+        TestEqual(TEXT("Frames written"), Writer.GetFramesWritten(), 2);
+        Writer.Close();
+
+        TArray<uint8> Bytes;
+        if (TestTrue(TEXT("Y4M stream reads back"), FFileHelper::LoadFileToArray(Bytes, *StreamPath)))
+        {
+            const FString Header = FOmniCaptureY4MWriter::BuildHeader(StreamSize, 30.0, 10);
+            TestEqual(TEXT("Header"), Header, FString(TEXT("YUV4MPEG2 W4 H2 F30:1 Ip A1:1 C420p10 XCOLORRANGE=LIMITED\n")));
+            TestEqual(TEXT("File size"), static_cast<int64>(Bytes.Num()), Header.Len() + 2 * FrameBytes);
+            if (Bytes.Num() == Header.Len() + 2 * FrameBytes)
+            {
+                const int64 SecondFrame = Header.Len() + FrameBytes;
+                TestEqual(TEXT("Header bytes"), FString(Header.Len(), reinterpret_cast<const ANSICHAR*>(Bytes.GetData())), Header);
+                TestEqual(TEXT("First FRAME marker"), FString(6, reinterpret_cast<const ANSICHAR*>(Bytes.GetData() + Header.Len())), FString(TEXT("FRAME\n")));
+                TestEqual(TEXT("Second FRAME marker"), FString(6, reinterpret_cast<const ANSICHAR*>(Bytes.GetData() + SecondFrame)), FString(TEXT("FRAME\n")));
+                TestEqual(TEXT("First frame luma"), static_cast<int32>(ReadSample(Bytes, Header.Len() + 6)), 64);
+                TestEqual(TEXT("Second frame luma"), static_cast<int32>(ReadSample(Bytes, SecondFrame + 6)), 940);
+                TestEqual(TEXT("Second frame Cr"), static_cast<int32>(ReadSample(Bytes, SecondFrame + FrameBytes - 2)), 512);
+            }
+        }
+        IFileManager::Get().Delete(*StreamPath);
+    }
+
+    AddInfo(FString::Printf(TEXT("Bytes per pixel through the ring buffer: packed %d, half float %d, float %d"),
+        static_cast<int32>(sizeof(FOmniCapturePackedRGB10A2)), static_cast<int32>(sizeof(FFloat16Color)), static_cast<int32>(sizeof(FLinearColor))));
+    return true;
+}
@@ -0,0 +1,80 @@
+#include "Misc/AutomationTest.h"
+
+#include "OmniCapturePreviewDownsample.h"
+
+namespace OmniCapturePreviewDownsampleTests
+{
+    /** Left half LeftColor, right half RightColor. */
+    TImagePixelData<FColor> MakeSplitFrame(const FIntPoint& Size, const FColor& LeftColor, const FColor& RightColor)
+    {
+        TImagePixelData<FColor> Frame(Size);
+        Frame.Pixels.SetNum(Size.X * Size.Y);
+        for (int32 Y = 0; Y < Size.Y; ++Y)
+        {
+            for (int32 X = 0; X < Size.X; ++X)
+            {
+                Frame.Pixels[Y * Size.X + X] = X < Size.X / 2 ? LeftColor : RightColor;
+            }
+        }
+        return Frame;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCapturePreviewDownsampleTest, "OmniCapture.Preview.Downsample", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCapturePreviewDownsampleTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCapturePreviewDownsampleTests;
+
+    // Preview sizes keep the aspect and never upscale.
+    TestEqual(TEXT("8K equirect fits 1024 wide"), FOmniCapturePreviewDownsample::GetPreviewSize(FIntPoint(8192, 4096), 1024), FIntPoint(1024, 512));
+    TestEqual(TEXT("Small frames keep their size"), FOmniCapturePreviewDownsample::GetPreviewSize(FIntPoint(640, 320), 1024), FIntPoint(640, 320));
+    TestEqual(TEXT("Empty frames have no preview"), FOmniCapturePreviewDownsample::GetPreviewSize(FIntPoint::ZeroValue, 1024), FIntPoint::ZeroValue);
+
+    // Single-eye views select their half of the stereo layout.
+    FOmniCaptureSettings Settings;
+    Settings.Mode = EOmniCaptureMode::Stereo;
+    Settings.StereoLayout = EOmniCaptureStereoLayout::SideBySide;
+    const FIntPoint StereoSize(64, 16);
+    TestEqual(TEXT("Composite shows the whole frame"), FOmniCapturePreviewDownsample::GetViewRect(StereoSize, Settings, EOmniCapturePreviewView::StereoComposite), FIntRect(0, 0, 64, 16));
+    TestEqual(TEXT("Right eye is the right half"), FOmniCapturePreviewDownsample::GetViewRect(StereoSize, Settings, EOmniCapturePreviewView::RightEye), FIntRect(32, 0, 64, 16));
+    Settings.StereoLayout = EOmniCaptureStereoLayout::TopBottom;
+    TestEqual(TEXT("Top-bottom right eye is the bottom half"), FOmniCapturePreviewDownsample::GetViewRect(StereoSize, Settings, EOmniCapturePreviewView::RightEye), FIntRect(0, 8, 64, 16));
+
+    // Boxes average their texels; a box straddling the split lands between the two colours.
+    const TImagePixelData<FColor> Split = MakeSplitFrame(FIntPoint(6, 2), FColor(0, 0, 0, 255), FColor(200, 100, 50, 255));
+    TArray<FColor> Preview;
+    TestTrue(TEXT("Color8 frames downsample"), FOmniCapturePreviewDownsample::Downsample(Split, EOmniCapturePixelDataType::Color8, FIntRect(0, 0, 6, 2), FIntPoint(3, 1), Preview));
+    TestEqual(TEXT("One pixel per output texel"), Preview.Num(), 3);
+    if (Preview.Num() == 3)
+    {
+        TestEqual(TEXT("Left box"), Preview[0], FColor(0, 0, 0, 255));
+        TestEqual(TEXT("Straddling box"), Preview[1], FColor(100, 50, 25, 255));
+        TestEqual(TEXT("Right box"), Preview[2], FColor(200, 100, 50, 255));
+    }
+
+    // Only the source rect is read.
+    FOmniCapturePreviewDownsample::Downsample(Split, EOmniCapturePixelDataType::Color8, FIntRect(3, 0, 6, 2), FIntPoint(1, 1), Preview);
+    TestEqual(TEXT("Right half only"), Preview[0], FColor(200, 100, 50, 255));
+
+    // Large reductions sample each box on a MaxTapsPerAxis grid; a flat frame stays flat.
+    const TImagePixelData<FColor> Wide = MakeSplitFrame(FIntPoint(512, 64), FColor(10, 20, 30, 255), FColor(10, 20, 30, 255));
+    FOmniCapturePreviewDownsample::Downsample(Wide, EOmniCapturePixelDataType::Color8, FIntRect(0, 0, 512, 64), FIntPoint(4, 1), Preview);
+    TestEqual(TEXT("Decimated boxes keep flat colour"), Preview[3], FColor(10, 20, 30, 255));
+
+    // Float frames are averaged in linear space and encoded to sRGB.
+    TImagePixelData<FLinearColor> Linear(FIntPoint(2, 1));
+    Linear.Pixels = { FLinearColor(0.0f, 0.0f, 0.0f, 1.0f), FLinearColor(1.0f, 1.0f, 1.0f, 1.0f) };
+    TestTrue(TEXT("Float32 frames downsample"), FOmniCapturePreviewDownsample::Downsample(Linear, EOmniCapturePixelDataType::LinearColorFloat32, FIntRect(0, 0, 2, 1), FIntPoint(1, 1), Preview));
+    TestEqual(TEXT("Linear average is sRGB encoded"), Preview[0], FLinearColor(0.5f, 0.5f, 0.5f, 1.0f).ToFColor(true));
+
+    TImagePixelData<FFloat16Color> Half(FIntPoint(1, 1));
+    Half.Pixels = { FFloat16Color(FLinearColor(0.25f, 0.5f, 1.0f, 1.0f)) };
+    TestTrue(TEXT("Float16 frames downsample"), FOmniCapturePreviewDownsample::Downsample(Half, EOmniCapturePixelDataType::LinearColorFloat16, FIntRect(0, 0, 1, 1), FIntPoint(1, 1), Preview));
+    TestEqual(TEXT("Half floats are encoded like full floats"), Preview[0], FLinearColor(0.25f, 0.5f, 1.0f, 1.0f).ToFColor(true));
+
+    // Packed frames are not a preview source.
+    TestFalse(TEXT("Packed frames are rejected"), FOmniCapturePreviewDownsample::Downsample(Split, EOmniCapturePixelDataType::PackedRGB10A2, FIntRect(0, 0, 6, 2), FIntPoint(3, 1), Preview));
+    TestEqual(TEXT("Rejected frames leave no pixels"), Preview.Num(), 0);
+    return true;
+}
@@ -0,0 +1,319 @@
+#include "Misc/AutomationTest.h"
+
+#include "OmniCaptureProjectionRemap.h"
+
+namespace OmniCaptureProjectionRemapTests
+{
+    constexpr int32 FaceResolution = 64;
+    constexpr float AngleToleranceDegrees = 2.0f;
+
+    /** Every texel stores its own direction as Dir * 0.5 + 0.5, so a remapped pixel decodes to the direction it sampled. */
+    FOmniCaptureCubemapPixels MakeDirectionCubemap()
+    {
+        FOmniCaptureCubemapPixels Cubemap;
+        Cubemap.Resolution = FaceResolution;
+        for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+        {
+            TArray<FLinearColor>& Face = Cubemap.Faces[FaceIndex];
+            Face.SetNumUninitialized(FaceResolution * FaceResolution);
+            for (int32 Y = 0; Y < FaceResolution; ++Y)
+            {
+                for (int32 X = 0; X < FaceResolution; ++X)
+                {
+                    const FVector2f UV((X + 0.5f) / FaceResolution, (Y + 0.5f) / FaceResolution);
+                    const FVector Direction = FOmniCaptureProjectionRemap::CubeFaceToDirection(FaceIndex, UV);
+                    Face[Y * FaceResolution + X] = FLinearColor(Direction.X * 0.5f + 0.5f, Direction.Y * 0.5f + 0.5f, Direction.Z * 0.5f + 0.5f, 1.0f);
+                }
+            }
+        }
+        return Cubemap;
+    }
+
+    TArray<FLinearColor> Remap(const FOmniCaptureProjectionParams& Params, const FIntPoint& Size)
+    {
+        const FOmniCaptureCubemapPixels Cubemap = MakeDirectionCubemap();
+        const TSharedRef<const FOmniCaptureRemapTable> Table = FOmniCaptureProjectionRemap::BuildTable(Params, Size, FaceResolution, 0.0f);
+
+        TArray<FLinearColor> Pixels;
+        Pixels.SetNumZeroed(Size.X * Size.Y);
+        FOmniCaptureProjectionRemap::RemapCPU(*Table, Cubemap, Pixels, FIntPoint::ZeroValue, Size.X);
+        return Pixels;
+    }
+
+    bool Decode(const TArray<FLinearColor>& Pixels, const FIntPoint& Size, int32 X, int32 Y, FVector& OutDirection)
+    {
+        const FLinearColor& Pixel = Pixels[Y * Size.X + X];
+        OutDirection = FVector(Pixel.R * 2.0f - 1.0f, Pixel.G * 2.0f - 1.0f, Pixel.B * 2.0f - 1.0f).GetSafeNormal();
+        return Pixel.A > 0.5f;
+    }
+
+    float AngleDegrees(const FVector& A, const FVector& B)
+    {
+        return static_cast<float>(FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(FVector::DotProduct(A.GetSafeNormal(), B.GetSafeNormal()), -1.0, 1.0))));
+    }
+
+    bool CheckDirection(FAutomationTestBase& Test, const TCHAR* Label, const TArray<FLinearColor>& Pixels, const FIntPoint& Size, int32 X, int32 Y, const FVector& Expected)
+    {
+        FVector Actual;
+        if (!Decode(Pixels, Size, X, Y, Actual))
+        {
+            Test.AddError(FString::Printf(TEXT("%s (%d, %d) is outside the image"), Label, X, Y));
+            return false;
+        }
+
+        const float Error = AngleDegrees(Actual, Expected);
+        return Test.TestTrue(FString::Printf(TEXT("%s (%d, %d) off by %.2f deg"), Label, X, Y, Error), Error < AngleToleranceDegrees);
+    }
+
+    /** Compares every valid pixel against a closed-form golden direction; returns the number of pixels the golden marks valid. */
+    template <typename GoldenFunc>
+    int32 CompareAgainstGolden(FAutomationTestBase& Test, const TArray<FLinearColor>& Pixels, const FIntPoint& Size, GoldenFunc&& Golden)
+    {
+        int32 ValidCount = 0;
+        int32 Mismatches = 0;
+        float WorstError = 0.0f;
+        for (int32 Y = 0; Y < Size.Y; ++Y)
+        {
+            for (int32 X = 0; X < Size.X; ++X)
+            {
+                FVector Expected;
+                const bool bExpectedValid = Golden(FVector2D((X + 0.5) / Size.X, (Y + 0.5) / Size.Y), Expected);
+                FVector Actual;
+                const bool bActualValid = Decode(Pixels, Size, X, Y, Actual);
+                if (bExpectedValid != bActualValid)
+                {
+                    ++Mismatches;
+                    continue;
+                }
+                if (bExpectedValid)
+                {
+                    ++ValidCount;
+                    WorstError = FMath::Max(WorstError, AngleDegrees(Actual, Expected));
+                }
+            }
+        }
+
+        Test.TestEqual(TEXT("Coverage matches golden"), Mismatches, 0);
+        Test.TestTrue(FString::Printf(TEXT("Worst angular error %.2f deg"), WorstError), WorstError < AngleToleranceDegrees);
+        return ValidCount;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureProjectionCylindricalGoldenTest, "OmniCapture.Projection.CylindricalGolden", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCaptureProjectionCylindricalGoldenTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCaptureProjectionRemapTests;
+
+    FOmniCaptureProjectionParams Params;
+    Params.Projection = EOmniCaptureProjection::Cylindrical;
+    Params.HorizontalFovRadians = 2.0f * PI;
+    Params.VerticalFovRadians = FMath::DegreesToRadians(90.0f);
+
+    const FIntPoint Size(129, 65);
+    const TArray<FLinearColor> Pixels = Remap(Params, Size);
+
+    CheckDirection(*this, TEXT("Centre faces forward"), Pixels, Size, 64, 32, FVector(1.0, 0.0, 0.0));
+    CheckDirection(*this, TEXT("Three-quarter column faces right"), Pixels, Size, 96, 32, FVector(0.0, 0.0, 1.0));
+    CheckDirection(*this, TEXT("Quarter column faces left"), Pixels, Size, 32, 32, FVector(0.0, 0.0, -1.0));
+
+    // Top row sits at tan(45 deg) = 1 on the cylinder wall above the forward direction.
+    CheckDirection(*this, TEXT("Top row"), Pixels, Size, 64, 0, FVector(1.0, 1.0 - 1.0 / Size.Y, 0.0));
+
+    const int32 ValidCount = CompareAgainstGolden(*this, Pixels, Size, [](const FVector2D& UV, FVector& OutDirection)
+    {
+        const double Longitude = (UV.X - 0.5) * 2.0 * PI;
+        OutDirection = FVector(FMath::Cos(Longitude), 1.0 - 2.0 * UV.Y, FMath::Sin(Longitude));
+        return true;
+    });
+    TestEqual(TEXT("Cylinder has no holes"), ValidCount, Size.X * Size.Y);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureProjectionFullDomeGoldenTest, "OmniCapture.Projection.FullDomeGolden", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCaptureProjectionFullDomeGoldenTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCaptureProjectionRemapTests;
+
+    FOmniCaptureProjectionParams Params;
+    Params.Projection = EOmniCaptureProjection::FullDome;
+    Params.HorizontalFovRadians = PI;
+    Params.VerticalFovRadians = PI;
+
+    const FIntPoint Size(129, 129);
+    const TArray<FLinearColor> Pixels = Remap(Params, Size);
+
+    CheckDirection(*this, TEXT("Centre is the zenith"), Pixels, Size, 64, 64, FVector(0.0, 1.0, 0.0));
+    CheckDirection(*this, TEXT("Top edge is the horizon in front"), Pixels, Size, 64, 0, FVector(1.0, 0.0, 0.0));
+    CheckDirection(*this, TEXT("Right edge is the horizon to the right"), Pixels, Size, 128, 64, FVector(0.0, 0.0, 1.0));
+    CheckDirection(*this, TEXT("Half radius is 45 deg up"), Pixels, Size, 64, 32, FVector(1.0, 1.0, 0.0));
+
+    FVector Unused;
+    TestFalse(TEXT("Corners are outside the dome"), Decode(Pixels, Size, 0, 0, Unused) || Decode(Pixels, Size, 128, 128, Unused));
+
+    const int32 ValidCount = CompareAgainstGolden(*this, Pixels, Size, [](const FVector2D& UV, FVector& OutDirection)
+    {
+        const double PX = UV.X * 2.0 - 1.0;
+        const double PY = 1.0 - UV.Y * 2.0;
+        const double Radius = FMath::Sqrt(PX * PX + PY * PY);
+        if (Radius > 1.0)
+        {
+            return false;
+        }
+
+        // Equidistant: zenith angle grows linearly with radius, 90 deg at the rim.
+        const double Zenith = Radius * HALF_PI;
+        const double Azimuth = FMath::Atan2(PX, PY);
+        OutDirection = FVector(FMath::Sin(Zenith) * FMath::Cos(Azimuth), FMath::Cos(Zenith), FMath::Sin(Zenith) * FMath::Sin(Azimuth));
+        return true;
+    });
+    TestNearlyEqual(TEXT("Disc covers pi/4 of the frame"), static_cast<float>(ValidCount) / (Size.X * Size.Y), PI * 0.25f, 0.02f);
+
+    // Tilting leans the zenith towards the front of the dome.
+    Params.TiltRadians = FMath::DegreesToRadians(30.0f);
+    const TArray<FLinearColor> Tilted = Remap(Params, Size);
+    CheckDirection(*this, TEXT("Tilted centre"), Tilted, Size, 64, 64, FVector(FMath::Sin(FMath::DegreesToRadians(30.0)), FMath::Cos(FMath::DegreesToRadians(30.0)), 0.0));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureProjectionSphericalMirrorGoldenTest, "OmniCapture.Projection.SphericalMirrorGolden", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCaptureProjectionSphericalMirrorGoldenTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCaptureProjectionRemapTests;
+
+    FOmniCaptureProjectionParams Params;
+    Params.Projection = EOmniCaptureProjection::SphericalMirror;
+    Params.AspectRatio = 4.0f / 3.0f;
+    Params.MirrorRadius = 0.2f;
+    Params.MirrorOffset = 0.7f;
+    Params.ProjectorDistance = 0.6f;
+
+    const FIntPoint Size(129, 97);
+    const TArray<FLinearColor> Pixels = Remap(Params, Size);
+
+    // The projector axis hits the mirror head-on and bounces straight back to the front of the dome.
+    CheckDirection(*this, TEXT("Centre faces forward"), Pixels, Size, 64, 48, FVector(1.0, 0.0, 0.0));
+
+    FVector Unused;
+    TestFalse(TEXT("Corners miss the mirror"), Decode(Pixels, Size, 0, 0, Unused) || Decode(Pixels, Size, 128, 96, Unused));
+
+    FVector Upper;
+    if (TestTrue(TEXT("Upper pixel hits the mirror"), Decode(Pixels, Size, 64, 24, Upper)))
+    {
+        TestTrue(TEXT("Upper half of the image lands on the upper dome"), Upper.Y > 0.0);
+    }
+
+    int32 SymmetryFailures = 0;
+    for (int32 Y = 0; Y < Size.Y; Y += 4)
+    {
+        for (int32 X = 0; X < Size.X / 2; X += 4)
+        {
+            FVector Left;
+            FVector Right;
+            const bool bLeftValid = Decode(Pixels, Size, X, Y, Left);
+            const bool bRightValid = Decode(Pixels, Size, Size.X - 1 - X, Y, Right);
+            if (bLeftValid != bRightValid || (bLeftValid && AngleDegrees(Left, FVector(Right.X, Right.Y, -Right.Z)) > AngleToleranceDegrees))
+            {
+                ++SymmetryFailures;
+            }
+        }
+    }
+    TestEqual(TEXT("Image is mirror-symmetric left to right"), SymmetryFailures, 0);
+
+    CompareAgainstGolden(*this, Pixels, Size, [&Params](const FVector2D& UV, FVector& OutDirection)
+    {
+        return FOmniCaptureProjectionRemap::DirectionFromSphericalMirror(UV, Params, OutDirection);
+    });
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureProjectionTableCacheTest, "OmniCapture.Projection.TableCache", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCaptureProjectionTableCacheTest::RunTest(const FString& Parameters)
+{
+    FOmniCaptureProjectionParams Params;
+    Params.Projection = EOmniCaptureProjection::FullDome;
+    Params.HorizontalFovRadians = PI;
+
+    const TSharedRef<const FOmniCaptureRemapTable> First = FOmniCaptureProjectionRemap::FindOrBuildTable(Params, FIntPoint(32, 32), 16, 1.0f);
+    const TSharedRef<const FOmniCaptureRemapTable> Second = FOmniCaptureProjectionRemap::FindOrBuildTable(Params, FIntPoint(32, 32), 16, 1.0f);
+    TestTrue(TEXT("Identical settings reuse the table"), &First.Get() == &Second.Get());
+
+    Params.TiltRadians = 0.25f;
+    const TSharedRef<const FOmniCaptureRemapTable> Changed = FOmniCaptureProjectionRemap::FindOrBuildTable(Params, FIntPoint(32, 32), 16, 1.0f);
+    TestTrue(TEXT("Changed settings rebuild the table"), &First.Get() != &Changed.Get());
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureProjectionCubemapAtlasTest, "OmniCapture.Projection.CubemapAtlas", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCaptureProjectionCubemapAtlasTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCaptureProjectionRemapTests;
+
+    // Every texel gets a unique value so any resampling shows up as a mismatch.
+    FOmniCaptureCubemapPixels Cubemap;
+    Cubemap.Resolution = FaceResolution;
+    for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+    {
+        Cubemap.Faces[FaceIndex].SetNumUninitialized(FaceResolution * FaceResolution);
+        for (int32 Index = 0; Index < FaceResolution * FaceResolution; ++Index)
+        {
+            Cubemap.Faces[FaceIndex][Index] = FLinearColor(static_cast<float>(FaceIndex), static_cast<float>(Index % FaceResolution), static_cast<float>(Index / FaceResolution), 1.0f);
+        }
+    }
+
+    FOmniCaptureProjectionParams Params;
+    Params.Projection = EOmniCaptureProjection::Cubemap;
+    const FIntPoint Size(FaceResolution * 3, FaceResolution * 2);
+    const TSharedRef<const FOmniCaptureRemapTable> Table = FOmniCaptureProjectionRemap::BuildTable(Params, Size, FaceResolution, 1.0f);
+
+    TArray<FLinearColor> Pixels;
+    Pixels.SetNumZeroed(Size.X * Size.Y);
+    FOmniCaptureProjectionRemap::RemapCPU(*Table, Cubemap, Pixels, FIntPoint::ZeroValue, Size.X);
+
+    // c3x2 order: right, left, up / down, front, back.
+    const int32 SlotFaces[6] = { 4, 5, 2, 3, 0, 1 };
+    int32 CopyMismatches = 0;
+    for (int32 Y = 0; Y < Size.Y; ++Y)
+    {
+        for (int32 X = 0; X < Size.X; ++X)
+        {
+            const int32 Slot = (Y / FaceResolution) * 3 + (X / FaceResolution);
+            const FLinearColor Expected(static_cast<float>(SlotFaces[Slot]), static_cast<float>(X % FaceResolution), static_cast<float>(Y % FaceResolution), 1.0f);
+            if (!Pixels[Y * Size.X + X].Equals(Expected, 1.0e-3f))
+            {
+                ++CopyMismatches;
+            }
+        }
+    }
+    TestEqual(TEXT("Raw 3x2 atlas is a texel-exact copy of the faces"), CopyMismatches, 0);
+
+    // EAC: centre of the top-middle slot is straight ahead, and equal slot steps are equal angles.
+    FOmniCaptureProjectionParams EquiAngular;
+    EquiAngular.Projection = EOmniCaptureProjection::EquiAngularCubemap;
+    FVector Direction;
+    FOmniCaptureProjectionRemap::DirectionFromCubemap(FVector2D(0.5, 0.25), EquiAngular, Direction);
+    TestTrue(TEXT("EAC front slot centre faces forward"), AngleDegrees(Direction, FVector(1.0, 0.0, 0.0)) < 0.01f);
+
+    FVector Quarter;
+    FOmniCaptureProjectionRemap::DirectionFromCubemap(FVector2D(0.5 + 1.0 / 12.0, 0.25), EquiAngular, Quarter);
+    TestTrue(TEXT("EAC quarter slot is 22.5 deg off axis"), FMath::IsNearlyEqual(AngleDegrees(Direction, Quarter), 22.5f, 0.01f));
+
+    int32 FaceIndex = INDEX_NONE;
+    FVector2f FaceUV;
+    FOmniCaptureProjectionRemap::AtlasToCubeFace(FVector2D(0.5, 0.75), true, FaceIndex, FaceUV);
+    TestEqual(TEXT("EAC bottom-middle slot holds the back face"), FaceIndex, 1);
+
+    FOmniCaptureSettings Settings;
+    Settings.Projection = EOmniCaptureProjection::EquiAngularCubemap;
+    Settings.Resolution = 1024;
+    Settings.Mode = EOmniCaptureMode::Stereo;
+    Settings.StereoLayout = EOmniCaptureStereoLayout::TopBottom;
+    TestEqual(TEXT("Per-eye atlas is 3x2 faces"), Settings.GetPerEyeOutputResolution(), FIntPoint(3072, 2048));
+    TestEqual(TEXT("Stereo atlases stack"), Settings.GetOutputResolution(), FIntPoint(3072, 4096));
+    TestEqual(TEXT("Metadata tag"), Settings.GetProjectionMetadataTag(), FString(TEXT("equi-angular-cubemap")));
+    return true;
+}
@@ -0,0 +1,148 @@
+#include "Misc/AutomationTest.h"
+
+#include "OmniCaptureQualityGovernor.h"
+
+namespace OmniCaptureQualityGovernorTests
+{
+    FOmniCaptureSettings MakeSettings()
+    {
+        FOmniCaptureSettings Settings;
+        Settings.OutputFormat = EOmniOutputFormat::ImageSequence;
+        Settings.ImageFormat = EOmniCaptureImageFormat::PNG;
+        Settings.AuxiliaryPasses = { EOmniCaptureAuxiliaryPassType::SceneDepth };
+        Settings.bEnablePreviewWindow = true;
+        Settings.PreviewFrameRate = 30.0f;
+        Settings.RemapQuality = EOmniCaptureRemapQuality::High;
+        Settings.TargetFrameRate = 60.0f;
+        Settings.MaxPendingImageTasks = 8;
+        Settings.RingBufferCapacity = 6;
+        Settings.bEnableQualityGovernor = true;
+        Settings.GovernorMinFaceResolutionScale = 0.5f;
+        return Settings;
+    }
+
+    /**
+     * A stand-in pipeline: each knob the governor gives up takes a slice off the conversion time, and the ring buffer
+     * backs up whenever the game thread runs over the 16.7 ms frame budget.
+     */
+    struct FSimulatedPipeline
+    {
+        double SceneMilliseconds = 24.0;
+        double Seconds = 0.0;
+        int32 RingPending = 0;
+
+        FOmniCaptureTelemetrySnapshot Step(const FOmniCaptureQualityState& State)
+        {
+            static constexpr double SavingsPerLevel[] = { 0.0, 3.0, 6.0, 8.0, 10.0, 14.0 };
+            const double ConversionMilliseconds = FMath::Max(1.0, SceneMilliseconds - SavingsPerLevel[State.Level]);
+            RingPending = ConversionMilliseconds > 1000.0 / 60.0 ? FMath::Min(RingPending + 2, 6) : FMath::Max(RingPending - 2, 0);
+            Seconds += 0.25;
+
+            FOmniCaptureTelemetrySnapshot Snapshot;
+            Snapshot.CaptureSeconds = Seconds;
+            Snapshot.RingBufferCapacity = 6;
+            Snapshot.RingBufferPending = RingPending;
+            Snapshot.StageMilliseconds[static_cast<int32>(EOmniCaptureStage::Conversion)] = ConversionMilliseconds;
+            return Snapshot;
+        }
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureQualityGovernorTest, "OmniCapture.Capture.QualityGovernor", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCaptureQualityGovernorTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCaptureQualityGovernorTests;
+
+    FOmniCaptureQualityGovernor Governor;
+    Governor.Initialize(MakeSettings());
+    TestTrue(TEXT("Governor is enabled"), Governor.IsEnabled());
+    TestEqual(TEXT("Every knob applies to a PNG capture with aux passes, preview and supersampling"), Governor.GetKnobCount(), static_cast<int32>(EOmniCaptureQualityKnob::Count));
+    TestEqual(TEXT("Baseline keeps the configured remap quality"), Governor.GetState().RemapQuality, EOmniCaptureRemapQuality::High);
+
+    // A heavy scene: the governor gives knobs up in order until the frame fits the budget, then holds.
+    FSimulatedPipeline Pipeline;
+    for (int32 Step = 0; Step < 80; ++Step)
+    {
+        Governor.Update(Pipeline.Step(Governor.GetState()), Step * 15);
+    }
+    const FOmniCaptureQualityState& Degraded = Governor.GetState();
+    TestEqual(TEXT("Settles at the first level that fits the budget"), Degraded.Level, 3);
+    TestEqual(TEXT("PNG compression is lowered"), Degraded.PNGCompressionLevel, 1);
+    TestEqual(TEXT("Auxiliary passes are thinned"), Degraded.AuxiliaryPassInterval, 2);
+    TestEqual(TEXT("Preview rate is reduced"), Degraded.PreviewRateScale, 0.25f);
+    TestEqual(TEXT("Remap sampling is not touched yet"), Degraded.RemapQuality, EOmniCaptureRemapQuality::High);
+    TestEqual(TEXT("Face resolution is not touched yet"), Degraded.FaceResolutionScale, 1.0f);
+
+    const TArray<FOmniCaptureQualityChange>& Changes = Governor.GetChanges();
+    TestEqual(TEXT("One change per knob, no oscillation while steady"), Changes.Num(), 3);
+    if (Changes.Num() == 3)
+    {
+        TestEqual(TEXT("PNG compression goes first"), Changes[0].Knob, EOmniCaptureQualityKnob::PNGCompression);
+        TestEqual(TEXT("Auxiliary passes go second"), Changes[1].Knob, EOmniCaptureQualityKnob::AuxiliaryPassRate);
+        TestEqual(TEXT("Preview rate goes third"), Changes[2].Knob, EOmniCaptureQualityKnob::PreviewRate);
+        TestTrue(TEXT("Changes are degradations"), Changes[0].bDegraded && Changes[2].bDegraded);
+        TestEqual(TEXT("Two overloaded snapshots trigger the first change"), Changes[0].CaptureSeconds, 0.5);
+        TestFalse(TEXT("Changes carry the reason"), Changes[0].Reason.IsEmpty());
+    }
+
+    // A heavier scene exhausts the remaining knobs; the level never exceeds the knob count.
+    Pipeline.SceneMilliseconds = 40.0;
+    for (int32 Step = 0; Step < 40; ++Step)
+    {
+        Governor.Update(Pipeline.Step(Governor.GetState()), 1200 + Step * 15);
+    }
+    TestEqual(TEXT("All knobs are down"), Governor.GetState().Level, 5);
+    TestEqual(TEXT("Remap sampling falls back to one tap"), Governor.GetState().RemapQuality, EOmniCaptureRemapQuality::Standard);
+    TestEqual(TEXT("Face resolution drops to the configured minimum"), Governor.GetState().FaceResolutionScale, 0.5f);
+
+    // Headroom returns: knobs come back one at a time, most recently lowered first.
+    Pipeline.SceneMilliseconds = 8.0;
+    for (int32 Step = 0; Step < 60; ++Step)
+    {
+        Governor.Update(Pipeline.Step(Governor.GetState()), 2000 + Step * 15);
+    }
+    TestEqual(TEXT("Full quality is restored"), Governor.GetState().Level, 0);
+    TestEqual(TEXT("Restored state matches the baseline"), Governor.GetState().RemapQuality, EOmniCaptureRemapQuality::High);
+    TestEqual(TEXT("Every step down and up is logged"), Changes.Num(), 10);
+    if (Changes.Num() == 10)
+    {
+        TestEqual(TEXT("Face resolution is restored first"), Changes[5].Knob, EOmniCaptureQualityKnob::FaceResolution);
+        TestFalse(TEXT("Restores are not degradations"), Changes[5].bDegraded);
+        TestEqual(TEXT("PNG compression is restored last"), Changes[9].Knob, EOmniCaptureQualityKnob::PNGCompression);
+        TestEqual(TEXT("Restores wait for sustained headroom"), Changes[6].CaptureSeconds - Changes[5].CaptureSeconds,
+            FOmniCaptureQualityGovernor::HeadroomSnapshotsToRestore * 0.25, 0.001);
+    }
+
+    // New drops count as overload even with an idle ring.
+    FOmniCaptureTelemetrySnapshot Dropping;
+    Dropping.RingBufferCapacity = 6;
+    Dropping.DroppedFrames = 1;
+    TestEqual(TEXT("A new drop is overload"), Governor.Classify(Dropping), FOmniCaptureQualityGovernor::EPressure::Overloaded);
+    Governor.Update(Dropping, 3000);
+    TestEqual(TEXT("Old drops are not"), Governor.Classify(Dropping), FOmniCaptureQualityGovernor::EPressure::Headroom);
+
+    // A saturated writer is overload.
+    FOmniCaptureTelemetrySnapshot Backlogged;
+    Backlogged.RingBufferCapacity = 6;
+    Backlogged.DroppedFrames = 1;
+    Backlogged.WriterPendingFrames = 8;
+    TestEqual(TEXT("Writer at its task limit is overload"), Governor.Classify(Backlogged), FOmniCaptureQualityGovernor::EPressure::Overloaded);
+
+    // Knobs that do not apply are skipped, and offline captures never govern.
+    FOmniCaptureSettings ExrSettings = MakeSettings();
+    ExrSettings.ImageFormat = EOmniCaptureImageFormat::EXR;
+    ExrSettings.AuxiliaryPasses.Reset();
+    ExrSettings.bEnablePreviewWindow = false;
+    ExrSettings.RemapQuality = EOmniCaptureRemapQuality::Standard;
+    Governor.Initialize(ExrSettings);
+    TestEqual(TEXT("Only face resolution applies"), Governor.GetKnobCount(), 1);
+    TestEqual(TEXT("Initialize clears the change log"), Governor.GetChanges().Num(), 0);
+
+    FOmniCaptureSettings OfflineSettings = MakeSettings();
+    OfflineSettings.FramePacing = EOmniCaptureFramePacing::FixedTimestep;
+    Governor.Initialize(OfflineSettings);
+    TestFalse(TEXT("Offline captures are not governed"), Governor.IsEnabled());
+    TestFalse(TEXT("Updates are ignored when disabled"), Governor.Update(Dropping, 0));
+    return true;
+}
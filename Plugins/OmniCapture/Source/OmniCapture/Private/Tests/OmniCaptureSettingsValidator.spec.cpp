@@ -34,3 +34,60 @@ bool FOmniCapturePlanarStereoFallbackTest::RunTest(const FString& Parameters)
     return true;
 }
 
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureODSFallbackTest, "OmniCapture.Settings.ODSFallback", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureODSFallbackTest::RunTest(const FString& Parameters)
+{
+    FOmniCaptureSettings Settings;
+    Settings.Mode = EOmniCaptureMode::Stereo;
+    Settings.Projection = EOmniCaptureProjection::Fisheye;
+    Settings.bOmniDirectionalStereo = true;
+
+    TArray<FString> Warnings;
+    TestTrue(TEXT("Compatibility fixups succeed for ODS fisheye"), FOmniCaptureSettingsValidator::ApplyCompatibilityFixups(Settings, Warnings));
+    TestFalse(TEXT("ODS is turned off outside equirect"), Settings.bOmniDirectionalStereo);
+    TestTrue(TEXT("Warning emitted for ODS fallback"), Warnings.Num() > 0);
+
+    Settings = FOmniCaptureSettings();
+    Settings.Mode = EOmniCaptureMode::Stereo;
+    Settings.bOmniDirectionalStereo = true;
+    Settings.AuxiliaryPasses.Add(EOmniCaptureAuxiliaryPassType::SceneDepth);
+    Warnings.Reset();
+    TestTrue(TEXT("Compatibility fixups succeed for ODS equirect"), FOmniCaptureSettingsValidator::ApplyCompatibilityFixups(Settings, Warnings));
+    TestTrue(TEXT("ODS stays on for stereo equirect"), Settings.UsesOmniDirectionalStereo());
+    TestEqual(TEXT("Auxiliary passes are dropped"), Settings.AuxiliaryPasses.Num(), 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureRemapTableBudgetTest, "OmniCapture.Settings.RemapTableBudget", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureRemapTableBudgetTest::RunTest(const FString& Parameters)
+{
+    // An 8192x4096 eye fits a single-tap table only.
+    FOmniCaptureSettings Settings;
+    Settings.Resolution = 4096;
+    Settings.RemapQuality = EOmniCaptureRemapQuality::Ultra;
+
+    TArray<FString> Warnings;
+    TestTrue(TEXT("Compatibility fixups succeed for an 8K Ultra remap"), FOmniCaptureSettingsValidator::ApplyCompatibilityFixups(Settings, Warnings));
+    TestEqual(TEXT("8K Ultra falls back to one tap"), Settings.RemapQuality, EOmniCaptureRemapQuality::Standard);
+    TestTrue(TEXT("Warning emitted for the remap budget"), Warnings.Num() > 0);
+
+    // A 4096x2048 eye fits 2x2 but not 3x3.
+    Settings = FOmniCaptureSettings();
+    Settings.Resolution = 2048;
+    Settings.RemapQuality = EOmniCaptureRemapQuality::Ultra;
+    Warnings.Reset();
+    TestTrue(TEXT("Compatibility fixups succeed for a 4K Ultra remap"), FOmniCaptureSettingsValidator::ApplyCompatibilityFixups(Settings, Warnings));
+    TestEqual(TEXT("4K Ultra falls back to 2x2"), Settings.RemapQuality, EOmniCaptureRemapQuality::High);
+
+    Settings = FOmniCaptureSettings();
+    Settings.Resolution = 1024;
+    Settings.RemapQuality = EOmniCaptureRemapQuality::Ultra;
+    Warnings.Reset();
+    TestTrue(TEXT("Compatibility fixups succeed for a 2K Ultra remap"), FOmniCaptureSettingsValidator::ApplyCompatibilityFixups(Settings, Warnings));
+    TestEqual(TEXT("2K Ultra fits the budget"), Settings.RemapQuality, EOmniCaptureRemapQuality::Ultra);
+    TestEqual(TEXT("No warning within the budget"), Warnings.Num(), 0);
+
+    return true;
+}
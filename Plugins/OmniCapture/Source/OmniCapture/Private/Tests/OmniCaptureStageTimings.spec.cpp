@@ -0,0 +1,81 @@
+#include "Misc/AutomationTest.h"
+
+#include "HAL/PlatformProcess.h"
+#include "OmniCaptureStageTimings.h"
+
+namespace OmniCaptureStageTimingsTests
+{
+    FOmniCaptureFrameStageTimings MakeTimings(int32 FrameIndex, EOmniCaptureStage Stage, double Milliseconds)
+    {
+        FOmniCaptureFrameStageTimings Timings;
+        Timings.FrameIndex = FrameIndex;
+        Timings[Stage] = Milliseconds;
+        return Timings;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureStageTimingsTest, "OmniCapture.Diagnostics.StageTimings", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCaptureStageTimingsTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCaptureStageTimingsTests;
+
+    // Nested scopes report exclusive time, so the stages add up to the outer scope's wall time.
+    FOmniCaptureStageScope::ResetThreadTimings();
+    const double StartSeconds = FPlatformTime::Seconds();
+    {
+        OMNICAPTURE_STAGE_SCOPE(WriterEncode);
+        FPlatformProcess::Sleep(0.01f);
+        {
+            OMNICAPTURE_STAGE_SCOPE(FileWrite);
+            FPlatformProcess::Sleep(0.01f);
+        }
+    }
+    const double WallMilliseconds = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+    const FOmniCaptureFrameStageTimings Nested = FOmniCaptureStageScope::TakeThreadTimings(7);
+    TestEqual(TEXT("Taken timings carry the frame index"), Nested.FrameIndex, 7);
+    TestTrue(TEXT("Inner stage is timed"), Nested[EOmniCaptureStage::FileWrite] >= 5.0);
+    TestTrue(TEXT("Outer stage excludes the inner stage"), Nested[EOmniCaptureStage::WriterEncode] < WallMilliseconds - Nested[EOmniCaptureStage::FileWrite] + 1.0);
+    TestEqual(TEXT("Stages sum to the wall time"), Nested.GetTotalMilliseconds(), WallMilliseconds, 1.0);
+    TestTrue(TEXT("Taking resets the thread accumulator"), FOmniCaptureStageScope::TakeThreadTimings(8).IsEmpty());
+
+    // Records for the same frame merge; the capture and writer stages arrive separately.
+    FOmniCaptureStageTimingHistory History;
+    History.Record(MakeTimings(0, EOmniCaptureStage::Conversion, 4.0));
+    History.Record(MakeTimings(1, EOmniCaptureStage::Conversion, 6.0));
+    History.Record(MakeTimings(0, EOmniCaptureStage::FileWrite, 2.0));
+    TArray<FOmniCaptureFrameStageTimings> Recent = History.GetRecent(10);
+    TestEqual(TEXT("Two frames recorded"), Recent.Num(), 2);
+    TestEqual(TEXT("Frame 0 keeps its conversion time"), Recent[0][EOmniCaptureStage::Conversion], 4.0);
+    TestEqual(TEXT("Frame 0 gains its file write time"), Recent[0][EOmniCaptureStage::FileWrite], 2.0);
+
+    // Averages skip frames in which a stage did not run.
+    const FOmniCaptureFrameStageTimings Average = History.GetAverage(10);
+    TestEqual(TEXT("Conversion averages both frames"), Average[EOmniCaptureStage::Conversion], 5.0);
+    TestEqual(TEXT("File write averages the frame that wrote"), Average[EOmniCaptureStage::FileWrite], 2.0);
+    TestEqual(TEXT("Unused stages average to zero"), Average[EOmniCaptureStage::EncoderSubmit], 0.0);
+
+    // Session stages stay out of the per-frame history.
+    History.Record(MakeTimings(INDEX_NONE, EOmniCaptureStage::Mux, 100.0));
+    TestEqual(TEXT("Mux lands in the session timings"), History.GetSessionTimings()[EOmniCaptureStage::Mux], 100.0);
+    TestEqual(TEXT("Mux does not add a frame"), History.GetRecent(10).Num(), 2);
+
+    // The ring keeps the newest Capacity frames and drops writer results for frames it has already overwritten.
+    const int32 Capacity = FOmniCaptureStageTimingHistory::Capacity;
+    for (int32 FrameIndex = 2; FrameIndex < Capacity + 10; ++FrameIndex)
+    {
+        History.Record(MakeTimings(FrameIndex, EOmniCaptureStage::Conversion, 1.0));
+    }
+    History.Record(MakeTimings(3, EOmniCaptureStage::FileWrite, 50.0));
+    Recent = History.GetRecent(Capacity * 2);
+    TestEqual(TEXT("History is capped at its capacity"), Recent.Num(), Capacity);
+    TestEqual(TEXT("Oldest retained frame"), Recent[0].FrameIndex, 10);
+    TestEqual(TEXT("Newest frame is last"), Recent.Last().FrameIndex, Capacity + 9);
+    TestEqual(TEXT("Late results for overwritten frames are dropped"), History.GetAverage(Capacity)[EOmniCaptureStage::FileWrite], 0.0);
+    TestEqual(TEXT("A window returns only the newest frames"), History.GetRecent(5)[0].FrameIndex, Capacity + 5);
+
+    History.Reset();
+    TestEqual(TEXT("Reset clears the frames"), History.GetRecent(10).Num(), 0);
+    TestTrue(TEXT("Reset clears the session timings"), History.GetSessionTimings().IsEmpty());
+    return true;
+}
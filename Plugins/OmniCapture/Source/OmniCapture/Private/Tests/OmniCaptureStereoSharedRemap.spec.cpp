@@ -0,0 +1,131 @@
+#include "Misc/AutomationTest.h"
+
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "OmniCaptureProjectionRemap.h"
+
+namespace OmniCaptureStereoSharedRemapTests
+{
+    FOmniCaptureCubemapPixels MakeNoiseCubemap(int32 Resolution, int32 Seed)
+    {
+        FRandomStream Random(Seed);
+        FOmniCaptureCubemapPixels Cubemap;
+        Cubemap.Resolution = Resolution;
+        for (TArray<FLinearColor>& Face : Cubemap.Faces)
+        {
+            Face.SetNumUninitialized(Resolution * Resolution);
+            for (FLinearColor& Pixel : Face)
+            {
+                Pixel = FLinearColor(Random.GetFraction(), Random.GetFraction(), Random.GetFraction(), 1.0f);
+            }
+        }
+        return Cubemap;
+    }
+
+    struct FTimings
+    {
+        double MonoMs = 0.0;
+        double SeparateMs = 0.0;
+        double SharedMs = 0.0;
+    };
+
+    /**
+     * Times mono, per-eye (geometry resolved once per eye, like the old stereo paths) and shared stereo, then counts
+     * output pixels where the shared remap differs from the per-eye one. BuildTable stands in for the per-pixel
+     * direction and face lookup the legacy kernels used to repeat for the right eye.
+     */
+    int32 CountMismatches(const FOmniCaptureProjectionParams& Params, const FIntPoint& EyeSize, bool bSideBySide, const FOmniCaptureCubemapPixels& Left, const FOmniCaptureCubemapPixels& Right, FTimings& OutTimings)
+    {
+        const FIntPoint OutputSize = bSideBySide ? FIntPoint(EyeSize.X * 2, EyeSize.Y) : FIntPoint(EyeSize.X, EyeSize.Y * 2);
+        const FIntPoint RightOffset = bSideBySide ? FIntPoint(EyeSize.X, 0) : FIntPoint(0, EyeSize.Y);
+        const int32 PixelCount = OutputSize.X * OutputSize.Y;
+
+        TArray<FLinearColor> Mono;
+        Mono.SetNumZeroed(PixelCount);
+        double Start = FPlatformTime::Seconds();
+        {
+            const TSharedRef<const FOmniCaptureRemapTable> Table = FOmniCaptureProjectionRemap::BuildTable(Params, EyeSize, Left.Resolution, 0.0f);
+            FOmniCaptureProjectionRemap::RemapCPU(*Table, Left, Mono, FIntPoint::ZeroValue, OutputSize.X);
+        }
+        OutTimings.MonoMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+        TArray<FLinearColor> Separate;
+        Separate.SetNumZeroed(PixelCount);
+        Start = FPlatformTime::Seconds();
+        {
+            const TSharedRef<const FOmniCaptureRemapTable> LeftTable = FOmniCaptureProjectionRemap::BuildTable(Params, EyeSize, Left.Resolution, 0.0f);
+            FOmniCaptureProjectionRemap::RemapCPU(*LeftTable, Left, Separate, FIntPoint::ZeroValue, OutputSize.X);
+            const TSharedRef<const FOmniCaptureRemapTable> RightTable = FOmniCaptureProjectionRemap::BuildTable(Params, EyeSize, Right.Resolution, 0.0f);
+            FOmniCaptureProjectionRemap::RemapCPU(*RightTable, Right, Separate, RightOffset, OutputSize.X);
+        }
+        OutTimings.SeparateMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+        TArray<FLinearColor> Shared;
+        Shared.SetNumZeroed(PixelCount);
+        Start = FPlatformTime::Seconds();
+        {
+            const TSharedRef<const FOmniCaptureRemapTable> Table = FOmniCaptureProjectionRemap::BuildTable(Params, EyeSize, Left.Resolution, 0.0f);
+            FOmniCaptureRemapTarget Targets[2];
+            Targets[0].Cubemap = &Left;
+            Targets[0].Pixels = Shared;
+            Targets[1].Cubemap = &Right;
+            Targets[1].Pixels = Shared;
+            Targets[1].Offset = RightOffset;
+            FOmniCaptureProjectionRemap::RemapTargetsCPU(*Table, Targets, OutputSize.X);
+        }
+        OutTimings.SharedMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+        int32 Mismatches = 0;
+        for (int32 Index = 0; Index < PixelCount; ++Index)
+        {
+            Mismatches += Separate[Index] == Shared[Index] ? 0 : 1;
+        }
+        return Mismatches;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureStereoSharedRemapTest, "OmniCapture.Projection.StereoSharedRemap", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCaptureStereoSharedRemapTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCaptureStereoSharedRemapTests;
+
+    constexpr int32 FaceResolution = 256;
+    const FOmniCaptureCubemapPixels Left = MakeNoiseCubemap(FaceResolution, 1);
+    const FOmniCaptureCubemapPixels Right = MakeNoiseCubemap(FaceResolution, 2);
+
+    struct FCase
+    {
+        const TCHAR* Name;
+        EOmniCaptureProjection Projection;
+        int32 SamplesPerAxis;
+        bool bSideBySide;
+    };
+
+    const FCase Cases[] =
+    {
+        { TEXT("Equirect top-bottom"), EOmniCaptureProjection::Equirectangular, 1, false },
+        { TEXT("Equirect side-by-side"), EOmniCaptureProjection::Equirectangular, 1, true },
+        { TEXT("Supersampled equirect top-bottom"), EOmniCaptureProjection::Equirectangular, 2, false },
+        { TEXT("VR180 fisheye side-by-side"), EOmniCaptureProjection::Fisheye, 1, true },
+    };
+
+    for (const FCase& Case : Cases)
+    {
+        FOmniCaptureProjectionParams Params;
+        Params.Projection = Case.Projection;
+        Params.SamplesPerAxis = Case.SamplesPerAxis;
+        if (Case.Projection == EOmniCaptureProjection::Fisheye)
+        {
+            Params.HorizontalFovRadians = UE_PI;
+        }
+
+        const FIntPoint EyeSize = Case.Projection == EOmniCaptureProjection::Fisheye ? FIntPoint(512, 512) : FIntPoint(1024, 512);
+        FTimings Timings;
+        const int32 Mismatches = CountMismatches(Params, EyeSize, Case.bSideBySide, Left, Right, Timings);
+        AddInfo(FString::Printf(TEXT("%s: mono %.2f ms, per-eye stereo %.2f ms, shared stereo %.2f ms (%.2fx mono)"),
+            Case.Name, Timings.MonoMs, Timings.SeparateMs, Timings.SharedMs, Timings.SharedMs / FMath::Max(Timings.MonoMs, 1.0e-3)));
+        TestEqual(FString::Printf(TEXT("%s shared remap matches per-eye remaps"), Case.Name), Mismatches, 0);
+    }
+    return true;
+}
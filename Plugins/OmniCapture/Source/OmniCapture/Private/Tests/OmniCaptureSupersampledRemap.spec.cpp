@@ -0,0 +1,177 @@
+#include "Misc/AutomationTest.h"
+
+#include "HAL/PlatformTime.h"
+#include "OmniCaptureProjectionRemap.h"
+
+namespace OmniCaptureSupersampledRemapTests
+{
+    /** Fine checker on the sphere: well resolved by the faces, far above the output's Nyquist limit. */
+    FLinearColor EvaluateScene(const FVector& Direction)
+    {
+        const float Azimuth = static_cast<float>(FMath::Atan2(Direction.Y, Direction.X));
+        const float Elevation = static_cast<float>(FMath::Asin(FMath::Clamp(Direction.Z, -1.0, 1.0)));
+        const float Value = 0.5f + 0.5f * FMath::Sin(Azimuth * 150.0f) * FMath::Sin(Elevation * 150.0f);
+        return FLinearColor(Value, Value, Value, 1.0f);
+    }
+
+    FOmniCaptureCubemapPixels RenderCubemap(int32 Resolution)
+    {
+        FOmniCaptureCubemapPixels Cubemap;
+        Cubemap.Resolution = Resolution;
+        for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+        {
+            TArray<FLinearColor>& Face = Cubemap.Faces[FaceIndex];
+            Face.SetNumUninitialized(Resolution * Resolution);
+            for (int32 Y = 0; Y < Resolution; ++Y)
+            {
+                for (int32 X = 0; X < Resolution; ++X)
+                {
+                    const FVector Direction = FOmniCaptureProjectionRemap::CubeFaceToDirection(FaceIndex, FVector2f((X + 0.5f) / Resolution, (Y + 0.5f) / Resolution));
+                    Face[Y * Resolution + X] = EvaluateScene(Direction.GetSafeNormal());
+                }
+            }
+        }
+        return Cubemap;
+    }
+
+    /** Brute-force footprint integral of the same cubemap: 8x8 sub-samples per pixel weighted by cos(latitude). */
+    void IntegrateEquirectReference(const FOmniCaptureCubemapPixels& Cubemap, const FOmniCaptureProjectionParams& Params, const FIntPoint& EyeSize, TArray<FLinearColor>& OutPixels)
+    {
+        constexpr int32 Grid = 8;
+        OutPixels.SetNumZeroed(EyeSize.X * EyeSize.Y);
+        for (int32 Y = 0; Y < EyeSize.Y; ++Y)
+        {
+            for (int32 X = 0; X < EyeSize.X; ++X)
+            {
+                FLinearColor Sum = FLinearColor::Transparent;
+                double TotalWeight = 0.0;
+                for (int32 SubY = 0; SubY < Grid; ++SubY)
+                {
+                    for (int32 SubX = 0; SubX < Grid; ++SubX)
+                    {
+                        const FVector2D UV((X + (SubX + 0.5) / Grid) / EyeSize.X, (Y + (SubY + 0.5) / Grid) / EyeSize.Y);
+                        FVector Direction;
+                        FOmniCaptureProjectionRemap::DirectionFromEquirect(UV, Params, Direction);
+
+                        int32 FaceIndex = 0;
+                        FVector2f FaceUV;
+                        FOmniCaptureProjectionRemap::DirectionToCubeFace(Direction, Cubemap.Resolution, 0.0f, FaceIndex, FaceUV);
+
+                        const double Weight = FMath::Cos((0.5 - UV.Y) * Params.VerticalFovRadians);
+                        Sum += FOmniCaptureProjectionRemap::SampleBilinear(Cubemap, FaceIndex, FaceUV) * static_cast<float>(Weight);
+                        TotalWeight += Weight;
+                    }
+                }
+                OutPixels[Y * EyeSize.X + X] = Sum * static_cast<float>(1.0 / TotalWeight);
+            }
+        }
+    }
+
+    double ComputeRMSE(const TArray<FLinearColor>& Reference, const TArray<FLinearColor>& Test)
+    {
+        double SquaredError = 0.0;
+        for (int32 Index = 0; Index < Reference.Num(); ++Index)
+        {
+            const float Delta = Reference[Index].R - Test[Index].R;
+            SquaredError += Delta * Delta;
+        }
+        return FMath::Sqrt(SquaredError / FMath::Max(1, Reference.Num()));
+    }
+
+    /** Sum of tap weights per pixel. */
+    void GetPixelWeights(const FOmniCaptureRemapTable& Table, TArray<float>& OutWeights)
+    {
+        OutWeights.SetNumZeroed(Table.Size.X * Table.Size.Y);
+        for (int32 Pixel = 0; Pixel < OutWeights.Num(); ++Pixel)
+        {
+            for (int32 Tap = 0; Tap < Table.TapsPerPixel; ++Tap)
+            {
+                OutWeights[Pixel] += Table.Entries[Pixel * Table.TapsPerPixel + Tap].W;
+            }
+        }
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureSupersampledRemapTest, "OmniCapture.Projection.SupersampledRemap", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCaptureSupersampledRemapTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCaptureSupersampledRemapTests;
+
+    constexpr int32 FaceResolution = 512;
+    const FIntPoint EyeSize(256, 128);
+    const FOmniCaptureCubemapPixels Cubemap = RenderCubemap(FaceResolution);
+
+    FOmniCaptureProjectionParams Params;
+    Params.Projection = EOmniCaptureProjection::Equirectangular;
+
+    TArray<FLinearColor> Reference;
+    IntegrateEquirectReference(Cubemap, Params, EyeSize, Reference);
+
+    const TCHAR* LevelNames[] = { TEXT("Standard"), TEXT("High"), TEXT("Ultra") };
+    double Errors[3] = { 0.0, 0.0, 0.0 };
+    for (int32 Level = 0; Level < 3; ++Level)
+    {
+        Params.SamplesPerAxis = Level + 1;
+        const TSharedRef<const FOmniCaptureRemapTable> Table = FOmniCaptureProjectionRemap::BuildTable(Params, EyeSize, FaceResolution, 0.0f);
+        TestEqual(FString::Printf(TEXT("%s taps per pixel"), LevelNames[Level]), Table->TapsPerPixel, Params.SamplesPerAxis * Params.SamplesPerAxis);
+
+        TArray<float> Weights;
+        GetPixelWeights(*Table, Weights);
+        float MaxWeightError = 0.0f;
+        for (const float Weight : Weights)
+        {
+            MaxWeightError = FMath::Max(MaxWeightError, FMath::Abs(Weight - 1.0f));
+        }
+        TestTrue(FString::Printf(TEXT("%s weights of every equirect pixel sum to one"), LevelNames[Level]), MaxWeightError < 1.0e-4f);
+
+        TArray<FLinearColor> Pixels;
+        Pixels.SetNumZeroed(EyeSize.X * EyeSize.Y);
+        const double Start = FPlatformTime::Seconds();
+        FOmniCaptureProjectionRemap::RemapCPU(*Table, Cubemap, Pixels, FIntPoint::ZeroValue, EyeSize.X);
+        const double RemapMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+        Errors[Level] = ComputeRMSE(Reference, Pixels);
+        AddInfo(FString::Printf(TEXT("%s: %d taps, %.2f ms, RMSE vs footprint integral %.4f"), LevelNames[Level], Table->TapsPerPixel, RemapMs, Errors[Level]));
+    }
+
+    TestTrue(TEXT("2x2 supersampling aliases less than one tap"), Errors[1] < Errors[0]);
+    TestTrue(TEXT("3x3 supersampling aliases less than 2x2"), Errors[2] < Errors[1]);
+    TestTrue(TEXT("3x3 supersampling at least halves the aliasing error"), Errors[2] < Errors[0] * 0.5);
+
+    // The single-tap table keeps the old (u, v, face, valid) layout bit for bit.
+    Params.SamplesPerAxis = 1;
+    const TSharedRef<const FOmniCaptureRemapTable> StandardTable = FOmniCaptureProjectionRemap::BuildTable(Params, EyeSize, FaceResolution, 0.0f);
+    int32 NonBinaryWeights = 0;
+    for (const FVector4f& Entry : StandardTable->Entries)
+    {
+        NonBinaryWeights += (Entry.W == 0.0f || Entry.W == 1.0f) ? 0 : 1;
+    }
+    TestEqual(TEXT("Single-tap weights are 0 or 1"), NonBinaryWeights, 0);
+
+    // Pixels straddling the fisheye image circle keep partial coverage instead of a hard edge.
+    FOmniCaptureProjectionParams FisheyeParams;
+    FisheyeParams.Projection = EOmniCaptureProjection::Fisheye;
+    FisheyeParams.HorizontalFovRadians = UE_PI;
+    FisheyeParams.SamplesPerAxis = 3;
+    const TSharedRef<const FOmniCaptureRemapTable> FisheyeTable = FOmniCaptureProjectionRemap::BuildTable(FisheyeParams, FIntPoint(128, 128), FaceResolution, 0.0f);
+    TArray<float> FisheyeWeights;
+    GetPixelWeights(*FisheyeTable, FisheyeWeights);
+    int32 EdgePixels = 0;
+    int32 OverweightPixels = 0;
+    for (const float Weight : FisheyeWeights)
+    {
+        EdgePixels += (Weight > 0.01f && Weight < 0.99f) ? 1 : 0;
+        OverweightPixels += Weight > 1.0001f ? 1 : 0;
+    }
+    TestTrue(TEXT("Fisheye rim pixels are partially covered"), EdgePixels > 0);
+    TestEqual(TEXT("No pixel gains energy"), OverweightPixels, 0);
+
+    // Tables over the memory budget drop to a smaller grid; the size is computed without int32 overflow.
+    Params.SamplesPerAxis = 3;
+    TestEqual(TEXT("Small tables keep the requested grid"), FOmniCaptureProjectionRemap::GetTableSamplesPerAxis(Params, EyeSize), 3);
+    TestEqual(TEXT("An 8192x4096 eye falls back to one tap"), FOmniCaptureProjectionRemap::GetTableSamplesPerAxis(Params, FIntPoint(8192, 4096)), 1);
+    TestEqual(TEXT("A 4096x2048 eye falls back to 2x2"), FOmniCaptureProjectionRemap::GetTableSamplesPerAxis(Params, FIntPoint(4096, 2048)), 2);
+    TestEqual(TEXT("Sizes past int32 entries fall back to one tap"), FOmniCaptureProjectionRemap::GetTableSamplesPerAxis(Params, FIntPoint(65536, 32768)), 1);
+    return true;
+}
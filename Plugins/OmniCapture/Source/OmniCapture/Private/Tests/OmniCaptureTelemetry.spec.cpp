@@ -0,0 +1,112 @@
+#include "Misc/AutomationTest.h"
+
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "OmniCaptureTelemetry.h"
+
+namespace OmniCaptureTelemetryTests
+{
+    FOmniCaptureTelemetrySnapshot MakeGauges(int32 Value)
+    {
+        FOmniCaptureTelemetrySnapshot Gauges;
+        Gauges.RingBufferPending = Value;
+        Gauges.WriterPendingFrames = Value;
+        Gauges.DroppedFrames = Value;
+        Gauges.EncodedPackets = Value;
+        return Gauges;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureTelemetryTest, "OmniCapture.Diagnostics.Telemetry", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FOmniCaptureTelemetryTest::RunTest(const FString& Parameters)
+{
+    using namespace OmniCaptureTelemetryTests;
+
+    FOmniCaptureTelemetry Telemetry;
+    TestEqual(TEXT("Nothing is published before the first publish"), static_cast<int32>(Telemetry.GetSnapshot().PublishIndex), 0);
+
+    // Counters become rates over the time between publishes.
+    Telemetry.RecordFrameCaptured(1000);
+    Telemetry.RecordBytesWritten(4000);
+    Telemetry.Publish(1.0, MakeGauges(0));
+    Telemetry.RecordFrameCaptured(1000);
+    Telemetry.RecordFrameCaptured(1000);
+    Telemetry.RecordBytesWritten(2000);
+    FOmniCaptureTelemetrySnapshot Gauges = MakeGauges(3);
+    Gauges.EncodedBytes = 500;
+    Telemetry.Publish(3.0, Gauges);
+
+    FOmniCaptureTelemetrySnapshot Snapshot = Telemetry.GetSnapshot();
+    TestEqual(TEXT("Publishes are counted"), static_cast<int32>(Snapshot.PublishIndex), 2);
+    TestEqual(TEXT("Frames accumulate"), Snapshot.FramesCaptured, 3);
+    TestEqual(TEXT("Frame rate covers the interval"), Snapshot.CaptureFramesPerSecond, 1.0);
+    TestEqual(TEXT("Write rate covers the interval"), Snapshot.BytesWrittenPerSecond, 1000.0);
+    TestEqual(TEXT("Encoder rate comes from the gauge change"), Snapshot.EncodedBytesPerSecond, 250.0);
+    TestEqual(TEXT("Memory in flight counts ring and writer frames"), static_cast<int32>(Snapshot.MemoryInFlightBytes), 6000);
+
+    // Stage latencies are means over the frames recorded since the previous publish.
+    FOmniCaptureFrameStageTimings Timings;
+    Timings[EOmniCaptureStage::Conversion] = 4.0;
+    Telemetry.RecordStageTimings(Timings);
+    Timings[EOmniCaptureStage::Conversion] = 8.0;
+    Timings[EOmniCaptureStage::FileWrite] = 2.0;
+    Telemetry.RecordStageTimings(Timings);
+    Telemetry.RecordAudioSync(1.5, 3.0, 2);
+    Telemetry.Publish(4.0, MakeGauges(0));
+    Snapshot = Telemetry.GetSnapshot();
+    TestEqual(TEXT("Conversion averages both frames"), Snapshot[EOmniCaptureStage::Conversion], 6.0, 0.01);
+    TestEqual(TEXT("File write averages the frame that wrote"), Snapshot[EOmniCaptureStage::FileWrite], 2.0, 0.01);
+    TestEqual(TEXT("Audio drift is carried"), Snapshot.AudioDriftMilliseconds, 1.5);
+    Telemetry.Publish(5.0, MakeGauges(0));
+    TestEqual(TEXT("An interval without frames reports no latency"), Telemetry.GetSnapshot()[EOmniCaptureStage::Conversion], 0.0);
+    TestTrue(TEXT("Every stage has a CSV column"), FOmniCaptureTelemetry::GetCsvHeader().Contains(TEXT(",preview_ms,")));
+
+    // A reader never sees a half-written snapshot while another thread publishes.
+    constexpr int32 PublishCount = 20000;
+    TAtomic<bool> bPublishing(true);
+    TFuture<void> Publisher = Async(EAsyncExecution::Thread, [&Telemetry, &bPublishing]()
+    {
+        for (int32 Index = 1; Index <= PublishCount; ++Index)
+        {
+            Telemetry.Publish(5.0 + Index, MakeGauges(Index));
+        }
+        bPublishing = false;
+    });
+    int32 TornReads = 0;
+    int32 Reads = 0;
+    while (bPublishing.Load() || Reads == 0)
+    {
+        const FOmniCaptureTelemetrySnapshot Read = Telemetry.GetSnapshot();
+        TornReads += (Read.RingBufferPending == Read.WriterPendingFrames && Read.RingBufferPending == Read.DroppedFrames && Read.RingBufferPending == Read.EncodedPackets) ? 0 : 1;
+        ++Reads;
+    }
+    Publisher.Wait();
+    TestEqual(TEXT("Concurrent reads are consistent"), TornReads, 0);
+    TestEqual(TEXT("The last publish is visible"), Telemetry.GetSnapshot().RingBufferPending, PublishCount);
+
+    // The CSV gets a header and one row per publish.
+    const FString CsvPath = FPaths::AutomationTransientDir() / TEXT("OmniCaptureTelemetry") / TEXT("Telemetry.csv");
+    Telemetry.Reset();
+    TestTrue(TEXT("CSV opens"), Telemetry.OpenCsv(CsvPath));
+    Telemetry.Publish(0.25, MakeGauges(1));
+    Telemetry.Publish(0.5, MakeGauges(2));
+    Telemetry.CloseCsv();
+
+    TArray<FString> Lines;
+    TestTrue(TEXT("CSV is readable"), FFileHelper::LoadFileToStringArray(Lines, *CsvPath));
+    TestEqual(TEXT("Header plus one row per publish"), Lines.Num(), 3);
+    if (Lines.Num() == 3)
+    {
+        TArray<FString> HeaderColumns;
+        TArray<FString> RowColumns;
+        Lines[0].ParseIntoArray(HeaderColumns, TEXT(","));
+        Lines[2].ParseIntoArray(RowColumns, TEXT(","));
+        TestEqual(TEXT("Rows match the header"), RowColumns.Num(), HeaderColumns.Num());
+        TestTrue(TEXT("Rows start with the capture time"), Lines[2].StartsWith(TEXT("0.500,")));
+    }
+    IFileManager::Get().DeleteDirectory(*FPaths::GetPath(CsvPath), false, true);
+    return true;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OmniCaptureTypes.h"
+
+struct FOmniCaptureAVTimelineStats
+{
+    int64 EmittedSamples = 0;
+    int64 PaddedSamples = 0;
+    int64 TrimmedSamples = 0;
+    int32 PadEvents = 0;
+    int32 TrimEvents = 0;
+    int32 RejectedPackets = 0;
+    /** Gaps longer than MaxGapSeconds; only MaxGapSeconds of silence was inserted for each. */
+    int32 ClampedGaps = 0;
+    /** Packets stretched or squeezed to absorb clock drift, and the net sample frames that added. */
+    int32 ResampleEvents = 0;
+    int64 ResampledFrames = 0;
+    double MaxCorrectionMilliseconds = 0.0;
+};
+
+/**
+ * Keeps the captured audio stream sample-aligned with the video presentation timestamps.
+ *
+ * The first video frame defines time zero of the output. Each audio packet is placed on a continuous
+ * sample grid relative to that origin: jitter inside the tolerance is absorbed without touching the samples,
+ * drift up to MaxResampleSeconds past it is absorbed by resampling packets by at most MaxResampleRatio, larger
+ * gaps are filled with silence packets and larger overlaps are trimmed. A slowly drifting audio clock therefore
+ * never produces silence inserts or dropped samples. Packet timestamps are rewritten to their exact grid
+ * position. Game thread only.
+ *
+ * A gap longer than MaxGapSeconds is treated as an audio clock jump: only MaxGapSeconds of silence is inserted
+ * and later packets are placed relative to the jump, so one bad timestamp cannot allocate unbounded silence.
+ */
+class OMNICAPTURE_API FOmniCaptureAVTimeline
+{
+public:
+    /** Longest stretch of silence inserted for a single gap. */
+    static constexpr double MaxGapSeconds = 10.0;
+    /** Sample frames per inserted silence packet. */
+    static constexpr int32 SilencePacketFrames = 2048;
+    /** Offsets beyond the tolerance up to this are drift and resampled; beyond it they are lost or repeated packets. */
+    static constexpr double MaxResampleSeconds = 0.005;
+    /** Largest length change of one resampled packet, about 17 cents of pitch. */
+    static constexpr double MaxResampleRatio = 0.01;
+
+    void Reset(double InToleranceSeconds = 0.002);
+
+    void AddVideoFrame(double PresentationTime);
+
+    /** Pads, trims or drops packets in place so they form a gapless stream starting at the first frame. Gaps become separate silence packets. */
+    void ProcessAudio(TArray<FOmniAudioPacket>& InOutPackets);
+
+    /**
+     * Computes the correction that makes the audio end exactly with the last frame.
+     * @param OutTailPadding silence packets to append, empty when none are needed.
+     * @return number of interleaved samples that must be removed from the end of the stream.
+     */
+    int64 Finish(TArray<FOmniAudioPacket>& OutTailPadding);
+
+    bool HasVideo() const { return VideoTimestamps.Num() > 0; }
+    double GetVideoOrigin() const { return HasVideo() ? VideoTimestamps[0] : 0.0; }
+    double GetVideoEndTime() const;
+    double GetNominalFrameDuration() const;
+    int32 GetSampleRate() const { return SampleRate; }
+    int32 GetNumChannels() const { return NumChannels; }
+    int64 GetWriteCursorFrames() const { return WriteCursor; }
+    const TArray<double>& GetVideoTimestamps() const { return VideoTimestamps; }
+    const FOmniCaptureAVTimelineStats& GetStats() const { return Stats; }
+
+private:
+    int64 TimeToSampleFrame(double Seconds) const;
+    void RecordCorrection(int64 Frames);
+    int64 ClampGap(int64 Frames);
+    void EmitSilence(int64 Frames, TArray<FOmniAudioPacket>& Output);
+
+    TArray<double> VideoTimestamps;
+    FOmniCaptureAVTimelineStats Stats;
+    double ToleranceSeconds = 0.002;
+    int64 WriteCursor = 0;
+    /** Sample frames skipped by clamped gaps; packet timestamps are moved back by this much. */
+    int64 SkippedFrames = 0;
+    int32 SampleRate = 0;
+    int32 NumChannels = 0;
+};
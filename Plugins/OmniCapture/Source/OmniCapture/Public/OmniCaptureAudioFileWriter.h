@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OmniCaptureTypes.h"
+#include "Templates/Atomic.h"
+
+class FRunnableThread;
+class IFileHandle;
+class FOmniCaptureAudioFileWriterWorker;
+
+/**
+ * Streams PCM16 packets to a RIFF/WAVE file on a background thread.
+ *
+ * Packets are appended as they arrive and the header is rewritten periodically, so a file left behind
+ * by a crash is playable up to the last header refresh. The header reserves room for a ds64 chunk and
+ * becomes RF64 once the PCM no longer fits the 32-bit RIFF sizes, so long captures are never clamped.
+ */
+class OMNICAPTURE_API FOmniCaptureAudioFileWriter
+{
+public:
+    /** RIFF + 36-byte JUNK/ds64 chunk + fmt + data chunk header. */
+    static constexpr int32 WaveHeaderSize = 80;
+
+    FOmniCaptureAudioFileWriter();
+    ~FOmniCaptureAudioFileWriter();
+
+    bool Open(const FString& InFilePath, double InHeaderRefreshSeconds = 1.0);
+    void Enqueue(const FOmniAudioPacket& Packet);
+    /** Flushes pending packets and finalizes the header. A non-negative MaxDataBytes truncates the PCM payload. */
+    void Close(int64 MaxDataBytes = -1);
+
+    bool IsOpen() const { return FileHandle.IsValid(); }
+    const FString& GetFilePath() const { return FilePath; }
+    int64 GetDataBytesWritten() const { return DataBytesWritten.Load(); }
+    int32 GetPendingPacketCount() const { return PendingCount.Load(); }
+    int32 GetRejectedPacketCount() const { return RejectedCount.Load(); }
+
+    static void BuildWaveHeader(int32 SampleRate, int32 NumChannels, int64 DataBytes, TArray<uint8>& OutHeader);
+    /** Whether a payload of DataBytes needs the RF64 form of the header. */
+    static bool IsRF64(int64 DataBytes);
+
+private:
+    friend class FOmniCaptureAudioFileWriterWorker;
+
+    void DrainQueue();
+    void WritePacket(const FOmniAudioPacket& Packet);
+    void RewriteHeader();
+
+    FString FilePath;
+    TUniquePtr<IFileHandle> FileHandle;
+    TQueue<FOmniAudioPacket, EQueueMode::Spsc> Queue;
+
+    TUniquePtr<FRunnableThread> WorkerThread;
+    FOmniCaptureAudioFileWriterWorker* Worker = nullptr;
+    FEvent* DataEvent = nullptr;
+    TAtomic<bool> bRunning;
+    TAtomic<int32> PendingCount;
+    TAtomic<int32> RejectedCount;
+    TAtomic<int64> DataBytesWritten;
+
+    double HeaderRefreshSeconds = 1.0;
+    double LastHeaderWriteTime = 0.0;
+    int32 SampleRate = 0;
+    int32 NumChannels = 0;
+    bool bLoggedFormatMismatch = false;
+    bool bLoggedRF64 = false;
+};
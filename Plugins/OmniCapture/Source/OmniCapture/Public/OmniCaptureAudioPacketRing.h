@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OmniCaptureTypes.h"
+#include "Templates/Atomic.h"
+
+/**
+ * Wait-free single-producer / single-consumer ring of fixed-size PCM16 blocks.
+ *
+ * The audio render thread is the only producer and the game thread the only consumer. All block
+ * storage is allocated up front in Initialize, so Push never allocates or takes a lock. When the
+ * ring is full the incoming block is discarded and accounted for in the dropped counters.
+ */
+class OMNICAPTURE_API FOmniCaptureAudioPacketRing
+{
+public:
+    static constexpr int32 DefaultBlockCount = 256;
+    static constexpr int32 DefaultSamplesPerBlock = 4096;
+
+    FOmniCaptureAudioPacketRing();
+
+    /** Allocates block storage. BlockCount is rounded up to a power of two. Not thread safe. */
+    void Initialize(int32 InBlockCount = DefaultBlockCount, int32 InSamplesPerBlock = DefaultSamplesPerBlock);
+
+    /** Discards every pending block and clears counters. Call only while no producer is active. */
+    void Reset();
+
+    /**
+     * Producer side. Converts interleaved float samples to PCM16 with gain applied and publishes them.
+     * Buffers larger than one block are split, with timestamps advanced by the frames already written.
+     * @return number of samples that were dropped because the ring was full.
+     */
+    int32 Push(const float* AudioData, int32 NumSamples, int32 NumChannels, int32 SampleRate, double Timestamp, float Gain);
+
+    /** Consumer side. Moves every block whose timestamp is <= Threshold into OutPackets. */
+    int32 PopUpTo(double Threshold, TArray<FOmniAudioPacket>& OutPackets);
+
+    /** Consumer side. Moves every pending block into OutPackets regardless of timestamp. */
+    int32 PopAll(TArray<FOmniAudioPacket>& OutPackets);
+
+    int32 GetPendingBlockCount() const;
+    int32 GetDroppedBlockCount() const { return DroppedBlocks.Load(); }
+    int64 GetDroppedSampleCount() const { return DroppedSamples.Load(); }
+    int64 GetPushedSampleCount() const { return PushedSamples.Load(); }
+    int32 GetBlockCapacity() const { return BlockCount; }
+    int32 GetSamplesPerBlock() const { return SamplesPerBlock; }
+
+    /** Scales, clamps and rounds float samples to PCM16 using four-wide vector math. */
+    static void ConvertFloatToPCM16(const float* Source, int16* Destination, int32 NumSamples, float Gain);
+
+private:
+    struct FBlock
+    {
+        double Timestamp = 0.0;
+        int32 SampleRate = 0;
+        int32 NumChannels = 0;
+        int32 NumSamples = 0;
+    };
+
+    bool PopFront(double Threshold, bool bIgnoreThreshold, FOmniAudioPacket& OutPacket);
+
+    TArray<FBlock> Blocks;
+    TArray<int16> SampleStorage;
+    int32 BlockCount = 0;
+    int32 SamplesPerBlock = 0;
+    uint32 IndexMask = 0;
+
+    TAtomic<uint32> WriteIndex;
+    TAtomic<uint32> ReadIndex;
+    TAtomic<int32> DroppedBlocks;
+    TAtomic<int64> DroppedSamples;
+    TAtomic<int64> PushedSamples;
+};
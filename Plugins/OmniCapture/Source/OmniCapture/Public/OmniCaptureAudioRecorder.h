@@ -2,6 +2,9 @@
 
 #include "CoreMinimal.h"
 #include "OmniCaptureTypes.h"
+#include "OmniCaptureAudioPacketRing.h"
+#include "OmniCaptureAudioFileWriter.h"
+#include "OmniCaptureAVTimeline.h"
 #include "Templates/Atomic.h"
 
 class UWorld;
@@ -21,19 +24,28 @@ public:
     void Start();
     void Stop(const FString& OutputDirectory, const FString& BaseFileName);
 
+    /** Platform time that frame timestamps passed to GatherAudio are relative to. */
+    void SetCaptureClockOrigin(double PlatformSeconds) { CaptureClockOrigin = PlatformSeconds; }
     void GatherAudio(double FrameTimestamp, TArray<FOmniAudioPacket>& OutPackets);
     FString GetDebugStatus() const;
     int32 GetPendingPacketCount() const;
+    int32 GetDroppedPacketCount() const;
+    int64 GetPaddedSampleCount() const { return PaddedSampleCount.Load(); }
+    int64 GetTrimmedSampleCount() const { return TrimmedSampleCount.Load(); }
 
     void SetPaused(bool bInPaused);
     bool IsPaused() const { return bPaused.Load(); }
 
     bool IsRecording() const { return bIsRecording; }
     FString GetOutputFilePath() const { return OutputFilePath; }
+    /** File currently being streamed; valid between Start and Stop. */
+    FString GetStreamingFilePath() const { return FileWriter.GetFilePath(); }
 
 private:
     void RegisterListener();
     void UnregisterListener();
+    double GetAudioToCaptureClockOffset() const;
+    FString BuildOutputFilePath(const FString& OutputDirectory, const FString& BaseFileName) const;
     void HandleSubmixBuffer(const float* AudioData, int32 NumSamples, int32 NumChannels, int32 SampleRate, double AudioClock);
 
     TWeakObjectPtr<UWorld> WorldPtr;
@@ -41,16 +53,21 @@ private:
     float Gain = 1.0f;
     FString OutputFilePath;
 
-    mutable FCriticalSection PacketCS;
-    TQueue<FOmniAudioPacket, EQueueMode::Mpsc> PendingPackets;
+    FOmniCaptureAudioPacketRing PacketRing;
+    FOmniCaptureAudioFileWriter FileWriter;
+    FOmniCaptureAVTimeline Timeline;
+    FString PendingOutputDirectory;
+    FString PendingBaseFileName;
     TWeakObjectPtr<USoundSubmix> TargetSubmix;
     class FOmniCaptureSubmixListener* SubmixListener = nullptr;
     class Audio::FMixerDevice* MixerDevice = nullptr;
     double AudioClockOrigin = -1.0;
+    double CaptureClockOrigin = 0.0;
+    TAtomic<double> AudioPlatformOrigin = -1.0;
     double AudioStartTime = 0.0;
     int32 CachedSampleRate = 48000;
-    TAtomic<int32> PendingPacketCount = 0;
-    TAtomic<int32> DroppedPacketCount = 0;
+    TAtomic<int64> PaddedSampleCount = 0;
+    TAtomic<int64> TrimmedSampleCount = 0;
     TAtomic<bool> bPaused = false;
     TAtomic<bool> bLoggedOverflowWarning = false;
 };
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OmniCaptureTypes.h"
+#include "OmniCaptureStageTimings.h"
+
+class FJsonObject;
+struct FOmniCaptureCubemapPixels;
+
+/** One benchmark configuration: output size, eye count and writer format. */
+struct FOmniCaptureBenchmarkCase
+{
+    FString Name;
+    FOmniCaptureSettings Settings;
+};
+
+struct FOmniCaptureBenchmarkOptions
+{
+    /** Equirect output widths; 2048, 4096 and 8192 are the 2K, 4K and 8K cases. */
+    TArray<int32> OutputWidths = { 2048, 4096, 8192 };
+    bool bMono = true;
+    bool bStereo = true;
+    /** PNG runs once per bit depth and EXR once per precision. */
+    TArray<EOmniCaptureImageFormat> ImageFormats = { EOmniCaptureImageFormat::PNG, EOmniCaptureImageFormat::JPG, EOmniCaptureImageFormat::EXR, EOmniCaptureImageFormat::BMP, EOmniCaptureImageFormat::Y4M };
+    int32 FramesPerCase = 8;
+    /** Runs the manifest writer and FFmpeg mux after the frames are written. */
+    bool bMux = true;
+    /** Case outputs go to OutputDirectory/<case name> and are deleted afterwards unless bKeepOutputs. */
+    FString OutputDirectory;
+    bool bKeepOutputs = false;
+    /** Only cases whose name contains Filter run. */
+    FString Filter;
+};
+
+/** Latency distribution of one stage over a case's frames. */
+struct FOmniCaptureBenchmarkStageStats
+{
+    int32 Samples = 0;
+    double MeanMilliseconds = 0.0;
+    double P50Milliseconds = 0.0;
+    double P90Milliseconds = 0.0;
+    double P99Milliseconds = 0.0;
+    double MaxMilliseconds = 0.0;
+};
+
+struct FOmniCaptureBenchmarkResult
+{
+    FString Name;
+    FIntPoint OutputSize = FIntPoint::ZeroValue;
+    bool bStereo = false;
+    EOmniCaptureImageFormat ImageFormat = EOmniCaptureImageFormat::PNG;
+    int32 Frames = 0;
+    /** From the first conversion until the writers have flushed; excludes synthetic input generation and muxing. */
+    double WallSeconds = 0.0;
+    double FramesPerSecond = 0.0;
+    double MegapixelsPerSecond = 0.0;
+    /** Highest process physical memory sampled during the case. */
+    uint64 PeakUsedPhysicalBytes = 0;
+    int64 BytesWritten = 0;
+    bool bMuxed = false;
+    FOmniCaptureBenchmarkStageStats Stages[static_cast<int32>(EOmniCaptureStage::Count)];
+    bool bSucceeded = false;
+    FString Error;
+};
+
+/**
+ * Drives the CPU half of the capture pipeline on synthetic cubemaps: CPU remap, pixel packing, ring buffer, image
+ * writer, frame index, manifest and mux. Nothing touches the RHI, so it runs under -nullrhi. Stage latencies come
+ * from the same scopes the live capture records (see OMNICAPTURE_STAGE_SCOPE).
+ */
+class OMNICAPTURE_API FOmniCaptureBenchmark
+{
+public:
+    static TArray<FOmniCaptureBenchmarkCase> MakeCases(const FOmniCaptureBenchmarkOptions& Options);
+    static TArray<FOmniCaptureBenchmarkResult> Run(const FOmniCaptureBenchmarkOptions& Options);
+    static FOmniCaptureBenchmarkResult RunCase(const FOmniCaptureBenchmarkCase& Case, const FOmniCaptureBenchmarkOptions& Options);
+
+    /** Deterministic gradient-and-checker cubemap with faces sized the way adaptive face resolution would render them. */
+    static void MakeSyntheticCubemap(const FOmniCaptureSettings& Settings, int32 Seed, FOmniCaptureCubemapPixels& OutCubemap);
+    /** Nearest-rank percentiles; sorts Samples in place. */
+    static FOmniCaptureBenchmarkStageStats ComputeStageStats(TArray<double>& Samples);
+
+    static TSharedRef<FJsonObject> MakeReport(const FOmniCaptureBenchmarkOptions& Options, const TArray<FOmniCaptureBenchmarkResult>& Results);
+    static bool SaveReport(const TSharedRef<FJsonObject>& Report, const FString& FilePath);
+};
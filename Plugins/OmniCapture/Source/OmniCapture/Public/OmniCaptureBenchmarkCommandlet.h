@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "OmniCaptureBenchmarkCommandlet.generated.h"
+
+/**
+ * Headless pipeline benchmark that writes a JSON report for CI to diff.
+ *
+ * UnrealEditor-Cmd <Project> -run=OmniCaptureBenchmark -nullrhi -unattended [-Report=<file>] [-Widths=2048,4096,8192]
+ *     [-Eyes=Mono,Stereo] [-Formats=PNG,JPG,EXR,BMP,Y4M] [-Frames=8] [-Filter=<substring>] [-NoMux] [-KeepOutputs]
+ *     [-OutputDir=<dir>]
+ *
+ * Returns non-zero if any case fails.
+ */
+UCLASS()
+class OMNICAPTURE_API UOmniCaptureBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UOmniCaptureBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "OmniCaptureTypes.h"
+
+class FArchive;
+
+/**
+ * Fixed-capacity ring of diagnostic entries with monotonically increasing sequence numbers.
+ *
+ * Every appended entry is stamped with the next sequence, which is never reused, not even after Reset, so readers can
+ * poll GetSince with the last sequence they saw and receive only what is new. Once the ring is full the oldest entry
+ * is evicted and, when a spill file is set, queued for it. Queued entries are written as text lines in batches of
+ * SpillBatchSize outside the ring lock, and the file is only flushed by FlushSpill, Reset and destruction; it rolls
+ * over to a ".1" sibling when it grows past its size limit. Reset spills whatever the ring still holds and bumps a
+ * reset generation, so readers holding copies of the entries know to drop them.
+ */
+class OMNICAPTURE_API FOmniCaptureDiagnosticLog
+{
+public:
+    static constexpr int32 DefaultCapacity = 256;
+    static constexpr int64 DefaultMaxSpillBytes = 4 * 1024 * 1024;
+    static constexpr int32 SpillBatchSize = 32;
+
+    explicit FOmniCaptureDiagnosticLog(int32 InCapacity = DefaultCapacity);
+    ~FOmniCaptureDiagnosticLog();
+
+    /** Evicted entries go to FilePath, which is opened lazily on the first eviction. An empty path disables spilling. */
+    void SetSpillFile(const FString& FilePath, int64 InMaxSpillBytes = DefaultMaxSpillBytes);
+    FString GetSpillFilePath() const;
+
+    /** Stamps Entry with the next sequence number, stores it and returns the sequence. */
+    int64 Append(FOmniCaptureDiagnosticEntry Entry);
+
+    /** Retained entries with a sequence above Sequence, oldest first. Returns the newest sequence appended so far. */
+    int64 GetSince(int64 Sequence, TArray<FOmniCaptureDiagnosticEntry>& OutEntries) const;
+    void GetAll(TArray<FOmniCaptureDiagnosticEntry>& OutEntries) const { GetSince(0, OutEntries); }
+
+    int64 GetLatestSequence() const;
+    int32 Num() const;
+    int32 GetCapacity() const { return Capacity; }
+
+    /** Spills the retained entries, oldest first, then empties the ring. Sequence numbers keep counting. */
+    void Reset();
+    /** Number of Resets so far. */
+    int32 GetResetGeneration() const;
+
+    /** Writes every queued evicted entry to the spill file and flushes it. */
+    void FlushSpill();
+
+    /** Single-line form used by the spill file. */
+    static FString FormatEntry(const FOmniCaptureDiagnosticEntry& Entry);
+
+private:
+    /** Callers hold SpillCriticalSection. */
+    void WritePendingSpill(bool bFlush);
+    void WriteSpillLine(const FOmniCaptureDiagnosticEntry& Entry);
+    void CloseSpillFile();
+
+    /** Guards the ring and PendingSpill. Never held while the spill file is written. */
+    mutable FCriticalSection CriticalSection;
+    const int32 Capacity;
+    TArray<FOmniCaptureDiagnosticEntry> Entries;
+    /** Slot of the oldest retained entry once the ring has wrapped. */
+    int32 OldestIndex = 0;
+    int64 NextSequence = 1;
+    int32 ResetGeneration = 0;
+    bool bSpillEnabled = false;
+    TArray<FOmniCaptureDiagnosticEntry> PendingSpill;
+
+    /** Guards the spill file; taken before CriticalSection when both are needed. */
+    mutable FCriticalSection SpillCriticalSection;
+    FString SpillFilePath;
+    int64 MaxSpillBytes = DefaultMaxSpillBytes;
+    TUniquePtr<FArchive> SpillArchive;
+};
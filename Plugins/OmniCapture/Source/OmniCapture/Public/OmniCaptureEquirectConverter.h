@@ -8,11 +8,11 @@
 // 公共头只做前置声明，避免路径/版本差异在项目内扩散
 class UTextureRenderTarget2D;
 class FTextureRenderTargetResource;
+struct FOmniCaptureCubemapPixels;
 
 struct FOmniCaptureEquirectResult
 {
     TUniquePtr<FImagePixelData> PixelData;
-    TArray<FColor> PreviewPixels;
     FIntPoint Size = FIntPoint::ZeroValue;
     bool bIsLinear = false;
     bool bUsedCPUFallback = false;
@@ -25,11 +25,35 @@ struct FOmniCaptureEquirectResult
     TArray<TRefCountPtr<IPooledRenderTarget>> EncoderPlanes;
 };
 
+/** Cube faces of one layer (beauty or an auxiliary pass) for each eye. */
+struct FOmniCaptureLayerEyes
+{
+    FOmniEyeCapture LeftEye;
+    FOmniEyeCapture RightEye;
+};
+
 class OMNICAPTURE_API FOmniCaptureEquirectConverter
 {
 public:
     static FOmniCaptureEquirectResult ConvertToEquirectangular(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye);
     static FOmniCaptureEquirectResult ConvertToFisheye(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye);
+    /** Remap-table outputs: the FOmniCaptureProjectionRemap projections, plus equirect and fisheye at supersampled RemapQuality. */
+    static FOmniCaptureEquirectResult ConvertToProjection(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye);
+    /**
+     * Remaps layers captured by one rig through a single remap table walk: each pixel's taps are resolved once and
+     * sampled from every layer. On GPU that is one dispatch and one readback per face format. Results follow Layers'
+     * order and carry CPU pixels only, so encoder planes still come from the single-layer converters.
+     */
+    static TArray<FOmniCaptureEquirectResult> ConvertLayers(const FOmniCaptureSettings& Settings, const TArray<FOmniCaptureLayerEyes>& Layers);
+    /** Omni-directional stereo: stitches each eye's ODS views into its half of the stereo equirect (see FOmniCaptureODSLayout). */
+    static FOmniCaptureEquirectResult ConvertToODS(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye);
     static FOmniCaptureEquirectResult ConvertToPlanar(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& SourceEye);
+    /**
+     * The CPU fallback of ConvertToProjection for cubemaps already in memory: one remap table walk for both eyes, packed
+     * like a GPU readback. Needs no RHI, so the benchmark and perf tests run it under -nullrhi.
+     */
+    static FOmniCaptureEquirectResult ConvertCubemapsOnCPU(const FOmniCaptureSettings& Settings, const FOmniCaptureCubemapPixels& LeftCubemap, const FOmniCaptureCubemapPixels& RightCubemap, EOmniCapturePixelPrecision Precision);
+    /** Repacks a result's CPU pixels as RGB10A2 when Settings.UsesPackedFrames(). The replaced pixels go to OutUnpackedPixels when given. */
+    static void PackOutputPixels(const FOmniCaptureSettings& Settings, FOmniCaptureEquirectResult& InOutResult, TUniquePtr<FImagePixelData>* OutUnpackedPixels = nullptr);
 };
 
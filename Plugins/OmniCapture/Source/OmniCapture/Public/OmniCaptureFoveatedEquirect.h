@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Run of consecutive equirect rows that share one horizontal divisor. */
+struct FOmniCaptureFoveatedBand
+{
+    int32 FirstSourceRow = 0;
+    int32 SourceRowCount = 0;
+    int32 FirstOutputRow = 0;
+    int32 Divisor = 1;
+};
+
+/**
+ * Row table for latitude-dependent equirect output.
+ *
+ * Rows above FoveationStartLatitude keep 1/2, 1/4, ... of their width, one halving per level, and
+ * Divisor such rows are packed side by side into a single output row. The table is fully determined
+ * by the source size and the two foveation settings, so it can be rebuilt from the manifest.
+ */
+class OMNICAPTURE_API FOmniCaptureFoveatedLayout
+{
+public:
+    static FOmniCaptureFoveatedLayout Build(const FIntPoint& SourceSize, float StartLatitudeDegrees, int32 Levels);
+
+    bool IsValid() const { return SourceSize.X > 0 && SourceSize.Y > 0 && Bands.Num() > 0; }
+    int32 GetPackedHeight() const { return OutputRowDivisor.Num(); }
+
+    /** Output pixel -> source row and horizontal UV (0..1) within that row. False for unused padding. */
+    bool ResolveOutputPixel(int32 X, int32 OutputRow, int32& OutSourceRow, double& OutU) const;
+
+    /** Replicates each packed pixel over its span; Pack(Expand(P)) == P, so nothing is lost. */
+    template <typename PixelType>
+    void Expand(TArrayView<const PixelType> Packed, int32 PackedStride, TArray<PixelType>& OutEquirect) const
+    {
+        OutEquirect.SetNumUninitialized(SourceSize.X * SourceSize.Y);
+        for (int32 Row = 0; Row < SourceSize.Y; ++Row)
+        {
+            const FSourceRow& Source = SourceRows[Row];
+            const int32 Divisor = SourceSize.X / Source.Width;
+            const PixelType* PackedRow = Packed.GetData() + Source.OutputRow * PackedStride + Source.OutputX;
+            PixelType* Dest = OutEquirect.GetData() + Row * SourceSize.X;
+            for (int32 X = 0; X < SourceSize.X; ++X)
+            {
+                Dest[X] = PackedRow[X / Divisor];
+            }
+        }
+    }
+
+    /** Box-filters a full equirect into the packed layout; the CPU reference for the remap path. */
+    void Pack(TArrayView<const FLinearColor> Equirect, TArray<FLinearColor>& OutPacked) const;
+
+    FIntPoint SourceSize = FIntPoint::ZeroValue;
+    float StartLatitudeDegrees = 90.0f;
+    int32 Levels = 0;
+    TArray<FOmniCaptureFoveatedBand> Bands;
+
+private:
+    struct FSourceRow
+    {
+        int32 OutputRow = 0;
+        int32 OutputX = 0;
+        int32 Width = 0;
+    };
+
+    TArray<FSourceRow> SourceRows;
+    TArray<int32> OutputRowFirstSource;
+    TArray<int32> OutputRowSourceCount;
+    TArray<int32> OutputRowDivisor;
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OmniCaptureTypes.h"
+#include "HAL/CriticalSection.h"
+
+class IFileHandle;
+class FJsonObject;
+
+enum class EOmniCaptureFrameIndexRecordType : uint8
+{
+    Frame = 0,
+    Dropped = 1,
+    Encoded = 2
+};
+
+/** Fixed-size little-endian row stored in the <Base>_FrameIndex.bin sidecar. */
+struct FOmniCaptureFrameIndexRecord
+{
+    double Timecode = 0.0;
+    int64 Value = 0;
+    int32 FrameIndex = 0;
+    uint8 Type = 0;
+    uint8 Flags = 0;
+    uint16 Reserved = 0;
+
+    static constexpr uint8 FlagKeyFrame = 1 << 0;
+    static constexpr uint8 FlagDuplicate = 1 << 1;
+};
+static_assert(sizeof(FOmniCaptureFrameIndexRecord) == 24, "Frame index records are serialized verbatim and must stay 24 bytes.");
+
+/** Per-frame view of the sidecar after drops and encode sizes have been folded in. */
+struct FOmniCaptureFrameIndexEntry
+{
+    FOmniCaptureFrameMetadata Metadata;
+    int64 EncodedBytes = -1;
+};
+
+struct FOmniCaptureFrameIndexContents
+{
+    TArray<FOmniCaptureFrameIndexEntry> Frames;
+    TArray<FOmniCaptureFrameIndexRecord> Drops;
+};
+
+/**
+ * Append-only binary frame index written during capture.
+ *
+ * Each captured frame, drop event and encoded size is one 24-byte record, buffered and flushed in
+ * small batches so the cost per frame is constant and a crash loses at most one batch. A small JSON
+ * header next to the binary file describes the layout. Thread safe.
+ */
+class OMNICAPTURE_API FOmniCaptureFrameIndexWriter
+{
+public:
+    static constexpr uint32 FileMagic = 0x49464D4F; // "OMFI"
+    static constexpr uint32 FileVersion = 1;
+    static constexpr int32 FileHeaderSize = 16;
+
+    FOmniCaptureFrameIndexWriter();
+    ~FOmniCaptureFrameIndexWriter();
+
+    bool Open(const FString& Directory, const FString& BaseFileName, const FOmniCaptureSettings& Settings);
+    void Close();
+
+    void AppendFrame(const FOmniCaptureFrameMetadata& Metadata);
+    void AppendDrop(int32 FrameIndex, double Timecode);
+    void AppendEncodedSize(int32 FrameIndex, int64 EncodedBytes);
+    void Flush();
+
+    bool IsOpen() const { return FileHandle.IsValid(); }
+    const FString& GetBinaryPath() const { return BinaryPath; }
+    int64 GetRecordCount() const { return RecordCount; }
+
+    static FString MakeBinaryPath(const FString& Directory, const FString& BaseFileName);
+    static FString MakeHeaderPath(const FString& Directory, const FString& BaseFileName);
+
+    /** Reads a sidecar, tolerating a truncated final record. */
+    static bool Load(const FString& InBinaryPath, FOmniCaptureFrameIndexContents& OutContents);
+
+    /** Writes Root followed by the manifest "frames" and "dropEvents" arrays, streamed in chunks. */
+    static bool ExportManifestJson(const FOmniCaptureFrameIndexContents& Contents, const TSharedRef<FJsonObject>& Root, const FString& OutJsonPath);
+    /** The same manifest with its rows streamed from a sidecar file; only encode sizes and drops are held in memory. */
+    static bool ExportManifestJson(const FString& InBinaryPath, const TSharedRef<FJsonObject>& Root, const FString& OutJsonPath);
+
+private:
+    void AppendRecord(const FOmniCaptureFrameIndexRecord& Record);
+    void FlushLocked();
+
+    FCriticalSection WriterCS;
+    TUniquePtr<IFileHandle> FileHandle;
+    TArray<FOmniCaptureFrameIndexRecord> PendingRecords;
+    FString BinaryPath;
+    int64 RecordCount = 0;
+    double LastFlushTime = 0.0;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/FrameRate.h"
+#include "OmniCaptureTypes.h"
+
+/** What one engine tick should capture. */
+struct FOmniCaptureFramePacingStep
+{
+    /** Output slot of the frame rendered this tick. */
+    int64 Slot = 0;
+    /** Earlier slots this tick ran past, filled with copies of this tick's frame. */
+    int32 DuplicateSlots = 0;
+    /** Earlier slots this tick ran past that get no frame at all. */
+    int32 SkippedSlots = 0;
+    bool bCapture = false;
+
+    int64 GetFirstSlot() const { return Slot - DuplicateSlots; }
+};
+
+/**
+ * Decimates engine ticks to TargetFrameRate.
+ *
+ * Tick time accumulates in units of output slots and a tick captures once at least one slot has come due, carrying
+ * the remainder forward so the long-run capture rate is the target rate whatever the tick rate. Timecodes come from
+ * the slot index and the rational form of the rate, so frames are evenly spaced. A tick that runs past several slots
+ * (engine slower than the target) either skips the earlier ones or fills them with duplicates, up to one second of
+ * duplicates per tick.
+ *
+ * In FixedTimestep mode the world is expected to advance GetFixedDeltaSeconds() per tick, so the pacer ignores the
+ * tick delta: it lets WarmUpFrames frames' worth of ticks go by, then captures every TemporalSamples-th tick.
+ */
+class OMNICAPTURE_API FOmniCaptureFramePacer
+{
+public:
+    void Reset(EOmniCaptureFramePacing InMode, double InTargetFrameRate, int32 InTemporalSamples = 1, int32 InWarmUpFrames = 0);
+    FOmniCaptureFramePacingStep Advance(double DeltaSeconds);
+
+    /** False in EveryTick mode or without a target rate; every tick then captures and keeps wall-clock timecodes. */
+    bool IsPacing() const { return Mode != EOmniCaptureFramePacing::EveryTick && TargetFrameRate > 0.0; }
+    bool IsFixedTimestep() const { return Mode == EOmniCaptureFramePacing::FixedTimestep && TargetFrameRate > 0.0; }
+    /** Exact Slot * Denominator / Numerator of the rational frame rate. */
+    double GetSlotTimecode(int64 Slot) const;
+    const FFrameRate& GetFrameRate() const { return FrameRate; }
+    /** World time per engine tick in FixedTimestep mode: one output frame split over the temporal samples. */
+    double GetFixedDeltaSeconds() const;
+
+    int64 GetCapturedTicks() const { return CapturedTicks; }
+    int64 GetDecimatedTicks() const { return DecimatedTicks; }
+    int64 GetWarmUpTicks() const { return WarmUpTicks; }
+    int64 GetDuplicatedSlots() const { return DuplicatedSlots; }
+    int64 GetSkippedSlots() const { return SkippedSlots; }
+
+    /** Rational form of FramesPerSecond: whole rates as N/1, NTSC rates as N*1000/1001, anything else in thousandths. */
+    static FFrameRate MakeFrameRate(double FramesPerSecond);
+
+private:
+    EOmniCaptureFramePacing Mode = EOmniCaptureFramePacing::EveryTick;
+    FFrameRate FrameRate;
+    double TargetFrameRate = 0.0;
+    double Accumulator = 0.0;
+    int32 TemporalSamples = 1;
+    int32 SubSampleIndex = 0;
+    int64 WarmUpTicksRemaining = 0;
+    int64 NextSlot = 0;
+    int64 CapturedTicks = 0;
+    int64 DecimatedTicks = 0;
+    int64 WarmUpTicks = 0;
+    int64 DuplicatedSlots = 0;
+    int64 SkippedSlots = 0;
+};
@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "OmniCaptureTypes.h"
+#include "OmniCaptureStageTimings.h"
+#include "OmniCaptureY4MWriter.h"
 #include "Async/Future.h"
 #include "Templates/Function.h"
 #include "ImageWriteTypes.h"
@@ -13,10 +15,23 @@ public:
     ~FOmniCaptureImageWriter();
 
     void Initialize(const FOmniCaptureSettings& Settings, const FString& InOutputDirectory);
-    void EnqueueFrame(TUniquePtr<FOmniCaptureFrame>&& Frame, const FString& FrameFileName);
+    /**
+     * Writes the frame to FrameFileName. Each of the frame's duplicates gets a copy of the written file under the
+     * matching DuplicateFileNames entry; a Y4M stream repeats the frame instead.
+     */
+    void EnqueueFrame(TUniquePtr<FOmniCaptureFrame>&& Frame, const FString& FrameFileName, const TArray<FString>& DuplicateFileNames = TArray<FString>());
     void Flush();
     const TArray<FOmniCaptureFrameMetadata>& GetCapturedFrames() const { return CapturedMetadata; }
     TArray<FOmniCaptureFrameMetadata> ConsumeCapturedFrames();
+    /** Frames handed to writer tasks that have not finished; lock-free. */
+    int32 GetPendingFrameCount() const { return PendingFrameCount.Load(EMemoryOrder::Relaxed); }
+    /** zlib level (0-9) for PNG frames written from now on; -1 restores libpng's default. Safe while writing. */
+    void SetPNGCompressionLevel(int32 Level) { PNGCompressionLevel.Store(FMath::Clamp(Level, -1, 9), EMemoryOrder::Relaxed); }
+
+    /** Invoked from the writer tasks with the on-disk size of each successfully written frame. */
+    void SetFrameWrittenCallback(TFunction<void(int32 FrameIndex, int64 FileSizeBytes)>&& InCallback) { FrameWrittenCallback = MoveTemp(InCallback); }
+    /** Invoked from the writer tasks with each frame's encode and file write times. */
+    void SetStageTimingCallback(TFunction<void(const FOmniCaptureFrameStageTimings& Timings)>&& InCallback) { StageTimingCallback = MoveTemp(InCallback); }
 
 private:
     struct FExrLayerRequest
@@ -28,6 +43,8 @@ private:
         EOmniCapturePixelDataType PixelDataType = EOmniCapturePixelDataType::Unknown;
     };
 
+    /** Appends to the sequence's Y4M stream on the calling thread, which keeps frames in order. */
+    bool WriteY4MFrame(FOmniCaptureFrame& Frame);
     bool WritePixelDataToDisk(TUniquePtr<FImagePixelData> PixelData, const FString& FilePath, EOmniCaptureImageFormat Format, bool bIsLinear, EOmniCapturePixelPrecision PixelPrecision, EOmniCapturePixelDataType PixelDataType) const;
     bool WritePNGRaw(const FString& FilePath, const FIntPoint& Size, const void* RawData, int64 RawSizeInBytes, ERGBFormat Format, int32 BitDepth) const;
     bool WritePNGWithRowSource(const FString& FilePath, const FIntPoint& Size, ERGBFormat Format, int32 BitDepth, TFunctionRef<void(int32 RowStart, int32 RowCount, int64 BytesPerRow, TArray64<uint8>& TempBuffer, TArray<uint8*>& RowPointers)> PrepareRows) const;
@@ -62,12 +79,21 @@ private:
     bool bPackEXRAuxiliaryLayers = true;
     bool bUseEXRMultiPart = false;
     EOmniCaptureEXRCompression TargetEXRCompression = EOmniCaptureEXRCompression::Zip;
+    EOmniCaptureColorSpace TargetColorSpace = EOmniCaptureColorSpace::BT709;
+    double TargetFrameRate = 30.0;
+
+    FOmniCaptureY4MWriter Y4MWriter;
+    FCriticalSection Y4MCS;
 
     TArray<FOmniCaptureFrameMetadata> CapturedMetadata;
     FCriticalSection MetadataCS;
+    TFunction<void(int32, int64)> FrameWrittenCallback;
+    TFunction<void(const FOmniCaptureFrameStageTimings&)> StageTimingCallback;
 
     TArray<TFuture<bool>> PendingTasks;
     FCriticalSection PendingTasksCS;
     TAtomic<bool> bStopRequested;
+    TAtomic<int32> PendingFrameCount;
+    TAtomic<int32> PNGCompressionLevel;
 };
 
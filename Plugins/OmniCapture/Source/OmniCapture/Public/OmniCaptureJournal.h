@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OmniCaptureTypes.h"
+#include "Containers/Queue.h"
+#include "Templates/Atomic.h"
+
+class FRunnableThread;
+class IFileHandle;
+class FJsonObject;
+class FOmniCaptureJournalWorker;
+
+/** Segment as described by the journal: opened, optionally closed, with the frame range seen so far. */
+struct FOmniCaptureJournalSegment
+{
+    int32 SegmentIndex = 0;
+    FString Directory;
+    FString BaseFileName;
+    FString AudioPath;
+    FString VideoPath;
+    int32 FirstFrame = INDEX_NONE;
+    int32 LastFrame = INDEX_NONE;
+    int32 FrameCount = 0;
+    int32 DroppedFrames = 0;
+    bool bHasImageSequence = false;
+    bool bClosed = false;
+};
+
+/** Everything needed to finalize a capture that never reached EndCapture. */
+struct FOmniCaptureJournalRecovery
+{
+    FString JournalPath;
+    FOmniCaptureSettings Settings;
+    FString BaseDirectory;
+    FString BaseFileName;
+    FDateTime StartTime;
+    uint32 ProcessId = 0;
+    TArray<FOmniCaptureJournalSegment> Segments;
+};
+
+/**
+ * Append-only JSON-lines journal of a capture session.
+ *
+ * Segment open/close events, frame ranges and output paths are queued from the game thread and
+ * written and flushed by a worker, so a crash loses at most the last second of frame ranges. The
+ * journal is deleted when the capture ends normally; any journal left behind describes an
+ * unfinished capture that ResumeFinalize can mux from the files already on disk.
+ */
+class OMNICAPTURE_API FOmniCaptureJournal
+{
+public:
+    FOmniCaptureJournal();
+    ~FOmniCaptureJournal();
+
+    bool Begin(const FOmniCaptureSettings& Settings, const FString& BaseDirectory, const FString& BaseFileName);
+    void RecordSegmentOpen(const FOmniCaptureJournalSegment& Segment);
+    void RecordFrame(int32 SegmentIndex, int32 FrameIndex);
+    void RecordSegmentClose(const FOmniCaptureJournalSegment& Segment);
+    /** Stops the worker and removes the journal; the capture no longer needs recovery. */
+    void End(bool bFinalized);
+
+    bool IsOpen() const { return FileHandle.IsValid(); }
+    const FString& GetJournalPath() const { return JournalPath; }
+
+    static FString GetJournalDirectory();
+
+    /** Journals whose owning process is gone. */
+    static void FindUnfinished(TArray<FOmniCaptureJournalRecovery>& OutRecoveries);
+    /** Parses a journal, tolerating a torn final line. */
+    static bool Load(const FString& InJournalPath, FOmniCaptureJournalRecovery& OutRecovery);
+    /**
+     * Muxes every recorded segment from its sidecar, audio and video files without re-rendering.
+     * Each journal is claimed for the duration of the mux; a journal another caller is already finalizing is skipped.
+     */
+    static bool ResumeFinalize(const FOmniCaptureJournalRecovery& Recovery, TArray<FString>* OutFinalizedFiles = nullptr);
+    static int32 ResumeFinalizeAll(TArray<FString>* OutFinalizedFiles = nullptr);
+    static void Discard(const FOmniCaptureJournalRecovery& Recovery);
+
+private:
+    friend class FOmniCaptureJournalWorker;
+
+    void EnqueueEvent(const TSharedRef<FJsonObject>& Event);
+    void FlushFrameRange(bool bForce);
+    void DrainQueue();
+
+    FString JournalPath;
+    TUniquePtr<IFileHandle> FileHandle;
+    TQueue<FString, EQueueMode::Spsc> Queue;
+
+    TUniquePtr<FRunnableThread> WorkerThread;
+    FOmniCaptureJournalWorker* Worker = nullptr;
+    FEvent* DataEvent = nullptr;
+    TAtomic<bool> bRunning;
+
+    int32 RangeSegmentIndex = INDEX_NONE;
+    int32 RangeFirstFrame = INDEX_NONE;
+    int32 RangeLastFrame = INDEX_NONE;
+    int32 RangeFrameCount = 0;
+    int32 LastJournaledFrameCount = 0;
+    double LastRangeFlushTime = 0.0;
+};
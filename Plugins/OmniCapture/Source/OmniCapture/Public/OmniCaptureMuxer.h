@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "OmniCaptureTypes.h"
+#include "OmniCaptureQualityGovernor.h"
 
 class OMNICAPTURE_API FOmniCaptureMuxer
 {
@@ -12,6 +13,8 @@ public:
     void EndRealtimeSession();
     void PushFrame(const FOmniCaptureFrame& Frame);
     FOmniAudioSyncStats GetAudioStats() const { return AudioStats; }
+    /** Quality governor decisions written to the manifest's qualityChanges array. */
+    void SetQualityChanges(const TArray<FOmniCaptureQualityChange>& InChanges) { QualityChanges = InChanges; }
     static FString ResolveFFmpegBinary(const FOmniCaptureSettings& Settings);
     static bool IsFFmpegAvailable(const FOmniCaptureSettings& Settings, FString* OutResolvedPath = nullptr);
 
@@ -19,6 +22,8 @@ private:
     bool WriteManifest(const FOmniCaptureSettings& Settings, const TArray<FOmniCaptureFrameMetadata>& Frames, const FString& AudioPath, const FString& VideoPath, int32 DroppedFrames, FString& OutManifestPath) const;
     bool TryInvokeFFmpeg(const FOmniCaptureSettings& Settings, const TArray<FOmniCaptureFrameMetadata>& Frames, const FString& AudioPath, const FString& VideoPath) const;
     bool WriteSpatialMetadata(const FOmniCaptureSettings& Settings) const;
+    bool WriteTimecodeFile(const TArray<FOmniCaptureFrameMetadata>& Frames, FString& OutTimecodePath) const;
+    bool WriteConcatList(const FOmniCaptureSettings& Settings, const TArray<FOmniCaptureFrameMetadata>& Frames, FString& OutListPath) const;
     FString BuildFFmpegBinaryPath() const;
     double CalculateFrameRate(const TArray<FOmniCaptureFrameMetadata>& Frames) const;
 
@@ -31,4 +36,5 @@ private:
     double LastAudioTimestamp = 0.0;
     double DriftWarningThresholdMs = 25.0;
     bool bRealtimeSessionActive = false;
+    TArray<FOmniCaptureQualityChange> QualityChanges;
 };
@@ -3,6 +3,7 @@
 
 #include "CoreMinimal.h"
 #include "OmniCaptureTypes.h"
+#include "Templates/Atomic.h"
 
 #undef OMNI_WITH_AVENCODER
 
@@ -103,6 +104,9 @@ public:
     bool IsInitialized() const { return bInitialized; }
     FString GetOutputFilePath() const { return OutputFilePath; }
     const FString& GetLastError() const { return LastErrorMessage; }
+    /** Bitstream totals since Initialize; lock-free. */
+    int64 GetEncodedBytes() const { return EncodedBytes.Load(EMemoryOrder::Relaxed); }
+    int32 GetEncodedPacketCount() const { return EncodedPackets.Load(EMemoryOrder::Relaxed); }
 
 private:
     FString OutputFilePath;
@@ -111,6 +115,8 @@ private:
     bool bZeroCopyRequested = true;
     EOmniCaptureCodec RequestedCodec = EOmniCaptureCodec::HEVC;
     FString LastErrorMessage;
+    TAtomic<int64> EncodedBytes{ 0 };
+    TAtomic<int32> EncodedPackets{ 0 };
 
 #if OMNI_WITH_AVENCODER
     TSharedPtr<OmniAVEncoder::FVideoEncoder> VideoEncoder;
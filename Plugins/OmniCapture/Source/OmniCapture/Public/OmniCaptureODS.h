@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OmniCaptureTypes.h"
+
+class FOmniCaptureRemapTable;
+
+/** One eye's ODS views, GetViewCount() images of ViewSize in view index order, stitched into an output image at Offset. */
+struct FOmniCaptureODSStitchTarget
+{
+    TConstArrayView<TArray<FLinearColor>> Views;
+    TArrayView<FLinearColor> Pixels;
+    FIntPoint Offset = FIntPoint::ZeroValue;
+};
+
+/**
+ * Omni-directional stereo slit-scan layout.
+ *
+ * Each eye renders SliceCount narrow vertical slices around the rig, and each slice is split into RowCount pitch
+ * rows so no view has to reach a pole. A slice's cameras sit on the IPD circle, offset sideways from the slice's
+ * viewing direction, which keeps the parallax right all the way round instead of only straight ahead. Every
+ * output column takes the slice whose centre is nearest its longitude, so more slices mean smaller steps between
+ * neighbouring eye positions at the cost of one scene render per slice and row.
+ *
+ * Directions are in rig space: longitude 0 looks down +X and grows toward +Y, latitude grows toward +Z.
+ */
+class OMNICAPTURE_API FOmniCaptureODSLayout
+{
+public:
+    static FOmniCaptureODSLayout Build(const FOmniCaptureSettings& Settings);
+    static FOmniCaptureODSLayout Build(const FIntPoint& EyeSize, float LongitudeSpanRadians, float LatitudeSpanRadians, int32 SliceCount, float InterPupillaryDistanceCm);
+
+    bool IsValid() const { return EyeSize.X > 0 && EyeSize.Y > 0 && SliceCount > 0 && RowCount > 0 && ViewSize.X > 0 && ViewSize.Y > 0; }
+    int32 GetViewCount() const { return SliceCount * RowCount; }
+    int32 GetViewIndex(int32 Slice, int32 Row) const { return Slice * RowCount + Row; }
+    /** Rendered view pixels per eye. */
+    int64 GetRenderedPixelCount() const { return static_cast<int64>(GetViewCount()) * ViewSize.X * ViewSize.Y; }
+
+    double GetSliceYaw(int32 Slice) const;
+    double GetRowPitch(int32 Row) const;
+    /** Horizontal field of view shared by every view, for USceneCaptureComponent2D::FOVAngle. */
+    float GetViewFOVDegrees() const;
+    /** Camera position of Slice in rig space; EyeSign is -1 for the left eye and +1 for the right. */
+    FVector GetViewLocation(int32 Slice, float EyeSign) const;
+    FRotator GetViewRotation(int32 Slice, int32 Row) const;
+
+    /** Slice and row an output direction is stitched from. */
+    void ResolveView(double Longitude, double Latitude, int32& OutSlice, int32& OutRow) const;
+    /** Rig-space direction -> view UV (0..1, origin top-left). */
+    FVector2f ProjectToView(int32 Slice, int32 Row, const FVector& Direction) const;
+    /** View UV -> rig-space direction; the inverse of ProjectToView. */
+    FVector ViewUVToDirection(int32 Slice, int32 Row, const FVector2f& UV) const;
+    /** Direction of an output pixel centre in one eye's equirect. */
+    FVector GetOutputDirection(int32 X, int32 Y, double& OutLongitude, double& OutLatitude) const;
+
+    /** Per-eye stitch table in FOmniCaptureRemapTable form: one (ViewU, ViewV, ViewIndex, 1) tap per output pixel. */
+    TSharedRef<const FOmniCaptureRemapTable> BuildStitchTable() const;
+    /** Returns the last table when the layout has not changed. */
+    TSharedRef<const FOmniCaptureRemapTable> FindOrBuildStitchTable() const;
+    uint32 GetTypeHash() const;
+
+    /** CPU stitch; every target's views are bilinear sampled at the same table taps. */
+    static void StitchCPU(const FOmniCaptureRemapTable& Table, const FIntPoint& ViewSize, TConstArrayView<FOmniCaptureODSStitchTarget> Targets, int32 RowStride);
+
+    FIntPoint EyeSize = FIntPoint::ZeroValue;
+    int32 SliceCount = 0;
+    int32 RowCount = 0;
+    double LongitudeSpan = UE_DOUBLE_TWO_PI;
+    double LatitudeSpan = UE_DOUBLE_PI;
+    float EyeRadiusCm = 0.0f;
+    /** Every view shares one frustum; tangents of its half angles match ViewSize's aspect exactly. */
+    double TanHalfFovX = 0.0;
+    double TanHalfFovY = 0.0;
+    FIntPoint ViewSize = FIntPoint::ZeroValue;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ImagePixelData.h"
+#include "OmniCaptureTypes.h"
+
+/** One RGB10A2 pixel in the DXGI R10G10B10A2 layout: R in bits 0-9, G in 10-19, B in 20-29 and A in 30-31. */
+struct FOmniCapturePackedRGB10A2
+{
+    uint32 Bits = 0;
+
+    bool operator==(const FOmniCapturePackedRGB10A2& Other) const { return Bits == Other.Bits; }
+    bool operator!=(const FOmniCapturePackedRGB10A2& Other) const { return Bits != Other.Bits; }
+};
+
+/** One 32-bit word per pixel; described as four 8-bit channels so FImagePixelData's size checks hold. */
+template<>
+struct TImagePixelDataTraits<FOmniCapturePackedRGB10A2>
+{
+    static const ERGBFormat PixelLayout = ERGBFormat::RGBA;
+    static const EImagePixelType PixelType = EImagePixelType::Color;
+
+    enum { BitDepth = 8, NumChannels = 4 };
+};
+
+/**
+ * Integer packing between the float frames the converter produces and the 10/12/16-bit codes video encoders take.
+ *
+ * Packed frames hold display-encoded values, exactly like the NVENC YUV passes in OmniColorConvertCS, so the image
+ * sequence and hardware paths feed the encoder the same signal. Linear frames go through the sRGB curve, except in
+ * HDR10 where scene-linear BT.709 light is converted to BT.2020 primaries and ST 2084 (PQ) encoded, with 1.0 at
+ * HDR10ReferenceWhiteNits.
+ */
+class OMNICAPTURE_API FOmniCapturePixelPacking
+{
+public:
+    static constexpr float HDR10ReferenceWhiteNits = 100.0f;
+
+    /** Nearest unsigned normalized code of Value at BitDepth (1-16); Value is clamped to [0, 1]. */
+    static uint32 QuantizeUnorm(float Value, int32 BitDepth);
+    static float DequantizeUnorm(uint32 Code, int32 BitDepth);
+
+    static FOmniCapturePackedRGB10A2 PackRGB10A2(const FLinearColor& Color);
+    static FLinearColor UnpackRGB10A2(FOmniCapturePackedRGB10A2 Pixel);
+
+    /** SMPTE ST 2084 (PQ) signal of an absolute luminance; values above 10000 nits clamp. */
+    static float EncodePQ(float Nits);
+
+    /** Packs a converter frame (Color8, LinearColorFloat16 or LinearColorFloat32); null for any other pixel type. */
+    static TUniquePtr<TImagePixelData<FOmniCapturePackedRGB10A2>> PackFrame(const FImagePixelData& PixelData, EOmniCapturePixelDataType PixelDataType, bool bLinear, EOmniCaptureColorSpace ColorSpace);
+
+    /**
+     * Limited-range Y'CbCr 4:2:0 planes at BitDepth (10, 12 or 16) with the OmniColorConvertCS matrices. Chroma
+     * averages each 2x2 block; planes are ceil(Size / 2) wide and high so odd sizes keep their last column and row.
+     */
+    static void ConvertToYUV420(TConstArrayView<FOmniCapturePackedRGB10A2> Pixels, const FIntPoint& Size, EOmniCaptureColorSpace ColorSpace, int32 BitDepth, TArray<uint16>& OutY, TArray<uint16>& OutCb, TArray<uint16>& OutCr);
+};
@@ -7,7 +7,9 @@
 
 class UStaticMeshComponent;
 class UMaterialInstanceDynamic;
+class UTexture;
 class UTexture2D;
+class UTextureRenderTarget2D;
 struct FOmniCaptureEquirectResult;
 
 UCLASS()
@@ -19,10 +21,18 @@ public:
     AOmniCapturePreviewActor();
 
     void Initialize(float InScale, const FIntPoint& InitialResolution);
-    void UpdatePreviewTexture(const FOmniCaptureEquirectResult& Result, const FOmniCaptureSettings& Settings);
+    /**
+     * Box-downsamples the selected view of a converted frame to PreviewMaxWidth. GPU frames are filtered on the GPU into
+     * a render target and return an empty request. CPU-fallback frames return the request the caller fulfils off the
+     * game thread and hands back through UploadPreviewPixels.
+     */
+    FOmniCapturePreviewRequest UpdatePreviewTexture(const FOmniCaptureEquirectResult& Result, const FOmniCaptureSettings& Settings);
+    /** Uploads an already filtered CPU preview on the render thread. Game thread only. */
+    void UploadPreviewPixels(const FIntPoint& TargetSize, TArray<FColor>&& Pixels);
     void SetPreviewEnabled(bool bEnabled);
     void SetPreviewView(EOmniCapturePreviewView InView);
-    UTexture2D* GetPreviewTexture() const { return PreviewTexture; }
+    /** Whichever of the CPU texture and the GPU render target the screen currently shows. */
+    UTexture* GetPreviewTexture() const { return BoundTexture; }
     FIntPoint GetPreviewResolution() const { return PreviewResolution; }
 
 protected:
@@ -30,8 +40,9 @@ protected:
 
 private:
     void EnsureMaterial();
-    void ApplyTexture(UTexture2D* Texture);
+    void ApplyTexture(UTexture* Texture);
     void ResizePreviewTexture(const FIntPoint& Size);
+    void ResizePreviewRenderTarget(const FIntPoint& Size);
     void UpdatePreviewAspectRatio(const FIntPoint& Size);
 
 private:
@@ -44,9 +55,14 @@ private:
     UPROPERTY(Transient)
     UTexture2D* PreviewTexture = nullptr;
 
+    UPROPERTY(Transient)
+    UTextureRenderTarget2D* PreviewRenderTarget = nullptr;
+
+    UPROPERTY(Transient)
+    UTexture* BoundTexture = nullptr;
+
     FName TextureParameterName = TEXT("SpriteTexture");
     float PreviewScale = 1.0f;
     FIntPoint PreviewResolution = FIntPoint::ZeroValue;
     EOmniCapturePreviewView PreviewViewMode = EOmniCapturePreviewView::StereoComposite;
-    TArray<FColor> PreviewScratchBuffer;
 };
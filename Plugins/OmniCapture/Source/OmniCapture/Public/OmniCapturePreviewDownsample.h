@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ImagePixelData.h"
+#include "OmniCaptureTypes.h"
+#include "RendererInterface.h"
+
+class UTextureRenderTarget2D;
+
+/**
+ * Builds the small image the preview shows from a converted frame, so converters never produce a full-size preview
+ * copy and the preview costs nothing on frames that are not shown. GPU frames are filtered on the GPU; CPU-fallback
+ * frames are filtered from their pixels.
+ */
+class OMNICAPTURE_API FOmniCapturePreviewDownsample
+{
+public:
+    /** Most taps averaged along each axis of a box; large reductions sample the box on an even grid instead. */
+    static constexpr int32 MaxTapsPerAxis = 4;
+
+    /** The part of a Size frame the preview view shows: one eye of a stereo frame, or all of it. */
+    static FIntRect GetViewRect(const FIntPoint& Size, const FOmniCaptureSettings& Settings, EOmniCapturePreviewView View);
+
+    /** SourceSize scaled down to at most MaxWidth wide with its aspect kept; never scaled up. */
+    static FIntPoint GetPreviewSize(const FIntPoint& SourceSize, int32 MaxWidth);
+
+    /**
+     * Box-filters SourceRect of a converter frame (Color8, LinearColorFloat16 or LinearColorFloat32) into PreviewSize
+     * sRGB pixels. Float frames are averaged in linear space. Returns false for any other pixel type.
+     */
+    static bool Downsample(const FImagePixelData& PixelData, EOmniCapturePixelDataType PixelDataType, const FIntRect& SourceRect, const FIntPoint& PreviewSize, TArray<FColor>& OutPixels);
+
+    /**
+     * The same box filter on the GPU: SourceRect of a converter's pooled output target is filtered into Target on the
+     * render thread, so GPU frames reach the preview without a readback. Target must be a float render target that
+     * allows UAVs; it receives linear values.
+     */
+    static void EnqueueGPUDownsample(const TRefCountPtr<IPooledRenderTarget>& Source, const FIntRect& SourceRect, UTextureRenderTarget2D* Target);
+};
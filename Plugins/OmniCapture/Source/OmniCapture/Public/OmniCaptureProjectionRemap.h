@@ -0,0 +1,170 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OmniCaptureTypes.h"
+#include "RenderGraphResources.h"
+
+/** Geometry of a projection, resolved from settings once per table build. */
+struct FOmniCaptureProjectionParams
+{
+    EOmniCaptureProjection Projection = EOmniCaptureProjection::Equirectangular;
+    float HorizontalFovRadians = PI * 2.0f;
+    float VerticalFovRadians = PI;
+    float TiltRadians = 0.0f;
+    float AspectRatio = 1.0f;
+    float MirrorRadius = 0.2f;
+    float MirrorOffset = 0.7f;
+    float ProjectorDistance = 0.6f;
+    FIntPoint FoveatedSourceSize = FIntPoint::ZeroValue;
+    float FoveationStartLatitude = 90.0f;
+    int32 FoveationLevels = 0;
+    /** Legacy equirect/fisheye shaping: pole blend strength and the VR180 rear-hemisphere cull. */
+    float PolarStrength = 0.0f;
+    bool bCullRearHemisphere = false;
+    /** Sub-samples per output pixel edge; 1 is a single tap at the pixel centre. Cubemap and foveated layouts always use 1. */
+    int32 SamplesPerAxis = 1;
+
+    static FOmniCaptureProjectionParams FromSettings(const FOmniCaptureSettings& Settings);
+    uint32 GetTypeHash() const;
+};
+
+/** Maps a normalized output UV (0..1, origin top-left) to a view direction. Returns false outside the image circle. */
+using FOmniCaptureInverseMapping = bool (*)(const FVector2D& UV, const FOmniCaptureProjectionParams& Params, FVector& OutDirection);
+
+/**
+ * Per-eye lookup table: TapsPerPixel consecutive float4 taps per output pixel, each (FaceU, FaceV, FaceIndex, Weight).
+ * A pixel is the weighted sum of its bilinear taps; weight 0 marks an unused tap, and single-tap tables store 1.
+ * Immutable once built; the GPU copy is created lazily on the render thread.
+ */
+class OMNICAPTURE_API FOmniCaptureRemapTable
+{
+public:
+    FIntPoint Size = FIntPoint::ZeroValue;
+    int32 FaceResolution = 0;
+    int32 TapsPerPixel = 1;
+    uint32 Key = 0;
+    TArray<FVector4f> Entries;
+
+    /** Output pixels with at least one valid tap. */
+    int32 GetValidCount() const;
+    /** CPU bytes held by Entries; the GPU copy is the same size once created. */
+    int64 GetAllocatedBytes() const;
+
+    /** Render thread only. */
+    FRDGBufferRef RegisterBuffer(FRDGBuilder& GraphBuilder) const;
+
+private:
+    mutable TRefCountPtr<FRDGPooledBuffer> PooledBuffer;
+};
+
+/**
+ * Face texels a projection samples, per cube face. An empty rect means the face is never read.
+ * Each face has its own size (FaceSizes) and its rect is in that face's texels.
+ */
+struct OMNICAPTURE_API FOmniCaptureFaceCoverage
+{
+    int32 FaceResolution = 0;
+    int32 FaceSizes[6] = { 0, 0, 0, 0, 0, 0 };
+    FIntRect Rects[6];
+
+    static FOmniCaptureFaceCoverage Full(int32 FaceResolution);
+
+    bool IsFaceUsed(int32 FaceIndex) const { return Rects[FaceIndex].Area() > 0; }
+    bool IsFaceCropped(int32 FaceIndex) const { return IsFaceUsed(FaceIndex) && Rects[FaceIndex] != FIntRect(0, 0, FaceSizes[FaceIndex], FaceSizes[FaceIndex]); }
+    /** Rendered texels over the texels of six full faces at FaceResolution. */
+    float GetRenderedFraction() const;
+};
+
+/** CPU-side cubemap in the rig's face order (+X, -X, +Y, -Y, +Z, -Z). */
+struct FOmniCaptureCubemapPixels
+{
+    int32 Resolution = 0;
+    /** Per-face sizes when faces differ; 0 means Resolution. */
+    int32 FaceResolutions[6] = { 0, 0, 0, 0, 0, 0 };
+    TArray<FLinearColor> Faces[6];
+
+    int32 GetFaceResolution(int32 FaceIndex) const { return FaceResolutions[FaceIndex] > 0 ? FaceResolutions[FaceIndex] : Resolution; }
+    bool IsValid() const;
+};
+
+/** One cubemap remapped into an output image at Offset. */
+struct FOmniCaptureRemapTarget
+{
+    const FOmniCaptureCubemapPixels* Cubemap = nullptr;
+    TArrayView<FLinearColor> Pixels;
+    FIntPoint Offset = FIntPoint::ZeroValue;
+};
+
+/**
+ * Generic cubemap -> 2D projection remapper.
+ *
+ * Each projection contributes one inverse mapping (output pixel -> direction). Directions are turned
+ * into cube face coordinates once and cached in a remap table, so per-frame work on either backend is
+ * a table fetch plus one bilinear tap, or SamplesPerAxis^2 solid-angle weighted taps when supersampling.
+ */
+class OMNICAPTURE_API FOmniCaptureProjectionRemap
+{
+public:
+    static bool SupportsProjection(EOmniCaptureProjection Projection);
+    static FOmniCaptureInverseMapping GetInverseMapping(EOmniCaptureProjection Projection);
+
+    static bool DirectionFromEquirect(const FVector2D& UV, const FOmniCaptureProjectionParams& Params, FVector& OutDirection);
+    static bool DirectionFromCylindrical(const FVector2D& UV, const FOmniCaptureProjectionParams& Params, FVector& OutDirection);
+    static bool DirectionFromFullDome(const FVector2D& UV, const FOmniCaptureProjectionParams& Params, FVector& OutDirection);
+    static bool DirectionFromSphericalMirror(const FVector2D& UV, const FOmniCaptureProjectionParams& Params, FVector& OutDirection);
+    static bool DirectionFromFisheye(const FVector2D& UV, const FOmniCaptureProjectionParams& Params, FVector& OutDirection);
+    static bool DirectionFromCubemap(const FVector2D& UV, const FOmniCaptureProjectionParams& Params, FVector& OutDirection);
+
+    static bool IsCubemapLayout(EOmniCaptureProjection Projection);
+
+    /** Largest supersampled table BuildTable allocates. The same amount is held again on the GPU. */
+    static constexpr int64 MaxTableBytes = 1024ll * 1024 * 1024;
+    /**
+     * Sub-samples per pixel edge of the table for EyeSize: Params.SamplesPerAxis, lowered until the table fits
+     * MaxTableBytes. Cubemap and foveated layouts always use 1; a single tap is never lowered further.
+     */
+    static int32 GetTableSamplesPerAxis(const FOmniCaptureProjectionParams& Params, const FIntPoint& EyeSize);
+    /**
+     * Resolves a 3x2 atlas UV straight to a face texel without going through a direction.
+     * Cubemap uses the FFmpeg c3x2 order (right, left, up / down, front, back) with no rotation.
+     * EquiAngularCubemap uses the YouTube EAC order (left, front, right / down, back, up) with the
+     * bottom row turned 270, 90 and 270 degrees clockwise and an equi-angular warp inside each face.
+     */
+    static void AtlasToCubeFace(const FVector2D& UV, bool bEquiAngular, int32& OutFaceIndex, FVector2f& OutFaceUV);
+
+    /** Same face selection and seam inset as the equirect shader. */
+    static void DirectionToCubeFace(const FVector& Direction, int32 FaceResolution, float SeamStrength, int32& OutFaceIndex, FVector2f& OutUV);
+    static FVector CubeFaceToDirection(int32 FaceIndex, const FVector2f& UV);
+
+    static TSharedRef<const FOmniCaptureRemapTable> BuildTable(const FOmniCaptureProjectionParams& Params, const FIntPoint& EyeSize, int32 FaceResolution, float SeamStrength);
+    /** Returns a cached table for identical inputs; tables are rebuilt only when settings change. */
+    static TSharedRef<const FOmniCaptureRemapTable> FindOrBuildTable(const FOmniCaptureProjectionParams& Params, const FIntPoint& EyeSize, int32 FaceResolution, float SeamStrength);
+
+    /**
+     * Face size each face needs so one face texel spans no more than one output pixel, using the largest
+     * pixel footprint (the rule GPUs use for mip selection). Scaled by DensityScale and capped at FaceResolution.
+     */
+    static void ComputeFaceResolutions(const FOmniCaptureProjectionParams& Params, const FIntPoint& EyeSize, int32 FaceResolution, float DensityScale, int32 (&OutFaceSizes)[6]);
+
+    /**
+     * Bilinear footprint of every output pixel, plus a small margin, per face. The rig renders only these
+     * rects, so anything outside them is never read by the converter and the output is unchanged.
+     * DensityScale > 0 also sizes each face with ComputeFaceResolutions; otherwise every face is FaceResolution.
+     */
+    static FOmniCaptureFaceCoverage ComputeFaceCoverage(const FOmniCaptureProjectionParams& Params, const FIntPoint& EyeSize, int32 FaceResolution, float SeamStrength, float DensityScale = 0.0f);
+    /** Geometry and per-eye size of the converter path the settings select: remap, legacy equirect or legacy fisheye. */
+    static void GetConverterParams(const FOmniCaptureSettings& Settings, FOmniCaptureProjectionParams& OutParams, FIntPoint& OutEyeSize);
+    static FOmniCaptureFaceCoverage ComputeFaceCoverage(const FOmniCaptureSettings& Settings);
+
+    /** Bilinear tap with clamp addressing inside a face of its own size. */
+    static FLinearColor SampleBilinear(const FOmniCaptureCubemapPixels& Cubemap, int32 FaceIndex, const FVector2f& UV);
+    /** Writes Table.Size pixels into OutPixels starting at Offset with the given row stride. The CPU reference for OmniProjectionRemapCS. */
+    static void RemapCPU(const FOmniCaptureRemapTable& Table, const FOmniCaptureCubemapPixels& Cubemap, TArrayView<FLinearColor> OutPixels, const FIntPoint& Offset, int32 RowStride);
+    /**
+     * RemapCPU for several cubemaps captured by one rig (both stereo eyes, beauty and auxiliary layers) in a single
+     * table walk: each tap's face texels and weights are resolved once and applied to every target.
+     */
+    static void RemapTargetsCPU(const FOmniCaptureRemapTable& Table, TConstArrayView<FOmniCaptureRemapTarget> Targets, int32 RowStride);
+    /** RemapTargetsCPU with every layer at the same offset. OutPixels[i] receives Cubemaps[i]. */
+    static void RemapLayersCPU(const FOmniCaptureRemapTable& Table, TConstArrayView<const FOmniCaptureCubemapPixels*> Cubemaps, TConstArrayView<TArrayView<FLinearColor>> OutPixels, const FIntPoint& Offset, int32 RowStride);
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OmniCaptureTelemetry.h"
+#include "OmniCaptureTypes.h"
+
+/** Quality knobs in the order the governor gives them up; restored in reverse. */
+enum class EOmniCaptureQualityKnob : uint8
+{
+    PNGCompression,
+    AuxiliaryPassRate,
+    PreviewRate,
+    RemapSampling,
+    FaceResolution,
+    Count
+};
+
+OMNICAPTURE_API const TCHAR* LexToString(EOmniCaptureQualityKnob Knob);
+
+/** What the capture should currently apply; the values at level 0 are the capture settings. */
+struct OMNICAPTURE_API FOmniCaptureQualityState
+{
+    /** Knobs currently stepped down. */
+    int32 Level = 0;
+    /** zlib level for PNG frames; -1 leaves the writer's default. */
+    int32 PNGCompressionLevel = -1;
+    /** Auxiliary passes render on every Nth frame. */
+    int32 AuxiliaryPassInterval = 1;
+    float PreviewRateScale = 1.0f;
+    EOmniCaptureRemapQuality RemapQuality = EOmniCaptureRemapQuality::Standard;
+    /** Cube face render scale; the output size never changes. */
+    float FaceResolutionScale = 1.0f;
+};
+
+/** One governor decision, kept for the manifest. */
+struct OMNICAPTURE_API FOmniCaptureQualityChange
+{
+    double CaptureSeconds = 0.0;
+    int32 FrameIndex = 0;
+    EOmniCaptureQualityKnob Knob = EOmniCaptureQualityKnob::PNGCompression;
+    /** True when the knob was stepped down, false when it was restored. */
+    bool bDegraded = true;
+    /** Governor level after the change. */
+    int32 Level = 0;
+    FString Reason;
+};
+
+/**
+ * Trades quality for throughput when the pipeline falls behind, instead of letting the ring buffer drop frames.
+ *
+ * Each telemetry snapshot is classified as overloaded (ring buffer filling, writer backlog at its task limit, frames
+ * dropped, or the game-thread stages over the frame budget) or as having headroom. Sustained overload steps the next
+ * applicable knob down; a longer run of headroom restores the most recently degraded one. Knobs that do not apply to
+ * the capture (PNG compression for EXR output, say) are skipped. Offline captures never need it: the world waits.
+ */
+class OMNICAPTURE_API FOmniCaptureQualityGovernor
+{
+public:
+    /** Consecutive overloaded snapshots before a knob is stepped down. */
+    static constexpr int32 OverloadedSnapshotsToDegrade = 2;
+    /** Consecutive snapshots with headroom before a knob is restored. */
+    static constexpr int32 HeadroomSnapshotsToRestore = 8;
+
+    enum class EPressure : uint8
+    {
+        Headroom,
+        Steady,
+        Overloaded
+    };
+
+    void Initialize(const FOmniCaptureSettings& Settings);
+    void Reset();
+
+    bool IsEnabled() const { return bEnabled; }
+    int32 GetKnobCount() const { return Knobs.Num(); }
+
+    /** Feeds one telemetry snapshot; returns true when the state changed. */
+    bool Update(const FOmniCaptureTelemetrySnapshot& Snapshot, int32 FrameIndex);
+    EPressure Classify(const FOmniCaptureTelemetrySnapshot& Snapshot, FString* OutReason = nullptr) const;
+
+    const FOmniCaptureQualityState& GetState() const { return State; }
+    const FOmniCaptureQualityState& GetBaselineState() const { return BaselineState; }
+    const TArray<FOmniCaptureQualityChange>& GetChanges() const { return Changes; }
+
+private:
+    FOmniCaptureQualityState MakeState(int32 Level) const;
+
+    bool bEnabled = false;
+    TArray<EOmniCaptureQualityKnob> Knobs;
+    FOmniCaptureQualityState BaselineState;
+    FOmniCaptureQualityState State;
+    TArray<FOmniCaptureQualityChange> Changes;
+
+    double FrameBudgetMilliseconds = 0.0;
+    int32 WriterTaskLimit = 0;
+    float MinFaceResolutionScale = 0.75f;
+    int32 LastDroppedFrames = 0;
+    int32 OverloadedSnapshots = 0;
+    int32 HeadroomSnapshots = 0;
+};
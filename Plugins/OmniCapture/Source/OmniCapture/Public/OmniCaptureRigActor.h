@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "OmniCaptureODS.h"
 #include "OmniCaptureTypes.h"
 #include "OmniCaptureRigActor.generated.h"
 
@@ -27,6 +28,15 @@ struct FOmniCaptureFaceResources
     UPROPERTY()
     TMap<EOmniCaptureAuxiliaryPassType, UTextureRenderTarget2D*> AuxiliaryTargets;
 
+    /** Face texels held by RenderTarget (and the auxiliary targets). Empty means the whole face. */
+    FIntRect ValidRect;
+
+    /** False when the projection never samples this face and the rig skipped its capture. */
+    bool bRendered = true;
+
+    /** Edge length of the full face in texels; ValidRect is in these texels. 0 means Settings.Resolution. */
+    int32 FaceSize = 0;
+
     UTextureRenderTarget2D* GetAuxiliaryRenderTarget(EOmniCaptureAuxiliaryPassType PassType) const
     {
         if (const UTextureRenderTarget2D* const* FoundTarget = AuxiliaryTargets.Find(PassType))
@@ -51,9 +61,16 @@ struct FOmniEyeCapture
     FOmniCaptureFaceResources Faces[6];
     int32 ActiveFaceCount = 0;
 
+    /** Slit views in FOmniCaptureODSLayout view order when the rig renders omni-directional stereo; the faces are unused then. */
+    TArray<UTextureRenderTarget2D*> ODSViews;
+
     UTextureRenderTarget2D* GetPrimaryRenderTarget() const
     {
-        return ActiveFaceCount > 0 ? Faces[0].RenderTarget : nullptr;
+        if (ActiveFaceCount > 0)
+        {
+            return Faces[0].RenderTarget;
+        }
+        return ODSViews.Num() > 0 ? ODSViews[0] : nullptr;
     }
 };
 
@@ -66,17 +83,27 @@ public:
     AOmniCaptureRigActor();
 
     void Configure(const FOmniCaptureSettings& InSettings);
-    void Capture(FOmniEyeCapture& OutLeftEye, FOmniEyeCapture& OutRightEye) const;
+    /** Renders both eyes; the auxiliary passes are skipped (and left out of the eye captures) when bCaptureAuxiliary is false. */
+    void Capture(FOmniEyeCapture& OutLeftEye, FOmniEyeCapture& OutRightEye, bool bCaptureAuxiliary = true) const;
     void UpdateStereoParameters(float NewIPDCm, float NewConvergenceDistanceCm);
+    /** Renders cube faces at Scale (0-1] of their configured size by resizing the face targets in place. Returns false for rigs without cube faces. */
+    bool SetFaceResolutionScale(float Scale);
 
     FORCEINLINE const FTransform& GetRigTransform() const { return RigRoot->GetComponentTransform(); }
+    /** Pixels rendered by the last Capture() across both eyes and all auxiliary passes. */
+    FORCEINLINE int64 GetLastCapturedPixelCount() const { return LastCapturedPixels; }
 
 private:
     void BuildEyeRig(EOmniCaptureEye Eye, float IPDHalfCm, int32 FaceCount);
+    void BuildODSEyeRig(EOmniCaptureEye Eye);
+    void UpdateODSViewTransforms();
+    void UpdateFaceCaptureRects();
+    FIntPoint GetFaceTargetSize(int32 FaceIndex) const;
+    void ApplyFaceCrop(USceneCaptureComponent2D* CaptureComponent, int32 FaceIndex) const;
     void ConfigureCaptureComponent(USceneCaptureComponent2D* CaptureComponent, const FIntPoint& TargetSize) const;
     USceneCaptureComponent2D* CreateAuxiliaryCaptureComponent(const FString& ComponentName, EOmniCaptureAuxiliaryPassType PassType, const FIntPoint& TargetSize) const;
-    void ConfigureAuxiliaryTargets(EOmniCaptureEye Eye, int32 FaceCount, const FIntPoint& TargetSize);
-    void CaptureEye(EOmniCaptureEye Eye, FOmniEyeCapture& OutCapture) const;
+    void ConfigureAuxiliaryTargets(EOmniCaptureEye Eye, int32 FaceCount);
+    void CaptureEye(EOmniCaptureEye Eye, FOmniEyeCapture& OutCapture, bool bCaptureAuxiliary) const;
     void ApplyStereoParameters();
     void UpdateEyeRootTransform(USceneComponent* EyeRoot, float LateralOffset, EOmniCaptureEye Eye) const;
 
@@ -108,5 +135,19 @@ private:
     TArray<UTextureRenderTarget2D*> RenderTargets;
 
     FOmniCaptureSettings CachedSettings;
+
+    /** Per-face render region from the projection's coverage; empty rects are skipped faces. */
+    FIntRect FaceCaptureRects[6];
+
+    /** Per-face edge length in texels; below Resolution when bAdaptiveFaceResolution shrinks a face. */
+    int32 FaceSizes[6] = { 0, 0, 0, 0, 0, 0 };
+
+    /** Applied on top of the coverage face sizes by SetFaceResolutionScale. */
+    float FaceResolutionScale = 1.0f;
+
+    /** Slice layout when CachedSettings.UsesOmniDirectionalStereo(); the eye captures then hold one component per view. */
+    FOmniCaptureODSLayout ODSLayout;
+
+    mutable int64 LastCapturedPixels = 0;
 };
 
@@ -12,7 +12,11 @@ public:
     FOmniCaptureRingBuffer();
     ~FOmniCaptureRingBuffer();
 
-    void Initialize(const FOmniCaptureSettings& Settings, const TFunction<void(TUniquePtr<FOmniCaptureFrame>&&)>& InConsumer);
+    /**
+     * Starts the consumer thread. OnDropped, when set, receives the metadata of each frame the DropOldest policy
+     * discards, duplicates included; it runs on the thread that called Enqueue.
+     */
+    void Initialize(const FOmniCaptureSettings& Settings, const TFunction<void(TUniquePtr<FOmniCaptureFrame>&&)>& InConsumer, const TFunction<void(const FOmniCaptureFrameMetadata&)>& InOnDropped = nullptr);
     void Enqueue(TUniquePtr<FOmniCaptureFrame>&& Frame);
     void Flush();
     FOmniCaptureRingBufferStats GetStats() const;
@@ -23,6 +27,7 @@ private:
 
     TQueue<TUniquePtr<FOmniCaptureFrame>, EQueueMode::Mpsc> Queue;
     TFunction<void(TUniquePtr<FOmniCaptureFrame>&&)> Consumer;
+    TFunction<void(const FOmniCaptureFrameMetadata&)> OnDropped;
 
     TUniquePtr<FRunnableThread> WorkerThread;
     FOmniCaptureRingBufferWorker* Worker = nullptr;
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+/** Pipeline stages timed per frame. Each stage's time is exclusive of any stage nested inside it. */
+enum class EOmniCaptureStage : uint8
+{
+    RigCapture,
+    RenderFlush,
+    Conversion,
+    AuxiliaryPasses,
+    Enqueue,
+    Preview,
+    WriterEncode,
+    FileWrite,
+    EncoderSubmit,
+    Mux,
+    Count
+};
+
+OMNICAPTURE_API const TCHAR* LexToString(EOmniCaptureStage Stage);
+
+/** Enable with -trace=cpu,OmniCapture to see the pipeline stages in Unreal Insights. */
+UE_TRACE_CHANNEL_EXTERN(OmniCaptureChannel, OMNICAPTURE_API);
+
+DECLARE_STATS_GROUP(TEXT("OmniCapture"), STATGROUP_OmniCapture, STATCAT_Advanced);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Rig Capture"), STAT_OmniCapture_RigCapture, STATGROUP_OmniCapture, OMNICAPTURE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Render Flush"), STAT_OmniCapture_RenderFlush, STATGROUP_OmniCapture, OMNICAPTURE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Conversion"), STAT_OmniCapture_Conversion, STATGROUP_OmniCapture, OMNICAPTURE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Auxiliary Passes"), STAT_OmniCapture_AuxiliaryPasses, STATGROUP_OmniCapture, OMNICAPTURE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enqueue"), STAT_OmniCapture_Enqueue, STATGROUP_OmniCapture, OMNICAPTURE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Preview"), STAT_OmniCapture_Preview, STATGROUP_OmniCapture, OMNICAPTURE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Writer Encode"), STAT_OmniCapture_WriterEncode, STATGROUP_OmniCapture, OMNICAPTURE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("File Write"), STAT_OmniCapture_FileWrite, STATGROUP_OmniCapture, OMNICAPTURE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Encoder Submit"), STAT_OmniCapture_EncoderSubmit, STATGROUP_OmniCapture, OMNICAPTURE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Mux"), STAT_OmniCapture_Mux, STATGROUP_OmniCapture, OMNICAPTURE_API);
+
+/** Milliseconds spent in each stage for one frame, or for the whole session when FrameIndex is INDEX_NONE. */
+struct OMNICAPTURE_API FOmniCaptureFrameStageTimings
+{
+    int32 FrameIndex = INDEX_NONE;
+    double Milliseconds[static_cast<int32>(EOmniCaptureStage::Count)] = {};
+
+    double& operator[](EOmniCaptureStage Stage) { return Milliseconds[static_cast<int32>(Stage)]; }
+    double operator[](EOmniCaptureStage Stage) const { return Milliseconds[static_cast<int32>(Stage)]; }
+
+    void Accumulate(const FOmniCaptureFrameStageTimings& Other);
+    double GetTotalMilliseconds() const;
+    bool IsEmpty() const;
+};
+
+/**
+ * Times one stage on the calling thread.
+ *
+ * Elapsed time goes into a per-thread accumulator and is subtracted from the enclosing scope, so a nested stage (a
+ * file write inside an encode) is never counted twice. Whoever owns the thread's unit of work resets the accumulator
+ * before it and takes the totals after it. Work the game thread waits on, such as GPU conversion, counts as wall time.
+ */
+class OMNICAPTURE_API FOmniCaptureStageScope
+{
+public:
+    explicit FOmniCaptureStageScope(EOmniCaptureStage InStage);
+    ~FOmniCaptureStageScope();
+
+    static void ResetThreadTimings();
+    static FOmniCaptureFrameStageTimings TakeThreadTimings(int32 FrameIndex);
+
+private:
+    EOmniCaptureStage Stage;
+    uint64 StartCycles;
+    FOmniCaptureStageScope* Parent;
+};
+
+/** Cycle stat, Insights event on OmniCaptureChannel and per-frame timing for the rest of the enclosing block. */
+#define OMNICAPTURE_STAGE_SCOPE(Stage) \
+    SCOPE_CYCLE_COUNTER(STAT_OmniCapture_##Stage); \
+    TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("OmniCapture::" #Stage, OmniCaptureChannel); \
+    FOmniCaptureStageScope PREPROCESSOR_JOIN(OmniCaptureStageScope_, __LINE__)(EOmniCaptureStage::Stage)
+
+/**
+ * Rolling per-frame stage timings, filled from the game thread, the ring buffer worker and the writer tasks.
+ *
+ * Records for the same frame merge into one entry, so writer stages that finish frames later land next to the
+ * capture stages. The newest Capacity frames are kept.
+ */
+class OMNICAPTURE_API FOmniCaptureStageTimingHistory
+{
+public:
+    static constexpr int32 Capacity = 256;
+
+    void Reset();
+    void Record(const FOmniCaptureFrameStageTimings& Timings);
+
+    /** Up to MaxFrames of the newest frames, oldest first. */
+    TArray<FOmniCaptureFrameStageTimings> GetRecent(int32 MaxFrames) const;
+    /** Per-stage mean over the newest MaxFrames, counting only frames in which the stage ran. */
+    FOmniCaptureFrameStageTimings GetAverage(int32 MaxFrames) const;
+    /** Stages that belong to the whole capture rather than a frame, such as muxing. */
+    FOmniCaptureFrameStageTimings GetSessionTimings() const;
+
+private:
+    mutable FCriticalSection CriticalSection;
+    TArray<FOmniCaptureFrameStageTimings> Frames;
+    FOmniCaptureFrameStageTimings SessionTimings;
+    int32 NewestFrameIndex = INDEX_NONE;
+};
@@ -7,6 +7,13 @@
 #include "OmniCaptureAudioRecorder.h"
 #include "OmniCaptureNVENCEncoder.h"
 #include "OmniCaptureMuxer.h"
+#include "OmniCaptureFrameIndex.h"
+#include "OmniCaptureJournal.h"
+#include "OmniCaptureFramePacer.h"
+#include "OmniCaptureStageTimings.h"
+#include "OmniCaptureTelemetry.h"
+#include "OmniCaptureDiagnosticLog.h"
+#include "OmniCaptureQualityGovernor.h"
 #include "Templates/Atomic.h"
 #include "Logging/LogVerbosity.h"
 #include "OmniCaptureOptional.h"
@@ -15,7 +22,7 @@
 class AOmniCaptureRigActor;
 class AOmniCaptureDirectorActor;
 class AOmniCapturePreviewActor;
-class UTexture2D;
+class UTexture;
 class IConsoleVariable;
 
 struct FOmniCaptureSegmentRecord
@@ -84,8 +91,28 @@ public:
     UFUNCTION(BlueprintCallable, Category = "OmniCapture")
     double GetCurrentFrameRate() const { return CurrentCaptureFPS; }
 
+    /** Megapixels the rig rendered for the last captured frame, across both eyes and auxiliary passes. */
     UFUNCTION(BlueprintCallable, Category = "OmniCapture")
-    UTexture2D* GetPreviewTexture() const;
+    double GetRenderedMegapixelsPerFrame() const { return RenderedMegapixelsPerFrame; }
+
+    /** Frames rendered per wall-clock second since capture started; an offline capture's speed relative to realtime. */
+    UFUNCTION(BlueprintCallable, Category = "OmniCapture")
+    double GetCaptureThroughput() const;
+
+    /** Per-stage timings of up to MaxFrames of the newest frames, oldest first. */
+    TArray<FOmniCaptureFrameStageTimings> GetRecentStageTimings(int32 MaxFrames = 120) const { return StageTimingHistory.GetRecent(MaxFrames); }
+    /** Per-stage mean over the newest MaxFrames. */
+    FOmniCaptureFrameStageTimings GetAverageStageTimings(int32 MaxFrames = 120) const { return StageTimingHistory.GetAverage(MaxFrames); }
+    /** Stages that run once per capture, such as the final mux. */
+    FOmniCaptureFrameStageTimings GetSessionStageTimings() const { return StageTimingHistory.GetSessionTimings(); }
+    /** Newest capture health snapshot, published every TelemetryIntervalSeconds; lock-free and safe from any thread. */
+    FOmniCaptureTelemetrySnapshot GetTelemetrySnapshot() const { return Telemetry.GetSnapshot(); }
+    /** Quality the capture currently runs at; level 0 unless bEnableQualityGovernor has stepped knobs down. */
+    const FOmniCaptureQualityState& GetQualityState() const { return QualityGovernor.GetState(); }
+
+    /** The texture the preview screen shows: a render target for GPU-converted frames, a CPU-filled texture otherwise. */
+    UFUNCTION(BlueprintCallable, Category = "OmniCapture")
+    UTexture* GetPreviewTexture() const;
 
     UFUNCTION(BlueprintCallable, Category = "OmniCapture")
     bool HasFinalizedOutput() const { return !LastFinalizedOutput.IsEmpty(); }
@@ -102,12 +129,29 @@ public:
     UFUNCTION(BlueprintCallable, Category = "OmniCapture|Diagnostics")
     void GetCaptureDiagnosticLog(TArray<FOmniCaptureDiagnosticEntry>& OutEntries) const;
 
+    /** Entries newer than Sequence, oldest first; returns the newest sequence so callers can poll incrementally. */
+    UFUNCTION(BlueprintCallable, Category = "OmniCapture|Diagnostics")
+    int64 GetDiagnosticsSince(int64 Sequence, TArray<FOmniCaptureDiagnosticEntry>& OutEntries) const;
+
+    /** Spills the retained diagnostics to the log file and empties the list; BeginCapture does this too. */
     UFUNCTION(BlueprintCallable, Category = "OmniCapture|Diagnostics")
     void ClearCaptureDiagnosticLog();
 
+    /** Changes whenever the diagnostic log is cleared; callers holding copies of the entries should drop them. */
+    UFUNCTION(BlueprintCallable, Category = "OmniCapture|Diagnostics")
+    int32 GetDiagnosticResetGeneration() const;
+
     UFUNCTION(BlueprintCallable, Category = "OmniCapture|Diagnostics")
     FString GetLastErrorMessage() const { return LastErrorMessage; }
 
+    /** Journals left by captures that never reached EndCapture (e.g. an editor crash). */
+    UFUNCTION(BlueprintCallable, Category = "OmniCapture|Recovery")
+    void GetUnfinishedCaptures(TArray<FString>& OutJournalPaths) const;
+
+    /** Muxes unfinished captures from the files already on disk without re-rendering. */
+    UFUNCTION(BlueprintCallable, Category = "OmniCapture|Recovery")
+    int32 ResumeUnfinishedCaptures(TArray<FString>& OutFinalizedFiles);
+
     void SetPendingRigTransform(const FTransform& InTransform);
 
 private:
@@ -130,17 +174,29 @@ private:
     void ShutdownAudioRecording();
 
     void TickCapture(float DeltaTime);
-    void CaptureFrame();
+    void CaptureFrame(const FOmniCaptureFramePacingStep& PacingStep);
+    void AddDuplicateFrames(FOmniCaptureFrame& Source, int32 FirstFrameIndex, const FOmniCaptureFramePacingStep& PacingStep);
+    /** Filters a frame's CPU preview on the ring buffer worker and posts the result to the preview actor. */
+    void FulfilPreviewRequest(FOmniCaptureFrame& Frame);
+    TArray<FString> BuildDuplicateFileNames(const FOmniCaptureFrame& Frame) const;
     void FlushRingBuffer();
+    void RecordStageTimings(const FOmniCaptureFrameStageTimings& Timings);
+    void PublishTelemetry(bool bForce);
+    void ApplyQualityState(const FOmniCaptureQualityState& QualityState);
     void UpdateDynamicStereoParameters();
     void ApplyRenderFeatureOverrides();
     void RestoreRenderFeatureOverrides();
+    void ApplyFixedTimestep();
+    void RestoreFixedTimestep();
 
-    void HandleDroppedFrame();
+    /** Records a frame that never reached the writers: its index and timecode go to the frame index sidecar. */
+    void HandleDroppedFrame(int32 FrameIndex, double Timecode);
+    double GetFrameTimecode(const FOmniCaptureFramePacingStep& PacingStep) const;
 
     void ConfigureActiveSegment();
     void RotateSegmentIfNeeded();
     void CompleteActiveSegment(bool bStoreResults);
+    void JournalActiveSegmentOpened();
     int64 CalculateActiveSegmentSizeBytes() const;
     void UpdateRuntimeWarnings();
     void AddWarningUnique(const FString& Warning);
@@ -187,6 +243,7 @@ private:
     double LastPreviewUpdateTime = 0.0;
     double PreviewFrameInterval = 0.0;
     double CurrentCaptureFPS = 0.0;
+    double RenderedMegapixelsPerFrame = 0.0;
     double LastFpsSampleTime = 0.0;
     int32 FramesSinceLastFpsSample = 0;
     double LastRuntimeWarningCheckTime = 0.0;
@@ -206,6 +263,13 @@ private:
     TUniquePtr<FOmniCaptureAudioRecorder> AudioRecorder;
     TUniquePtr<FOmniCaptureNVENCEncoder> NVENCEncoder;
     TUniquePtr<FOmniCaptureMuxer> OutputMuxer;
+    TUniquePtr<FOmniCaptureFrameIndexWriter> FrameIndexWriter;
+    TUniquePtr<FOmniCaptureJournal> CaptureJournal;
+    FOmniCaptureFramePacer FramePacer;
+    FOmniCaptureStageTimingHistory StageTimingHistory;
+    FOmniCaptureTelemetry Telemetry;
+    double LastTelemetryPublishTime = 0.0;
+    FOmniCaptureQualityGovernor QualityGovernor;
 
     TAtomic<bool> bUsingNVENCImageFallback{ false };
     bool bCapturedImageSequenceThisSegment = false;
@@ -232,8 +296,11 @@ private:
 
     TArray<FConsoleVariableOverrideRecord> ConsoleOverrideRecords;
     bool bRenderOverridesApplied = false;
+    bool bFixedTimestepApplied = false;
+    bool bPreviousUseFixedTimeStep = false;
+    double PreviousFixedDeltaTime = 0.0;
 
-    TArray<FOmniCaptureDiagnosticEntry> DiagnosticLog;
+    FOmniCaptureDiagnosticLog DiagnosticLog;
     FString CurrentDiagnosticStep;
     FString LastErrorMessage;
 };
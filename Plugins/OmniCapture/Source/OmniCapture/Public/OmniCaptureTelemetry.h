@@ -0,0 +1,106 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OmniCaptureStageTimings.h"
+#include "Templates/Atomic.h"
+
+class FArchive;
+
+/** One consistent reading of the capture's health, published a few times a second. */
+struct OMNICAPTURE_API FOmniCaptureTelemetrySnapshot
+{
+    /** Increments with every publish; 0 means nothing has been published yet. */
+    uint64 PublishIndex = 0;
+    double CaptureSeconds = 0.0;
+
+    int32 FramesCaptured = 0;
+    int32 DroppedFrames = 0;
+    double CaptureFramesPerSecond = 0.0;
+
+    int32 RingBufferPending = 0;
+    int32 RingBufferCapacity = 0;
+    int32 RingBufferBlockedPushes = 0;
+    /** Frames handed to the image writer whose files are not written yet. */
+    int32 WriterPendingFrames = 0;
+
+    /** Mean time per stage over the frames recorded since the previous snapshot; 0 for stages that did not run. */
+    double StageMilliseconds[static_cast<int32>(EOmniCaptureStage::Count)] = {};
+
+    int64 BytesWritten = 0;
+    double BytesWrittenPerSecond = 0.0;
+    int64 EncodedBytes = 0;
+    int32 EncodedPackets = 0;
+    double EncodedBytesPerSecond = 0.0;
+    double EncodedPacketsPerSecond = 0.0;
+
+    double AudioDriftMilliseconds = 0.0;
+    double MaxAudioDriftMilliseconds = 0.0;
+    int32 AudioPendingPackets = 0;
+
+    /** Pixel data queued in the ring buffer and the image writer, estimated from the newest frame's size. */
+    int64 MemoryInFlightBytes = 0;
+
+    double operator[](EOmniCaptureStage Stage) const { return StageMilliseconds[static_cast<int32>(Stage)]; }
+};
+
+/**
+ * Lock-free capture health counters with sequence-locked snapshots.
+ *
+ * Pipeline threads only touch relaxed atomics. One publishing thread (the game thread during capture) periodically
+ * folds the counters and the gauges it samples into a snapshot, derives rates from the change since the previous
+ * publish, and optionally appends it as a CSV row. Readers on any thread get the newest snapshot from GetSnapshot
+ * without taking a lock; a read that overlaps a publish simply retries.
+ */
+class OMNICAPTURE_API FOmniCaptureTelemetry
+{
+public:
+    FOmniCaptureTelemetry();
+    ~FOmniCaptureTelemetry();
+
+    /** Clears counters and the published snapshot. Not safe while other threads are still recording. */
+    void Reset();
+
+    void RecordFrameCaptured(int64 FrameBytes);
+    void RecordStageTimings(const FOmniCaptureFrameStageTimings& Timings);
+    void RecordBytesWritten(int64 Bytes);
+    void RecordAudioSync(double DriftMilliseconds, double MaxDriftMilliseconds, int32 PendingPackets);
+
+    /**
+     * Publishing thread only. Gauges carries the values the caller sampled (queue depths, drops, encoder totals);
+     * the counters, rates and memory estimate are filled in here.
+     */
+    void Publish(double CaptureSeconds, const FOmniCaptureTelemetrySnapshot& Gauges);
+
+    /** The newest published snapshot; safe from any thread. */
+    FOmniCaptureTelemetrySnapshot GetSnapshot() const;
+
+    /** Publishing thread only. Every later publish appends a row until CloseCsv. */
+    bool OpenCsv(const FString& FilePath);
+    void CloseCsv();
+    bool IsCsvOpen() const { return CsvArchive.IsValid(); }
+
+    static FString GetCsvHeader();
+    static FString FormatCsvRow(const FOmniCaptureTelemetrySnapshot& Snapshot);
+
+private:
+    static constexpr int32 StageCount = static_cast<int32>(EOmniCaptureStage::Count);
+
+    TAtomic<int32> FramesCaptured;
+    TAtomic<int64> LastFrameBytes;
+    TAtomic<int64> BytesWritten;
+    TAtomic<int64> StageMicroseconds[StageCount];
+    TAtomic<int32> StageSamples[StageCount];
+    TAtomic<double> AudioDriftMilliseconds;
+    TAtomic<double> MaxAudioDriftMilliseconds;
+    TAtomic<int32> AudioPendingPackets;
+
+    /** Odd while a publish is writing Published. */
+    TAtomic<uint32> Sequence;
+    FOmniCaptureTelemetrySnapshot Published;
+
+    // Publishing thread state.
+    FOmniCaptureTelemetrySnapshot Previous;
+    int64 PreviousStageMicroseconds[StageCount] = {};
+    int32 PreviousStageSamples[StageCount] = {};
+    TUniquePtr<FArchive> CsvArchive;
+};
@@ -7,6 +7,7 @@
 #include "ImagePixelData.h"
 #include "RenderGraphResources.h"
 #include "Misc/DateTime.h"
+#include "UObject/WeakObjectPtrTemplates.h"
 #include "OmniCaptureTypes.generated.h"
 
 namespace OmniCapture
@@ -22,6 +23,7 @@ namespace OmniCapture
 }
 
 class UCurveFloat;
+class AOmniCapturePreviewActor;
 
 UENUM(BlueprintType)
 enum class EOmniCaptureMode : uint8 { Mono, Stereo };
@@ -34,7 +36,10 @@ enum class EOmniCaptureProjection : uint8
         Planar2D,
         Cylindrical,
         FullDome,
-        SphericalMirror
+        SphericalMirror,
+        Cubemap,
+        EquiAngularCubemap,
+        FoveatedEquirectangular
 };
 
 UENUM(BlueprintType)
@@ -47,6 +52,14 @@ enum class EOmniCaptureFisheyeType : uint8
 UENUM(BlueprintType)
 enum class EOmniCaptureCoverage : uint8 { FullSphere, HalfSphere };
 
+UENUM(BlueprintType)
+enum class EOmniCaptureRemapQuality : uint8
+{
+        Standard UMETA(DisplayName = "Standard (1 tap)"),
+        High UMETA(DisplayName = "High (2x2 supersampled)"),
+        Ultra UMETA(DisplayName = "Ultra (3x3 supersampled)")
+};
+
 UENUM(BlueprintType)
 enum class EOmniCaptureStereoLayout : uint8 { TopBottom, SideBySide };
 
@@ -59,7 +72,16 @@ enum class EOmniOutputFormat : uint8
 };
 
 UENUM(BlueprintType)
-enum class EOmniCaptureImageFormat : uint8 { PNG, JPG, EXR, BMP };
+enum class EOmniCaptureFramePacing : uint8
+{
+        EveryTick UMETA(DisplayName = "Every Tick"),
+        Decimate UMETA(DisplayName = "Decimate (skip missed frames)"),
+        DecimateAndDuplicate UMETA(DisplayName = "Decimate (duplicate missed frames)"),
+        FixedTimestep UMETA(DisplayName = "Offline (fixed timestep)")
+};
+
+UENUM(BlueprintType)
+enum class EOmniCaptureImageFormat : uint8 { PNG, JPG, EXR, BMP, Y4M UMETA(DisplayName = "Y4M 10-bit Stream") };
 
 UENUM(BlueprintType)
 enum class EOmniCaptureEXRCompression : uint8
@@ -94,7 +116,8 @@ enum class EOmniCapturePixelDataType : uint8
     LinearColorFloat16,
     Color8,
     ScalarFloat32,
-    Vector2Float32
+    Vector2Float32,
+    PackedRGB10A2
 };
 
 UENUM(BlueprintType)
@@ -177,6 +200,10 @@ struct OMNICAPTURE_API FOmniCaptureDiagnosticEntry
 {
         GENERATED_BODY()
 
+        /** Monotonically increasing per subsystem; see UOmniCaptureSubsystem::GetDiagnosticsSince. */
+        UPROPERTY(BlueprintReadOnly, Category = "Diagnostics")
+        int64 Sequence = 0;
+
         UPROPERTY(BlueprintReadOnly, Category = "Diagnostics")
         FDateTime Timestamp;
 
@@ -236,7 +263,17 @@ struct OMNICAPTURE_API FOmniCaptureSettings
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Fisheye", meta = (ClampMin = 90.0, ClampMax = 360.0, UIMin = 90.0, UIMax = 360.0, EditCondition = "Projection == EOmniCaptureProjection::Fisheye")) float FisheyeFOV = 180.0f;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Fisheye", meta = (ClampMin = 256, UIMin = 256, EditCondition = "Projection == EOmniCaptureProjection::Fisheye")) FIntPoint FisheyeResolution = FIntPoint(4096, 4096);
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Fisheye", meta = (EditCondition = "Projection == EOmniCaptureProjection::Fisheye")) bool bFisheyeConvertToEquirect = false;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Cylindrical", meta = (ClampMin = 10.0, ClampMax = 170.0, UIMin = 10.0, UIMax = 170.0, EditCondition = "Projection == EOmniCaptureProjection::Cylindrical")) float CylindricalVerticalFOV = 120.0f;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|FullDome", meta = (ClampMin = 90.0, ClampMax = 360.0, UIMin = 90.0, UIMax = 360.0, EditCondition = "Projection == EOmniCaptureProjection::FullDome")) float FullDomeFOV = 180.0f;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|FullDome", meta = (ClampMin = -90.0, ClampMax = 90.0, UIMin = -90.0, UIMax = 90.0, EditCondition = "Projection == EOmniCaptureProjection::FullDome")) float FullDomeTilt = 0.0f;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|SphericalMirror", meta = (ClampMin = 0.05, ClampMax = 0.5, EditCondition = "Projection == EOmniCaptureProjection::SphericalMirror")) float MirrorRadius = 0.2f;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|SphericalMirror", meta = (ClampMin = 0.1, ClampMax = 0.95, EditCondition = "Projection == EOmniCaptureProjection::SphericalMirror")) float MirrorOffset = 0.7f;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|SphericalMirror", meta = (ClampMin = 0.1, ClampMax = 2.0, EditCondition = "Projection == EOmniCaptureProjection::SphericalMirror")) float MirrorProjectorDistance = 0.6f;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Foveated", meta = (ClampMin = 30.0, ClampMax = 85.0, UIMin = 30.0, UIMax = 85.0, EditCondition = "Projection == EOmniCaptureProjection::FoveatedEquirectangular")) float FoveationStartLatitude = 60.0f;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Foveated", meta = (ClampMin = 1, ClampMax = 4, UIMin = 1, UIMax = 4, EditCondition = "Projection == EOmniCaptureProjection::FoveatedEquirectangular")) int32 FoveationLevels = 2;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (ClampMin = 0.0, UIMin = 0.0)) float TargetFrameRate = 60.0f;
+        /** How engine ticks map onto TargetFrameRate output frames; paced modes stamp frames with constant-rate timecodes. */
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture") EOmniCaptureFramePacing FramePacing = EOmniCaptureFramePacing::Decimate;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture") EOmniCaptureGamma Gamma = EOmniCaptureGamma::SRGB;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture") bool bEnablePreviewWindow = true;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (ClampMin = 0.1, UIMin = 0.1)) float PreviewScreenScale = 1.0f;
@@ -248,6 +285,10 @@ struct OMNICAPTURE_API FOmniCaptureSettings
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Stereo", meta = (ClampMin = 0.0, UIMin = 0.0)) float EyeConvergenceDistanceCm = 0.0f;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Stereo") UCurveFloat* InterpupillaryDistanceCurve = nullptr;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Stereo") UCurveFloat* EyeConvergenceCurve = nullptr;
+        /** Render stereo as narrow slit-scan slices around the IPD circle (omni-directional stereo) instead of two offset cubemaps. Stereo equirect only. */
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Stereo", meta = (EditCondition = "Mode == EOmniCaptureMode::Stereo")) bool bOmniDirectionalStereo = false;
+        /** ODS slices per eye around the rig. More slices shrink the parallax step between columns; each slice costs one scene render per pitch row. */
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Stereo", meta = (EditCondition = "bOmniDirectionalStereo", ClampMin = 8, ClampMax = 640, UIMin = 16, UIMax = 360)) int32 ODSSliceCount = 72;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (ClampMin = 0.0, UIMin = 0.0)) float SegmentDurationSeconds = 0.0f;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (ClampMin = 0)) int32 SegmentSizeLimitMB = 0;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (ClampMin = 0, UIMin = 0)) int32 SegmentFrameCount = 0;
@@ -268,19 +309,39 @@ struct OMNICAPTURE_API FOmniCaptureSettings
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output", meta = (ClampMin = 1, UIMin = 1)) int32 MaxPendingImageTasks = 8;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Diagnostics", meta = (ClampMin = 0)) int32 MinimumFreeDiskSpaceGB = 2;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Diagnostics", meta = (ClampMin = 0.1, ClampMax = 1.0)) float LowFrameRateWarningRatio = 0.85f;
+        /** Seconds between telemetry snapshots (queue depths, stage latencies, throughput, audio drift). */
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Diagnostics", meta = (ClampMin = 0.05, UIMin = 0.05)) float TelemetryIntervalSeconds = 0.25f;
+        /** Append every telemetry snapshot to <OutputFileName>_Telemetry.csv next to the capture. */
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Diagnostics") bool bWriteTelemetryCsv = false;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output") FString PreferredFFmpegPath;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (ClampMin = 0.0, ClampMax = 1.0)) float SeamBlend = 0.25f;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (ClampMin = 0.0, ClampMax = 1.0)) float PolarDampening = 0.5f;
+        /** Skip cube faces the output projection never samples (e.g. the rear face for VR180 and 180 degree fisheye). */
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rendering") bool bSkipUnusedCubeFaces = true;
+        /** Render partly used faces into a cropped target with an off-axis projection. Screen-space effects can differ slightly at the crop edge. */
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rendering") bool bCropPartialCubeFaces = true;
+        /** Size each cube face from the texel density the output projection actually needs instead of rendering every face at Resolution. */
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rendering") bool bAdaptiveFaceResolution = false;
+        /** Face texels per output pixel at each face's densest point; 1 matches the output, higher values supersample. */
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rendering", meta = (EditCondition = "bAdaptiveFaceResolution", ClampMin = 0.5, ClampMax = 4.0)) float AdaptiveFaceDensityScale = 1.0f;
+        /** Taps per output pixel when resampling the cube faces. High and Ultra filter each pixel's footprint and cost 4x / 9x remap table memory and bandwidth. */
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture") EOmniCaptureRemapQuality RemapQuality = EOmniCaptureRemapQuality::Standard;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output") FOmniCaptureQuality Quality;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NVENC") EOmniCaptureCodec Codec = EOmniCaptureCodec::HEVC;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NVENC") EOmniCaptureColorFormat NVENCColorFormat = EOmniCaptureColorFormat::NV12;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NVENC") bool bZeroCopy = true;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NVENC", meta = (ClampMin = 0, UIMin = 0)) int32 RingBufferCapacity = 6;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NVENC") EOmniCaptureRingBufferPolicy RingBufferPolicy = EOmniCaptureRingBufferPolicy::DropOldest;
+        /** Under sustained pipeline pressure, step down PNG compression, auxiliary pass rate, preview rate, remap sampling and cube face resolution (in that order) instead of dropping frames; restored once there is headroom. Ignored by offline captures. */
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Quality Governor") bool bEnableQualityGovernor = false;
+        /** Cube face render scale the governor falls back to last; the output size never changes. 1 keeps full face resolution. */
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|Quality Governor", meta = (EditCondition = "bEnableQualityGovernor", ClampMin = 0.25, ClampMax = 1.0)) float GovernorMinFaceResolutionScale = 0.75f;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NVENC") FString AVEncoderModulePathOverride;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NVENC") FString NVENCDllPathOverride;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output") bool bOpenPreviewOnFinalize = false;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preview") EOmniCapturePreviewView PreviewVisualization = EOmniCapturePreviewView::StereoComposite;
+        /** Width the preview is box-downsampled to before upload; narrower views are shown at their own size. */
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Preview", meta = (ClampMin = 64, UIMin = 256, UIMax = 4096)) int32 PreviewMaxWidth = 1024;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Metadata") bool bGenerateManifest = true;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Metadata") bool bWriteSpatialMetadata = true;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Metadata") bool bWriteXMPMetadata = true;
@@ -295,6 +356,13 @@ struct OMNICAPTURE_API FOmniCaptureSettings
         FIntPoint GetEquirectResolution() const;
         FIntPoint GetPlanarResolution() const;
         FIntPoint GetFisheyeResolution() const;
+        FIntPoint GetDomeResolution() const;
+        /** Per-eye 3x2 face atlas. */
+        FIntPoint GetCubemapResolution() const;
+        /** Per-eye equirect that the foveated layout packs; width divides by every band divisor. */
+        FIntPoint GetFoveatedSourceResolution() const;
+        /** Per-eye packed foveated frame. */
+        FIntPoint GetFoveatedResolution() const;
         FIntPoint GetOutputResolution() const;
         FIntPoint GetPerEyeOutputResolution() const;
         bool IsStereo() const;
@@ -304,10 +372,24 @@ struct OMNICAPTURE_API FOmniCaptureSettings
         bool IsCylindrical() const;
         bool IsFullDome() const;
         bool IsSphericalMirror() const;
+        /** Raw 3x2 cubemap or equi-angular cubemap. */
+        bool IsCubemapLayout() const;
+        bool IsFoveatedEquirect() const;
+        /** Stereo equirect rendered by the ODS slit-scan rig. */
+        bool UsesOmniDirectionalStereo() const;
+        /** Frames travel as packed RGB10A2 from the converter to the writer (the Y4M stream output). */
+        bool UsesPackedFrames() const;
+        /** True when capture is decimated to TargetFrameRate and frames carry constant-rate timecodes. */
+        bool UsesFramePacing() const;
+        /** Offline capture: the world advances a fixed 1/TargetFrameRate per output frame however long rendering takes. */
+        bool UsesFixedTimestep() const;
         bool SupportsSphericalMetadata() const;
         bool UseDualFisheyeLayout() const;
         bool ShouldConvertFisheyeToEquirect() const;
+        /** Supersampling grid edge for RemapQuality; 1 means a single bilinear tap per output pixel. */
+        int32 GetRemapSamplesPerAxis() const;
         FString GetStereoModeMetadataTag() const;
+        FString GetProjectionMetadataTag() const;
         int32 GetEncoderAlignmentRequirement() const;
         float GetHorizontalFOVDegrees() const;
         float GetVerticalFOVDegrees() const;
@@ -333,6 +415,10 @@ struct FOmniCaptureFrameMetadata
         UPROPERTY() int32 FrameIndex = 0;
         UPROPERTY() double Timecode = 0.0;
         UPROPERTY() bool bKeyFrame = false;
+        /** Repeat of the next captured frame that fills a slot the engine ticked past. */
+        UPROPERTY() bool bDuplicate = false;
+        /** Output slots skipped between the previous frame and this one. */
+        UPROPERTY() int32 SkippedSlots = 0;
 };
 
 struct FOmniCaptureLayerPayload
@@ -343,6 +429,19 @@ struct FOmniCaptureLayerPayload
         EOmniCapturePixelDataType PixelDataType = EOmniCapturePixelDataType::Unknown;
 };
 
+/** A CPU-fallback preview the ring buffer worker filters off the game thread before the frame is written. */
+struct FOmniCapturePreviewRequest
+{
+        TWeakObjectPtr<AOmniCapturePreviewActor> Target;
+        FIntRect ViewRect;
+        FIntPoint PreviewSize = FIntPoint::ZeroValue;
+        /** Pre-pack pixels of a packed frame; empty when the frame's own pixels are the ones to filter. */
+        TUniquePtr<FImagePixelData> UnpackedPixels;
+        EOmniCapturePixelDataType UnpackedPixelDataType = EOmniCapturePixelDataType::Unknown;
+
+        bool IsRequested() const { return PreviewSize.X > 0 && PreviewSize.Y > 0; }
+};
+
 struct FOmniCaptureFrame
 {
         FOmniCaptureFrameMetadata Metadata;
@@ -357,6 +456,9 @@ struct FOmniCaptureFrame
         TArray<FOmniAudioPacket> AudioPackets;
         TArray<FTextureRHIRef> EncoderTextures;
         TMap<FName, FOmniCaptureLayerPayload> AuxiliaryLayers;
+        /** Slots ahead of this frame that repeat its image; writers emit the one payload for each, so nothing is copied. */
+        TArray<FOmniCaptureFrameMetadata> Duplicates;
+        FOmniCapturePreviewRequest Preview;
 };
 
 USTRUCT(BlueprintType)
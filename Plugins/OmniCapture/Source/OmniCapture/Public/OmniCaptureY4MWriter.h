@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OmniCapturePixelPacking.h"
+
+/**
+ * Appends packed frames to a YUV4MPEG2 stream as limited-range 4:2:0 planes of 10, 12 or 16 bits, which ffmpeg
+ * reads directly (-i capture.y4m) without going through per-frame image files. Frames are written in call order.
+ */
+class OMNICAPTURE_API FOmniCaptureY4MWriter
+{
+public:
+    ~FOmniCaptureY4MWriter();
+
+    /** Creates or truncates FilePath and writes the stream header. */
+    bool Open(const FString& FilePath, const FIntPoint& InSize, double FrameRate, EOmniCaptureColorSpace InColorSpace, int32 InBitDepth = 10);
+    /** Appends one frame; returns the bytes written, or 0 if the stream is closed or the frame size differs. */
+    int64 WriteFrame(const TImagePixelData<FOmniCapturePackedRGB10A2>& Frame);
+    void Close();
+
+    bool IsOpen() const { return Archive.IsValid(); }
+    int32 GetFramesWritten() const { return FramesWritten; }
+
+    static FString BuildHeader(const FIntPoint& Size, double FrameRate, int32 BitDepth);
+    /** Rational form of FrameRate, the same one paced capture stamps its timecodes with. */
+    static void GetFrameRateRatio(double FrameRate, int32& OutNumerator, int32& OutDenominator);
+
+private:
+    TUniquePtr<FArchive> Archive;
+    FIntPoint Size = FIntPoint::ZeroValue;
+    EOmniCaptureColorSpace ColorSpace = EOmniCaptureColorSpace::BT709;
+    int32 BitDepth = 10;
+    int32 FramesWritten = 0;
+    TArray<uint16> YPlane;
+    TArray<uint16> CbPlane;
+    TArray<uint16> CrPlane;
+};
@@ -5,6 +5,8 @@
 #include "SOmniCaptureControlPanel.h"
 #include "OmniCaptureNVENCStatus.h"
 #include "OmniCaptureNVENCAPI.h"
+#include "OmniCaptureJournal.h"
+#include "Async/Async.h"
 #include "Framework/Docking/TabManager.h"
 #include "Styling/AppStyle.h"
 #include "ToolMenus.h"
@@ -50,6 +52,9 @@ void FOmniCaptureEditorModule::StartupModule()
     
     // 注册编辑器模块的退出回调
     FCoreDelegates::OnFEngineLoopDestroyed.AddRaw(this, &FOmniCaptureEditorModule::OnEditorClose);
+
+    // 检测上次崩溃遗留的未完成捕获
+    FCoreDelegates::OnPostEngineInit.AddRaw(this, &FOmniCaptureEditorModule::CheckForUnfinishedCaptures);
 }
 
 void FOmniCaptureEditorModule::ShutdownModule()
@@ -76,6 +81,7 @@ void FOmniCaptureEditorModule::ShutdownModule()
     
     // 移除委托
     FCoreDelegates::OnFEngineLoopDestroyed.RemoveAll(this);
+    FCoreDelegates::OnPostEngineInit.RemoveAll(this);
 }
 
 TSharedRef<SDockTab> FOmniCaptureEditorModule::SpawnCaptureTab(const FSpawnTabArgs& Args)
@@ -241,6 +247,105 @@ void FOmniCaptureEditorModule::OnEditorClose()
     FOmniCaptureNVENCAPI::Get().UnloadNVEncodeAPI();
 }
 
+void FOmniCaptureEditorModule::CheckForUnfinishedCaptures()
+{
+    TArray<FOmniCaptureJournalRecovery> Recoveries;
+    FOmniCaptureJournal::FindUnfinished(Recoveries);
+    if (Recoveries.Num() == 0)
+    {
+        return;
+    }
+
+    FNotificationInfo Info(FText::Format(
+        NSLOCTEXT("OmniCaptureEditor", "UnfinishedCaptures", "{0} Omni Capture session(s) did not finish (e.g. {1}). Finalize them from the files already on disk?"),
+        FText::AsNumber(Recoveries.Num()),
+        FText::FromString(Recoveries[0].BaseFileName)));
+    Info.bFireAndForget = false;
+    Info.bUseLargeFont = false;
+    Info.ButtonDetails.Add(FNotificationButtonInfo(
+        NSLOCTEXT("OmniCaptureEditor", "ResumeFinalize", "Resume Finalize"),
+        NSLOCTEXT("OmniCaptureEditor", "ResumeFinalizeTooltip", "Mux the recorded segments without re-rendering"),
+        FSimpleDelegate::CreateRaw(this, &FOmniCaptureEditorModule::HandleResumeUnfinishedCaptures),
+        SNotificationItem::CS_None));
+    Info.ButtonDetails.Add(FNotificationButtonInfo(
+        NSLOCTEXT("OmniCaptureEditor", "DiscardUnfinished", "Discard"),
+        NSLOCTEXT("OmniCaptureEditor", "DiscardUnfinishedTooltip", "Forget these sessions; captured files are left untouched"),
+        FSimpleDelegate::CreateRaw(this, &FOmniCaptureEditorModule::HandleDiscardUnfinishedCaptures),
+        SNotificationItem::CS_None));
+
+    UnfinishedCaptureNotification = FSlateNotificationManager::Get().AddNotification(Info);
+}
+
+void FOmniCaptureEditorModule::HandleResumeUnfinishedCaptures()
+{
+    if (bResumeInProgress)
+    {
+        return;
+    }
+    bResumeInProgress = true;
+
+    if (TSharedPtr<SNotificationItem> Notification = UnfinishedCaptureNotification.Pin())
+    {
+        Notification->SetText(NSLOCTEXT("OmniCaptureEditor", "ResumeFinalizeProgress", "Finalizing unfinished Omni Capture sessions..."));
+        Notification->SetCompletionState(SNotificationItem::CS_Pending);
+    }
+
+    // Muxing runs FFmpeg over whole segments, so it stays off the game thread; the result is reported back on it.
+    Async(EAsyncExecution::ThreadPool, []()
+    {
+        TArray<FString> FinalizedFiles;
+        const int32 Recovered = FOmniCaptureJournal::ResumeFinalizeAll(&FinalizedFiles);
+        const int32 FinalizedFileCount = FinalizedFiles.Num();
+
+        AsyncTask(ENamedThreads::GameThread, [Recovered, FinalizedFileCount]()
+        {
+            // The module may have been unloaded while the mux ran.
+            if (FOmniCaptureEditorModule* Module = FModuleManager::GetModulePtr<FOmniCaptureEditorModule>(TEXT("OmniCaptureEditor")))
+            {
+                Module->HandleResumeFinished(Recovered, FinalizedFileCount);
+            }
+        });
+    });
+}
+
+void FOmniCaptureEditorModule::HandleResumeFinished(int32 Recovered, int32 FinalizedFileCount)
+{
+    bResumeInProgress = false;
+
+    if (TSharedPtr<SNotificationItem> Notification = UnfinishedCaptureNotification.Pin())
+    {
+        Notification->SetText(FText::Format(
+            NSLOCTEXT("OmniCaptureEditor", "ResumeFinalizeResult", "Recovered {0} capture(s) into {1} file(s)."),
+            FText::AsNumber(Recovered),
+            FText::AsNumber(FinalizedFileCount)));
+        Notification->SetCompletionState(Recovered > 0 ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+        Notification->ExpireAndFadeout();
+    }
+    UnfinishedCaptureNotification.Reset();
+}
+
+void FOmniCaptureEditorModule::HandleDiscardUnfinishedCaptures()
+{
+    // Journals being finalized must not be deleted underneath the mux.
+    if (bResumeInProgress)
+    {
+        return;
+    }
+
+    TArray<FOmniCaptureJournalRecovery> Recoveries;
+    FOmniCaptureJournal::FindUnfinished(Recoveries);
+    for (const FOmniCaptureJournalRecovery& Recovery : Recoveries)
+    {
+        FOmniCaptureJournal::Discard(Recovery);
+    }
+
+    if (TSharedPtr<SNotificationItem> Notification = UnfinishedCaptureNotification.Pin())
+    {
+        Notification->ExpireAndFadeout();
+    }
+    UnfinishedCaptureNotification.Reset();
+}
+
 #undef LOCTEXT_NAMESPACE
 
 IMPLEMENT_MODULE(FOmniCaptureEditorModule, OmniCaptureEditor)
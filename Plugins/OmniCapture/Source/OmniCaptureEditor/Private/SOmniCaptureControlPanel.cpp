@@ -96,6 +96,12 @@ namespace
             return LOCTEXT("ProjectionFullDome", "Full Dome");
         case EOmniCaptureProjection::SphericalMirror:
             return LOCTEXT("ProjectionSphericalMirror", "Spherical Mirror");
+        case EOmniCaptureProjection::Cubemap:
+            return LOCTEXT("ProjectionCubemap", "Cubemap 3x2");
+        case EOmniCaptureProjection::EquiAngularCubemap:
+            return LOCTEXT("ProjectionEAC", "Equi-Angular Cubemap (EAC)");
+        case EOmniCaptureProjection::FoveatedEquirectangular:
+            return LOCTEXT("ProjectionFoveated", "Foveated Equirectangular");
         case EOmniCaptureProjection::Fisheye:
             return LOCTEXT("ProjectionFisheye", "Fisheye");
         case EOmniCaptureProjection::Equirectangular:
@@ -126,6 +132,8 @@ namespace
             return LOCTEXT("ImageFormatEXR", "EXR Sequence");
         case EOmniCaptureImageFormat::BMP:
             return LOCTEXT("ImageFormatBMP", "BMP Sequence");
+        case EOmniCaptureImageFormat::Y4M:
+            return LOCTEXT("ImageFormatY4M", "Y4M 10-bit Stream");
         case EOmniCaptureImageFormat::PNG:
         default:
             return LOCTEXT("ImageFormatPNG", "PNG Sequence");
@@ -266,6 +274,9 @@ void SOmniCaptureControlPanel::Construct(const FArguments& InArgs)
     ProjectionOptions.Add(MakeShared<TEnumOptionValue<EOmniCaptureProjection>>(EOmniCaptureProjection::Cylindrical));
     ProjectionOptions.Add(MakeShared<TEnumOptionValue<EOmniCaptureProjection>>(EOmniCaptureProjection::FullDome));
     ProjectionOptions.Add(MakeShared<TEnumOptionValue<EOmniCaptureProjection>>(EOmniCaptureProjection::SphericalMirror));
+    ProjectionOptions.Add(MakeShared<TEnumOptionValue<EOmniCaptureProjection>>(EOmniCaptureProjection::Cubemap));
+    ProjectionOptions.Add(MakeShared<TEnumOptionValue<EOmniCaptureProjection>>(EOmniCaptureProjection::EquiAngularCubemap));
+    ProjectionOptions.Add(MakeShared<TEnumOptionValue<EOmniCaptureProjection>>(EOmniCaptureProjection::FoveatedEquirectangular));
 
     FisheyeTypeOptions.Reset();
     FisheyeTypeOptions.Add(MakeShared<TEnumOptionValue<EOmniCaptureFisheyeType>>(EOmniCaptureFisheyeType::Hemispherical));
@@ -276,6 +287,7 @@ void SOmniCaptureControlPanel::Construct(const FArguments& InArgs)
     ImageFormatOptions.Add(MakeShared<TEnumOptionValue<EOmniCaptureImageFormat>>(EOmniCaptureImageFormat::JPG));
     ImageFormatOptions.Add(MakeShared<TEnumOptionValue<EOmniCaptureImageFormat>>(EOmniCaptureImageFormat::EXR));
     ImageFormatOptions.Add(MakeShared<TEnumOptionValue<EOmniCaptureImageFormat>>(EOmniCaptureImageFormat::BMP));
+    ImageFormatOptions.Add(MakeShared<TEnumOptionValue<EOmniCaptureImageFormat>>(EOmniCaptureImageFormat::Y4M));
 
     PNGBitDepthOptions.Reset();
     PNGBitDepthOptions.Add(MakeShared<TEnumOptionValue<EOmniCapturePNGBitDepth>>(EOmniCapturePNGBitDepth::BitDepth8));
@@ -1430,6 +1442,11 @@ void SOmniCaptureControlPanel::Construct(const FArguments& InArgs)
             ]
             + SVerticalBox::Slot()
             .AutoHeight()
+            [
+                CreateDisplayText(StageTimingTextBlock, LOCTEXT("StageTimingsInactive", "Stage Timings: -"))
+            ]
+            + SVerticalBox::Slot()
+            .AutoHeight()
             [
                 CreateDisplayText(AudioTextBlock, LOCTEXT("AudioStats", "Audio Drift: 0 ms"))
             ]
@@ -1834,6 +1851,10 @@ void SOmniCaptureControlPanel::RefreshStatus()
             FrameRateTextBlock->SetText(LOCTEXT("FrameRateInactive", "Frame Rate: 0.00 FPS"));
         }
         RingBufferTextBlock->SetText(FText::GetEmpty());
+        if (StageTimingTextBlock.IsValid())
+        {
+            StageTimingTextBlock->SetText(LOCTEXT("StageTimingsInactive", "Stage Timings: -"));
+        }
         AudioTextBlock->SetText(FText::GetEmpty());
         UpdateOutputDirectoryDisplay();
         RebuildWarningList(TArray<FString>());
@@ -1896,25 +1917,71 @@ void SOmniCaptureControlPanel::RefreshStatus()
         FNumberFormattingOptions FpsFormat;
         FpsFormat.SetMinimumFractionalDigits(2);
         FpsFormat.SetMaximumFractionalDigits(2);
-        const FText FrameText = FText::Format(LOCTEXT("FrameRateFormat", "Frame Rate: {0} FPS"), FText::AsNumber(CurrentFps, &FpsFormat));
+        FNumberFormattingOptions MegapixelFormat;
+        MegapixelFormat.SetMinimumFractionalDigits(1);
+        MegapixelFormat.SetMaximumFractionalDigits(1);
+        FText FrameText = FText::Format(LOCTEXT("FrameRateFormat", "Frame Rate: {0} FPS | Rendered: {1} MP/frame"),
+            FText::AsNumber(CurrentFps, &FpsFormat),
+            FText::AsNumber(Subsystem->GetRenderedMegapixelsPerFrame(), &MegapixelFormat));
+        if (bCapturing && Settings.UsesFixedTimestep())
+        {
+            const double Throughput = Subsystem->GetCaptureThroughput();
+            FrameText = FText::Format(LOCTEXT("OfflineThroughputFormat", "{0} | Offline: {1} frames/s ({2}x realtime)"),
+                FrameText,
+                FText::AsNumber(Throughput, &FpsFormat),
+                FText::AsNumber(Throughput / Settings.TargetFrameRate, &FpsFormat));
+        }
         FrameRateTextBlock->SetText(FrameText);
         FrameRateTextBlock->SetForegroundColor(Subsystem->IsPaused() ? FSlateColor(FLinearColor::Gray) : FSlateColor::UseForeground());
     }
 
-    const FOmniCaptureRingBufferStats RingStats = Subsystem->GetRingBufferStats();
-    const FText RingText = FText::Format(LOCTEXT("RingStatsFormat", "Ring Buffer: Pending {0} | Dropped {1} | Blocked {2}"),
-        FText::AsNumber(RingStats.PendingFrames),
-        FText::AsNumber(RingStats.DroppedFrames),
-        FText::AsNumber(RingStats.BlockedPushes));
+    // One lock-free snapshot for the whole refresh, so the numbers below come from the same instant.
+    const FOmniCaptureTelemetrySnapshot Telemetry = Subsystem->GetTelemetrySnapshot();
+    FNumberFormattingOptions RateFormat;
+    RateFormat.SetMinimumFractionalDigits(1);
+    RateFormat.SetMaximumFractionalDigits(1);
+    FText RingText = FText::Format(LOCTEXT("RingStatsFormat", "Ring Buffer: Pending {0} | Dropped {1} | Blocked {2} | Writer Backlog {3} | Write {4} MB/s | In Flight {5} MB"),
+        FText::AsNumber(Telemetry.RingBufferPending),
+        FText::AsNumber(Telemetry.DroppedFrames),
+        FText::AsNumber(Telemetry.RingBufferBlockedPushes),
+        FText::AsNumber(Telemetry.WriterPendingFrames),
+        FText::AsNumber(Telemetry.BytesWrittenPerSecond / (1024.0 * 1024.0), &RateFormat),
+        FText::AsNumber(Telemetry.MemoryInFlightBytes / (1024.0 * 1024.0), &RateFormat));
+    if (Telemetry.EncodedPackets > 0)
+    {
+        RingText = FText::Format(LOCTEXT("RingStatsEncoderFormat", "{0} | Encoder {1} packets/s, {2} Mbit/s"),
+            RingText,
+            FText::AsNumber(Telemetry.EncodedPacketsPerSecond, &RateFormat),
+            FText::AsNumber(Telemetry.EncodedBytesPerSecond * 8.0 / 1.0e6, &RateFormat));
+    }
     RingBufferTextBlock->SetText(RingText);
 
+    if (StageTimingTextBlock.IsValid())
+    {
+        // Means over the last telemetry interval; stages that did not run (no aux passes, no encoder) are left out.
+        FOmniCaptureFrameStageTimings StageTimings;
+        FMemory::Memcpy(StageTimings.Milliseconds, Telemetry.StageMilliseconds, sizeof(StageTimings.Milliseconds));
+        StageTimings[EOmniCaptureStage::Mux] = Subsystem->GetSessionStageTimings()[EOmniCaptureStage::Mux];
+        FString StageString;
+        for (int32 StageIndex = 0; StageIndex < static_cast<int32>(EOmniCaptureStage::Count); ++StageIndex)
+        {
+            if (StageTimings.Milliseconds[StageIndex] > 0.0)
+            {
+                StageString += FString::Printf(TEXT("%s%s %.2f"), StageString.IsEmpty() ? TEXT("") : TEXT(" | "), LexToString(static_cast<EOmniCaptureStage>(StageIndex)), StageTimings.Milliseconds[StageIndex]);
+            }
+        }
+        StageTimingTextBlock->SetText(StageString.IsEmpty()
+            ? LOCTEXT("StageTimingsInactive", "Stage Timings: -")
+            : FText::Format(LOCTEXT("StageTimingsFormat", "Stage Timings (ms): {0}"), FText::FromString(StageString)));
+    }
+
     const FOmniAudioSyncStats AudioStats = Subsystem->GetAudioSyncStats();
-    const FString DriftString = FString::Printf(TEXT("%.2f"), AudioStats.DriftMilliseconds);
-    const FString MaxString = FString::Printf(TEXT("%.2f"), AudioStats.MaxObservedDriftMilliseconds);
+    const FString DriftString = FString::Printf(TEXT("%.2f"), Telemetry.AudioDriftMilliseconds);
+    const FString MaxString = FString::Printf(TEXT("%.2f"), Telemetry.MaxAudioDriftMilliseconds);
     const FText AudioText = FText::Format(LOCTEXT("AudioStatsFormat", "Audio Drift: {0} ms (Max {1} ms) Pending {2}"),
         FText::FromString(DriftString),
         FText::FromString(MaxString),
-        FText::AsNumber(AudioStats.PendingPackets));
+        FText::AsNumber(Telemetry.AudioPendingPackets));
     AudioTextBlock->SetText(AudioText);
     AudioTextBlock->SetForegroundColor(AudioStats.bInError ? FSlateColor(FLinearColor::Red) : FSlateColor::UseForeground());
 
@@ -1931,13 +1998,13 @@ void SOmniCaptureControlPanel::UpdatePreviewTextureDisplay()
     }
 
     UOmniCaptureSubsystem* Subsystem = GetSubsystem();
-    UTexture2D* SubsystemPreviewTexture = Subsystem ? Subsystem->GetPreviewTexture() : nullptr;
-    const bool bHasValidTexture = SubsystemPreviewTexture && SubsystemPreviewTexture->GetSizeX() > 0 && SubsystemPreviewTexture->GetSizeY() > 0;
+    UTexture* SubsystemPreviewTexture = Subsystem ? Subsystem->GetPreviewTexture() : nullptr;
+    const bool bHasValidTexture = SubsystemPreviewTexture && SubsystemPreviewTexture->GetSurfaceWidth() > 0 && SubsystemPreviewTexture->GetSurfaceHeight() > 0;
     const FOmniCaptureSettings Snapshot = GetSettingsSnapshot();
 
     if (bHasValidTexture)
     {
-        const FVector2D NewSize(SubsystemPreviewTexture->GetSizeX(), SubsystemPreviewTexture->GetSizeY());
+        const FVector2D NewSize(SubsystemPreviewTexture->GetSurfaceWidth(), SubsystemPreviewTexture->GetSurfaceHeight());
         const bool bTextureChanged = CachedPreviewTexture.Get() != SubsystemPreviewTexture || !CachedPreviewSize.Equals(NewSize, KINDA_SMALL_NUMBER);
         if (bTextureChanged || !PreviewBrush.IsValid())
         {
@@ -2048,59 +2115,54 @@ TSharedRef<ITableRow> SOmniCaptureControlPanel::GenerateWarningRow(TSharedPtr<FS
 
 void SOmniCaptureControlPanel::RefreshDiagnosticLog()
 {
-    TArray<FOmniCaptureDiagnosticEntry> Entries;
-    if (UOmniCaptureSubsystem* Subsystem = GetSubsystem())
+    UOmniCaptureSubsystem* Subsystem = GetSubsystem();
+    if (Subsystem != DiagnosticSource.Get())
     {
-        Subsystem->GetCaptureDiagnosticLog(Entries);
+        // Sequences are per subsystem, so a different world starts the list over.
+        DiagnosticSource = Subsystem;
+        LastDiagnosticSequence = 0;
+        LastDiagnosticResetGeneration = Subsystem ? Subsystem->GetDiagnosticResetGeneration() : 0;
+        DiagnosticItems.Reset();
+        bHasDiagnostics = false;
     }
-
-    const int32 NewDiagnosticCount = Entries.Num();
-    bHasDiagnostics = NewDiagnosticCount > 0;
-
-    DiagnosticItems.Reset();
-
-    if (bHasDiagnostics)
+    else if (Subsystem && Subsystem->GetDiagnosticResetGeneration() != LastDiagnosticResetGeneration)
     {
-        FNumberFormattingOptions SecondsFormat;
-        SecondsFormat.SetMinimumFractionalDigits(2);
-        SecondsFormat.SetMaximumFractionalDigits(2);
-
-        for (const FOmniCaptureDiagnosticEntry& Entry : Entries)
-        {
-            TSharedPtr<FDiagnosticListItem> Item = MakeShared<FDiagnosticListItem>();
+        // The log was cleared elsewhere (BeginCapture, Blueprint); its old rows are only in the spill file now.
+        LastDiagnosticResetGeneration = Subsystem->GetDiagnosticResetGeneration();
+        DiagnosticItems.Reset();
+        bHasDiagnostics = false;
+    }
 
-            if (Entry.Timestamp.GetTicks() > 0)
-            {
-                Item->Timestamp = FText::FromString(Entry.Timestamp.ToString(TEXT("%H:%M:%S")));
-            }
-            else
-            {
-                Item->Timestamp = LOCTEXT("DiagnosticsNoTimestamp", "--:--:--");
-            }
+    TArray<FOmniCaptureDiagnosticEntry> Entries;
+    if (Subsystem)
+    {
+        LastDiagnosticSequence = Subsystem->GetDiagnosticsSince(LastDiagnosticSequence, Entries);
+    }
 
-            const FText RelativeSeconds = FText::AsNumber(Entry.SecondsSinceCaptureStart, &SecondsFormat);
-            Item->RelativeTime = FText::Format(LOCTEXT("DiagnosticsRelativeFormat", "(+{0}s)"), RelativeSeconds);
-            Item->AttemptIndex = Entry.AttemptIndex;
+    if (Entries.Num() == 0 && DiagnosticItems.Num() > 0)
+    {
+        return;
+    }
 
-            const FText BaseStep = Entry.Step.IsEmpty()
-                ? LOCTEXT("DiagnosticsDefaultStep", "Subsystem")
-                : FText::FromString(Entry.Step);
+    if (!bHasDiagnostics)
+    {
+        DiagnosticItems.Reset();
+    }
 
-            if (Entry.AttemptIndex > 0)
-            {
-                Item->Step = FText::Format(LOCTEXT("DiagnosticsAttemptStepFormat", "Attempt {0} · {1}"), Entry.AttemptIndex, BaseStep);
-            }
-            else
-            {
-                Item->Step = BaseStep;
-            }
-            Item->Message = Entry.Message.IsEmpty() ? LOCTEXT("DiagnosticsNoMessage", "No additional details.") : FText::FromString(Entry.Message);
-            Item->Level = Entry.Level;
+    for (const FOmniCaptureDiagnosticEntry& Entry : Entries)
+    {
+        DiagnosticItems.Add(MakeDiagnosticListItem(Entry));
+    }
 
-            DiagnosticItems.Add(Item);
-        }
+    // Keep no more than the subsystem retains; older entries live in its spill file.
+    const int32 ExcessItems = DiagnosticItems.Num() - FOmniCaptureDiagnosticLog::DefaultCapacity;
+    if (ExcessItems > 0)
+    {
+        DiagnosticItems.RemoveAt(0, ExcessItems, EAllowShrinking::No);
     }
-    else
+
+    bHasDiagnostics = DiagnosticItems.Num() > 0;
+    if (!bHasDiagnostics)
     {
         TSharedPtr<FDiagnosticListItem> Placeholder = MakeShared<FDiagnosticListItem>();
         Placeholder->bIsPlaceholder = true;
@@ -2111,22 +2173,49 @@ void SOmniCaptureControlPanel::RefreshDiagnosticLog()
     if (DiagnosticListView.IsValid())
     {
         DiagnosticListView->RequestListRefresh();
-        if (NewDiagnosticCount > LastDiagnosticCount && NewDiagnosticCount > 0)
+        if (Entries.Num() > 0)
         {
-            const int32 LastDiagnosticIndex = DiagnosticItems.FindLastByPredicate(
-                [](const TSharedPtr<FDiagnosticListItem>& Item)
-                {
-                    return Item.IsValid() && !Item->bIsPlaceholder;
-                });
-
-            if (LastDiagnosticIndex != INDEX_NONE)
-            {
-                DiagnosticListView->RequestScrollIntoView(DiagnosticItems[LastDiagnosticIndex]);
-            }
+            DiagnosticListView->RequestScrollIntoView(DiagnosticItems.Last());
         }
     }
+}
 
-    LastDiagnosticCount = NewDiagnosticCount;
+TSharedPtr<SOmniCaptureControlPanel::FDiagnosticListItem> SOmniCaptureControlPanel::MakeDiagnosticListItem(const FOmniCaptureDiagnosticEntry& Entry)
+{
+    FNumberFormattingOptions SecondsFormat;
+    SecondsFormat.SetMinimumFractionalDigits(2);
+    SecondsFormat.SetMaximumFractionalDigits(2);
+
+    TSharedPtr<FDiagnosticListItem> Item = MakeShared<FDiagnosticListItem>();
+
+    if (Entry.Timestamp.GetTicks() > 0)
+    {
+        Item->Timestamp = FText::FromString(Entry.Timestamp.ToString(TEXT("%H:%M:%S")));
+    }
+    else
+    {
+        Item->Timestamp = LOCTEXT("DiagnosticsNoTimestamp", "--:--:--");
+    }
+
+    const FText RelativeSeconds = FText::AsNumber(Entry.SecondsSinceCaptureStart, &SecondsFormat);
+    Item->RelativeTime = FText::Format(LOCTEXT("DiagnosticsRelativeFormat", "(+{0}s)"), RelativeSeconds);
+    Item->AttemptIndex = Entry.AttemptIndex;
+
+    const FText BaseStep = Entry.Step.IsEmpty()
+        ? LOCTEXT("DiagnosticsDefaultStep", "Subsystem")
+        : FText::FromString(Entry.Step);
+
+    if (Entry.AttemptIndex > 0)
+    {
+        Item->Step = FText::Format(LOCTEXT("DiagnosticsAttemptStepFormat", "Attempt {0} · {1}"), Entry.AttemptIndex, BaseStep);
+    }
+    else
+    {
+        Item->Step = BaseStep;
+    }
+    Item->Message = Entry.Message.IsEmpty() ? LOCTEXT("DiagnosticsNoMessage", "No additional details.") : FText::FromString(Entry.Message);
+    Item->Level = Entry.Level;
+    return Item;
 }
 
 TSharedRef<ITableRow> SOmniCaptureControlPanel::GenerateDiagnosticRow(TSharedPtr<FDiagnosticListItem> Item, const TSharedRef<STableViewBase>& OwnerTable)
@@ -2267,7 +2356,8 @@ FReply SOmniCaptureControlPanel::OnClearDiagnostics()
         Subsystem->ClearCaptureDiagnosticLog();
     }
 
-    LastDiagnosticCount = 0;
+    DiagnosticItems.Reset();
+    bHasDiagnostics = false;
     RefreshDiagnosticLog();
     return FReply::Handled();
 }
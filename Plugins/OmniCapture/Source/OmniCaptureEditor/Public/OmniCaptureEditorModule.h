@@ -32,7 +32,15 @@ private:
     void HandleNVENCStatusChanged(bool bAvailable);
     void OnEditorClose();
 
+    // 崩溃恢复
+    void CheckForUnfinishedCaptures();
+    void HandleResumeUnfinishedCaptures();
+    void HandleResumeFinished(int32 Recovered, int32 FinalizedFileCount);
+    void HandleDiscardUnfinishedCaptures();
+
 private:
     FDelegateHandle MenuRegistrationHandle;
+    TWeakPtr<SNotificationItem> UnfinishedCaptureNotification;
+    bool bResumeInProgress = false;
     TSharedPtr<SOmniCaptureNVENCStatus> NVENCStatusWidget;
 };
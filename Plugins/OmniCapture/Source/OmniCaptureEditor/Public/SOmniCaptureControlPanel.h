@@ -38,7 +38,7 @@ class SImage;
 struct FSlateDynamicImageBrush;
 class UOmniCaptureEditorSettings;
 class UOmniCaptureSubsystem;
-class UTexture2D;
+class UTexture;
 
 class OMNICAPTUREEDITOR_API SOmniCaptureControlPanel : public SCompoundWidget
 {
@@ -219,6 +219,7 @@ private:
     TSharedRef<ITableRow> GenerateDiagnosticRow(TSharedPtr<FDiagnosticListItem> Item, const TSharedRef<STableViewBase>& OwnerTable);
     FSlateColor GetDiagnosticLevelColor(EOmniCaptureDiagnosticLevel Level) const;
     static FString BuildDiagnosticEntryString(const FDiagnosticListItem& Item);
+    static TSharedPtr<FDiagnosticListItem> MakeDiagnosticListItem(const FOmniCaptureDiagnosticEntry& Entry);
     FReply OnCopyDiagnostics();
     FReply OnClearDiagnostics();
     bool CanClearDiagnostics() const;
@@ -254,6 +255,7 @@ private:
     TSharedPtr<SMultiLineEditableTextBox> StatusTextBlock;
     TSharedPtr<SMultiLineEditableTextBox> ActiveConfigTextBlock;
     TSharedPtr<SMultiLineEditableTextBox> RingBufferTextBlock;
+    TSharedPtr<SMultiLineEditableTextBox> StageTimingTextBlock;
     TSharedPtr<SMultiLineEditableTextBox> AudioTextBlock;
     TSharedPtr<SMultiLineEditableTextBox> FrameRateTextBlock;
     TSharedPtr<SMultiLineEditableTextBox> LastStillTextBlock;
@@ -268,7 +270,11 @@ private:
     TSharedPtr<SListView<TSharedPtr<FDiagnosticListItem>>> DiagnosticListView;
     TWeakPtr<FActiveTimerHandle> ActiveTimerHandle;
     bool bHasDiagnostics = false;
-    int32 LastDiagnosticCount = 0;
+    /** Newest subsystem diagnostic sequence already in DiagnosticItems; only later entries are pulled. */
+    int64 LastDiagnosticSequence = 0;
+    /** Subsystem diagnostic reset generation DiagnosticItems was built under; a newer one means the log was cleared. */
+    int32 LastDiagnosticResetGeneration = 0;
+    TWeakObjectPtr<UOmniCaptureSubsystem> DiagnosticSource;
 
     TArray<TEnumOptionPtr<EOmniCaptureStereoLayout>> StereoLayoutOptions;
     TArray<TEnumOptionPtr<EOmniOutputFormat>> OutputFormatOptions;
@@ -297,6 +303,6 @@ private:
     TSharedPtr<STextBlock> PreviewStatusText;
     TSharedPtr<STextBlock> PreviewResolutionText;
     TSharedPtr<FSlateDynamicImageBrush> PreviewBrush;
-    TWeakObjectPtr<UTexture2D> CachedPreviewTexture;
+    TWeakObjectPtr<UTexture> CachedPreviewTexture;
     FVector2D CachedPreviewSize = FVector2D::ZeroVector;
 };